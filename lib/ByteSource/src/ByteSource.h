@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * ByteSource - forward-only pull reader
+ *
+ * Decoders that only ever read forward (picojpeg, pngle) take a ByteSource so
+ * they can run straight off a decompressor instead of a temp file. No seeking:
+ * anything that needs to look ahead must buffer what it read.
+ */
+class ByteSource {
+ public:
+  virtual ~ByteSource() = default;
+
+  // Read up to len bytes. Returns bytes read, 0 at end of data, -1 on error.
+  virtual int read(uint8_t* buf, size_t len) = 0;
+
+  // Total size in bytes if known up front, 0 otherwise
+  virtual size_t size() const { return 0; }
+};
+
+// Adapter for an open file (FsFile or anything with int read(void*, size_t))
+template <typename File>
+class FileByteSource : public ByteSource {
+ public:
+  explicit FileByteSource(File& file) : file_(file) {}
+
+  int read(uint8_t* buf, const size_t len) override { return file_.read(buf, len); }
+  size_t size() const override { return static_cast<size_t>(file_.size()); }
+
+ private:
+  File& file_;
+};
+
+/**
+ * Replays bytes already consumed from `source` (e.g. a format signature) before
+ * continuing with the rest of it, so detection needs no seek back.
+ */
+class PrefixedByteSource : public ByteSource {
+ public:
+  static constexpr size_t MAX_PREFIX = 16;
+
+  PrefixedByteSource(ByteSource& source, const uint8_t* prefix, const size_t prefixLen) : source_(source) {
+    prefixLen_ = prefixLen < MAX_PREFIX ? prefixLen : MAX_PREFIX;
+    memcpy(prefix_, prefix, prefixLen_);
+  }
+
+  int read(uint8_t* buf, const size_t len) override {
+    if (len == 0) return 0;
+    if (prefixPos_ < prefixLen_) {
+      const size_t available = prefixLen_ - prefixPos_;
+      const size_t count = len < available ? len : available;
+      memcpy(buf, prefix_ + prefixPos_, count);
+      prefixPos_ += count;
+      return static_cast<int>(count);
+    }
+    return source_.read(buf, len);
+  }
+
+  size_t size() const override { return source_.size(); }
+
+ private:
+  ByteSource& source_;
+  uint8_t prefix_[MAX_PREFIX] = {};
+  size_t prefixLen_ = 0;
+  size_t prefixPos_ = 0;
+};
@@ -71,6 +71,19 @@ class EInkDisplay {
   // turnOffScreen: Power down display after refresh. Used for sunlight fading fix
   // on SSD1677 displays without resin protection (XTEINK X4).
   void displayBuffer(RefreshMode mode = FAST_REFRESH, bool turnOffScreen = false);
+  // Non-blocking displayBuffer(): sends the frame and starts the waveform, then returns.
+  // finishRefresh() waits for the panel and completes the RED RAM sync; every other
+  // controller operation calls it first. In single buffer mode the frame buffer is still
+  // needed for that sync, so it must not be drawn into until finishRefresh() returns.
+  // X3 panels refresh synchronously.
+  void beginDisplayBuffer(RefreshMode mode = FAST_REFRESH, bool turnOffScreen = false);
+  bool isRefreshing() const;
+  void finishRefresh();
+#ifdef EINK_DISPLAY_SINGLE_BUFFER_MODE
+  static constexpr bool frameBufferFreeWhileRefreshing() { return false; }
+#else
+  static constexpr bool frameBufferFreeWhileRefreshing() { return true; }
+#endif
   void displayBufferDriveAll(bool turnOffScreen = false);
   // EXPERIMENTAL: Windowed update - display only a rectangular region
   void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool turnOffScreen = false);
@@ -139,6 +152,9 @@ class EInkDisplay {
   bool customLutActive;
   bool inGrayscaleMode;
   bool drawGrayscale;
+  bool refreshPending = false;
+  bool redSyncPending = false;
+  const char* pendingRefreshType = nullptr;
 
   // Low-level display control
   void resetDisplay();
@@ -149,6 +165,7 @@ class EInkDisplay {
   void sendDataBatchEnd();
   void waitForRefresh(const char* comment = nullptr);
   void waitWhileBusy(const char* comment = nullptr);
+  void startRefresh(RefreshMode mode, bool turnOffScreen);
   void initDisplayController();
 
   // Low-level display operations
@@ -666,6 +666,7 @@ void IRAM_ATTR EInkDisplay::writeRamBufferInverted(uint8_t ramBuffer, const uint
 }
 
 void EInkDisplay::displayBufferDriveAll(bool turnOffScreen) {
+  finishRefresh();
   if (_x3Mode) {
     requestResync();
     displayBuffer(FAST_REFRESH, turnOffScreen);
@@ -702,6 +703,7 @@ void EInkDisplay::swapBuffers() {
 #endif
 
 void EInkDisplay::grayscaleRevert() {
+  finishRefresh();
   if (!inGrayscaleMode) {
     return;
   }
@@ -715,6 +717,7 @@ void EInkDisplay::grayscaleRevert() {
 }
 
 void EInkDisplay::copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer) {
+  finishRefresh();
   if (!lsbBuffer) {
     _x3GrayState.lsbValid = false;
     return;
@@ -739,6 +742,7 @@ void EInkDisplay::copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer) {
 }
 
 void EInkDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) {
+  finishRefresh();
   if (!msbBuffer) {
     return;
   }
@@ -762,6 +766,7 @@ void EInkDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) {
 }
 
 void EInkDisplay::copyGrayscaleBuffers(const uint8_t* lsbBuffer, const uint8_t* msbBuffer) {
+  finishRefresh();
   if (_x3Mode) {
     copyGrayscaleLsbBuffers(lsbBuffer);
     copyGrayscaleMsbBuffers(msbBuffer);
@@ -779,6 +784,7 @@ void EInkDisplay::copyGrayscaleBuffers(const uint8_t* lsbBuffer, const uint8_t*
  * grayscale display.
  */
 void EInkDisplay::cleanupGrayscaleBuffers(const uint8_t* bwBuffer) {
+  finishRefresh();
   if (_x3Mode) {
     if (!bwBuffer) {
       return;
@@ -817,7 +823,13 @@ void EInkDisplay::cleanupGrayscaleBuffers(const uint8_t* bwBuffer) {
 }
 #endif
 
-void EInkDisplay::displayBuffer(RefreshMode mode, const bool turnOffScreen) {
+void EInkDisplay::displayBuffer(const RefreshMode mode, const bool turnOffScreen) {
+  beginDisplayBuffer(mode, turnOffScreen);
+  finishRefresh();
+}
+
+void EInkDisplay::beginDisplayBuffer(RefreshMode mode, const bool turnOffScreen) {
+  finishRefresh();
   if (!_x3Mode && !isScreenOn && mode == FAST_REFRESH) {
     // Force half refresh if screen is off — FAST_REFRESH requires valid
     // previous frame data in RED RAM which may be stale after power-off.
@@ -1021,21 +1033,37 @@ void EInkDisplay::displayBuffer(RefreshMode mode, const bool turnOffScreen) {
   swapBuffers();
 #endif
 
-  // Refresh the display
-  refreshDisplay(mode, turnOffScreen);
+  // Start the refresh; finishRefresh() waits for it
+  startRefresh(mode, turnOffScreen);
 
 #ifdef EINK_DISPLAY_SINGLE_BUFFER_MODE
-  // In single buffer mode always sync RED RAM after refresh to prepare for next fast refresh
-  // This ensures RED contains the currently displayed frame for differential comparison
-  setRamArea(0, 0, displayWidth, displayHeight);
-  writeRamBuffer(CMD_WRITE_RAM_RED, frameBuffer, bufferSize);
+  // In single buffer mode RED RAM is synced after the refresh to prepare for the next fast refresh,
+  // so it holds the currently displayed frame for differential comparison
+  redSyncPending = true;
 #endif
 }
 
+bool EInkDisplay::isRefreshing() const { return refreshPending && digitalRead(_busy) == HIGH; }
+
+void EInkDisplay::finishRefresh() {
+  if (!refreshPending) return;
+  LOG_DBG(TAG, "Waiting for display refresh...");
+  waitWhileBusy(pendingRefreshType);
+  refreshPending = false;
+  pendingRefreshType = nullptr;
+
+  if (redSyncPending) {
+    redSyncPending = false;
+    setRamArea(0, 0, displayWidth, displayHeight);
+    writeRamBuffer(CMD_WRITE_RAM_RED, frameBuffer, bufferSize);
+  }
+}
+
 // EXPERIMENTAL: Windowed update support
 // Displays only a rectangular region of the frame buffer, preserving the rest of the screen.
 // Requirements: x and w must be byte-aligned (multiples of 8 pixels)
 void EInkDisplay::displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const bool turnOffScreen) {
+  finishRefresh();
   LOG_DBG(TAG, "Displaying window at (%d,%d) size (%dx%d)", x, y, w, h);
 
   // Validate bounds
@@ -1106,6 +1134,7 @@ void EInkDisplay::displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
 }
 
 void EInkDisplay::displayGrayBuffer(const bool turnOffScreen) {
+  finishRefresh();
   if (_x3Mode) {
     // X3 AA pipeline: LSB->0x10 + MSB->0x13, trigger 0x12 with X3 LUT bank.
     drawGrayscale = false;
@@ -1187,7 +1216,12 @@ void EInkDisplay::refreshDisplay(const RefreshMode mode, const bool turnOffScree
     displayBuffer(mode, turnOffScreen);
     return;
   }
+  finishRefresh();
+  startRefresh(mode, turnOffScreen);
+  finishRefresh();
+}
 
+void EInkDisplay::startRefresh(const RefreshMode mode, const bool turnOffScreen) {
   // Configure Display Update Control 1
   sendCommand(CMD_DISPLAY_UPDATE_CTRL1);
   sendData((mode == FAST_REFRESH) ? CTRL1_NORMAL : CTRL1_BYPASS_RED);  // Configure buffer comparison mode
@@ -1237,13 +1271,12 @@ void EInkDisplay::refreshDisplay(const RefreshMode mode, const bool turnOffScree
   sendData(displayMode);
 
   sendCommand(CMD_MASTER_ACTIVATION);
-
-  // Wait for display to finish updating
-  LOG_DBG(TAG, "Waiting for display refresh...");
-  waitWhileBusy(refreshType);
+  refreshPending = true;
+  pendingRefreshType = refreshType;
 }
 
 void EInkDisplay::setCustomLUT(const bool enabled, const unsigned char* lutData) {
+  finishRefresh();
   if (enabled) {
     LOG_DBG(TAG, "Loading custom LUT...");
 
@@ -1274,6 +1307,7 @@ void EInkDisplay::setCustomLUT(const bool enabled, const unsigned char* lutData)
 }
 
 void EInkDisplay::deepSleep() {
+  finishRefresh();
   LOG_INF(TAG, "Preparing display for deep sleep...");
 
   // First, power down the display properly
@@ -94,6 +94,10 @@ class StreamingEpdFont {
    */
   void logCacheStats() const;
 
+  // Bitmap cache lookups since load(); a miss is one SD read
+  uint32_t getCacheHits() const { return _cacheHits; }
+  uint32_t getCacheMisses() const { return _cacheMisses; }
+
   /**
    * Get the configured cache size.
    */
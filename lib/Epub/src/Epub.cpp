@@ -831,6 +831,23 @@ bool Epub::readItemContentsToStream(const std::string& itemHref, Print& out, con
   return ZipFile(filepath).readFileToStream(path.c_str(), out, chunkSize, dictBuffer, shouldAbort, scratch);
 }
 
+bool Epub::readItemWithSource(const std::string& itemHref, const std::function<bool(ByteSource&)>& consumer,
+                              uint8_t* dictBuffer) const {
+  if (itemHref.empty()) {
+    LOG_ERR(TAG, "Failed to read item, empty href");
+    return false;
+  }
+
+  const std::string path = FsHelpers::normalisePath(itemHref);
+  ZipFile zip(filepath);
+  ZipEntryReader reader;
+  if (reader.open(zip, path.c_str(), dictBuffer) != StreamReadResult::Success) {
+    LOG_ERR(TAG, "Failed to open item %s", path.c_str());
+    return false;
+  }
+  return consumer(reader);
+}
+
 bool Epub::getItemSize(const std::string& itemHref, size_t* size) const {
   const std::string path = FsHelpers::normalisePath(itemHref);
   return ZipFile(filepath).getInflatedFileSize(path.c_str(), size);
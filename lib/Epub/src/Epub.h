@@ -14,6 +14,7 @@
 #include "Epub/css/CssParser.h"
 
 class BuildArena;
+class ByteSource;
 class ZipFile;
 
 class Epub {
@@ -89,6 +90,10 @@ class Epub {
   bool readItemContentsToStream(const std::string& itemHref, Print& out, size_t chunkSize,
                                 uint8_t* dictBuffer = nullptr, BuildArena* scratch = nullptr,
                                 const std::function<bool()>& shouldAbort = nullptr) const;
+  // Hand a pull reader over the item to `consumer` instead of extracting it. False if the item
+  // can't be opened, otherwise the consumer's result. dictBuffer (32KB) avoids a malloc for deflated items.
+  bool readItemWithSource(const std::string& itemHref, const std::function<bool(ByteSource&)>& consumer,
+                          uint8_t* dictBuffer = nullptr) const;
   bool getItemSize(const std::string& itemHref, size_t* size) const;
   bool getSpineItemSizes(std::vector<size_t>& sizes) const;
   BookMetadataCache::SpineEntry getSpineItem(int spineIndex) const;
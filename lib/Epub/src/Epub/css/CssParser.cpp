@@ -196,11 +196,11 @@ bool CssParser::parseFile(const char* filepath) {
     }
   }
 
-  if (styleMap_.size() >= MAX_CSS_RULES) {
+  if (getStyleCount() >= MAX_CSS_RULES) {
     LOG_DBG(TAG, "Rule limit reached (%zu max)", MAX_CSS_RULES);
   }
   file.close();
-  LOG_INF(TAG, "Loaded %d style rules from %s", static_cast<int>(styleMap_.size()), filepath);
+  LOG_INF(TAG, "Loaded %d style rules from %s", static_cast<int>(getStyleCount()), filepath);
   return true;
 }
 
@@ -230,6 +230,79 @@ CssStyle CssParser::getCombinedStyle(const std::string& tagName, const std::stri
     combined.applyOver(*tagStyle);
   }
 
+  applyClassStyles(tagName, classNames, combined);
+  return combined;
+}
+
+CssStyle CssParser::getCombinedStyle(const std::string& tagName, const std::string& classNames,
+                                     const CssElementKey& element, const CssAncestorStack& ancestors) const {
+  if (selectorRules_.empty()) {
+    return getCombinedStyle(tagName, classNames);
+  }
+
+  // Gather candidates by subject key, reject by ancestor bloom, then verify
+  uint16_t matched[MAX_MATCHED_RULES];
+  size_t matchedCount = 0;
+  auto collect = [&](const std::vector<uint16_t>& candidates) {
+    for (const uint16_t ruleIdx : candidates) {
+      if (matchedCount >= MAX_MATCHED_RULES) return;
+      if (matchesRule(selectorRules_[ruleIdx], element, ancestors)) {
+        matched[matchedCount++] = ruleIdx;
+      }
+    }
+  };
+  auto collectKey = [&](const uint32_t key) {
+    if (!key) return;
+    auto it = ruleIndex_.find(key);
+    if (it != ruleIndex_.end()) collect(it->second);
+  };
+
+  collect(universalRules_);
+  collectKey(element.tag);
+  collectKey(element.id);
+  for (uint8_t i = 0; i < element.classCount; i++) {
+    collectKey(element.classes[i]);
+  }
+
+  // Insertion sort by (specificity, source order); matchedCount is tiny
+  for (size_t i = 1; i < matchedCount; i++) {
+    const uint16_t value = matched[i];
+    const auto& rule = selectorRules_[value];
+    size_t j = i;
+    while (j > 0) {
+      const auto& prev = selectorRules_[matched[j - 1]];
+      if (prev.specificity < rule.specificity || (prev.specificity == rule.specificity && prev.order < rule.order)) {
+        break;
+      }
+      matched[j] = matched[j - 1];
+      j--;
+    }
+    matched[j] = value;
+  }
+
+  // Interleave with the simple cascade: tag rules weigh 1, class rules 10
+  CssStyle combined;
+  size_t next = 0;
+  auto applyBelow = [&](const uint16_t specificity) {
+    while (next < matchedCount && selectorRules_[matched[next]].specificity < specificity) {
+      combined.applyOver(selectorRules_[matched[next]].style);
+      next++;
+    }
+  };
+
+  applyBelow(1);
+  const CssStyle* tagStyle = getStyleForClass(tagName);
+  if (tagStyle) {
+    combined.applyOver(*tagStyle);
+  }
+  applyBelow(10);
+  applyClassStyles(tagName, classNames, combined);
+  applyBelow(UINT16_MAX);
+
+  return combined;
+}
+
+void CssParser::applyClassStyles(const std::string& tagName, const std::string& classNames, CssStyle& combined) const {
   // Split class names by whitespace and apply each
   size_t start = 0;
   size_t len = classNames.length();
@@ -265,8 +338,154 @@ CssStyle CssParser::getCombinedStyle(const std::string& tagName, const std::stri
 
     start = end;
   }
+}
 
-  return combined;
+bool CssParser::matchesRule(const CssSelectorRule& rule, const CssElementKey& element,
+                            const CssAncestorStack& ancestors) const {
+  if (!compounds_[rule.first].matches(element)) return false;
+  if (rule.compoundCount == 1) return true;
+  // One subset test rejects most rules without walking the stack
+  if (!ancestors.bloom().mayContainAll(rule.ancestorMask)) return false;
+  return matchesAncestors(rule, 1, ancestors.size(), ancestors);
+}
+
+bool CssParser::matchesAncestors(const CssSelectorRule& rule, const uint8_t index, const size_t limit,
+                                 const CssAncestorStack& ancestors) const {
+  if (index == rule.compoundCount) return true;
+
+  const CssCompoundSelector& compound = compounds_[rule.first + index];
+  const bool directChild = (rule.childMask >> (index - 1)) & 1;
+  for (size_t j = limit; j-- > 0;) {
+    if (compound.matches(ancestors.keyAt(j)) && matchesAncestors(rule, index + 1, j, ancestors)) {
+      return true;
+    }
+    if (directChild) break;
+  }
+  return false;
+}
+
+bool CssParser::parseSelector(const std::string& selector, std::vector<CssCompoundSelector>& compounds,
+                              uint8_t& childMask, uint16_t& specificity) {
+  // Parsed left to right; compounds are reversed at the end so the subject comes first
+  std::vector<CssCompoundSelector> parsed;
+  std::vector<bool> childCombinator;  // childCombinator[i]: '>' between parsed[i] and parsed[i + 1]
+  CssCompoundSelector current;
+  bool inCompound = false;
+  bool pendingChild = false;
+  unsigned ids = 0, classes = 0, tags = 0;
+
+  auto isNameChar = [](const char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+  };
+  auto finishCompound = [&]() {
+    if (!inCompound) return true;
+    if (!parsed.empty()) childCombinator.push_back(pendingChild);
+    parsed.push_back(current);
+    current = CssCompoundSelector{};
+    inCompound = false;
+    pendingChild = false;
+    return parsed.size() <= MAX_SELECTOR_COMPOUNDS;
+  };
+
+  size_t i = 0;
+  const size_t len = selector.size();
+  while (i < len) {
+    const char c = selector[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      if (!finishCompound()) return false;
+      i++;
+      continue;
+    }
+    if (c == '>') {
+      if (!finishCompound() || parsed.empty() || pendingChild) return false;
+      pendingChild = true;
+      i++;
+      continue;
+    }
+    if (c == '*') {
+      if (inCompound) return false;
+      inCompound = true;
+      i++;
+      continue;
+    }
+    if (c == '.' || c == '#') {
+      size_t end = i + 1;
+      while (end < len && isNameChar(selector[end])) end++;
+      if (end == i + 1) return false;
+      if (c == '.') {
+        if (current.classCount >= CssCompoundSelector::MAX_CLASSES) return false;
+        current.classes[current.classCount++] = cssNameHash(CssHashKind::Class, selector.data() + i + 1, end - i - 1);
+        classes++;
+      } else {
+        if (current.id) return false;
+        current.id = cssNameHash(CssHashKind::Id, selector.data() + i + 1, end - i - 1);
+        ids++;
+      }
+      inCompound = true;
+      i = end;
+      continue;
+    }
+    if (isNameChar(c)) {
+      if (inCompound) return false;
+      size_t end = i;
+      while (end < len && isNameChar(selector[end])) end++;
+      const std::string tag = toLower(selector.substr(i, end - i));
+      current.tag = cssNameHash(CssHashKind::Tag, tag.c_str(), tag.size());
+      tags++;
+      inCompound = true;
+      i = end;
+      continue;
+    }
+    // Sibling combinators, attributes, pseudo-classes: unsupported
+    return false;
+  }
+  if (!finishCompound() || parsed.empty() || pendingChild) return false;
+
+  compounds.assign(parsed.rbegin(), parsed.rend());
+  childMask = 0;
+  for (size_t k = 0; k < childCombinator.size(); k++) {
+    // childCombinator[k] links parsed[k] (ancestor) and parsed[k + 1] (child);
+    // reversed, the child sits at index n - 2 - k
+    if (childCombinator[k]) childMask |= static_cast<uint8_t>(1u << (parsed.size() - 2 - k));
+  }
+  const unsigned spec = ids * 100 + classes * 10 + tags;
+  specificity = static_cast<uint16_t>(spec > UINT16_MAX - 1 ? UINT16_MAX - 1 : spec);
+  return true;
+}
+
+void CssParser::addSelectorRule(const std::string& selector, const CssStyle& style) {
+  std::vector<CssCompoundSelector> compounds;
+  uint8_t childMask = 0;
+  uint16_t specificity = 0;
+  if (!parseSelector(selector, compounds, childMask, specificity)) {
+    return;
+  }
+  if (getStyleCount() >= MAX_CSS_RULES || compounds_.size() + compounds.size() > UINT16_MAX) {
+    return;
+  }
+
+  CssSelectorRule rule;
+  rule.first = static_cast<uint16_t>(compounds_.size());
+  rule.compoundCount = static_cast<uint8_t>(compounds.size());
+  rule.childMask = childMask;
+  rule.specificity = specificity;
+  rule.order = static_cast<uint16_t>(selectorRules_.size());
+  rule.style = style;
+  for (size_t i = 1; i < compounds.size(); i++) {
+    compounds[i].addToBloom(rule.ancestorMask);
+  }
+
+  const CssCompoundSelector& subject = compounds.front();
+  const uint32_t key = subject.id ? subject.id : subject.classCount ? subject.classes[0] : subject.tag;
+  const auto ruleIdx = static_cast<uint16_t>(selectorRules_.size());
+  if (key) {
+    ruleIndex_[key].push_back(ruleIdx);
+  } else {
+    universalRules_.push_back(ruleIdx);
+  }
+
+  compounds_.insert(compounds_.end(), compounds.begin(), compounds.end());
+  selectorRules_.push_back(rule);
 }
 
 void CssParser::parseRule(const std::string& selector, const std::string& properties) {
@@ -280,14 +499,16 @@ void CssParser::parseRule(const std::string& selector, const std::string& proper
 
     std::string singleSelector = trim(selector.substr(start, end - start));
 
-    // Only accept tag, .class, and tag.class. Skip combinators (+>~), descendant
-    // (whitespace inside trimmed selector), attribute ([), pseudo (:), ID (#),
-    // and wildcard (*) — the matcher can't apply them, and keeping them would
-    // fill MAX_CSS_RULES with rules that never match.
-    const bool supportedSelector =
-        !singleSelector.empty() && singleSelector.find_first_of("+>[:#~* ") == std::string::npos;
+    // Plain tag, .class, and tag.class go to the string map. Id, multi-class, universal
+    // and descendant/child selectors are compiled into hashed selector rules; sibling
+    // (+~), attribute ([) and pseudo (:) selectors are rejected by parseSelector()
+    // so they don't fill MAX_CSS_RULES with rules that never match.
+    const size_t dot = singleSelector.find('.');
+    const bool simpleSelector = !singleSelector.empty() &&
+                                singleSelector.find_first_of("+>[:#~* \t\n") == std::string::npos &&
+                                (dot == std::string::npos || singleSelector.find('.', dot + 1) == std::string::npos);
 
-    if (supportedSelector) {
+    if (!singleSelector.empty()) {
       CssStyle style;
 
       // Split properties by semicolon
@@ -314,11 +535,15 @@ void CssParser::parseRule(const std::string& selector, const std::string& proper
       }
 
       if (style.defined.anySet()) {
-        auto it = styleMap_.find(singleSelector);
-        if (it != styleMap_.end()) {
-          it->second.applyOver(style);
-        } else if (styleMap_.size() < MAX_CSS_RULES) {
-          styleMap_[singleSelector] = style;
+        if (!simpleSelector) {
+          addSelectorRule(singleSelector, style);
+        } else {
+          auto it = styleMap_.find(singleSelector);
+          if (it != styleMap_.end()) {
+            it->second.applyOver(style);
+          } else if (getStyleCount() < MAX_CSS_RULES) {
+            styleMap_[singleSelector] = style;
+          }
         }
       }
     }
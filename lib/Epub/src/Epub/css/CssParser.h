@@ -2,8 +2,10 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "CssSelector.h"
 #include "CssStyle.h"
 
 /**
@@ -13,11 +15,18 @@
  * - Class selectors (.classname)
  * - Element.class selectors (p.classname)
  * - Tag selectors (p, div, etc.)
+ * - Id selectors (#id, tag#id)
+ * - Descendant and child combinators (div.poem p, blockquote > p)
+ * - Universal selector (*) inside compound selectors
  * - Multiple selectors separated by commas
  * - Inline styles
  *
+ * Simple selectors live in a string map. Everything else is compiled into
+ * hashed CssSelectorRules, indexed by their rightmost compound's id, first
+ * class or tag, and matched against a CssAncestorStack (see CssSelector.h).
+ *
  * Limitations:
- * - Does not support complex selectors (descendant, child, etc.)
+ * - Does not support sibling combinators (+, ~) or attribute selectors
  * - Does not support pseudo-classes or pseudo-elements
  * - Only extracts properties we actually use
  */
@@ -49,6 +58,15 @@ class CssParser {
    */
   CssStyle getCombinedStyle(const std::string& tagName, const std::string& classNames) const;
 
+  /**
+   * Same as above, plus id and descendant/child selector rules matched against
+   * the element's ancestors. `ancestors` must hold exactly the element's
+   * ancestors (entries [0, depth) of the open-element stack).
+   * Cascade: rules are applied in specificity order, source order breaking ties.
+   */
+  CssStyle getCombinedStyle(const std::string& tagName, const std::string& classNames, const CssElementKey& element,
+                            const CssAncestorStack& ancestors) const;
+
   /**
    * Parse an inline style attribute (e.g., "text-align: center; font-weight: bold;")
    * Returns a CssStyle with the parsed properties
@@ -56,12 +74,43 @@ class CssParser {
    */
   static CssStyle parseInlineStyle(const std::string& styleAttr);
 
-  bool hasStyles() const { return !styleMap_.empty(); }
-  size_t getStyleCount() const { return styleMap_.size(); }
-  void clear() { styleMap_.clear(); }
+  bool hasStyles() const { return !styleMap_.empty() || !selectorRules_.empty(); }
+  size_t getStyleCount() const { return styleMap_.size() + selectorRules_.size(); }
+  size_t getSelectorRuleCount() const { return selectorRules_.size(); }
+  void clear() {
+    styleMap_.clear();
+    selectorRules_.clear();
+    compounds_.clear();
+    ruleIndex_.clear();
+    universalRules_.clear();
+  }
 
  private:
+  // Compiled complex selector. compounds_[first] is the subject (rightmost) compound,
+  // followed by its ancestors right to left.
+  struct CssSelectorRule {
+    uint16_t first = 0;
+    uint8_t compoundCount = 0;
+    // Bit i set: compound i must be the direct child of compound i + 1 ('>')
+    uint8_t childMask = 0;
+    uint16_t specificity = 0;
+    uint16_t order = 0;
+    // Bloom bits of every ancestor compound; rejected unless all are on the path
+    CssAncestorBloom ancestorMask;
+    CssStyle style;
+  };
+
+  static constexpr uint8_t MAX_SELECTOR_COMPOUNDS = 8;
+  static constexpr size_t MAX_MATCHED_RULES = 32;
+
   void parseRule(const std::string& selector, const std::string& properties);
+  void addSelectorRule(const std::string& selector, const CssStyle& style);
+  static bool parseSelector(const std::string& selector, std::vector<CssCompoundSelector>& compounds, uint8_t& childMask,
+                            uint16_t& specificity);
+  bool matchesRule(const CssSelectorRule& rule, const CssElementKey& element, const CssAncestorStack& ancestors) const;
+  bool matchesAncestors(const CssSelectorRule& rule, uint8_t index, size_t limit,
+                        const CssAncestorStack& ancestors) const;
+  void applyClassStyles(const std::string& tagName, const std::string& classNames, CssStyle& combined) const;
   static void parseProperty(const std::string& name, const std::string& value, CssStyle& style);
   static TextAlign parseTextAlign(const std::string& value);
   static CssFontStyle parseFontStyle(const std::string& value);
@@ -75,4 +124,10 @@ class CssParser {
   static constexpr size_t MAX_CSS_FILE_SIZE = 64 * 1024;
 
   std::map<std::string, CssStyle> styleMap_;
+  std::vector<CssSelectorRule> selectorRules_;
+  std::vector<CssCompoundSelector> compounds_;
+  // Subject key hash (id, first class, or tag) -> indices into selectorRules_
+  std::unordered_map<uint32_t, std::vector<uint16_t>> ruleIndex_;
+  // Rules whose subject is "*" - candidates for every element
+  std::vector<uint16_t> universalRules_;
 };
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Hashed selector matching primitives for descendant/child/id CSS selectors.
+ *
+ * Element names, classes and ids are reduced to 32-bit hashes once per element,
+ * so matching never touches strings. Each hash kind uses its own seed, keeping
+ * tag "p", class ".p" and id "#p" distinct.
+ *
+ * CssAncestorStack keeps one entry per open element (indexed by XML depth) with a
+ * bloom filter of every tag/class/id hash on the path from the root. A complex
+ * rule precomputes the same bloom bits for its ancestor compounds, so rejecting a
+ * rule whose ancestors are not on the path is a single 128-bit subset test
+ * instead of a walk up the stack.
+ */
+
+enum class CssHashKind : uint8_t { Tag = 't', Class = 'c', Id = 'i' };
+
+// FNV-1a over kind + name. Never returns 0 (0 means "not set" in selectors).
+inline uint32_t cssNameHash(const CssHashKind kind, const char* name, const size_t len) {
+  uint32_t h = 2166136261u;
+  h = (h ^ static_cast<uint8_t>(kind)) * 16777619u;
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ static_cast<uint8_t>(name[i])) * 16777619u;
+  }
+  return h == 0 ? 1 : h;
+}
+
+inline uint32_t cssNameHash(const CssHashKind kind, const char* name) {
+  return cssNameHash(kind, name, strlen(name));
+}
+
+/**
+ * 128-bit bloom filter, two bits per key (derived from disjoint hash slices).
+ * Typical chapters nest < 10 elements with 1-3 keys each, which keeps the false
+ * positive rate low; false positives only cost a full match walk.
+ */
+struct CssAncestorBloom {
+  uint32_t words[4] = {};
+
+  void add(const uint32_t hash) {
+    const uint32_t b1 = hash & 127;
+    const uint32_t b2 = (hash >> 7) & 127;
+    words[b1 >> 5] |= 1u << (b1 & 31);
+    words[b2 >> 5] |= 1u << (b2 & 31);
+  }
+
+  void merge(const CssAncestorBloom& other) {
+    for (int i = 0; i < 4; i++) words[i] |= other.words[i];
+  }
+
+  // True if every bit of `mask` is set here (mask keys may be present)
+  bool mayContainAll(const CssAncestorBloom& mask) const {
+    return ((mask.words[0] & ~words[0]) | (mask.words[1] & ~words[1]) | (mask.words[2] & ~words[2]) |
+            (mask.words[3] & ~words[3])) == 0;
+  }
+};
+
+/**
+ * Hashed identity of one element: tag, id and up to MAX_CLASSES classes.
+ * Extra classes beyond the limit are ignored for complex-selector matching.
+ */
+struct CssElementKey {
+  static constexpr uint8_t MAX_CLASSES = 6;
+
+  uint32_t tag = 0;
+  uint32_t id = 0;
+  uint8_t classCount = 0;
+  uint32_t classes[MAX_CLASSES] = {};
+
+  static CssElementKey fromAttributes(const char* tagName, const char* classAttr, const char* idAttr) {
+    CssElementKey key;
+    key.tag = cssNameHash(CssHashKind::Tag, tagName);
+    if (idAttr && idAttr[0] != '\0') {
+      key.id = cssNameHash(CssHashKind::Id, idAttr);
+    }
+    if (classAttr) {
+      const char* p = classAttr;
+      while (*p && key.classCount < MAX_CLASSES) {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+        const char* start = p;
+        while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') p++;
+        if (p > start) {
+          key.classes[key.classCount++] = cssNameHash(CssHashKind::Class, start, static_cast<size_t>(p - start));
+        }
+      }
+    }
+    return key;
+  }
+
+  bool hasClass(const uint32_t hash) const {
+    for (uint8_t i = 0; i < classCount; i++) {
+      if (classes[i] == hash) return true;
+    }
+    return false;
+  }
+
+  void addToBloom(CssAncestorBloom& bloom) const {
+    bloom.add(tag);
+    if (id) bloom.add(id);
+    for (uint8_t i = 0; i < classCount; i++) bloom.add(classes[i]);
+  }
+};
+
+/**
+ * One compound selector (e.g. "p.note#intro"). Zero fields match anything,
+ * so "*" is a compound with every field zero.
+ */
+struct CssCompoundSelector {
+  static constexpr uint8_t MAX_CLASSES = 4;
+
+  uint32_t tag = 0;
+  uint32_t id = 0;
+  uint8_t classCount = 0;
+  uint32_t classes[MAX_CLASSES] = {};
+
+  bool matches(const CssElementKey& element) const {
+    if (tag && tag != element.tag) return false;
+    if (id && id != element.id) return false;
+    for (uint8_t i = 0; i < classCount; i++) {
+      if (!element.hasClass(classes[i])) return false;
+    }
+    return true;
+  }
+
+  void addToBloom(CssAncestorBloom& bloom) const {
+    if (tag) bloom.add(tag);
+    if (id) bloom.add(id);
+    for (uint8_t i = 0; i < classCount; i++) bloom.add(classes[i]);
+  }
+};
+
+/**
+ * Open-element stack indexed by XML depth. Entry i holds the element at depth i
+ * and the bloom of all keys from the root through it.
+ *
+ * Callers set the entry for the current depth with enter(); deeper stale entries
+ * are discarded, so elements that return early without entering (skip regions,
+ * void tags) need no matching pop.
+ */
+class CssAncestorStack {
+ public:
+  struct Entry {
+    CssElementKey key;
+    CssAncestorBloom bloom;
+  };
+
+  void clear() { entries_.clear(); }
+
+  // Drop entries at depth >= `depth` so [0, depth) are the current element's ancestors
+  void truncate(const size_t depth) {
+    if (entries_.size() > depth) {
+      entries_.resize(depth);
+    } else {
+      while (entries_.size() < depth) {
+        // Gap left by an element that never entered: inherit the parent's bloom
+        Entry filler;
+        if (!entries_.empty()) filler.bloom = entries_.back().bloom;
+        entries_.push_back(filler);
+      }
+    }
+  }
+
+  void enter(const size_t depth, const CssElementKey& key) {
+    truncate(depth);
+    Entry entry;
+    entry.key = key;
+    if (!entries_.empty()) entry.bloom = entries_.back().bloom;
+    key.addToBloom(entry.bloom);
+    entries_.push_back(entry);
+  }
+
+  size_t size() const { return entries_.size(); }
+  const CssElementKey& keyAt(const size_t index) const { return entries_[index].key; }
+
+  // Bloom of all ancestors currently on the stack
+  const CssAncestorBloom& bloom() const {
+    static const CssAncestorBloom empty;
+    return entries_.empty() ? empty : entries_.back().bloom;
+  }
+
+ private:
+  std::vector<Entry> entries_;
+};
@@ -1,6 +1,5 @@
 #include "ChapterHtmlSlimParser.h"
 
-#include <Bitmap.h>
 #include <ExpatEncodingHandler.h>
 #include <FsHelpers.h>
 #include <GfxRenderer.h>
@@ -9,7 +8,8 @@
 #include <Page.h>
 #include <SDCardManager.h>
 #include <Utf8.h>
-#include <core/PerfLog.h>
+#include <XmlNames.h>
+#include <core/Trace.h>
 #include <esp_heap_caps.h>
 #include <expat.h>
 #include <freertos/FreeRTOS.h>
@@ -25,27 +25,57 @@ using std::min;  // ESP32 Arduino.h provides this via using-declaration
 
 #include "../htmlEntities.h"
 
-const char* HEADER_TAGS[] = {"h1", "h2", "h3", "h4", "h5", "h6"};
-constexpr int NUM_HEADER_TAGS = sizeof(HEADER_TAGS) / sizeof(HEADER_TAGS[0]);
-
 // Minimum file size (in bytes) to show progress bar - smaller chapters don't benefit from it
 constexpr size_t MIN_SIZE_FOR_PROGRESS = 50 * 1024;  // 50KB
 
-const char* BLOCK_TAGS[] = {"p", "li", "div", "br", "blockquote", "question", "answer", "quotation", "pre"};
-constexpr int NUM_BLOCK_TAGS = sizeof(BLOCK_TAGS) / sizeof(BLOCK_TAGS[0]);
-
-const char* BOLD_TAGS[] = {"b", "strong"};
-constexpr int NUM_BOLD_TAGS = sizeof(BOLD_TAGS) / sizeof(BOLD_TAGS[0]);
+// Tag classes. Names are resolved once per element via lookupXmlName(); these are plain switches.
+bool isHeaderTag(const XmlName tag) {
+  switch (tag) {
+    case XmlName::H1:
+    case XmlName::H2:
+    case XmlName::H3:
+    case XmlName::H4:
+    case XmlName::H5:
+    case XmlName::H6:
+      return true;
+    default:
+      return false;
+  }
+}
 
-// Monospace inline tags render as italic: no monospace font is bundled, italic is the visual cue.
-const char* ITALIC_TAGS[] = {"i", "em", "code", "tt", "kbd", "samp"};
-constexpr int NUM_ITALIC_TAGS = sizeof(ITALIC_TAGS) / sizeof(ITALIC_TAGS[0]);
+bool isBlockTag(const XmlName tag) {
+  switch (tag) {
+    case XmlName::P:
+    case XmlName::Li:
+    case XmlName::Div:
+    case XmlName::Br:
+    case XmlName::Blockquote:
+    case XmlName::Question:
+    case XmlName::Answer:
+    case XmlName::Quotation:
+    case XmlName::Pre:
+      return true;
+    default:
+      return false;
+  }
+}
 
-const char* IMAGE_TAGS[] = {"img"};
-constexpr int NUM_IMAGE_TAGS = sizeof(IMAGE_TAGS) / sizeof(IMAGE_TAGS[0]);
+bool isBoldTag(const XmlName tag) { return tag == XmlName::B || tag == XmlName::Strong; }
 
-const char* SKIP_TAGS[] = {"head"};
-constexpr int NUM_SKIP_TAGS = sizeof(SKIP_TAGS) / sizeof(SKIP_TAGS[0]);
+// Monospace inline tags render as italic: no monospace font is bundled, italic is the visual cue.
+bool isItalicTag(const XmlName tag) {
+  switch (tag) {
+    case XmlName::I:
+    case XmlName::Em:
+    case XmlName::Code:
+    case XmlName::Tt:
+    case XmlName::Kbd:
+    case XmlName::Samp:
+      return true;
+    default:
+      return false;
+  }
+}
 
 bool isWhitespace(const char c) { return c == ' ' || c == '\r' || c == '\n' || c == '\t'; }
 
@@ -101,16 +131,6 @@ BlockStyle blockStyleFromCss(const CssStyle& cssStyle, const float emSize, const
   return bs;
 }
 
-// given the start and end of a tag, check to see if it matches a known tag
-bool matches(const char* tag_name, const char* possible_tags[], const int possible_tag_count) {
-  for (int i = 0; i < possible_tag_count; i++) {
-    if (strcmp(tag_name, possible_tags[i]) == 0) {
-      return true;
-    }
-  }
-  return false;
-}
-
 void ChapterHtmlSlimParser::flushPartWordBuffer() {
   if (!currentTextBlock || partWordBufferIndex == 0) {
     partWordBufferIndex = 0;
@@ -179,7 +199,6 @@ void ChapterHtmlSlimParser::startNewTextBlock(const TextBlock::BLOCK_STYLE style
 
 void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char* name, const XML_Char** atts) {
   auto* self = static_cast<ChapterHtmlSlimParser*>(userData);
-  (void)atts;
 
   // Prevent stack overflow from deeply nested XML
   if (self->depth >= MAX_XML_DEPTH) {
@@ -193,18 +212,57 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
     return;
   }
 
-  if (matches(name, IMAGE_TAGS, NUM_IMAGE_TAGS)) {
-    std::string srcAttr;
-    std::string altText;
-    if (atts != nullptr) {
-      for (int i = 0; atts[i]; i += 2) {
-        if (strcmp(atts[i], "src") == 0 && atts[i + 1][0] != '\0') {
-          srcAttr = atts[i + 1];
-        } else if (strcmp(atts[i], "alt") == 0 && atts[i + 1][0] != '\0') {
-          altText = atts[i + 1];
-        }
+  const XmlName tag = lookupXmlName(name);
+
+  // Single pass over attributes, one hash per name
+  const char* srcValue = "";
+  const char* altValue = "";
+  const char* classValue = "";
+  const char* styleValue = "";
+  const char* dirValue = "";
+  const char* idValue = "";
+  bool pageBreak = false;
+  bool ariaHidden = false;
+  if (atts != nullptr) {
+    for (int i = 0; atts[i]; i += 2) {
+      const char* value = atts[i + 1];
+      switch (lookupXmlName(atts[i])) {
+        case XmlName::Src:
+          if (value[0] != '\0') srcValue = value;
+          break;
+        case XmlName::Alt:
+          if (value[0] != '\0') altValue = value;
+          break;
+        case XmlName::Class:
+          classValue = value;
+          break;
+        case XmlName::Style:
+          styleValue = value;
+          break;
+        case XmlName::Dir:
+          dirValue = value;
+          break;
+        case XmlName::Id:
+          if (value[0] != '\0') idValue = value;
+          break;
+        case XmlName::Role:
+          pageBreak = pageBreak || strcmp(value, "doc-pagebreak") == 0;
+          break;
+        case XmlName::EpubType:
+          pageBreak = pageBreak || strcmp(value, "pagebreak") == 0;
+          break;
+        case XmlName::AriaHidden:
+          ariaHidden = ariaHidden || strcmp(value, "true") == 0;
+          break;
+        default:
+          break;
       }
     }
+  }
+
+  if (tag == XmlName::Img) {
+    const std::string srcAttr = srcValue;
+    const std::string altText = altValue;
 
     LOG_DBG(TAG, "Found image: src=%s", srcAttr.empty() ? "(empty)" : srcAttr.c_str());
 
@@ -228,35 +286,25 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
         return;
       }
       if (!cachedPath.empty()) {
-        // Read image dimensions from cached BMP
-        FsFile bmpFile;
-        if (SdMan.openFileForRead("EHP", cachedPath, bmpFile)) {
-          Bitmap bitmap(bmpFile, false);
-          if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-            // Skip tiny decorative images (e.g. 1px-tall line separators) - invisible on e-paper
-            if (bitmap.getWidth() < 20 || bitmap.getHeight() < 20) {
-              bmpFile.close();
-              self->depth += 1;
-              return;
-            }
-            LOG_DBG(TAG, "Image loaded: %dx%d", bitmap.getWidth(), bitmap.getHeight());
-            auto imageBlock = std::make_shared<ImageBlock>(cachedPath, bitmap.getWidth(), bitmap.getHeight());
-            bmpFile.close();
-
-            // Flush any pending text block before adding image
-            if (self->currentTextBlock && !self->currentTextBlock->isEmpty()) {
-              self->makePages();
-            }
-
-            self->addImageToPage(imageBlock);
+        int imageWidth = 0;
+        int imageHeight = 0;
+        if (ImageBlock::readCachedSize(cachedPath, imageWidth, imageHeight)) {
+          // Skip tiny decorative images (e.g. 1px-tall line separators) - invisible on e-paper
+          if (imageWidth < 20 || imageHeight < 20) {
             self->depth += 1;
             return;
-          } else {
-            LOG_ERR(TAG, "BMP parse failed for cached image");
           }
-          bmpFile.close();
-        } else {
-          LOG_ERR(TAG, "Failed to open cached BMP: %s", cachedPath.c_str());
+          LOG_DBG(TAG, "Image loaded: %dx%d", imageWidth, imageHeight);
+          auto imageBlock = std::make_shared<ImageBlock>(cachedPath, imageWidth, imageHeight);
+
+          // Flush any pending text block before adding image
+          if (self->currentTextBlock && !self->currentTextBlock->isEmpty()) {
+            self->makePages();
+          }
+
+          self->addImageToPage(imageBlock);
+          self->depth += 1;
+          return;
         }
       }
     } else {
@@ -282,7 +330,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
   // Special handling for tables - show placeholder text instead of dropping silently
   // TODO: Render tables - parse table structure (thead, tbody, tr, td, th), calculate
   // column widths, handle colspan/rowspan, and render as formatted text grid.
-  if (strcmp(name, "table") == 0) {
+  if (tag == XmlName::Table) {
     // For now, add placeholder text
     self->startNewTextBlock(TextBlock::CENTER_ALIGN);
     if (self->currentTextBlock) {
@@ -295,7 +343,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
     return;
   }
 
-  if (matches(name, SKIP_TAGS, NUM_SKIP_TAGS)) {
+  if (tag == XmlName::Head) {
     // start skip
     self->skipUntilDepth = self->depth;
     self->depth += 1;
@@ -303,62 +351,42 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
   }
 
   // Skip blocks with role="doc-pagebreak" and epub:type="pagebreak"
-  if (atts != nullptr) {
-    for (int i = 0; atts[i]; i += 2) {
-      if (strcmp(atts[i], "role") == 0 && strcmp(atts[i + 1], "doc-pagebreak") == 0 ||
-          strcmp(atts[i], "epub:type") == 0 && strcmp(atts[i + 1], "pagebreak") == 0) {
-        self->skipUntilDepth = self->depth;
-        self->depth += 1;
-        return;
-      }
-    }
+  if (pageBreak) {
+    self->skipUntilDepth = self->depth;
+    self->depth += 1;
+    return;
   }
 
   // Skip empty anchor tags with aria-hidden (Pandoc line number anchors)
   // These appear as: <a href="#cb1-1" aria-hidden="true" tabindex="-1"></a>
-  if (strcmp(name, "a") == 0 && atts != nullptr) {
-    for (int i = 0; atts[i]; i += 2) {
-      if (strcmp(atts[i], "aria-hidden") == 0 && strcmp(atts[i + 1], "true") == 0) {
-        self->skipUntilDepth = self->depth;
-        self->depth += 1;
-        return;
-      }
-    }
+  if (tag == XmlName::A && ariaHidden) {
+    self->skipUntilDepth = self->depth;
+    self->depth += 1;
+    return;
   }
 
-  // Extract class, style, dir, and id attributes
-  std::string classAttr;
-  std::string styleAttr;
-  std::string dirAttr;
-  std::string idAttr;
-  if (atts != nullptr) {
-    for (int i = 0; atts[i]; i += 2) {
-      if (strcmp(atts[i], "class") == 0) {
-        classAttr = atts[i + 1];
-      } else if (strcmp(atts[i], "style") == 0) {
-        styleAttr = atts[i + 1];
-      } else if (strcmp(atts[i], "dir") == 0) {
-        dirAttr = atts[i + 1];
-      } else if (strcmp(atts[i], "id") == 0 && atts[i + 1][0] != '\0') {
-        idAttr = atts[i + 1];
-      }
-    }
-  }
+  const std::string classAttr = classValue;
+  std::string idAttr = idValue;
 
   // Query CSS for combined style (tag + classes + inline)
   CssStyle cssStyle;
-  if (self->cssParser_) {
+  if (self->cssParser_ && self->cssParser_->getSelectorRuleCount() > 0) {
+    const auto elementKey = CssElementKey::fromAttributes(name, classValue, idValue);
+    self->cssAncestors_.truncate(self->depth);
+    cssStyle = self->cssParser_->getCombinedStyle(name, classAttr, elementKey, self->cssAncestors_);
+    self->cssAncestors_.enter(self->depth, elementKey);
+  } else if (self->cssParser_) {
     cssStyle = self->cssParser_->getCombinedStyle(name, classAttr);
   }
   // Inline styles override stylesheet rules (static method, no instance needed)
-  if (!styleAttr.empty()) {
-    cssStyle.applyOver(CssParser::parseInlineStyle(styleAttr));
+  if (styleValue[0] != '\0') {
+    cssStyle.applyOver(CssParser::parseInlineStyle(styleValue));
   }
   // HTML dir attribute overrides CSS direction (case-insensitive per HTML spec)
-  if (!dirAttr.empty() && strcasecmp(dirAttr.c_str(), "rtl") == 0) {
+  if (strcasecmp(dirValue, "rtl") == 0) {
     cssStyle.direction = TextDirection::Rtl;
     cssStyle.defined.direction = 1;
-  } else if (!dirAttr.empty() && strcasecmp(dirAttr.c_str(), "ltr") == 0) {
+  } else if (strcasecmp(dirValue, "ltr") == 0) {
     cssStyle.direction = TextDirection::Ltr;
     cssStyle.defined.direction = 1;
   }
@@ -408,7 +436,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
     }
   };
 
-  if (matches(name, HEADER_TAGS, NUM_HEADER_TAGS)) {
+  if (isHeaderTag(tag)) {
     const float emSize = static_cast<float>(self->renderer.getEffectiveLineHeight(self->config.fontId));
     auto headerBlockStyle =
         blockStyleFromCss(cssStyle, emSize, self->config.paragraphAlignment, self->config.viewportWidth);
@@ -422,8 +450,8 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
     self->startNewTextBlock(accumulated.alignment);
     applyOrStashBlockStyle(accumulated);
     self->boldUntilDepth = min(self->boldUntilDepth, self->depth);
-  } else if (matches(name, BLOCK_TAGS, NUM_BLOCK_TAGS)) {
-    if (strcmp(name, "br") == 0) {
+  } else if (isBlockTag(tag)) {
+    if (tag == XmlName::Br) {
       self->flushPartWordBuffer();
       const bool hadContent = self->currentTextBlock && !self->currentTextBlock->isEmpty();
       const auto style = self->currentTextBlock ? self->currentTextBlock->getStyle()
@@ -432,7 +460,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
       if (hadContent) self->skipParagraphSpacing_ = true;
       self->startNewTextBlock(style);
       if (hadContent) self->reapplyContinuationInsets();
-    } else if (strcmp(name, "pre") == 0) {
+    } else if (tag == XmlName::Pre) {
       self->preformattedUntilDepth = min(self->preformattedUntilDepth, self->depth);
       self->preWsPending = 0;
       const float emSize = static_cast<float>(self->renderer.getEffectiveLineHeight(self->config.fontId));
@@ -455,7 +483,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
       self->startNewTextBlock(accumulated.alignment);
       applyOrStashBlockStyle(accumulated);
 
-      if (strcmp(name, "li") == 0 && !self->listStack_.empty()) {
+      if (tag == XmlName::Li && !self->listStack_.empty()) {
         auto& listEntry = self->listStack_.back();
         listEntry.counter++;
         char marker[12] = {};
@@ -471,12 +499,12 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
         }
       }
     }
-  } else if (matches(name, BOLD_TAGS, NUM_BOLD_TAGS)) {
+  } else if (isBoldTag(tag)) {
     self->boldUntilDepth = min(self->boldUntilDepth, self->depth);
-  } else if (matches(name, ITALIC_TAGS, NUM_ITALIC_TAGS)) {
+  } else if (isItalicTag(tag)) {
     self->italicUntilDepth = min(self->italicUntilDepth, self->depth);
-  } else if (strcmp(name, "ul") == 0 || strcmp(name, "ol") == 0) {
-    self->listStack_.push_back({self->depth, strcmp(name, "ol") == 0, 0});
+  } else if (tag == XmlName::Ul || tag == XmlName::Ol) {
+    self->listStack_.push_back({self->depth, tag == XmlName::Ol, 0});
   }
 
   // Record anchor-to-page mapping (after block handling so pagesCreated_ reflects current page)
@@ -596,7 +624,7 @@ void XMLCALL ChapterHtmlSlimParser::characterData(void* userData, const XML_Char
 
 void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* name) {
   auto* self = static_cast<ChapterHtmlSlimParser*>(userData);
-  (void)name;
+  const XmlName tag = lookupXmlName(name);
 
   if (self->partWordBufferIndex > 0) {
     // Only flush out part word buffer if we're closing a block tag or are at the top of the HTML file.
@@ -605,10 +633,8 @@ void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* n
     // text styling needs to be overhauled to fix it.
     const bool closingCssStyle =
         self->cssBoldUntilDepth == self->depth - 1 || self->cssItalicUntilDepth == self->depth - 1;
-    const bool shouldBreakText = matches(name, BLOCK_TAGS, NUM_BLOCK_TAGS) ||
-                                 matches(name, HEADER_TAGS, NUM_HEADER_TAGS) ||
-                                 matches(name, BOLD_TAGS, NUM_BOLD_TAGS) ||
-                                 matches(name, ITALIC_TAGS, NUM_ITALIC_TAGS) || closingCssStyle || self->depth == 1;
+    const bool shouldBreakText = isBlockTag(tag) || isHeaderTag(tag) || isBoldTag(tag) || isItalicTag(tag) ||
+                                 closingCssStyle || self->depth == 1;
 
     if (shouldBreakText) {
       self->flushPartWordBuffer();
@@ -627,8 +653,7 @@ void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* n
     return;
   }
 
-  const bool headerOrBlockTag =
-      matches(name, HEADER_TAGS, NUM_HEADER_TAGS) || matches(name, BLOCK_TAGS, NUM_BLOCK_TAGS);
+  const bool headerOrBlockTag = isHeaderTag(tag) || isBlockTag(tag);
 
   if (headerOrBlockTag && self->currentTextBlock && self->currentTextBlock->isEmpty()) {
     self->currentTextBlock->setStyle(static_cast<TextBlock::BLOCK_STYLE>(self->config.paragraphAlignment));
@@ -654,7 +679,7 @@ void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* n
     self->rtlUntilDepth_ = INT_MAX;
     self->pendingRtl_ = false;
   }
-  if (headerOrBlockTag && strcmp(name, "br") != 0) {
+  if (headerOrBlockTag && tag != XmlName::Br) {
     if (self->blockStyleStack_.size() > 1) {
       self->currentBlockStyle_ = self->currentBlockStyle_.addBottom(self->blockStyleStack_.back());
       self->blockStyleStack_.pop_back();
@@ -744,6 +769,7 @@ bool ChapterHtmlSlimParser::initParser() {
   skipParagraphSpacing_ = false;
   currentLeftInset_ = 0;
   listStack_.clear();
+  cssAncestors_.clear();
   pendingListMarker_[0] = '\0';
   dataUriStripper_.reset();
   startNewTextBlock(static_cast<TextBlock::BLOCK_STYLE>(config.paragraphAlignment));
@@ -883,12 +909,12 @@ bool ChapterHtmlSlimParser::parseLoop() {
         const uint16_t splitWidth =
             (inset < config.viewportWidth) ? static_cast<uint16_t>(config.viewportWidth - inset) : config.viewportWidth;
         currentLeftInset_ = currentBlockStyle_.leftInset();
-        const uint32_t layoutStarted = perfMsNow();
+        TRACE_BEGIN(EpubLayout);
         const bool layoutCompleted = currentTextBlock->layoutAndExtractLines(
             renderer, config.fontId, splitWidth,
             [this](const std::shared_ptr<TextBlock>& textBlock) { addLineToPage(textBlock); }, true,
             [this]() -> bool { return stopRequested_ || shouldAbort(); }, buildScratch_);
-        readerPerfLog("epub-layout", layoutStarted);
+        TRACE_END(EpubLayout);
         if (chapter_html::layoutWasAborted(layoutCompleted, stopRequested_)) {
           aborted_ = true;
         }
@@ -1142,12 +1168,12 @@ void ChapterHtmlSlimParser::makePages() {
                                       : config.viewportWidth;
   currentLeftInset_ = currentBlockStyle_.leftInset();
 
-  const uint32_t layoutStarted = perfMsNow();
+  TRACE_BEGIN(EpubLayout);
   const bool layoutCompleted = currentTextBlock->layoutAndExtractLines(
       renderer, config.fontId, effectiveWidth,
       [this](const std::shared_ptr<TextBlock>& textBlock) { addLineToPage(textBlock); }, true,
       [this]() -> bool { return stopRequested_ || shouldAbort(); }, buildScratch_);
-  readerPerfLog("epub-layout", layoutStarted);
+  TRACE_END(EpubLayout);
   if (chapter_html::layoutWasAborted(layoutCompleted, stopRequested_)) {
     aborted_ = true;
     return;
@@ -1225,12 +1251,20 @@ std::string ChapterHtmlSlimParser::cacheImage(const std::string& src) {
     LOG_DBG(TAG, "Skipping session-blacklisted image: %s", resolvedPath.c_str());
     return "";
   }
-  std::string cachedBmpPath = imageCachePath + "/" + std::to_string(srcHash) + ".bmp";
+  const std::string cacheBase = imageCachePath + "/" + std::to_string(srcHash);
+  std::string cachedBmpPath = cacheBase + ".bmp";
+  // Grayscale pages need both darkness planes, 1-bit pages only the black mask
+  const int g5Planes = config.grayscaleImages ? 2 : 1;
+  const std::string cachedG5Path = cacheBase + (config.grayscaleImages ? ".g5" : ".bw.g5");
 
   // Check if already cached
-  if (SdMan.exists(cachedBmpPath.c_str())) {
+  if (SdMan.exists(cachedG5Path.c_str())) {
     consecutiveImageFailures_ = 0;  // Reset on success
-    return cachedBmpPath;
+    return cachedG5Path;
+  }
+  if (SdMan.exists(cachedBmpPath.c_str())) {
+    consecutiveImageFailures_ = 0;
+    return ImageBlock::compressCachedBmp(cachedBmpPath, cachedG5Path, g5Planes);
   }
 
   // Check for failed marker
@@ -1251,44 +1285,54 @@ std::string ChapterHtmlSlimParser::cacheImage(const std::string& src) {
     return "";
   }
 
-  // Extract image to temp file (include hash in name for uniqueness)
-  const std::string tempExt = FsHelpers::isPngFile(src) ? ".png" : ".jpg";
-  std::string tempPath = imageCachePath + "/.tmp_" + std::to_string(srcHash) + tempExt;
-  FsFile tempFile;
-  if (!SdMan.openFileForWrite("EHP", tempPath, tempFile)) {
-    LOG_ERR(TAG, "Failed to create temp file for image");
-    return "";
-  }
-
-  if (!readItemFn(resolvedPath, tempFile, 1024, buildScratch_)) {
-    tempFile.close();
-    SdMan.remove(tempPath.c_str());
-    const bool externallyAborted = externalAbortCallback_ && externalAbortCallback_();
-    if (!chapter_html::imageFailureShouldPersist(externallyAborted)) {
-      LOG_DBG(TAG, "Image extraction cancelled: %s", resolvedPath.c_str());
-      return "";
-    }
-
-    LOG_ERR(TAG, "Failed to extract image: %s", resolvedPath.c_str());
-    FsFile marker;
-    if (SdMan.openFileForWrite("EHP", failedMarker, marker)) {
-      marker.close();
-    }
-    blacklistFailedImage(srcHash);
-    consecutiveImageFailures_++;
-    return "";
-  }
-  tempFile.close();
-
   const int maxImageHeight = config.viewportHeight;
   ImageConvertConfig convertConfig;
   convertConfig.maxWidth = static_cast<int>(config.viewportWidth);
   convertConfig.maxHeight = maxImageHeight;
+  convertConfig.oneBit = !config.grayscaleImages;
   convertConfig.logTag = "EHP";
   convertConfig.shouldAbort = externalAbortCallback_;
 
-  const bool success = ImageConverterFactory::convertToBmp(tempPath, cachedBmpPath, convertConfig);
-  SdMan.remove(tempPath.c_str());
+  bool success = false;
+  if (readItemSourceFn_) {
+    // Decode straight off the (inflating) ZIP entry: no temp copy written and read back
+    success = readItemSourceFn_(
+        resolvedPath,
+        [&](ByteSource& source) { return ImageConverterFactory::convertToBmp(source, cachedBmpPath, convertConfig); },
+        buildScratch_);
+  } else {
+    // Extract image to temp file (include hash in name for uniqueness)
+    const std::string tempExt = FsHelpers::isPngFile(src) ? ".png" : ".jpg";
+    std::string tempPath = imageCachePath + "/.tmp_" + std::to_string(srcHash) + tempExt;
+    FsFile tempFile;
+    if (!SdMan.openFileForWrite("EHP", tempPath, tempFile)) {
+      LOG_ERR(TAG, "Failed to create temp file for image");
+      return "";
+    }
+
+    if (!readItemFn(resolvedPath, tempFile, 1024, buildScratch_)) {
+      tempFile.close();
+      SdMan.remove(tempPath.c_str());
+      const bool externallyAborted = externalAbortCallback_ && externalAbortCallback_();
+      if (!chapter_html::imageFailureShouldPersist(externallyAborted)) {
+        LOG_DBG(TAG, "Image extraction cancelled: %s", resolvedPath.c_str());
+        return "";
+      }
+
+      LOG_ERR(TAG, "Failed to extract image: %s", resolvedPath.c_str());
+      FsFile marker;
+      if (SdMan.openFileForWrite("EHP", failedMarker, marker)) {
+        marker.close();
+      }
+      blacklistFailedImage(srcHash);
+      consecutiveImageFailures_++;
+      return "";
+    }
+    tempFile.close();
+
+    success = ImageConverterFactory::convertToBmp(tempPath, cachedBmpPath, convertConfig);
+    SdMan.remove(tempPath.c_str());
+  }
 
   if (!success) {
     SdMan.remove(cachedBmpPath.c_str());
@@ -1311,7 +1355,7 @@ std::string ChapterHtmlSlimParser::cacheImage(const std::string& src) {
 
   consecutiveImageFailures_ = 0;  // Reset on success
   LOG_DBG(TAG, "Cached image: %s", cachedBmpPath.c_str());
-  return cachedBmpPath;
+  return ImageBlock::compressCachedBmp(cachedBmpPath, cachedG5Path, g5Planes);
 }
 
 void ChapterHtmlSlimParser::addImageToPage(std::shared_ptr<ImageBlock> image) {
@@ -20,6 +20,7 @@
 #include "DataUriStripper.h"
 
 class BuildArena;
+class ByteSource;
 class Page;
 class GfxRenderer;
 class Print;
@@ -53,10 +54,14 @@ class ChapterHtmlSlimParser {
   std::string chapterBasePath;
   std::string imageCachePath;
   std::function<bool(const std::string&, Print&, size_t, BuildArena*)> readItemFn;
+  // Optional: decode images straight from the container instead of a temp copy (see cacheImage)
+  std::function<bool(const std::string&, const std::function<bool(ByteSource&)>&, BuildArena*)> readItemSourceFn_;
   BuildArena* buildScratch_ = nullptr;
 
   // CSS support
   const CssParser* cssParser_ = nullptr;
+  // Open-element keys + ancestor bloom for descendant/child/id selectors
+  CssAncestorStack cssAncestors_;
 
   // XML parser handle for stopping mid-parse
   XML_Parser xmlParser_ = nullptr;
@@ -168,6 +173,10 @@ class ChapterHtmlSlimParser {
   }
 
   void setBuildScratch(BuildArena* scratch) { buildScratch_ = scratch; }
+  void setReadItemSourceFn(
+      const std::function<bool(const std::string&, const std::function<bool(ByteSource&)>&, BuildArena*)>& fn) {
+    readItemSourceFn_ = fn;
+  }
   void setExternalAbortCallback(const std::function<bool()>& callback) { externalAbortCallback_ = callback; }
   bool parseAndBuildPages();
   bool resumeParsing();
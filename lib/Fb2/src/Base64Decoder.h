@@ -1,108 +1,226 @@
 #pragma once
 
+#include <ByteSource.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 
-// Streaming base64 decoder for FB2 embedded binary extraction.
-// Accumulates input in a small buffer, decodes 4-char groups to 3 bytes,
-// and passes decoded data to a callback. Skips whitespace automatically.
+namespace base64 {
+
+// Lookup values besides 0..63. All of them have one of the top two bits set,
+// so a whole group of four can be checked with a single OR.
+constexpr uint8_t kPad = 0x40;
+constexpr uint8_t kSkip = 0x80;  // whitespace between groups and line breaks
+constexpr uint8_t kInvalid = 0xFF;
+constexpr uint8_t kSpecialMask = 0xC0;
+
+struct DecodeTable {
+  uint8_t value[256];
+
+  constexpr DecodeTable() : value() {
+    for (int i = 0; i < 256; i++) value[i] = kInvalid;
+    for (int i = 0; i < 26; i++) {
+      value['A' + i] = static_cast<uint8_t>(i);
+      value['a' + i] = static_cast<uint8_t>(26 + i);
+    }
+    for (int i = 0; i < 10; i++) value['0' + i] = static_cast<uint8_t>(52 + i);
+    value[static_cast<uint8_t>('+')] = 62;
+    value[static_cast<uint8_t>('/')] = 63;
+    value[static_cast<uint8_t>('=')] = kPad;
+    value[static_cast<uint8_t>(' ')] = kSkip;
+    value[static_cast<uint8_t>('\n')] = kSkip;
+    value[static_cast<uint8_t>('\r')] = kSkip;
+    value[static_cast<uint8_t>('\t')] = kSkip;
+  }
+};
+
+inline constexpr DecodeTable kDecodeTable{};
+
+}  // namespace base64
+
+// Streaming base64 decoder for FB2 embedded binaries.
+// Table-driven: whole groups of four valid characters decode 4->3 bytes in one
+// step; whitespace, padding and groups split across calls take the per-character
+// path. Only the partial group is kept between calls, never the base64 text.
 class Base64Decoder {
  public:
   using WriteCallback = std::function<bool(const uint8_t* data, size_t len)>;
 
-  void feed(const char* data, int len, const WriteCallback& write) {
-    for (int i = 0; i < len && !failed_; i++) {
-      char c = data[i];
-      if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
-      buf_[bufLen_++] = c;
-      if (bufLen_ == kBufSize) {
-        decodeBuffer(write);
+  /**
+   * Decode from in[0..inLen) into out[0..outCap). Stops when the input is used up
+   * or fewer than 3 bytes of output space are left.
+   * @param consumed Set to the number of input characters used
+   * @return Bytes written to out (0 with failed() set on invalid input)
+   */
+  size_t decode(const char* in, const size_t inLen, size_t& consumed, uint8_t* out, const size_t outCap) {
+    const auto* src = reinterpret_cast<const uint8_t*>(in);
+    const uint8_t* table = base64::kDecodeTable.value;
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < inLen && outCap - o >= 3 && !failed_) {
+      if (pending_ == 0) {
+        while (i + 4 <= inLen && outCap - o >= 3) {
+          const uint8_t a = table[src[i]];
+          const uint8_t b = table[src[i + 1]];
+          const uint8_t c = table[src[i + 2]];
+          const uint8_t d = table[src[i + 3]];
+          if ((a | b | c | d) & base64::kSpecialMask) break;
+          const uint32_t v = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) |
+                             (static_cast<uint32_t>(c) << 6) | d;
+          out[o++] = static_cast<uint8_t>(v >> 16);
+          out[o++] = static_cast<uint8_t>(v >> 8);
+          out[o++] = static_cast<uint8_t>(v);
+          i += 4;
+        }
+        if (i >= inLen || outCap - o < 3) break;
+      }
+
+      const uint8_t v = table[src[i++]];
+      if (v == base64::kSkip) continue;
+      if (v == base64::kInvalid) {
+        failed_ = true;
+        break;
+      }
+      group_[pending_++] = v;
+      if (pending_ == 4) {
+        o += emitGroup(out + o);
+        pending_ = 0;
       }
     }
+
+    consumed = i;
+    return failed_ ? 0 : o;
   }
 
-  bool finish(const WriteCallback& write) {
-    if (failed_) return false;
-    if (bufLen_ > 0) {
-      decodeBuffer(write);
-    }
-    if (bufLen_ > 0) {
-      failed_ = true;  // Incomplete base64 group
+  void feed(const char* data, const int len, const WriteCallback& write) {
+    size_t offset = 0;
+    const size_t total = len > 0 ? static_cast<size_t>(len) : 0;
+    while (offset < total && !failed_) {
+      size_t consumed = 0;
+      const size_t produced = decode(data + offset, total - offset, consumed, out_, kOutSize);
+      offset += consumed;
+      if (produced > 0 && !write(out_, produced)) failed_ = true;
     }
+  }
+
+  bool finish(const WriteCallback& /*write*/) {
+    // Output is written as each group completes; only a partial group can be left
+    if (pending_ != 0) failed_ = true;  // Incomplete base64 group
     return !failed_;
   }
 
   bool failed() const { return failed_; }
 
  private:
-  static constexpr size_t kBufSize = 256;
-  char buf_[kBufSize] = {};
-  size_t bufLen_ = 0;
+  static constexpr size_t kOutSize = 192;
+  uint8_t out_[kOutSize] = {};
+  uint8_t group_[4] = {};
+  uint8_t pending_ = 0;
   bool failed_ = false;
 
-  static int8_t decodeChar(char c) {
-    if (c >= 'A' && c <= 'Z') return c - 'A';
-    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-    if (c >= '0' && c <= '9') return c - '0' + 52;
-    if (c == '+') return 62;
-    if (c == '/') return 63;
-    if (c == '=') return -2;  // padding
-    return -1;                // invalid
+  // Full group with padding: "xxxx" -> 3 bytes, "xxx=" -> 2, "xx==" -> 1
+  size_t emitGroup(uint8_t* out) {
+    const uint8_t a = group_[0];
+    const uint8_t b = group_[1];
+    const uint8_t c = group_[2];
+    const uint8_t d = group_[3];
+    if (a == base64::kPad || b == base64::kPad || (c == base64::kPad && d != base64::kPad)) {
+      failed_ = true;
+      return 0;
+    }
+    out[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+    if (c == base64::kPad) return 1;
+    out[1] = static_cast<uint8_t>(((b & 0x0F) << 4) | (c >> 2));
+    if (d == base64::kPad) return 2;
+    out[2] = static_cast<uint8_t>(((c & 0x03) << 6) | d);
+    return 3;
   }
+};
 
-  void decodeBuffer(const WriteCallback& write) {
-    // Process complete 4-char groups
-    size_t groups = bufLen_ / 4;
-    size_t processed = groups * 4;
-    uint8_t out[3];
-
-    for (size_t g = 0; g < groups && !failed_; g++) {
-      size_t base = g * 4;
-      int8_t a = decodeChar(buf_[base]);
-      int8_t b = decodeChar(buf_[base + 1]);
-      int8_t c = decodeChar(buf_[base + 2]);
-      int8_t d = decodeChar(buf_[base + 3]);
+/**
+ * Decoded bytes of base64 text read from another ByteSource, so image decoders
+ * can pull an FB2 <binary> straight from the book file. The text ends at the
+ * end of the source or at the first '<' (the </binary> tag; '<' is never base64).
+ * Only one read chunk of base64 text is held at a time.
+ */
+class Base64Source : public ByteSource {
+ public:
+  explicit Base64Source(ByteSource& text) : text_(text) {}
 
-      if (a < 0 || b < 0) {
-        failed_ = true;
-        return;
+  int read(uint8_t* buf, const size_t len) override {
+    size_t produced = 0;
+    while (produced < len) {
+      if (carryPos_ < carryLen_) {
+        const size_t n = len - produced < carryLen_ - carryPos_ ? len - produced : carryLen_ - carryPos_;
+        memcpy(buf + produced, carry_ + carryPos_, n);
+        carryPos_ += n;
+        produced += n;
+        continue;
       }
 
-      out[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+      if (inPos_ == inLen_) {
+        if (ended_ || !refill()) break;
+        continue;
+      }
 
-      if (c == -2) {
-        // "xx==" — 1 output byte
-        if (d != -2) {
-          failed_ = true;
-          return;
-        }
-        if (!write(out, 1)) failed_ = true;
-      } else if (c < 0) {
-        failed_ = true;
-        return;
-      } else if (d == -2) {
-        // "xxx=" — 2 output bytes
-        out[1] = static_cast<uint8_t>(((b & 0x0F) << 4) | (c >> 2));
-        if (!write(out, 2)) failed_ = true;
-      } else if (d < 0) {
-        failed_ = true;
-        return;
+      size_t consumed = 0;
+      if (len - produced >= 3) {
+        produced += decoder_.decode(in_ + inPos_, inLen_ - inPos_, consumed, buf + produced, len - produced);
       } else {
-        // "xxxx" — 3 output bytes
-        out[1] = static_cast<uint8_t>(((b & 0x0F) << 4) | (c >> 2));
-        out[2] = static_cast<uint8_t>(((c & 0x03) << 6) | d);
-        if (!write(out, 3)) failed_ = true;
+        // Caller asked for fewer bytes than one group decodes to
+        carryLen_ = decoder_.decode(in_ + inPos_, inLen_ - inPos_, consumed, carry_, sizeof(carry_));
+        carryPos_ = 0;
+      }
+      inPos_ += consumed;
+      if (decoder_.failed()) {
+        failed_ = true;
+        break;
       }
     }
 
-    // Shift remaining bytes to start
-    size_t remaining = bufLen_ - processed;
-    if (remaining > 0) {
-      for (size_t i = 0; i < remaining; i++) {
-        buf_[i] = buf_[processed + i];
-      }
+    if (failed_) return -1;
+    if (produced == 0 && ended_ && inPos_ == inLen_ && !decoder_.finish(nullptr)) {
+      failed_ = true;
+      return -1;
+    }
+    return static_cast<int>(produced);
+  }
+
+  bool failed() const { return failed_; }
+
+ private:
+  static constexpr size_t kInSize = 512;
+  ByteSource& text_;
+  Base64Decoder decoder_;
+  char in_[kInSize] = {};
+  size_t inPos_ = 0;
+  size_t inLen_ = 0;
+  uint8_t carry_[3] = {};
+  size_t carryPos_ = 0;
+  size_t carryLen_ = 0;
+  bool ended_ = false;
+  bool failed_ = false;
+
+  bool refill() {
+    const int n = text_.read(reinterpret_cast<uint8_t*>(in_), kInSize);
+    inPos_ = 0;
+    inLen_ = 0;
+    if (n < 0) {
+      failed_ = true;
+      return false;
+    }
+    if (n == 0) {
+      ended_ = true;
+      return false;
+    }
+    inLen_ = static_cast<size_t>(n);
+    if (const void* close = memchr(in_, '<', inLen_)) {
+      inLen_ = static_cast<size_t>(static_cast<const char*>(close) - in_);
+      ended_ = true;
     }
-    bufLen_ = remaining;
+    return true;
   }
 };
@@ -12,33 +12,63 @@
 #include <FsHelpers.h>
 #include <ImageConverter.h>
 #include <Logging.h>
+#include <XmlNames.h>
 
 #include "Base64Decoder.h"
+#include "Fb2Parser.h"
+#include "Fb2Source.h"
 
 #define TAG "FB2"
 #include <SDCardManager.h>
 #include <Serialization.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace {
-constexpr uint8_t kMetaCacheVersion = 6;
+constexpr uint8_t kMetaCacheVersion = 8;
 constexpr char kMetaCacheFile[] = "/meta.bin";
-constexpr char kSectionFilePrefix[] = "/section_";
-constexpr char kSectionFileSuffix[] = ".fb2";
-constexpr char kSectionCacheMarker[] = "/.section_cache_v2";
+constexpr char kInflateIndexFile[] = "/inflate.idx";  // Checkpoints into a .fb2.zip (see Fb2Source)
+constexpr char kDefaultXmlDeclaration[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+// Wrapper that makes one <section> byte range a complete FB2 document
+constexpr char kSectionPrologue[] =
+    "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\" "
+    "xmlns:l=\"http://www.w3.org/1999/xlink\">\n"
+    "  <body>\n";
+constexpr char kSectionEpilogue[] = "\n  </body>\n</FictionBook>\n";
+
+// Section copies written by earlier versions (replaced by in-place byte ranges)
+constexpr char kLegacySectionFilePrefix[] = "/section_";
+constexpr char kLegacySectionFileSuffix[] = ".fb2";
+constexpr char kLegacySectionCacheMarker[] = "/.section_cache_v2";
+
+uint32_t binaryIdHash(const char* id) {
+  uint32_t hash = 2166136261u;
+  for (; *id; id++) {
+    hash ^= static_cast<uint8_t>(*id);
+    hash *= 16777619u;
+  }
+  return hash;
+}
 }  // namespace
 
 std::string Fb2::metaCachePath() const { return cachePath + kMetaCacheFile; }
 
+std::string Fb2::inflateIndexPath() const { return cachePath + kInflateIndexFile; }
+
 Fb2::Fb2(std::string filepath, const std::string& cacheDir)
     : filepath(std::move(filepath)), fileSize(0), loaded(false) {
   // Create cache key based on filepath (same as Epub/Xtc/Txt)
   cachePath = cacheDir + "/fb2_" + std::to_string(std::hash<std::string>{}(this->filepath));
 
-  // Extract title from filename
+  // Extract title from filename (without the .fb2 of a .fb2.zip as well)
   size_t lastSlash = this->filepath.find_last_of('/');
   size_t lastDot = this->filepath.find_last_of('.');
+  if (Fb2Source::isZipped(this->filepath) && lastDot != std::string::npos && lastDot > 0) {
+    const size_t innerDot = this->filepath.find_last_of('.', lastDot - 1);
+    if (innerDot != std::string::npos && (lastSlash == std::string::npos || innerDot > lastSlash)) lastDot = innerDot;
+  }
 
   if (lastSlash == std::string::npos) {
     lastSlash = 0;
@@ -72,42 +102,24 @@ bool Fb2::load() {
   if (loadMetaCache() && !sectionOffsets_.empty()) {
     loaded = true;
     LOG_INF(TAG, "Loaded from cache: %s (title: '%s', author: '%s')", filepath.c_str(), title.c_str(), author.c_str());
-    if (!generateSectionFiles()) {
-      LOG_ERR(TAG, "Failed to generate section files (cache path)");
-    }
     return true;
   }
 
-  FsFile file;
-  if (!SdMan.openFileForRead("FB2", filepath, file)) {
-    LOG_ERR(TAG, "Failed to open file");
-    return false;
-  }
-
-  fileSize = file.size();
-  file.close();
-
   // Clear author before re-parsing — unlike title/language (cleared by their start
   // tags), author uses += accumulation and would duplicate if already set from cache
   author.clear();
 
-  // Stream-parse in chunks (file may exceed available RAM)
+  // Single streaming pass (file may exceed available RAM): metadata, TOC,
+  // section byte ranges and the cover offset
   if (!parseXmlStream()) {
     LOG_ERR(TAG, "Failed to parse XML");
     return false;
   }
 
-  if (!scanSectionOffsets()) {
-    LOG_ERR(TAG, "Failed to scan section offsets");
-  }
-
   filterNestedSections();
 
   saveMetaCache();
-
-  if (!generateSectionFiles()) {
-    LOG_ERR(TAG, "Failed to generate section files");
-  }
+  removeLegacySectionFiles();
 
   // Free TOC strings, rebuild as compact LUT from cache
   std::vector<TocItem>().swap(tocItems_);
@@ -133,14 +145,6 @@ bool Fb2::loadMetadataOnly() {
     return true;
   }
 
-  FsFile file;
-  if (!SdMan.openFileForRead("FB2", filepath, file)) {
-    LOG_ERR(TAG, "Failed to open file");
-    return false;
-  }
-  fileSize = file.size();
-  file.close();
-
   metadataOnly_ = true;
   bool ok = parseXmlStream();
   metadataOnly_ = false;
@@ -169,27 +173,35 @@ void XMLCALL Fb2::startElement(void* userData, const XML_Char* name, const XML_C
   }
 
   // FB2 uses namespaces, strip prefix if present
-  const char* tag = strrchr(name, ':');
-  if (tag) {
-    tag++;
-  } else {
-    tag = name;
-  }
+  const XmlName tag = lookupXmlLocalName(name);
 
-  // Skip binary content (base64-encoded images), but capture cover content-type
-  if (strcmp(tag, "binary") == 0) {
+  // Skip binary content (base64-encoded images), but record where it starts and capture cover content-type
+  if (tag == XmlName::Binary) {
+    if (!self->metadataOnly_ && atts) {
+      for (int i = 0; atts[i]; i += 2) {
+        if (lookupXmlName(atts[i]) == XmlName::Id && atts[i + 1]) {
+          // Byte count of the current event is the whole start tag
+          BinaryRef ref;
+          ref.idHash = binaryIdHash(atts[i + 1]);
+          ref.dataOffset = static_cast<uint32_t>(XML_GetCurrentByteIndex(self->xmlParser_) +
+                                                 XML_GetCurrentByteCount(self->xmlParser_) + self->bomSkip_);
+          self->binaries_.push_back(ref);
+          break;
+        }
+      }
+    }
     if (!self->coverRef.empty() && atts) {
       bool isTargetBinary = false;
       for (int i = 0; atts[i]; i += 2) {
-        if (strcmp(atts[i], "id") == 0 && atts[i + 1] && self->coverRef == atts[i + 1]) {
+        if (lookupXmlName(atts[i]) == XmlName::Id && atts[i + 1] && self->coverRef == atts[i + 1]) {
           isTargetBinary = true;
           break;
         }
       }
       if (isTargetBinary) {
-        self->coverBinaryOffset_ = XML_GetCurrentByteIndex(self->xmlParser_);
+        self->coverBinaryOffset_ = XML_GetCurrentByteIndex(self->xmlParser_) + static_cast<int64_t>(self->bomSkip_);
         for (int i = 0; atts[i]; i += 2) {
-          if (strcmp(atts[i], "content-type") == 0 && atts[i + 1]) {
+          if (lookupXmlName(atts[i]) == XmlName::ContentType && atts[i + 1]) {
             self->coverContentType = atts[i + 1];
             break;
           }
@@ -201,28 +213,28 @@ void XMLCALL Fb2::startElement(void* userData, const XML_Char* name, const XML_C
   }
 
   // Track <title-info> to only collect metadata from it (not <document-info>)
-  if (strcmp(tag, "title-info") == 0) {
+  if (tag == XmlName::TitleInfo) {
     self->inTitleInfo = true;
   }
 
   // Description / Metadata (only from <title-info>)
-  if (strcmp(tag, "book-title") == 0 && self->inTitleInfo) {
+  if (tag == XmlName::BookTitle && self->inTitleInfo) {
     self->inBookTitle = true;
     self->title.clear();
-  } else if (strcmp(tag, "author") == 0 && self->inTitleInfo) {
+  } else if (tag == XmlName::Author && self->inTitleInfo) {
     self->inAuthor = true;
     self->currentAuthorFirst.clear();
     self->currentAuthorLast.clear();
-  } else if (strcmp(tag, "first-name") == 0 && self->inAuthor) {
+  } else if (tag == XmlName::FirstName && self->inAuthor) {
     self->inFirstName = true;
-  } else if (strcmp(tag, "last-name") == 0 && self->inAuthor) {
+  } else if (tag == XmlName::LastName && self->inAuthor) {
     self->inLastName = true;
-  } else if (strcmp(tag, "lang") == 0 && self->inTitleInfo) {
+  } else if (tag == XmlName::Lang && self->inTitleInfo) {
     self->inLang = true;
     self->language.clear();
-  } else if (strcmp(tag, "coverpage") == 0) {
+  } else if (tag == XmlName::Coverpage) {
     self->inCoverPage = true;
-  } else if (strcmp(tag, "image") == 0 && self->inCoverPage) {
+  } else if (tag == XmlName::Image && self->inCoverPage) {
     // Look for l:href or href attribute
     if (atts) {
       for (int i = 0; atts[i]; i += 2) {
@@ -230,13 +242,7 @@ void XMLCALL Fb2::startElement(void* userData, const XML_Char* name, const XML_C
         const char* attrValue = atts[i + 1];
 
         // Handle both l:href and href
-        const char* attr = strrchr(attrName, ':');
-        if (attr)
-          attr++;
-        else
-          attr = attrName;
-
-        if ((strcmp(attr, "href") == 0 || strcmp(attrName, "l:href") == 0) && attrValue) {
+        if (lookupXmlLocalName(attrName) == XmlName::Href && attrValue) {
           // Store the reference (remove # prefix)
           if (attrValue[0] == '#') {
             self->coverRef = attrValue + 1;
@@ -248,12 +254,19 @@ void XMLCALL Fb2::startElement(void* userData, const XML_Char* name, const XML_C
         }
       }
     }
-  } else if (strcmp(tag, "body") == 0) {
+  } else if (tag == XmlName::Body) {
     self->bodyCount_++;
     self->inBody = (self->bodyCount_ == 1);
-  } else if (strcmp(tag, "section") == 0 && self->inBody) {
+  } else if (tag == XmlName::Section && self->inBody) {
     self->sectionCounter_++;
-  } else if (strcmp(tag, "title") == 0 && self->inBody && self->sectionCounter_ > 0) {
+    if (!self->metadataOnly_) {
+      // Byte index points at '<' of the start tag
+      SectionOffset off;
+      off.startOffset = static_cast<uint32_t>(XML_GetCurrentByteIndex(self->xmlParser_) + self->bomSkip_);
+      self->sectionOffsets_.push_back(off);
+      self->openSections_.emplace_back(static_cast<int>(self->sectionOffsets_.size()) - 1, self->depth);
+    }
+  } else if (tag == XmlName::Title && self->inBody && self->sectionCounter_ > 0) {
     self->inSectionTitle_ = true;
     self->sectionTitleDepth_ = self->depth;
     self->currentSectionTitle_.clear();
@@ -264,14 +277,9 @@ void XMLCALL Fb2::endElement(void* userData, const XML_Char* name) {
   auto* self = static_cast<Fb2*>(userData);
 
   // FB2 uses namespaces, strip prefix if present
-  const char* tag = strrchr(name, ':');
-  if (tag) {
-    tag++;
-  } else {
-    tag = name;
-  }
+  const XmlName tag = lookupXmlLocalName(name);
 
-  if (strcmp(tag, "title-info") == 0) {
+  if (tag == XmlName::TitleInfo) {
     self->inTitleInfo = false;
     if (self->metadataOnly_) {
       XML_StopParser(self->xmlParser_, XML_FALSE);
@@ -279,13 +287,13 @@ void XMLCALL Fb2::endElement(void* userData, const XML_Char* name) {
     }
   }
 
-  if (strcmp(tag, "book-title") == 0) {
+  if (tag == XmlName::BookTitle) {
     self->inBookTitle = false;
-  } else if (strcmp(tag, "first-name") == 0) {
+  } else if (tag == XmlName::FirstName) {
     self->inFirstName = false;
-  } else if (strcmp(tag, "last-name") == 0) {
+  } else if (tag == XmlName::LastName) {
     self->inLastName = false;
-  } else if (strcmp(tag, "author") == 0 && self->inAuthor) {
+  } else if (tag == XmlName::Author && self->inAuthor) {
     // Combine first and last name for author
     std::string fullAuthor;
     if (!self->currentAuthorFirst.empty()) {
@@ -306,16 +314,23 @@ void XMLCALL Fb2::endElement(void* userData, const XML_Char* name) {
     self->inAuthor = false;
     self->currentAuthorFirst.clear();
     self->currentAuthorLast.clear();
-  } else if (strcmp(tag, "lang") == 0 && self->inLang) {
+  } else if (tag == XmlName::Lang && self->inLang) {
     self->inLang = false;
-  } else if (strcmp(tag, "coverpage") == 0) {
+  } else if (tag == XmlName::Coverpage) {
     self->inCoverPage = false;
-  } else if (strcmp(tag, "binary") == 0) {
+  } else if (tag == XmlName::Binary) {
     // Exit binary tag - stop skipping
     self->skipUntilDepth = INT_MAX;
-  } else if (strcmp(tag, "body") == 0) {
+  } else if (tag == XmlName::Body) {
     self->inBody = false;
-  } else if (strcmp(tag, "title") == 0 && self->inSectionTitle_ && self->depth == self->sectionTitleDepth_) {
+  } else if (tag == XmlName::Section && !self->openSections_.empty() &&
+             self->openSections_.back().second == self->depth) {
+    // Include the full </name> closing tag (byte index points at its '<')
+    const int sectionIdx = self->openSections_.back().first;
+    self->openSections_.pop_back();
+    self->sectionOffsets_[sectionIdx].endOffset = static_cast<uint32_t>(
+        XML_GetCurrentByteIndex(self->xmlParser_) + self->bomSkip_ + strlen(name) + 3);
+  } else if (tag == XmlName::Title && self->inSectionTitle_ && self->depth == self->sectionTitleDepth_) {
     self->inSectionTitle_ = false;
 
     // Trim whitespace and replace newlines with spaces
@@ -375,10 +390,13 @@ void XMLCALL Fb2::characterData(void* userData, const XML_Char* s, int len) {
 bool Fb2::parseXmlStream() {
   LOG_INF(TAG, "Starting streaming XML parse");
 
-  FsFile file;
-  if (!SdMan.openFileForRead("FB2", filepath, file)) {
+  // A full pass indexes inflate checkpoints of a .fb2.zip for the section seeks later
+  Fb2Source source;
+  if (!source.open(filepath, metadataOnly_ ? "" : inflateIndexPath())) {
+    LOG_ERR(TAG, "Failed to open file");
     return false;
   }
+  fileSize = source.size();
 
   constexpr size_t kChunkSize = 4096;
   uint8_t buffer[kChunkSize];
@@ -387,18 +405,38 @@ bool Fb2::parseXmlStream() {
   // force Expat to UTF-8 even when the declaration says CP1251/KOI8-R
   // (mis-declared files). Genuine single-byte encodings fall through to the
   // expatUnknownEncodingHandler path below.
-  const size_t peekBytes = file.read(buffer, kChunkSize);
+  const int peekRead = source.read(buffer, kChunkSize);
+  const size_t peekBytes = peekRead > 0 ? static_cast<size_t>(peekRead) : 0;
   const char* explicitEncoding = nullptr;
   size_t bomSkip = 0;
   if (peekBytes > 0 && detectEncoding(buffer, peekBytes, bomSkip) == Encoding::Utf8) {
     explicitEncoding = "UTF-8";
   }
-  file.seek(bomSkip);
+  if (!source.seek(bomSkip)) {
+    LOG_ERR(TAG, "Failed to rewind file");
+    return false;
+  }
+  bomSkip_ = bomSkip;
+
+  // Keep the declaration (and its encoding) for the section prologue
+  xmlDeclaration_ = kDefaultXmlDeclaration;
+  for (size_t j = bomSkip; j + 1 < peekBytes && j < bomSkip + 256; j++) {
+    if (buffer[j] == '?' && buffer[j + 1] == '>') {
+      if (memcmp(buffer + bomSkip, "<?xml", 5) == 0) {
+        xmlDeclaration_.assign(reinterpret_cast<const char*>(buffer + bomSkip), j + 2 - bomSkip);
+        xmlDeclaration_ += "\n";
+      }
+      break;
+    }
+  }
+
+  sectionOffsets_.clear();
+  openSections_.clear();
+  binaries_.clear();
 
   xmlParser_ = XML_ParserCreate(explicitEncoding);
   if (!xmlParser_) {
     LOG_ERR(TAG, "Failed to create XML parser");
-    file.close();
     return false;
   }
 
@@ -407,14 +445,25 @@ bool Fb2::parseXmlStream() {
   XML_SetElementHandler(xmlParser_, startElement, endElement);
   XML_SetCharacterDataHandler(xmlParser_, characterData);
 
+  if (!metadataOnly_) {
+    setupCacheDir();
+    source.recordCheckpoints();
+  }
+
   bool success = true;
 
-  while (file.available() > 0) {
-    const size_t bytesRead = file.read(buffer, kChunkSize);
-    if (bytesRead == 0) break;
+  while (source.available() > 0) {
+    const int bytesRead = source.read(buffer, kChunkSize);
+    if (bytesRead <= 0) {
+      if (bytesRead < 0) {
+        LOG_ERR(TAG, "Read error at %u", static_cast<unsigned>(source.position()));
+        success = false;
+      }
+      break;
+    }
 
-    const int done = (file.available() == 0) ? 1 : 0;
-    if (XML_Parse(xmlParser_, reinterpret_cast<const char*>(buffer), static_cast<int>(bytesRead), done) ==
+    const int done = (source.available() == 0) ? 1 : 0;
+    if (XML_Parse(xmlParser_, reinterpret_cast<const char*>(buffer), bytesRead, done) ==
         XML_STATUS_ERROR) {
       if (metadataOnly_ && XML_GetErrorCode(xmlParser_) == XML_ERROR_ABORTED) {
         break;
@@ -425,9 +474,12 @@ bool Fb2::parseXmlStream() {
     }
   }
 
-  file.close();
+  source.finishCheckpoints(success);
+  source.close();
 
   if (success) {
+    std::sort(binaries_.begin(), binaries_.end(),
+              [](const BinaryRef& a, const BinaryRef& b) { return a.idHash < b.idHash; });
     postProcessMetadata();
   }
 
@@ -436,132 +488,6 @@ bool Fb2::parseXmlStream() {
   return success;
 }
 
-bool Fb2::scanSectionOffsets() {
-  LOG_INF(TAG, "Scanning section offsets");
-
-  FsFile file;
-  if (!SdMan.openFileForRead("FB2", filepath, file)) {
-    return false;
-  }
-
-  constexpr size_t kChunkSize = 4096;
-  uint8_t buffer[kChunkSize];
-
-  const size_t peekBytes = file.read(buffer, kChunkSize);
-  const char* explicitEncoding = nullptr;
-  size_t bomSkip = 0;
-  if (peekBytes > 0 && detectEncoding(buffer, peekBytes, bomSkip) == Encoding::Utf8) {
-    explicitEncoding = "UTF-8";
-  }
-  file.seek(bomSkip);
-
-  struct SectionScanCtx {
-    std::vector<SectionOffset>* offsets;
-    int depth = 0;
-    int skipUntilDepth = INT_MAX;
-    bool inBody = false;
-    int bodyCount = 0;
-    XML_Parser parser = nullptr;
-    std::vector<int> sectionStack;  // Tracks open <section> → section index
-  };
-
-  SectionScanCtx ctx;
-  ctx.offsets = &sectionOffsets_;
-  sectionOffsets_.clear();
-
-  XML_Parser parser = XML_ParserCreate(explicitEncoding);
-  if (!parser) {
-    LOG_ERR(TAG, "Failed to create section scanner parser");
-    file.close();
-    return false;
-  }
-  ctx.parser = parser;
-
-  auto scanStart = [](void* userData, const XML_Char* name, const XML_Char** atts) {
-    (void)atts;
-    auto* c = static_cast<SectionScanCtx*>(userData);
-    c->depth++;
-    if (c->depth >= 100) return;
-    if (c->skipUntilDepth < c->depth) return;
-
-    const char* tag = strrchr(name, ':');
-    if (tag)
-      tag++;
-    else
-      tag = name;
-
-    if (strcmp(tag, "binary") == 0) {
-      c->skipUntilDepth = c->depth - 1;
-      return;
-    }
-    if (strcmp(tag, "body") == 0) {
-      c->bodyCount++;
-      c->inBody = (c->bodyCount == 1);
-      return;
-    }
-    if (strcmp(tag, "section") == 0 && c->inBody) {
-      int64_t byteIdx = XML_GetCurrentByteIndex(c->parser);
-      if (byteIdx >= 0) {
-        SectionOffset off;
-        off.startOffset = static_cast<uint32_t>(byteIdx);
-        c->offsets->push_back(off);
-        c->sectionStack.push_back(static_cast<int>(c->offsets->size()) - 1);
-      }
-    }
-  };
-
-  auto scanEnd = [](void* userData, const XML_Char* name) {
-    auto* c = static_cast<SectionScanCtx*>(userData);
-    const char* tag = strrchr(name, ':');
-    if (tag)
-      tag++;
-    else
-      tag = name;
-
-    if (strcmp(tag, "binary") == 0) {
-      c->skipUntilDepth = INT_MAX;
-    }
-    if (strcmp(tag, "body") == 0) {
-      c->inBody = false;
-    }
-    if (strcmp(tag, "section") == 0 && c->inBody && !c->sectionStack.empty()) {
-      int sectionIdx = c->sectionStack.back();
-      c->sectionStack.pop_back();
-      int64_t byteIdx = XML_GetCurrentByteIndex(c->parser);
-      if (byteIdx >= 0) {
-        // Include the full </name> closing tag (XML_GetCurrentByteIndex points to '<')
-        uint32_t endOffset = static_cast<uint32_t>(byteIdx) + static_cast<uint32_t>(strlen(name)) + 3;
-        (*c->offsets)[sectionIdx].endOffset = endOffset;
-      }
-    }
-    c->depth--;
-  };
-
-  XML_SetUserData(parser, &ctx);
-  XML_SetUnknownEncodingHandler(parser, expatUnknownEncodingHandler, nullptr);
-  XML_SetElementHandler(parser, scanStart, scanEnd);
-
-  bool success = true;
-  while (file.available() > 0) {
-    const size_t bytesRead = file.read(buffer, kChunkSize);
-    if (bytesRead == 0) break;
-    const int done = (file.available() == 0) ? 1 : 0;
-    if (XML_Parse(parser, reinterpret_cast<const char*>(buffer), static_cast<int>(bytesRead), done) ==
-        XML_STATUS_ERROR) {
-      success = false;
-      break;
-    }
-  }
-
-  file.close();
-  XML_ParserFree(parser);
-
-  if (success) {
-    LOG_INF(TAG, "Scanned %u section offsets", static_cast<unsigned int>(sectionOffsets_.size()));
-  }
-  return success;
-}
-
 void Fb2::filterNestedSections() {
   if (sectionOffsets_.size() <= 1) return;
 
@@ -626,202 +552,47 @@ void Fb2::filterNestedSections() {
           static_cast<unsigned int>(sectionOffsets_.size()));
 }
 
-bool Fb2::generateSectionFiles() {
-  if (sectionOffsets_.empty()) {
-    LOG_INF(TAG, "No sections to generate");
-    return true;
-  }
-
-  setupCacheDir();
-
-  // Drop stale section files when the cache marker is missing.
-  const std::string markerPath = cachePath + kSectionCacheMarker;
-  if (!SdMan.exists(markerPath.c_str())) {
-    for (size_t i = 0; i < sectionOffsets_.size(); i++) {
-      const std::string oldPath = sectionFilePath(static_cast<int>(i));
-      if (SdMan.exists(oldPath.c_str())) {
-        SdMan.remove(oldPath.c_str());
-      }
-    }
-  }
-
-  std::string xmlDecl = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-  FsFile declFile;
-  if (SdMan.openFileForRead("FB2", filepath, declFile)) {
-    char declBuf[256];
-    size_t declRead = declFile.read(declBuf, sizeof(declBuf));
-    for (size_t j = 0; j + 1 < declRead; j++) {
-      if (declBuf[j] == '?' && declBuf[j + 1] == '>') {
-        xmlDecl.assign(declBuf, j + 2);
-        xmlDecl += "\n";
-        break;
-      }
-    }
-    declFile.close();
-  }
-
-  const std::string wrapperStart =
-      "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\" "
-      "xmlns:l=\"http://www.w3.org/1999/xlink\">\n"
-      "  <body>\n";
-  const std::string wrapperEnd = "  </body>\n</FictionBook>\n";
-
-  // Stored offsets are hints; the actual <section / </section> tag bytes are
-  // authoritative — tolerant of small offset drift (e.g. BOM-stripped expat indices).
-  // We track <section> nesting depth across reads so an inner close tag does not
-  // truncate the outer section's copy.
-  constexpr size_t kStartBackoff = 16;
-  constexpr size_t kAnchorWindowSize = 128;
-  constexpr char kStartTag[] = "<section";
-  constexpr size_t kStartTagLen = sizeof(kStartTag) - 1;
-  constexpr char kEndTag[] = "</section>";
-  constexpr size_t kEndTagLen = sizeof(kEndTag) - 1;
-  constexpr size_t kCopyBufSize = 4096;
-  constexpr uint32_t kCopyOverhead = 1024;
-
-  bool allOk = true;
-  for (size_t i = 0; i < sectionOffsets_.size(); i++) {
-    const std::string outPath = sectionFilePath(static_cast<int>(i));
-
-    // Skip if already exists
-    if (SdMan.exists(outPath.c_str())) {
-      continue;
-    }
-
-    FsFile outFile;
-    if (!SdMan.openFileForWrite("FB2", outPath, outFile)) {
-      LOG_ERR(TAG, "Failed to create section file: %s", outPath.c_str());
-      allOk = false;
-      continue;
-    }
-
-    outFile.write(xmlDecl.c_str(), xmlDecl.size());
-    outFile.write(wrapperStart.c_str(), wrapperStart.size());
-
-    bool sectionWritten = false;
-    FsFile inFile;
-    if (SdMan.openFileForRead("FB2", filepath, inFile)) {
-      const uint32_t hintStart = sectionOffsets_[i].startOffset;
-      const uint32_t hintEnd = sectionOffsets_[i].endOffset;
-
-      // Anchor the start: scan a small window around the hint for "<section".
-      const uint32_t windowStart = (hintStart > kStartBackoff) ? (hintStart - kStartBackoff) : 0;
-      uint32_t actualStart = 0;
-      bool startAnchored = false;
-      if (inFile.seek(windowStart)) {
-        uint8_t windowBuf[kAnchorWindowSize];
-        const size_t winRead = inFile.read(windowBuf, kAnchorWindowSize);
-        for (size_t j = 0; j + kStartTagLen <= winRead; j++) {
-          if (memcmp(windowBuf + j, kStartTag, kStartTagLen) == 0) {
-            actualStart = windowStart + static_cast<uint32_t>(j);
-            startAnchored = true;
-            break;
-          }
-        }
-      }
-
-      if (!startAnchored) {
-        LOG_ERR(TAG, "section %u: <section start tag not found near offset %u", static_cast<unsigned int>(i),
-                static_cast<unsigned int>(windowStart));
-      } else if (!inFile.seek(actualStart)) {
-        LOG_ERR(TAG, "section %u: seek to %u failed", static_cast<unsigned int>(i),
-                static_cast<unsigned int>(actualStart));
-      } else {
-        // Cap the copy so a corrupt input cannot run away.
-        const uint32_t span = (hintEnd > actualStart) ? (hintEnd - actualStart) : 0;
-        const uint32_t copyCap = span + kCopyOverhead;
-
-        uint8_t copyBuf[kCopyBufSize + kEndTagLen];
-        uint32_t consumed = 0;
-        size_t carry = 0;
-        bool foundClose = false;
-        int depth = 0;
-
-        while (consumed < copyCap) {
-          size_t maxRead = copyCap - consumed;
-          if (maxRead > kCopyBufSize) maxRead = kCopyBufSize;
-          const size_t n = inFile.read(copyBuf + carry, maxRead);
-          if (n == 0) break;
-          consumed += static_cast<uint32_t>(n);
-          const size_t bufLen = carry + n;
-
-          size_t closeAt = SIZE_MAX;
-          size_t j = 0;
-          while (j + kStartTagLen <= bufLen) {
-            if (j + kEndTagLen <= bufLen && memcmp(copyBuf + j, kEndTag, kEndTagLen) == 0) {
-              depth--;
-              if (depth <= 0) {
-                closeAt = j;
-                break;
-              }
-              j += kEndTagLen;
-            } else if (memcmp(copyBuf + j, kStartTag, kStartTagLen) == 0) {
-              depth++;
-              j += kStartTagLen;
-            } else {
-              j++;
-            }
-          }
-
-          if (closeAt != SIZE_MAX) {
-            outFile.write(copyBuf, closeAt + kEndTagLen);
-            foundClose = true;
-            break;
-          }
+void Fb2::removeLegacySectionFiles() const {
+  const std::string markerPath = cachePath + kLegacySectionCacheMarker;
+  if (!SdMan.exists(markerPath.c_str())) return;
 
-          // Carry last (kEndTagLen-1) bytes — a tag may straddle a read boundary.
-          if (bufLen > kEndTagLen - 1) {
-            const size_t writeLen = bufLen - (kEndTagLen - 1);
-            outFile.write(copyBuf, writeLen);
-            carry = kEndTagLen - 1;
-            memmove(copyBuf, copyBuf + writeLen, carry);
-          } else {
-            carry = bufLen;
-          }
-        }
-
-        if (foundClose) {
-          sectionWritten = true;
-        } else {
-          LOG_ERR(TAG, "section %u: </section> close tag not found within %u byte cap", static_cast<unsigned int>(i),
-                  static_cast<unsigned int>(copyCap));
-        }
-      }
-      inFile.close();
-    }
-
-    if (!sectionWritten) {
-      outFile.close();
-      SdMan.remove(outPath.c_str());
-      allOk = false;
-      continue;
-    }
-
-    outFile.write(wrapperEnd.c_str(), wrapperEnd.size());
-    outFile.close();
-  }
-
-  if (allOk) {
-    FsFile marker;
-    if (SdMan.openFileForWrite("FB2", markerPath, marker)) {
-      marker.close();
-    }
+  int removed = 0;
+  for (;; removed++) {
+    const std::string path = cachePath + kLegacySectionFilePrefix + std::to_string(removed) + kLegacySectionFileSuffix;
+    if (!SdMan.exists(path.c_str())) break;
+    SdMan.remove(path.c_str());
   }
-
-  LOG_INF(TAG, "Generated %u section files (allOk=%d)", static_cast<unsigned int>(sectionOffsets_.size()),
-          allOk ? 1 : 0);
-  return allOk;
+  SdMan.remove(markerPath.c_str());
+  LOG_INF(TAG, "Removed %d legacy section files", removed);
 }
 
-std::string Fb2::sectionFilePath(int sectionIndex) const {
-  return cachePath + kSectionFilePrefix + std::to_string(sectionIndex) + kSectionFileSuffix;
+uint32_t Fb2::getSectionSize(const int sectionIndex) const {
+  if (sectionIndex < 0 || sectionIndex >= static_cast<int>(sectionOffsets_.size())) return 0;
+  const SectionOffset& off = sectionOffsets_[sectionIndex];
+  const uint32_t end = off.endOffset > off.startOffset ? off.endOffset : static_cast<uint32_t>(fileSize);
+  return end > off.startOffset ? end - off.startOffset : 0;
 }
 
-std::string Fb2::getSectionPath(int sectionIndex) const {
-  if (sectionIndex < 0 || sectionIndex >= static_cast<int>(sectionOffsets_.size())) {
-    return filepath;  // Fallback to original file
+void Fb2::prepareSectionParser(Fb2Parser& parser, const int sectionIndex, const std::string& imageCachePath) const {
+  parser.setInflateIndex(inflateIndexPath());
+  if (!imageCachePath.empty() && !binaries_.empty()) {
+    parser.setImageSource(imageCachePath,
+                          [this](const char* id, uint32_t& dataOffset) { return findBinary(id, dataOffset); });
   }
-  return sectionFilePath(sectionIndex);
+  const uint32_t length = getSectionSize(sectionIndex);
+  if (length == 0) return;
+  parser.setByteRange(sectionOffsets_[sectionIndex].startOffset, length, xmlDeclaration_ + kSectionPrologue,
+                      kSectionEpilogue);
+}
+
+bool Fb2::findBinary(const char* id, uint32_t& dataOffset) const {
+  if (!id) return false;
+  const uint32_t hash = binaryIdHash(id);
+  const auto it = std::lower_bound(binaries_.begin(), binaries_.end(), hash,
+                                   [](const BinaryRef& ref, const uint32_t h) { return ref.idHash < h; });
+  if (it == binaries_.end() || it->idHash != hash) return false;
+  dataOffset = it->dataOffset;
+  return true;
 }
 
 int Fb2::getSectionForTocEntry(int tocIndex) const {
@@ -873,17 +644,21 @@ bool Fb2::clearCache() const {
 }
 
 void Fb2::setupCacheDir() const {
-  if (SdMan.exists(cachePath.c_str())) {
-    return;
+  if (!SdMan.exists(cachePath.c_str())) {
+    // Create directories recursively
+    for (size_t i = 1; i < cachePath.length(); i++) {
+      if (cachePath[i] == '/') {
+        SdMan.mkdir(cachePath.substr(0, i).c_str());
+      }
+    }
+    SdMan.mkdir(cachePath.c_str());
   }
 
-  // Create directories recursively
-  for (size_t i = 1; i < cachePath.length(); i++) {
-    if (cachePath[i] == '/') {
-      SdMan.mkdir(cachePath.substr(0, i).c_str());
-    }
+  // Converted inline images (see Fb2Parser::setImageSource)
+  const std::string imagesDir = cachePath + "/images";
+  if (!binaries_.empty() && !SdMan.exists(imagesDir.c_str())) {
+    SdMan.mkdir(imagesDir.c_str());
   }
-  SdMan.mkdir(cachePath.c_str());
 }
 
 std::string Fb2::getCoverBmpPath() const { return cachePath + "/cover.bmp"; }
@@ -902,91 +677,55 @@ std::string Fb2::findCoverImage(const std::function<bool()>& shouldAbort) const
 bool Fb2::extractEmbeddedCover(const std::string& outputPath, const std::function<bool()>& shouldAbort) const {
   if (CoverHelpers::isAbortRequested(shouldAbort) || coverRef.empty() || coverBinaryOffset_ < 0) return false;
 
-  FsFile fb2File;
-  if (!SdMan.openFileForRead("FB2", filepath, fb2File)) {
+  Fb2Source source;
+  if (!source.open(filepath, inflateIndexPath())) {
     return false;
   }
 
-  if (!fb2File.seek(static_cast<uint32_t>(coverBinaryOffset_))) {
-    fb2File.close();
+  if (!source.seek(static_cast<size_t>(coverBinaryOffset_))) {
     return false;
   }
 
-  // Scan forward past '>' that closes the <binary ...> start tag.
+  // Scan forward past '>' that closes the <binary ...> start tag, a byte at a time
+  // so the base64 text starts right after it without a seek back.
   // FB2 <binary> attributes are only id and content-type (simple filenames/MIME types),
   // so '>' will not appear inside attribute values in well-formed FB2 files.
-  constexpr size_t kBufSize = 256;
-  uint8_t buf[kBufSize];
   bool foundTagEnd = false;
-  int scanLimit = 512;
-
-  while (!foundTagEnd && scanLimit > 0 && fb2File.available() > 0) {
-    if (CoverHelpers::isAbortRequested(shouldAbort)) {
-      fb2File.close();
-      return false;
-    }
-    size_t toRead = static_cast<size_t>(scanLimit) < kBufSize ? static_cast<size_t>(scanLimit) : kBufSize;
-    size_t n = fb2File.read(buf, toRead);
-    if (n == 0) break;
-    scanLimit -= static_cast<int>(n);
-
-    for (size_t i = 0; i < n; i++) {
-      if (buf[i] == '>') {
-        // Seek back to just after '>'
-        fb2File.seek(fb2File.position() - (n - i - 1));
-        foundTagEnd = true;
-        break;
-      }
-    }
+  for (int scanned = 0; scanned < 512 && !foundTagEnd; scanned++) {
+    uint8_t c;
+    if (source.read(&c, 1) != 1) break;
+    foundTagEnd = c == '>';
+  }
+  if (CoverHelpers::isAbortRequested(shouldAbort)) {
+    return false;
   }
 
   if (!foundTagEnd) {
-    fb2File.close();
     return false;
   }
 
   FsFile outFile;
   if (!SdMan.openFileForWrite("FB2", outputPath, outFile)) {
-    fb2File.close();
     return false;
   }
 
-  // Read base64 content until '</binary>' terminator.
-  // '<' cannot appear in base64, so the first '<' marks end of content.
-  Base64Decoder decoder;
-  bool done = false;
-  bool success = false;
-
-  auto writeCallback = [&outFile](const uint8_t* data, size_t sz) { return outFile.write(data, sz) == sz; };
-
-  while (!done && fb2File.available() > 0) {
-    if (CoverHelpers::isAbortRequested(shouldAbort)) break;
-    size_t n = fb2File.read(buf, kBufSize);
-    if (n == 0) break;
-
-    // Find '<' that starts the closing tag
-    size_t feedLen = n;
-    for (size_t i = 0; i < n; i++) {
-      if (buf[i] == '<') {
-        feedLen = i;
-        done = true;
-        break;
-      }
-    }
-
-    if (feedLen > 0) {
-      decoder.feed(reinterpret_cast<const char*>(buf), static_cast<int>(feedLen), writeCallback);
+  // The base64 text ends at the '<' of </binary>
+  constexpr size_t kBufSize = 256;
+  uint8_t buf[kBufSize];
+  Base64Source decoded(source);
+  bool success = true;
+  int n;
+  while ((n = decoded.read(buf, kBufSize)) > 0) {
+    if (CoverHelpers::isAbortRequested(shouldAbort) ||
+        outFile.write(buf, static_cast<size_t>(n)) != static_cast<size_t>(n)) {
+      success = false;
+      break;
     }
-
-    if (decoder.failed()) break;
-  }
-
-  if (done && !decoder.failed() && !CoverHelpers::isAbortRequested(shouldAbort)) {
-    success = decoder.finish(writeCallback);
   }
+  if (n < 0) success = false;
 
   outFile.close();
-  fb2File.close();
+  source.close();
 
   if (!success) {
     SdMan.remove(outputPath.c_str());
@@ -1074,7 +813,7 @@ bool Fb2::loadMetaCache() {
 
   if (!serialization::readString(file, title) || !serialization::readString(file, author) ||
       !serialization::readString(file, coverRef) || !serialization::readString(file, language) ||
-      !serialization::readString(file, coverContentType)) {
+      !serialization::readString(file, coverContentType) || !serialization::readString(file, xmlDeclaration_)) {
     LOG_ERR(TAG, "Failed to read meta cache strings");
     file.close();
     return false;
@@ -1139,6 +878,21 @@ bool Fb2::loadMetaCache() {
     }
   }
 
+  // Embedded binary offsets (v8+) — missing or truncated leaves images unresolved
+  binaries_.clear();
+  uint16_t binaryCount;
+  if (serialization::readPodChecked(file, binaryCount)) {
+    binaries_.reserve(binaryCount);
+    for (uint16_t i = 0; i < binaryCount; i++) {
+      BinaryRef ref;
+      if (!serialization::readPodChecked(file, ref.idHash) || !serialization::readPodChecked(file, ref.dataOffset)) {
+        binaries_.clear();
+        break;
+      }
+      binaries_.push_back(ref);
+    }
+  }
+
   file.close();
   return true;
 }
@@ -1158,6 +912,7 @@ bool Fb2::saveMetaCache() const {
   serialization::writeString(file, coverRef);
   serialization::writeString(file, language);
   serialization::writeString(file, coverContentType);
+  serialization::writeString(file, xmlDeclaration_);
   serialization::writePod(file, coverBinaryOffset_);
 
   const uint32_t size32 = static_cast<uint32_t>(fileSize);
@@ -1183,9 +938,17 @@ bool Fb2::saveMetaCache() const {
     serialization::writePod(file, off.endOffset);
   }
 
+  const uint16_t binaryCount = static_cast<uint16_t>(std::min<size_t>(binaries_.size(), UINT16_MAX));
+  serialization::writePod(file, binaryCount);
+  for (uint16_t i = 0; i < binaryCount; i++) {
+    serialization::writePod(file, binaries_[i].idHash);
+    serialization::writePod(file, binaries_[i].dataOffset);
+  }
+
   file.sync();
   file.close();
-  LOG_INF(TAG, "Saved meta cache (%u TOC items, %u sections)", tocItemCount, sectionOffsetCount);
+  LOG_INF(TAG, "Saved meta cache (%u TOC items, %u sections, %u binaries)", tocItemCount, sectionOffsetCount,
+          binaryCount);
   return true;
 }
 
@@ -1211,17 +974,16 @@ size_t Fb2::readContent(uint8_t* buffer, size_t offset, size_t length) const {
     return 0;
   }
 
-  FsFile file;
-  if (!SdMan.openFileForRead("FB2", filepath, file)) {
+  Fb2Source source;
+  if (!source.open(filepath, inflateIndexPath()) || !source.seek(offset)) {
     return 0;
   }
 
-  if (offset > 0) {
-    file.seek(offset);
+  size_t total = 0;
+  while (total < length) {
+    const int n = source.read(buffer + total, length - total);
+    if (n <= 0) break;
+    total += static_cast<size_t>(n);
   }
-
-  const size_t bytesRead = file.read(buffer, length);
-  file.close();
-
-  return bytesRead;
+  return total;
 }
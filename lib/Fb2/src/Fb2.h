@@ -2,7 +2,7 @@
  * Fb2.h
  *
  * FictionBook 2.0 XML e-book handler for Papyrix Reader
- * Provides EPUB-like interface for FB2 file handling
+ * Provides EPUB-like interface for FB2 file handling (.fb2 and .fb2.zip)
  */
 
 #pragma once
@@ -14,8 +14,11 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
+class Fb2Parser;
+
 /**
  * Fb2 File Handler
  *
@@ -33,6 +36,12 @@ class Fb2 {
     uint32_t endOffset = 0;
   };
 
+  // Embedded <binary>: FNV-1a hash of its id -> offset of its base64 text
+  struct BinaryRef {
+    uint32_t idHash = 0;
+    uint32_t dataOffset = 0;
+  };
+
  private:
   std::string filepath;
   std::string cachePath;
@@ -45,9 +54,12 @@ class Fb2 {
   size_t fileSize;
   bool loaded;
   std::vector<SectionOffset> sectionOffsets_;
+  std::string xmlDeclaration_;  // Copied into each section's prologue (keeps the encoding)
+  std::vector<BinaryRef> binaries_;  // Sorted by idHash
 
   // XML parsing state
   XML_Parser xmlParser_ = nullptr;
+  size_t bomSkip_ = 0;  // Expat byte indices are relative to the end of the BOM
   int depth = 0;
   int skipUntilDepth = INT_MAX;  // Skip content inside binary tags
 
@@ -72,6 +84,7 @@ class Fb2 {
   std::vector<uint32_t> tocLut_;
   uint16_t tocItemCount_ = 0;
   int sectionCounter_ = 0;
+  std::vector<std::pair<int, int>> openSections_;  // Open <section>: (sectionOffsets_ index, depth)
   bool inSectionTitle_ = false;
   int sectionTitleDepth_ = 0;
   std::string currentSectionTitle_;
@@ -85,14 +98,13 @@ class Fb2 {
   bool metadataOnly_ = false;
 
   bool parseXmlStream();
-  bool scanSectionOffsets();
   void filterNestedSections();
-  bool generateSectionFiles();
+  void removeLegacySectionFiles() const;
   void postProcessMetadata();
   bool loadMetaCache();
   bool saveMetaCache() const;
   std::string metaCachePath() const;
-  std::string sectionFilePath(int sectionIndex) const;
+  std::string inflateIndexPath() const;
   home_thumbnail::Result prepareCoverSource(std::string& sourcePath, bool& temporary,
                                             const std::function<bool()>& shouldAbort) const;
 
@@ -101,7 +113,8 @@ class Fb2 {
   ~Fb2();
 
   /**
-   * Load FB2 file (verify existence and parse metadata)
+   * Load FB2 file: one streaming pass collects metadata, TOC, section byte
+   * ranges and <binary> offsets (cached in meta.bin afterwards)
    * @return true on success
    */
   bool load();
@@ -169,7 +182,23 @@ class Fb2 {
 
   // Section access (for per-section spine emulation)
   uint16_t getSectionCount() const { return static_cast<uint16_t>(sectionOffsets_.size()); }
-  std::string getSectionPath(int sectionIndex) const;
+  uint32_t getSectionSize(int sectionIndex) const;
   int getSectionForTocEntry(int tocIndex) const;
+
+  /**
+   * Point a parser of this book's file at one section, parsed in place.
+   * Out-of-range indices leave the parser reading the whole file.
+   * With an image cache path, <image> references are decoded into it.
+   */
+  void prepareSectionParser(Fb2Parser& parser, int sectionIndex, const std::string& imageCachePath = "") const;
+
+  /**
+   * Find the base64 text of an embedded <binary> (image) by id
+   * @param id Binary id, as referenced by <image l:href="#id">
+   * @param dataOffset Set to the file offset just past the <binary ...> start tag
+   * @return true if the book has a binary with this id
+   */
+  bool findBinary(const char* id, uint32_t& dataOffset) const;
+  size_t getBinaryCount() const { return binaries_.size(); }
   const std::vector<SectionOffset>& getSectionOffsets() const { return sectionOffsets_; }
 };
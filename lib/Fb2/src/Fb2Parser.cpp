@@ -5,20 +5,26 @@
 #include <ExpatEncodingHandler.h>
 #include <GfxRenderer.h>
 #include <Hyphenation.h>
+#include <ImageConverter.h>
 #include <Logging.h>
 #include <Page.h>
 #include <ParsedText.h>
 #include <SDCardManager.h>
 #include <Utf8.h>
-#include <core/PerfLog.h>
+#include <XmlNames.h>
+#include <blocks/ImageBlock.h>
+#include <core/Trace.h>
 #include <esp_heap_caps.h>
 
 #ifdef ARDUINO
 #include <esp_task_wdt.h>
 #endif
 
+#include "Base64Decoder.h"
+
 #define TAG "FB2_PARSE"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <new>
@@ -29,22 +35,19 @@ constexpr size_t READ_CHUNK_SIZE = 4096;
 
 bool isWhitespace(char c) { return c == ' ' || c == '\r' || c == '\n' || c == '\t'; }
 
-const char* stripNamespace(const char* name) {
-  const char* local = strrchr(name, ':');
-  return local ? local + 1 : name;
-}
-
-const char* PARAGRAPH_TAGS[] = {"v", "text-author"};
-constexpr int NUM_PARAGRAPH_TAGS = sizeof(PARAGRAPH_TAGS) / sizeof(PARAGRAPH_TAGS[0]);
-
-const char* BLOCK_TAGS[] = {"poem", "stanza", "cite", "epigraph", "annotation"};
-constexpr int NUM_BLOCK_TAGS = sizeof(BLOCK_TAGS) / sizeof(BLOCK_TAGS[0]);
+bool isParagraphTag(const XmlName tag) { return tag == XmlName::V || tag == XmlName::TextAuthor; }
 
-bool matches(const char* tag, const char* tags[], int count) {
-  for (int i = 0; i < count; i++) {
-    if (strcmp(tag, tags[i]) == 0) return true;
+bool isBlockTag(const XmlName tag) {
+  switch (tag) {
+    case XmlName::Poem:
+    case XmlName::Stanza:
+    case XmlName::Cite:
+    case XmlName::Epigraph:
+    case XmlName::Annotation:
+      return true;
+    default:
+      return false;
   }
-  return false;
 }
 
 class ScratchReporter {
@@ -83,9 +86,7 @@ Fb2Parser::~Fb2Parser() {
     XML_ParserFree(xmlParser_);
     xmlParser_ = nullptr;
   }
-  if (resumeFile_) {
-    resumeFile_.close();
-  }
+  source_.close();
 }
 
 void Fb2Parser::reset() {
@@ -93,9 +94,7 @@ void Fb2Parser::reset() {
     XML_ParserFree(xmlParser_);
     xmlParser_ = nullptr;
   }
-  if (resumeFile_) {
-    resumeFile_.close();
-  }
+  source_.close();
   bomSkip_ = 0;
   hasMore_ = true;
   isRtl_ = false;
@@ -121,9 +120,28 @@ void Fb2Parser::reset() {
   pendingSpacing_ = 0;
   fileSize_ = 0;
   bytesConsumed_ = 0;
+  rangeRead_ = 0;
+  epilogueFed_ = false;
+  consecutiveImageFailures_ = 0;
+  pendingImage_.reset();
   anchorMap_.clear();
 }
 
+bool Fb2Parser::hasMoreInput() {
+  if (byteRangeMode_) return rangeRead_ < rangeLength_;
+  return source_.available() > 0;
+}
+
+uint32_t Fb2Parser::consumedOffset() const {
+  const int64_t index = XML_GetCurrentByteIndex(xmlParser_);
+  if (!byteRangeMode_) return static_cast<uint32_t>(index) + static_cast<uint32_t>(bomSkip_);
+
+  // Expat counts the prologue too; report progress within the section only
+  const int64_t inRange = index - static_cast<int64_t>(prologueXml_.size());
+  if (inRange <= 0) return 0;
+  return inRange > rangeLength_ ? rangeLength_ : static_cast<uint32_t>(inRange);
+}
+
 bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onPageComplete, uint32_t maxPages,
                            const AbortCallback& shouldAbort) {
   const uint32_t scratchStarted = millis();
@@ -162,7 +180,9 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
   }
 
   // RESUME PATH: parser suspended from previous maxPages stop
-  if (xmlParser_ && resumeFile_) {
+  size_t preloaded = 0;  // Bytes of the encoding peek already in buffer, parsed first
+
+  if (xmlParser_ && source_.isOpen()) {
     LOG_DBG(TAG, "Resuming parse from previous position");
 
     if (pendingSpacing_ > 0) {
@@ -170,32 +190,51 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
       pendingSpacing_ = 0;
     }
 
+    // An image that arrived at the page limit goes after the rest of its preceding text
+    if (pendingImage_) {
+      makePages();
+      if (!hitMaxPages_) placeImage(std::move(pendingImage_));
+      if (stopRequested_) {
+        bytesConsumed_ = consumedOffset();
+        hasMore_ = true;
+        return true;
+      }
+    }
+
     auto status = XML_ResumeParser(xmlParser_);
     if (status == XML_STATUS_ERROR) {
       LOG_ERR(TAG, "Resume parse error: %s", XML_ErrorString(XML_GetErrorCode(xmlParser_)));
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
       XML_ParserFree(xmlParser_);
       xmlParser_ = nullptr;
-      resumeFile_.close();
+      source_.close();
       return false;
     }
     if (status == XML_STATUS_SUSPENDED || stopRequested_) {
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
       hasMore_ = true;
       return true;
     }
   } else {
     // INIT PATH: open file, detect encoding, create parser
-    if (resumeFile_) resumeFile_.close();
-
-    if (!SdMan.openFileForRead("FB2", filepath_, resumeFile_)) {
+    if (!source_.open(filepath_, inflateIndexPath_)) {
       LOG_ERR(TAG, "Failed to open file: %s", filepath_.c_str());
       return false;
     }
 
-    fileSize_ = resumeFile_.size();
+    fileSize_ = byteRangeMode_ ? rangeLength_ : source_.size();
+    rangeRead_ = 0;
+    epilogueFed_ = false;
 
-    size_t peekBytes = resumeFile_.read(buffer, READ_CHUNK_SIZE);
+    // Byte-range mode peeks at the section itself; the BOM (if any) is only at file start
+    if (byteRangeMode_ && !source_.seek(rangeOffset_)) {
+      LOG_ERR(TAG, "Failed to seek to section at %u", rangeOffset_);
+      source_.close();
+      return false;
+    }
+    const size_t peekLimit = byteRangeMode_ ? std::min<size_t>(READ_CHUNK_SIZE, rangeLength_) : READ_CHUNK_SIZE;
+    const int peekRead = source_.read(buffer, peekLimit);
+    const size_t peekBytes = peekRead > 0 ? static_cast<size_t>(peekRead) : 0;
     const char* explicitEncoding = nullptr;
     bomSkip_ = 0;
     if (peekBytes > 0) {
@@ -204,12 +243,15 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
         explicitEncoding = "UTF-8";
       }
     }
-    resumeFile_.seekSet(bomSkip_);
+    if (byteRangeMode_) bomSkip_ = 0;
+    // The peeked bytes (minus a BOM) are the first chunk; no seek back into a zipped book
+    preloaded = peekBytes - bomSkip_;
+    if (bomSkip_ > 0) memmove(buffer, buffer + bomSkip_, preloaded);
 
     xmlParser_ = XML_ParserCreate(explicitEncoding);
     if (!xmlParser_) {
       LOG_ERR(TAG, "Failed to create XML parser");
-      resumeFile_.close();
+      source_.close();
       return false;
     }
 
@@ -219,11 +261,21 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
     XML_SetCharacterDataHandler(xmlParser_, characterData);
 
     startNewPage();
+
+    // Byte-range mode: the prologue declares the encoding and opens <FictionBook><body>
+    if (byteRangeMode_ && !prologueXml_.empty() &&
+        XML_Parse(xmlParser_, prologueXml_.c_str(), static_cast<int>(prologueXml_.size()), 0) == XML_STATUS_ERROR) {
+      LOG_ERR(TAG, "Prologue parse error: %s", XML_ErrorString(XML_GetErrorCode(xmlParser_)));
+      XML_ParserFree(xmlParser_);
+      xmlParser_ = nullptr;
+      source_.close();
+      return false;
+    }
   }
 
   uint16_t abortCheckCounter = 0;
 
-  while (resumeFile_.available() > 0) {
+  while (preloaded > 0 || hasMoreInput()) {
     if (++abortCheckCounter % 10 == 0) {
 #ifdef ARDUINO
       esp_task_wdt_reset();
@@ -231,37 +283,73 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
     }
     if (shouldAbort_ && (abortCheckCounter % 10 == 0) && shouldAbort_()) {
       LOG_INF(TAG, "Aborted by external request");
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
       XML_ParserFree(xmlParser_);
       xmlParser_ = nullptr;
-      resumeFile_.close();
+      source_.close();
       hasMore_ = true;
       return false;
     }
 
-    size_t bytesRead = resumeFile_.read(buffer, READ_CHUNK_SIZE);
-    if (bytesRead == 0) break;
+    size_t bytesRead = preloaded;
+    preloaded = 0;
+    if (bytesRead == 0) {
+      size_t toRead = READ_CHUNK_SIZE;
+      if (byteRangeMode_ && rangeLength_ - rangeRead_ < toRead) toRead = rangeLength_ - rangeRead_;
+      const int n = source_.read(buffer, toRead);
+      if (n < 0) {
+        LOG_ERR(TAG, "Read error at %u", static_cast<unsigned>(source_.position()));
+        bytesConsumed_ = consumedOffset();
+        XML_ParserFree(xmlParser_);
+        xmlParser_ = nullptr;
+        source_.close();
+        return false;
+      }
+      if (n == 0) break;
+      bytesRead = static_cast<size_t>(n);
+    }
+    rangeRead_ += static_cast<uint32_t>(bytesRead);
 
-    int done = (resumeFile_.available() == 0) ? 1 : 0;
+    int done = (!hasMoreInput() && epilogueXml_.empty()) ? 1 : 0;
     auto status = XML_Parse(xmlParser_, reinterpret_cast<const char*>(buffer), static_cast<int>(bytesRead), done);
     if (status == XML_STATUS_ERROR) {
       LOG_ERR(TAG, "Parse error at line %lu: %s", XML_GetCurrentLineNumber(xmlParser_),
               XML_ErrorString(XML_GetErrorCode(xmlParser_)));
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
       XML_ParserFree(xmlParser_);
       xmlParser_ = nullptr;
-      resumeFile_.close();
+      source_.close();
       return false;
     }
 
     if (status == XML_STATUS_SUSPENDED) {
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
       hasMore_ = true;
       return true;
     }
 
     if (stopRequested_) {
-      bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+      bytesConsumed_ = consumedOffset();
+      hasMore_ = true;
+      return true;
+    }
+  }
+
+  // Byte-range mode: close the wrapper elements. Their end tags can still emit
+  // pages, so a page limit hit here suspends like any other chunk.
+  if (byteRangeMode_ && !epilogueXml_.empty() && !epilogueFed_) {
+    epilogueFed_ = true;
+    const auto status = XML_Parse(xmlParser_, epilogueXml_.c_str(), static_cast<int>(epilogueXml_.size()), 1);
+    if (status == XML_STATUS_ERROR) {
+      LOG_ERR(TAG, "Epilogue parse error: %s", XML_ErrorString(XML_GetErrorCode(xmlParser_)));
+      bytesConsumed_ = consumedOffset();
+      XML_ParserFree(xmlParser_);
+      xmlParser_ = nullptr;
+      source_.close();
+      return false;
+    }
+    if (status == XML_STATUS_SUSPENDED || stopRequested_) {
+      bytesConsumed_ = consumedOffset();
       hasMore_ = true;
       return true;
     }
@@ -279,10 +367,10 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
     pagesCreated_++;
   }
 
-  bytesConsumed_ = static_cast<uint32_t>(XML_GetCurrentByteIndex(xmlParser_)) + static_cast<uint32_t>(bomSkip_);
+  bytesConsumed_ = consumedOffset();
   XML_ParserFree(xmlParser_);
   xmlParser_ = nullptr;
-  resumeFile_.close();
+  source_.close();
   currentTextBlock_.reset();
   currentPage_.reset();
   hasMore_ = false;
@@ -293,7 +381,7 @@ bool Fb2Parser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onP
 
 void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const XML_Char** atts) {
   auto* self = static_cast<Fb2Parser*>(userData);
-  const char* localName = stripNamespace(name);
+  const XmlName tag = lookupXmlLocalName(name);
 
   // Prevent stack overflow from deeply nested XML
   if (self->depth_ >= 100) {
@@ -306,13 +394,13 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
     return;
   }
 
-  if (strcmp(localName, "binary") == 0) {
+  if (tag == XmlName::Binary) {
     self->skipUntilDepth_ = self->depth_;
     self->depth_++;
     return;
   }
 
-  if (strcmp(localName, "body") == 0) {
+  if (tag == XmlName::Body) {
     self->bodyCount_++;
     self->inBody_ = (self->bodyCount_ == 1);
     self->depth_++;
@@ -324,7 +412,7 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
     return;
   }
 
-  if (strcmp(localName, "section") == 0) {
+  if (tag == XmlName::Section) {
     self->sectionCounter_++;
     if (!self->firstSection_) {
       // Flush current content before new section
@@ -349,7 +437,7 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
     self->firstSection_ = false;
     // Record anchor for TOC navigation: section_N → page where this section starts
     self->anchorMap_.emplace_back("section_" + std::to_string(self->sectionCounter_ - 1), self->pagesCreated_);
-  } else if (strcmp(localName, "title") == 0) {
+  } else if (tag == XmlName::Title) {
     self->inTitle_ = true;
     self->boldUntilDepth_ = std::min(self->boldUntilDepth_, self->depth_);
     self->flushPartWordBuffer();
@@ -357,7 +445,7 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
       self->makePages();
     }
     self->startNewTextBlock(TextBlock::CENTER_ALIGN);
-  } else if (strcmp(localName, "subtitle") == 0) {
+  } else if (tag == XmlName::Subtitle) {
     self->inSubtitle_ = true;
     self->boldUntilDepth_ = std::min(self->boldUntilDepth_, self->depth_);
     self->flushPartWordBuffer();
@@ -365,7 +453,7 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
       self->makePages();
     }
     self->startNewTextBlock(TextBlock::CENTER_ALIGN);
-  } else if (strcmp(localName, "p") == 0) {
+  } else if (tag == XmlName::P) {
     self->inParagraph_ = true;
     if (!self->currentTextBlock_) {
       TextBlock::BLOCK_STYLE style = self->inTitle_ || self->inSubtitle_
@@ -373,29 +461,29 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
                                          : static_cast<TextBlock::BLOCK_STYLE>(self->config_.paragraphAlignment);
       self->startNewTextBlock(style);
     }
-  } else if (strcmp(localName, "emphasis") == 0) {
+  } else if (tag == XmlName::Emphasis) {
     self->flushPartWordBuffer();
     self->italicUntilDepth_ = std::min(self->italicUntilDepth_, self->depth_);
-  } else if (strcmp(localName, "code") == 0) {
+  } else if (tag == XmlName::Code) {
     self->flushPartWordBuffer();
     self->italicUntilDepth_ = std::min(self->italicUntilDepth_, self->depth_);
-  } else if (strcmp(localName, "strong") == 0) {
+  } else if (tag == XmlName::Strong) {
     self->flushPartWordBuffer();
     self->boldUntilDepth_ = std::min(self->boldUntilDepth_, self->depth_);
-  } else if (strcmp(localName, "empty-line") == 0) {
+  } else if (tag == XmlName::EmptyLine) {
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
     }
     self->addVerticalSpacing(1);
-  } else if (strcmp(localName, "image") == 0) {
-    // Skip images in v1
-  } else if (matches(localName, PARAGRAPH_TAGS, NUM_PARAGRAPH_TAGS)) {
+  } else if (tag == XmlName::Image) {
+    self->handleImage(atts);
+  } else if (isParagraphTag(tag)) {
     self->inParagraph_ = true;
     if (!self->currentTextBlock_) {
       self->startNewTextBlock(TextBlock::LEFT_ALIGN);
     }
-  } else if (matches(localName, BLOCK_TAGS, NUM_BLOCK_TAGS)) {
+  } else if (isBlockTag(tag)) {
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
@@ -408,9 +496,9 @@ void XMLCALL Fb2Parser::startElement(void* userData, const XML_Char* name, const
 
 void XMLCALL Fb2Parser::endElement(void* userData, const XML_Char* name) {
   auto* self = static_cast<Fb2Parser*>(userData);
-  const char* localName = stripNamespace(name);
+  const XmlName tag = lookupXmlLocalName(name);
 
-  if (strcmp(localName, "emphasis") == 0 || strcmp(localName, "code") == 0 || strcmp(localName, "strong") == 0) {
+  if (tag == XmlName::Emphasis || tag == XmlName::Code || tag == XmlName::Strong) {
     self->flushPartWordBuffer();
   }
 
@@ -429,44 +517,44 @@ void XMLCALL Fb2Parser::endElement(void* userData, const XML_Char* name) {
   }
 
   if (!self->inBody_) {
-    if (strcmp(localName, "body") == 0) {
+    if (tag == XmlName::Body) {
       // Closing body tag — nothing more to do
     }
     return;
   }
 
-  if (strcmp(localName, "body") == 0) {
+  if (tag == XmlName::Body) {
     self->inBody_ = false;
     return;
   }
 
-  if (strcmp(localName, "title") == 0) {
+  if (tag == XmlName::Title) {
     self->inTitle_ = false;
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
     }
     self->addVerticalSpacing(1);
-  } else if (strcmp(localName, "subtitle") == 0) {
+  } else if (tag == XmlName::Subtitle) {
     self->inSubtitle_ = false;
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
     }
     self->addVerticalSpacing(1);
-  } else if (strcmp(localName, "p") == 0) {
+  } else if (tag == XmlName::P) {
     self->inParagraph_ = false;
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
     }
-  } else if (matches(localName, PARAGRAPH_TAGS, NUM_PARAGRAPH_TAGS)) {
+  } else if (isParagraphTag(tag)) {
     self->inParagraph_ = false;
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
     }
-  } else if (matches(localName, BLOCK_TAGS, NUM_BLOCK_TAGS)) {
+  } else if (isBlockTag(tag)) {
     self->flushPartWordBuffer();
     if (self->currentTextBlock_ && !self->currentTextBlock_->isEmpty()) {
       self->makePages();
@@ -539,7 +627,7 @@ void Fb2Parser::makePages() {
   const int lineHeight = static_cast<int>(renderer_.getLineHeight(config_.fontId) * config_.lineCompression);
   bool continueProcessing = true;
 
-  const uint32_t layoutStarted = perfMsNow();
+  TRACE_BEGIN(Fb2Layout);
   currentTextBlock_->layoutAndExtractLines(
       renderer_, config_.fontId, config_.viewportWidth,
       [this, &continueProcessing](const std::shared_ptr<TextBlock>& line) {
@@ -551,7 +639,7 @@ void Fb2Parser::makePages() {
       },
       true, [this, &continueProcessing]() -> bool { return !continueProcessing || (shouldAbort_ && shouldAbort_()); },
       buildScratch_);
-  readerPerfLog("fb2-layout", layoutStarted);
+  TRACE_END(Fb2Layout);
 
   if (!hitMaxPages_) {
     switch (config_.spacingLevel) {
@@ -583,21 +671,185 @@ void Fb2Parser::addLineToPage(std::shared_ptr<TextBlock> line) {
   }
 
   if (currentPageNextY_ + lineHeight > config_.viewportHeight) {
-    onPageComplete_(std::move(currentPage_));
-    pagesCreated_++;
-    startNewPage();
-
-    if (maxPages_ > 0 && pagesCreated_ >= maxPages_) {
-      hitMaxPages_ = true;
-      stopRequested_ = true;
-      XML_StopParser(xmlParser_, XML_TRUE);
-    }
+    completePage();
   }
 
   currentPage_->elements.push_back(std::make_shared<PageLine>(line, 0, currentPageNextY_));
   currentPageNextY_ += lineHeight;
 }
 
+// Emits the current page and starts the next. Reaching maxPages suspends the
+// parse; the element being placed still goes on the new page.
+void Fb2Parser::completePage() {
+  onPageComplete_(std::move(currentPage_));
+  pagesCreated_++;
+  startNewPage();
+
+  if (maxPages_ > 0 && pagesCreated_ >= maxPages_) {
+    hitMaxPages_ = true;
+    stopRequested_ = true;
+    XML_StopParser(xmlParser_, XML_TRUE);
+  }
+}
+
+void Fb2Parser::handleImage(const XML_Char** atts) {
+  if (imageCachePath_.empty() || !findBinary_ || !atts || stopRequested_) return;
+
+  const char* href = nullptr;
+  for (int i = 0; atts[i]; i += 2) {
+    if (lookupXmlLocalName(atts[i]) == XmlName::Href && atts[i + 1]) {
+      href = atts[i + 1];
+      break;
+    }
+  }
+  // Only references to the book's own <binary> elements
+  if (!href || href[0] != '#') return;
+
+  const std::string cachedPath = cacheImage(href + 1);
+  if (cachedPath.empty()) return;
+
+  int imageWidth = 0;
+  int imageHeight = 0;
+  if (!ImageBlock::readCachedSize(cachedPath, imageWidth, imageHeight)) return;
+  // Skip tiny decorative images (e.g. 1px-tall line separators) - invisible on e-paper
+  if (imageWidth < 20 || imageHeight < 20) return;
+  auto image = std::make_shared<ImageBlock>(cachedPath, imageWidth, imageHeight);
+
+  // Text before the image goes first
+  flushPartWordBuffer();
+  if (currentTextBlock_ && !currentTextBlock_->isEmpty()) {
+    makePages();
+  }
+  if (stopRequested_) {
+    pendingImage_ = std::move(image);
+    return;
+  }
+  placeImage(std::move(image));
+}
+
+void Fb2Parser::placeImage(std::shared_ptr<ImageBlock> image) {
+  addImageToPage(std::move(image));
+
+  // Text after an inline image continues the paragraph in a new block. Created
+  // directly: startNewTextBlock() does nothing once a page limit stopped the parse.
+  if (inParagraph_ && !currentTextBlock_) {
+    const auto style = inTitle_ || inSubtitle_ ? TextBlock::CENTER_ALIGN
+                                               : static_cast<TextBlock::BLOCK_STYLE>(config_.paragraphAlignment);
+    currentTextBlock_.reset(new ParsedText(style, config_.indentLevel, config_.hyphenation, true, isRtl_));
+  }
+}
+
+std::string Fb2Parser::cacheImage(const char* id) {
+  if (shouldAbort_ && shouldAbort_()) return "";
+
+  // Skip remaining images after too many consecutive failures
+  if (consecutiveImageFailures_ >= MAX_CONSECUTIVE_IMAGE_FAILURES) {
+    LOG_DBG(TAG, "Skipping image - too many failures");
+    return "";
+  }
+
+  uint32_t dataOffset = 0;
+  if (!findBinary_(id, dataOffset)) {
+    LOG_DBG(TAG, "No <binary> for image #%s", id);
+    return "";
+  }
+
+  // The image cache is per book, so the binary's offset names it
+  const std::string cacheBase = imageCachePath_ + "/" + std::to_string(dataOffset);
+  const std::string cachedBmpPath = cacheBase + ".bmp";
+  // Grayscale pages need both darkness planes, 1-bit pages only the black mask
+  const int g5Planes = config_.grayscaleImages ? 2 : 1;
+  const std::string cachedG5Path = cacheBase + (config_.grayscaleImages ? ".g5" : ".bw.g5");
+
+  if (SdMan.exists(cachedG5Path.c_str())) {
+    consecutiveImageFailures_ = 0;
+    return cachedG5Path;
+  }
+  if (SdMan.exists(cachedBmpPath.c_str())) {
+    consecutiveImageFailures_ = 0;
+    return ImageBlock::compressCachedBmp(cachedBmpPath, cachedG5Path, g5Planes);
+  }
+
+  const std::string failedMarker = cacheBase + ".failed";
+  if (SdMan.exists(failedMarker.c_str())) {
+    consecutiveImageFailures_++;
+    return "";
+  }
+
+  if (!convertBinary(dataOffset, cachedBmpPath)) {
+    SdMan.remove(cachedBmpPath.c_str());
+    SdMan.remove((cachedBmpPath + ".part").c_str());
+    // Cancelled conversions are retried next time
+    if (shouldAbort_ && shouldAbort_()) return "";
+
+    LOG_ERR(TAG, "Failed to convert image #%s", id);
+    FsFile marker;
+    if (SdMan.openFileForWrite("FB2", failedMarker, marker)) {
+      marker.close();
+    }
+    consecutiveImageFailures_++;
+    return "";
+  }
+
+  consecutiveImageFailures_ = 0;
+  LOG_DBG(TAG, "Cached image: %s", cachedBmpPath.c_str());
+  return ImageBlock::compressCachedBmp(cachedBmpPath, cachedG5Path, g5Planes);
+}
+
+// Decodes the base64 text in place: book file -> Base64Source -> JPEG/PNG decoder,
+// with no copy of the encoded or decoded image on the card
+bool Fb2Parser::convertBinary(const uint32_t dataOffset, const std::string& bmpPath) {
+  // A second reader: the parse's own stays where it is. For a .fb2.zip this one
+  // seeks through the inflate checkpoints.
+  Fb2Source book;
+  if (!book.open(filepath_, inflateIndexPath_) || !book.seek(dataOffset)) {
+    return false;
+  }
+
+  ImageConvertConfig convertConfig;
+  convertConfig.maxWidth = static_cast<int>(config_.viewportWidth);
+  convertConfig.maxHeight = static_cast<int>(config_.viewportHeight);
+  convertConfig.oneBit = !config_.grayscaleImages;
+  convertConfig.logTag = TAG;
+  convertConfig.shouldAbort = shouldAbort_;
+
+  Base64Source source(book);
+  return ImageConverterFactory::convertToBmp(source, bmpPath, convertConfig);
+}
+
+void Fb2Parser::addImageToPage(std::shared_ptr<ImageBlock> image) {
+  const int lineHeight = static_cast<int>(renderer_.getLineHeight(config_.fontId) * config_.lineCompression);
+  const int imageHeight = image->getHeight();
+  const bool isTallImage = imageHeight > config_.viewportHeight / 2;
+
+  if (!currentPage_) {
+    startNewPage();
+  }
+
+  // Tall images get a dedicated page; others move on when they don't fit
+  if (currentPageNextY_ > 0 && (isTallImage || currentPageNextY_ + imageHeight > config_.viewportHeight)) {
+    completePage();
+  }
+
+  // Center horizontally (signed: images can be wider than the viewport)
+  int xPos = (static_cast<int>(config_.viewportWidth) - static_cast<int>(image->getWidth())) / 2;
+  if (xPos < 0) xPos = 0;
+
+  // Center tall images vertically on their dedicated page
+  int yPos = currentPageNextY_;
+  if (isTallImage && currentPageNextY_ == 0 && imageHeight < config_.viewportHeight) {
+    yPos = (config_.viewportHeight - imageHeight) / 2;
+  }
+
+  currentPage_->elements.push_back(std::make_shared<PageImage>(image, xPos, yPos));
+  currentPageNextY_ = yPos + imageHeight + lineHeight;
+
+  // Text continues on the next page after a tall image
+  if (isTallImage) {
+    completePage();
+  }
+}
+
 void Fb2Parser::startNewPage() {
   currentPage_.reset(new Page());
   currentPageNextY_ = 0;
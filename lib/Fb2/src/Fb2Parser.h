@@ -4,7 +4,6 @@
 #include <EpdFontFamily.h>
 #include <RenderConfig.h>
 #include <ScriptDetector.h>
-#include <SdFat.h>
 #include <blocks/TextBlock.h>
 #include <expat.h>
 
@@ -13,7 +12,10 @@
 #include <memory>
 #include <string>
 
+#include "Fb2Source.h"
+
 class BuildArena;
+class ImageBlock;
 class Page;
 class GfxRenderer;
 class ParsedText;
@@ -32,6 +34,28 @@ class Fb2Parser : public ContentParser {
   uint32_t bytesConsumed() const override { return bytesConsumed_; }
   uint32_t totalBytes() const override { return static_cast<uint32_t>(fileSize_); }
 
+  // Parse only [offset, offset + length) of the file, wrapped in prologue/epilogue
+  // XML so a single <section> reads as a complete document (see Fb2::prepareSectionParser)
+  void setByteRange(uint32_t offset, uint32_t length, const std::string& prologue, const std::string& epilogue) {
+    byteRangeMode_ = true;
+    rangeOffset_ = offset;
+    rangeLength_ = length;
+    prologueXml_ = prologue;
+    epilogueXml_ = epilogue;
+  }
+
+  // Checkpoint index for seeking into a .fb2.zip (see Fb2Source); set by Fb2::prepareSectionParser
+  void setInflateIndex(std::string indexPath) { inflateIndexPath_ = std::move(indexPath); }
+
+  // Resolves an <image l:href="#id"> to the file offset of its <binary> base64 text
+  using BinaryLookup = std::function<bool(const char* id, uint32_t& dataOffset)>;
+
+  // Decode referenced images into imageCachePath (see Fb2::prepareSectionParser). Without it images are skipped.
+  void setImageSource(std::string imageCachePath, BinaryLookup findBinary) {
+    imageCachePath_ = std::move(imageCachePath);
+    findBinary_ = std::move(findBinary);
+  }
+
  private:
   std::string filepath_;
   GfxRenderer& renderer_;
@@ -80,7 +104,8 @@ class Fb2Parser : public ContentParser {
   AbortCallback shouldAbort_;
 
   // File reading — kept open between resume calls
-  FsFile resumeFile_;
+  Fb2Source source_;
+  std::string inflateIndexPath_;
   size_t bomSkip_ = 0;
   size_t fileSize_ = 0;
   // Snapshot of expat's cumulative byte index (+ BOM skip) at end of last
@@ -88,15 +113,39 @@ class Fb2Parser : public ContentParser {
   // while the cache is partial.
   uint32_t bytesConsumed_ = 0;
 
+  // Byte-range mode: one section parsed in place inside the book file
+  bool byteRangeMode_ = false;
+  uint32_t rangeOffset_ = 0;
+  uint32_t rangeLength_ = 0;
+  uint32_t rangeRead_ = 0;
+  bool epilogueFed_ = false;
+  std::string prologueXml_;
+  std::string epilogueXml_;
+
+  // Inline images
+  static constexpr int MAX_CONSECUTIVE_IMAGE_FAILURES = 3;
+  std::string imageCachePath_;
+  BinaryLookup findBinary_;
+  int consecutiveImageFailures_ = 0;
+  std::shared_ptr<ImageBlock> pendingImage_;  // Waits for the text before it after a page-limit stop
+
   // XML callbacks
   static void XMLCALL startElement(void* userData, const XML_Char* name, const XML_Char** atts);
   static void XMLCALL endElement(void* userData, const XML_Char* name);
   static void XMLCALL characterData(void* userData, const XML_Char* s, int len);
 
+  bool hasMoreInput();
+  uint32_t consumedOffset() const;
   void flushPartWordBuffer();
   void startNewTextBlock(TextBlock::BLOCK_STYLE style);
   void makePages();
   void addLineToPage(std::shared_ptr<TextBlock> line);
+  void handleImage(const XML_Char** atts);
+  void placeImage(std::shared_ptr<ImageBlock> image);
+  std::string cacheImage(const char* id);
+  bool convertBinary(uint32_t dataOffset, const std::string& bmpPath);
+  void addImageToPage(std::shared_ptr<ImageBlock> image);
+  void completePage();
   void startNewPage();
   EpdFontFamily::Style getCurrentFontFamily() const;
   void addVerticalSpacing(int lines);
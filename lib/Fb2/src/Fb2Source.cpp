@@ -0,0 +1,185 @@
+#include "Fb2Source.h"
+
+#include <Logging.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <cstring>
+#include <new>
+#include <strings.h>
+
+#define TAG "FB2_SRC"
+
+namespace {
+constexpr uint8_t kIndexVersion = 1;
+// Version, record size, member size
+constexpr size_t kIndexHeaderSize = 1 + 4 + 4;
+
+bool endsWithIgnoreCase(const std::string& s, const char* suffix) {
+  const size_t n = strlen(suffix);
+  return s.size() >= n && strcasecmp(s.c_str() + s.size() - n, suffix) == 0;
+}
+}  // namespace
+
+bool Fb2Source::isZipped(const std::string& path) { return endsWithIgnoreCase(path, ".zip"); }
+
+bool Fb2Source::open(const std::string& path, const std::string& indexPath) {
+  close();
+  indexPath_ = indexPath;
+
+  if (isZipped(path)) {
+    if (!openZipMember(path)) {
+      close();
+      return false;
+    }
+  } else {
+    if (!SdMan.openFileForRead("FB2", path, file_)) return false;
+    size_ = file_.size();
+  }
+
+  position_ = 0;
+  open_ = true;
+  return true;
+}
+
+bool Fb2Source::openZipMember(const std::string& path) {
+  zip_.reset(new (std::nothrow) ZipFile(path));
+  if (!zip_ || !zip_->loadAllFileStatSlims()) {
+    LOG_ERR(TAG, "Failed to read ZIP directory: %s", path.c_str());
+    return false;
+  }
+
+  // Archives from FB2 libraries hold one book; take the first .fb2 by name if there are more
+  const std::string* member = nullptr;
+  for (const auto& entry : zip_->getFileStatSlimCache()) {
+    if (endsWithIgnoreCase(entry.first, ".fb2") && (!member || entry.first < *member)) member = &entry.first;
+  }
+  if (!member) {
+    LOG_ERR(TAG, "No .fb2 member in %s", path.c_str());
+    return false;
+  }
+
+  const std::string name = *member;
+  const StreamReadResult result = entry_.open(*zip_, name.c_str());
+  if (result != StreamReadResult::Success) {
+    LOG_ERR(TAG, "Failed to open %s in ZIP (%d)", name.c_str(), static_cast<int>(result));
+    return false;
+  }
+  size_ = entry_.size();
+  return true;
+}
+
+void Fb2Source::close() {
+  stopRecording();
+  entry_.close();
+  zip_.reset();
+  if (file_) file_.close();
+  size_ = 0;
+  position_ = 0;
+  open_ = false;
+}
+
+int Fb2Source::read(uint8_t* buf, const size_t len) {
+  if (!open_) return -1;
+
+  const int n = zip_ ? entry_.read(buf, len) : file_.read(buf, len);
+  if (n <= 0) return n;
+  position_ += static_cast<size_t>(n);
+
+  if (indexOut_ && position_ >= nextCheckpoint_) {
+    if (!entry_.saveCheckpoint(indexOut_)) {
+      LOG_ERR(TAG, "Failed to write inflate checkpoint");
+      stopRecording();
+      SdMan.remove(indexPath_.c_str());
+    }
+    nextCheckpoint_ = position_ + CHECKPOINT_SPACING;
+  }
+  return n;
+}
+
+bool Fb2Source::seek(const size_t offset) {
+  if (!open_ || offset > size_) return false;
+
+  if (!zip_) {
+    if (!file_.seekSet(offset)) return false;
+  } else {
+    if (entry_.isDeflated()) restoreNearestCheckpoint(offset);
+    if (!entry_.seek(offset)) {
+      LOG_ERR(TAG, "Seek to %u failed", static_cast<unsigned>(offset));
+      return false;
+    }
+  }
+  position_ = offset;
+  return true;
+}
+
+// Jump to the last checkpoint at or before offset when that beats inflating from where we are
+void Fb2Source::restoreNearestCheckpoint(const size_t offset) {
+  if (indexPath_.empty() || indexOut_) return;
+
+  FsFile index;
+  if (!SdMan.openFileForRead("FB2", indexPath_, index)) return;
+
+  uint8_t version = 0;
+  uint32_t recordSize = 0;
+  uint32_t memberSize = 0;
+  if (!serialization::readPodChecked(index, version) || !serialization::readPodChecked(index, recordSize) ||
+      !serialization::readPodChecked(index, memberSize) || version != kIndexVersion ||
+      recordSize != ZipEntryReader::CHECKPOINT_SIZE || memberSize != size_) {
+    LOG_DBG(TAG, "Ignoring stale inflate index");
+    index.close();
+    return;
+  }
+
+  // Records are in increasing position order; find the last one at or before offset
+  const size_t count = (index.size() - kIndexHeaderSize) / recordSize;
+  size_t lo = 0;
+  size_t hi = count;
+  uint32_t best = 0;
+  size_t bestIndex = count;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    uint32_t pos = 0;
+    if (!index.seekSet(kIndexHeaderSize + mid * recordSize) || !serialization::readPodChecked(index, pos)) break;
+    if (pos <= offset) {
+      best = pos;
+      bestIndex = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  const size_t current = entry_.position();
+  const bool worthIt = bestIndex < count && (offset < current || best > current);
+  if (worthIt && index.seekSet(kIndexHeaderSize + bestIndex * recordSize) && !entry_.restoreCheckpoint(index)) {
+    LOG_ERR(TAG, "Failed to restore inflate checkpoint at %u", best);
+  }
+  index.close();
+}
+
+void Fb2Source::recordCheckpoints() {
+  stopRecording();
+  if (!open_ || !zip_ || !entry_.isDeflated() || indexPath_.empty()) return;
+
+  if (!SdMan.openFileForWrite("FB2", indexPath_, indexOut_)) {
+    LOG_ERR(TAG, "Failed to create inflate index");
+    return;
+  }
+  serialization::writePod(indexOut_, kIndexVersion);
+  serialization::writePod(indexOut_, static_cast<uint32_t>(ZipEntryReader::CHECKPOINT_SIZE));
+  serialization::writePod(indexOut_, static_cast<uint32_t>(size_));
+  nextCheckpoint_ = position_ + CHECKPOINT_SPACING;
+}
+
+void Fb2Source::finishCheckpoints(const bool keep) {
+  const bool recording = static_cast<bool>(indexOut_);
+  stopRecording();
+  if (recording && !keep) SdMan.remove(indexPath_.c_str());
+}
+
+void Fb2Source::stopRecording() {
+  if (!indexOut_) return;
+  indexOut_.sync();
+  indexOut_.close();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ByteSource.h>
+#include <SdFat.h>
+#include <ZipFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * The XML of an FB2 book: a plain .fb2 file, or the .fb2 member of a .fb2.zip
+ * read through ZipEntryReader without extracting it to SD.
+ *
+ * Reads forward like any ByteSource and seeks to any XML offset. In a deflated
+ * member a seek restores the nearest inflate checkpoint at or before the target
+ * from the book's index file, then inflates only the rest. The index is written
+ * by the first full pass over the book (recordCheckpoints()); without it seeks
+ * still work but inflate from the start of the member.
+ */
+class Fb2Source : public ByteSource {
+ public:
+  // Uncompressed bytes between checkpoints; each costs ZipEntryReader::CHECKPOINT_SIZE in the index
+  static constexpr size_t CHECKPOINT_SPACING = 256 * 1024;
+
+  Fb2Source() = default;
+  ~Fb2Source() override { close(); }
+
+  Fb2Source(const Fb2Source&) = delete;
+  Fb2Source& operator=(const Fb2Source&) = delete;
+
+  // .fb2.zip (any .zip path): the book is the first .fb2 member of the archive
+  static bool isZipped(const std::string& path);
+
+  /**
+   * @param path Book file (.fb2 or .fb2.zip)
+   * @param indexPath Checkpoint index of this book; may be empty or not yet written
+   */
+  bool open(const std::string& path, const std::string& indexPath = "");
+  void close();
+  bool isOpen() const { return open_; }
+
+  int read(uint8_t* buf, size_t len) override;
+  size_t size() const override { return size_; }
+  size_t position() const { return position_; }
+  size_t available() const { return size_ - position_; }
+  bool seek(size_t offset);
+
+  /**
+   * Write a fresh checkpoint index while the book is read front to back from
+   * here on. Does nothing for plain files and stored members (they seek directly).
+   */
+  void recordCheckpoints();
+  // Stop recording; the index is kept only when the pass completed
+  void finishCheckpoints(bool keep);
+
+ private:
+  FsFile file_;
+  std::unique_ptr<ZipFile> zip_;
+  ZipEntryReader entry_;
+  std::string indexPath_;
+  FsFile indexOut_;
+  size_t size_ = 0;
+  size_t position_ = 0;
+  size_t nextCheckpoint_ = 0;
+  bool open_ = false;
+
+  bool openZipMember(const std::string& path);
+  void restoreNearestCheckpoint(size_t offset);
+  void stopRecording();
+};
@@ -12,15 +12,26 @@
 #include <cstring>
 #include <memory>
 #include <new>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace {
 constexpr char INDEX_DIRECTORY[] = "/.papyrix/fileindex";
 constexpr char MAGIC[4] = {'P', 'F', 'I', 'X'};
-constexpr uint8_t VERSION = 1;
-constexpr size_t CHUNK_RECORDS = 16;
+constexpr uint8_t VERSION = 2;
 constexpr uint8_t DIRECTORY_FLAG = 1;
 constexpr uint32_t FNV32_BASIS = 2166136261u;
+constexpr uint32_t MAX_ENTRIES = 1u << 24;
+// Sort buffer for one run: a slice of the largest free block, within these bounds
+constexpr size_t MIN_CHUNK_BYTES = 2048;
+constexpr size_t MAX_CHUNK_BYTES = 16384;
+// Row table entries moved per read/write
+constexpr size_t TABLE_BATCH = 64;
+// Spare table slots left for in-place additions
+constexpr uint32_t MIN_SPARE_ROWS = 16;
+// Smallest record: head, one name byte, terminator
+constexpr uint32_t MIN_RECORD_BYTES = 4;
 
 uint32_t fnv1a32(const void* data, size_t length, uint32_t hash) {
   const auto* bytes = static_cast<const uint8_t*>(data);
@@ -51,14 +62,44 @@ bool writeExact(FsFile& file, const void* data, size_t length) {
 void maybeYield(uint32_t& counter) {
   if ((++counter & 0xFFu) == 0) delay(1);
 }
+
+int compareEntries(uint8_t leftFlags, const char* leftName, uint8_t rightFlags, const char* rightName) {
+  const bool leftDirectory = (leftFlags & DIRECTORY_FLAG) != 0;
+  const bool rightDirectory = (rightFlags & DIRECTORY_FLAG) != 0;
+  if (leftDirectory != rightDirectory) return leftDirectory ? -1 : 1;
+  return FsHelpers::naturalCompare(leftName, rightName);
+}
+
+// FAT timestamp of the directory, zero when the filesystem has none (root)
+void readStamp(FsFile& directory, uint16_t& date, uint16_t& time) {
+  if (!directory.getModifyDateTime(&date, &time)) {
+    date = 0;
+    time = 0;
+  }
+}
+
+bool splitPath(const char* path, std::string& directory, const char*& name) {
+  if (!path || path[0] != '/') return false;
+  const char* slash = strrchr(path, '/');
+  name = slash + 1;
+  if (name[0] == '\0') return false;
+  directory.assign(path, slash == path ? 1 : static_cast<size_t>(slash - path));
+  return true;
+}
 }  // namespace
 
 struct FileIndex::BuildState {
   FsFile runsOut;
-  std::unique_ptr<Record[]> chunk;
+  std::unique_ptr<uint8_t[]> chunk;
+  std::unique_ptr<uint16_t[]> offsets;
+  size_t chunkBytes = 0;
   size_t chunkUsed = 0;
-  uint32_t runCount = 0;
+  size_t offsetSlots = 0;
+  size_t offsetCount = 0;
+  uint32_t runsBytes = 0;
+  std::vector<uint32_t> runStarts;
   uint32_t yieldCounter = 0;
+  uint32_t tableBatch[TABLE_BATCH] = {};
   Record left{};
   Record right{};
   char temporaryPath[72] = {};
@@ -66,24 +107,100 @@ struct FileIndex::BuildState {
   char runsPathB[72] = {};
 };
 
+bool FileIndex::makeIndexPath(const char* directory, char* out, size_t size) {
+  const int result = snprintf(out, size, "%s/%016llx.idx", INDEX_DIRECTORY,
+                              static_cast<unsigned long long>(fnv1a64(directory)));
+  return result >= 0 && static_cast<size_t>(result) < size;
+}
+
+uint32_t FileIndex::recordHash(const Record& record) {
+  // Entries are summed into the directory signature, so it can be patched
+  // when one is added or removed; mix so that sums of similar names spread
+  uint32_t hash = fnv1a32(&record.flags, sizeof(record.flags), FNV32_BASIS);
+  hash = fnv1a32(record.name, record.length, hash);
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  return hash ^ (hash >> 16);
+}
+
+bool FileIndex::readNextRecord(FsFile& file, Record& record) {
+  return readExact(file, &record, RECORD_HEAD) && (record.flags & ~DIRECTORY_FLAG) == 0 && record.length > 0 &&
+         readExact(file, record.name, record.length + 1u) && record.name[record.length] == '\0' &&
+         memchr(record.name, '\0', record.length) == nullptr;
+}
+
+bool FileIndex::writeRecord(FsFile& file, const Record& record) {
+  return writeExact(file, &record, recordSize(record));
+}
+
+int FileIndex::compareRecords(const Record& left, const Record& right) {
+  return compareEntries(left.flags, left.name, right.flags, right.name);
+}
+
 bool FileIndex::open(const char* directory, AcceptFn accept) {
   close();
   if (!directory || directory[0] != '/' || !accept) return false;
 
   const size_t pathLength = strlen(directory);
-  if (pathLength == 0 || pathLength > UINT16_MAX) return false;
+  if (pathLength > UINT16_MAX || !makeIndexPath(directory, indexPath_, sizeof(indexPath_))) return false;
 
-  const int pathResult = snprintf(indexPath_, sizeof(indexPath_), "%s/%016llx.idx", INDEX_DIRECTORY,
-                                  static_cast<unsigned long long>(fnv1a64(directory)));
-  if (pathResult < 0 || static_cast<size_t>(pathResult) >= sizeof(indexPath_)) return false;
+  FsFile root = SdMan.open(directory);
+  if (!root || !root.isDirectory()) {
+    if (root) root.close();
+    return false;
+  }
+  uint16_t date = 0;
+  uint16_t time = 0;
+  readStamp(root, date, time);
 
-  uint32_t signature = 0;
-  uint32_t count = 0;
-  if (!scanDirectory(directory, accept, signature, count)) return false;
-  if (loadExisting(directory, signature, count)) return true;
+  FsFile file = SdMan.open(indexPath_);
+  Header candidate{};
+  bool valid = file && readHeader(file, directory, candidate) && verifyTable(file, candidate);
+
+  // A timestamp that moved means the listing changed: skip the check and rebuild
+  if (valid && candidate.directoryDate != 0 && date != 0 &&
+      (candidate.directoryDate != date || candidate.directoryTime != time)) {
+    valid = false;
+  }
+
+  if (valid) {
+    uint32_t signature = 0;
+    uint32_t count = 0;
+    if (!scanDirectory(root, accept, signature, count)) {
+      file.close();
+      root.close();
+      return false;
+    }
+    valid = signature == candidate.directorySignature && count == candidate.entryCount;
+  }
+  root.close();
+
+  if (valid && (candidate.directoryDate != date || candidate.directoryTime != time)) {
+    // Listing confirmed under a new timestamp: keep it for the next visit
+    file.close();
+    candidate.directoryDate = date;
+    candidate.directoryTime = time;
+    FsFile writable = SdMan.open(indexPath_, O_RDWR);
+    if (writable) {
+      if (!writeExact(writable, &candidate, sizeof(candidate)) || !writable.sync()) valid = false;
+      writable.close();
+    }
+    file = SdMan.open(indexPath_);
+    valid = valid && file;
+  }
+
+  if (valid) {
+    header_ = candidate;
+    indexFile_ = std::move(file);
+    opened_ = true;
+    return true;
+  }
+  if (file) file.close();
 
-  LOG_INF("FIDX", "Building index for %s (%u entries)", directory, count);
-  return build(directory, accept);
+  LOG_INF("FIDX", "Building index for %s", directory);
+  return build(directory, accept, date, time);
 }
 
 void FileIndex::close() {
@@ -92,16 +209,8 @@ void FileIndex::close() {
   memset(&header_, 0, sizeof(header_));
 }
 
-bool FileIndex::scanDirectory(const char* directory, AcceptFn accept, uint32_t& signature, uint32_t& count) {
-  FsFile root = SdMan.open(directory);
-  if (!root || !root.isDirectory()) {
-    if (root) root.close();
-    return false;
-  }
-
-  const size_t pathLength = strlen(directory);
-  const uint64_t maximumRecords = (UINT32_MAX - sizeof(Header) - pathLength) / sizeof(Record);
-  uint32_t hash = FNV32_BASIS;
+bool FileIndex::scanDirectory(FsFile& root, AcceptFn accept, uint32_t& signature, uint32_t& count) {
+  uint32_t sum = 0;
   uint32_t entries = 0;
   uint32_t yieldCounter = 0;
 
@@ -109,107 +218,149 @@ bool FileIndex::scanDirectory(const char* directory, AcceptFn accept, uint32_t&
     FsFile entry = root.openNextFile();
     if (!entry) break;
 
-    entry.getName(nameBuffer_, sizeof(nameBuffer_));
+    entry.getName(record_.name, sizeof(record_.name));
     const bool isDirectory = entry.isDirectory();
     entry.close();
-    if (nameBuffer_[0] == '\0' || !accept(nameBuffer_, isDirectory)) continue;
-    if (entries >= maximumRecords) {
-      root.close();
+    if (record_.name[0] == '\0' || !accept(record_.name, isDirectory)) continue;
+    if (entries >= MAX_ENTRIES) {
       LOG_ERR("FIDX", "Directory is too large to index");
       return false;
     }
 
-    const uint16_t nameLength = static_cast<uint16_t>(strlen(nameBuffer_));
-    const uint8_t flags = isDirectory ? DIRECTORY_FLAG : 0;
-    hash = fnv1a32(&nameLength, sizeof(nameLength), hash);
-    hash = fnv1a32(nameBuffer_, nameLength, hash);
-    hash = fnv1a32(&flags, sizeof(flags), hash);
+    record_.flags = isDirectory ? DIRECTORY_FLAG : 0;
+    record_.length = static_cast<uint8_t>(strlen(record_.name));
+    sum += recordHash(record_);
     entries++;
     maybeYield(yieldCounter);
   }
-  root.close();
 
-  signature = hash;
+  signature = sum;
   count = entries;
   return true;
 }
 
-bool FileIndex::loadExisting(const char* directory, uint32_t signature, uint32_t count) {
-  FsFile file = SdMan.open(indexPath_);
-  if (!file) return false;
-
-  Header candidate{};
+bool FileIndex::readHeader(FsFile& file, const char* directory, Header& out) {
   const size_t pathLength = strlen(directory);
-  bool valid = readExact(file, &candidate, sizeof(candidate)) && memcmp(candidate.magic, MAGIC, sizeof(MAGIC)) == 0 &&
-               candidate.version == VERSION && candidate.reserved == 0 && candidate.pathLength == pathLength &&
-               candidate.directorySignature == signature && candidate.entryCount == count &&
-               candidate.recordsOffset == sizeof(Header) + pathLength;
+  if (!file.seekSet(0) || !readExact(file, &out, sizeof(out)) || memcmp(out.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      out.version != VERSION || out.reserved != 0 || out.pathLength != pathLength ||
+      out.entryCount > out.tableCapacity) {
+    return false;
+  }
 
-  if (valid) {
-    const uint64_t expectedSize =
-        static_cast<uint64_t>(candidate.recordsOffset) + static_cast<uint64_t>(candidate.entryCount) * sizeof(Record);
-    valid = expectedSize <= UINT32_MAX && static_cast<uint64_t>(file.fileSize()) == expectedSize;
+  const uint64_t heapOffset = sizeof(Header) + pathLength + static_cast<uint64_t>(out.tableCapacity) * 4;
+  if (out.heapOffset != heapOffset ||
+      static_cast<uint64_t>(file.fileSize()) != heapOffset + static_cast<uint64_t>(out.heapSize)) {
+    return false;
   }
 
+  char buffer[64];
   size_t compared = 0;
-  while (valid && compared < pathLength) {
-    const size_t bytes = std::min(sizeof(nameBuffer_), pathLength - compared);
-    valid = readExact(file, nameBuffer_, bytes) && memcmp(nameBuffer_, directory + compared, bytes) == 0;
+  while (compared < pathLength) {
+    const size_t bytes = std::min(sizeof(buffer), pathLength - compared);
+    if (!readExact(file, buffer, bytes) || memcmp(buffer, directory + compared, bytes) != 0) return false;
     compared += bytes;
   }
+  return true;
+}
 
-  uint32_t recordsChecksum = FNV32_BASIS;
-  Record record{};
-  for (uint32_t row = 0; valid && row < candidate.entryCount; row++) {
-    valid = readExact(file, &record, sizeof(record)) && (record.flags & ~DIRECTORY_FLAG) == 0 &&
-            memchr(record.name, '\0', sizeof(record.name)) != nullptr;
-    if (valid) recordsChecksum = fnv1a32(&record, sizeof(record), recordsChecksum);
+bool FileIndex::verifyTable(FsFile& file, const Header& header) {
+  // Records are checked as they are read; here only that every row points into the heap
+  const uint64_t heapEnd = static_cast<uint64_t>(header.heapOffset) + header.heapSize;
+  uint32_t batch[TABLE_BATCH];
+  uint32_t yieldCounter = 0;
+  if (!file.seekSet(sizeof(Header) + header.pathLength)) return false;
+
+  for (uint32_t row = 0; row < header.entryCount;) {
+    const size_t count = std::min<size_t>(TABLE_BATCH, header.entryCount - row);
+    if (!readExact(file, batch, count * sizeof(uint32_t))) return false;
+    for (size_t i = 0; i < count; i++) {
+      if (batch[i] < header.heapOffset || batch[i] + static_cast<uint64_t>(MIN_RECORD_BYTES) > heapEnd) return false;
+    }
+    row += count;
+    maybeYield(yieldCounter);
   }
-  valid = valid && recordsChecksum == candidate.recordsChecksum;
+  return true;
+}
 
-  if (!valid) {
-    file.close();
+bool FileIndex::readRow(FsFile& file, const Header& header, size_t row, Record& record) {
+  if (row >= header.entryCount) return false;
+  uint32_t offset = 0;
+  const uint64_t slot = sizeof(Header) + header.pathLength + static_cast<uint64_t>(row) * 4;
+  if (!file.seekSet(static_cast<uint32_t>(slot)) || !readExact(file, &offset, sizeof(offset)) ||
+      offset < header.heapOffset || !file.seekSet(offset) || !readNextRecord(file, record)) {
     return false;
   }
-
-  header_ = candidate;
-  indexFile_ = std::move(file);
-  opened_ = true;
-  return true;
+  const uint64_t heapEnd = static_cast<uint64_t>(header.heapOffset) + header.heapSize;
+  return offset + static_cast<uint64_t>(recordSize(record)) <= heapEnd;
 }
 
-int FileIndex::compareRecords(const Record& left, const Record& right) {
-  const bool leftDirectory = (left.flags & DIRECTORY_FLAG) != 0;
-  const bool rightDirectory = (right.flags & DIRECTORY_FLAG) != 0;
-  if (leftDirectory != rightDirectory) return leftDirectory ? -1 : 1;
-  return FsHelpers::naturalCompare(left.name, right.name);
+size_t FileIndex::lowerBound(FsFile& file, const Header& header, const Record& key, Record& scratch, bool& ok) {
+  size_t low = 0;
+  size_t high = header.entryCount;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (!readRow(file, header, middle, scratch)) {
+      ok = false;
+      return 0;
+    }
+    if (compareRecords(scratch, key) < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
 }
 
-bool FileIndex::flushChunk(BuildState& state) {
-  for (size_t i = 1; i < state.chunkUsed; i++) {
-    const Record candidate = state.chunk[i];
-    size_t position = i;
-    while (position > 0 && compareRecords(candidate, state.chunk[position - 1]) < 0) {
-      state.chunk[position] = state.chunk[position - 1];
-      position--;
+size_t FileIndex::findEqual(FsFile& file, const Header& header, uint8_t flags, const char* name, Record& scratch,
+                            bool& ok) {
+  const size_t length = strlen(name);
+  if (length == 0 || length > MAX_NAME) return SIZE_MAX;
+
+  Record key{};
+  key.flags = flags;
+  key.length = static_cast<uint8_t>(length);
+  memcpy(key.name, name, length);
+
+  // Natural order ignores case and leading zeros, so walk the whole equal range
+  for (size_t row = lowerBound(file, header, key, scratch, ok); ok && row < header.entryCount; row++) {
+    if (!readRow(file, header, row, scratch)) {
+      ok = false;
+      break;
     }
-    state.chunk[position] = candidate;
+    if (compareRecords(scratch, key) != 0) break;
+    if (strcasecmp(scratch.name, name) == 0) return row;
   }
+  return SIZE_MAX;
+}
 
-  const size_t bytes = state.chunkUsed * sizeof(Record);
-  if (bytes > 0 && !writeExact(state.runsOut, state.chunk.get(), bytes)) return false;
+bool FileIndex::flushChunk(BuildState& state) {
+  if (state.offsetCount == 0) return true;
+
+  const uint8_t* chunk = state.chunk.get();
+  std::sort(state.offsets.get(), state.offsets.get() + state.offsetCount, [chunk](uint16_t left, uint16_t right) {
+    return compareEntries(chunk[left], reinterpret_cast<const char*>(chunk + left + RECORD_HEAD), chunk[right],
+                          reinterpret_cast<const char*>(chunk + right + RECORD_HEAD)) < 0;
+  });
+
+  state.runStarts.push_back(state.runsBytes);
+  for (size_t i = 0; i < state.offsetCount; i++) {
+    const uint8_t* record = chunk + state.offsets[i];
+    const size_t bytes = RECORD_HEAD + record[1] + 1;
+    if (!writeExact(state.runsOut, record, bytes)) return false;
+    state.runsBytes += static_cast<uint32_t>(bytes);
+  }
   state.chunkUsed = 0;
-  state.runCount++;
+  state.offsetCount = 0;
   return true;
 }
 
-bool FileIndex::mergeRuns(BuildState& state, uint32_t recordCount, const char*& finalPath) {
+bool FileIndex::mergeRuns(BuildState& state, const char*& finalPath) {
   const char* inputPath = state.runsPathA;
   const char* outputPath = state.runsPathB;
-  uint32_t runLength = CHUNK_RECORDS;
-  uint32_t runCount = state.runCount;
+  std::vector<uint32_t> mergedStarts;
 
-  while (runCount > 1) {
+  while (state.runStarts.size() > 1) {
     FsFile inputA = SdMan.open(inputPath);
     FsFile inputB = SdMan.open(inputPath);
     FsFile output = SdMan.open(outputPath, O_RDWR | O_CREAT | O_TRUNC);
@@ -220,98 +371,159 @@ bool FileIndex::mergeRuns(BuildState& state, uint32_t recordCount, const char*&
       return false;
     }
 
+    const std::vector<uint32_t>& starts = state.runStarts;
+    const size_t runCount = starts.size();
+    auto runEnd = [&](size_t run) { return run + 1 < runCount ? starts[run + 1] : state.runsBytes; };
+
     bool success = true;
-    uint32_t mergedRuns = 0;
-    for (uint32_t run = 0; success && run < runCount; run += 2) {
-      const uint32_t startA = run * runLength;
-      const uint32_t lengthA = std::min(runLength, recordCount - startA);
-      const uint64_t byteA = static_cast<uint64_t>(startA) * sizeof(Record);
-      success = byteA <= UINT32_MAX && inputA.seekSet(static_cast<uint32_t>(byteA));
+    uint32_t written = 0;
+    mergedStarts.clear();
+    for (size_t run = 0; success && run < runCount; run += 2) {
+      mergedStarts.push_back(written);
+      uint32_t positionA = starts[run];
+      const uint32_t endA = runEnd(run);
+      success = inputA.seekSet(positionA);
 
       if (run + 1 >= runCount) {
-        uint32_t remaining = lengthA;
-        while (success && remaining > 0) {
-          const uint32_t batch = std::min<uint32_t>(remaining, CHUNK_RECORDS);
-          const size_t bytes = static_cast<size_t>(batch) * sizeof(Record);
+        // Odd run out: copy it through unchanged
+        while (success && positionA < endA) {
+          const size_t bytes = std::min<size_t>(state.chunkBytes, endA - positionA);
           success = readExact(inputA, state.chunk.get(), bytes) && writeExact(output, state.chunk.get(), bytes);
-          remaining -= batch;
+          positionA += static_cast<uint32_t>(bytes);
+          written += static_cast<uint32_t>(bytes);
           maybeYield(state.yieldCounter);
         }
-        mergedRuns++;
         break;
       }
 
-      const uint32_t startB = startA + lengthA;
-      const uint32_t lengthB = std::min(runLength, recordCount - startB);
-      const uint64_t byteB = static_cast<uint64_t>(startB) * sizeof(Record);
-      success = success && byteB <= UINT32_MAX && inputB.seekSet(static_cast<uint32_t>(byteB));
+      uint32_t positionB = starts[run + 1];
+      const uint32_t endB = runEnd(run + 1);
+      success = success && inputB.seekSet(positionB);
 
-      uint32_t usedA = 0;
-      uint32_t usedB = 0;
       bool haveA = false;
       bool haveB = false;
-      while (success && (usedA < lengthA || usedB < lengthB)) {
-        if (!haveA && usedA < lengthA) {
-          success = readExact(inputA, &state.left, sizeof(Record));
+      while (success) {
+        if (!haveA && positionA < endA) {
+          success = readNextRecord(inputA, state.left);
+          positionA += static_cast<uint32_t>(recordSize(state.left));
           haveA = success;
         }
-        if (success && !haveB && usedB < lengthB) {
-          success = readExact(inputB, &state.right, sizeof(Record));
+        if (success && !haveB && positionB < endB) {
+          success = readNextRecord(inputB, state.right);
+          positionB += static_cast<uint32_t>(recordSize(state.right));
           haveB = success;
         }
-        if (!success) break;
+        if (!success || (!haveA && !haveB)) break;
 
         const bool takeA = haveA && (!haveB || compareRecords(state.left, state.right) <= 0);
         const Record& selected = takeA ? state.left : state.right;
-        success = writeExact(output, &selected, sizeof(selected));
+        success = writeRecord(output, selected);
+        written += static_cast<uint32_t>(recordSize(selected));
         if (takeA) {
           haveA = false;
-          usedA++;
         } else {
           haveB = false;
-          usedB++;
         }
         maybeYield(state.yieldCounter);
       }
-      mergedRuns++;
     }
 
     inputA.close();
     inputB.close();
-    if (success) success = output.sync();
+    if (success) success = written == state.runsBytes && output.sync();
     output.close();
     if (!success) return false;
 
     std::swap(inputPath, outputPath);
-    runCount = mergedRuns;
-    const uint64_t doubled = static_cast<uint64_t>(runLength) * 2;
-    runLength = static_cast<uint32_t>(std::min<uint64_t>(recordCount, doubled));
+    state.runStarts.swap(mergedStarts);
   }
 
   finalPath = inputPath;
   return true;
 }
 
-bool FileIndex::build(const char* directory, AcceptFn accept) {
+bool FileIndex::writeIndex(BuildState& state, const char* directory, const char* sortedPath, Header& header) {
+  const size_t pathLength = strlen(directory);
+  const uint32_t count = header.entryCount;
+  const uint64_t capacity = static_cast<uint64_t>(count) + std::max<uint32_t>(MIN_SPARE_ROWS, count / 8);
+  const uint64_t tableOffset = sizeof(Header) + pathLength;
+  const uint64_t heapOffset = tableOffset + capacity * 4;
+  if (heapOffset + state.runsBytes > UINT32_MAX) return false;
+
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.reserved = 0;
+  header.pathLength = static_cast<uint16_t>(pathLength);
+  header.tableCapacity = static_cast<uint32_t>(capacity);
+  header.heapOffset = static_cast<uint32_t>(heapOffset);
+  header.heapSize = state.runsBytes;
+
+  FsFile sorted = SdMan.open(sortedPath);
+  FsFile output = SdMan.open(state.temporaryPath, O_RDWR | O_CREAT | O_TRUNC);
+  bool success = sorted && output && writeExact(output, &header, sizeof(header)) &&
+                 writeExact(output, directory, pathLength);
+
+  // Zero the table (spare slots stay zero), then stream the heap after it and
+  // fill the table in batches as the record offsets become known
+  memset(state.chunk.get(), 0, state.chunkBytes);
+  for (uint64_t remaining = capacity * 4; success && remaining > 0;) {
+    const size_t bytes = static_cast<size_t>(std::min<uint64_t>(state.chunkBytes, remaining));
+    success = writeExact(output, state.chunk.get(), bytes);
+    remaining -= bytes;
+  }
+
+  uint32_t cursor = header.heapOffset;
+  uint32_t batchStart = 0;
+  size_t batchUsed = 0;
+  for (uint32_t row = 0; success && row < count; row++) {
+    success = readNextRecord(sorted, state.left) && writeRecord(output, state.left);
+    state.tableBatch[batchUsed++] = cursor;
+    cursor += static_cast<uint32_t>(recordSize(state.left));
+
+    if (success && (batchUsed == TABLE_BATCH || row + 1 == count)) {
+      success = output.seekSet(static_cast<uint32_t>(tableOffset) + batchStart * 4) &&
+                writeExact(output, state.tableBatch, batchUsed * sizeof(uint32_t)) && output.seekSet(cursor);
+      batchStart += static_cast<uint32_t>(batchUsed);
+      batchUsed = 0;
+    }
+    maybeYield(state.yieldCounter);
+  }
+  success = success && cursor == header.heapOffset + header.heapSize;
+
+  if (sorted) sorted.close();
+  if (output) {
+    if (success) success = output.sync();
+    output.close();
+  }
+  return success;
+}
+
+bool FileIndex::build(const char* directory, AcceptFn accept, uint16_t directoryDate, uint16_t directoryTime) {
   if (!SdMan.ensureDirectoryExists(INDEX_DIRECTORY)) return false;
 
-  const size_t allocationSize = sizeof(BuildState) + CHUNK_RECORDS * sizeof(Record);
-  const size_t largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
-  if (allocationSize > largestBlock * 80 / 100) {
+  const size_t chunkBytes =
+      std::min(MAX_CHUNK_BYTES, static_cast<size_t>(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT)) / 4);
+  if (chunkBytes < MIN_CHUNK_BYTES) {
     LOG_ERR("FIDX", "Insufficient heap for index build");
     return false;
   }
+  const size_t offsetSlots = chunkBytes / 8;
 
   BuildState* stateRaw = new (std::nothrow) BuildState();
-  Record* chunkRaw = new (std::nothrow) Record[CHUNK_RECORDS];
-  if (!stateRaw || !chunkRaw) {
+  uint8_t* chunkRaw = new (std::nothrow) uint8_t[chunkBytes];
+  uint16_t* offsetsRaw = new (std::nothrow) uint16_t[offsetSlots];
+  if (!stateRaw || !chunkRaw || !offsetsRaw) {
     delete stateRaw;
     delete[] chunkRaw;
+    delete[] offsetsRaw;
     return false;
   }
   std::unique_ptr<BuildState> stateOwner(stateRaw);
   BuildState& state = *stateOwner;
   state.chunk.reset(chunkRaw);
+  state.offsets.reset(offsetsRaw);
+  state.chunkBytes = chunkBytes;
+  state.offsetSlots = offsetSlots;
 
   const int temporaryResult = snprintf(state.temporaryPath, sizeof(state.temporaryPath), "%s.tmp", indexPath_);
   const int runsAResult = snprintf(state.runsPathA, sizeof(state.runsPathA), "%s.a", indexPath_);
@@ -338,83 +550,51 @@ bool FileIndex::build(const char* directory, AcceptFn accept) {
     return false;
   }
 
-  const size_t pathLength = strlen(directory);
-  const uint64_t maximumRecords = (UINT32_MAX - sizeof(Header) - pathLength) / sizeof(Record);
-  uint32_t signature = FNV32_BASIS;
+  uint32_t signature = 0;
   uint32_t recordCount = 0;
   bool success = true;
   while (success) {
     FsFile entry = root.openNextFile();
     if (!entry) break;
 
-    entry.getName(nameBuffer_, sizeof(nameBuffer_));
+    entry.getName(record_.name, sizeof(record_.name));
     const bool isDirectory = entry.isDirectory();
     entry.close();
-    if (nameBuffer_[0] == '\0' || !accept(nameBuffer_, isDirectory)) continue;
-    if (recordCount >= maximumRecords) {
+    if (record_.name[0] == '\0' || !accept(record_.name, isDirectory)) continue;
+    if (recordCount >= MAX_ENTRIES) {
       success = false;
       break;
     }
 
-    const uint16_t nameLength = static_cast<uint16_t>(strlen(nameBuffer_));
-    const uint8_t flags = isDirectory ? DIRECTORY_FLAG : 0;
-    signature = fnv1a32(&nameLength, sizeof(nameLength), signature);
-    signature = fnv1a32(nameBuffer_, nameLength, signature);
-    signature = fnv1a32(&flags, sizeof(flags), signature);
+    record_.flags = isDirectory ? DIRECTORY_FLAG : 0;
+    record_.length = static_cast<uint8_t>(strlen(record_.name));
+    signature += recordHash(record_);
 
-    Record& record = state.chunk[state.chunkUsed++];
-    memset(&record, 0, sizeof(record));
-    record.flags = flags;
-    memcpy(record.name, nameBuffer_, nameLength);
+    const size_t bytes = recordSize(record_);
+    if (state.chunkUsed + bytes > state.chunkBytes || state.offsetCount == state.offsetSlots) {
+      success = flushChunk(state);
+    }
+    memcpy(state.chunk.get() + state.chunkUsed, &record_, bytes);
+    state.offsets[state.offsetCount++] = static_cast<uint16_t>(state.chunkUsed);
+    state.chunkUsed += bytes;
     recordCount++;
-
-    if (state.chunkUsed == CHUNK_RECORDS) success = flushChunk(state);
     maybeYield(state.yieldCounter);
   }
   root.close();
-  if (success && state.chunkUsed > 0) success = flushChunk(state);
-  if (success) success = state.runsOut.sync();
+  if (success) success = flushChunk(state) && state.runsOut.sync();
   state.runsOut.close();
   if (!success) {
     cleanup();
     return false;
   }
 
-  const char* finalRunsPath = nullptr;
-  success = mergeRuns(state, recordCount, finalRunsPath);
-  FsFile sortedRuns;
-  FsFile temporary;
-  if (success) {
-    sortedRuns = SdMan.open(finalRunsPath);
-    temporary = SdMan.open(state.temporaryPath, O_RDWR | O_CREAT | O_TRUNC);
-    success = static_cast<bool>(sortedRuns) && static_cast<bool>(temporary);
-  }
-
+  const char* sortedPath = nullptr;
   Header newHeader{};
-  memcpy(newHeader.magic, MAGIC, sizeof(MAGIC));
-  newHeader.version = VERSION;
-  newHeader.pathLength = static_cast<uint16_t>(pathLength);
   newHeader.directorySignature = signature;
   newHeader.entryCount = recordCount;
-  newHeader.recordsOffset = sizeof(Header) + pathLength;
-
-  if (success)
-    success = writeExact(temporary, &newHeader, sizeof(newHeader)) && writeExact(temporary, directory, pathLength);
-
-  uint32_t checksum = FNV32_BASIS;
-  for (uint32_t row = 0; success && row < recordCount; row++) {
-    success = readExact(sortedRuns, &state.left, sizeof(Record)) && writeExact(temporary, &state.left, sizeof(Record));
-    if (success) checksum = fnv1a32(&state.left, sizeof(Record), checksum);
-    maybeYield(state.yieldCounter);
-  }
-  newHeader.recordsChecksum = checksum;
-  if (success) success = temporary.seekSet(0) && writeExact(temporary, &newHeader, sizeof(newHeader));
-
-  if (sortedRuns) sortedRuns.close();
-  if (temporary) {
-    if (success) success = temporary.sync();
-    temporary.close();
-  }
+  newHeader.directoryDate = directoryDate;
+  newHeader.directoryTime = directoryTime;
+  success = mergeRuns(state, sortedPath) && writeIndex(state, directory, sortedPath, newHeader);
   if (!success || !SdMan.commitFile(state.temporaryPath, indexPath_)) {
     cleanup();
     return false;
@@ -430,36 +610,113 @@ bool FileIndex::build(const char* directory, AcceptFn accept) {
   return true;
 }
 
-bool FileIndex::readRecordAt(size_t row, Record& record) {
-  if (!opened_ || row >= header_.entryCount) return false;
-  const uint64_t offset = static_cast<uint64_t>(header_.recordsOffset) + static_cast<uint64_t>(row) * sizeof(Record);
-  if (offset > UINT32_MAX || !indexFile_.seekSet(static_cast<uint32_t>(offset)) ||
-      !readExact(indexFile_, &record, sizeof(record))) {
-    return false;
-  }
-  return (record.flags & ~DIRECTORY_FLAG) == 0 && memchr(record.name, '\0', sizeof(record.name)) != nullptr;
-}
-
 bool FileIndex::entryAt(size_t row, Entry& out) {
-  Record record{};
-  if (!readRecordAt(row, record)) return false;
-  memcpy(out.name, record.name, sizeof(out.name));
-  out.name[MAX_NAME] = '\0';
-  out.isDir = (record.flags & DIRECTORY_FLAG) != 0;
+  if (!opened_ || !readRow(indexFile_, header_, row, record_)) return false;
+  memcpy(out.name, record_.name, record_.length + 1u);
+  out.isDir = (record_.flags & DIRECTORY_FLAG) != 0;
   return true;
 }
 
 size_t FileIndex::findRowByName(const char* name) {
-  if (!opened_ || !name || !indexFile_.seekSet(header_.recordsOffset)) return SIZE_MAX;
+  if (!opened_ || !name) return SIZE_MAX;
 
-  Record record{};
-  for (size_t row = 0; row < header_.entryCount; row++) {
-    if (!readExact(indexFile_, &record, sizeof(record)) || (record.flags & ~DIRECTORY_FLAG) != 0 ||
-        memchr(record.name, '\0', sizeof(record.name)) == nullptr) {
-      return SIZE_MAX;
+  bool ok = true;
+  size_t row = findEqual(indexFile_, header_, DIRECTORY_FLAG, name, record_, ok);
+  if (ok && row == SIZE_MAX) row = findEqual(indexFile_, header_, 0, name, record_, ok);
+  return ok ? row : SIZE_MAX;
+}
+
+bool FileIndex::patchDirectory(const char* directory, const char* removeName, const Record* add) {
+  char indexPath[64];
+  if (!makeIndexPath(directory, indexPath, sizeof(indexPath)) || !SdMan.exists(indexPath)) return true;
+
+  FsFile file = SdMan.open(indexPath, O_RDWR);
+  Header header{};
+  bool ok = file && readHeader(file, directory, header);
+  const uint32_t tableOffset = sizeof(Header) + header.pathLength;
+  uint32_t batch[TABLE_BATCH];
+  Record scratch{};
+
+  // Move table rows [first, end) one slot down (removal) or up (insertion)
+  auto shiftRows = [&](uint32_t first, uint32_t end, bool up) {
+    uint32_t remaining = end - first;
+    while (ok && remaining > 0) {
+      const uint32_t count = std::min<uint32_t>(TABLE_BATCH, remaining);
+      const uint32_t from = up ? first + remaining - count : end - remaining;
+      const uint32_t to = up ? from + 1 : from - 1;
+      ok = file.seekSet(tableOffset + from * 4) && readExact(file, batch, count * sizeof(uint32_t)) &&
+           file.seekSet(tableOffset + to * 4) && writeExact(file, batch, count * sizeof(uint32_t));
+      remaining -= count;
+    }
+  };
+
+  // A replaced entry may differ in case or type, so drop any same-named row first
+  const char* removals[2] = {removeName, add ? add->name : nullptr};
+  for (const char* name : removals) {
+    for (uint8_t flags : {DIRECTORY_FLAG, uint8_t{0}}) {
+      if (!ok || !name) break;
+      const size_t row = findEqual(file, header, flags, name, scratch, ok);
+      if (!ok || row == SIZE_MAX) continue;
+      header.directorySignature -= recordHash(scratch);
+      shiftRows(static_cast<uint32_t>(row) + 1, header.entryCount, false);
+      header.entryCount--;
     }
-    if (strcasecmp(record.name, name) == 0) return row;
-    if ((row & 0xFFu) == 0xFFu) delay(1);
   }
-  return SIZE_MAX;
+
+  if (ok && add) {
+    const uint64_t offset = static_cast<uint64_t>(header.heapOffset) + header.heapSize;
+    // Out of spare rows: let the next visit rebuild with fresh ones
+    ok = header.entryCount < header.tableCapacity && offset + recordSize(*add) <= UINT32_MAX;
+    const size_t row = ok ? lowerBound(file, header, *add, scratch, ok) : 0;
+    const uint32_t recordOffset = static_cast<uint32_t>(offset);
+    ok = ok && file.seekSet(recordOffset) && writeRecord(file, *add);
+    shiftRows(static_cast<uint32_t>(row), header.entryCount, true);
+    ok = ok && file.seekSet(tableOffset + static_cast<uint32_t>(row) * 4) &&
+         writeExact(file, &recordOffset, sizeof(recordOffset));
+    header.heapSize += static_cast<uint32_t>(recordSize(*add));
+    header.entryCount++;
+    header.directorySignature += recordHash(*add);
+  }
+
+  if (ok) {
+    FsFile root = SdMan.open(directory);
+    if (root) {
+      readStamp(root, header.directoryDate, header.directoryTime);
+      root.close();
+    }
+    ok = file.seekSet(0) && writeExact(file, &header, sizeof(header)) && file.sync();
+  }
+  if (file) file.close();
+
+  if (!ok) {
+    LOG_ERR("FIDX", "Dropping index for %s", directory);
+    SdMan.remove(indexPath);
+  }
+  return ok;
+}
+
+bool FileIndex::noteAdded(const char* path, bool isDir, AcceptFn accept) {
+  std::string directory;
+  const char* name = nullptr;
+  if (!splitPath(path, directory, name) || strlen(name) > MAX_NAME) return true;
+  if (!accept || !accept(name, isDir)) return patchDirectory(directory.c_str(), name, nullptr);
+
+  Record record{};
+  record.flags = isDir ? DIRECTORY_FLAG : 0;
+  record.length = static_cast<uint8_t>(strlen(name));
+  memcpy(record.name, name, record.length);
+  return patchDirectory(directory.c_str(), nullptr, &record);
+}
+
+bool FileIndex::noteRemoved(const char* path) {
+  std::string directory;
+  const char* name = nullptr;
+  if (!splitPath(path, directory, name)) return true;
+  return patchDirectory(directory.c_str(), name, nullptr);
+}
+
+bool FileIndex::noteRenamed(const char* oldPath, const char* newPath, bool isDir, AcceptFn accept) {
+  const bool removed = noteRemoved(oldPath);
+  const bool added = noteAdded(newPath, isDir, accept);
+  return removed && added;
 }
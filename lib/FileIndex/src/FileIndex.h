@@ -5,6 +5,19 @@
 #include <cstddef>
 #include <cstdint>
 
+/**
+ * Sorted listing of a large directory kept on the SD card, so the file
+ * browser can page through thousands of entries in bounded RAM.
+ *
+ * File /.papyrix/fileindex/<fnv64 of path>.idx:
+ *   Header, directory path, row table (u32 record offset per row, with spare
+ *   slots), then a name heap of records {flags u8, length u8, name, '\0'}.
+ * Rows are sorted directories first, then in natural name order.
+ *
+ * Changes the firmware makes itself (web uploads, renames, deletes, Calibre)
+ * are patched into an existing index with the note*() calls, so the next
+ * visit only has to confirm the listing instead of rebuilding it.
+ */
 class FileIndex {
  public:
   static constexpr size_t MAX_NAME = 255;
@@ -26,6 +39,15 @@ class FileIndex {
   bool entryAt(size_t row, Entry& out);
   size_t findRowByName(const char* name);
 
+  /**
+   * Update the index of the parent directory, if there is one, after the
+   * firmware changed an entry. Replaces an entry with the same name.
+   * @return false if the index could not be patched and was dropped
+   */
+  static bool noteAdded(const char* path, bool isDir, AcceptFn accept);
+  static bool noteRemoved(const char* path);
+  static bool noteRenamed(const char* oldPath, const char* newPath, bool isDir, AcceptFn accept);
+
  private:
 #pragma pack(push, 1)
   struct Header {
@@ -34,30 +56,49 @@ class FileIndex {
     uint8_t reserved;
     uint16_t pathLength;
     uint32_t directorySignature;
-    uint32_t recordsChecksum;
     uint32_t entryCount;
-    uint32_t recordsOffset;
+    uint32_t tableCapacity;
+    uint32_t heapOffset;
+    uint32_t heapSize;
+    uint16_t directoryDate;
+    uint16_t directoryTime;
   };
 
+  // On disk a record takes RECORD_HEAD + length + 1 bytes
   struct Record {
     uint8_t flags;
+    uint8_t length;
     char name[MAX_NAME + 1];
   };
 #pragma pack(pop)
 
+  static constexpr size_t RECORD_HEAD = 2;
+
   struct BuildState;
 
-  bool scanDirectory(const char* directory, AcceptFn accept, uint32_t& signature, uint32_t& count);
-  bool loadExisting(const char* directory, uint32_t signature, uint32_t count);
-  bool build(const char* directory, AcceptFn accept);
+  bool scanDirectory(FsFile& root, AcceptFn accept, uint32_t& signature, uint32_t& count);
+  bool build(const char* directory, AcceptFn accept, uint16_t directoryDate, uint16_t directoryTime);
   bool flushChunk(BuildState& state);
-  bool mergeRuns(BuildState& state, uint32_t recordCount, const char*& finalPath);
-  bool readRecordAt(size_t row, Record& record);
+  bool mergeRuns(BuildState& state, const char*& finalPath);
+  bool writeIndex(BuildState& state, const char* directory, const char* sortedPath, Header& header);
+
+  static bool makeIndexPath(const char* directory, char* out, size_t size);
+  static size_t recordSize(const Record& record) { return RECORD_HEAD + record.length + 1; }
+  static uint32_t recordHash(const Record& record);
+  static bool readNextRecord(FsFile& file, Record& record);
+  static bool writeRecord(FsFile& file, const Record& record);
+  static bool readHeader(FsFile& file, const char* directory, Header& out);
+  static bool verifyTable(FsFile& file, const Header& header);
+  static bool readRow(FsFile& file, const Header& header, size_t row, Record& record);
+  static size_t lowerBound(FsFile& file, const Header& header, const Record& key, Record& scratch, bool& ok);
+  static size_t findEqual(FsFile& file, const Header& header, uint8_t flags, const char* name, Record& scratch,
+                          bool& ok);
+  static bool patchDirectory(const char* directory, const char* removeName, const Record* add);
   static int compareRecords(const Record& left, const Record& right);
 
   FsFile indexFile_;
   Header header_{};
   bool opened_ = false;
   char indexPath_[64] = {};
-  char nameBuffer_[MAX_NAME + 1] = {};
+  Record record_{};
 };
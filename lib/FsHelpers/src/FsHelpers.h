@@ -24,6 +24,14 @@ class FsHelpers {
 
   static inline bool hasExtension(const std::string& path, const char* ext) { return hasExtension(path.c_str(), ext); }
 
+  // Case-insensitive match of a multi-part suffix such as ".fb2.zip"
+  static inline bool hasSuffix(const char* path, const char* suffix) {
+    if (!path || !suffix) return false;
+    const size_t pathLen = strlen(path);
+    const size_t suffixLen = strlen(suffix);
+    return pathLen > suffixLen && strcasecmp(path + pathLen - suffixLen, suffix) == 0;
+  }
+
   // Image formats
   static inline bool isJpegFile(const char* path) { return hasExtension(path, ".jpg") || hasExtension(path, ".jpeg"); }
   static inline bool isJpegFile(const std::string& path) { return isJpegFile(path.c_str()); }
@@ -55,7 +63,7 @@ class FsHelpers {
   }
   static inline bool isMarkdownFile(const std::string& path) { return isMarkdownFile(path.c_str()); }
 
-  static inline bool isFb2File(const char* path) { return hasExtension(path, ".fb2"); }
+  static inline bool isFb2File(const char* path) { return hasExtension(path, ".fb2") || hasSuffix(path, ".fb2.zip"); }
   static inline bool isFb2File(const std::string& path) { return isFb2File(path.c_str()); }
 
   static inline bool isHtmlFile(const char* path) { return hasExtension(path, ".html") || hasExtension(path, ".htm"); }
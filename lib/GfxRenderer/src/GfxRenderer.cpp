@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstring>
 
 #define TAG "GFX"
@@ -536,6 +537,95 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
   }
 }
 
+// Mirror a byte: bit 7 <-> bit 0. A logical row drawn right to left on the panel.
+static inline uint8_t reverseBits(uint8_t b) {
+  b = static_cast<uint8_t>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+  b = static_cast<uint8_t>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+  return static_cast<uint8_t>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+}
+
+static inline void mergeMaskByte(uint8_t& target, const uint8_t bits, const bool state) {
+  if (state) {
+    target &= static_cast<uint8_t>(~bits);
+  } else {
+    target |= bits;
+  }
+}
+
+void GfxRenderer::drawMaskRow(const uint8_t* row, const int x, const int y, const int width,
+                              const bool state) const {
+  const int screenW = getScreenWidth();
+  if (!row || y < 0 || y >= getScreenHeight()) return;
+  const int dxStart = std::max(0, -x);
+  const int dxEnd = std::min(width, screenW - x);
+  if (dxStart >= dxEnd) return;
+
+  const int panelW = einkDisplay.getDisplayWidth();
+  const int panelH = einkDisplay.getDisplayHeight();
+  const int stride = einkDisplay.getDisplayWidthBytes();
+  const int fullBytes = dxEnd >> 3;
+  const uint8_t tailMask = static_cast<uint8_t>(0xFF << (8 - (dxEnd & 7)));
+
+  switch (orientation) {
+    case LandscapeCounterClockwise:
+      // The logical row is a frame buffer row in the same bit order: merge whole bytes
+      if ((x & 7) == 0 && dxStart == 0) {
+        uint8_t* fbRow = frameBuffer + static_cast<size_t>(y) * stride + (x >> 3);
+        for (int i = 0; i < fullBytes; i++) mergeMaskByte(fbRow[i], row[i], state);
+        if (dxEnd & 7) mergeMaskByte(fbRow[fullBytes], row[fullBytes] & tailMask, state);
+        return;
+      }
+      break;
+    case LandscapeClockwise:
+      // A frame buffer row read right to left: merge whole bytes with their bits mirrored
+      if (((panelW - x) & 7) == 0 && dxStart == 0) {
+        uint8_t* fbRow = frameBuffer + static_cast<size_t>(panelH - 1 - y) * stride;
+        const int lastByte = ((panelW - x) >> 3) - 1;
+        for (int i = 0; i < fullBytes; i++) mergeMaskByte(fbRow[lastByte - i], reverseBits(row[i]), state);
+        if (dxEnd & 7) mergeMaskByte(fbRow[lastByte - fullBytes], reverseBits(row[fullBytes] & tailMask), state);
+        return;
+      }
+      break;
+    case Portrait:
+    case PortraitInverted: {
+      // The logical row is a panel column: every pixel sits in its own frame buffer
+      // row, so bytes cannot be merged one row at a time. Walk the column instead,
+      // with one fixed bit mask and a row stride, for any x.
+      const bool portrait = orientation == Portrait;
+      const int physX = portrait ? y : panelW - 1 - y;
+      const uint8_t bit = static_cast<uint8_t>(0x80 >> (physX & 7));
+      const ptrdiff_t step = portrait ? -static_cast<ptrdiff_t>(stride) : stride;
+      // Frame buffer index of logical column x + dx is origin + dx * step
+      const ptrdiff_t origin =
+          static_cast<ptrdiff_t>(portrait ? panelH - 1 - x : x) * stride + static_cast<ptrdiff_t>(physX >> 3);
+      for (int dx = dxStart; dx < dxEnd;) {
+        const uint8_t bits = row[dx >> 3];
+        const int byteEnd = std::min((dx & ~7) + 8, dxEnd);
+        if (bits != 0) {
+          for (int i = dx; i < byteEnd; i++) {
+            if (bits & (0x80 >> (i & 7))) mergeMaskByte(frameBuffer[origin + i * step], bit, state);
+          }
+        }
+        dx = byteEnd;
+      }
+      return;
+    }
+  }
+
+  // Landscape at an x that is not byte aligned on the panel: one pixel write per
+  // set bit, skipping empty bytes (image backgrounds are mostly blank)
+  for (int byteX = dxStart & ~7; byteX < dxEnd; byteX += 8) {
+    const uint8_t bits = row[byteX >> 3];
+    if (bits == 0) continue;
+    const int bitEnd = std::min(8, dxEnd - byteX);
+    for (int bit = std::max(0, dxStart - byteX); bit < bitEnd; bit++) {
+      if (bits & (0x80 >> bit)) {
+        orientedWriteFB(frameBuffer, stride, x + byteX + bit, y, orientation, panelW, panelH, state);
+      }
+    }
+  }
+}
+
 static unsigned long renderStartMs = 0;
 
 void GfxRenderer::clearScreen(const uint8_t color) const {
@@ -624,6 +714,16 @@ void GfxRenderer::displayBuffer(const EInkDisplay::RefreshMode refreshMode, bool
   einkDisplay.displayBuffer(refreshMode, turnOffScreen);
 }
 
+void GfxRenderer::beginDisplayBuffer(const EInkDisplay::RefreshMode refreshMode, bool turnOffScreen) const {
+  if (renderStartMs > 0) {
+    LOG_DBG(TAG, "Render took %lu ms", millis() - renderStartMs);
+    renderStartMs = 0;
+  }
+  einkDisplay.beginDisplayBuffer(refreshMode, turnOffScreen);
+}
+
+void GfxRenderer::finishRefresh() const { einkDisplay.finishRefresh(); }
+
 void GfxRenderer::displayWindow(int x, int y, int width, int height, bool turnOffScreen) const {
   int physX, physY, physW, physH;
   switch (orientation) {
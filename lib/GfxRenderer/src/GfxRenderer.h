@@ -191,6 +191,10 @@ class GfxRenderer {
   void displayBufferDriveAll(bool turnOffScreen = false) const;
   void displayBuffer(EInkDisplay::RefreshMode refreshMode = EInkDisplay::FAST_REFRESH,
                      bool turnOffScreen = false) const;
+  // Non-blocking displayBuffer(); call finishRefresh() before drawing into the frame buffer again
+  void beginDisplayBuffer(EInkDisplay::RefreshMode refreshMode = EInkDisplay::FAST_REFRESH,
+                          bool turnOffScreen = false) const;
+  void finishRefresh() const;
   // EXPERIMENTAL: Windowed update - display only a rectangular region
   void displayWindow(int x, int y, int width, int height, bool turnOffScreen = false) const;
   void invertScreen() const;
@@ -204,6 +208,8 @@ class GfxRenderer {
   void fillRect(int x, int y, int width, int height, bool state = true) const;
   void drawImage(const uint8_t bitmap[], int x, int y, int width, int height) const;
   void drawBitmap(const Bitmap& bitmap, int x, int y, int maxWidth, int maxHeight) const;
+  // Write `state` wherever a bit is set in a 1-bit MSB-first row; clear bits are left alone
+  void drawMaskRow(const uint8_t* row, int x, int y, int width, bool state = true) const;
 
   // Text
   int getTextWidth(int fontId, const char* text, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
@@ -244,6 +250,7 @@ class GfxRenderer {
 
   // Grayscale functions
   void setRenderMode(const RenderMode mode) { this->renderMode = mode; }
+  RenderMode getRenderMode() const { return renderMode; }
   void copyGrayscaleLsbBuffers() const;
   void copyGrayscaleMsbBuffers() const;
   void displayGrayBuffer(bool turnOffScreen = false) const;
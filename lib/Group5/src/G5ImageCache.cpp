@@ -7,7 +7,23 @@
 #include <cstring>
 
 bool G5ImageCache::compressToFile(const uint8_t* bitmap, int width, int height, const char* path) {
-  if (!bitmap || width <= 0 || height <= 0 || !path) {
+  if (!bitmap || width <= 0) {
+    return false;
+  }
+
+  const size_t rowBytes = (static_cast<size_t>(width) + 7) / 8;
+  return compressPlanesToFile(
+      width, height, 1,
+      [bitmap, rowBytes](int, int y, uint8_t* row) {
+        memcpy(row, bitmap + static_cast<size_t>(y) * rowBytes, rowBytes);
+        return true;
+      },
+      path);
+}
+
+bool G5ImageCache::compressPlanesToFile(int width, int height, int planeCount,
+                                        const std::function<bool(int, int, uint8_t*)>& readRow, const char* path) {
+  if (!readRow || width <= 0 || height <= 0 || !path || planeCount < 1 || planeCount > MAX_PLANES) {
     return false;
   }
 
@@ -21,69 +37,66 @@ bool G5ImageCache::compressToFile(const uint8_t* bitmap, int width, int height,
   }
 
   const size_t maxCompressedSize = estimateMaxCompressedSize(width, height);
-  if (maxCompressedSize > MAX_COMPRESSED_SIZE || !hasAllocationHeadroom(maxCompressedSize)) {
+  if (maxCompressedSize > MAX_COMPRESSED_SIZE || !hasAllocationHeadroom(maxCompressedSize + rowBytes)) {
     return false;
   }
 
   uint8_t* compressBuffer = new (std::nothrow) uint8_t[maxCompressedSize];
-  if (!compressBuffer) {
-    return false;
-  }
-
-  G5ENCODER encoder;
-  int result = encoder.init(width, height, compressBuffer, maxCompressedSize);
-  if (result != G5_SUCCESS) {
-    delete[] compressBuffer;
-    return false;
-  }
-
-  // Encode all rows
-  for (int y = 0; y < height; y++) {
-    result = encoder.encodeLine(const_cast<uint8_t*>(bitmap + static_cast<size_t>(y) * rowBytes));
-    if (result != G5_SUCCESS && result != G5_ENCODE_COMPLETE) {
-      delete[] compressBuffer;
-      return false;
-    }
-  }
-
-  const int compressedSize = encoder.size();
-  if (compressedSize <= 0 || static_cast<size_t>(compressedSize) > maxCompressedSize) {
+  uint8_t* rowBuffer = new (std::nothrow) uint8_t[rowBytes];
+  if (!compressBuffer || !rowBuffer) {
     delete[] compressBuffer;
+    delete[] rowBuffer;
     return false;
   }
 
-  // Write to file
   FsFile outFile;
   if (!SdMan.openFileForWrite("G5C", path, outFile)) {
     delete[] compressBuffer;
+    delete[] rowBuffer;
     return false;
   }
 
-  // Write header
-  G5ImageHeader header;
-  header.magic = G5_MAGIC;
-  header.width = width;
-  header.height = height;
-  header.compressedSize = compressedSize;
+  bool ok = true;
+  for (int plane = 0; plane < planeCount && ok; plane++) {
+    G5ENCODER encoder;
+    int result = encoder.init(width, height, compressBuffer, maxCompressedSize);
+    ok = result == G5_SUCCESS;
+
+    // Encode all rows
+    for (int y = 0; y < height && ok; y++) {
+      if (!readRow(plane, y, rowBuffer)) {
+        ok = false;
+        break;
+      }
+      result = encoder.encodeLine(rowBuffer);
+      ok = result == G5_SUCCESS || result == G5_ENCODE_COMPLETE;
+    }
+    if (!ok) break;
 
-  if (outFile.write(reinterpret_cast<uint8_t*>(&header), sizeof(header)) != sizeof(header)) {
-    outFile.close();
-    SdMan.remove(path);
-    delete[] compressBuffer;
-    return false;
-  }
+    const int compressedSize = encoder.size();
+    if (compressedSize <= 0 || static_cast<size_t>(compressedSize) > maxCompressedSize) {
+      ok = false;
+      break;
+    }
 
-  // Write compressed data
-  if (outFile.write(compressBuffer, compressedSize) != static_cast<size_t>(compressedSize)) {
-    outFile.close();
-    SdMan.remove(path);
-    delete[] compressBuffer;
-    return false;
+    // Write header, then compressed data
+    G5ImageHeader header;
+    header.magic = G5_MAGIC;
+    header.width = width;
+    header.height = height;
+    header.compressedSize = compressedSize;
+
+    ok = outFile.write(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+         outFile.write(compressBuffer, compressedSize) == static_cast<size_t>(compressedSize);
   }
 
   outFile.close();
   delete[] compressBuffer;
-  return true;
+  delete[] rowBuffer;
+  if (!ok) {
+    SdMan.remove(path);
+  }
+  return ok;
 }
 
 bool G5ImageCache::decompressFromFile(const char* path, std::function<void(const uint8_t*, int, int)> rowCallback) {
@@ -166,7 +179,95 @@ bool G5ImageCache::decompressFromFile(const char* path, std::function<void(const
   return true;
 }
 
-bool G5ImageCache::readHeader(const char* path, G5ImageHeader& header) {
+bool G5ImageCache::decompressPlanesFromFile(
+    const char* path, const std::function<void(const uint8_t* const*, int, int, int)>& rowCallback) {
+  if (!path || !rowCallback) {
+    return false;
+  }
+
+  FsFile inFile;
+  if (!SdMan.openFileForRead("G5C", path, inFile)) {
+    return false;
+  }
+
+  // Same zero padding as decompressFromFile, per plane
+  constexpr size_t DECODER_PADDING = sizeof(uint32_t);
+  const size_t fileSize = inFile.size();
+  G5ImageHeader headers[MAX_PLANES];
+  uint8_t* compressedData[MAX_PLANES] = {};
+  G5DECODER* decoders = nullptr;
+  uint8_t* rowBuffers = nullptr;
+  auto release = [&]() {
+    for (uint8_t* data : compressedData) delete[] data;
+    delete[] decoders;
+    delete[] rowBuffers;
+  };
+
+  int planeCount = 0;
+  size_t offset = 0;
+  size_t rowBytesSize = 0;
+  while (planeCount < MAX_PLANES && offset + sizeof(G5ImageHeader) <= fileSize) {
+    G5ImageHeader& header = headers[planeCount];
+    if (inFile.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) != sizeof(header) ||
+        !validateHeader(header, fileSize - offset, rowBytesSize) ||
+        (planeCount > 0 && (header.width != headers[0].width || header.height != headers[0].height))) {
+      inFile.close();
+      release();
+      return false;
+    }
+
+    const size_t bufferSize = static_cast<size_t>(header.compressedSize) + DECODER_PADDING;
+    uint8_t* data = hasAllocationHeadroom(bufferSize) ? new (std::nothrow) uint8_t[bufferSize] : nullptr;
+    compressedData[planeCount] = data;
+    if (!data || inFile.read(data, header.compressedSize) != header.compressedSize) {
+      inFile.close();
+      release();
+      return false;
+    }
+    memset(data + header.compressedSize, 0, DECODER_PADDING);
+    offset += sizeof(header) + header.compressedSize;
+    planeCount++;
+  }
+  inFile.close();
+
+  if (planeCount == 0) {
+    return false;
+  }
+
+  const int rowBytes = static_cast<int>(rowBytesSize);
+  decoders = new (std::nothrow) G5DECODER[planeCount];
+  rowBuffers = new (std::nothrow) uint8_t[rowBytesSize * planeCount];
+  if (!decoders || !rowBuffers) {
+    release();
+    return false;
+  }
+
+  const uint8_t* planes[MAX_PLANES] = {};
+  for (int p = 0; p < planeCount; p++) {
+    if (decoders[p].init(headers[p].width, headers[p].height, compressedData[p], headers[p].compressedSize) !=
+        G5_SUCCESS) {
+      release();
+      return false;
+    }
+    planes[p] = rowBuffers + rowBytesSize * p;
+  }
+
+  for (int y = 0; y < headers[0].height; y++) {
+    for (int p = 0; p < planeCount; p++) {
+      const int result = decoders[p].decodeLine(rowBuffers + rowBytesSize * p);
+      if (result != G5_SUCCESS && result != G5_DECODE_COMPLETE) {
+        release();
+        return false;
+      }
+    }
+    rowCallback(planes, planeCount, rowBytes, y);
+  }
+
+  release();
+  return true;
+}
+
+bool G5ImageCache::readHeader(const char* path, G5ImageHeader& header, int* planeCount) {
   if (!path) {
     return false;
   }
@@ -181,10 +282,32 @@ bool G5ImageCache::readHeader(const char* path, G5ImageHeader& header) {
     return false;
   }
   const size_t fileSize = inFile.size();
-  inFile.close();
 
   size_t rowBytes = 0;
-  return validateHeader(header, fileSize, rowBytes);
+  const bool valid = validateHeader(header, fileSize, rowBytes);
+  if (valid && planeCount) {
+    *planeCount = countPlanes(inFile, header);
+  }
+  inFile.close();
+  return valid;
+}
+
+int G5ImageCache::countPlanes(FsFile& file, const G5ImageHeader& first) {
+  const size_t fileSize = file.size();
+  size_t offset = sizeof(G5ImageHeader) + first.compressedSize;
+  int planes = 1;
+  while (planes < MAX_PLANES && offset + sizeof(G5ImageHeader) <= fileSize) {
+    G5ImageHeader next;
+    size_t rowBytes = 0;
+    if (!file.seek(offset) || file.read(reinterpret_cast<uint8_t*>(&next), sizeof(next)) != sizeof(next) ||
+        !validateHeader(next, fileSize - offset, rowBytes) || next.width != first.width ||
+        next.height != first.height) {
+      break;
+    }
+    offset += sizeof(next) + next.compressedSize;
+    planes++;
+  }
+  return planes;
 }
 
 bool G5ImageCache::validateHeader(const G5ImageHeader& header, size_t fileSize, size_t& rowBytes) {
@@ -9,7 +9,8 @@
 #include "Group5.h"
 
 // G5 compressed image file header
-// File format: [G5ImageHeader][compressed data]
+// File format: [G5ImageHeader][compressed data], repeated once per plane.
+// 1-bit images have one plane; 2-bit images have two (high bit, then low bit).
 struct G5ImageHeader {
   uint16_t magic;  // 0x4735 ('G5')
   uint16_t width;
@@ -37,18 +38,35 @@ class G5ImageCache {
   // Returns true on success
   static bool decompressFromFile(const char* path, std::function<void(const uint8_t*, int, int)> rowCallback);
 
+  // Compress planeCount planes of width x height, pulling rows from readRow
+  // readRow receives: (plane, y, row) and fills row with MSB-first packed pixels
+  // Planes are encoded one after another, so only one compressed buffer is live
+  // Returns true on success
+  static bool compressPlanesToFile(int width, int height, int planeCount,
+                                   const std::function<bool(int, int, uint8_t*)>& readRow, const char* path);
+
+  // Decompress every plane of a G5 file in lockstep
+  // rowCallback receives: (planes, planeCount, rowBytes, y)
+  // planes[i]: MSB-first packed pixels of plane i for row y
+  // Returns true on success
+  static bool decompressPlanesFromFile(const char* path,
+                                       const std::function<void(const uint8_t* const*, int, int, int)>& rowCallback);
+
   // Read header from a G5 file without decompressing
-  // Returns true if valid G5 file, populating header
-  static bool readHeader(const char* path, G5ImageHeader& header);
+  // Returns true if valid G5 file, populating header (and plane count if requested)
+  static bool readHeader(const char* path, G5ImageHeader& header, int* planeCount = nullptr);
 
   // Estimate worst-case compressed size for given dimensions
   // Group5 can expand data in worst case, this provides safe buffer size
   static size_t estimateMaxCompressedSize(int width, int height);
 
+  static constexpr int MAX_PLANES = 2;
+
  private:
   static constexpr size_t MAX_RAW_SIZE = 512 * 1024;
   static constexpr size_t MAX_COMPRESSED_SIZE = 512 * 1024;
 
   static bool validateHeader(const G5ImageHeader& header, size_t fileSize, size_t& rowBytes);
+  static int countPlanes(FsFile& file, const G5ImageHeader& first);
   static bool hasAllocationHeadroom(size_t bytes);
 };
@@ -193,6 +193,7 @@ static constexpr KeyMapping KEY_MAP[] = {
     {"BOOKS", StrId::STR_BOOKS},
     {"RECENT_BOOKS", StrId::STR_RECENT_BOOKS},
     {"NO_RECENT_BOOKS", StrId::STR_NO_RECENT_BOOKS},
+    {"ALL_BOOKS", StrId::STR_ALL_BOOKS},
     {"DELETE_FILE_Q", StrId::STR_DELETE_FILE_Q},
     {"DELETE_FOLDER_Q", StrId::STR_DELETE_FOLDER_Q},
     {"ENTER_PASSWORD", StrId::STR_ENTER_PASSWORD},
@@ -212,6 +212,7 @@ enum class StrId : uint8_t {
   STR_BOOKS,
   STR_RECENT_BOOKS,
   STR_NO_RECENT_BOOKS,
+  STR_ALL_BOOKS,
   STR_DELETE_FILE_Q,
   STR_DELETE_FOLDER_Q,
   STR_ENTER_PASSWORD,
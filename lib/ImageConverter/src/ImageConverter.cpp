@@ -2,6 +2,7 @@
 
 #include <Bitmap.h>
 #include <BitmapHelpers.h>
+#include <ByteSource.h>
 #include <FsHelpers.h>
 #include <JpegToBmpConverter.h>
 #include <Logging.h>
@@ -32,6 +33,12 @@ class JpegImageConverter : public ImageConverter {
                                                                  config.shouldAbort);
   }
 
+  bool convertStream(ByteSource& input, Print& output, const ImageConvertConfig& config) override {
+    return JpegToBmpConverter::jpegStreamToBmpStream(input, output, config.maxWidth, config.maxHeight, config.oneBit,
+                                                     config.requireDithering, config.shouldAbort);
+  }
+
+  bool canStream() const override { return true; }
   const char* formatName() const override { return "JPEG"; }
 };
 
@@ -42,6 +49,12 @@ class PngImageConverter : public ImageConverter {
                                                          config.oneBit, config.requireDithering, config.shouldAbort);
   }
 
+  bool convertStream(ByteSource& input, Print& output, const ImageConvertConfig& config) override {
+    return PngToBmpConverter::pngStreamToBmpStream(input, output, config.maxWidth, config.maxHeight, config.oneBit,
+                                                   config.requireDithering, config.shouldAbort);
+  }
+
+  bool canStream() const override { return true; }
   const char* formatName() const override { return "PNG"; }
 };
 
@@ -138,24 +151,87 @@ JpegImageConverter jpegConverter;
 PngImageConverter pngConverter;
 BmpImageConverter bmpConverter;
 
+constexpr size_t SIGNATURE_SIZE = 8;
+
 ImageFormat detectFormat(FsFile& file) {
   const auto originalPosition = file.position();
   if (!file.seek(0)) return ImageFormat::Unknown;
 
-  uint8_t signature[8] = {};
+  uint8_t signature[SIGNATURE_SIZE] = {};
   const int count = file.read(signature, sizeof(signature));
   const bool restored = file.seek(originalPosition);
   if (count < 0 || !restored) return ImageFormat::Unknown;
 
-  if (count >= 2 && signature[0] == 0xFF && signature[1] == 0xD8) return ImageFormat::Jpeg;
+  return ImageConverterFactory::detectFormat(signature, static_cast<size_t>(count));
+}
 
-  static const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
-  if (count >= static_cast<int>(sizeof(pngSignature)) && memcmp(signature, pngSignature, sizeof(pngSignature)) == 0) {
-    return ImageFormat::Png;
+// Fill `signature` from the start of a stream; short reads are retried until end of data
+size_t readSignature(ByteSource& input, uint8_t* signature) {
+  size_t count = 0;
+  while (count < SIGNATURE_SIZE) {
+    const int n = input.read(signature + count, SIGNATURE_SIZE - count);
+    if (n <= 0) break;
+    count += static_cast<size_t>(n);
   }
+  return count;
+}
 
-  if (count >= 2 && signature[0] == 'B' && signature[1] == 'M') return ImageFormat::Bmp;
-  return ImageFormat::Unknown;
+// Stack safety gate: PNG/JPEG decode (pngle + zlib/tinflate) is the deepest call chain in
+// the reader and can overflow a constrained task stack, panicking the whole device. If the
+// current task's free stack is below the safety floor, skip this image gracefully instead —
+// callers can skip or retry the asset rather than rebooting. The 12 KB foreground and Reader
+// background task stacks keep this gate from triggering in normal use; it only fires when the stack is genuinely
+// tight (deeper-than-expected nesting, huge image), which is exactly when a skip beats a crash.
+bool hasImageStackHeadroom() {
+  constexpr size_t kMinImageStackBytes = 4096;
+  return uxTaskGetStackHighWaterMark(nullptr) * sizeof(StackType_t) >= kMinImageStackBytes;
+}
+
+// Run `convert` into <outputPath>.part, validate, then publish atomically so readers never
+// see a half-written BMP.
+bool convertAndPublish(const ImageConverter& converter, const std::string& outputPath,
+                       const ImageConvertConfig& config, const std::function<bool(Print&)>& convert) {
+  const std::string partPath = outputPath + ".part";
+  SdMan.remove(partPath.c_str());
+
+  FsFile outputFile;
+  if (!SdMan.openFileForWrite(config.logTag, partPath, outputFile)) {
+    LOG_ERR(config.logTag, "Failed to create output file: %s", partPath.c_str());
+    return false;
+  }
+
+  const bool success = convert(outputFile);
+  outputFile.close();
+
+  if (!success) {
+    LOG_ERR(config.logTag, "Failed to convert %s to BMP", converter.formatName());
+    SdMan.remove(partPath.c_str());
+    return false;
+  }
+
+  if (config.validateOutput && !config.validateOutput(partPath)) {
+    LOG_ERR(config.logTag, "Converted BMP failed validation: %s", partPath.c_str());
+    SdMan.remove(partPath.c_str());
+    return false;
+  }
+
+  // Publish the completed BMP (commitFile removes a stale output first because
+  // SdFat can't rename over an existing file).
+  if (!SdMan.commitFile(partPath.c_str(), outputPath.c_str())) {
+    LOG_ERR(config.logTag, "Failed to commit %s -> %s", partPath.c_str(), outputPath.c_str());
+    SdMan.remove(partPath.c_str());
+    return false;
+  }
+
+  LOG_INF(config.logTag, "Converted %s to BMP: %s", converter.formatName(), outputPath.c_str());
+
+  // Stack headroom probe: image conversion (PNG/JPEG decode) is the deepest call chain.
+  // Report remaining stack so a future regression shows up as a shrinking
+  // high-water mark instead of a mystery "Stack protection fault" crash. Everything is a
+  // LOG_DBG argument, so it compiles to nothing at LOG_LEVEL<2 (release).
+  LOG_DBG(config.logTag, "Stack headroom: %u bytes (%s)",
+          static_cast<unsigned>(uxTaskGetStackHighWaterMark(nullptr) * sizeof(StackType_t)), pcTaskGetName(nullptr));
+  return true;
 }
 
 ImageConverter* converterForFormat(const ImageFormat format) {
@@ -184,14 +260,7 @@ ImageFormat ImageConverterFactory::detectFormat(const std::string& filePath) {
 
 bool ImageConverterFactory::convertToBmp(const std::string& inputPath, const std::string& outputPath,
                                          const ImageConvertConfig& config) {
-  // Stack safety gate: PNG/JPEG decode (pngle + zlib/tinflate) is the deepest call chain in
-  // the reader and can overflow a constrained task stack, panicking the whole device. If the
-  // current task's free stack is below the safety floor, skip this image gracefully instead —
-  // callers can skip or retry the asset rather than rebooting. The 12 KB foreground and Reader
-  // background task stacks keep this gate from triggering in normal use; it only fires when the stack is genuinely
-  // tight (deeper-than-expected nesting, huge image), which is exactly when a skip beats a crash.
-  constexpr size_t kMinImageStackBytes = 4096;
-  if (uxTaskGetStackHighWaterMark(nullptr) * sizeof(StackType_t) < kMinImageStackBytes) {
+  if (!hasImageStackHeadroom()) {
     LOG_WRN(config.logTag, "Skip image convert (low stack): %s", inputPath.c_str());
     return false;
   }
@@ -209,51 +278,65 @@ bool ImageConverterFactory::convertToBmp(const std::string& inputPath, const std
     return false;
   }
 
-  // Atomic publish: convert to .part then rename so readers never see a half-written BMP.
-  const std::string partPath = outputPath + ".part";
-  SdMan.remove(partPath.c_str());
+  const bool success = convertAndPublish(*converter, outputPath, config,
+                                         [&](Print& output) { return converter->convert(inputFile, output, config); });
+  inputFile.close();
+  return success;
+}
 
-  FsFile outputFile;
-  if (!SdMan.openFileForWrite(config.logTag, partPath, outputFile)) {
-    inputFile.close();
-    LOG_ERR(config.logTag, "Failed to create output file: %s", partPath.c_str());
+bool ImageConverterFactory::convertToBmp(ByteSource& input, const std::string& outputPath,
+                                         const ImageConvertConfig& config) {
+  if (!hasImageStackHeadroom()) {
+    LOG_WRN(config.logTag, "Skip image convert (low stack): %s", outputPath.c_str());
     return false;
   }
 
-  const bool success = converter->convert(inputFile, outputFile, config);
-
-  inputFile.close();
-  outputFile.close();
-
-  if (!success) {
-    LOG_ERR(config.logTag, "Failed to convert %s to BMP", converter->formatName());
-    SdMan.remove(partPath.c_str());
+  uint8_t signature[SIGNATURE_SIZE] = {};
+  const size_t signatureLen = readSignature(input, signature);
+  ImageConverter* converter = converterForFormat(detectFormat(signature, signatureLen));
+  if (!converter) {
+    LOG_ERR(config.logTag, "Unsupported image stream for %s", outputPath.c_str());
     return false;
   }
 
-  if (config.validateOutput && !config.validateOutput(partPath)) {
-    LOG_ERR(config.logTag, "Converted BMP failed validation: %s", partPath.c_str());
-    SdMan.remove(partPath.c_str());
-    return false;
+  PrefixedByteSource source(input, signature, signatureLen);
+  if (converter->canStream()) {
+    return convertAndPublish(*converter, outputPath, config,
+                             [&](Print& output) { return converter->convertStream(source, output, config); });
   }
 
-  // Publish the completed BMP (commitFile removes a stale output first because
-  // SdFat can't rename over an existing file).
-  if (!SdMan.commitFile(partPath.c_str(), outputPath.c_str())) {
-    LOG_ERR(config.logTag, "Failed to commit %s -> %s", partPath.c_str(), outputPath.c_str());
-    SdMan.remove(partPath.c_str());
+  // Seeking decoder: spool the stream to a temp file and convert from there
+  const std::string spoolPath = outputPath + ".src";
+  FsFile spool;
+  if (!SdMan.openFileForWrite(config.logTag, spoolPath, spool)) {
+    LOG_ERR(config.logTag, "Failed to create spool file: %s", spoolPath.c_str());
     return false;
   }
+  uint8_t buffer[512];
+  bool spooled = true;
+  int n;
+  while ((n = source.read(buffer, sizeof(buffer))) > 0) {
+    if (spool.write(buffer, static_cast<size_t>(n)) != static_cast<size_t>(n)) {
+      spooled = false;
+      break;
+    }
+  }
+  spool.close();
+  const bool success = spooled && n == 0 && convertToBmp(spoolPath, outputPath, config);
+  SdMan.remove(spoolPath.c_str());
+  return success;
+}
 
-  LOG_INF(config.logTag, "Converted %s to BMP: %s", converter->formatName(), outputPath.c_str());
+ImageFormat ImageConverterFactory::detectFormat(const uint8_t* signature, const size_t len) {
+  if (len >= 2 && signature[0] == 0xFF && signature[1] == 0xD8) return ImageFormat::Jpeg;
 
-  // Stack headroom probe: image conversion (PNG/JPEG decode) is the deepest call chain.
-  // Report remaining stack so a future regression shows up as a shrinking
-  // high-water mark instead of a mystery "Stack protection fault" crash. Everything is a
-  // LOG_DBG argument, so it compiles to nothing at LOG_LEVEL<2 (release).
-  LOG_DBG(config.logTag, "Stack headroom: %u bytes (%s)",
-          static_cast<unsigned>(uxTaskGetStackHighWaterMark(nullptr) * sizeof(StackType_t)), pcTaskGetName(nullptr));
-  return true;
+  static const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+  if (len >= sizeof(pngSignature) && memcmp(signature, pngSignature, sizeof(pngSignature)) == 0) {
+    return ImageFormat::Png;
+  }
+
+  if (len >= 2 && signature[0] == 'B' && signature[1] == 'M') return ImageFormat::Bmp;
+  return ImageFormat::Unknown;
 }
 
 bool ImageConverterFactory::isSupported(const std::string& filePath) { return FsHelpers::isImageFile(filePath); }
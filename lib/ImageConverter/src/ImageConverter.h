@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
 
+class ByteSource;
 class FsFile;
 class Print;
 
@@ -28,6 +30,9 @@ class ImageConverter {
  public:
   virtual ~ImageConverter() = default;
   virtual bool convert(FsFile& input, Print& output, const ImageConvertConfig& config) = 0;
+  // Forward-only input, for converters whose decoder never seeks (canStream())
+  virtual bool convertStream(ByteSource&, Print&, const ImageConvertConfig&) { return false; }
+  virtual bool canStream() const { return false; }
   virtual const char* formatName() const = 0;
 };
 
@@ -35,11 +40,18 @@ class ImageConverterFactory {
  public:
   // Detect the actual source type from its file signature.
   static ImageFormat detectFormat(const std::string& filePath);
+  // Same, from the first bytes of a stream (8 are enough for every supported format)
+  static ImageFormat detectFormat(const uint8_t* signature, size_t len);
 
   // Convenience: convert file to BMP in one call (handles file I/O)
   static bool convertToBmp(const std::string& inputPath, const std::string& outputPath,
                            const ImageConvertConfig& config = {});
 
+  // Convert straight from a stream such as an inflating ZIP entry, without a temp
+  // copy of the source. Format comes from the first bytes. Formats that need seeking
+  // (BMP) are spooled to a temp file next to outputPath first.
+  static bool convertToBmp(ByteSource& input, const std::string& outputPath, const ImageConvertConfig& config = {});
+
   // Check if format is supported
   static bool isSupported(const std::string& filePath);
 };
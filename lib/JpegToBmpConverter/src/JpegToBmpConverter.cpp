@@ -1,5 +1,6 @@
 #include "JpegToBmpConverter.h"
 
+#include <ByteSource.h>
 #include <Logging.h>
 
 #define TAG "JPEG"
@@ -15,7 +16,7 @@
 
 // Context structure for picojpeg callback
 struct JpegReadContext {
-  FsFile& file;
+  ByteSource& source;
   uint8_t buffer[512];
   size_t bufferPos;
   size_t bufferFilled;
@@ -194,7 +195,7 @@ unsigned char JpegToBmpConverter::jpegReadCallback(unsigned char* pBuf, const un
                                                    unsigned char* pBytes_actually_read, void* pCallback_data) {
   auto* context = static_cast<JpegReadContext*>(pCallback_data);
 
-  if (!context || !context->file) {
+  if (!context) {
     return PJPG_STREAM_READ_ERROR;
   }
   if (context->shouldAbort && *context->shouldAbort && (*context->shouldAbort)()) {
@@ -204,7 +205,7 @@ unsigned char JpegToBmpConverter::jpegReadCallback(unsigned char* pBuf, const un
 
   // Check if we need to refill our context buffer
   if (context->bufferPos >= context->bufferFilled) {
-    const int bytesRead = context->file.read(context->buffer, sizeof(context->buffer));
+    const int bytesRead = context->source.read(context->buffer, sizeof(context->buffer));
     context->bufferFilled = bytesRead > 0 ? static_cast<size_t>(bytesRead) : 0;
     context->bufferPos = 0;
 
@@ -225,12 +226,10 @@ unsigned char JpegToBmpConverter::jpegReadCallback(unsigned char* pBuf, const un
   return 0;  // Success
 }
 
-// Internal implementation with configurable target size and bit depth
+// File input: reject unsupported encodings with a cheap marker scan before decoding
 bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bmpOut, int targetWidth, int targetHeight,
                                                      bool oneBit, bool requireDithering,
                                                      const std::function<bool()>& shouldAbort) {
-  LOG_INF(TAG, "Converting JPEG to %s BMP (target: %dx%d)", oneBit ? "1-bit" : "2-bit", targetWidth, targetHeight);
-
   // Check for unsupported JPEG encoding (progressive or arithmetic) before attempting decode
   bool scanAborted = false;
   if (isUnsupportedJpeg(jpegFile, shouldAbort, scanAborted)) {
@@ -239,9 +238,20 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
   }
   if (scanAborted) return false;
 
+  FileByteSource<FsFile> source(jpegFile);
+  return jpegToBmpInternal(source, bmpOut, targetWidth, targetHeight, oneBit, requireDithering, shouldAbort);
+}
+
+// Internal implementation with configurable target size and bit depth. Reads forward only, so stream
+// input relies on picojpeg's own SOF check to reject progressive/arithmetic JPEGs.
+bool JpegToBmpConverter::jpegToBmpInternal(ByteSource& jpegSource, Print& bmpOut, int targetWidth, int targetHeight,
+                                           bool oneBit, bool requireDithering,
+                                           const std::function<bool()>& shouldAbort) {
+  LOG_INF(TAG, "Converting JPEG to %s BMP (target: %dx%d)", oneBit ? "1-bit" : "2-bit", targetWidth, targetHeight);
+
   // Setup context for picojpeg callback
   JpegReadContext context = {
-      .file = jpegFile,
+      .source = jpegSource,
       .bufferPos = 0,
       .bufferFilled = 0,
       .shouldAbort = &shouldAbort,
@@ -259,17 +269,11 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
   LOG_INF(TAG, "JPEG dimensions: %dx%d, components: %d, MCUs: %dx%d", imageInfo.m_width, imageInfo.m_height,
           imageInfo.m_comps, imageInfo.m_MCUSPerRow, imageInfo.m_MCUSPerCol);
 
-  // Safety limits to prevent memory issues on ESP32
+  // Safety limits to prevent memory issues on ESP32 (applied to the decoded size, after DCT scaling)
   constexpr int MAX_IMAGE_WIDTH = 2048;
   constexpr int MAX_IMAGE_HEIGHT = 3072;
   constexpr int MAX_MCU_ROW_BYTES = 65536;
 
-  if (imageInfo.m_width > MAX_IMAGE_WIDTH || imageInfo.m_height > MAX_IMAGE_HEIGHT) {
-    LOG_ERR(TAG, "Image too large (%dx%d), max supported: %dx%d", imageInfo.m_width, imageInfo.m_height,
-            MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT);
-    return false;
-  }
-
   // Calculate output dimensions (pre-scale to fit display exactly)
   int outWidth = imageInfo.m_width;
   int outHeight = imageInfo.m_height;
@@ -288,13 +292,32 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
 
     if (outWidth < 1) outWidth = 1;
     if (outHeight < 1) outHeight = 1;
+  }
 
-    scaleX_fp = (static_cast<uint32_t>(imageInfo.m_width) << 16) / outWidth;
-    scaleY_fp = (static_cast<uint32_t>(imageInfo.m_height) << 16) / outHeight;
-    needsScaling = true;
+  // Let picojpeg drop 1/2, 1/4 or 1/8 of the resolution in the DCT domain while the decoded image still covers the
+  // output size; the area averaging below only handles what is left.
+  const int decodeScale = decodeScaleFor(imageInfo.m_width, imageInfo.m_height, outWidth, outHeight);
+  if (decodeScale > 0 && pjpeg_set_scale(static_cast<unsigned char>(decodeScale)) != 0) {
+    LOG_ERR(TAG, "JPEG scaled decode (1/%d) not supported", 1 << decodeScale);
+    return false;
+  }
+  const int scaleRound = (1 << decodeScale) - 1;
+  const int srcWidth = (imageInfo.m_width + scaleRound) >> decodeScale;
+  const int srcHeight = (imageInfo.m_height + scaleRound) >> decodeScale;
 
-    LOG_INF(TAG, "Scaling %dx%d -> %dx%d (target %dx%d)", imageInfo.m_width, imageInfo.m_height, outWidth, outHeight,
-            targetWidth, targetHeight);
+  if (srcWidth > MAX_IMAGE_WIDTH || srcHeight > MAX_IMAGE_HEIGHT) {
+    LOG_ERR(TAG, "Image too large (%dx%d decoded at 1/%d), max supported: %dx%d", imageInfo.m_width,
+            imageInfo.m_height, 1 << decodeScale, MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT);
+    return false;
+  }
+
+  if (outWidth != imageInfo.m_width || outHeight != imageInfo.m_height) {
+    scaleX_fp = (static_cast<uint32_t>(srcWidth) << 16) / outWidth;
+    scaleY_fp = (static_cast<uint32_t>(srcHeight) << 16) / outHeight;
+    needsScaling = scaleX_fp != 65536 || scaleY_fp != 65536;
+
+    LOG_INF(TAG, "Scaling %dx%d -> %dx%d (DCT 1/%d, target %dx%d)", imageInfo.m_width, imageInfo.m_height, outWidth,
+            outHeight, 1 << decodeScale, targetWidth, targetHeight);
   }
 
   // Write BMP header with output dimensions
@@ -319,8 +342,8 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
 
   // Allocate a buffer for one MCU row worth of grayscale pixels
   // This is the minimal memory needed for streaming conversion
-  const int mcuPixelHeight = imageInfo.m_MCUHeight;
-  const int mcuRowPixels = imageInfo.m_width * mcuPixelHeight;
+  const int mcuPixelHeight = imageInfo.m_MCUHeight >> decodeScale;
+  const int mcuRowPixels = srcWidth * mcuPixelHeight;
 
   // Validate MCU row buffer size before allocation
   if (mcuRowPixels > MAX_MCU_ROW_BYTES) {
@@ -402,7 +425,8 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
   }
 
   // Process MCUs row-by-row and write to BMP as we go (top-down)
-  const int mcuPixelWidth = imageInfo.m_MCUWidth;
+  const int mcuPixelWidth = imageInfo.m_MCUWidth >> decodeScale;
+  const int blockPixels = 8 >> decodeScale;
 
   for (int mcuY = 0; mcuY < imageInfo.m_MCUSPerCol; mcuY++) {
     if (shouldAbort && shouldAbort()) {
@@ -439,25 +463,23 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
         return false;
       }
 
-      // picojpeg stores MCU data in 8x8 blocks
+      // picojpeg stores MCU data in 8x8 blocks (only the top-left blockPixels square when scaled)
       // Block layout: H2V2(16x16)=0,64,128,192 H2V1(16x8)=0,64 H1V2(8x16)=0,128
       for (int blockY = 0; blockY < mcuPixelHeight; blockY++) {
         for (int blockX = 0; blockX < mcuPixelWidth; blockX++) {
           const int pixelX = mcuX * mcuPixelWidth + blockX;
-          if (pixelX >= imageInfo.m_width) continue;
+          if (pixelX >= srcWidth) continue;
 
           // Calculate proper block offset for picojpeg buffer
-          const int blockCol = blockX / 8;
-          const int blockRow = blockY / 8;
-          const int localX = blockX % 8;
-          const int localY = blockY % 8;
-          const int blocksPerRow = mcuPixelWidth / 8;
-          const int blockIndex = blockRow * blocksPerRow + blockCol;
-          const int pixelOffset = blockIndex * 64 + localY * 8 + localX;
+          const int blockCol = blockX / blockPixels;
+          const int blockRow = blockY / blockPixels;
+          const int localX = blockX % blockPixels;
+          const int localY = blockY % blockPixels;
+          const int pixelOffset = blockRow * 128 + blockCol * 64 + localY * 8 + localX;
 
           const uint8_t gray = imageInfo.m_pMCUBufR[pixelOffset];
 
-          mcuRowBuffer[blockY * imageInfo.m_width + pixelX] = gray;
+          mcuRowBuffer[blockY * srcWidth + pixelX] = gray;
         }
       }
 
@@ -478,7 +500,7 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
     const int startRow = mcuY * mcuPixelHeight;
     const int endRow = (mcuY + 1) * mcuPixelHeight;
 
-    for (int y = startRow; y < endRow && y < imageInfo.m_height; y++) {
+    for (int y = startRow; y < endRow && y < srcHeight; y++) {
       const int bufferY = y - startRow;
 
       if (!needsScaling) {
@@ -487,13 +509,13 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
 
         if (USE_8BIT_OUTPUT && !oneBit) {
           for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = mcuRowBuffer[bufferY * imageInfo.m_width + x];
+            const uint8_t gray = mcuRowBuffer[bufferY * srcWidth + x];
             rowBuffer[x] = adjustPixel(gray);
           }
         } else if (oneBit) {
           // 1-bit output with Atkinson dithering for better quality
           for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = mcuRowBuffer[bufferY * imageInfo.m_width + x];
+            const uint8_t gray = mcuRowBuffer[bufferY * srcWidth + x];
             const uint8_t bit =
                 atkinson1BitDitherer ? atkinson1BitDitherer->processPixel(gray, x) : quantize1bit(gray, x, y);
             // Pack 1-bit value: MSB first, 8 pixels per byte
@@ -505,7 +527,7 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
         } else {
           // 2-bit output
           for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = adjustPixel(mcuRowBuffer[bufferY * imageInfo.m_width + x]);
+            const uint8_t gray = adjustPixel(mcuRowBuffer[bufferY * srcWidth + x]);
             uint8_t twoBit;
             if (atkinsonDitherer) {
               twoBit = atkinsonDitherer->processPixel(gray, x);
@@ -528,7 +550,7 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
         // Fixed-point area averaging for exact fit scaling
         // For each output pixel X, accumulate source pixels that map to it
         // srcX range for outX: [outX * scaleX_fp >> 16, (outX+1) * scaleX_fp >> 16)
-        const uint8_t* srcRow = mcuRowBuffer + bufferY * imageInfo.m_width;
+        const uint8_t* srcRow = mcuRowBuffer + bufferY * srcWidth;
 
         for (int outX = 0; outX < outWidth; outX++) {
           // Calculate source X range for this output pixel
@@ -538,13 +560,13 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
           // Accumulate all source pixels in this range
           int sum = 0;
           int count = 0;
-          for (int srcX = srcXStart; srcX < srcXEnd && srcX < imageInfo.m_width; srcX++) {
+          for (int srcX = srcXStart; srcX < srcXEnd && srcX < srcWidth; srcX++) {
             sum += srcRow[srcX];
             count++;
           }
 
           // Handle edge case: if no pixels in range, use nearest
-          if (count == 0 && srcXStart < imageInfo.m_width) {
+          if (count == 0 && srcXStart < srcWidth) {
             sum = srcRow[srcXStart];
             count = 1;
           }
@@ -663,3 +685,11 @@ bool JpegToBmpConverter::jpegFileTo1BitBmpStreamWithSize(FsFile& jpegFile, Print
   return jpegFileToBmpStreamInternal(jpegFile, bmpOut, targetMaxWidth, targetMaxHeight, true, requireDithering,
                                      shouldAbort);
 }
+
+// Convert from a forward-only stream (e.g. an inflating ZIP entry)
+bool JpegToBmpConverter::jpegStreamToBmpStream(ByteSource& jpegSource, Print& bmpOut, int targetMaxWidth,
+                                               int targetMaxHeight, const bool oneBit, const bool requireDithering,
+                                               const std::function<bool()>& shouldAbort) {
+  return jpegToBmpInternal(jpegSource, bmpOut, targetMaxWidth, targetMaxHeight, oneBit, requireDithering,
+                           shouldAbort);
+}
@@ -2,6 +2,7 @@
 
 #include <functional>
 
+class ByteSource;
 class FsFile;
 class Print;
 class ZipFile;
@@ -11,6 +12,8 @@ class JpegToBmpConverter {
                                         unsigned char* pBytes_actually_read, void* pCallback_data);
   static bool jpegFileToBmpStreamInternal(class FsFile& jpegFile, Print& bmpOut, int targetWidth, int targetHeight,
                                           bool oneBit, bool requireDithering, const std::function<bool()>& shouldAbort);
+  static bool jpegToBmpInternal(ByteSource& jpegSource, Print& bmpOut, int targetWidth, int targetHeight, bool oneBit,
+                                bool requireDithering, const std::function<bool()>& shouldAbort);
 
  public:
   static bool jpegFileToBmpStream(FsFile& jpegFile, Print& bmpOut);
@@ -23,4 +26,15 @@ class JpegToBmpConverter {
   static bool jpegFileTo1BitBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight,
                                               const std::function<bool()>& shouldAbort = nullptr,
                                               bool requireDithering = false);
+  // log2 of the DCT-domain downscale (0..3 = 1/1..1/8) picojpeg can decode at while still covering outWidth x
+  // outHeight, so the area averaging never has to upscale
+  static int decodeScaleFor(const int srcWidth, const int srcHeight, const int outWidth, const int outHeight) {
+    int scale = 0;
+    while (scale < 3 && (srcWidth >> (scale + 1)) >= outWidth && (srcHeight >> (scale + 1)) >= outHeight) scale++;
+    return scale;
+  }
+  // Convert from a forward-only stream (e.g. ZipEntryReader), no temp file needed
+  static bool jpegStreamToBmpStream(ByteSource& jpegSource, Print& bmpOut, int targetMaxWidth, int targetMaxHeight,
+                                    bool oneBit, bool requireDithering = false,
+                                    const std::function<bool()>& shouldAbort = nullptr);
 };
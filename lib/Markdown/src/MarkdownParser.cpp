@@ -47,6 +47,11 @@ void MarkdownParser::reset() {
   pendingSpacing_ = 0;
   pendingPage_.reset();
   pendingPageNextY_ = 0;
+  toc_.stop();
+  pagesEmitted_ = 0;
+  lineOffset_ = 0;
+  blockOffset_ = 0;
+  blockHasLines_ = false;
 }
 
 int MarkdownParser::getCurrentFontStyle(const ParseContext& ctx) const {
@@ -79,6 +84,7 @@ void MarkdownParser::startNewTextBlock(ParseContext& ctx, const int style) {
   if (ctx.textBlock) {
     if (ctx.textBlock->isEmpty()) {
       ctx.textBlock->setStyle(static_cast<TextBlock::BLOCK_STYLE>(style));
+      blockOffset_ = lineOffset_;
       return;
     }
     flushTextBlock(ctx);
@@ -86,6 +92,8 @@ void MarkdownParser::startNewTextBlock(ParseContext& ctx, const int style) {
   }
   ctx.textBlock.reset(new ParsedText(static_cast<TextBlock::BLOCK_STYLE>(style), config_.indentLevel,
                                      config_.hyphenation, true, isRtl_));
+  blockOffset_ = lineOffset_;
+  blockHasLines_ = false;
 }
 
 void MarkdownParser::flushTextBlock(ParseContext& ctx) {
@@ -143,11 +151,13 @@ bool MarkdownParser::addLineToPage(ParseContext& ctx, std::shared_ptr<TextBlock>
       LOG_DBG(TAG, "Page %u complete, heap: %zu free", ctx.pagesCreated, freeHeap);
       ctx.onPageComplete(std::move(ctx.currentPage));
       ctx.pagesCreated++;
+      pagesEmitted_++;
 
       if (freeHeap < 12000) {
         LOG_ERR(TAG, "Stopping early due to low memory (%zu bytes)", freeHeap);
         ctx.currentPage.reset(new Page());
         ctx.pageNextY = 0;
+        markBlockPlaced();
         ctx.currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, ctx.pageNextY));
         ctx.pageNextY += lineHeight;
         ctx.hitMaxPages = true;
@@ -158,6 +168,7 @@ bool MarkdownParser::addLineToPage(ParseContext& ctx, std::shared_ptr<TextBlock>
     ctx.pageNextY = 0;
 
     if (ctx.maxPages > 0 && ctx.pagesCreated >= ctx.maxPages) {
+      markBlockPlaced();
       ctx.currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, ctx.pageNextY));
       ctx.pageNextY += lineHeight;
       ctx.hitMaxPages = true;
@@ -165,11 +176,19 @@ bool MarkdownParser::addLineToPage(ParseContext& ctx, std::shared_ptr<TextBlock>
     }
   }
 
+  markBlockPlaced();
   ctx.currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, ctx.pageNextY));
   ctx.pageNextY += lineHeight;
   return true;
 }
 
+// The first line of each text block tells the TOC which page a heading starts on
+void MarkdownParser::markBlockPlaced() {
+  if (blockHasLines_) return;
+  blockHasLines_ = true;
+  toc_.onBlockStart(pagesEmitted_, blockOffset_);
+}
+
 bool MarkdownParser::readLine(FsFile& file) {
   int i = 0;
   bool readAnyChar = false;
@@ -406,6 +425,11 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
     file.seekSet(currentOffset_ + bomSkipBytes_);
   }
 
+  if (currentOffset_ == 0 && !pendingPage_ && !pendingTextBlock_) {
+    pagesEmitted_ = 0;
+    toc_.begin(config_);
+  }
+
   LOG_INF(TAG, "Parsing from offset %zu, file size %zu", currentOffset_, fileSize_);
   LOG_DBG(TAG, "Heap: %zu free", heap_caps_get_free_size(MALLOC_CAP_8BIT));
 
@@ -456,6 +480,7 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
   }
 
   // Start with a paragraph block
+  lineOffset_ = static_cast<uint32_t>(currentOffset_);
   startNewTextBlock(ctx, config_.paragraphAlignment);
 
   size_t bytesProcessed = 0;
@@ -470,7 +495,9 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
       break;
     }
 
+    lineOffset_ = static_cast<uint32_t>(file.position());
     if (!readLine(file)) {
+      toc_.onEnd();
       break;
     }
 
@@ -486,6 +513,8 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
     }
 
     if (isBlank) {
+      // Before the flush: a heading waiting for this blank line goes with the block it ends
+      toc_.onLine(lineBuffer_, static_cast<size_t>(lineLen), lineOffset_, false);
       if (!prevLineBlank && !ctx.inCodeBlock) {
         flushTextBlock(ctx);
         if (!ctx.hitMaxPages) {
@@ -503,6 +532,8 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
 
     // Parse the line
     md_parse(&parser, lineBuffer_, lineLen);
+    // After parsing: a header line has already placed its own block
+    toc_.onLine(lineBuffer_, static_cast<size_t>(lineLen), lineOffset_, false);
 
     prevLineBlank = false;
 
@@ -546,6 +577,7 @@ bool MarkdownParser::parsePages(const std::function<void(std::unique_ptr<Page>)>
     if (ctx.currentPage && !ctx.currentPage->elements.empty() && onPageComplete) {
       onPageComplete(std::move(ctx.currentPage));
       ctx.pagesCreated++;
+      pagesEmitted_++;
     }
   }
 
@@ -13,6 +13,7 @@
 #include <RenderConfig.h>
 #include <ScriptDetector.h>
 #include <SdFat.h>
+#include <TextToc.h>
 
 #include <functional>
 #include <memory>
@@ -46,6 +47,12 @@ class MarkdownParser : public ContentParser {
   uint32_t bytesConsumed() const override { return static_cast<uint32_t>(currentOffset_); }
   uint32_t totalBytes() const override { return static_cast<uint32_t>(fileSize_); }
 
+  /**
+   * Detect chapter headings while laying out and record them at this path
+   * (see TextToc).
+   */
+  void setTocPath(std::string path) { toc_.setPath(std::move(path)); }
+
  private:
   // File state
   std::string filepath_;
@@ -72,6 +79,13 @@ class MarkdownParser : public ContentParser {
   std::unique_ptr<Page> pendingPage_;
   int16_t pendingPageNextY_ = 0;
 
+  // Chapter headings; pages are counted from the start of the file
+  TextTocWriter toc_;
+  uint32_t pagesEmitted_ = 0;
+  uint32_t lineOffset_ = 0;   // Line being parsed
+  uint32_t blockOffset_ = 0;  // Line the current text block started at
+  bool blockHasLines_ = false;
+
   // Parsing context passed through md_parser callback
   struct ParseContext {
     MarkdownParser* self;
@@ -101,6 +115,7 @@ class MarkdownParser : public ContentParser {
   void flushWordBuffer(ParseContext& ctx);
   void flushTextBlock(ParseContext& ctx);
   bool addLineToPage(ParseContext& ctx, std::shared_ptr<TextBlock> line);
+  void markBlockPlaced();
   int getCurrentFontStyle(const ParseContext& ctx) const;
   void startNewTextBlock(ParseContext& ctx, int style);
 };
@@ -0,0 +1,233 @@
+#include "ChapterDetector.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+struct Keyword {
+  const char* word;  // ASCII keywords are matched case-insensitively
+  bool numbered;     // Expects a number or name after it ("Chapter 3")
+  bool part;         // Groups chapters below it
+};
+
+constexpr Keyword kKeywords[] = {
+    {"chapter", true, false}, {"part", true, true},   {"book", true, true},     {"prologue", false, false},
+    {"epilogue", false, false}, {"Глава", true, false}, {"ГЛАВА", true, false}, {"глава", true, false},
+    {"Часть", true, true},    {"ЧАСТЬ", true, true},   {"часть", true, true},   {"Книга", true, true},
+    {"КНИГА", true, true},    {"Пролог", false, false}, {"ПРОЛОГ", false, false}, {"Эпилог", false, false},
+    {"ЭПИЛОГ", false, false},
+};
+
+// Titles are short; a line ending like a sentence is prose
+constexpr size_t kMaxTitledLine = 60;
+constexpr size_t kMaxUnnumberedWords = 5;
+
+bool isSpace(const char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+char lowerAscii(const char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+bool isRomanDigit(const char c) {
+  return c == 'I' || c == 'V' || c == 'X' || c == 'L' || c == 'C' || c == 'D' || c == 'M';
+}
+
+bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+bool endsLikeSentence(const char* text, const size_t len) {
+  if (len == 0) return false;
+  const char c = text[len - 1];
+  if (c == '.' || c == ',' || c == ';' || c == '!' || c == '?' || c == '"' || c == '\'') return true;
+  // "…", "»", "”"
+  if (len >= 3 && (memcmp(text + len - 3, "\xE2\x80\xA6", 3) == 0 || memcmp(text + len - 3, "\xE2\x80\x9D", 3) == 0))
+    return true;
+  return len >= 2 && memcmp(text + len - 2, "\xC2\xBB", 2) == 0;
+}
+
+size_t countWords(const char* text, const size_t len) {
+  size_t words = 0;
+  bool inWord = false;
+  for (size_t i = 0; i < len; i++) {
+    if (isSpace(text[i])) {
+      inWord = false;
+    } else if (!inWord) {
+      inWord = true;
+      words++;
+    }
+  }
+  return words;
+}
+
+// A token of roman or arabic digits, optionally followed by '.' or ':'
+bool isNumberToken(const char* text, const size_t len) {
+  size_t n = len;
+  if (n > 0 && (text[n - 1] == '.' || text[n - 1] == ':')) n--;
+  if (n == 0) return false;
+  bool digits = true;
+  bool roman = true;
+  for (size_t i = 0; i < n; i++) {
+    digits = digits && isDigit(text[i]);
+    roman = roman && isRomanDigit(text[i]);
+  }
+  return (digits && n <= 4) || (roman && n <= 7);
+}
+
+// Line made only of separator marks, e.g. "***", "* * *", "-----", "=====", "~~~"
+bool isSeparatorLine(const char* text, const size_t len) {
+  size_t marks = 0;
+  for (size_t i = 0; i < len; i++) {
+    const char c = text[i];
+    if (c == '*' || c == '-' || c == '=' || c == '_' || c == '~' || c == '#') {
+      marks++;
+    } else if (!isSpace(c)) {
+      return false;
+    }
+  }
+  return marks >= 3;
+}
+
+// Match a keyword at the start of the line; returns its length or 0
+size_t matchKeyword(const char* text, const size_t len, const Keyword& kw) {
+  const size_t n = strlen(kw.word);
+  if (len < n) return 0;
+  const bool ascii = static_cast<unsigned char>(kw.word[0]) < 0x80;
+  for (size_t i = 0; i < n; i++) {
+    if (ascii ? lowerAscii(text[i]) != kw.word[i] : text[i] != kw.word[i]) return 0;
+  }
+  if (len > n && !isSpace(text[n]) && text[n] != '.' && text[n] != ':') return 0;
+  return n;
+}
+
+void setTitle(ChapterDetector::Heading& heading, const char* text, size_t len) {
+  if (len > ChapterDetector::MAX_TITLE) {
+    len = ChapterDetector::MAX_TITLE;
+    // Don't cut a UTF-8 sequence in half
+    while (len > 0 && (static_cast<unsigned char>(text[len]) & 0xC0) == 0x80) len--;
+  }
+  heading.title.assign(text, len);
+}
+}  // namespace
+
+void ChapterDetector::reset() {
+  prev_ = Prev::Start;
+  afterSeparator_ = false;
+  sawPart_ = false;
+  hasPending_ = false;
+  pending_ = Heading();
+}
+
+ChapterDetector::Kind ChapterDetector::classify(const char* text, const size_t len, uint8_t& depth, bool& part) {
+  const uint8_t chapterDepth = sawPart_ ? 1 : 0;
+
+  size_t hashes = 0;
+  while (hashes < len && text[hashes] == '#') hashes++;
+  if (hashes >= 1 && hashes <= 6 && hashes < len && isSpace(text[hashes])) {
+    depth = static_cast<uint8_t>(hashes > 3 ? 2 : hashes - 1);
+    return Kind::Markdown;
+  }
+
+  for (const auto& kw : kKeywords) {
+    const size_t n = matchKeyword(text, len, kw);
+    if (n == 0) continue;
+
+    size_t rest = n;
+    while (rest < len && (isSpace(text[rest]) || text[rest] == '.' || text[rest] == ':')) rest++;
+    size_t tokenEnd = rest;
+    while (tokenEnd < len && !isSpace(text[tokenEnd])) tokenEnd++;
+
+    const bool numbered = rest < len && isNumberToken(text + rest, tokenEnd - rest);
+    const bool short_ = countWords(text, len) <= kMaxUnnumberedWords && !endsLikeSentence(text, len);
+    if (kw.numbered ? (rest < len && (numbered || short_)) : short_) {
+      part = kw.part;
+      depth = kw.part ? 0 : chapterDepth;
+      return Kind::Keyword;
+    }
+    return Kind::None;
+  }
+
+  if (isNumberToken(text, len)) {
+    depth = chapterDepth;
+    return Kind::Numeral;
+  }
+
+  if (afterSeparator_ && len <= kMaxTitledLine && !endsLikeSentence(text, len)) {
+    depth = chapterDepth;
+    return Kind::Titled;
+  }
+  return Kind::None;
+}
+
+bool ChapterDetector::feedLine(const char* text, size_t len, const uint32_t offset, const bool truncated,
+                               Heading& out) {
+  while (len > 0 && isSpace(*text)) {
+    text++;
+    len--;
+  }
+  while (len > 0 && isSpace(text[len - 1])) len--;
+
+  if (len == 0 && !truncated) {
+    const bool confirmed = hasPending_;
+    if (confirmed) {
+      out = std::move(pending_);
+      hasPending_ = false;
+    }
+    if (prev_ != Prev::Separator) prev_ = Prev::Blank;
+    return confirmed;
+  }
+
+  // Any text line after a candidate means it was the start of a paragraph
+  hasPending_ = false;
+
+  if (truncated || len > MAX_LINE) {
+    prev_ = Prev::Text;
+    afterSeparator_ = false;
+    return false;
+  }
+
+  if (isSeparatorLine(text, len)) {
+    prev_ = Prev::Separator;
+    afterSeparator_ = true;
+    return false;
+  }
+
+  const bool paragraphStart = prev_ != Prev::Text;
+  uint8_t depth = 0;
+  bool part = false;
+  const Kind kind = classify(text, len, depth, part);
+  prev_ = Prev::Text;
+  afterSeparator_ = false;
+
+  if (kind == Kind::None || (kind != Kind::Markdown && !paragraphStart)) return false;
+
+  Heading heading;
+  heading.offset = offset;
+  heading.depth = depth;
+  if (kind == Kind::Markdown) {
+    // Strip the markers: "## Title ##" -> "Title"
+    size_t start = 0;
+    while (start < len && (text[start] == '#' || isSpace(text[start]))) start++;
+    size_t end = len;
+    while (end > start && (text[end - 1] == '#' || isSpace(text[end - 1]))) end--;
+    while (start < end && (text[start] == '*' || text[start] == '_')) start++;
+    while (end > start && (text[end - 1] == '*' || text[end - 1] == '_')) end--;
+    setTitle(heading, text + start, end - start);
+  } else {
+    setTitle(heading, text, len);
+  }
+  if (heading.title.empty()) return false;
+  if (part) sawPart_ = true;
+
+  if (kind == Kind::Numeral || kind == Kind::Titled) {
+    // Weak patterns need a blank line after them too
+    pending_ = std::move(heading);
+    hasPending_ = true;
+    return false;
+  }
+  out = std::move(heading);
+  return true;
+}
+
+bool ChapterDetector::finish(Heading& out) {
+  if (!hasPending_) return false;
+  out = std::move(pending_);
+  hasPending_ = false;
+  return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Streaming chapter heading detector for plain text and Markdown.
+ *
+ * Lines are fed in file order as they are parsed. A line is judged from a
+ * small window around it: the lines before it (blank, separator, start of
+ * file) and, for the weaker patterns, the line after it. Recognised:
+ *   - "Chapter 12", "CHAPTER XII", "Part Two", "Глава 5", "Пролог", ...
+ *   - Markdown headings ("# Title", "## Title")
+ *   - a bare roman or arabic numeral ("IV", "12.") between blank lines
+ *   - a short title line after a separator ("* * *", "----", "====")
+ */
+class ChapterDetector {
+ public:
+  // Longest line (in bytes) still considered a heading
+  static constexpr size_t MAX_LINE = 80;
+  static constexpr size_t MAX_TITLE = 63;
+
+  struct Heading {
+    std::string title;
+    uint32_t offset = 0;  // Byte offset of the heading line in the source
+    uint8_t depth = 0;
+  };
+
+  /**
+   * Feed one line (without its newline).
+   * @param text Line text, UTF-8
+   * @param len Bytes in text
+   * @param offset Byte offset of the line in the source file
+   * @param truncated True if the caller kept only the start of a longer line
+   * @param out Filled with a confirmed heading (this line or the previous one)
+   * @return true if a heading was confirmed
+   */
+  bool feedLine(const char* text, size_t len, uint32_t offset, bool truncated, Heading& out);
+
+  /**
+   * End of input: confirm a candidate that was waiting for the next line.
+   * @return true if a heading was confirmed
+   */
+  bool finish(Heading& out);
+
+  void reset();
+
+ private:
+  enum class Prev : uint8_t { Start, Blank, Separator, Text };
+  enum class Kind : uint8_t { None, Keyword, Markdown, Numeral, Titled };
+
+  Prev prev_ = Prev::Start;
+  // Nearest non-blank line was a separator
+  bool afterSeparator_ = false;
+  bool sawPart_ = false;
+  // Candidate that is confirmed only if the next line is blank
+  bool hasPending_ = false;
+  Heading pending_;
+
+  Kind classify(const char* text, size_t len, uint8_t& depth, bool& part);
+};
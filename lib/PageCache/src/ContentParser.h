@@ -78,4 +78,24 @@ class ContentParser {
    * parsers, chapter size for chaptered parsers). 0 if unknown.
    */
   virtual uint32_t totalBytes() const { return 0; }
+
+  /**
+   * Move a freshly reset parser to its last saved checkpoint at or before
+   * `page`, so a cold extend lays out from there instead of from the start.
+   * @return Index of the first page the next parsePages() call emits; 0 when
+   *         the parser keeps no checkpoints or none applies
+   */
+  virtual uint32_t seekToCheckpoint(uint32_t page) {
+    (void)page;
+    return 0;
+  }
+
+  /**
+   * Index of the last saved checkpoint at or before `page` (0 if none),
+   * without moving the parser.
+   */
+  virtual uint32_t checkpointBefore(uint32_t page) const {
+    (void)page;
+    return 0;
+  }
 };
@@ -6,10 +6,11 @@
 #include <Html5Normalizer.h>
 #include <HtmlSplitter.h>
 #include <Hyphenation.h>
+#include <InflateReader.h>
 #include <Logging.h>
 #include <Page.h>
 #include <SDCardManager.h>
-#include <core/PerfLog.h>
+#include <core/Trace.h>
 #include <esp_heap_caps.h>
 
 #define TAG "EPUB_CHAP"
@@ -254,9 +255,9 @@ bool EpubChapterParser::parsePages(const std::function<void(std::unique_ptr<Page
         if (!SdMan.openFileForWrite("EPUB", tmpHtmlPath_, tmpHtml)) {
           continue;
         }
-        const uint32_t extractionStarted = perfMsNow();
+        TRACE_BEGIN(EpubExtract);
         extracted = epub_->readItemContentsToStream(localPath, tmpHtml, 1024, renderer_.getFrameBuffer(), &scratch);
-        readerPerfLog("epub-extract", extractionStarted);
+        TRACE_END(EpubExtract);
         tmpHtml.close();
 
         if (!extracted && SdMan.exists(tmpHtmlPath_.c_str())) {
@@ -271,11 +272,11 @@ bool EpubChapterParser::parsePages(const std::function<void(std::unique_ptr<Page
 
       normalizedPath_ = epub_->getCachePath() + "/.norm_" + std::to_string(spineIndex_) + ".html";
       parseHtmlPath_ = tmpHtmlPath_;
-      const uint32_t normalizationStarted = perfMsNow();
+      TRACE_BEGIN(EpubNormalize);
       if (html5::normalizeHtmlForXml(tmpHtmlPath_, normalizedPath_, &scratch)) {
         parseHtmlPath_ = normalizedPath_;
       }
-      readerPerfLog("epub-normalize", normalizationStarted);
+      TRACE_END(EpubNormalize);
     }
 
     auto readItemFn = [this](const std::string& href, Print& out, size_t chunkSize, BuildArena* arena) -> bool {
@@ -300,6 +301,19 @@ bool EpubChapterParser::parsePages(const std::function<void(std::unique_ptr<Page
     liveParser_.reset(new ChapterHtmlSlimParser(parseHtmlPath_, renderer_, config_, wrappedCallback, nullptr,
                                                 chapterBasePath_, imageCachePath_, readItemFn, epub_->getCssParser(),
                                                 shouldAbort));
+    // Images decode straight from the EPUB entry. The inflate dictionary comes from the build arena: the
+    // frame buffer behind it holds live arena allocations, so it cannot be handed out raw.
+    liveParser_->setReadItemSourceFn([this](const std::string& href, const std::function<bool(ByteSource&)>& consumer,
+                                            BuildArena* arena) -> bool {
+      auto arenaScope = arena ? arena->scope() : BuildArena::Scope{};
+      uint8_t* dictionary = arena ? arena->allocArray<uint8_t>(InflateReader::STREAMING_DICTIONARY_SIZE) : nullptr;
+      if (arena && !dictionary) {
+        // The entry reader mallocs its own window
+        arenaScope.release();
+        arena->noteFallback(InflateReader::STREAMING_DICTIONARY_SIZE);
+      }
+      return epub_->readItemWithSource(href, consumer, dictionary);
+    });
 
     // Index-based byte-range mode: read section from .body file using .idx metadata
     if (totalSubSections_ > 0 && parseHtmlPath_.size() > 5 &&
@@ -11,6 +11,7 @@
 #include <Page.h>
 #include <SDCardManager.h>
 #include <Serialization.h>
+#include <core/Trace.h>
 
 #include "ContentParser.h"
 
@@ -21,7 +22,7 @@ bool PageCache::failHeaderCommitOnce_ = false;
 #endif
 
 namespace {
-constexpr uint8_t CACHE_FILE_VERSION = 22;  // v22: source/font fingerprints; 32-bit indexes
+constexpr uint8_t CACHE_FILE_VERSION = 24;  // v24: window start page
 
 // Header layout (offsets are absolute from start of file):
 // - version (1 byte)        @ 0
@@ -41,8 +42,11 @@ constexpr uint8_t CACHE_FILE_VERSION = 22;  // v22: source/font fingerprints; 32
 // - totalBytes (4)          @ 31
 // - sourceFingerprint (4)   @ 35
 // - fontFingerprint (4)     @ 39
+// - grayscaleImages (1)     @ 43
+// - firstPage (4)           @ 44
+// The LUT holds one entry per page from firstPage to pageCount.
 constexpr uint32_t kPageCountOffset = 18;
-constexpr uint32_t kHeaderSize = 43;
+constexpr uint32_t kHeaderSize = 48;
 
 struct CacheHeader {
   uint8_t version = 0;
@@ -52,6 +56,7 @@ struct CacheHeader {
   uint32_t lutOffset = 0;
   uint32_t bytesConsumed = 0;
   uint32_t totalBytes = 0;
+  uint32_t firstPage = 0;
 };
 
 bool readCacheHeader(FsFile& file, CacheHeader& header) {
@@ -70,17 +75,24 @@ bool readCacheHeader(FsFile& file, CacheHeader& header) {
          serialization::readPodChecked(file, header.bytesConsumed) &&
          serialization::readPodChecked(file, header.totalBytes) &&
          serialization::readPodChecked(file, header.config.sourceFingerprint) &&
-         serialization::readPodChecked(file, header.config.fontFingerprint);
+         serialization::readPodChecked(file, header.config.fontFingerprint) &&
+         serialization::readPodChecked(file, header.config.grayscaleImages) &&
+         serialization::readPodChecked(file, header.firstPage);
 }
 
 bool hasValidLutSpan(const CacheHeader& header, size_t fileSize) {
-  if (header.partial > 1 || header.lutOffset < kHeaderSize || header.lutOffset > fileSize) return false;
-  return page_cache::lutFitsFile(header.pageCount, fileSize - header.lutOffset);
+  if (header.partial > 1 || header.firstPage > header.pageCount || header.lutOffset < kHeaderSize ||
+      header.lutOffset > fileSize) {
+    return false;
+  }
+  return page_cache::lutFitsFile(header.pageCount - header.firstPage, fileSize - header.lutOffset);
 }
 }  // namespace
 
 PageCache::PageCache(std::string cachePath) : cachePath_(std::move(cachePath)) {}
 
+PageCache::~PageCache() = default;
+
 bool PageCache::writeHeader(bool isPartial) {
   const uint8_t partial = isPartial ? 1 : 0;
   const uint32_t lutOffset = 0;
@@ -98,7 +110,9 @@ bool PageCache::writeHeader(bool isPartial) {
          serialization::writePodChecked(file_, lutOffset) && serialization::writePodChecked(file_, bytesConsumed_) &&
          serialization::writePodChecked(file_, totalBytes_) &&
          serialization::writePodChecked(file_, config_.sourceFingerprint) &&
-         serialization::writePodChecked(file_, config_.fontFingerprint);
+         serialization::writePodChecked(file_, config_.fontFingerprint) &&
+         serialization::writePodChecked(file_, config_.grayscaleImages) &&
+         serialization::writePodChecked(file_, firstPage_);
 }
 
 bool PageCache::writeMutableHeader(uint32_t pageCount, bool isPartial, uint32_t lutOffset, uint32_t bytesConsumed,
@@ -116,8 +130,8 @@ bool PageCache::writeMutableHeader(uint32_t pageCount, bool isPartial, uint32_t
 }
 
 bool PageCache::writeLut(const std::vector<uint32_t>& lut) {
-  if (lut.size() != pageCount_) {
-    LOG_ERR(TAG, "LUT size mismatch: %zu entries vs %u pages", lut.size(), pageCount_);
+  if (lut.size() != pageCount_ - firstPage_) {
+    LOG_ERR(TAG, "LUT size mismatch: %zu entries vs %u pages", lut.size(), pageCount_ - firstPage_);
     return false;
   }
 
@@ -148,6 +162,7 @@ bool PageCache::loadRaw() {
   }
 
   pageCount_ = header.pageCount;
+  firstPage_ = header.firstPage;
   isPartial_ = header.partial != 0;
   lutOffset_ = header.lutOffset;
   bytesConsumed_ = header.bytesConsumed;
@@ -158,6 +173,7 @@ bool PageCache::loadRaw() {
 }
 
 bool PageCache::load(const RenderConfig& config) {
+  prefetched_.reset();
   if (!SdMan.openFileForRead("CACHE", cachePath_, file_)) {
     return false;
   }
@@ -180,6 +196,7 @@ bool PageCache::load(const RenderConfig& config) {
   }
 
   pageCount_ = header.pageCount;
+  firstPage_ = header.firstPage;
   isPartial_ = header.partial != 0;
   lutOffset_ = header.lutOffset;
   bytesConsumed_ = header.bytesConsumed;
@@ -187,13 +204,15 @@ bool PageCache::load(const RenderConfig& config) {
   config_ = config;
 
   file_.close();
-  LOG_INF(TAG, "Loaded: %u pages, partial=%d", pageCount_, isPartial_);
+  LOG_INF(TAG, "Loaded: pages %u-%u, partial=%d", firstPage_, pageCount_, isPartial_);
   return true;
 }
 
 bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32_t maxPages, uint32_t skipPages,
-                       const AbortCallback& shouldAbort) {
+                       const AbortCallback& shouldAbort, uint32_t firstPage) {
   const unsigned long startMs = millis();
+  // Pages already cached keep their records when extending; a fresh build may lay them out anew
+  if (skipPages == 0) prefetched_.reset();
 
   // For extends with existing pages, track the committed header so any failed
   // append can leave the previous cache readable.
@@ -235,7 +254,8 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     }
 
     config_ = config;
-    pageCount_ = 0;
+    firstPage_ = firstPage;
+    pageCount_ = firstPage;
     isPartial_ = false;
 
     // Write placeholder header
@@ -253,7 +273,7 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     return false;
   }
 
-  uint32_t parsedPages = 0;
+  uint32_t parsedPages = firstPage;
   bool hitMaxPages = false;
   bool aborted = false;
   bool serializeFailed = false;
@@ -279,7 +299,10 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
           return;
         }
 #endif
-        if (!page->serialize(file_)) {
+        TRACE_BEGIN(PageSerialize);
+        const bool serialized = page->serialize(file_);
+        TRACE_END(PageSerialize);
+        if (!serialized) {
           LOG_ERR(TAG, "Failed to serialize page %u, stopping", pageCount_);
           serializeFailed = true;
           hitMaxPages = true;
@@ -298,7 +321,7 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
           hitMaxPages = true;
         }
       },
-      maxPages, shouldAbort);
+      maxPages > firstPage ? maxPages - firstPage : maxPages, shouldAbort);
 
   // Check if we were aborted
   if (shouldAbort && shouldAbort()) {
@@ -311,6 +334,7 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     file_.close();
     if (skipPages == 0) {
       pageCount_ = 0;
+      firstPage_ = 0;
       isPartial_ = false;
       bytesConsumed_ = 0;
       totalBytes_ = 0;
@@ -326,11 +350,12 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     return false;
   }
 
-  if ((!success && pageCount_ == 0) || aborted) {
+  if ((!success && pageCount_ == firstPage_) || aborted) {
     file_.close();
     parser.reset();
     if (skipPages == 0) {
       pageCount_ = 0;
+      firstPage_ = 0;
       isPartial_ = false;
       bytesConsumed_ = 0;
       totalBytes_ = 0;
@@ -355,7 +380,7 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     const uint32_t newLutOffset = file_.position();
     constexpr size_t kCopyBuf = 256;
     uint8_t copyBuf[kCopyBuf];
-    uint32_t remaining = oldPageCount * static_cast<uint32_t>(sizeof(uint32_t));
+    uint32_t remaining = (oldPageCount - oldHeader.firstPage) * static_cast<uint32_t>(sizeof(uint32_t));
     uint32_t srcPos = oldLutOffset;
     uint32_t dstPos = newLutOffset;
     bool copyOk = true;
@@ -410,6 +435,7 @@ bool PageCache::create(ContentParser& parser, const RenderConfig& config, uint32
     parser.reset();
     if (skipPages == 0) {
       pageCount_ = 0;
+      firstPage_ = 0;
       isPartial_ = false;
       bytesConsumed_ = 0;
       totalBytes_ = 0;
@@ -468,7 +494,7 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
     // Read current LUT position from header
     CacheHeader header;
     if (!readCacheHeader(file_, header) || header.version != CACHE_FILE_VERSION || header.pageCount != pageCount_ ||
-        !hasValidLutSpan(header, file_.size())) {
+        header.firstPage != firstPage_ || !hasValidLutSpan(header, file_.size())) {
       LOG_ERR(TAG, "Invalid header for hot extend");
       file_.close();
       return false;
@@ -488,7 +514,7 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
     }
 
     const uint32_t pagesBefore = pageCount_;
-    const uint32_t oldPageCount = pageCount_;
+    const uint32_t oldLutEntries = pageCount_ - firstPage_;
     uint32_t newOffsets[50];
     uint16_t newCount = 0;
     bool hitMaxPages = false;
@@ -505,7 +531,10 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
             return;
           }
 #endif
-          if (!page->serialize(file_)) {
+          TRACE_BEGIN(PageSerialize);
+          const bool serialized = page->serialize(file_);
+          TRACE_END(PageSerialize);
+          if (!serialized) {
             LOG_ERR(TAG, "Failed to serialize page %u, stopping", pageCount_);
             serializeFailed = true;
             hitMaxPages = true;
@@ -540,7 +569,7 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
     {
       constexpr size_t kCopyBuf = 256;
       uint8_t buf[kCopyBuf];
-      uint32_t remaining = oldPageCount * static_cast<uint32_t>(sizeof(uint32_t));
+      uint32_t remaining = oldLutEntries * static_cast<uint32_t>(sizeof(uint32_t));
       uint32_t srcPos = oldLutOffset;
       uint32_t dstPos = newLutOffset;
       while (remaining > 0) {
@@ -567,7 +596,7 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
     }
 
     // Append new LUT entries and update header
-    bool writeOk = file_.seek(newLutOffset + oldPageCount * static_cast<uint32_t>(sizeof(uint32_t)));
+    bool writeOk = file_.seek(newLutOffset + oldLutEntries * static_cast<uint32_t>(sizeof(uint32_t)));
     for (uint16_t i = 0; i < newCount; i++) {
       writeOk = writeOk && serialization::writePodChecked(file_, newOffsets[i]);
     }
@@ -590,14 +619,16 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
     return true;
   }
 
-  // COLD PATH: Fresh parser (after exit/reboot) — re-parse from start, skip
-  // cached pages, then append the next chunk. This is slower than hot resume,
-  // but it must remain correct for interrupted large books.
+  // COLD PATH: Fresh parser (after exit/reboot) — re-parse from the nearest
+  // checkpoint (or the start), skip cached pages, then append the next chunk.
+  // This is slower than hot resume, but it must remain correct for interrupted
+  // large books.
   const uint32_t targetPages = pageCount_ + chunk;
-  LOG_INF(TAG, "Cold extend from %u to %u pages", currentPages, targetPages);
-
   parser.reset();
-  bool result = create(parser, config_, targetPages, currentPages, shouldAbort);
+  const uint32_t firstPage = parser.seekToCheckpoint(currentPages);
+  LOG_INF(TAG, "Cold extend from %u to %u pages (parsing from page %u)", currentPages, targetPages, firstPage);
+
+  bool result = create(parser, config_, targetPages, currentPages, shouldAbort, firstPage);
 
   // No forward progress AND parser has no more content → content is truly finished.
   // Without the hasMoreContent() check, an aborted extend (timeout/memory pressure)
@@ -610,11 +641,63 @@ bool PageCache::extend(ContentParser& parser, uint16_t additionalPages, const Ab
   return result;
 }
 
+bool PageCache::createWindow(ContentParser& parser, const RenderConfig& config, const uint32_t targetPage,
+                             const AbortCallback& shouldAbort) {
+  parser.reset();
+  const uint32_t firstPage = parser.seekToCheckpoint(targetPage);
+  LOG_INF(TAG, "Window for page %u (parsing from page %u)", targetPage, firstPage);
+  return create(parser, config, targetPage + DEFAULT_CACHE_CHUNK, 0, shouldAbort, firstPage);
+}
+
+bool PageCache::backfill(ContentParser& parser, const AbortCallback& shouldAbort) {
+  if (firstPage_ == 0) return true;
+
+  // A live session may belong to this window; the fill resumes from its own checkpoint
+  parser.reset();
+  const std::string fillPath = cachePath_ + ".fill";
+  PageCache fill(fillPath);
+  bool ok;
+  if (fill.load(config_)) {
+    ok = fill.extend(parser, DEFAULT_CACHE_CHUNK, shouldAbort);
+  } else {
+    ok = fill.create(parser, config_, DEFAULT_CACHE_CHUNK, 0, shouldAbort);
+  }
+  // Nor may the window's next extend continue the fill's session
+  parser.reset();
+  if (!ok) {
+    LOG_ERR(TAG, "Backfill stopped at %u of %u pages", fill.pageCount(), firstPage_);
+    return false;
+  }
+  if (fill.isPartial() && fill.pageCount() < pageCount_) {
+    LOG_DBG(TAG, "Backfill at %u pages (window %u-%u)", fill.pageCount(), firstPage_, pageCount_);
+    return true;
+  }
+
+  // Pages are laid out the same from any checkpoint, so the fill holds the window too
+  if (!SdMan.commitFile(fillPath.c_str(), cachePath_.c_str())) {
+    LOG_ERR(TAG, "Failed to replace window with backfill");
+    return false;
+  }
+  prefetched_.reset();
+  LOG_INF(TAG, "Backfill complete: %u pages", fill.pageCount());
+  return load(config_);
+}
+
+bool PageCache::prefetchPage(const uint32_t pageNum) {
+  if (prefetched_ && prefetchedNum_ == pageNum) return true;
+  prefetched_.reset();
+  if (!hasPage(pageNum)) return false;
+  prefetched_ = loadPage(pageNum);
+  prefetchedNum_ = pageNum;
+  return prefetched_ != nullptr;
+}
+
 std::unique_ptr<Page> PageCache::loadPage(uint32_t pageNum) {
-  if (pageNum >= pageCount_) {
-    LOG_ERR(TAG, "Page %u out of range (max %u)", pageNum, pageCount_);
+  if (!hasPage(pageNum)) {
+    LOG_ERR(TAG, "Page %u out of range (%u-%u)", pageNum, firstPage_, pageCount_);
     return nullptr;
   }
+  if (prefetched_ && prefetchedNum_ == pageNum) return std::move(prefetched_);
 
   for (int attempt = 0; attempt < 3; attempt++) {
     if (attempt > 0) delay(50);
@@ -627,15 +710,16 @@ std::unique_ptr<Page> PageCache::loadPage(uint32_t pageNum) {
 
     CacheHeader header;
     if (!readCacheHeader(file_, header) || header.version != CACHE_FILE_VERSION || pageNum >= header.pageCount ||
-        !hasValidLutSpan(header, fileSize)) {
+        pageNum < header.firstPage || !hasValidLutSpan(header, fileSize)) {
       LOG_ERR(TAG, "Invalid cache header while loading page");
       file_.close();
       continue;
     }
     const uint32_t lutOffset = header.lutOffset;
+    const uint32_t lutIndex = pageNum - header.firstPage;
 
     // Validate LUT offset and requested LUT entry
-    const size_t lutEntryEnd = static_cast<size_t>(lutOffset) + (static_cast<size_t>(pageNum) + 1) * sizeof(uint32_t);
+    const size_t lutEntryEnd = static_cast<size_t>(lutOffset) + (static_cast<size_t>(lutIndex) + 1) * sizeof(uint32_t);
     if (lutEntryEnd > fileSize) {
       LOG_ERR(TAG, "Invalid LUT offset: %u (file size: %zu)", lutOffset, fileSize);
       file_.close();
@@ -644,7 +728,7 @@ std::unique_ptr<Page> PageCache::loadPage(uint32_t pageNum) {
 
     // Read this page's start and the following page's start. The next LUT
     // entry (or LUT start for the final page) is the exact record boundary.
-    if (!file_.seek(lutOffset + static_cast<size_t>(pageNum) * sizeof(uint32_t))) {
+    if (!file_.seek(lutOffset + static_cast<size_t>(lutIndex) * sizeof(uint32_t))) {
       file_.close();
       continue;
     }
@@ -704,7 +788,7 @@ PageCache::ProbeResult PageCache::probe(const std::string& cachePath, const Rend
   }
 
   result.pageCount = header.pageCount;
-  result.partial = header.partial != 0;
+  result.partial = header.partial != 0 || header.firstPage > 0;
 
   file.close();
   result.valid = true;
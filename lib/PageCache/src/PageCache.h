@@ -30,6 +30,9 @@ class PageCache {
   std::string cachePath_;
   FsFile file_;
   uint32_t pageCount_ = 0;
+  // First cached page. A window opened at a parser checkpoint holds pages
+  // [firstPage_, pageCount_); a contiguous cache starts at 0.
+  uint32_t firstPage_ = 0;
   bool isPartial_ = false;
   RenderConfig config_;
   uint32_t lutOffset_ = 0;  // Cached LUT offset for extend operations
@@ -39,6 +42,9 @@ class PageCache {
   // waiting for the next extend.
   uint32_t bytesConsumed_ = 0;
   uint32_t totalBytes_ = 0;
+  // Page read ahead by prefetchPage(), handed out by the next loadPage() for it
+  std::unique_ptr<Page> prefetched_;
+  uint32_t prefetchedNum_ = 0;
 
   bool writeHeader(bool isPartial);
   bool writeMutableHeader(uint32_t pageCount, bool isPartial, uint32_t lutOffset, uint32_t bytesConsumed,
@@ -47,7 +53,7 @@ class PageCache {
 
  public:
   explicit PageCache(std::string cachePath);
-  ~PageCache() = default;
+  ~PageCache();
 
   /**
    * Try to load existing cache from disk.
@@ -69,14 +75,17 @@ class PageCache {
    * @param maxPages Maximum pages to cache (0 = unlimited)
    * @param skipPages Skip serializing first N pages (for extend)
    * @param shouldAbort Optional callback to check for cancellation
+   * @param firstPage Page number the parser starts at (after seekToCheckpoint);
+   *        a fresh create with firstPage > 0 opens a window there
    * @return true on success
    */
   bool create(ContentParser& parser, const RenderConfig& config, uint32_t maxPages = DEFAULT_CACHE_CHUNK,
-              uint32_t skipPages = 0, const AbortCallback& shouldAbort = nullptr);
+              uint32_t skipPages = 0, const AbortCallback& shouldAbort = nullptr, uint32_t firstPage = 0);
 
   /**
    * Extend cache with more pages.
    * Re-parses content but skips already-cached pages, then appends new pages.
+   * A cold extend starts from the parser's nearest checkpoint when it has one.
    * @param parser Content parser (will be reset)
    * @param additionalPages Number of additional pages to cache
    * @param shouldAbort Optional callback to check for cancellation
@@ -85,13 +94,44 @@ class PageCache {
   bool extend(ContentParser& parser, uint16_t additionalPages = DEFAULT_CACHE_CHUNK,
               const AbortCallback& shouldAbort = nullptr);
 
+  /**
+   * Create a window that starts at the parser's checkpoint at or before
+   * `targetPage` and runs a few pages past it, instead of laying out every
+   * page from the start. Without a checkpoint the window starts at page 0.
+   * @param parser Content parser (will be reset)
+   * @param config Render config
+   * @param targetPage Page the reader is about to show
+   * @param shouldAbort Optional callback to check for cancellation
+   * @return true on success
+   */
+  bool createWindow(ContentParser& parser, const RenderConfig& config, uint32_t targetPage,
+                    const AbortCallback& shouldAbort = nullptr);
+
+  /**
+   * Lay out the next chunk of the pages before a window into a contiguous cache
+   * at `<path>.fill`, and replace this cache with it once it reaches the end of
+   * the window. Each step replays from a checkpoint, so the parser is reset
+   * before and after it and any live session is dropped.
+   * @param parser Content parser (will be reset)
+   * @param shouldAbort Optional callback to check for cancellation
+   * @return true if the step completed; this cache is contiguous once the fill is swapped in
+   */
+  bool backfill(ContentParser& parser, const AbortCallback& shouldAbort = nullptr);
+
   /**
    * Load a specific page from cache.
    * @param pageNum Page number (0-indexed)
-   * @return Page object or nullptr on error
+   * @return Page object or nullptr on error or if the page is not cached
    */
   std::unique_ptr<Page> loadPage(uint32_t pageNum);
 
+  /**
+   * Read a page ahead of time, e.g. while the display refreshes.
+   * The next loadPage() for it returns the page without touching the SD card.
+   * @return true if the page is held
+   */
+  bool prefetchPage(uint32_t pageNum);
+
   /**
    * Clear cache from disk.
    * @return true on success
@@ -100,13 +140,15 @@ class PageCache {
 
   struct ProbeResult {
     bool valid = false;
-    bool partial = false;
+    bool partial = false;  // Also set for a window, which lacks the pages before it
     uint32_t pageCount = 0;
   };
   static ProbeResult probe(const std::string& cachePath, const RenderConfig& config);
 
   // Accessors
   uint32_t pageCount() const { return pageCount_; }
+  uint32_t firstPage() const { return firstPage_; }
+  bool hasPage(uint32_t pageNum) const { return pageNum >= firstPage_ && pageNum < pageCount_; }
   bool isPartial() const { return isPartial_; }
   bool needsExtension(uint32_t currentPage) const {
     return page_cache::needsExtension(pageCount_, isPartial_, currentPage);
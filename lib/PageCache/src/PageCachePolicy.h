@@ -6,6 +6,7 @@ namespace page_cache {
 
 inline constexpr uint16_t EXTEND_THRESHOLD = 3;
 inline constexpr uint32_t MAX_PROACTIVE_COLD_PAGES = 1000;
+inline constexpr uint32_t MAX_CHECKPOINT_REPLAY = 64;
 
 constexpr bool needsExtension(uint32_t pageCount, bool partial, uint32_t currentPage) {
   return partial && (currentPage >= pageCount || pageCount - currentPage <= EXTEND_THRESHOLD);
@@ -33,6 +34,22 @@ constexpr uint16_t extensionChunk(uint32_t pageCount, uint16_t requestedPages) {
   return static_cast<uint16_t>(desired < remaining ? desired : remaining);
 }
 
+// A cold extend that replays at most a few pages from a parser checkpoint is
+// treated like a hot one.
+constexpr bool checkpointReplayIsCheap(uint32_t checkpointPage, uint32_t pageCount) {
+  return checkpointPage > 0 && checkpointPage <= pageCount && pageCount - checkpointPage <= MAX_CHECKPOINT_REPLAY;
+}
+
+// Reach `targetPage` through a window that starts at its checkpoint instead of
+// extending the cache up to it: the target lies before the window, or the
+// checkpoint lies past the cached pages by more than a cheap replay. An empty
+// cache has no pages to keep, so any checkpoint past its start will do.
+constexpr bool opensWindow(uint32_t firstPage, uint32_t pageCount, uint32_t targetPage, uint32_t checkpointPage) {
+  if (targetPage < firstPage) return true;
+  if (targetPage < pageCount || checkpointPage <= pageCount) return false;
+  return pageCount == 0 || checkpointPage - pageCount > MAX_CHECKPOINT_REPLAY;
+}
+
 constexpr bool proactiveExtensionAllowed(bool parserCanResume, uint32_t pageCount) {
   return parserCanResume || pageCount < MAX_PROACTIVE_COLD_PAGES;
 }
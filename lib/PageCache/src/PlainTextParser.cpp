@@ -5,10 +5,15 @@
 #include <Page.h>
 #include <ParsedText.h>
 #include <SDCardManager.h>
+#include <Serialization.h>
 #include <Utf8.h>
 
+#include "RenderConfigIo.h"
+
 #define TAG "TXT_PARSE"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <new>
 #include <utility>
@@ -16,7 +21,95 @@
 namespace {
 constexpr size_t READ_CHUNK_SIZE = 4096;
 
+// Checkpoint index: header (version + render config), then fixed-size records
+// {page u32, block offset u32, flags u8} in increasing page order
+constexpr uint8_t kCheckpointVersion = 2;
+constexpr size_t kCheckpointHeaderSize = 1 + render_config_io::SIZE;
+constexpr size_t kCheckpointRecordSize = 4 + 4 + 1;
+constexpr uint8_t kCheckpointSawNewline = 0x01;
+constexpr uint8_t kCheckpointRtl = 0x02;
+constexpr uint8_t kCheckpointMidLine = 0x04;
+
+struct Checkpoint {
+  uint32_t page = 0;
+  uint32_t offset = 0;
+  uint8_t flags = 0;
+};
+
 bool isWhitespace(char c) { return c == ' ' || c == '\t'; }
+
+// Longest word kept whole; a longer one is split at a codepoint boundary
+constexpr size_t kMaxWordBytes = 100;
+
+// Bytes of a run that can go straight into the current word, tested four at a
+// time (SWAR): a run stops at a control character or space (< 0x21) and, when
+// a code page table converts high bytes, at a byte >= 0x80. Other control
+// characters stop the run too and take the byte-by-byte path.
+size_t wordRunLength(const uint8_t* p, const size_t len, const bool stopAtHighBytes) {
+  constexpr uint32_t kOnes = 0x01010101u;
+  constexpr uint32_t kHighBits = 0x80808080u;
+  const uint32_t highMask = stopAtHighBytes ? kHighBits : 0;
+  size_t n = 0;
+  while (n + 4 <= len) {
+    uint32_t w;
+    memcpy(&w, p + n, 4);
+    // Lowest flagged byte is exact: a byte < 0x21 or, if requested, a high byte
+    const uint32_t stop = ((w - kOnes * 0x21) & ~w & kHighBits) | (w & highMask);
+    if (stop != 0) {
+      // Little-endian load: byte k holds bits 8k..8k+7
+      return n + (__builtin_ctz(stop) >> 3);
+    }
+    n += 4;
+  }
+  while (n < len && p[n] >= 0x21 && (!stopAtHighBytes || p[n] < 0x80)) n++;
+  return n;
+}
+
+bool readCheckpoint(FsFile& file, const size_t index, Checkpoint& out) {
+  return file.seekSet(kCheckpointHeaderSize + index * kCheckpointRecordSize) &&
+         serialization::readPodChecked(file, out.page) && serialization::readPodChecked(file, out.offset) &&
+         serialization::readPodChecked(file, out.flags);
+}
+
+// Last checkpoint at or before `page` in an index written for `config`; `lastPage`
+// receives the page of the final record. Returns false if there is none.
+bool findCheckpoint(const std::string& path, const RenderConfig& config, const uint32_t page, Checkpoint& found,
+                    uint32_t& lastPage) {
+  FsFile file;
+  if (path.empty() || !SdMan.openFileForRead("TXT", path, file)) return false;
+
+  if (!render_config_io::readHeader(file, kCheckpointVersion, config)) {
+    file.close();
+    return false;
+  }
+
+  // A record cut short by a failed append is ignored
+  const size_t count = (file.size() - kCheckpointHeaderSize) / kCheckpointRecordSize;
+  Checkpoint last;
+  if (count == 0 || !readCheckpoint(file, count - 1, last)) {
+    file.close();
+    return false;
+  }
+  lastPage = last.page;
+
+  size_t lo = 0;
+  size_t hi = count;
+  bool ok = false;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    Checkpoint probe;
+    if (!readCheckpoint(file, mid, probe)) break;
+    if (probe.page <= page) {
+      found = probe;
+      ok = true;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  file.close();
+  return ok;
+}
 }  // namespace
 
 PlainTextParser::PlainTextParser(std::string filepath, GfxRenderer& renderer, const RenderConfig& config)
@@ -35,6 +128,97 @@ void PlainTextParser::reset() {
   pendingPartialWord_.clear();
   pendingPage_.reset();
   pendingPageY_ = 0;
+  encodingDetected_ = false;
+  pagesEmitted_ = 0;
+  lastCheckpointPage_ = 0;
+  recordCheckpoints_ = false;
+  blockOffset_ = 0;
+  blockSawNewline_ = false;
+  blockRtl_ = false;
+  blockRestartable_ = false;
+  blockHasLines_ = false;
+  toc_.stop();
+  lineText_.clear();
+  lineOffset_ = 0;
+  lineTruncated_ = false;
+  blockMidLine_ = false;
+}
+
+uint32_t PlainTextParser::checkpointBefore(const uint32_t page) const {
+  Checkpoint cp;
+  uint32_t lastPage = 0;
+  return findCheckpoint(checkpointPath_, config_, page, cp, lastPage) ? cp.page : 0;
+}
+
+uint32_t PlainTextParser::seekToCheckpoint(const uint32_t page) {
+  reset();
+  Checkpoint cp;
+  uint32_t lastPage = 0;
+  if (!findCheckpoint(checkpointPath_, config_, page, cp, lastPage) || cp.offset == 0) return 0;
+
+  currentOffset_ = cp.offset;
+  pendingSawNewline_ = (cp.flags & kCheckpointSawNewline) != 0;
+  isRtl_ = (cp.flags & kCheckpointRtl) != 0;
+  pagesEmitted_ = cp.page;
+  // Keep appending to the same index; pages up to its last record are already covered
+  lastCheckpointPage_ = lastPage;
+  recordCheckpoints_ = true;
+  toc_.resume(config_);
+  lineOffset_ = cp.offset;
+  // The start of a line split at the word cap is not replayed; it is too long for a heading
+  lineTruncated_ = (cp.flags & kCheckpointMidLine) != 0;
+  LOG_DBG(TAG, "Resuming at checkpoint page %u (offset %u)", cp.page, cp.offset);
+  return cp.page;
+}
+
+// Layout from the start repeats the pages an index for this layout already
+// covers (the backfill behind a window does this), so such an index is kept
+// and only later pages are appended to it
+void PlainTextParser::beginCheckpoints() {
+  recordCheckpoints_ = false;
+  lastCheckpointPage_ = 0;
+  if (checkpointPath_.empty()) return;
+
+  Checkpoint last;
+  uint32_t lastPage = 0;
+  if (findCheckpoint(checkpointPath_, config_, UINT32_MAX, last, lastPage)) {
+    lastCheckpointPage_ = lastPage;
+    recordCheckpoints_ = true;
+    return;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("TXT", checkpointPath_, file)) return;
+  recordCheckpoints_ = serialization::writePodChecked(file, kCheckpointVersion) &&
+                       render_config_io::write(file, config_) && file.sync();
+  file.close();
+  if (!recordCheckpoints_) SdMan.remove(checkpointPath_.c_str());
+}
+
+// Called as the first line of a text block is placed at the top of page pagesEmitted_
+void PlainTextParser::recordCheckpoint() {
+  if (!recordCheckpoints_ || !blockRestartable_ || pagesEmitted_ < lastCheckpointPage_ + CHECKPOINT_SPACING) return;
+
+  const uint8_t flags = (blockSawNewline_ ? kCheckpointSawNewline : 0) | (blockRtl_ ? kCheckpointRtl : 0) |
+                        (blockMidLine_ ? kCheckpointMidLine : 0);
+  FsFile file = SdMan.open(checkpointPath_.c_str(), O_RDWR);
+  const bool ok = file && file.seekEnd() && serialization::writePodChecked(file, pagesEmitted_) &&
+                  serialization::writePodChecked(file, static_cast<uint32_t>(blockOffset_)) &&
+                  serialization::writePodChecked(file, flags);
+  if (file) file.close();
+  if (!ok) {
+    LOG_ERR(TAG, "Failed to append checkpoint for page %u", pagesEmitted_);
+    recordCheckpoints_ = false;
+    return;
+  }
+  lastCheckpointPage_ = pagesEmitted_;
+}
+
+void PlainTextParser::endLine(const uint32_t nextOffset) {
+  toc_.onLine(lineText_.data(), lineText_.size(), lineOffset_, lineTruncated_);
+  lineText_.clear();
+  lineOffset_ = nextOffset;
+  lineTruncated_ = false;
 }
 
 bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)>& onPageComplete, uint32_t maxPages,
@@ -46,9 +230,6 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
   }
 
   fileSize_ = file.size();
-  if (currentOffset_ > 0) {
-    file.seek(currentOffset_);
-  }
 
   const int lineHeight = static_cast<int>(renderer_.getEffectiveLineHeight(config_.fontId) * config_.lineCompression);
   const int maxLinesPerPage = config_.viewportHeight / lineHeight;
@@ -76,6 +257,19 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
     currentPageY = 0;
   };
 
+  auto placeLine = [&](std::shared_ptr<TextBlock> line) {
+    if (!blockHasLines_) {
+      // A page that opens on the first line of a block can be laid out again from that block
+      if (currentPageY == 0 && currentPage->elements.empty()) {
+        recordCheckpoint();
+      }
+      toc_.onBlockStart(pagesEmitted_, static_cast<uint32_t>(blockOffset_));
+    }
+    blockHasLines_ = true;
+    currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, currentPageY));
+    currentPageY += lineHeight;
+  };
+
   auto addLineToPage = [&](std::shared_ptr<TextBlock> line) {
     if (!currentPage) {
       startNewPage();
@@ -84,17 +278,16 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
     if (currentPageY + lineHeight > config_.viewportHeight) {
       onPageComplete(std::move(currentPage));
       pagesCreated++;
+      pagesEmitted_++;
       startNewPage();
 
       if (maxPages > 0 && pagesCreated >= maxPages) {
-        currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, currentPageY));
-        currentPageY += lineHeight;
+        placeLine(std::move(line));
         return false;
       }
     }
 
-    currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, currentPageY));
-    currentPageY += lineHeight;
+    placeLine(std::move(line));
     return true;
   };
 
@@ -143,15 +336,52 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
     return true;
   };
 
-  if (currentOffset_ == 0) {
+  // Detected from the head of the file even when starting at a checkpoint
+  if (!encodingDetected_) {
     size_t peekBytes = file.read(buffer.get(), READ_CHUNK_SIZE);
     if (peekBytes > 0) {
       buffer[peekBytes] = '\0';
       detectedEncoding_ = detectEncoding(buffer.get(), peekBytes, bomSkipBytes_);
       encodingTable_ = getEncodingTable(detectedEncoding_);
     }
-    file.seekSet(bomSkipBytes_);
+    encodingDetected_ = true;
+  }
+  file.seekSet(currentOffset_ > 0 ? currentOffset_ : bomSkipBytes_);
+
+  if (currentOffset_ == 0 && pagesEmitted_ == 0 && !pendingPage_) {
+    beginCheckpoints();
+    // Keeps the chapters found so far for this layout, like the checkpoints
+    toc_.resume(config_);
+    lineOffset_ = static_cast<uint32_t>(bomSkipBytes_);
   }
+  const bool trackLines = toc_.active();
+
+  // Keep the start of each line for heading detection
+  auto appendLineText = [&](const char* text, const size_t len) {
+    if (lineTruncated_) return;
+    if (lineText_.size() + len > ChapterDetector::MAX_LINE) {
+      lineTruncated_ = true;
+      return;
+    }
+    lineText_.append(text, len);
+  };
+
+  auto startBlock = [&](const size_t offset) {
+    currentBlock.reset(new ParsedText(static_cast<TextBlock::BLOCK_STYLE>(config_.paragraphAlignment),
+                                      config_.indentLevel, config_.hyphenation, true, isRtl_));
+    blockOffset_ = offset;
+    blockSawNewline_ = sawNewline;
+    blockRtl_ = isRtl_;
+    // A word carried in from the previous block is not in the file at `offset`
+    blockRestartable_ = partialWord.empty();
+    blockMidLine_ = !lineText_.empty() || lineTruncated_;
+    blockHasLines_ = false;
+  };
+
+  // Code page tables decode to precomposed characters only: NFC has nothing to do
+  auto normalizeWord = [&](std::string& word) {
+    if (!encodingTable_) word.resize(utf8NormalizeNfc(&word[0], word.size()));
+  };
 
   auto addWordWithRtlCheck = [&](const std::string& word, EpdFontFamily::Style style) {
     if (!isRtl_ && ScriptDetector::classify(word.c_str()) == ScriptDetector::Script::ARABIC) {
@@ -192,8 +422,7 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
   }
 
   if (!currentBlock) {
-    currentBlock.reset(new ParsedText(static_cast<TextBlock::BLOCK_STYLE>(config_.paragraphAlignment),
-                                      config_.indentLevel, config_.hyphenation, true, isRtl_));
+    startBlock(file.position());
   }
 
   while (file.available() > 0) {
@@ -220,8 +449,7 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
           return true;
         }
         if (!currentBlock) {
-          currentBlock.reset(new ParsedText(static_cast<TextBlock::BLOCK_STYLE>(config_.paragraphAlignment),
-                                            config_.indentLevel, config_.hyphenation, true, isRtl_));
+          startBlock(file.position() - (bytesRead - i));
         }
       }
 
@@ -230,8 +458,9 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
       if (c == '\r') continue;
 
       if (c == '\n') {
+        if (trackLines) endLine(static_cast<uint32_t>(file.position() - (bytesRead - i - 1)));
         if (!partialWord.empty()) {
-          partialWord.resize(utf8NormalizeNfc(&partialWord[0], partialWord.size()));
+          normalizeWord(partialWord);
           addWordWithRtlCheck(partialWord, EpdFontFamily::REGULAR);
           partialWord.clear();
         }
@@ -260,8 +489,7 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
           }
 
           if (!currentBlock) {
-            currentBlock.reset(new ParsedText(static_cast<TextBlock::BLOCK_STYLE>(config_.paragraphAlignment),
-                                              config_.indentLevel, config_.hyphenation, true, isRtl_));
+            startBlock(file.position() - (bytesRead - i - 1));
 
             switch (config_.spacingLevel) {
               case 1:
@@ -279,8 +507,9 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
       }
 
       if (isWhitespace(c)) {
+        if (trackLines) appendLineText(" ", 1);
         if (!partialWord.empty()) {
-          partialWord.resize(utf8NormalizeNfc(&partialWord[0], partialWord.size()));
+          normalizeWord(partialWord);
           addWordWithRtlCheck(partialWord, EpdFontFamily::REGULAR);
           partialWord.clear();
         }
@@ -295,13 +524,22 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
           char utf8Buf[4];
           int len = codepointToUtf8(cp, utf8Buf);
           partialWord.append(utf8Buf, len);
+          if (trackLines) appendLineText(utf8Buf, len);
         }
       } else {
-        partialWord += c;
+        // Copy the whole run of plain word bytes; stop one byte past the word
+        // limit so over-long words split exactly where a byte-at-a-time copy would
+        const char* run = reinterpret_cast<const char*>(&buffer[i]);
+        const size_t runLen =
+            std::min(1 + wordRunLength(&buffer[i + 1], bytesRead - i - 1, encodingTable_ != nullptr),
+                     kMaxWordBytes + 1 - partialWord.size());
+        partialWord.append(run, runLen);
+        if (trackLines) appendLineText(run, runLen);
+        i += runLen - 1;
       }
 
       // Prevent extremely long words from accumulating
-      if (partialWord.length() > 100) {
+      if (partialWord.length() > kMaxWordBytes) {
         // Back up to last valid UTF-8 codepoint boundary to avoid splitting multi-byte chars
         size_t safeLen = partialWord.length();
         while (safeLen > 0 && (static_cast<unsigned char>(partialWord[safeLen - 1]) & 0xC0) == 0x80) {
@@ -314,11 +552,11 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
         if (safeLen > 0) {
           std::string overflow = partialWord.substr(safeLen);
           partialWord.resize(safeLen);
-          partialWord.resize(utf8NormalizeNfc(&partialWord[0], partialWord.size()));
+          normalizeWord(partialWord);
           addWordWithRtlCheck(partialWord, EpdFontFamily::REGULAR);
           partialWord = std::move(overflow);
         } else {
-          partialWord.resize(utf8NormalizeNfc(&partialWord[0], partialWord.size()));
+          normalizeWord(partialWord);
           addWordWithRtlCheck(partialWord, EpdFontFamily::REGULAR);
           partialWord.clear();
         }
@@ -343,9 +581,15 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
     }
   }
 
+  // A last line without a newline
+  if (trackLines) {
+    if (!lineText_.empty() || lineTruncated_) endLine(static_cast<uint32_t>(fileSize_));
+    toc_.onEnd();
+  }
+
   // Flush remaining content
   if (!partialWord.empty()) {
-    partialWord.resize(utf8NormalizeNfc(&partialWord[0], partialWord.size()));
+    normalizeWord(partialWord);
     addWordWithRtlCheck(partialWord, EpdFontFamily::REGULAR);
   }
   if (!flushBlock()) {
@@ -367,6 +611,7 @@ bool PlainTextParser::parsePages(const std::function<void(std::unique_ptr<Page>)
   if (currentPage && !currentPage->elements.empty()) {
     onPageComplete(std::move(currentPage));
     pagesCreated++;
+    pagesEmitted_++;
   }
 
   file.close();
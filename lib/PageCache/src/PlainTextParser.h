@@ -8,6 +8,7 @@
 #include <string>
 
 #include "ContentParser.h"
+#include "TextToc.h"
 
 class GfxRenderer;
 class ParsedText;
@@ -15,8 +16,19 @@ class ParsedText;
 /**
  * Content parser for plain text files (TXT, Markdown).
  * Reads text, wraps into lines, and creates Page objects.
+ *
+ * With a checkpoint path set, the parser also keeps a sparse index of pages it
+ * can restart from: roughly every CHECKPOINT_SPACING pages, the first page that
+ * opens on the first line of a text block is stored with that block's byte
+ * offset and carried state. Lines are broken greedily, so laying out forward
+ * from such a block reproduces the same pages as the pass that recorded it.
  */
 class PlainTextParser : public ContentParser {
+ public:
+  // Pages between checkpoints; a cold extend replays at most about this many
+  static constexpr uint32_t CHECKPOINT_SPACING = 16;
+
+ private:
   std::string filepath_;
   GfxRenderer& renderer_;
   RenderConfig config_;
@@ -39,6 +51,32 @@ class PlainTextParser : public ContentParser {
   std::unique_ptr<Page> pendingPage_;
   int16_t pendingPageY_ = 0;
 
+  bool encodingDetected_ = false;
+  // Pages completed since reset(), or since the restored checkpoint
+  uint32_t pagesEmitted_ = 0;
+
+  // Checkpoint index (empty path = not recorded)
+  std::string checkpointPath_;
+  uint32_t lastCheckpointPage_ = 0;
+  bool recordCheckpoints_ = false;
+  // Where the current text block began, and whether a page can restart there
+  size_t blockOffset_ = 0;
+  bool blockSawNewline_ = false;
+  bool blockRtl_ = false;
+  bool blockRestartable_ = false;
+  bool blockHasLines_ = false;
+
+  // Chapter headings, detected line by line
+  TextTocWriter toc_;
+  std::string lineText_;
+  uint32_t lineOffset_ = 0;
+  bool lineTruncated_ = false;
+  bool blockMidLine_ = false;
+
+  void beginCheckpoints();
+  void recordCheckpoint();
+  void endLine(uint32_t nextOffset);
+
  public:
   PlainTextParser(std::string filepath, GfxRenderer& renderer, const RenderConfig& config);
   ~PlainTextParser() override = default;
@@ -50,4 +88,17 @@ class PlainTextParser : public ContentParser {
   void reset() override;
   uint32_t bytesConsumed() const override { return static_cast<uint32_t>(currentOffset_); }
   uint32_t totalBytes() const override { return static_cast<uint32_t>(fileSize_); }
+
+  /**
+   * Record and use a checkpoint index at this path (normally next to the page
+   * cache). A parse from the start of the file rewrites it.
+   */
+  void setCheckpointPath(std::string path) { checkpointPath_ = std::move(path); }
+  /**
+   * Detect chapter headings while laying out and record them at this path
+   * (see TextToc).
+   */
+  void setTocPath(std::string path) { toc_.setPath(std::move(path)); }
+  uint32_t seekToCheckpoint(uint32_t page) override;
+  uint32_t checkpointBefore(uint32_t page) const override;
 };
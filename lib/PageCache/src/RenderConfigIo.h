@@ -0,0 +1,51 @@
+#pragma once
+
+#include <RenderConfig.h>
+#include <Serialization.h>
+
+#include <cstddef>
+
+// Field-by-field RenderConfig encoding for the layout sidecar files kept next
+// to a page cache (checkpoints, TOC), which are only valid for one layout.
+namespace render_config_io {
+
+inline constexpr size_t SIZE = 4 + 4 + 1 + 1 + 1 + 1 + 1 + 2 + 2 + 4 + 4 + 1;
+
+inline bool write(FsFile& file, const RenderConfig& config) {
+  return serialization::writePodChecked(file, config.fontId) &&
+         serialization::writePodChecked(file, config.lineCompression) &&
+         serialization::writePodChecked(file, config.indentLevel) &&
+         serialization::writePodChecked(file, config.spacingLevel) &&
+         serialization::writePodChecked(file, config.paragraphAlignment) &&
+         serialization::writePodChecked(file, config.hyphenation) &&
+         serialization::writePodChecked(file, config.showImages) &&
+         serialization::writePodChecked(file, config.viewportWidth) &&
+         serialization::writePodChecked(file, config.viewportHeight) &&
+         serialization::writePodChecked(file, config.sourceFingerprint) &&
+         serialization::writePodChecked(file, config.fontFingerprint) &&
+         serialization::writePodChecked(file, config.grayscaleImages);
+}
+
+inline bool read(FsFile& file, RenderConfig& config) {
+  return serialization::readPodChecked(file, config.fontId) &&
+         serialization::readPodChecked(file, config.lineCompression) &&
+         serialization::readPodChecked(file, config.indentLevel) &&
+         serialization::readPodChecked(file, config.spacingLevel) &&
+         serialization::readPodChecked(file, config.paragraphAlignment) &&
+         serialization::readPodChecked(file, config.hyphenation) &&
+         serialization::readPodChecked(file, config.showImages) &&
+         serialization::readPodChecked(file, config.viewportWidth) &&
+         serialization::readPodChecked(file, config.viewportHeight) &&
+         serialization::readPodChecked(file, config.sourceFingerprint) &&
+         serialization::readPodChecked(file, config.fontFingerprint) &&
+         serialization::readPodChecked(file, config.grayscaleImages);
+}
+
+// Read a `version` byte plus config header and check both
+inline bool readHeader(FsFile& file, const uint8_t version, const RenderConfig& expected) {
+  uint8_t stored = 0;
+  RenderConfig config;
+  return serialization::readPodChecked(file, stored) && stored == version && read(file, config) && config == expected;
+}
+
+}  // namespace render_config_io
@@ -0,0 +1,136 @@
+#include "TextToc.h"
+
+#include <Logging.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <utility>
+
+#include "RenderConfigIo.h"
+
+#define TAG "TEXT_TOC"
+
+namespace {
+constexpr uint8_t kTocVersion = 2;
+
+bool readEntry(FsFile& file, TextToc::Entry& out) {
+  uint8_t titleLen = 0;
+  if (!serialization::readPodChecked(file, out.page) || !serialization::readPodChecked(file, out.offset) ||
+      !serialization::readPodChecked(file, out.depth) || !serialization::readPodChecked(file, titleLen)) {
+    return false;
+  }
+  out.title.resize(titleLen);
+  return titleLen == 0 || file.read(reinterpret_cast<uint8_t*>(&out.title[0]), titleLen) == titleLen;
+}
+}  // namespace
+
+bool TextToc::load(const std::string& path, const RenderConfig& config) {
+  entries_.clear();
+  FsFile file;
+  if (path.empty() || !SdMan.openFileForRead("TOC", path, file)) return false;
+
+  if (!render_config_io::readHeader(file, kTocVersion, config)) {
+    file.close();
+    return false;
+  }
+
+  // A record cut short by a failed append ends the list
+  Entry entry;
+  while (entries_.size() < MAX_ENTRIES && readEntry(file, entry)) {
+    entries_.push_back(std::move(entry));
+  }
+  file.close();
+  LOG_DBG(TAG, "Loaded %u entries", static_cast<unsigned>(entries_.size()));
+  return true;
+}
+
+void TextTocWriter::begin(const RenderConfig& config) {
+  stop();
+  if (path_.empty()) return;
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("TOC", path_, file)) return;
+  active_ = serialization::writePodChecked(file, kTocVersion) && render_config_io::write(file, config) && file.sync();
+  file.close();
+  if (!active_) SdMan.remove(path_.c_str());
+}
+
+void TextTocWriter::resume(const RenderConfig& config) {
+  TextToc existing;
+  if (!existing.load(path_, config)) {
+    begin(config);
+    return;
+  }
+
+  stop();
+  active_ = true;
+  count_ = static_cast<uint16_t>(existing.entries().size());
+  if (count_ > 0) {
+    hasStored_ = true;
+    storedThrough_ = existing.entries().back().offset;
+  }
+}
+
+void TextTocWriter::stop() {
+  active_ = false;
+  hasStored_ = false;
+  storedThrough_ = 0;
+  count_ = 0;
+  hasLastBlock_ = false;
+  lastBlockPage_ = 0;
+  lastBlockOffset_ = 0;
+  pending_.clear();
+  detector_.reset();
+}
+
+void TextTocWriter::onLine(const char* text, const size_t len, const uint32_t offset, const bool truncated) {
+  if (!active_) return;
+  ChapterDetector::Heading heading;
+  if (!detector_.feedLine(text, len, offset, truncated, heading)) return;
+  if (hasLastBlock_ && lastBlockOffset_ == heading.offset) {
+    append(heading, lastBlockPage_);
+  } else {
+    pending_.push_back(std::move(heading));
+  }
+}
+
+void TextTocWriter::onEnd() {
+  if (!active_) return;
+  ChapterDetector::Heading heading;
+  if (detector_.finish(heading)) {
+    pending_.push_back(std::move(heading));
+  }
+}
+
+void TextTocWriter::onBlockStart(const uint32_t page, const uint32_t blockOffset) {
+  hasLastBlock_ = true;
+  lastBlockPage_ = page;
+  lastBlockOffset_ = blockOffset;
+  if (pending_.empty()) return;
+  for (const auto& heading : pending_) {
+    append(heading, page);
+  }
+  pending_.clear();
+}
+
+void TextTocWriter::append(const ChapterDetector::Heading& heading, const uint32_t page) {
+  // Lines read again after a resume report headings that are already stored
+  if (!active_ || count_ >= TextToc::MAX_ENTRIES || (hasStored_ && heading.offset <= storedThrough_)) return;
+
+  const uint8_t titleLen = static_cast<uint8_t>(heading.title.size());
+  FsFile file = SdMan.open(path_.c_str(), O_RDWR);
+  const bool ok = file && file.seekEnd() && serialization::writePodChecked(file, page) &&
+                  serialization::writePodChecked(file, heading.offset) &&
+                  serialization::writePodChecked(file, heading.depth) &&
+                  serialization::writePodChecked(file, titleLen) &&
+                  file.write(reinterpret_cast<const uint8_t*>(heading.title.data()), titleLen) == titleLen;
+  if (file) file.close();
+  if (!ok) {
+    LOG_ERR(TAG, "Failed to append entry at offset %u", heading.offset);
+    active_ = false;
+    return;
+  }
+  hasStored_ = true;
+  storedThrough_ = heading.offset;
+  count_++;
+}
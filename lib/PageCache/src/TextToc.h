@@ -0,0 +1,83 @@
+#pragma once
+
+#include <RenderConfig.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ChapterDetector.h"
+
+/**
+ * Chapter list for plain text and Markdown books, detected while the page
+ * cache is laid out. Page numbers depend on the layout, so the file sits next
+ * to the page cache (`pages_<fontId>.bin.toc`) and carries the same render
+ * config; each entry also keeps the byte offset of its heading in the source.
+ *
+ * File: version (u8), render config, then records
+ *   {page u32, offset u32, depth u8, titleLen u8, title[titleLen]}
+ * in increasing offset order.
+ */
+class TextToc {
+ public:
+  static constexpr uint16_t MAX_ENTRIES = 256;
+
+  struct Entry {
+    uint32_t page = 0;
+    uint32_t offset = 0;
+    uint8_t depth = 0;
+    std::string title;
+  };
+
+  /**
+   * Load the entries written so far for this layout.
+   * @return false if the file is missing or was written for another layout
+   */
+  bool load(const std::string& path, const RenderConfig& config);
+  void clear() { entries_.clear(); }
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+/**
+ * Records a TextToc as a parser lays out pages. The parser feeds every source
+ * line and reports each text block whose first line it places; a heading is
+ * stored with the page its block starts on. A heading confirmed after its own
+ * block was placed (a Markdown header flushed as it is parsed) takes that
+ * block's page; any other waits for the next block.
+ */
+class TextTocWriter {
+ public:
+  void setPath(std::string path) { path_ = std::move(path); }
+  bool active() const { return active_; }
+
+  // Parsing starts at the beginning of the source: write the file again
+  void begin(const RenderConfig& config);
+  // Parsing starts at a checkpoint, or lays out a recorded layout again: keep
+  // stored entries, append later ones
+  void resume(const RenderConfig& config);
+  // Stop recording until the next begin()/resume()
+  void stop();
+
+  void onLine(const char* text, size_t len, uint32_t offset, bool truncated);
+  void onEnd();
+  // First line of the block starting at `blockOffset` was placed on `page`
+  void onBlockStart(uint32_t page, uint32_t blockOffset);
+
+ private:
+  std::string path_;
+  ChapterDetector detector_;
+  // Confirmed headings whose block has not been placed yet
+  std::vector<ChapterDetector::Heading> pending_;
+  bool active_ = false;
+  bool hasLastBlock_ = false;
+  uint32_t lastBlockPage_ = 0;
+  uint32_t lastBlockOffset_ = 0;
+  bool hasStored_ = false;
+  uint32_t storedThrough_ = 0;  // Offset of the last entry in the file
+  uint16_t count_ = 0;
+
+  void append(const ChapterDetector::Heading& heading, uint32_t page);
+};
@@ -1,5 +1,6 @@
 #include "PngToBmpConverter.h"
 
+#include <ByteSource.h>
 #include <Logging.h>
 
 #define TAG "PNG"
@@ -35,7 +36,6 @@ inline void write32Signed(Print& out, const int32_t value) {
 }
 
 struct PngContext {
-  FsFile* pngFile;
   Print* bmpOut;
   int srcWidth;
   int srcHeight;
@@ -223,7 +223,7 @@ void pngInitCallback(pngle_t* pngle, uint32_t w, uint32_t h) {
   if (!ctx->headerWritten) ctx->initFailed = true;
 }
 
-bool pngFileToBmpStreamInternal(FsFile& pngFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight, bool oneBit,
+bool pngToBmpInternal(ByteSource& pngSource, Print& bmpOut, int targetMaxWidth, int targetMaxHeight, bool oneBit,
                                 bool requireDithering, const std::function<bool()>& shouldAbort = nullptr) {
   LOG_INF(TAG, "Converting PNG to BMP (target: %dx%d)", targetMaxWidth, targetMaxHeight);
 
@@ -234,7 +234,6 @@ bool pngFileToBmpStreamInternal(FsFile& pngFile, Print& bmpOut, int targetMaxWid
   }
 
   PngContext ctx = {};
-  ctx.pngFile = &pngFile;
   ctx.bmpOut = &bmpOut;
   ctx.targetMaxWidth = targetMaxWidth;
   ctx.targetMaxHeight = targetMaxHeight;
@@ -253,7 +252,7 @@ bool pngFileToBmpStreamInternal(FsFile& pngFile, Print& bmpOut, int targetMaxWid
   int bytesRead;
   bool success = true;
 
-  while ((bytesRead = pngFile.read(buffer, sizeof(buffer))) > 0) {
+  while ((bytesRead = pngSource.read(buffer, sizeof(buffer))) > 0) {
     const bool abortRequested = shouldAbort && shouldAbort();
     if (ctx.aborted || ctx.initFailed || abortRequested) {
       ctx.aborted = ctx.aborted || abortRequested;
@@ -291,6 +290,12 @@ bool pngFileToBmpStreamInternal(FsFile& pngFile, Print& bmpOut, int targetMaxWid
 bool PngToBmpConverter::pngFileToBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth,
                                                    int targetMaxHeight, const bool oneBit, const bool requireDithering,
                                                    const std::function<bool()>& shouldAbort) {
-  return pngFileToBmpStreamInternal(pngFile, bmpOut, targetMaxWidth, targetMaxHeight, oneBit, requireDithering,
-                                    shouldAbort);
+  FileByteSource<FsFile> source(pngFile);
+  return pngToBmpInternal(source, bmpOut, targetMaxWidth, targetMaxHeight, oneBit, requireDithering, shouldAbort);
+}
+
+bool PngToBmpConverter::pngStreamToBmpStream(ByteSource& pngSource, Print& bmpOut, int targetMaxWidth,
+                                             int targetMaxHeight, const bool oneBit, const bool requireDithering,
+                                             const std::function<bool()>& shouldAbort) {
+  return pngToBmpInternal(pngSource, bmpOut, targetMaxWidth, targetMaxHeight, oneBit, requireDithering, shouldAbort);
 }
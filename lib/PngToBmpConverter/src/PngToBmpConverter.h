@@ -2,6 +2,7 @@
 
 #include <functional>
 
+class ByteSource;
 class FsFile;
 class Print;
 
@@ -10,4 +11,8 @@ class PngToBmpConverter {
   static bool pngFileToBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight,
                                          bool oneBit = false, bool requireDithering = false,
                                          const std::function<bool()>& shouldAbort = nullptr);
+  // Convert from a forward-only stream (e.g. ZipEntryReader), no temp file needed
+  static bool pngStreamToBmpStream(ByteSource& pngSource, Print& bmpOut, int targetMaxWidth, int targetMaxHeight,
+                                   bool oneBit = false, bool requireDithering = false,
+                                   const std::function<bool()>& shouldAbort = nullptr);
 };
@@ -14,6 +14,7 @@ struct RenderConfig {
   uint16_t viewportHeight = 0;
   uint32_t sourceFingerprint = 0;
   uint32_t fontFingerprint = 0;
+  bool grayscaleImages = false;  // images cached with both gray planes (.g5) rather than 1-bit (.bw.g5)
 
   RenderConfig() = default;
   RenderConfig(int fontId, float lineCompression, uint8_t indentLevel, uint8_t spacingLevel, uint8_t paragraphAlignment,
@@ -36,7 +37,8 @@ struct RenderConfig {
            indentLevel == o.indentLevel && spacingLevel == o.spacingLevel &&
            paragraphAlignment == o.paragraphAlignment && hyphenation == o.hyphenation && showImages == o.showImages &&
            viewportWidth == o.viewportWidth && viewportHeight == o.viewportHeight &&
-           sourceFingerprint == o.sourceFingerprint && fontFingerprint == o.fontFingerprint;
+           sourceFingerprint == o.sourceFingerprint && fontFingerprint == o.fontFingerprint &&
+           grayscaleImages == o.grayscaleImages;
   }
   bool operator!=(const RenderConfig& o) const { return !(*this == o); }
 };
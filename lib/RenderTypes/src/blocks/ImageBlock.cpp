@@ -1,11 +1,16 @@
 #include "ImageBlock.h"
 
 #include <Bitmap.h>
+#include <G5ImageCache.h>
 #include <GfxRenderer.h>
 #include <Logging.h>
 #include <SDCardManager.h>
 #include <Serialization.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 #define TAG "IMG_BLOCK"
 
 void ImageBlock::render(GfxRenderer& renderer, const int fontId, const int x, const int y) const {
@@ -23,6 +28,14 @@ void ImageBlock::render(GfxRenderer& renderer, const int fontId, const int x, co
     return;
   }
 
+  if (isG5Path(cachedBmpPath)) {
+    if (!renderG5(renderer, x, y)) {
+      LOG_ERR(TAG, "Failed to decode cached G5 image: %s", cachedBmpPath.c_str());
+      renderPlaceholder();
+    }
+    return;
+  }
+
   FsFile bmpFile;
   if (!SdMan.openFileForRead("IMB", cachedBmpPath, bmpFile)) {
     LOG_ERR(TAG, "Failed to open cached BMP: %s", cachedBmpPath.c_str());
@@ -43,6 +56,142 @@ void ImageBlock::render(GfxRenderer& renderer, const int fontId, const int x, co
   bmpFile.close();
 }
 
+bool ImageBlock::renderG5(GfxRenderer& renderer, const int x, const int y) const {
+  G5ImageHeader header;
+  int planeCount = 0;
+  if (!G5ImageCache::readHeader(cachedBmpPath.c_str(), header, &planeCount)) {
+    return false;
+  }
+
+  const GfxRenderer::RenderMode mode = renderer.getRenderMode();
+  // A 1-bit image has no gray pixels, so the grayscale passes have nothing to draw
+  if (planeCount == 1 && mode != GfxRenderer::BW) {
+    return true;
+  }
+
+  const int drawWidth = std::min<int>(header.width, width);
+  const int drawHeight = std::min<int>(header.height, height);
+  const size_t rowBytes = (static_cast<size_t>(header.width) + 7) / 8;
+  auto* mask = static_cast<uint8_t*>(malloc(rowBytes));
+  if (!mask) {
+    return false;
+  }
+
+  // BW draws black, grayscale passes clear the bits of their gray level
+  const bool state = mode == GfxRenderer::BW;
+  const bool ok = G5ImageCache::decompressPlanesFromFile(
+      cachedBmpPath.c_str(), [&](const uint8_t* const* planes, const int count, const int bytes, const int row) {
+        if (row >= drawHeight) return;
+        const uint8_t* out = planes[0];
+        if (count > 1) {
+          // Darkness 3 = black, 2 = dark gray, 1 = light gray
+          const uint8_t* hi = planes[0];
+          const uint8_t* lo = planes[1];
+          for (int i = 0; i < bytes; i++) {
+            if (mode == GfxRenderer::BW) {
+              mask[i] = hi[i] | lo[i];
+            } else if (mode == GfxRenderer::GRAYSCALE_LSB) {
+              mask[i] = hi[i] & static_cast<uint8_t>(~lo[i]);
+            } else {
+              mask[i] = hi[i] ^ lo[i];
+            }
+          }
+          out = mask;
+        }
+        renderer.drawMaskRow(out, x, y + row, drawWidth, state);
+      });
+
+  free(mask);
+  return ok;
+}
+
+bool ImageBlock::isG5Path(const std::string& path) {
+  return path.size() > 3 && path.compare(path.size() - 3, 3, ".g5") == 0;
+}
+
+bool ImageBlock::compressBmpToG5(const std::string& bmpPath, const std::string& g5Path, const int planeCount) {
+  FsFile bmpFile;
+  if (!SdMan.openFileForRead("IMB", bmpPath, bmpFile)) {
+    return false;
+  }
+
+  Bitmap bitmap(bmpFile, false);
+  if (bitmap.parseHeaders() != BmpReaderError::Ok) {
+    bmpFile.close();
+    return false;
+  }
+
+  const int bmpWidth = bitmap.getWidth();
+  const int bmpHeight = bitmap.getHeight();
+  auto* packed = static_cast<uint8_t*>(malloc((static_cast<size_t>(bmpWidth) + 3) / 4));
+  auto* raw = static_cast<uint8_t*>(malloc(static_cast<size_t>(bitmap.getRowBytes())));
+  if (!packed || !raw) {
+    free(packed);
+    free(raw);
+    bmpFile.close();
+    return false;
+  }
+
+  const size_t rowBytes = (static_cast<size_t>(bmpWidth) + 7) / 8;
+  const bool ok = G5ImageCache::compressPlanesToFile(
+      bmpWidth, bmpHeight, planeCount,
+      [&](const int plane, const int row, uint8_t* out) {
+        const int storageRow = bitmap.isTopDown() ? row : bmpHeight - 1 - row;
+        if (bitmap.readRow(packed, raw, storageRow) != BmpReaderError::Ok) return false;
+        memset(out, 0, rowBytes);
+        for (int px = 0; px < bmpWidth; px++) {
+          const uint8_t darkness = 3 - ((packed[px >> 2] >> (6 - ((px & 3) << 1))) & 0x3);
+          const bool set = planeCount == 1 ? darkness != 0 : (plane == 0 ? (darkness >> 1) : (darkness & 1));
+          if (set) out[px >> 3] |= static_cast<uint8_t>(0x80 >> (px & 7));
+        }
+        return true;
+      },
+      g5Path.c_str());
+
+  free(packed);
+  free(raw);
+  bmpFile.close();
+  return ok;
+}
+
+std::string ImageBlock::compressCachedBmp(const std::string& bmpPath, const std::string& g5Path, const int planeCount) {
+  if (!compressBmpToG5(bmpPath, g5Path, planeCount)) {
+    LOG_DBG(TAG, "G5 compression failed, keeping BMP: %s", bmpPath.c_str());
+    return bmpPath;
+  }
+  SdMan.remove(bmpPath.c_str());
+  return g5Path;
+}
+
+bool ImageBlock::readCachedSize(const std::string& path, int& width, int& height) {
+  if (isG5Path(path)) {
+    G5ImageHeader header;
+    if (!G5ImageCache::readHeader(path.c_str(), header)) {
+      LOG_ERR(TAG, "Failed to read cached G5 image: %s", path.c_str());
+      return false;
+    }
+    width = header.width;
+    height = header.height;
+    return true;
+  }
+
+  FsFile bmpFile;
+  if (!SdMan.openFileForRead("IMB", path, bmpFile)) {
+    LOG_ERR(TAG, "Failed to open cached BMP: %s", path.c_str());
+    return false;
+  }
+  Bitmap bitmap(bmpFile, false);
+  const bool ok = bitmap.parseHeaders() == BmpReaderError::Ok;
+  if (ok) {
+    width = bitmap.getWidth();
+    height = bitmap.getHeight();
+  } else {
+    LOG_ERR(TAG, "BMP parse failed for cached image");
+  }
+  bmpFile.close();
+  return ok;
+}
+
 bool ImageBlock::serialize(FsFile& file) const {
   return serialization::writeStringChecked(file, cachedBmpPath) && serialization::writePodChecked(file, width) &&
          serialization::writePodChecked(file, height);
@@ -30,4 +30,17 @@ class ImageBlock final : public Block {
   void render(GfxRenderer& renderer, int fontId, int x, int y) const;
   bool serialize(FsFile& file) const;
   static std::unique_ptr<ImageBlock> deserialize(FsFile& file);
+
+  // Cached images are either a converted BMP or a Group5 file (".g5") made from it.
+  // G5 planes hold pixel darkness (3 - BMP value): one plane is the black mask for
+  // 1-bit rendering, two planes are its high and low bit for grayscale rendering.
+  static bool isG5Path(const std::string& path);
+  static bool compressBmpToG5(const std::string& bmpPath, const std::string& g5Path, int planeCount);
+  // Replace a cached BMP with its G5 form. Returns the path to use: the BMP stays if compression fails (low heap).
+  static std::string compressCachedBmp(const std::string& bmpPath, const std::string& g5Path, int planeCount);
+  // Dimensions of a cached image (either form) from its header
+  static bool readCachedSize(const std::string& path, int& width, int& height);
+
+ private:
+  bool renderG5(GfxRenderer& renderer, int x, int y) const;
 };
@@ -117,15 +117,15 @@ bool isCombiningMark(uint32_t cp) {
 }  // namespace
 
 size_t utf8NormalizeNfc(char* buf, size_t len) {
-  // Fast path: if all bytes are ASCII, no normalization needed
-  bool allAscii = true;
-  for (size_t i = 0; i < len; i++) {
-    if (static_cast<unsigned char>(buf[i]) >= 0x80) {
-      allAscii = false;
-      break;
-    }
+  // Fast path: if all bytes are ASCII, no normalization needed (high bits tested four bytes at a time)
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t w;
+    memcpy(&w, buf + i, 4);
+    if (w & 0x80808080u) break;
   }
-  if (allAscii) return len;
+  while (i < len && static_cast<unsigned char>(buf[i]) < 0x80) i++;
+  if (i == len) return len;
 
   // Decode to codepoints (max codepoints = len, since each UTF-8 char >= 1 byte)
   // Use stack buffer for small strings, heap for large ones.
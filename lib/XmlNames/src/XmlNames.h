@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * XmlNames - compile-time perfect hash for XML tag and attribute names
+ *
+ * Expat hands every element and attribute name to the parsers as a C string.
+ * Instead of strcmp() chains, each name is hashed once and looked up in a
+ * table whose seed is searched at compile time so that every known name gets
+ * its own slot. A lookup is one hash, one table read and one confirming
+ * compare (unknown names can land on an occupied slot).
+ *
+ * Shared by ChapterHtmlSlimParser (EPUB/HTML) and the FB2 parsers. Tag and
+ * attribute names live in one table; callers only switch on the IDs that make
+ * sense in their position.
+ */
+enum class XmlName : uint8_t {
+  Unknown = 0,
+
+  // XHTML tags
+  H1,
+  H2,
+  H3,
+  H4,
+  H5,
+  H6,
+  P,
+  Li,
+  Div,
+  Br,
+  Blockquote,
+  Question,
+  Answer,
+  Quotation,
+  Pre,
+  B,
+  Strong,
+  I,
+  Em,
+  Code,
+  Tt,
+  Kbd,
+  Samp,
+  Img,
+  Head,
+  Table,
+  A,
+  Ul,
+  Ol,
+
+  // FB2 tags (namespace prefix stripped)
+  Binary,
+  Body,
+  Section,
+  Title,
+  Subtitle,
+  Emphasis,
+  EmptyLine,
+  Image,
+  V,
+  TextAuthor,
+  Poem,
+  Stanza,
+  Cite,
+  Epigraph,
+  Annotation,
+  TitleInfo,
+  BookTitle,
+  Author,
+  FirstName,
+  LastName,
+  Lang,
+  Coverpage,
+
+  // Attributes
+  Class,
+  Style,
+  Dir,
+  Id,
+  Role,
+  EpubType,
+  AriaHidden,
+  Src,
+  Alt,
+  Href,
+  ContentType,
+
+  Count
+};
+
+namespace xml_names {
+
+struct Entry {
+  const char* name;
+  XmlName id;
+};
+
+constexpr Entry kEntries[] = {
+    {"h1", XmlName::H1},
+    {"h2", XmlName::H2},
+    {"h3", XmlName::H3},
+    {"h4", XmlName::H4},
+    {"h5", XmlName::H5},
+    {"h6", XmlName::H6},
+    {"p", XmlName::P},
+    {"li", XmlName::Li},
+    {"div", XmlName::Div},
+    {"br", XmlName::Br},
+    {"blockquote", XmlName::Blockquote},
+    {"question", XmlName::Question},
+    {"answer", XmlName::Answer},
+    {"quotation", XmlName::Quotation},
+    {"pre", XmlName::Pre},
+    {"b", XmlName::B},
+    {"strong", XmlName::Strong},
+    {"i", XmlName::I},
+    {"em", XmlName::Em},
+    {"code", XmlName::Code},
+    {"tt", XmlName::Tt},
+    {"kbd", XmlName::Kbd},
+    {"samp", XmlName::Samp},
+    {"img", XmlName::Img},
+    {"head", XmlName::Head},
+    {"table", XmlName::Table},
+    {"a", XmlName::A},
+    {"ul", XmlName::Ul},
+    {"ol", XmlName::Ol},
+    {"binary", XmlName::Binary},
+    {"body", XmlName::Body},
+    {"section", XmlName::Section},
+    {"title", XmlName::Title},
+    {"subtitle", XmlName::Subtitle},
+    {"emphasis", XmlName::Emphasis},
+    {"empty-line", XmlName::EmptyLine},
+    {"image", XmlName::Image},
+    {"v", XmlName::V},
+    {"text-author", XmlName::TextAuthor},
+    {"poem", XmlName::Poem},
+    {"stanza", XmlName::Stanza},
+    {"cite", XmlName::Cite},
+    {"epigraph", XmlName::Epigraph},
+    {"annotation", XmlName::Annotation},
+    {"title-info", XmlName::TitleInfo},
+    {"book-title", XmlName::BookTitle},
+    {"author", XmlName::Author},
+    {"first-name", XmlName::FirstName},
+    {"last-name", XmlName::LastName},
+    {"lang", XmlName::Lang},
+    {"coverpage", XmlName::Coverpage},
+    {"class", XmlName::Class},
+    {"style", XmlName::Style},
+    {"dir", XmlName::Dir},
+    {"id", XmlName::Id},
+    {"role", XmlName::Role},
+    {"epub:type", XmlName::EpubType},
+    {"aria-hidden", XmlName::AriaHidden},
+    {"src", XmlName::Src},
+    {"alt", XmlName::Alt},
+    {"href", XmlName::Href},
+    {"content-type", XmlName::ContentType},
+};
+
+constexpr size_t kEntryCount = sizeof(kEntries) / sizeof(kEntries[0]);
+static_assert(kEntryCount + 1 == static_cast<size_t>(XmlName::Count), "every XmlName needs a table entry");
+
+// 512 slots keeps the seed search short (~1-2% of seeds are collision-free)
+constexpr size_t kTableBits = 9;
+constexpr size_t kTableSize = size_t{1} << kTableBits;
+constexpr uint32_t kMaxSeed = 4096;
+
+constexpr uint32_t hash(const char* s, const uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
+  while (*s) {
+    h = (h ^ static_cast<uint8_t>(*s++)) * 16777619u;
+  }
+  return h ^ (h >> 15);
+}
+
+constexpr bool equals(const char* a, const char* b) {
+  while (*a && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+struct Table {
+  uint32_t seed = 0;
+  // kEntries index + 1, 0 = empty
+  uint8_t slots[kTableSize] = {};
+};
+
+constexpr Table buildTable() {
+  for (uint32_t seed = 1; seed < kMaxSeed; seed++) {
+    Table table;
+    table.seed = seed;
+    bool collision = false;
+    for (size_t i = 0; i < kEntryCount && !collision; i++) {
+      const size_t slot = hash(kEntries[i].name, seed) & (kTableSize - 1);
+      if (table.slots[slot] != 0) {
+        collision = true;
+      } else {
+        table.slots[slot] = static_cast<uint8_t>(i + 1);
+      }
+    }
+    if (!collision) return table;
+  }
+  return Table{};
+}
+
+constexpr Table kTable = buildTable();
+static_assert(kTable.seed != 0, "no collision-free seed found; grow kTableBits or kMaxSeed");
+
+}  // namespace xml_names
+
+// Map a tag or attribute name to its ID, XmlName::Unknown if not in the table
+constexpr XmlName lookupXmlName(const char* name) {
+  const uint8_t slot = xml_names::kTable.slots[xml_names::hash(name, xml_names::kTable.seed) &
+                                               (xml_names::kTableSize - 1)];
+  if (slot == 0) return XmlName::Unknown;
+  const auto& entry = xml_names::kEntries[slot - 1];
+  return xml_names::equals(entry.name, name) ? entry.id : XmlName::Unknown;
+}
+
+// Same, after stripping a namespace prefix ("l:section" -> "section"). For FB2.
+inline XmlName lookupXmlLocalName(const char* name) {
+  const char* local = name;
+  for (const char* p = name; *p; p++) {
+    if (*p == ':') local = p + 1;
+  }
+  return lookupXmlName(local);
+}
+
+static_assert(lookupXmlName("blockquote") == XmlName::Blockquote, "perfect hash self-check");
+static_assert(lookupXmlName("epub:type") == XmlName::EpubType, "perfect hash self-check");
+static_assert(lookupXmlName("marquee") == XmlName::Unknown, "perfect hash self-check");
@@ -0,0 +1,159 @@
+/**
+ * XtcPageCodec.cpp
+ *
+ * Compressed XTG/XTH page data (XtgPageHeader::compression)
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#include "XtcPageCodec.h"
+
+#include <Group5.h>
+#include <esp_heap_caps.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace xtc {
+namespace {
+
+bool readExactAt(FsFile& file, const uint64_t offset, uint8_t* out, const size_t len) {
+  if (!file.seek(offset)) return false;
+  const int bytesRead = file.read(out, len);
+  return bytesRead >= 0 && static_cast<size_t>(bytesRead) == len;
+}
+
+}  // namespace
+
+PageStreamDecoder::PageStreamDecoder() = default;
+PageStreamDecoder::~PageStreamDecoder() = default;
+
+XtcError PageStreamDecoder::begin(FsFile& file, const uint8_t compression, const uint64_t offset, const uint32_t size,
+                                  const size_t lineBytes, const size_t lineCount) {
+  file_ = &file;
+  compression_ = compression;
+  filePos_ = offset;
+  storedLeft_ = size;
+  decodedLeft_ = lineBytes * lineCount;
+  inputPos_ = inputLen_ = 0;
+  runLeft_ = 0;
+  lineBytes_ = lineBytes;
+  linePos_ = lineBytes;
+  compressed_.reset();
+  g5_.reset();
+  line_.reset();
+
+  switch (compression) {
+    case XTG_COMPRESSION_NONE:
+      return size == decodedLeft_ ? XtcError::OK : XtcError::CORRUPTED_HEADER;
+    case XTG_COMPRESSION_PACKBITS:
+      return size > 0 ? XtcError::OK : XtcError::CORRUPTED_HEADER;
+    case XTG_COMPRESSION_GROUP5:
+      break;
+    default:
+      return XtcError::CORRUPTED_HEADER;
+  }
+
+  // Group5 lines are whole bytes wide, so the padding bits round-trip too
+  if (size == 0 || lineBytes == 0 || lineCount == 0 || lineBytes * 8 > INT16_MAX || lineCount > INT16_MAX) {
+    return XtcError::CORRUPTED_HEADER;
+  }
+  const size_t needed = size + sizeof(G5DECODER) + lineBytes;
+  if (needed > heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) * 80 / 100) return XtcError::MEMORY_ERROR;
+
+  compressed_.reset(new (std::nothrow) uint8_t[size]);
+  g5_.reset(new (std::nothrow) G5DECODER());
+  line_.reset(new (std::nothrow) uint8_t[lineBytes]);
+  if (!compressed_ || !g5_ || !line_) return XtcError::MEMORY_ERROR;
+
+  if (!readExactAt(file, offset, compressed_.get(), size)) return XtcError::READ_ERROR;
+  storedLeft_ = 0;
+  if (g5_->init(static_cast<int>(lineBytes * 8), static_cast<int>(lineCount), compressed_.get(),
+                static_cast<int>(size)) != G5_SUCCESS) {
+    return XtcError::DECOMPRESSION_ERROR;
+  }
+  return XtcError::OK;
+}
+
+XtcError PageStreamDecoder::read(uint8_t* out, const size_t len) {
+  if (!file_ || len > decodedLeft_) return XtcError::DECOMPRESSION_ERROR;
+
+  XtcError error = XtcError::OK;
+  switch (compression_) {
+    case XTG_COMPRESSION_NONE:
+      if (!readExactAt(*file_, filePos_, out, len)) return XtcError::READ_ERROR;
+      filePos_ += len;
+      storedLeft_ -= static_cast<uint32_t>(len);
+      break;
+    case XTG_COMPRESSION_PACKBITS:
+      error = readPackBits(out, len);
+      break;
+    case XTG_COMPRESSION_GROUP5:
+      error = readGroup5(out, len);
+      break;
+    default:
+      return XtcError::CORRUPTED_HEADER;
+  }
+  if (error == XtcError::OK) decodedLeft_ -= len;
+  return error;
+}
+
+bool PageStreamDecoder::nextStoredByte(uint8_t& byte) {
+  if (inputPos_ == inputLen_) {
+    if (storedLeft_ == 0) return false;
+    const size_t toRead = std::min<size_t>(INPUT_BUFFER_SIZE, storedLeft_);
+    if (!readExactAt(*file_, filePos_, input_, toRead)) return false;
+    filePos_ += toRead;
+    storedLeft_ -= static_cast<uint32_t>(toRead);
+    inputPos_ = 0;
+    inputLen_ = toRead;
+  }
+  byte = input_[inputPos_++];
+  return true;
+}
+
+// Header byte n: 0..127 = n + 1 literal bytes follow, -1..-127 = next byte repeated
+// 1 - n times, -128 = no-op
+XtcError PageStreamDecoder::readPackBits(uint8_t* out, size_t len) {
+  while (len > 0) {
+    if (runLeft_ == 0) {
+      uint8_t header;
+      if (!nextStoredByte(header)) return XtcError::DECOMPRESSION_ERROR;
+      if (header == 0x80) continue;
+      runIsLiteral_ = header < 0x80;
+      runLeft_ = runIsLiteral_ ? header + 1u : 257u - header;
+      if (!runIsLiteral_ && !nextStoredByte(runValue_)) return XtcError::DECOMPRESSION_ERROR;
+    }
+
+    const size_t n = std::min(len, runLeft_);
+    if (runIsLiteral_) {
+      for (size_t i = 0; i < n; i++) {
+        if (!nextStoredByte(out[i])) return XtcError::DECOMPRESSION_ERROR;
+      }
+    } else {
+      memset(out, runValue_, n);
+    }
+    out += n;
+    len -= n;
+    runLeft_ -= n;
+  }
+  return XtcError::OK;
+}
+
+XtcError PageStreamDecoder::readGroup5(uint8_t* out, size_t len) {
+  while (len > 0) {
+    if (linePos_ == lineBytes_) {
+      const int result = g5_->decodeLine(line_.get());
+      if (result != G5_SUCCESS && result != G5_DECODE_COMPLETE) return XtcError::DECOMPRESSION_ERROR;
+      linePos_ = 0;
+    }
+    const size_t n = std::min(len, lineBytes_ - linePos_);
+    memcpy(out, line_.get() + linePos_, n);
+    linePos_ += n;
+    out += n;
+    len -= n;
+  }
+  return XtcError::OK;
+}
+
+}  // namespace xtc
@@ -0,0 +1,71 @@
+/**
+ * XtcPageCodec.h
+ *
+ * Compressed XTG/XTH page data (XtgPageHeader::compression)
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#pragma once
+
+#include <SdFat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "XtcTypes.h"
+
+class G5DECODER;
+
+namespace xtc {
+
+/**
+ * Decoder for one stored bitmap stream: a whole XTG bitmap or one XTH plane.
+ *
+ * The stream is a run of lines (XTG rows, XTH columns) of lineBytes each.
+ * Uncompressed and PackBits streams are read through a small buffer; Group5
+ * streams are loaded whole (a compressed page is a few KB) and decoded one line
+ * at a time. read() hands out decoded bytes in order, in any chunk size.
+ */
+class PageStreamDecoder {
+ public:
+  PageStreamDecoder();
+  ~PageStreamDecoder();
+
+  PageStreamDecoder(const PageStreamDecoder&) = delete;
+  PageStreamDecoder& operator=(const PageStreamDecoder&) = delete;
+
+  XtcError begin(FsFile& file, uint8_t compression, uint64_t offset, uint32_t size, size_t lineBytes,
+                 size_t lineCount);
+  XtcError read(uint8_t* out, size_t len);
+
+ private:
+  static constexpr size_t INPUT_BUFFER_SIZE = 256;
+
+  FsFile* file_ = nullptr;
+  uint8_t compression_ = XTG_COMPRESSION_NONE;
+  uint64_t filePos_ = 0;      // next stored byte to read
+  uint32_t storedLeft_ = 0;   // stored bytes not yet read
+  size_t decodedLeft_ = 0;    // decoded bytes not yet handed out
+
+  // PackBits
+  uint8_t input_[INPUT_BUFFER_SIZE];
+  size_t inputPos_ = 0;
+  size_t inputLen_ = 0;
+  size_t runLeft_ = 0;
+  bool runIsLiteral_ = false;
+  uint8_t runValue_ = 0;
+
+  // Group5
+  std::unique_ptr<uint8_t[]> compressed_;
+  std::unique_ptr<G5DECODER> g5_;
+  std::unique_ptr<uint8_t[]> line_;
+  size_t lineBytes_ = 0;
+  size_t linePos_ = 0;
+
+  bool nextStoredByte(uint8_t& byte);
+  XtcError readPackBits(uint8_t* out, size_t len);
+  XtcError readGroup5(uint8_t* out, size_t len);
+};
+
+}  // namespace xtc
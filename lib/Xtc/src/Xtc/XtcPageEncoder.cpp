@@ -0,0 +1,95 @@
+/**
+ * XtcPageEncoder.cpp
+ *
+ * Compressed XTG/XTH page encoding, for tools/xtc-repack and the host tests
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#include "XtcPageEncoder.h"
+
+#include <Group5.h>
+
+#include <cstring>
+
+namespace xtc {
+
+bool packBitsEncode(const uint8_t* data, const size_t size, std::vector<uint8_t>& out) {
+  out.clear();
+  size_t i = 0;
+  while (i < size) {
+    size_t run = 1;
+    while (i + run < size && run < 128 && data[i + run] == data[i]) run++;
+    if (run >= 2) {
+      out.push_back(static_cast<uint8_t>(257 - run));
+      out.push_back(data[i]);
+      i += run;
+      continue;
+    }
+
+    // Literal packet, ended early by a run of three or more
+    const size_t start = i;
+    while (i < size && i - start < 128) {
+      if (i + 2 < size && data[i] == data[i + 1] && data[i] == data[i + 2]) break;
+      i++;
+    }
+    out.push_back(static_cast<uint8_t>(i - start - 1));
+    out.insert(out.end(), data + start, data + i);
+  }
+  return true;
+}
+
+bool group5Encode(const uint8_t* data, const size_t lineBytes, const size_t lineCount, std::vector<uint8_t>& out) {
+  if (lineBytes == 0 || lineCount == 0 || lineBytes * 8 > INT16_MAX || lineCount > INT16_MAX) return false;
+
+  // Worst case is well above the raw size; anything larger is rejected by encodePage anyway
+  out.assign(lineBytes * lineCount * 2 + 64, 0);
+  std::vector<uint8_t> line(lineBytes);
+  G5ENCODER encoder;
+  if (encoder.init(static_cast<int>(lineBytes * 8), static_cast<int>(lineCount), out.data(),
+                   static_cast<int>(out.size())) != G5_SUCCESS) {
+    return false;
+  }
+  for (size_t y = 0; y < lineCount; y++) {
+    memcpy(line.data(), data + y * lineBytes, lineBytes);
+    const int result = encoder.encodeLine(line.data());
+    if (result != G5_SUCCESS && result != G5_ENCODE_COMPLETE) return false;
+  }
+  const int size = encoder.size();
+  if (size <= 0) return false;
+  out.resize(static_cast<size_t>(size));
+  return true;
+}
+
+bool encodePage(const uint8_t bitDepth, const uint16_t width, const uint16_t height, const uint8_t* bitmap,
+                const uint8_t compression, std::vector<uint8_t>& out) {
+  auto encodeStream = [compression](const uint8_t* data, const size_t lineBytes, const size_t lineCount,
+                                    std::vector<uint8_t>& stream) {
+    if (compression == XTG_COMPRESSION_GROUP5) return group5Encode(data, lineBytes, lineCount, stream);
+    if (compression == XTG_COMPRESSION_PACKBITS) return packBitsEncode(data, lineBytes * lineCount, stream);
+    return false;
+  };
+
+  out.clear();
+  if (bitDepth == 1) {
+    const size_t rowBytes = (static_cast<size_t>(width) + 7) / 8;
+    if (!encodeStream(bitmap, rowBytes, height, out)) return false;
+    return out.size() < xtgBitmapSize(width, height);
+  }
+  if (bitDepth != 2) return false;
+
+  const size_t columnBytes = xthColumnBytes(height);
+  const size_t planeSize = xthPlaneSize(width, height);
+  std::vector<uint8_t> first;
+  std::vector<uint8_t> second;
+  if (!encodeStream(bitmap, columnBytes, width, first) || !encodeStream(bitmap + planeSize, columnBytes, width, second)) {
+    return false;
+  }
+  const uint32_t firstSize = static_cast<uint32_t>(first.size());
+  out.resize(sizeof(firstSize));
+  for (size_t i = 0; i < sizeof(firstSize); i++) out[i] = static_cast<uint8_t>(firstSize >> (8 * i));
+  out.insert(out.end(), first.begin(), first.end());
+  out.insert(out.end(), second.begin(), second.end());
+  return out.size() < xthBitmapSize(width, height);
+}
+
+}  // namespace xtc
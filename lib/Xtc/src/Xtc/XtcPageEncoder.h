@@ -0,0 +1,34 @@
+/**
+ * XtcPageEncoder.h
+ *
+ * Compressed XTG/XTH page encoding, for tools/xtc-repack and the host tests
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "XtcTypes.h"
+
+namespace xtc {
+
+// PackBits-encode `size` bytes (the format PageStreamDecoder reads)
+bool packBitsEncode(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+// Group5-encode `lineCount` lines of `lineBytes` bytes. False if a line has too
+// many color changes for the decoder (MAX_IMAGE_FLIPS).
+bool group5Encode(const uint8_t* data, size_t lineBytes, size_t lineCount, std::vector<uint8_t>& out);
+
+/**
+ * Compress a raw XTG bitmap or XTH plane pair into the stored page layout:
+ * one stream for XTG; for XTH a uint32 (LE) size of the first plane's stream,
+ * then both streams. Returns false if the mode cannot represent the page or the
+ * result is not smaller than the raw bitmap (store it uncompressed then).
+ */
+bool encodePage(uint8_t bitDepth, uint16_t width, uint16_t height, const uint8_t* bitmap, uint8_t compression,
+                std::vector<uint8_t>& out);
+
+}  // namespace xtc
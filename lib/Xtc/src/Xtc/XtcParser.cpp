@@ -348,18 +348,23 @@ bool XtcParser::readValidatedPage(uint32_t pageIndex, PageInfo& page, XtgPageHea
     return false;
   }
 
-  if (pageHeader.compression != 0 || pageHeader.width != page.width || pageHeader.height != page.height) {
+  if (pageHeader.compression > XTG_COMPRESSION_PACKBITS || pageHeader.width != page.width ||
+      pageHeader.height != page.height) {
     m_lastError = XtcError::CORRUPTED_HEADER;
     return false;
   }
 
+  // Compressed pages are only stored when smaller than the raw bitmap
   bitmapSize = m_bitDepth == 2 ? xthBitmapSize(page.width, page.height) : xtgBitmapSize(page.width, page.height);
-  if (bitmapSize == 0 || bitmapSize > XTC_MAX_BITMAP_SIZE || pageHeader.dataSize != bitmapSize) {
+  const bool storedSizeValid = pageHeader.compression == XTG_COMPRESSION_NONE
+                                   ? pageHeader.dataSize == bitmapSize
+                                   : pageHeader.dataSize > 0 && pageHeader.dataSize < bitmapSize;
+  if (bitmapSize == 0 || bitmapSize > XTC_MAX_BITMAP_SIZE || !storedSizeValid) {
     m_lastError = XtcError::CORRUPTED_HEADER;
     return false;
   }
 
-  const uint64_t totalSize = sizeof(XtgPageHeader) + bitmapSize;
+  const uint64_t totalSize = sizeof(XtgPageHeader) + pageHeader.dataSize;
   if (page.size < totalSize || totalSize > fileSize - page.offset) {
     m_lastError = XtcError::CORRUPTED_HEADER;
     return false;
@@ -368,6 +373,39 @@ bool XtcParser::readValidatedPage(uint32_t pageIndex, PageInfo& page, XtgPageHea
   return true;
 }
 
+XtcError XtcParser::beginPageStreams(const PageInfo& page, const XtgPageHeader& pageHeader,
+                                     PageStreamDecoder (&streams)[2]) {
+  const uint64_t dataOffset = page.offset + sizeof(XtgPageHeader);
+  if (m_bitDepth != 2) {
+    return streams[0].begin(m_file, pageHeader.compression, dataOffset, pageHeader.dataSize,
+                            (static_cast<size_t>(page.width) + 7) / 8, page.height);
+  }
+
+  // XTH: two planes of `width` columns. Compressed pages prefix the first plane's stream size.
+  const size_t columnBytes = xthColumnBytes(page.height);
+  uint64_t firstOffset = dataOffset;
+  uint32_t firstSize = static_cast<uint32_t>(xthPlaneSize(page.width, page.height));
+  uint32_t secondSize = firstSize;
+  if (pageHeader.compression != XTG_COMPRESSION_NONE) {
+    if (pageHeader.dataSize < sizeof(firstSize) || !m_file.seek(dataOffset) ||
+        !readExact(m_file, &firstSize, sizeof(firstSize))) {
+      return XtcError::READ_ERROR;
+    }
+    const uint32_t streamBytes = pageHeader.dataSize - sizeof(firstSize);
+    if (firstSize > streamBytes) return XtcError::CORRUPTED_HEADER;
+    firstOffset += sizeof(firstSize);
+    secondSize = streamBytes - firstSize;
+  }
+
+  XtcError error =
+      streams[0].begin(m_file, pageHeader.compression, firstOffset, firstSize, columnBytes, page.width);
+  if (error == XtcError::OK) {
+    error = streams[1].begin(m_file, pageHeader.compression, firstOffset + firstSize, secondSize, columnBytes,
+                             page.width);
+  }
+  return error;
+}
+
 bool XtcParser::getPageInfo(uint32_t pageIndex, PageInfo& info) { return readPageEntry(pageIndex, info); }
 
 size_t XtcParser::loadPage(uint32_t pageIndex, uint8_t* buffer, size_t bufferSize) {
@@ -396,14 +434,17 @@ size_t XtcParser::loadPage(uint32_t pageIndex, uint8_t* buffer, size_t bufferSiz
     return 0;
   }
 
-  const int bytesRead = m_file.read(buffer, bitmapSize);
-  if (bytesRead < 0 || static_cast<size_t>(bytesRead) != bitmapSize) {
-    m_lastError = XtcError::READ_ERROR;
-    return 0;
+  PageStreamDecoder streams[2];
+  m_lastError = beginPageStreams(page, pageHeader, streams);
+  if (m_lastError != XtcError::OK) return 0;
+  const size_t streamCount = m_bitDepth == 2 ? 2 : 1;
+  const size_t streamSize = bitmapSize / streamCount;
+  for (size_t i = 0; i < streamCount; i++) {
+    m_lastError = streams[i].read(buffer + i * streamSize, streamSize);
+    if (m_lastError != XtcError::OK) return 0;
   }
 
-  m_lastError = XtcError::OK;
-  return bytesRead;
+  return bitmapSize;
 }
 
 XtcError XtcParser::loadPageStreaming(uint32_t pageIndex, PageChunkCallback callback, size_t chunkSize,
@@ -426,24 +467,28 @@ XtcError XtcParser::loadPageStreaming(uint32_t pageIndex, PageChunkCallback call
   std::unique_ptr<uint8_t[]> chunk(new (std::nothrow) uint8_t[chunkSize]);
   if (!chunk) return XtcError::MEMORY_ERROR;
 
+  PageStreamDecoder streams[2];
+  m_lastError = beginPageStreams(page, pageHeader, streams);
+  if (m_lastError != XtcError::OK) return m_lastError;
+  // XTH planes are handed out one after the other, as stored
+  const size_t streamSize = m_bitDepth == 2 ? bitmapSize / 2 : bitmapSize;
+
   size_t totalRead = 0;
   while (totalRead < bitmapSize) {
     if (shouldAbort && shouldAbort()) {
       m_lastError = XtcError::CANCELLED;
       return m_lastError;
     }
-    const size_t toRead = std::min(chunkSize, bitmapSize - totalRead);
-    const int bytesRead = m_file.read(chunk.get(), toRead);
-    if (bytesRead < 0 || static_cast<size_t>(bytesRead) != toRead) {
-      m_lastError = XtcError::READ_ERROR;
-      return m_lastError;
-    }
+    const size_t stream = totalRead / streamSize;
+    const size_t toRead = std::min(chunkSize, (stream + 1) * streamSize - totalRead);
+    m_lastError = streams[stream].read(chunk.get(), toRead);
+    if (m_lastError != XtcError::OK) return m_lastError;
 
-    if (!callback(chunk.get(), static_cast<size_t>(bytesRead), totalRead)) {
+    if (!callback(chunk.get(), toRead, totalRead)) {
       m_lastError = XtcError::READ_ERROR;
       return m_lastError;
     }
-    totalRead += static_cast<size_t>(bytesRead);
+    totalRead += toRead;
   }
 
   m_lastError = XtcError::OK;
@@ -481,15 +526,16 @@ XtcError XtcParser::loadPagePlanePairs(const uint32_t pageIndex, PagePlaneChunkC
 
   uint8_t* const plane1 = scratch.get();
   uint8_t* const plane2 = scratch.get() + chunkSize;
-  const uint64_t bitmapOffset = page.offset + sizeof(XtgPageHeader);
+  PageStreamDecoder streams[2];
+  const XtcError streamError = beginPageStreams(page, pageHeader, streams);
+  if (streamError != XtcError::OK) return finish(streamError);
 
   for (size_t offset = 0; offset < planeSize; offset += chunkSize) {
     if (shouldAbort && shouldAbort()) return finish(XtcError::CANCELLED);
     const size_t size = std::min(chunkSize, planeSize - offset);
-    if (!m_file.seek(bitmapOffset + offset) || !readExact(m_file, plane1, size) ||
-        !m_file.seek(bitmapOffset + planeSize + offset) || !readExact(m_file, plane2, size)) {
-      return finish(XtcError::READ_ERROR);
-    }
+    XtcError error = streams[0].read(plane1, size);
+    if (error == XtcError::OK) error = streams[1].read(plane2, size);
+    if (error != XtcError::OK) return finish(error);
     if (!callback(plane1, plane2, size, offset)) return finish(XtcError::READ_ERROR);
   }
 
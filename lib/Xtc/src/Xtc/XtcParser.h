@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 
+#include "XtcPageCodec.h"
 #include "XtcTypes.h"
 
 namespace xtc {
@@ -46,6 +47,8 @@ class XtcParser {
 
   /**
    * Load page bitmap (raw 1-bit data, skipping XTG header)
+   * Compressed pages (Group5, PackBits) are decoded here and by the streaming
+   * loaders below, so callers always see the raw XTG/XTH layout.
    *
    * @param pageIndex Page index (0-based)
    * @param buffer Output buffer (caller allocated)
@@ -112,6 +115,7 @@ class XtcParser {
   void ensureChaptersLoaded() const;
   bool readPageEntry(uint32_t pageIndex, PageInfo& info);
   bool readValidatedPage(uint32_t pageIndex, PageInfo& page, XtgPageHeader& pageHeader, size_t& bitmapSize);
+  XtcError beginPageStreams(const PageInfo& page, const XtgPageHeader& pageHeader, PageStreamDecoder (&streams)[2]);
 };
 
 }  // namespace xtc
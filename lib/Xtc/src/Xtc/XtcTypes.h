@@ -30,6 +30,11 @@ constexpr uint32_t XTG_MAGIC = 0x00475458;  // "XTG\0" for 1-bit page data
 // "XTH\0" = 0x58, 0x54, 0x48, 0x00
 constexpr uint32_t XTH_MAGIC = 0x00485458;  // "XTH\0" for 2-bit page data
 
+// XtgPageHeader::compression values
+constexpr uint8_t XTG_COMPRESSION_NONE = 0;
+constexpr uint8_t XTG_COMPRESSION_GROUP5 = 1;    // lib/Group5, one line per XTG row / XTH column
+constexpr uint8_t XTG_COMPRESSION_PACKBITS = 2;  // PackBits run-length bytes
+
 // XTeink X4 display resolution
 constexpr uint16_t DISPLAY_WIDTH = 480;
 constexpr uint16_t DISPLAY_HEIGHT = 800;
@@ -112,8 +117,8 @@ struct XtgPageHeader {
   uint16_t width;       // 0x04: Image width (pixels)
   uint16_t height;      // 0x06: Image height (pixels)
   uint8_t colorMode;    // 0x08: Color mode (0=monochrome)
-  uint8_t compression;  // 0x09: Compression (0=uncompressed)
-  uint32_t dataSize;    // 0x0A: Image data size (bytes)
+  uint8_t compression;  // 0x09: Compression (XTG_COMPRESSION_*)
+  uint32_t dataSize;    // 0x0A: Stored image data size (bytes, compressed size if compressed)
   uint64_t md5;         // 0x0E: MD5 checksum (first 8 bytes, optional)
   // Followed by bitmap data at offset 0x16 (22)
   //
@@ -126,6 +131,12 @@ struct XtgPageHeader {
   //   First plane: Bit1 for all pixels
   //   Second plane: Bit2 for all pixels
   //   pixelValue = (bit1 << 1) | bit2
+  //
+  // Compressed pages (compression != 0) store the same bitmap encoded:
+  //   XTG: one stream of height rows
+  //   XTH: uint32 size of the first plane's stream, then the first and second
+  //        plane streams, each of width columns
+  //   Every line is padded to whole bytes, so decoding is lossless
 };
 #pragma pack(pop)
 
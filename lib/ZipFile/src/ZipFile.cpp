@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <climits>
 #include <cstddef>
+#include <new>
 
 struct ZipInflateCtx {
   InflateReader reader;  // Must be first — callback casts uzlib_uncomp* to ZipInflateCtx*
@@ -729,3 +730,211 @@ StreamReadResult ZipFile::readFileToStreamDetailed(const char* filename, Print&
   LOG_ERR(TAG, "Unsupported compression method");
   return StreamReadResult::UnsupportedMethod;
 }
+
+ZipEntryReader::~ZipEntryReader() { close(); }
+
+StreamReadResult ZipEntryReader::open(ZipFile& zip, const char* filename, uint8_t* dictBuffer) {
+  close();
+
+  const bool wasOpen = zip.isOpen();
+  if (!wasOpen && !zip.open()) {
+    return StreamReadResult::OpenFailed;
+  }
+  zip_ = &zip;
+  closeZip_ = !wasOpen;
+
+  ZipFile::FileStatSlim fileStat = {};
+  if (!zip.loadFileStatSlim(filename, &fileStat)) {
+    close();
+    return StreamReadResult::NotFound;
+  }
+
+  const long fileOffset = zip.getDataOffset(fileStat);
+  if (fileOffset < 0 || !dataSpanFits(zip.file, static_cast<size_t>(fileOffset), fileStat.compressedSize) ||
+      (fileStat.method == ZIP_METHOD_STORED && fileStat.compressedSize != fileStat.uncompressedSize) ||
+      !zip.file.seek(fileOffset)) {
+    close();
+    return StreamReadResult::InvalidOffset;
+  }
+
+  dataOffset_ = static_cast<size_t>(fileOffset);
+  compressedSize_ = fileStat.compressedSize;
+  uncompressedSize_ = fileStat.uncompressedSize;
+  remaining_ = fileStat.uncompressedSize;
+
+  if (fileStat.method == ZIP_METHOD_STORED) {
+    return StreamReadResult::Success;
+  }
+  if (fileStat.method != ZIP_METHOD_DEFLATED) {
+    close();
+    LOG_ERR(TAG, "Unsupported compression method");
+    return StreamReadResult::UnsupportedMethod;
+  }
+
+  deflated_ = true;
+  readBuf_ = static_cast<uint8_t*>(malloc(READ_BUFFER_SIZE));
+  inflate_ = new (std::nothrow) ZipInflateCtx();
+  if (!readBuf_ || !inflate_ || !inflate_->reader.init(true, dictBuffer)) {
+    LOG_ERR(TAG, "Failed to init entry reader (largest free: %u)", heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    close();
+    return StreamReadResult::AllocFailed;
+  }
+  inflate_->file = &zip.file;
+  inflate_->fileRemaining = fileStat.compressedSize;
+  inflate_->readBuf = readBuf_;
+  inflate_->readBufSize = READ_BUFFER_SIZE;
+  inflate_->reader.setReadCallback(zipReadCallback);
+  return StreamReadResult::Success;
+}
+
+void ZipEntryReader::close() {
+  delete inflate_;
+  inflate_ = nullptr;
+  free(readBuf_);
+  readBuf_ = nullptr;
+  if (zip_ && closeZip_) zip_->close();
+  zip_ = nullptr;
+  closeZip_ = false;
+  deflated_ = false;
+  done_ = false;
+  dataOffset_ = 0;
+  compressedSize_ = 0;
+  uncompressedSize_ = 0;
+  remaining_ = 0;
+}
+
+int ZipEntryReader::read(uint8_t* buf, const size_t len) {
+  if (!zip_) return -1;
+  if (done_ || len == 0) return 0;
+
+  if (!deflated_) {
+    const size_t toRead = remaining_ < len ? remaining_ : len;
+    if (toRead == 0) {
+      done_ = true;
+      return 0;
+    }
+    const int bytesRead = zip_->file.read(buf, toRead);
+    if (bytesRead <= 0) {
+      LOG_ERR(TAG, "Could not read more bytes");
+      return -1;
+    }
+    remaining_ -= static_cast<size_t>(bytesRead);
+    return bytesRead;
+  }
+
+  // Stop at the declared size; the decoder sees end of data there
+  if (remaining_ == 0) {
+    done_ = true;
+    return 0;
+  }
+  size_t produced = 0;
+  const InflateStatus status = inflate_->reader.readAtMost(buf, remaining_ < len ? remaining_ : len, &produced);
+  if (status == InflateStatus::Error) {
+    LOG_ERR(TAG, "Decompression failed");
+    return -1;
+  }
+  remaining_ -= produced;
+  if (status == InflateStatus::Done) {
+    done_ = true;
+    if (remaining_ != 0) {
+      LOG_ERR(TAG, "Decompressed size mismatch (expected %zu, short by %zu)", uncompressedSize_, remaining_);
+      return -1;
+    }
+  }
+  return static_cast<int>(produced);
+}
+
+bool ZipEntryReader::seek(const size_t offset) {
+  if (!zip_ || offset > uncompressedSize_) return false;
+
+  if (!deflated_) {
+    if (!zip_->file.seek(dataOffset_ + offset)) return false;
+    remaining_ = uncompressedSize_ - offset;
+    done_ = false;
+    return true;
+  }
+
+  if (offset < position() && !rewindDeflated()) return false;
+
+  uint8_t discard[256];
+  while (position() < offset) {
+    const size_t want = offset - position() < sizeof(discard) ? offset - position() : sizeof(discard);
+    if (read(discard, want) <= 0) return false;
+  }
+  return true;
+}
+
+// Restart inflating at the beginning of the entry, keeping the buffers
+bool ZipEntryReader::rewindDeflated() {
+  if (!zip_->file.seek(dataOffset_)) return false;
+  uzlib_uncomp* d = inflate_->reader.raw();
+  const auto readCb = d->source_read_cb;
+  uzlib_uncompress_init(d, d->dict_ring, d->dict_size);
+  d->source = nullptr;
+  d->source_limit = nullptr;
+  d->source_read_cb = readCb;
+  d->tag = 0;
+  inflate_->fileRemaining = compressedSize_;
+  remaining_ = uncompressedSize_;
+  done_ = false;
+  return true;
+}
+
+// Compressed bytes the decoder has taken in (read from the file minus what is still buffered)
+size_t ZipEntryReader::compressedConsumed() const {
+  const uzlib_uncomp* d = inflate_->reader.raw();
+  const size_t buffered = d->source && d->source_limit > d->source ? static_cast<size_t>(d->source_limit - d->source) : 0;
+  return compressedSize_ - inflate_->fileRemaining - buffered;
+}
+
+bool ZipEntryReader::saveCheckpoint(FsFile& out) const {
+  if (!zip_ || !deflated_) return false;
+
+  const uzlib_uncomp* d = inflate_->reader.raw();
+  // Pointers are rebuilt on restore; everything else is plain decoder state
+  uzlib_uncomp state = *d;
+  state.source = nullptr;
+  state.source_limit = nullptr;
+  state.source_read_cb = nullptr;
+  state.dest_start = nullptr;
+  state.dest = nullptr;
+  state.dest_limit = nullptr;
+  state.dict_ring = nullptr;
+
+  const uint32_t header[2] = {static_cast<uint32_t>(position()), static_cast<uint32_t>(compressedConsumed())};
+  return out.write(reinterpret_cast<const uint8_t*>(header), sizeof(header)) == sizeof(header) &&
+         out.write(reinterpret_cast<const uint8_t*>(&state), sizeof(state)) == sizeof(state) &&
+         out.write(d->dict_ring, d->dict_size) == d->dict_size;
+}
+
+bool ZipEntryReader::restoreCheckpoint(FsFile& in) {
+  if (!zip_ || !deflated_) return false;
+
+  uint32_t header[2];
+  uzlib_uncomp state;
+  if (in.read(header, sizeof(header)) != static_cast<int>(sizeof(header)) ||
+      in.read(&state, sizeof(state)) != static_cast<int>(sizeof(state))) {
+    return false;
+  }
+  uzlib_uncomp* d = inflate_->reader.raw();
+  if (header[0] > uncompressedSize_ || header[1] > compressedSize_ || state.dict_size != d->dict_size ||
+      state.dict_idx >= state.dict_size) {
+    LOG_ERR(TAG, "Invalid inflate checkpoint");
+    return false;
+  }
+  if (in.read(d->dict_ring, d->dict_size) != static_cast<int>(d->dict_size) ||
+      !zip_->file.seek(dataOffset_ + header[1])) {
+    rewindDeflated();
+    return false;
+  }
+
+  state.source = nullptr;
+  state.source_limit = nullptr;
+  state.source_read_cb = d->source_read_cb;
+  state.dict_ring = d->dict_ring;
+  *d = state;
+  inflate_->fileRemaining = compressedSize_ - header[1];
+  remaining_ = uncompressedSize_ - header[0];
+  done_ = false;
+  return true;
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <ByteSource.h>
+#include <InflateReader.h>
 #include <SdFat.h>
 
 #include <functional>
@@ -8,6 +10,8 @@
 #include <vector>
 
 class BuildArena;
+class ZipEntryReader;
+struct ZipInflateCtx;
 
 enum class StreamReadResult : uint8_t {
   Success,
@@ -61,6 +65,8 @@ class ZipFile {
   }
 
  private:
+  friend class ZipEntryReader;
+
   std::string filePath;
   FsFile file;
   ZipDetails zipDetails = {0, 0, false};
@@ -102,3 +108,64 @@ class ZipFile {
                                             const std::function<bool()>& shouldAbort = nullptr,
                                             BuildArena* scratch = nullptr);
 };
+
+/**
+ * Pull-style reader over one ZIP entry (stored or deflated), so decoders can
+ * consume it without extracting to a temp file first.
+ *
+ * Opens the ZIP if needed and keeps it open until close(); the ZipFile must
+ * outlive the reader. Deflated entries need a 32KB dictionary: pass dictBuffer
+ * to reuse an existing buffer, otherwise it is malloc'd.
+ */
+class ZipEntryReader : public ByteSource {
+ public:
+  static constexpr size_t READ_BUFFER_SIZE = 1024;
+
+  ZipEntryReader() = default;
+  ~ZipEntryReader() override;
+
+  ZipEntryReader(const ZipEntryReader&) = delete;
+  ZipEntryReader& operator=(const ZipEntryReader&) = delete;
+
+  StreamReadResult open(ZipFile& zip, const char* filename, uint8_t* dictBuffer = nullptr);
+  void close();
+
+  int read(uint8_t* buf, size_t len) override;
+  size_t size() const override { return uncompressedSize_; }
+
+  // Uncompressed offset of the next byte read() returns
+  size_t position() const { return uncompressedSize_ - remaining_; }
+  bool isDeflated() const { return deflated_; }
+
+  /**
+   * Move to an uncompressed offset. Stored entries seek directly; deflated ones
+   * inflate forward from the current position (or from the start when going
+   * back), so pair with restoreCheckpoint() for random access.
+   */
+  bool seek(size_t offset);
+
+  /**
+   * Inflate checkpoints: the decoder state at position() (bit reader, trees and
+   * the 32KB window), written as one CHECKPOINT_SIZE record. A reader open on the
+   * same entry can restoreCheckpoint() it and continue from there instead of
+   * inflating everything before it. Deflated entries only.
+   */
+  static constexpr size_t CHECKPOINT_SIZE = 8 + sizeof(uzlib_uncomp) + InflateReader::STREAMING_DICTIONARY_SIZE;
+  bool saveCheckpoint(FsFile& out) const;
+  bool restoreCheckpoint(FsFile& in);
+
+ private:
+  ZipFile* zip_ = nullptr;
+  bool closeZip_ = false;
+  bool deflated_ = false;
+  bool done_ = false;
+  size_t dataOffset_ = 0;  // Entry data in the ZIP file
+  size_t compressedSize_ = 0;
+  size_t uncompressedSize_ = 0;
+  size_t remaining_ = 0;  // stored: bytes left in the entry; deflated: bytes left to produce
+  ZipInflateCtx* inflate_ = nullptr;
+  uint8_t* readBuf_ = nullptr;
+
+  bool rewindDeflated();
+  size_t compressedConsumed() const;
+};
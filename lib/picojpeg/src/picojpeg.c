@@ -224,6 +224,7 @@ static pjpeg_need_bytes_callback_t g_pNeedBytesCallback;
 static void* g_pCallback_data;
 static uint8 gCallbackStatus;
 static uint8 gReduce;
+static uint8 gScale;
 //------------------------------------------------------------------------------
 static void fillInBuf(void) {
   unsigned char status;
@@ -1260,6 +1261,80 @@ static void idctCols(void) {
   }
 }
 
+/*----------------------------------------------------------------------------*/
+// Reduced IDCTs for scaled grayscale decoding (pjpeg_set_scale).
+// gCoeffBuf holds Winograd-prescaled coefficients, so averaging the full 8-point IDCT over each run of 8/N output
+// pixels collapses to a plain N-point inverse DCT over the low coefficients (basis u at reduced pixel y becomes
+// cos((2y+1)u*pi/2N), scaled by the box-filter gain). Only the top-left 4x4 coefficients are used; the higher ones
+// would mostly alias and are dropped, the same trade libjpeg's scaled IDCTs make. Constants are 8.8 fixed point.
+#define PJPG_R_C1 237  // cos(pi/8)
+#define PJPG_R_C2 181  // cos(pi/4)
+#define PJPG_R_C3 98   // cos(3pi/8)
+#define PJPG_R_Q1 167  // cos(pi/4) * (cos(pi/16) + cos(3pi/16)) / (2 cos(pi/16))
+#define PJPG_R_Q3 69   // cos(pi/4) * (cos(3pi/16) + cos(9pi/16)) / (2 cos(3pi/16))
+
+static PJPG_INLINE long reduceMul(long x, long k) { return (x * k + 128L) >> 8; }
+
+static PJPG_INLINE uint8 reduceDescale(long x) {
+  x = ((x + (1L << (PJPG_DCT_SCALE_BITS - 1))) >> PJPG_DCT_SCALE_BITS) + 128;
+  return (uint8)(x < 0 ? 0 : (x > 255 ? 255 : x));
+}
+
+// 4-point butterfly: 5 multiplies
+static PJPG_INLINE void reduceIdct4(long c0, long c1, long c2, long c3, long* pOut) {
+  long e = reduceMul(c2, PJPG_R_C2);
+  long o0 = reduceMul(c1, PJPG_R_C1) + reduceMul(c3, PJPG_R_C3);
+  long o1 = reduceMul(c1, PJPG_R_C3) - reduceMul(c3, PJPG_R_C1);
+
+  pOut[0] = c0 + e + o0;
+  pOut[1] = c0 - e + o1;
+  pOut[2] = c0 - e - o1;
+  pOut[3] = c0 + e - o0;
+}
+
+// 1/2 scale: 4x4 pixels per block, written back to gCoeffBuf with a row stride of 8
+static void idctReduce4(void) {
+  long tmp[4 * 4];
+  long col[4];
+  uint8 i;
+
+  for (i = 0; i < 4; i++) {
+    const int16* pSrc = gCoeffBuf + i * 8;
+    long* pDst = tmp + i * 4;
+    if ((pSrc[1] | pSrc[2] | pSrc[3]) == 0) {
+      pDst[0] = pDst[1] = pDst[2] = pDst[3] = pSrc[0];
+    } else {
+      reduceIdct4(pSrc[0], pSrc[1], pSrc[2], pSrc[3], pDst);
+    }
+  }
+
+  for (i = 0; i < 4; i++) {
+    reduceIdct4(tmp[i], tmp[4 + i], tmp[8 + i], tmp[12 + i], col);
+    gCoeffBuf[0 * 8 + i] = reduceDescale(col[0]);
+    gCoeffBuf[1 * 8 + i] = reduceDescale(col[1]);
+    gCoeffBuf[2 * 8 + i] = reduceDescale(col[2]);
+    gCoeffBuf[3 * 8 + i] = reduceDescale(col[3]);
+  }
+}
+
+// 1/4 scale: 2x2 pixels per block (the cos(pi/2) terms of u = 2 vanish)
+static void idctReduce2(void) {
+  long tmp[4 * 2];
+  uint8 i;
+
+  for (i = 0; i < 4; i++) {
+    const int16* pSrc = gCoeffBuf + i * 8;
+    long o = reduceMul(pSrc[1], PJPG_R_Q1) - reduceMul(pSrc[3], PJPG_R_Q3);
+    tmp[i * 2 + 0] = pSrc[0] + o;
+    tmp[i * 2 + 1] = pSrc[0] - o;
+  }
+
+  for (i = 0; i < 2; i++) {
+    long o = reduceMul(tmp[2 + i], PJPG_R_Q1) - reduceMul(tmp[6 + i], PJPG_R_Q3);
+    gCoeffBuf[0 * 8 + i] = reduceDescale(tmp[i] + o);
+    gCoeffBuf[1 * 8 + i] = reduceDescale(tmp[i] - o);
+  }
+}
 /*----------------------------------------------------------------------------*/
 static PJPG_INLINE uint8 addAndClamp(uint8 a, int16 b) {
   b = a + b;
@@ -1859,8 +1934,22 @@ static void transformBlockGrayscale(uint8 mcuBlock) {
 
   if (componentID != 0) return;
 
-  idctRows();
-  idctCols();
+  switch (gScale) {
+    case PJPG_SCALE_1_2:
+      idctReduce4();
+      break;
+    case PJPG_SCALE_1_4:
+      idctReduce2();
+      break;
+    case PJPG_SCALE_1_8:
+      // AC coefficients were skipped, the DC term is the block average
+      gCoeffBuf[0] = clamp(PJPG_DESCALE(gCoeffBuf[0]) + 128);
+      break;
+    default:
+      idctRows();
+      idctCols();
+      break;
+  }
 
   switch (gScanType) {
     case PJPG_GRAYSCALE:
@@ -1943,8 +2032,9 @@ static uint8 decodeNextMCU(void) {
       }
 
       transformBlockReduce(mcuBlock);
-    } else if ((gReduce == PJPG_GRAYSCALE_ONLY) && (componentID != 0)) {
-      // Grayscale-only mode, chroma block: parse Huffman to advance bitstream, skip IDCT/upsample/convert
+    } else if ((gReduce == PJPG_GRAYSCALE_ONLY) && ((componentID != 0) || (gScale == PJPG_SCALE_1_8))) {
+      // Grayscale-only mode, chroma block (or 1/8 scale Y block, which needs only the DC term):
+      // parse Huffman to advance bitstream, skip IDCT/upsample/convert
       for (k = 1; k < 64; k++) {
         s = huffDecode(compACTab ? &gHuffTab3 : &gHuffTab2, compACTab ? gHuffVal3 : gHuffVal2);
 
@@ -1969,6 +2059,8 @@ static uint8 decodeNextMCU(void) {
             break;
         }
       }
+
+      if (componentID == 0) transformBlockGrayscale(mcuBlock);
     } else {
       // Full decode (reduce==0) or grayscale-only Y blocks
       for (k = 1; k < 64; k++) {
@@ -2061,6 +2153,7 @@ unsigned char pjpeg_decode_init(pjpeg_image_info_t* pInfo, pjpeg_need_bytes_call
   g_pCallback_data = pCallback_data;
   gCallbackStatus = 0;
   gReduce = reduce;
+  gScale = PJPG_SCALE_1_1;
 
   status = init();
   if ((status) || (gCallbackStatus)) return gCallbackStatus ? gCallbackStatus : status;
@@ -2088,3 +2181,11 @@ unsigned char pjpeg_decode_init(pjpeg_image_info_t* pInfo, pjpeg_need_bytes_call
 
   return 0;
 }
+//------------------------------------------------------------------------------
+unsigned char pjpeg_set_scale(unsigned char scale) {
+  if (scale > PJPG_SCALE_1_8) return PJPG_UNSUPPORTED_MODE;
+  if ((scale != PJPG_SCALE_1_1) && (gReduce != PJPG_GRAYSCALE_ONLY)) return PJPG_UNSUPPORTED_MODE;
+
+  gScale = scale;
+  return 0;
+}
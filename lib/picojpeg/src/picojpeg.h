@@ -120,6 +120,21 @@ typedef unsigned char (*pjpeg_need_bytes_callback_t)(unsigned char* pBuf, unsign
 unsigned char pjpeg_decode_init(pjpeg_image_info_t* pInfo, pjpeg_need_bytes_callback_t pNeed_bytes_callback,
                                 void* pCallback_data, unsigned char reduce);
 
+// Reduced-size decoding for PJPG_GRAYSCALE_ONLY, as log2 of the downscale factor. Each 8x8 Y block is decoded
+// straight to a (8 >> scale)-pixel square: 1/2 and 1/4 use a reduced IDCT over the low-frequency coefficients (the
+// box average of the full IDCT), 1/8 keeps only the DC term and skips the AC math entirely. Output stays in the block
+// layout described above with a row stride of 8 bytes, so only the top-left (8 >> scale)^2 bytes of each block are
+// valid. m_width/m_height/m_MCUWidth/m_MCUHeight keep reporting full-size values; callers divide (rounding up).
+#define PJPG_SCALE_1_1 0
+#define PJPG_SCALE_1_2 1
+#define PJPG_SCALE_1_4 2
+#define PJPG_SCALE_1_8 3
+
+// Selects the decode scale. Call after pjpeg_decode_init() and before the first pjpeg_decode_mcu(). Returns 0 on
+// success, or PJPG_UNSUPPORTED_MODE if the scale is out of range or the decoder was not initialized with
+// PJPG_GRAYSCALE_ONLY (any scale other than PJPG_SCALE_1_1 is rejected in that case).
+unsigned char pjpeg_set_scale(unsigned char scale);
+
 // Decompresses the file's next MCU. Returns 0 on success, PJPG_NO_MORE_BLOCKS if no more blocks are available, or an
 // error code. Must be called a total of m_MCUSPerRow*m_MCUSPerCol times to completely decompress the image. Not thread
 // safe.
@@ -29,6 +29,48 @@ uint32_t updateFontFingerprint(uint32_t hash, const void* data, size_t size) {
 uint32_t builtinFontFingerprint(int fontId) {
   return updateFontFingerprint(kFontFingerprintBasis, &fontId, sizeof(fontId));
 }
+
+uint32_t binFontFingerprint(int builtinFontId, const char* familyName, uint32_t fileSignature) {
+  const uint32_t hash = updateFontFingerprint(builtinFontFingerprint(builtinFontId), familyName, strlen(familyName));
+  return updateFontFingerprint(hash, &fileSignature, sizeof(fileSignature));
+}
+
+struct StyleFile {
+  const char* filename;
+  EpdFontFamily::Style style;
+};
+constexpr StyleFile kStyleFiles[] = {{"regular.epdfont", EpdFontFamily::REGULAR},
+                                     {"bold.epdfont", EpdFontFamily::BOLD}};
+
+// Hashes the style files of a custom family and fills stylePaths with the ones
+// present. 0 when regular.epdfont is missing or a file cannot be fingerprinted.
+uint32_t customFamilyFingerprint(const char* familyName, int fontId, char (&stylePaths)[3][80]) {
+  uint32_t fingerprint = builtinFontFingerprint(fontId);
+  for (const auto& s : kStyleFiles) {
+    char* fontPath = stylePaths[s.style];
+    snprintf(fontPath, sizeof(stylePaths[s.style]), "%s/%s/%s", CONFIG_FONTS_DIR, familyName, s.filename);
+
+    if (!SdMan.exists(fontPath)) {
+      if (s.style == EpdFontFamily::REGULAR) {
+        LOG_ERR(TAG, "Custom font '%s': missing required file regular.epdfont in %s/%s", familyName,
+                CONFIG_FONTS_DIR, familyName);
+        return 0;  // Regular is required
+      }
+      fontPath[0] = '\0';
+      continue;
+    }
+
+    const uint32_t styleFingerprint = papyrix::fileFingerprint(fontPath);
+    if (styleFingerprint == 0) {
+      LOG_ERR(TAG, "Failed to fingerprint font file: %s", fontPath);
+      return 0;
+    }
+    const uint8_t style = static_cast<uint8_t>(s.style);
+    fingerprint = updateFontFingerprint(fingerprint, &style, sizeof(style));
+    fingerprint = updateFontFingerprint(fingerprint, &styleFingerprint, sizeof(styleFingerprint));
+  }
+  return fingerprint;
+}
 }  // namespace
 
 FontManager& FontManager::instance() {
@@ -74,41 +116,13 @@ bool FontManager::loadFontFamily(const char* familyName, int fontId) {
     return false;
   }
 
-  struct StyleInfo {
-    const char* filename;
-    EpdFontFamily::Style style;
-  };
-  const StyleInfo styles[] = {{"regular.epdfont", EpdFontFamily::REGULAR}, {"bold.epdfont", EpdFontFamily::BOLD}};
-
   LoadedFamily family;
   family.fontId = fontId;
-  family.fingerprint = builtinFontFingerprint(fontId);
-
   char stylePaths[3][80] = {};
-  for (const auto& s : styles) {
-    char* fontPath = stylePaths[s.style];
-    snprintf(fontPath, sizeof(stylePaths[s.style]), "%s/%s", basePath, s.filename);
+  family.fingerprint = customFamilyFingerprint(familyName, fontId, stylePaths);
+  if (family.fingerprint == 0) return false;
 
-    if (!SdMan.exists(fontPath)) {
-      if (s.style == EpdFontFamily::REGULAR) {
-        LOG_ERR(TAG, "Custom font '%s': missing required file regular.epdfont in %s", familyName, basePath);
-        return false;  // Regular is required
-      }
-      fontPath[0] = '\0';
-      continue;
-    }
-
-    const uint32_t styleFingerprint = papyrix::fileFingerprint(fontPath);
-    if (styleFingerprint == 0) {
-      LOG_ERR(TAG, "Failed to fingerprint font file: %s", fontPath);
-      return false;
-    }
-    const uint8_t style = static_cast<uint8_t>(s.style);
-    family.fingerprint = updateFontFingerprint(family.fingerprint, &style, sizeof(style));
-    family.fingerprint = updateFontFingerprint(family.fingerprint, &styleFingerprint, sizeof(styleFingerprint));
-  }
-
-  for (const auto& s : styles) {
+  for (const auto& s : kStyleFiles) {
     const char* fontPath = stylePaths[s.style];
     if (!*fontPath) continue;
 
@@ -340,6 +354,20 @@ int FontManager::getFontId(const char* familyName, int builtinFontId) {
   return builtinFontId;
 }
 
+uint32_t FontManager::readerFontFingerprint(const char* familyName, const int builtinFontId) {
+  if (!familyName || !*familyName) return builtinFontFingerprint(builtinFontId);
+  if (isBinFont(familyName)) {
+    char path[80];
+    snprintf(path, sizeof(path), "%s/%s", CONFIG_FONTS_DIR, familyName);
+    const uint32_t fileSignature = SdMan.exists(path) ? papyrix::fileFingerprint(path) : 0;
+    return fileSignature == 0 ? 0 : binFontFingerprint(builtinFontId, familyName, fileSignature);
+  }
+  char stylePaths[3][80] = {};
+  const uint32_t fingerprint = customFamilyFingerprint(familyName, generateFontId(familyName), stylePaths);
+  // getReaderFontId() falls back to the built-in font when the family is missing
+  return fingerprint != 0 ? fingerprint : builtinFontFingerprint(builtinFontId);
+}
+
 int FontManager::generateFontId(const char* familyName) {
   // Simple hash for consistent font IDs
   uint32_t hash = 5381;
@@ -390,9 +418,7 @@ int FontManager::getReaderFontId(const char* familyName, int builtinFontId) {
     if (fileSignature == 0) {
       LOG_WRN(TAG, "External font fingerprint unavailable; using session cache ID for %s", path);
     }
-    _activeReaderFontFingerprint = updateFontFingerprint(builtinFingerprint, familyName, strlen(familyName));
-    _activeReaderFontFingerprint =
-        updateFontFingerprint(_activeReaderFontFingerprint, &cacheSignature, sizeof(cacheSignature));
+    _activeReaderFontFingerprint = binFontFingerprint(builtinFontId, familyName, cacheSignature);
     strncpy(_activeBinFontName, familyName, sizeof(_activeBinFontName) - 1);
     _activeBinFontName[sizeof(_activeBinFontName) - 1] = '\0';
     _activeBinBuiltinFontId = builtinFontId;
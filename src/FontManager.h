@@ -89,6 +89,13 @@ class FontManager {
    */
   int getReaderFontId(const char* familyName, int builtinFontId);
 
+  /**
+   * Fingerprint getReaderFontId() would give this font, from its files on the
+   * SD card without loading it. Usable before init(), e.g. at boot.
+   * @return 0 when an external (.bin) font file cannot be fingerprinted
+   */
+  static uint32_t readerFontFingerprint(const char* familyName, int builtinFontId);
+
   /**
    * Generate a unique font ID for a family name.
    * Uses hash of the name for consistency.
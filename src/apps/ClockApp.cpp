@@ -243,6 +243,8 @@ bool update(Core& core) {
       core.cpu.unthrottle();
       return true;
     }
+    // Wake the main loop right at the next minute
+    core.scheduler.arm(LoopScheduler::Timer::Clock, now + (60 - timeinfo.tm_sec % 60) * 1000UL);
   } else if (now - state.lastNtpSyncMs >= 10000) {
     // No time yet — refresh periodically so display updates after NTP sync
     core.cpu.unthrottle();
@@ -394,6 +396,7 @@ bool render(Core& core) {
 }
 
 void exit(Core& core) {
+  core.scheduler.disarm(LoopScheduler::Timer::Clock);
   core.cpu.unthrottle();
   renderer.clearScreen(THEME.backgroundColor);
   renderer.displayBuffer(EInkDisplay::HALF_REFRESH);
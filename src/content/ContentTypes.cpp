@@ -27,6 +27,10 @@ ContentType detectContentType(const char* path) {
   if (strcasecmp(ext, ".fb2") == 0) {
     return ContentType::Fb2;
   }
+  // Zipped FB2, read in place (any other .zip is not a book)
+  if (strcasecmp(ext, ".zip") == 0 && ext - path >= 4 && strncasecmp(ext - 4, ".fb2", 4) == 0) {
+    return ContentType::Fb2;
+  }
   if (strcasecmp(ext, ".html") == 0 || strcasecmp(ext, ".htm") == 0) {
     return ContentType::Html;
   }
@@ -82,11 +82,6 @@ int Fb2Provider::getSectionCount() const {
   return fb2->getSectionCount();
 }
 
-std::string Fb2Provider::getSectionPath(int sectionIndex) const {
-  if (!fb2) return "";
-  return fb2->getSectionPath(sectionIndex);
-}
-
 std::string Fb2Provider::getSectionCachePath(int sectionIndex) const {
   if (!fb2) return "";
   return fb2->getCachePath() + "/pages_" + std::to_string(sectionIndex) + ".bin";
@@ -34,7 +34,6 @@ struct Fb2Provider {
 
   // Section (spine) access for per-section caching
   int getSectionCount() const;
-  std::string getSectionPath(int sectionIndex) const;
   std::string getSectionCachePath(int sectionIndex) const;
   int getSectionForTocEntry(int tocIndex) const;
 
@@ -37,7 +37,7 @@ void fillEstimates(std::vector<Section>& metrics, size_t bytesPerPage) {
   }
 }
 
-void recalibrate(std::vector<Section>& metrics) {
+size_t learnedBytesPerPage(const std::vector<Section>& metrics) {
   uint64_t calibrationBytes = 0;
   uint64_t calibrationPages = 0;
   for (const auto& metric : metrics) {
@@ -46,9 +46,14 @@ void recalibrate(std::vector<Section>& metrics) {
       calibrationPages += metric.pages;
     }
   }
-  if (calibrationPages == 0) return;
+  if (calibrationPages == 0) return 0;
+  return static_cast<size_t>(std::max<uint64_t>(256, calibrationBytes / calibrationPages));
+}
+
+void recalibrate(std::vector<Section>& metrics) {
+  const size_t bytesPerPage = learnedBytesPerPage(metrics);
+  if (bytesPerPage == 0) return;
 
-  const size_t bytesPerPage = static_cast<size_t>(std::max<uint64_t>(256, calibrationBytes / calibrationPages));
   for (auto& metric : metrics) {
     if (metric.exact || metric.byteSize == 0) continue;
     metric.pages = estimatePagesForBytes(metric.byteSize, bytesPerPage);
@@ -28,6 +28,8 @@ struct Update {
 uint32_t estimatePagesForBytes(size_t bytes, size_t bytesPerPage = kEstimatedBytesPerPage);
 Update applyCache(Section& metric, uint32_t pageCount, bool partial);
 void fillEstimates(std::vector<Section>& metrics, size_t bytesPerPage = kEstimatedBytesPerPage);
+// Source bytes per laid-out page over the exact sections; 0 until one has pages
+size_t learnedBytesPerPage(const std::vector<Section>& metrics);
 void recalibrate(std::vector<Section>& metrics);
 uint32_t total(const std::vector<Section>& metrics);
 Display resolve(const std::vector<Section>& metrics, int currentSpineIndex, int currentSectionPage,
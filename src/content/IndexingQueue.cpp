@@ -0,0 +1,29 @@
+#include "IndexingQueue.h"
+
+namespace papyrix {
+
+int IndexingQueue::next(const std::vector<page_metrics::Section>& metrics, const int readerSection) const {
+  const int count = static_cast<int>(metrics.size());
+  if (count == 0) return -1;
+
+  // Sections ahead of the reader first: that is where the next TOC jumps and page numbers are
+  const int start = readerSection >= 0 && readerSection < count ? readerSection + 1 : 0;
+  for (int step = 0; step < count; step++) {
+    const int section = (start + step) % count;
+    if (section == readerSection || skipped(section)) continue;
+    if (!metrics[static_cast<size_t>(section)].exact) return section;
+  }
+  return -1;
+}
+
+void IndexingQueue::skip(const int section) {
+  if (section < 0) return;
+  if (static_cast<size_t>(section) >= skipped_.size()) skipped_.resize(static_cast<size_t>(section) + 1, false);
+  skipped_[static_cast<size_t>(section)] = true;
+}
+
+bool IndexingQueue::skipped(const int section) const {
+  return section >= 0 && static_cast<size_t>(section) < skipped_.size() && skipped_[static_cast<size_t>(section)];
+}
+
+}  // namespace papyrix
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include "GlobalPageMetrics.h"
+
+namespace papyrix {
+
+// Idle-time whole-book pagination for sectioned books (EPUB spine items, FB2
+// sections). The pending set is the sections metrics.bin does not mark exact,
+// and a section cut short keeps its partial cache on disk, so the queue picks
+// up where it stopped after sleep or a reboot. Decision-only: ReaderState's
+// cache task does the parsing.
+class IndexingQueue {
+ public:
+  // Forget skipped sections, e.g. for the next book
+  void clear() { skipped_.clear(); }
+
+  // Next section to paginate: the first pending one after readerSection, then
+  // from the start of the book. readerSection belongs to the reader's own cache
+  // and is never returned. -1 when nothing is left.
+  int next(const std::vector<page_metrics::Section>& metrics, int readerSection) const;
+
+  // A section that failed to paginate is not tried again until clear()
+  void skip(int section);
+  bool skipped(int section) const;
+
+ private:
+  std::vector<bool> skipped_;
+};
+
+}  // namespace papyrix
@@ -0,0 +1,491 @@
+#include "LibraryStore.h"
+
+#include <FsHelpers.h>
+#include <Logging.h>
+#include <SDCardManager.h>
+
+#include <algorithm>
+#include <cstring>
+
+#define TAG "LIBRARY"
+
+namespace papyrix {
+
+namespace {
+constexpr char LIBRARY_FILE[] = "/.papyrix/library.bin";
+constexpr char LIBRARY_TMP[] = "/.papyrix/library.bin.tmp";
+constexpr char MAGIC[4] = {'P', 'L', 'I', 'B'};
+constexpr uint32_t INITIAL_CAPACITY = 256;
+constexpr uint32_t MAX_CAPACITY = 1u << 20;
+// Heap garbage tolerated before a rewrite compacts it
+constexpr uint32_t MIN_COMPACT_GARBAGE = 16 * 1024;
+// Title index entries moved per read/write
+constexpr uint32_t INDEX_BATCH = 64;
+// Slots read at once by a directory scan
+constexpr uint32_t SLOT_BATCH = 32;
+constexpr uint8_t SLOT_EMPTY = 0;
+constexpr uint8_t SLOT_USED = 1;
+constexpr uint8_t SLOT_DELETED = 2;
+
+uint64_t pathHash(const std::string& path) {
+  uint64_t hash = 1469598103934665603ULL;
+  for (const char c : path) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+bool readExact(FsFile& file, void* data, size_t length) {
+  return file.read(static_cast<uint8_t*>(data), length) == static_cast<int>(length);
+}
+
+bool writeExact(FsFile& file, const void* data, size_t length) {
+  return file.write(static_cast<const uint8_t*>(data), length) == length;
+}
+
+bool zeroFill(FsFile& file, uint32_t length) {
+  const uint8_t zeros[256] = {};
+  while (length > 0) {
+    const uint32_t chunk = std::min<uint32_t>(length, sizeof(zeros));
+    if (!writeExact(file, zeros, chunk)) return false;
+    length -= chunk;
+  }
+  return true;
+}
+
+// Cut at a character boundary so a capped title stays valid UTF-8
+std::string capText(const std::string& value) {
+  if (value.size() <= LibraryStore::MAX_TEXT_BYTES) return value;
+  size_t length = LibraryStore::MAX_TEXT_BYTES;
+  while (length > 0 && (static_cast<uint8_t>(value[length]) & 0xC0) == 0x80) length--;
+  return value.substr(0, length);
+}
+
+uint32_t stringBytes(const std::string& value) { return static_cast<uint32_t>(sizeof(uint16_t) + value.size()); }
+
+bool writeString(FsFile& file, const std::string& value) {
+  const uint16_t length = static_cast<uint16_t>(value.size());
+  return writeExact(file, &length, sizeof(length)) && (length == 0 || writeExact(file, value.data(), length));
+}
+
+// Title, then author, then slot so every row has one position
+int compareKeys(const std::string& leftTitle, const std::string& leftAuthor, uint32_t leftSlot,
+                const std::string& rightTitle, const std::string& rightAuthor, uint32_t rightSlot) {
+  int result = FsHelpers::naturalCompare(leftTitle.c_str(), rightTitle.c_str());
+  if (result == 0) result = FsHelpers::naturalCompare(leftAuthor.c_str(), rightAuthor.c_str());
+  if (result == 0 && leftSlot != rightSlot) result = leftSlot < rightSlot ? -1 : 1;
+  return result;
+}
+
+// "/books" and "/books/" both cover "/books/a.epub" but not "/books2/a.epub"
+std::string directoryPrefix(const std::string& dir) {
+  return !dir.empty() && dir.back() == '/' ? dir : dir + '/';
+}
+}  // namespace
+
+LibraryStore& LibraryStore::instance() {
+  static LibraryStore inst;
+  return inst;
+}
+
+uint32_t LibraryStore::slotOffset(const uint32_t slot) {
+  return static_cast<uint32_t>(sizeof(Header) + slot * sizeof(Slot));
+}
+
+uint32_t LibraryStore::indexOffset(const uint32_t capacity, const uint32_t position) {
+  return slotOffset(capacity) + position * static_cast<uint32_t>(sizeof(uint32_t));
+}
+
+uint32_t LibraryStore::heapOffset(const uint32_t capacity) { return indexOffset(capacity, capacity); }
+
+bool LibraryStore::readSlot(FsFile& file, const uint32_t slot, Slot& out) {
+  return file.seekSet(slotOffset(slot)) && readExact(file, &out, sizeof(out));
+}
+
+bool LibraryStore::readString(FsFile& file, const Header& header, const uint32_t ref, std::string& out) {
+  uint16_t length = 0;
+  if (ref > header.heapSize || header.heapSize - ref < sizeof(length)) return false;
+  if (!file.seekSet(heapOffset(header.capacity) + ref) || !readExact(file, &length, sizeof(length))) return false;
+  if (length > MAX_PATH_BYTES || header.heapSize - ref - sizeof(length) < length) return false;
+  out.resize(length);
+  return length == 0 || readExact(file, &out[0], length);
+}
+
+bool LibraryStore::writeSlot(const uint32_t slot, const Slot& value) {
+  return file_.seekSet(slotOffset(slot)) && writeExact(file_, &value, sizeof(value));
+}
+
+bool LibraryStore::appendString(const std::string& value, uint32_t& ref) {
+  ref = header_.heapSize;
+  if (!file_.seekSet(heapOffset(header_.capacity) + ref) || !writeString(file_, value)) return false;
+  header_.heapSize += stringBytes(value);
+  return true;
+}
+
+bool LibraryStore::writeHeader() {
+  return file_.seekSet(0) && writeExact(file_, &header_, sizeof(header_)) && file_.sync();
+}
+
+bool LibraryStore::readIndex(const uint32_t position, uint32_t& slot) {
+  return position < header_.count && file_.seekSet(indexOffset(header_.capacity, position)) &&
+         readExact(file_, &slot, sizeof(slot)) && slot < header_.capacity;
+}
+
+bool LibraryStore::ensureOpen(const bool create) {
+  if (opened_) return true;
+  if (SdMan.exists(LIBRARY_FILE)) {
+    file_ = SdMan.open(LIBRARY_FILE, O_RDWR);
+    if (file_ && readExact(file_, &header_, sizeof(header_)) && validHeader()) {
+      opened_ = true;
+      return true;
+    }
+    LOG_ERR(TAG, "Library database unreadable; dropping it");
+    close();
+    SdMan.remove(LIBRARY_FILE);
+  }
+  return create && rewrite(INITIAL_CAPACITY);
+}
+
+bool LibraryStore::validHeader() {
+  const uint32_t capacity = header_.capacity;
+  if (memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0 || header_.version != FILE_VERSION) return false;
+  if (capacity < INITIAL_CAPACITY || capacity > MAX_CAPACITY || (capacity & (capacity - 1)) != 0) return false;
+  if (header_.count > header_.used || header_.used >= capacity || header_.garbage > header_.heapSize) return false;
+  return file_.size() >= static_cast<size_t>(heapOffset(capacity)) + header_.heapSize;
+}
+
+bool LibraryStore::fail(const char* what) {
+  LOG_ERR(TAG, "Failed to %s; dropping library database", what);
+  close();
+  SdMan.remove(LIBRARY_FILE);
+  return false;
+}
+
+bool LibraryStore::rewrite(const uint32_t capacity) {
+  SdMan.mkdir("/.papyrix");
+  FsFile out = SdMan.open(LIBRARY_TMP, O_RDWR | O_CREAT | O_TRUNC);
+  if (!out) {
+    LOG_ERR(TAG, "Failed to open %s for write", LIBRARY_TMP);
+    return false;
+  }
+
+  Header header{};
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = FILE_VERSION;
+  header.capacity = capacity;
+  bool ok = writeExact(out, &header, sizeof(header)) && zeroFill(out, heapOffset(capacity) - sizeof(header));
+
+  // Walking the old title index writes the new one in order and leaves the heap garbage behind
+  const uint32_t count = opened_ ? header_.count : 0;
+  const uint32_t mask = capacity - 1;
+  std::string path, title, author;
+  Slot slot{};
+  Slot probe{};
+  for (uint32_t position = 0; ok && position < count; position++) {
+    uint32_t oldSlot = 0;
+    ok = readIndex(position, oldSlot) && readSlot(file_, oldSlot, slot) && slot.state == SLOT_USED &&
+         readString(file_, header_, slot.pathRef, path) && readString(file_, header_, slot.titleRef, title) &&
+         readString(file_, header_, slot.authorRef, author);
+    if (!ok) break;
+
+    slot.pathRef = header.heapSize;
+    slot.titleRef = slot.pathRef + stringBytes(path);
+    slot.authorRef = slot.titleRef + stringBytes(title);
+    header.heapSize = slot.authorRef + stringBytes(author);
+    ok = out.seekSet(heapOffset(capacity) + slot.pathRef) && writeString(out, path) && writeString(out, title) &&
+         writeString(out, author);
+
+    uint32_t newSlot = static_cast<uint32_t>(slot.pathHash) & mask;
+    while (ok) {
+      ok = readSlot(out, newSlot, probe);
+      if (probe.state == SLOT_EMPTY) break;
+      newSlot = (newSlot + 1) & mask;
+    }
+    ok = ok && out.seekSet(slotOffset(newSlot)) && writeExact(out, &slot, sizeof(slot)) &&
+         out.seekSet(indexOffset(capacity, position)) && writeExact(out, &newSlot, sizeof(newSlot));
+    header.count++;
+  }
+
+  header.used = header.count;
+  ok = ok && out.seekSet(0) && writeExact(out, &header, sizeof(header)) && out.sync();
+  out.close();
+  close();
+  if (!ok || !SdMan.commitFile(LIBRARY_TMP, LIBRARY_FILE)) {
+    LOG_ERR(TAG, "Failed to rewrite library database");
+    SdMan.remove(LIBRARY_TMP);
+    SdMan.remove(LIBRARY_FILE);
+    return false;
+  }
+
+  LOG_DBG(TAG, "Rewrote library: %u books, capacity %u", static_cast<unsigned>(header.count),
+          static_cast<unsigned>(capacity));
+  return ensureOpen(false);
+}
+
+bool LibraryStore::locate(const std::string& path, const uint64_t hash, uint32_t& found, uint32_t& freeSlot,
+                          Slot& slot) {
+  found = NO_SLOT;
+  freeSlot = NO_SLOT;
+  const uint32_t mask = header_.capacity - 1;
+  std::string stored;
+  uint32_t index = static_cast<uint32_t>(hash) & mask;
+  for (uint32_t probes = 0; probes < header_.capacity; probes++, index = (index + 1) & mask) {
+    if (!readSlot(file_, index, slot)) return false;
+    if (slot.state != SLOT_USED) {
+      if (freeSlot == NO_SLOT) freeSlot = index;
+      if (slot.state == SLOT_EMPTY) return true;
+      continue;
+    }
+    if (slot.pathHash != hash) continue;
+    if (!readString(file_, header_, slot.pathRef, stored)) return false;
+    if (stored == path) {
+      found = index;
+      return true;
+    }
+  }
+  return true;
+}
+
+bool LibraryStore::indexPosition(const std::string& title, const std::string& author, const uint32_t slot,
+                                 uint32_t& position) {
+  uint32_t low = 0;
+  uint32_t high = header_.count;
+  Slot candidate{};
+  std::string candidateTitle, candidateAuthor;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    uint32_t candidateSlot = 0;
+    if (!readIndex(mid, candidateSlot) || !readSlot(file_, candidateSlot, candidate) ||
+        !readString(file_, header_, candidate.titleRef, candidateTitle) ||
+        !readString(file_, header_, candidate.authorRef, candidateAuthor)) {
+      return false;
+    }
+    if (compareKeys(candidateTitle, candidateAuthor, candidateSlot, title, author, slot) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  position = low;
+  return true;
+}
+
+bool LibraryStore::insertIndex(const uint32_t position, const uint32_t slot) {
+  uint32_t batch[INDEX_BATCH];
+  uint32_t end = header_.count;
+  while (end > position) {
+    const uint32_t moved = std::min(end - position, INDEX_BATCH);
+    const uint32_t start = end - moved;
+    const size_t bytes = moved * sizeof(uint32_t);
+    if (!file_.seekSet(indexOffset(header_.capacity, start)) || !readExact(file_, batch, bytes) ||
+        !file_.seekSet(indexOffset(header_.capacity, start + 1)) || !writeExact(file_, batch, bytes)) {
+      return false;
+    }
+    end = start;
+  }
+  if (!file_.seekSet(indexOffset(header_.capacity, position)) || !writeExact(file_, &slot, sizeof(slot))) return false;
+  header_.count++;
+  return true;
+}
+
+bool LibraryStore::eraseIndex(const uint32_t position) {
+  uint32_t batch[INDEX_BATCH];
+  uint32_t start = position + 1;
+  while (start < header_.count) {
+    const uint32_t moved = std::min(header_.count - start, INDEX_BATCH);
+    const size_t bytes = moved * sizeof(uint32_t);
+    if (!file_.seekSet(indexOffset(header_.capacity, start)) || !readExact(file_, batch, bytes) ||
+        !file_.seekSet(indexOffset(header_.capacity, start - 1)) || !writeExact(file_, batch, bytes)) {
+      return false;
+    }
+    start += moved;
+  }
+  header_.count--;
+  return true;
+}
+
+bool LibraryStore::unindex(const uint32_t slot, const std::string& title, const std::string& author) {
+  uint32_t position = 0;
+  uint32_t indexed = NO_SLOT;
+  return indexPosition(title, author, slot, position) && readIndex(position, indexed) && indexed == slot &&
+         eraseIndex(position);
+}
+
+bool LibraryStore::maybeCompact() {
+  if (header_.garbage < MIN_COMPACT_GARBAGE || header_.garbage * 2 < header_.heapSize) return true;
+  return rewrite(header_.capacity);
+}
+
+bool LibraryStore::find(const std::string& path, Entry& out) {
+  if (path.empty() || path.size() > MAX_PATH_BYTES || !ensureOpen(false)) return false;
+  uint32_t found = NO_SLOT;
+  uint32_t freeSlot = NO_SLOT;
+  Slot slot{};
+  if (!locate(path, pathHash(path), found, freeSlot, slot) || found == NO_SLOT) return false;
+  if (!readString(file_, header_, slot.titleRef, out.title) ||
+      !readString(file_, header_, slot.authorRef, out.author)) {
+    return false;
+  }
+  out.progress = slot.progress;
+  return true;
+}
+
+bool LibraryStore::update(const std::string& path, const std::string& rawTitle, const std::string& rawAuthor) {
+  if (path.empty() || path.size() > MAX_PATH_BYTES || !ensureOpen(true)) return false;
+  const std::string title = capText(rawTitle);
+  const std::string author = capText(rawAuthor);
+  const uint64_t hash = pathHash(path);
+  uint32_t found = NO_SLOT;
+  uint32_t freeSlot = NO_SLOT;
+  Slot slot{};
+  if (!locate(path, hash, found, freeSlot, slot)) return fail("look up book");
+
+  if (found != NO_SLOT) {
+    std::string oldTitle, oldAuthor;
+    if (!readString(file_, header_, slot.titleRef, oldTitle) ||
+        !readString(file_, header_, slot.authorRef, oldAuthor)) {
+      return fail("read book");
+    }
+    if (oldTitle == title && oldAuthor == author) return true;
+    if (!unindex(found, oldTitle, oldAuthor)) return fail("unindex book");
+    header_.garbage += stringBytes(oldTitle) + stringBytes(oldAuthor);
+  } else {
+    if ((header_.used + 1) * 4 > header_.capacity * 3) {
+      // Rewriting also clears tombstones, so size for the live books
+      uint32_t capacity = header_.capacity;
+      while ((header_.count + 1) * 2 > capacity) capacity *= 2;
+      if (capacity > MAX_CAPACITY) {
+        LOG_ERR(TAG, "Library database is full");
+        return false;
+      }
+      if (!rewrite(capacity)) return false;
+      if (!locate(path, hash, found, freeSlot, slot)) return fail("look up book");
+    }
+    Slot previous{};
+    if (freeSlot == NO_SLOT || !readSlot(file_, freeSlot, previous)) return fail("find a free slot");
+    if (previous.state == SLOT_EMPTY) header_.used++;
+    found = freeSlot;
+    slot = Slot{};
+    slot.pathHash = hash;
+    slot.state = SLOT_USED;
+    slot.progress = NO_PROGRESS;
+    if (!appendString(path, slot.pathRef)) return fail("store path");
+  }
+
+  uint32_t position = 0;
+  if (!appendString(title, slot.titleRef) || !appendString(author, slot.authorRef) || !writeSlot(found, slot) ||
+      !indexPosition(title, author, found, position) || !insertIndex(position, found) || !writeHeader()) {
+    return fail("store book");
+  }
+  return maybeCompact();
+}
+
+bool LibraryStore::setProgress(const std::string& path, const uint8_t percent) {
+  if (path.empty() || path.size() > MAX_PATH_BYTES || !ensureOpen(false)) return false;
+  uint32_t found = NO_SLOT;
+  uint32_t freeSlot = NO_SLOT;
+  Slot slot{};
+  if (!locate(path, pathHash(path), found, freeSlot, slot)) return fail("look up book");
+  if (found == NO_SLOT) return false;
+
+  const uint8_t progress = std::min<uint8_t>(percent, 100);
+  if (slot.progress == progress) return true;
+  slot.progress = progress;
+  if (!writeSlot(found, slot) || !file_.sync()) return fail("store progress");
+  return true;
+}
+
+bool LibraryStore::remove(const std::string& path) {
+  if (path.empty() || path.size() > MAX_PATH_BYTES || !ensureOpen(false)) return true;
+  uint32_t found = NO_SLOT;
+  uint32_t freeSlot = NO_SLOT;
+  Slot slot{};
+  if (!locate(path, pathHash(path), found, freeSlot, slot)) return fail("look up book");
+  if (found == NO_SLOT) return true;
+
+  std::string title, author;
+  if (!readString(file_, header_, slot.titleRef, title) || !readString(file_, header_, slot.authorRef, author) ||
+      !unindex(found, title, author)) {
+    return fail("unindex book");
+  }
+  slot.state = SLOT_DELETED;
+  header_.garbage += stringBytes(path) + stringBytes(title) + stringBytes(author);
+  if (!writeSlot(found, slot) || !writeHeader()) return fail("remove book");
+  return maybeCompact();
+}
+
+bool LibraryStore::rename(const std::string& oldPath, const std::string& newPath) {
+  if (oldPath == newPath) return true;
+  Entry entry;
+  const bool known = find(oldPath, entry);
+  // Whatever was stored under the new path belonged to the file it replaced
+  if (!remove(newPath)) return false;
+  if (!known) return true;
+  return remove(oldPath) && update(newPath, entry.title, entry.author) &&
+         (entry.progress == NO_PROGRESS || setProgress(newPath, entry.progress));
+}
+
+bool LibraryStore::pathsUnder(const std::string& dir, std::vector<std::string>& out) {
+  const std::string prefix = directoryPrefix(dir);
+  Slot batch[SLOT_BATCH];
+  std::string path;
+  for (uint32_t first = 0; first < header_.capacity; first += SLOT_BATCH) {
+    const uint32_t slots = std::min(header_.capacity - first, SLOT_BATCH);
+    if (!file_.seekSet(slotOffset(first)) || !readExact(file_, batch, slots * sizeof(Slot))) return false;
+    for (uint32_t i = 0; i < slots; i++) {
+      if (batch[i].state != SLOT_USED) continue;
+      if (!readString(file_, header_, batch[i].pathRef, path)) return false;
+      if (path.compare(0, prefix.size(), prefix) == 0) out.push_back(path);
+    }
+  }
+  return true;
+}
+
+bool LibraryStore::removeDirectory(const std::string& dir) {
+  if (dir.empty() || !ensureOpen(false)) return true;
+  std::vector<std::string> paths;
+  if (!pathsUnder(dir, paths)) return fail("scan directory");
+  for (const auto& path : paths) {
+    if (!remove(path)) return false;
+  }
+  return true;
+}
+
+bool LibraryStore::renameDirectory(const std::string& oldDir, const std::string& newDir) {
+  if (oldDir.empty() || oldDir == newDir || !ensureOpen(false)) return true;
+  std::vector<std::string> paths;
+  if (!pathsUnder(oldDir, paths)) return fail("scan directory");
+  const std::string oldPrefix = directoryPrefix(oldDir);
+  const std::string newPrefix = directoryPrefix(newDir);
+  for (const auto& path : paths) {
+    const std::string newPath = newPrefix + path.substr(oldPrefix.size());
+    // Too long under the new name: the book is read again on first open
+    if (newPath.size() > MAX_PATH_BYTES ? !remove(path) : !rename(path, newPath)) return false;
+  }
+  return true;
+}
+
+size_t LibraryStore::size() { return ensureOpen(false) ? header_.count : 0; }
+
+bool LibraryStore::entryByTitle(const size_t index, std::string& path, Entry& out) {
+  if (!ensureOpen(false) || index >= header_.count) return false;
+  uint32_t slotNumber = 0;
+  Slot slot{};
+  if (!readIndex(static_cast<uint32_t>(index), slotNumber) || !readSlot(file_, slotNumber, slot) ||
+      slot.state != SLOT_USED || !readString(file_, header_, slot.pathRef, path) ||
+      !readString(file_, header_, slot.titleRef, out.title) ||
+      !readString(file_, header_, slot.authorRef, out.author)) {
+    return false;
+  }
+  out.progress = slot.progress;
+  return true;
+}
+
+void LibraryStore::close() {
+  if (file_) file_.close();
+  opened_ = false;
+  header_ = {};
+}
+
+}  // namespace papyrix
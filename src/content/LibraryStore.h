@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SdFat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace papyrix {
+
+/**
+ * Library-wide book metadata kept in one file on the SD card, so lists can
+ * show titles, authors and progress without opening each book's cache.
+ *
+ * File /.papyrix/library.bin:
+ *   Header, slot table (capacity fixed-size records, open addressing on the
+ *   path hash), title index (capacity u32 slot numbers, the first count
+ *   sorted by title then author), then a string heap of {u16 length, bytes}.
+ * Looking up a path reads one slot in the common case plus its strings.
+ * Changes are patched in place; the file is only rewritten when the table
+ * grows or most of the heap is garbage. The store is a cache: a file that
+ * fails validation or a failed patch is dropped and refilled as books open.
+ */
+class LibraryStore {
+ public:
+  static constexpr uint8_t FILE_VERSION = 1;
+  static constexpr uint8_t NO_PROGRESS = 0xFF;
+  static constexpr size_t MAX_TEXT_BYTES = 255;
+  static constexpr size_t MAX_PATH_BYTES = 1023;
+
+  struct Entry {
+    std::string title;
+    std::string author;
+    uint8_t progress = NO_PROGRESS;
+  };
+
+  static LibraryStore& instance();
+
+  bool find(const std::string& path, Entry& out);
+  // Adds or replaces title and author; stored progress is kept
+  bool update(const std::string& path, const std::string& title, const std::string& author);
+  bool setProgress(const std::string& path, uint8_t percent);
+  // Both return true when there was nothing to change
+  bool remove(const std::string& path);
+  bool rename(const std::string& oldPath, const std::string& newPath);
+  // Same for every book below a deleted or renamed directory
+  bool removeDirectory(const std::string& dir);
+  bool renameDirectory(const std::string& oldDir, const std::string& newDir);
+
+  size_t size();
+  bool entryByTitle(size_t index, std::string& path, Entry& out);
+  void close();
+
+ private:
+  LibraryStore() = default;
+
+#pragma pack(push, 1)
+  struct Header {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t used;  // live slots plus tombstones
+    uint32_t heapSize;
+    uint32_t garbage;
+  };
+
+  struct Slot {
+    uint64_t pathHash;
+    uint32_t pathRef;
+    uint32_t titleRef;
+    uint32_t authorRef;
+    uint8_t state;
+    uint8_t progress;
+    uint16_t reserved;
+  };
+#pragma pack(pop)
+
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+  bool ensureOpen(bool create);
+  bool validHeader();
+  bool rewrite(uint32_t capacity);
+  bool fail(const char* what);
+
+  static uint32_t slotOffset(uint32_t slot);
+  static uint32_t indexOffset(uint32_t capacity, uint32_t position);
+  static uint32_t heapOffset(uint32_t capacity);
+  static bool readSlot(FsFile& file, uint32_t slot, Slot& out);
+  static bool readString(FsFile& file, const Header& header, uint32_t ref, std::string& out);
+
+  bool writeSlot(uint32_t slot, const Slot& value);
+  bool appendString(const std::string& value, uint32_t& ref);
+  bool writeHeader();
+  bool readIndex(uint32_t position, uint32_t& slot);
+  bool locate(const std::string& path, uint64_t hash, uint32_t& found, uint32_t& freeSlot, Slot& slot);
+  bool pathsUnder(const std::string& dir, std::vector<std::string>& out);
+  bool indexPosition(const std::string& title, const std::string& author, uint32_t slot, uint32_t& position);
+  bool insertIndex(uint32_t position, uint32_t slot);
+  bool eraseIndex(uint32_t position);
+  bool unindex(uint32_t slot, const std::string& title, const std::string& author);
+  bool maybeCompact();
+
+  FsFile file_;
+  Header header_{};
+  bool opened_ = false;
+};
+
+}  // namespace papyrix
+
+#define LIBRARY papyrix::LibraryStore::instance()
@@ -45,6 +45,7 @@ Result<void> MarkdownProvider::open(const char* path, const char* cacheDir) {
 void MarkdownProvider::close() {
   markdown.reset();
   meta.clear();
+  toc.clear();
 }
 
 uint32_t MarkdownProvider::pageCount() const {
@@ -56,4 +57,19 @@ uint32_t MarkdownProvider::pageCount() const {
   return (fileSize + BYTES_PER_PAGE - 1) / BYTES_PER_PAGE;
 }
 
+Result<TocEntry> MarkdownProvider::getTocEntry(uint16_t index) const {
+  if (index >= toc.entries().size()) {
+    return Err<TocEntry>(Error::InvalidState);
+  }
+
+  const TextToc::Entry& item = toc.entries()[index];
+
+  TocEntry entry;
+  utf8SafeCopy(entry.title, sizeof(entry.title), item.title.c_str());
+  entry.pageIndex = item.page;
+  entry.depth = item.depth;
+
+  return Ok(entry);
+}
+
 }  // namespace papyrix
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Markdown.h>
+#include <TextToc.h>
 
 #include <memory>
 
@@ -13,6 +14,7 @@ namespace papyrix {
 struct MarkdownProvider {
   std::unique_ptr<Markdown> markdown;
   ContentMetadata meta;
+  TextToc toc;
 
   MarkdownProvider() = default;
   ~MarkdownProvider() = default;
@@ -29,8 +31,10 @@ struct MarkdownProvider {
   void close();
 
   uint32_t pageCount() const;
-  uint16_t tocCount() const { return 0; }  // Markdown has no TOC (for now)
-  Result<TocEntry> getTocEntry(uint16_t index) const { return Err<TocEntry>(Error::InvalidState); }
+  // Chapters detected while laying out pages; page numbers belong to one layout
+  uint16_t tocCount() const { return static_cast<uint16_t>(toc.entries().size()); }
+  Result<TocEntry> getTocEntry(uint16_t index) const;
+  void loadToc(const std::string& path, const RenderConfig& config) { toc.load(path, config); }
 
   // Direct access
   Markdown* getMarkdown() { return markdown.get(); }
@@ -0,0 +1,133 @@
+#include "MetricsIndex.h"
+
+#include <Logging.h>
+#include <SDCardManager.h>
+#include <SdFat.h>
+#include <Serialization.h>
+
+#include <algorithm>
+
+#define TAG "MIDX"
+
+namespace papyrix {
+namespace metrics_index {
+
+namespace {
+// File layout: version, RenderConfig fields, bytesPerPage, entryCount,
+// then per entry: pages (u32), flags (u8, bit 0 = exact), byteSize (u32)
+constexpr uint8_t kExactFlag = 1;
+
+bool readConfig(FsFile& file, RenderConfig& config) {
+  return serialization::readPodChecked(file, config.fontId) &&
+         serialization::readPodChecked(file, config.lineCompression) &&
+         serialization::readPodChecked(file, config.indentLevel) &&
+         serialization::readPodChecked(file, config.spacingLevel) &&
+         serialization::readPodChecked(file, config.paragraphAlignment) &&
+         serialization::readPodChecked(file, config.hyphenation) &&
+         serialization::readPodChecked(file, config.showImages) &&
+         serialization::readPodChecked(file, config.viewportWidth) &&
+         serialization::readPodChecked(file, config.viewportHeight) &&
+         serialization::readPodChecked(file, config.sourceFingerprint) &&
+         serialization::readPodChecked(file, config.fontFingerprint) &&
+         serialization::readPodChecked(file, config.grayscaleImages);
+}
+
+bool writeConfig(FsFile& file, const RenderConfig& config) {
+  return serialization::writePodChecked(file, config.fontId) &&
+         serialization::writePodChecked(file, config.lineCompression) &&
+         serialization::writePodChecked(file, config.indentLevel) &&
+         serialization::writePodChecked(file, config.spacingLevel) &&
+         serialization::writePodChecked(file, config.paragraphAlignment) &&
+         serialization::writePodChecked(file, config.hyphenation) &&
+         serialization::writePodChecked(file, config.showImages) &&
+         serialization::writePodChecked(file, config.viewportWidth) &&
+         serialization::writePodChecked(file, config.viewportHeight) &&
+         serialization::writePodChecked(file, config.sourceFingerprint) &&
+         serialization::writePodChecked(file, config.fontFingerprint) &&
+         serialization::writePodChecked(file, config.grayscaleImages);
+}
+
+// Reads the whole file for this config; the section count is whatever it holds
+bool read(const std::string& sectionsDir, const RenderConfig& config, Index& out) {
+  FsFile file;
+  if (!SdMan.openFileForRead("MIDX", path(sectionsDir), file)) return false;
+
+  uint8_t version = 0;
+  RenderConfig fileConfig;
+  Index decoded;
+  uint16_t entryCount = 0;
+  bool ok = serialization::readPodChecked(file, version) && version == VERSION && readConfig(file, fileConfig) &&
+            config == fileConfig && serialization::readPodChecked(file, decoded.bytesPerPage) &&
+            serialization::readPodChecked(file, entryCount);
+  if (ok) decoded.sections.resize(entryCount);
+  for (auto& section : decoded.sections) {
+    uint8_t flags = 0;
+    ok = ok && serialization::readPodChecked(file, section.pages) && serialization::readPodChecked(file, flags) &&
+         serialization::readPodChecked(file, section.byteSize);
+    section.exact = (flags & kExactFlag) != 0;
+    if (!ok) break;
+  }
+  file.close();
+
+  if (!ok) return false;
+  out = std::move(decoded);
+  return true;
+}
+}  // namespace
+
+std::string path(const std::string& sectionsDir) { return sectionsDir + "/" + FILENAME; }
+
+bool load(const std::string& sectionsDir, const RenderConfig& config, const size_t sectionCount, Index& out) {
+  Index decoded;
+  if (!read(sectionsDir, config, decoded) || decoded.sections.size() != sectionCount) return false;
+  out = std::move(decoded);
+  return true;
+}
+
+bool save(const std::string& sectionsDir, const RenderConfig& config,
+          const std::vector<page_metrics::Section>& sections) {
+  if (sections.empty() || sections.size() > UINT16_MAX) return false;
+
+  const std::string filePath = path(sectionsDir);
+  const std::string tmpPath = filePath + ".tmp";
+  FsFile file;
+  if (!SdMan.openFileForWrite("MIDX", tmpPath, file)) return false;
+
+  const size_t learned = page_metrics::learnedBytesPerPage(sections);
+  const uint32_t bytesPerPage = static_cast<uint32_t>(learned > 0 ? learned : page_metrics::kEstimatedBytesPerPage);
+  const uint16_t entryCount = static_cast<uint16_t>(sections.size());
+  bool writeOk = serialization::writePodChecked(file, VERSION) && writeConfig(file, config) &&
+                 serialization::writePodChecked(file, bytesPerPage) && serialization::writePodChecked(file, entryCount);
+  for (const auto& section : sections) {
+    const uint8_t flags = section.exact ? kExactFlag : 0;
+    writeOk = writeOk && serialization::writePodChecked(file, section.pages) &&
+              serialization::writePodChecked(file, flags) && serialization::writePodChecked(file, section.byteSize);
+  }
+  writeOk = writeOk && file.sync();
+  file.close();
+
+  // Written next to the old file and swapped in, so a cut-off write keeps the previous counts
+  if (!writeOk || !SdMan.commitFile(tmpPath.c_str(), filePath.c_str())) {
+    SdMan.remove(tmpPath.c_str());
+    SdMan.remove(filePath.c_str());
+    return false;
+  }
+  LOG_DBG(TAG, "Saved metrics index: %u entries, %u bytes/page", entryCount, static_cast<unsigned>(bytesPerPage));
+  return true;
+}
+
+bool recordSection(const std::string& sectionsDir, const RenderConfig& config, const int sectionIndex,
+                   const uint32_t pageCount, const bool partial) {
+  Index index;
+  if (!read(sectionsDir, config, index)) return false;
+  if (sectionIndex < 0 || static_cast<size_t>(sectionIndex) >= index.sections.size()) return false;
+
+  const auto update =
+      page_metrics::applyCache(index.sections[static_cast<size_t>(sectionIndex)], pageCount, partial);
+  if (!update.changed) return true;
+  if (update.becameExact) page_metrics::recalibrate(index.sections);
+  return save(sectionsDir, config, index.sections);
+}
+
+}  // namespace metrics_index
+}  // namespace papyrix
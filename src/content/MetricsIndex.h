@@ -0,0 +1,48 @@
+#pragma once
+
+#include <RenderConfig.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GlobalPageMetrics.h"
+
+namespace papyrix {
+
+// Whole-book page counts for sectioned books (EPUB spine items, FB2 sections),
+// kept in metrics.bin next to the section caches. Each entry is exact once its
+// section cache is complete and an estimate from the learned bytes-per-page
+// ratio until then. Every section cache write folds into the file, so the book
+// total is read back without probing section files.
+namespace metrics_index {
+
+constexpr uint8_t VERSION = 6;
+constexpr char FILENAME[] = "metrics.bin";
+
+struct Index {
+  std::vector<page_metrics::Section> sections;
+  // Source bytes per page over the exact sections, kEstimatedBytesPerPage until one is exact
+  uint32_t bytesPerPage = page_metrics::kEstimatedBytesPerPage;
+};
+
+std::string path(const std::string& sectionsDir);
+
+// False when the file is missing or corrupt, or was written for another format
+// version, render config or section count. out is left untouched then.
+bool load(const std::string& sectionsDir, const RenderConfig& config, size_t sectionCount, Index& out);
+
+// Replaces the file. On failure none is left, so the next open rebuilds it.
+bool save(const std::string& sectionsDir, const RenderConfig& config,
+          const std::vector<page_metrics::Section>& sections);
+
+// Folds one section cache write into the file: a complete cache makes the
+// entry exact, a partial one raises its estimate, and the learned ratio
+// re-estimates the sections not cached yet. False when there is no index for
+// this config (the next full build picks the cache up) or the write fails.
+bool recordSection(const std::string& sectionsDir, const RenderConfig& config, int sectionIndex, uint32_t pageCount,
+                   bool partial);
+
+}  // namespace metrics_index
+}  // namespace papyrix
@@ -0,0 +1,192 @@
+#include "ResumeSnapshot.h"
+
+#include <Group5.h>
+#include <Logging.h>
+#include <SDCardManager.h>
+#include <SdFat.h>
+#include <Serialization.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "../config.h"
+#include "../core/PapyrixSettings.h"
+#include "FileFingerprint.h"
+
+#define TAG "RESUME"
+
+namespace papyrix {
+namespace resume_snapshot {
+
+namespace {
+constexpr char SNAPSHOT_FILE[] = PAPYRIX_DIR "/resume.bin";
+constexpr char SNAPSHOT_TMP[] = PAPYRIX_DIR "/resume.bin.tmp";
+constexpr uint32_t kSnapshotMagic = 0x4D535250;  // "PRSM" in little-endian files
+constexpr uint8_t kSnapshotVersion = 2;
+constexpr uint16_t kMaxRowBytes = 256;
+// The encoder checks for overflow after each line, so the buffer needs room
+// for one worst-case line past the limit (MAX_IMAGE_FLIPS codes of up to 2 bytes)
+constexpr uint32_t kLineSlack = MAX_IMAGE_FLIPS * 2;
+
+// File layout: magic, version, width, height, layoutKey, bookPath, font family,
+// built-in font ID, compressedSize, Group5 data
+struct Record {
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint32_t layoutKey = 0;
+  std::string bookPath;
+  FontSource font;
+  uint32_t compressedSize = 0;
+};
+
+bool readRecord(FsFile& file, Record& record) {
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  return serialization::readPodChecked(file, magic) && magic == kSnapshotMagic &&
+         serialization::readPodChecked(file, version) && version == kSnapshotVersion &&
+         serialization::readPodChecked(file, record.width) && serialization::readPodChecked(file, record.height) &&
+         serialization::readPodChecked(file, record.layoutKey) && serialization::readString(file, record.bookPath) &&
+         serialization::readString(file, record.font.family) &&
+         serialization::readPodChecked(file, record.font.builtinFontId) &&
+         serialization::readPodChecked(file, record.compressedSize);
+}
+
+// Fingerprint of the theme file, 0 for a built-in theme without one
+uint32_t themeFileFingerprint(const char* themeName) {
+  char path[96];
+  snprintf(path, sizeof(path), "%s/%s.theme", CONFIG_THEMES_DIR, themeName);
+  return SdMan.exists(path) ? fileFingerprint(path) : 0;
+}
+}  // namespace
+
+uint32_t layoutKey(const Settings& settings, const uint32_t fontFingerprint) {
+  using namespace file_fingerprint_detail;
+  uint32_t hash = kFnvBasis;
+  for (const uint8_t value :
+       {settings.statusBar, settings.textLayout, settings.orientation, settings.fontSize, settings.paragraphAlignment,
+        settings.hyphenation, settings.textAntiAliasing, settings.showImages, settings.lineSpacing}) {
+    hash = updateFnv1aValue(hash, value);
+  }
+  hash = updateFnv1aBytes(hash, reinterpret_cast<const uint8_t*>(settings.themeName), strlen(settings.themeName));
+  hash = updateFnv1aValue(hash, themeFileFingerprint(settings.themeName));
+  return updateFnv1aValue(hash, fontFingerprint);
+}
+
+bool save(const uint8_t* frameBuffer, const uint16_t width, const uint16_t height, const char* bookPath,
+          const FontSource& font, const uint32_t layoutKey) {
+  const uint16_t rowBytes = (width + 7) / 8;
+  if (!frameBuffer || width == 0 || height == 0 || rowBytes > kMaxRowBytes || !bookPath || !*bookPath) {
+    return false;
+  }
+
+  std::unique_ptr<uint8_t[]> compressed(new (std::nothrow) uint8_t[MAX_COMPRESSED_SIZE + kLineSlack]);
+  if (!compressed) {
+    LOG_DBG(TAG, "No RAM for snapshot (%u bytes)", static_cast<unsigned>(MAX_COMPRESSED_SIZE));
+    discard();
+    return false;
+  }
+
+  G5ENCODER encoder;
+  bool encoded = encoder.init(width, height, compressed.get(), MAX_COMPRESSED_SIZE) == G5_SUCCESS;
+  uint8_t row[kMaxRowBytes];
+  for (uint16_t y = 0; y < height && encoded; y++) {
+    memcpy(row, frameBuffer + static_cast<size_t>(y) * rowBytes, rowBytes);
+    const int result = encoder.encodeLine(row);
+    encoded = result == G5_SUCCESS || result == G5_ENCODE_COMPLETE;
+  }
+  const int compressedSize = encoded ? encoder.size() : 0;
+  if (compressedSize <= 0) {
+    // Usually a page of images that does not fit MAX_COMPRESSED_SIZE
+    LOG_DBG(TAG, "Page does not compress into %u bytes, dropping snapshot",
+            static_cast<unsigned>(MAX_COMPRESSED_SIZE));
+    discard();
+    return false;
+  }
+
+  SdMan.mkdir(PAPYRIX_DIR);
+  FsFile file;
+  if (!SdMan.openFileForWrite("RESUME", SNAPSHOT_TMP, file)) {
+    LOG_ERR(TAG, "Failed to open %s for write", SNAPSHOT_TMP);
+    discard();
+    return false;
+  }
+  const uint32_t size = static_cast<uint32_t>(compressedSize);
+  const bool writeOk =
+      serialization::writePodChecked(file, kSnapshotMagic) && serialization::writePodChecked(file, kSnapshotVersion) &&
+      serialization::writePodChecked(file, width) && serialization::writePodChecked(file, height) &&
+      serialization::writePodChecked(file, layoutKey) && serialization::writeStringChecked(file, bookPath) &&
+      serialization::writeStringChecked(file, font.family) &&
+      serialization::writePodChecked(file, font.builtinFontId) && serialization::writePodChecked(file, size) &&
+      file.write(compressed.get(), size) == size && file.sync();
+  file.close();
+
+  if (!writeOk || !SdMan.commitFile(SNAPSHOT_TMP, SNAPSHOT_FILE)) {
+    LOG_ERR(TAG, "Failed to write snapshot");
+    SdMan.remove(SNAPSHOT_TMP);
+    discard();
+    return false;
+  }
+  LOG_DBG(TAG, "Saved snapshot: %u bytes", static_cast<unsigned>(size));
+  return true;
+}
+
+bool restore(uint8_t* frameBuffer, const uint16_t width, const uint16_t height, const char* bookPath,
+             const LayoutKeyFn& layoutKeyFor) {
+  if (!frameBuffer || !bookPath || !*bookPath || !layoutKeyFor) {
+    return false;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("RESUME", SNAPSHOT_FILE, file)) {
+    return false;
+  }
+
+  Record record;
+  if (!readRecord(file, record) || record.compressedSize == 0 || record.compressedSize > MAX_COMPRESSED_SIZE) {
+    file.close();
+    LOG_ERR(TAG, "Corrupt snapshot; deleting");
+    discard();
+    return false;
+  }
+  // The font files are only fingerprinted once the snapshot is known to be for this book
+  if (record.bookPath != bookPath || record.width != width || record.height != height ||
+      record.layoutKey != layoutKeyFor(record.font)) {
+    file.close();
+    LOG_DBG(TAG, "Snapshot is for another book or layout");
+    return false;
+  }
+
+  std::unique_ptr<uint8_t[]> compressed(new (std::nothrow) uint8_t[record.compressedSize]);
+  const bool readOk = compressed && file.read(compressed.get(), record.compressedSize) ==
+                                        static_cast<int>(record.compressedSize);
+  file.close();
+  if (!readOk) {
+    LOG_ERR(TAG, "Failed to read snapshot data");
+    if (compressed) discard();
+    return false;
+  }
+
+  // Decode straight into the frame buffer; on error it is cleared so no half page is shown
+  const size_t rowBytes = (width + 7) / 8;
+  G5DECODER decoder;
+  bool decoded = decoder.init(width, height, compressed.get(), static_cast<int>(record.compressedSize)) == G5_SUCCESS;
+  for (uint16_t y = 0; y < height && decoded; y++) {
+    const int result = decoder.decodeLine(frameBuffer + y * rowBytes);
+    decoded = result == G5_SUCCESS || result == G5_DECODE_COMPLETE;
+  }
+  if (!decoded) {
+    memset(frameBuffer, 0xFF, rowBytes * height);
+    LOG_ERR(TAG, "Corrupt snapshot data; deleting");
+    discard();
+    return false;
+  }
+  return true;
+}
+
+void discard() { SdMan.remove(SNAPSHOT_FILE); }
+
+}  // namespace resume_snapshot
+}  // namespace papyrix
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace papyrix {
+
+struct Settings;
+
+// Instant resume: the reader page on the panel, kept as a Group5-compressed
+// frame buffer plus a small record naming the book and layout. A Reader-mode
+// boot puts it back on screen before theme, fonts and caches load; ReaderState
+// then renders the real page over it.
+namespace resume_snapshot {
+
+// Text pages compress to a few KB; pages larger than this (dense images) are not kept
+constexpr uint32_t MAX_COMPRESSED_SIZE = 24 * 1024;
+
+// The reader font a page was drawn with. Kept in the snapshot so a boot can
+// fingerprint the font files before the theme and fonts are loaded.
+struct FontSource {
+  std::string family;  // Empty for a built-in font
+  int32_t builtinFontId = 0;
+};
+
+// Hash of the settings, theme file and reader font (FontManager fingerprint)
+// that change how a page looks. A snapshot taken under another layout would
+// show the wrong page, so restore() rejects it.
+uint32_t layoutKey(const Settings& settings, uint32_t fontFingerprint);
+
+// Save the physical frame buffer (width x height, 1 bit per pixel, MSB first)
+// as the page of bookPath. Replaces the previous snapshot; on failure none is left.
+bool save(const uint8_t* frameBuffer, uint16_t width, uint16_t height, const char* bookPath, const FontSource& font,
+          uint32_t layoutKey);
+
+// Decode the snapshot into frameBuffer if it was saved for bookPath on a panel
+// of the same size, and its layoutKey equals layoutKeyFor(its font) now. A
+// corrupt snapshot is deleted.
+using LayoutKeyFn = std::function<uint32_t(const FontSource& font)>;
+bool restore(uint8_t* frameBuffer, uint16_t width, uint16_t height, const char* bookPath,
+             const LayoutKeyFn& layoutKeyFor);
+
+void discard();
+
+}  // namespace resume_snapshot
+}  // namespace papyrix
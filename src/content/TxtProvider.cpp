@@ -45,6 +45,7 @@ Result<void> TxtProvider::open(const char* path, const char* cacheDir) {
 void TxtProvider::close() {
   txt.reset();
   meta.clear();
+  toc.clear();
 }
 
 uint32_t TxtProvider::pageCount() const {
@@ -57,4 +58,19 @@ uint32_t TxtProvider::pageCount() const {
   return (fileSize + BYTES_PER_PAGE - 1) / BYTES_PER_PAGE;
 }
 
+Result<TocEntry> TxtProvider::getTocEntry(uint16_t index) const {
+  if (index >= toc.entries().size()) {
+    return Err<TocEntry>(Error::InvalidState);
+  }
+
+  const TextToc::Entry& item = toc.entries()[index];
+
+  TocEntry entry;
+  utf8SafeCopy(entry.title, sizeof(entry.title), item.title.c_str());
+  entry.pageIndex = item.page;
+  entry.depth = item.depth;
+
+  return Ok(entry);
+}
+
 }  // namespace papyrix
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <TextToc.h>
 #include <Txt.h>
 
 #include <memory>
@@ -13,6 +14,7 @@ namespace papyrix {
 struct TxtProvider {
   std::unique_ptr<Txt> txt;
   ContentMetadata meta;
+  TextToc toc;
 
   TxtProvider() = default;
   ~TxtProvider() = default;
@@ -29,8 +31,10 @@ struct TxtProvider {
   void close();
 
   uint32_t pageCount() const;
-  uint16_t tocCount() const { return 0; }  // TXT has no TOC
-  Result<TocEntry> getTocEntry(uint16_t index) const { return Err<TocEntry>(Error::InvalidState); }
+  // Chapters detected while laying out pages; page numbers belong to one layout
+  uint16_t tocCount() const { return static_cast<uint16_t>(toc.entries().size()); }
+  Result<TocEntry> getTocEntry(uint16_t index) const;
+  void loadToc(const std::string& path, const RenderConfig& config) { toc.load(path, config); }
 
   // Direct access
   Txt* getTxt() { return txt.get(); }
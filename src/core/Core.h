@@ -8,6 +8,7 @@
 #include "../drivers/Storage.h"
 #include "BootMode.h"
 #include "EventQueue.h"
+#include "LoopScheduler.h"
 #include "PapyrixSettings.h"
 #include "Result.h"
 #include "Types.h"
@@ -31,6 +32,9 @@ struct Core {
   // === Events (fixed ring buffer) ===
   EventQueue events;
 
+  // === Main loop wake-ups ===
+  LoopScheduler scheduler;
+
   // === Shared buffers (pre-allocated, reused) ===
   struct Buffers {
     char path[BufferSize::FilePath];
@@ -0,0 +1,54 @@
+#include "LoopScheduler.h"
+
+namespace papyrix {
+
+namespace {
+uint8_t bit(LoopScheduler::Timer timer) { return static_cast<uint8_t>(1u << static_cast<uint8_t>(timer)); }
+
+// Signed difference so deadlines survive millis() wrap-around
+int32_t remainingMs(uint32_t dueMs, uint32_t nowMs) { return static_cast<int32_t>(dueMs - nowMs); }
+}  // namespace
+
+void LoopScheduler::arm(const Timer timer, const uint32_t dueMs) {
+  if (timer >= Timer::Count) return;
+  dueMs_[static_cast<size_t>(timer)] = dueMs;
+  armedMask_ |= bit(timer);
+}
+
+void LoopScheduler::disarm(const Timer timer) {
+  if (timer >= Timer::Count) return;
+  armedMask_ &= static_cast<uint8_t>(~bit(timer));
+}
+
+bool LoopScheduler::armed(const Timer timer) const { return timer < Timer::Count && (armedMask_ & bit(timer)); }
+
+bool LoopScheduler::fire(const Timer timer, const uint32_t nowMs) {
+  if (!armed(timer) || remainingMs(dueMs_[static_cast<size_t>(timer)], nowMs) > 0) return false;
+  disarm(timer);
+  return true;
+}
+
+LoopPlan LoopScheduler::plan(const uint32_t nowMs, const LoopActivity& activity) const {
+  LoopPlan result;
+  result.ms = activity.pollIntervalMs;
+
+  if (activity.buttonHeld) {
+    result.wait = LoopWait::Delay;
+  } else if (activity.backgroundWork) {
+    // Background tasks only run while the loop waits; give them longer slices once the user is idle
+    result.wait = LoopWait::Delay;
+    if (activity.idleMs >= IDLE_AFTER_MS && result.ms < BACKGROUND_SLICE_MS) result.ms = BACKGROUND_SLICE_MS;
+  } else {
+    result.wait = activity.lightSleepAllowed ? LoopWait::LightSleep : LoopWait::Delay;
+  }
+
+  for (size_t i = 0; i < TIMER_COUNT; i++) {
+    if (!(armedMask_ & (1u << i))) continue;
+    const int32_t remaining = remainingMs(dueMs_[i], nowMs);
+    if (remaining <= 0) return {LoopWait::None, 0};
+    if (static_cast<uint32_t>(remaining) < result.ms) result.ms = static_cast<uint32_t>(remaining);
+  }
+  return result;
+}
+
+}  // namespace papyrix
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace papyrix {
+
+// How main.cpp's loop() waits before its next pass.
+enum class LoopWait : uint8_t {
+  None,        // A timer is due: run the next pass at once
+  Delay,       // delay(): other FreeRTOS tasks keep running
+  LightSleep,  // esp_light_sleep_start(): everything stops until a wake source fires
+};
+
+struct LoopPlan {
+  LoopWait wait = LoopWait::Delay;
+  uint32_t ms = 0;
+};
+
+// What the loop saw during the pass that just ran.
+struct LoopActivity {
+  uint32_t idleMs = 0;             // Time since the last button activity
+  uint32_t pollIntervalMs = 10;    // Longest gap between ADC button samples
+  bool buttonHeld = false;         // Long press and repeat timing need steady polling
+  bool backgroundWork = false;     // A background task (cache extend, thumbnail) holds the CPU
+  bool lightSleepAllowed = false;  // No radio, no USB host, nothing left to draw
+};
+
+// Decision-only scheduler for the main loop. Holds one-shot wake-up timers and
+// picks how long and how deeply the loop may wait. Time is passed in as nowMs,
+// so host tests drive it with a fake clock; main.cpp performs the wait.
+//
+// The front buttons sit on ADC resistor ladders whose pressed levels mostly stay
+// above the GPIO low threshold, so they cannot wake the chip by themselves. A
+// wait never exceeds pollIntervalMs (or BACKGROUND_SLICE_MS, the idle sampling
+// rate), which keeps taps from being missed; timers only ever shorten it.
+class LoopScheduler {
+ public:
+  enum class Timer : uint8_t {
+    AutoSleep,  // Inactivity timeout, re-armed by the loop every pass
+    Clock,      // Next minute boundary while the clock app is open
+    Count,
+  };
+
+  // Users idle this long are reading, not navigating
+  static constexpr uint32_t IDLE_AFTER_MS = 3000;
+  // Wait between input samples while an idle user leaves the CPU to background work
+  static constexpr uint32_t BACKGROUND_SLICE_MS = 50;
+
+  // Re-arming replaces the previous due time
+  void arm(Timer timer, uint32_t dueMs);
+  void disarm(Timer timer);
+  bool armed(Timer timer) const;
+  // True once when an armed timer is due; firing disarms it
+  bool fire(Timer timer, uint32_t nowMs);
+
+  LoopPlan plan(uint32_t nowMs, const LoopActivity& activity) const;
+
+ private:
+  static constexpr size_t TIMER_COUNT = static_cast<size_t>(Timer::Count);
+  static_assert(TIMER_COUNT <= sizeof(uint8_t) * 8, "Timer mask no longer fits in uint8_t");
+
+  uint32_t dueMs_[TIMER_COUNT] = {};
+  uint8_t armedMask_ = 0;
+};
+
+}  // namespace papyrix
@@ -116,35 +116,38 @@ Result<void> Settings::load(drivers::Storage& storage) {
 }
 
 int Settings::getReaderFontId(const Theme& theme) const {
+  return FONT_MANAGER.getReaderFontId(readerFontFamily(theme), readerBuiltinFontId(theme));
+}
+
+bool Settings::hasExternalReaderFont(const Theme& theme) const {
+  const char* family = readerFontFamily(theme);
+  return family && *family;
+}
+
+const char* Settings::readerFontFamily(const Theme& theme) const {
   switch (fontSize) {
     case FontXSmall:
-      return FONT_MANAGER.getReaderFontId(theme.readerFontFamilyXSmall, theme.readerFontIdXSmall);
+      return theme.readerFontFamilyXSmall;
     case FontMedium:
-      return FONT_MANAGER.getReaderFontId(theme.readerFontFamilyMedium, theme.readerFontIdMedium);
+      return theme.readerFontFamilyMedium;
     case FontLarge:
-      return FONT_MANAGER.getReaderFontId(theme.readerFontFamilyLarge, theme.readerFontIdLarge);
+      return theme.readerFontFamilyLarge;
     default:  // FontSmall
-      return FONT_MANAGER.getReaderFontId(theme.readerFontFamilySmall, theme.readerFontId);
+      return theme.readerFontFamilySmall;
   }
 }
 
-bool Settings::hasExternalReaderFont(const Theme& theme) const {
-  const char* family = nullptr;
+int Settings::readerBuiltinFontId(const Theme& theme) const {
   switch (fontSize) {
     case FontXSmall:
-      family = theme.readerFontFamilyXSmall;
-      break;
+      return theme.readerFontIdXSmall;
     case FontMedium:
-      family = theme.readerFontFamilyMedium;
-      break;
+      return theme.readerFontIdMedium;
     case FontLarge:
-      family = theme.readerFontFamilyLarge;
-      break;
-    default:
-      family = theme.readerFontFamilySmall;
-      break;
+      return theme.readerFontIdLarge;
+    default:  // FontSmall
+      return theme.readerFontId;
   }
-  return family && *family;
 }
 
 RenderConfig Settings::getRenderConfig(const Theme& theme, uint16_t viewportWidth, uint16_t viewportHeight) const {
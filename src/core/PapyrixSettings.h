@@ -118,6 +118,9 @@ struct Settings {
 
   int getReaderFontId(const Theme& theme) const;
   bool hasExternalReaderFont(const Theme& theme) const;
+  // Theme font for the current size: custom family (empty for built-in) and built-in fallback ID
+  const char* readerFontFamily(const Theme& theme) const;
+  int readerBuiltinFontId(const Theme& theme) const;
 
   int getPagesPerRefreshValue() const {
     constexpr int values[] = {1, 5, 10, 15, 30, 0};
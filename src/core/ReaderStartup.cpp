@@ -0,0 +1,28 @@
+#include "ReaderStartup.h"
+
+namespace papyrix {
+
+void ReaderStartup::begin(const uint32_t nowMs) {
+  stage_ = ReaderStartupStage::Opening;
+  beginMs_ = nowMs;
+  for (auto& elapsed : elapsedMs_) elapsed = 0;
+}
+
+bool ReaderStartup::advance(const ReaderStartupStage stage, const uint32_t nowMs) {
+  if (stage >= ReaderStartupStage::Count || stage <= stage_) return false;
+
+  // Skipped stages count as done at the same moment
+  const uint32_t elapsed = nowMs - beginMs_;
+  for (size_t i = static_cast<size_t>(stage_) + 1; i <= static_cast<size_t>(stage); i++) {
+    elapsedMs_[i] = elapsed;
+  }
+  stage_ = stage;
+  return true;
+}
+
+uint32_t ReaderStartup::elapsedMs(const ReaderStartupStage stage) const {
+  if (stage >= ReaderStartupStage::Count || !reached(stage)) return 0;
+  return elapsedMs_[static_cast<size_t>(stage)];
+}
+
+}  // namespace papyrix
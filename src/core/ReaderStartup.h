@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace papyrix {
+
+// Book-open work in the order the reader needs it. Each stage starts once the
+// one before it is done; later stages run after the first page is on screen.
+enum class ReaderStartupStage : uint8_t {
+  Opening,      // ReaderState::enter(): content handle, position, bookmarks
+  PageShown,    // First page on screen; its status bar may show section-local numbers
+  Bookkeeping,  // Settings, recent books, library entry, cover/thumbnail state
+  Ready,        // Whole-book page metrics built by the cache task
+  Count,
+};
+
+// Decision-only tracker for the staged Reader startup. Time is passed in as
+// nowMs so host tests drive it with a fake clock; ReaderState does the work and
+// reports progress through EventQueue (PageReady, ContentLoaded).
+class ReaderStartup {
+ public:
+  void begin(uint32_t nowMs);
+
+  ReaderStartupStage stage() const { return stage_; }
+  bool reached(ReaderStartupStage stage) const { return stage_ >= stage; }
+
+  // Moves forward only. False when the stage was already reached.
+  bool advance(ReaderStartupStage stage, uint32_t nowMs);
+
+  // Time from begin() to the stage, 0 while it is not reached.
+  // PageShown is the time to first page.
+  uint32_t elapsedMs(ReaderStartupStage stage) const;
+
+ private:
+  static constexpr size_t STAGE_COUNT = static_cast<size_t>(ReaderStartupStage::Count);
+
+  ReaderStartupStage stage_ = ReaderStartupStage::Opening;
+  uint32_t beginMs_ = 0;
+  uint32_t elapsedMs_[STAGE_COUNT] = {};
+};
+
+}  // namespace papyrix
@@ -0,0 +1,154 @@
+#include "Trace.h"
+
+#include <SDCardManager.h>
+
+namespace papyrix {
+namespace trace {
+
+namespace {
+constexpr const char* EVENT_NAMES[] = {
+    "boot-setup",    "boot-early-init", "boot-mode-init", "page-render",      "page-load",
+    "refresh-begin", "refresh-wait",    "prefetch",       "cache-task-start", "cache-build",
+    "epub-extract",  "epub-normalize",  "epub-layout",    "fb2-layout",       "thumbnail",
+    "sleep",         "page-serialize",  "resume-save",    "resume-restore",   "reader-open",
+    "first-page",    "global-metrics",  "idle-index",     "prefetch-skip",
+};
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == static_cast<size_t>(Event::Count),
+              "Every trace event needs a name");
+}  // namespace
+
+const char* eventName(const Event event) {
+  return event < Event::Count ? EVENT_NAMES[static_cast<size_t>(event)] : "unknown";
+}
+
+}  // namespace trace
+}  // namespace papyrix
+
+#if PAPYRIX_TRACE
+
+#include <Logging.h>
+#include <esp_heap_caps.h>
+
+#include <atomic>
+#include <cstring>
+
+#if __has_include(<esp_timer.h>)
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#endif
+
+#define TAG "TRACE"
+
+namespace papyrix {
+namespace trace {
+
+namespace {
+constexpr size_t CAPACITY = PAPYRIX_TRACE_RECORDS;
+constexpr size_t MAX_TASKS = 8;
+
+Record ring[CAPACITY];
+std::atomic<uint32_t> written{0};
+std::atomic<Listener> listener{nullptr};
+
+#if __has_include(<esp_timer.h>)
+uint32_t nowUs() { return static_cast<uint32_t>(esp_timer_get_time()); }
+
+std::atomic<void*> tasks[MAX_TASKS];
+
+// Task numbers are handed out on first use so records stay 16 bytes
+uint8_t currentTask() {
+  void* self = xTaskGetCurrentTaskHandle();
+  for (size_t i = 0; i < MAX_TASKS; i++) {
+    void* seen = tasks[i].load(std::memory_order_acquire);
+    if (seen == self) return static_cast<uint8_t>(i);
+    if (!seen && tasks[i].compare_exchange_strong(seen, self, std::memory_order_acq_rel)) {
+      return static_cast<uint8_t>(i);
+    }
+  }
+  return MAX_TASKS;
+}
+#else
+uint32_t nowUs() {
+  using namespace std::chrono;
+  static const auto start = steady_clock::now();
+  return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - start).count());
+}
+
+uint8_t currentTask() { return 0; }
+#endif
+}  // namespace
+
+void record(const Event event, const Phase phase) {
+  Record entry;
+  entry.timeUs = nowUs();
+  entry.event = static_cast<uint16_t>(event);
+  entry.phase = static_cast<uint8_t>(phase);
+  entry.task = currentTask();
+  entry.freeHeap = static_cast<uint32_t>(heap_caps_get_free_size(MALLOC_CAP_8BIT));
+  entry.largestFreeBlock = static_cast<uint32_t>(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  // Claiming a slot is the only shared step, so tasks never wait on each other
+  ring[written.fetch_add(1, std::memory_order_acq_rel) % CAPACITY] = entry;
+  if (const Listener notify = listener.load(std::memory_order_acquire)) notify(event, phase);
+}
+
+size_t snapshot(Record* out, const size_t maxRecords) {
+  const uint32_t total = written.load(std::memory_order_acquire);
+  size_t count = total < CAPACITY ? total : CAPACITY;
+  if (count > maxRecords) count = maxRecords;
+  const uint32_t first = total - static_cast<uint32_t>(count);
+  for (size_t i = 0; i < count; i++) {
+    out[i] = ring[(first + i) % CAPACITY];
+  }
+  return count;
+}
+
+bool flush() {
+  // Copy first: recording continues while the card is written
+  static Record copy[CAPACITY];
+  const uint32_t total = written.load(std::memory_order_acquire);
+  const size_t count = snapshot(copy, CAPACITY);
+
+  FileHeader header{};
+  memcpy(header.magic, "PTRC", sizeof(header.magic));
+  header.version = FILE_VERSION;
+  header.recordSize = sizeof(Record);
+  header.nameCount = static_cast<uint16_t>(Event::Count);
+  header.recordCount = static_cast<uint32_t>(count);
+  header.overwritten = total > CAPACITY ? total - CAPACITY : 0;
+
+  SdMan.mkdir("/.papyrix");
+  FsFile file;
+  if (!SdMan.openFileForWrite("TRACE", FILE_PATH, file)) {
+    LOG_ERR(TAG, "Cannot open %s", FILE_PATH);
+    return false;
+  }
+  bool ok = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header);
+  for (uint16_t i = 0; ok && i < header.nameCount; i++) {
+    const char* name = eventName(static_cast<Event>(i));
+    const uint8_t length = static_cast<uint8_t>(strlen(name));
+    ok = file.write(&length, 1) == 1 && file.write(reinterpret_cast<const uint8_t*>(name), length) == length;
+  }
+  const size_t recordBytes = count * sizeof(Record);
+  ok = ok && file.write(reinterpret_cast<const uint8_t*>(copy), recordBytes) == recordBytes;
+  file.close();
+  if (!ok) {
+    LOG_ERR(TAG, "Short write to %s", FILE_PATH);
+    SdMan.remove(FILE_PATH);
+    return false;
+  }
+  LOG_INF(TAG, "Wrote %u trace records (%u overwritten)", static_cast<unsigned>(count),
+          static_cast<unsigned>(header.overwritten));
+  return true;
+}
+
+void reset() { written.store(0, std::memory_order_release); }
+
+void setListener(const Listener callback) { listener.store(callback, std::memory_order_release); }
+
+}  // namespace trace
+}  // namespace papyrix
+
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef PAPYRIX_TRACE
+#define PAPYRIX_TRACE 0
+#endif
+
+// Ring capacity in records; 16 bytes each
+#ifndef PAPYRIX_TRACE_RECORDS
+#define PAPYRIX_TRACE_RECORDS 256
+#endif
+
+namespace papyrix {
+namespace trace {
+
+// Stable IDs: the names are written into every trace file, so tools/monitor
+// decodes traces from any firmware version. Append new events before Count.
+enum class Event : uint16_t {
+  BootSetup,
+  BootEarlyInit,
+  BootModeInit,
+  PageRender,
+  PageLoad,
+  RefreshBegin,
+  RefreshWait,
+  Prefetch,
+  CacheTaskStart,
+  CacheBuild,
+  EpubExtract,
+  EpubNormalize,
+  EpubLayout,
+  Fb2Layout,
+  Thumbnail,
+  Sleep,
+  PageSerialize,
+  ResumeSave,
+  ResumeRestore,
+  ReaderOpen,
+  FirstPage,
+  GlobalMetrics,
+  IdleIndex,
+  PrefetchSkip,
+  Count,
+};
+
+enum class Phase : uint8_t {
+  Begin = 'B',
+  End = 'E',
+  Instant = 'i',
+};
+
+#pragma pack(push, 1)
+struct Record {
+  uint32_t timeUs;  // Wraps after ~71 minutes; the decoder unwraps it
+  uint16_t event;
+  uint8_t phase;
+  uint8_t task;  // Small per-boot task number, 0 is the first task that traced
+  uint32_t freeHeap;
+  uint32_t largestFreeBlock;
+};
+#pragma pack(pop)
+static_assert(sizeof(Record) == 16, "Trace records are 16 bytes on disk");
+
+/**
+ * File /.papyrix/trace.bin:
+ *   FileHeader, nameCount x {u8 length, bytes} event names indexed by ID,
+ *   then recordCount Records oldest first.
+ */
+#pragma pack(push, 1)
+struct FileHeader {
+  char magic[4];  // "PTRC"
+  uint8_t version;
+  uint8_t recordSize;
+  uint16_t nameCount;
+  uint32_t recordCount;
+  uint32_t overwritten;  // Records lost to ring wrap-around before this flush
+};
+#pragma pack(pop)
+
+constexpr uint8_t FILE_VERSION = 1;
+constexpr const char* FILE_PATH = "/.papyrix/trace.bin";
+
+const char* eventName(Event event);
+
+#if PAPYRIX_TRACE
+
+// Safe from any task; takes a timestamp and two heap queries, no formatting
+void record(Event event, Phase phase);
+// Copies up to maxRecords of the newest records, oldest first
+size_t snapshot(Record* out, size_t maxRecords);
+// Writes the ring to FILE_PATH, replacing the previous trace
+bool flush();
+void reset();
+
+// Called after each record on the recording task; host tools use it to
+// attribute work to phases (test/common/HeapProfiler.h). Pass nullptr to remove.
+using Listener = void (*)(Event event, Phase phase);
+void setListener(Listener listener);
+
+class Span {
+ public:
+  explicit Span(Event event) : event_(event) { record(event_, Phase::Begin); }
+  ~Span() { record(event_, Phase::End); }
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+ private:
+  Event event_;
+};
+
+#else
+
+inline bool flush() { return true; }
+
+#endif
+
+}  // namespace trace
+}  // namespace papyrix
+
+#if PAPYRIX_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_BEGIN(event) papyrix::trace::record(papyrix::trace::Event::event, papyrix::trace::Phase::Begin)
+#define TRACE_END(event) papyrix::trace::record(papyrix::trace::Event::event, papyrix::trace::Phase::End)
+#define TRACE_INSTANT(event) papyrix::trace::record(papyrix::trace::Event::event, papyrix::trace::Phase::Instant)
+#define TRACE_SCOPE(event) papyrix::trace::Span TRACE_CONCAT(traceSpan_, __LINE__)(papyrix::trace::Event::event)
+#else
+#define TRACE_BEGIN(event) ((void)0)
+#define TRACE_END(event) ((void)0)
+#define TRACE_INSTANT(event) ((void)0)
+#define TRACE_SCOPE(event) ((void)0)
+#endif
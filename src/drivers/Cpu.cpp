@@ -55,6 +55,8 @@ void Cpu::unthrottleLocked() {
 
 bool Cpu::isThrottled() const { return throttled_.load(std::memory_order_acquire); }
 
+bool Cpu::isPerformanceLocked() const { return performanceLockCount_.load(std::memory_order_acquire) != 0; }
+
 uint8_t Cpu::loopDelayMs() const { return isThrottled() ? kIdleLoopDelayMs : kActiveLoopDelayMs; }
 
 }  // namespace drivers
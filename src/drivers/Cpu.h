@@ -27,6 +27,8 @@ class Cpu {
   void throttle();
   void unthrottle();
   bool isThrottled() const;
+  // True while a background task holds a PerformanceLock
+  bool isPerformanceLocked() const;
   uint8_t loopDelayMs() const;
 
  private:
@@ -14,6 +14,7 @@
 #include <builtinFonts/reader_xsmall_italic_2b.h>
 #include <builtinFonts/reader_xsmall_regular_2b.h>
 #include <driver/gpio.h>
+#include <esp_sleep.h>
 #include <esp_system.h>
 
 #include "core/CrashDebug.h"
@@ -36,6 +37,7 @@
 #include "ThemeManager.h"
 #include "config.h"
 #include "content/ContentTypes.h"
+#include "content/ResumeSnapshot.h"
 #include "drivers/Device.h"
 #include "ui/Elements.h"
 
@@ -49,6 +51,7 @@
 #include "core/Core.h"
 #include "core/FirmwareUpdater.h"
 #include "core/StateMachine.h"
+#include "core/Trace.h"
 #include "images/PapyrixLogo.h"
 #include "states/AppLauncherState.h"
 #include "states/CalibreSyncState.h"
@@ -259,13 +262,21 @@ void setupReaderFontForSize(papyrix::Settings::FontSize fontSize) {
   }
 }
 
-void setupDisplayAndFonts(bool allReaderSizes = true) {
+// Idempotent: Reader mode starts the display early to show the resume snapshot
+void setupDisplay() {
+  static bool started = false;
+  if (started) return;
   if (papyrix::drivers::Device::instance().isX3()) {
     einkDisplay.setDisplayX3();
   }
   einkDisplay.begin();
   renderer.begin();
+  started = true;
   LOG_INF(TAG, "Display initialized");
+}
+
+void setupDisplayAndFonts(bool allReaderSizes = true) {
+  setupDisplay();
   if (allReaderSizes) {
     renderer.insertFont(READER_FONT_ID_XSMALL, readerFontFamilyXSmall());
     renderer.insertFont(READER_FONT_ID, readerFontFamilySmall());
@@ -494,6 +505,32 @@ void initUIMode() {
   LOG_DBG(TAG, "[UI mode] After init - Free heap: %lu, Max block: %lu", ESP.getFreeHeap(), ESP.getMaxAllocHeap());
 }
 
+// Reader-mode startup input: presses made while the resume snapshot is on screen
+// are queued and handled by ReaderState's first update
+static void pollStartupInput() {
+  inputManager.update();
+  papyrix::core.input.poll();
+}
+
+// Put the last reader page back on the panel before theme, fonts and caches load.
+// The refresh runs while the rest of initReaderMode() continues.
+static void showResumeSnapshot(const char* bookPath, const bool usesFonts) {
+  setupDisplay();
+  TRACE_BEGIN(ResumeRestore);
+  // Fonts are not loaded yet: the snapshot names its font and the files are fingerprinted directly
+  const bool restored = papyrix::resume_snapshot::restore(
+      einkDisplay.getFrameBuffer(), einkDisplay.getDisplayWidth(), einkDisplay.getDisplayHeight(), bookPath,
+      [usesFonts](const papyrix::resume_snapshot::FontSource& font) {
+        const uint32_t fontFingerprint =
+            usesFonts ? FontManager::readerFontFingerprint(font.family.c_str(), font.builtinFontId) : 0;
+        return papyrix::resume_snapshot::layoutKey(papyrix::core.settings, fontFingerprint);
+      });
+  TRACE_END(ResumeRestore);
+  if (!restored) return;
+  renderer.beginDisplayBuffer(EInkDisplay::HALF_REFRESH);
+  LOG_INF(TAG, "Resume snapshot shown %lu ms after boot", millis());
+}
+
 // Initialize Reader mode - minimal state registration, single font size
 void initReaderMode() {
   LOG_INF(TAG, "Initializing READER mode");
@@ -505,16 +542,26 @@ void initReaderMode() {
   papyrix::ContentType contentType = papyrix::detectContentType(transition.bookPath);
   bool needsCustomFonts = (contentType != papyrix::ContentType::Xtc);
 
+  showResumeSnapshot(transition.bookPath, needsCustomFonts);
+
+  // Buttons held through boot (the wake press) must not turn into page turns
+  mappedInputManager.setSettings(&papyrix::core.settings);
+  papyrix::core.input.init(papyrix::core.events);
+  papyrix::core.input.resyncState();
+
   // Initialize theme and font managers (minimal - no cache)
   FONT_MANAGER.init(renderer);
   THEME_MANAGER.loadTheme(papyrix::core.settings.themeName);
   // Skip createDefaultThemeFiles() - not needed in reader mode
   LOG_INF(TAG, "Theme loaded: %s (reader mode)", THEME_MANAGER.currentThemeName());
+  pollStartupInput();
 
   setupDisplayAndFonts(false);  // Only active reader font size
+  pollStartupInput();
 
   if (needsCustomFonts) {
     applyThemeFonts();  // Custom fonts - skip for XTC/XTCH to save ~500KB+ RAM
+    pollStartupInput();
   } else {
     LOG_DBG(TAG, "Skipping custom fonts for XTC content");
   }
@@ -524,6 +571,9 @@ void initReaderMode() {
   stateMachine.registerState(&sleepState);
   stateMachine.registerState(&errorState);
 
+  // Core::init() starts the display driver again, which clears the frame buffer
+  renderer.finishRefresh();
+
   // Initialize core
   auto result = papyrix::core.init();
   if (!result.ok()) {
@@ -566,8 +616,13 @@ void setup() {
   logSerial.setTxTimeoutMs(kSerialTxTimeoutMs);
 #endif
 
+  TRACE_SCOPE(BootSetup);
+
   // Early initialization (common to both modes)
-  if (!earlyInit()) {
+  TRACE_BEGIN(BootEarlyInit);
+  const bool initialized = earlyInit();
+  TRACE_END(BootEarlyInit);
+  if (!initialized) {
     return;  // Critical failure
   }
 
@@ -575,16 +630,37 @@ void setup() {
   currentBootMode = papyrix::detectBootMode();
   papyrix::core.bootMode = currentBootMode;
 
+  TRACE_BEGIN(BootModeInit);
   if (currentBootMode == papyrix::BootMode::READER) {
     initReaderMode();
   } else {
     initUIMode();
   }
+  TRACE_END(BootModeInit);
 
   // Ensure we're not still holding the power button before leaving setup
   waitForPowerRelease();
 }
 
+// Only the power button is a plain GPIO that can wake light sleep; the ADC
+// ladder buttons are sampled when the timer wakes the chip
+static void waitForNextPass(const papyrix::LoopPlan& plan) {
+  if (plan.wait == papyrix::LoopWait::None) return;
+
+  if (plan.wait == papyrix::LoopWait::LightSleep) {
+    static bool wakeSourcesReady = false;
+    if (!wakeSourcesReady) {
+      gpio_wakeup_enable(static_cast<gpio_num_t>(InputManager::POWER_BUTTON_PIN), GPIO_INTR_LOW_LEVEL);
+      esp_sleep_enable_gpio_wakeup();
+      wakeSourcesReady = true;
+    }
+    esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(plan.ms) * 1000);
+    if (esp_light_sleep_start() == ESP_OK) return;
+    // Rejected, e.g. a wake source is already pending: fall back to a plain delay
+  }
+  delay(plan.ms);
+}
+
 void loop() {
   static unsigned long maxLoopDuration = 0;
   const unsigned long loopStartTime = millis();
@@ -602,12 +678,20 @@ void loop() {
   papyrix::core.input.poll();
 
   // Auto-sleep after inactivity
+  auto& scheduler = papyrix::core.scheduler;
   const auto autoSleepTimeout = papyrix::core.settings.getAutoSleepTimeoutMs();
   const bool wifiActive = papyrix::core.network.isConnected() || papyrix::core.network.isAPMode();
   if (wifiActive) {
     papyrix::core.input.resetIdleTimer();
   }
-  if (autoSleepTimeout > 0 && papyrix::core.input.idleTimeMs() >= autoSleepTimeout) {
+  const unsigned long idleCheckMs = millis();
+  if (autoSleepTimeout > 0) {
+    scheduler.arm(papyrix::LoopScheduler::Timer::AutoSleep,
+                  idleCheckMs - papyrix::core.input.idleTimeMs() + autoSleepTimeout);
+  } else {
+    scheduler.disarm(papyrix::LoopScheduler::Timer::AutoSleep);
+  }
+  if (scheduler.fire(papyrix::LoopScheduler::Timer::AutoSleep, idleCheckMs)) {
     LOG_INF(TAG, "Auto-sleep after %lu ms idle", autoSleepTimeout);
     stateMachine.init(papyrix::core, papyrix::StateId::Sleep);
     return;
@@ -638,9 +722,8 @@ void loop() {
   // restore full speed on any activity. Must run BEFORE stateMachine.update()
   // so rendering always happens at full CPU/SPI speed after wake.
   // Idea: CrossPoint HalPowerManager by @ngxson (https://github.com/ngxson)
-  static constexpr unsigned long kIdlePowerSavingMs = 3000;
   if (currentBootMode == papyrix::BootMode::READER) {
-    if (papyrix::core.input.idleTimeMs() >= kIdlePowerSavingMs) {
+    if (papyrix::core.input.idleTimeMs() >= papyrix::LoopScheduler::IDLE_AFTER_MS) {
       papyrix::core.cpu.throttle();
     } else {
       papyrix::core.cpu.unthrottle();
@@ -660,8 +743,16 @@ void loop() {
     }
   }
 
-  // Add delay at the end of the loop to prevent tight spinning
-  // Increase delay after idle to save power (~4x less CPU load)
+  // Wait for the next input sample or timer. Poll slower after idle to save power (~4x less CPU load)
   // Idea: https://github.com/crosspoint-reader/crosspoint-reader/commit/0991782 by @ngxson (https://github.com/ngxson)
-  delay(papyrix::core.cpu.loopDelayMs());
+  papyrix::LoopActivity activity;
+  activity.idleMs = papyrix::core.input.idleTimeMs();
+  activity.pollIntervalMs = papyrix::core.cpu.loopDelayMs();
+  activity.backgroundWork = papyrix::core.cpu.isPerformanceLocked();
+  for (uint8_t btn = 0; btn <= InputManager::BTN_POWER && !activity.buttonHeld; btn++) {
+    activity.buttonHeld = inputManager.isPressed(btn);
+  }
+  // Light sleep stops the background task and drops the USB serial link
+  activity.lightSleepAllowed = papyrix::core.cpu.isThrottled() && !wifiActive && !isUsbConnected();
+  waitForNextPass(scheduler.plan(millis(), activity));
 }
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <FileIndex.h>
 #include <FsHelpers.h>
 #include <Logging.h>
 #include <SDCardManager.h>
@@ -11,7 +12,9 @@
 
 #include "../IniParser.h"
 #include "../config.h"
+#include "../content/LibraryStore.h"
 #include "../content/RecentBooksStore.h"
+#include "../states/FileListState.h"
 #include "WebFileNameValidation.h"
 #include "html/AppPageHtml.generated.h"
 
@@ -331,6 +334,12 @@ void PapyrixWebServer::handleUpload() {
       if (upload_.error.isEmpty()) {
         upload_.success = true;
         LOG_INF(TAG, "Upload complete: %s (%zu bytes)", upload_.fileName.c_str(), upload_.size);
+        String filePath = upload_.path;
+        if (appendWebPathComponent(filePath, upload_.fileName)) {
+          FileIndex::noteAdded(filePath.c_str(), false, FileListState::acceptEntry);
+          // An overwritten book is read again on first open
+          LIBRARY.remove(filePath.c_str());
+        }
       }
     }
     upload_.buffer.clear();
@@ -395,6 +404,7 @@ void PapyrixWebServer::handleCreateFolder() {
   }
 
   if (SdMan.mkdir(folderPath.c_str())) {
+    FileIndex::noteAdded(folderPath.c_str(), true, FileListState::acceptEntry);
     LOG_INF(TAG, "Created folder: %s", folderPath.c_str());
     server_->send(200, "text/plain", "Folder created");
   } else {
@@ -452,6 +462,12 @@ void PapyrixWebServer::handleDelete() {
   }
 
   if (success) {
+    FileIndex::noteRemoved(itemPath.c_str());
+    if (itemType == "folder") {
+      LIBRARY.removeDirectory(itemPath.c_str());
+    } else {
+      LIBRARY.remove(itemPath.c_str());
+    }
     RecentBooksStore::instance().remove(itemPath.c_str());
     LOG_INF(TAG, "Deleted: %s", itemPath.c_str());
     server_->send(200, "text/plain", "Deleted");
@@ -547,7 +563,17 @@ void PapyrixWebServer::handleRename() {
     return;
   }
 
+  FsFile item = SdMan.open(itemPath.c_str());
+  const bool isDirectory = item && item.isDirectory();
+  if (item) item.close();
+
   if (SdMan.rename(itemPath.c_str(), newPath.c_str())) {
+    FileIndex::noteRenamed(itemPath.c_str(), newPath.c_str(), isDirectory, FileListState::acceptEntry);
+    if (isDirectory) {
+      LIBRARY.renameDirectory(itemPath.c_str(), newPath.c_str());
+    } else {
+      LIBRARY.rename(itemPath.c_str(), newPath.c_str());
+    }
     LOG_INF(TAG, "Renamed: %s -> %s", itemPath.c_str(), newPath.c_str());
     server_->send(200, "text/plain", "Renamed");
   } else {
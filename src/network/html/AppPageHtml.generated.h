@@ -0,0 +1,494 @@
+// THIS FILE IS AUTOGENERATED, DO NOT EDIT MANUALLY
+
+#pragma once
+
+#include <cstddef>
+
+constexpr char AppPageHtml[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0xaf, 0x28, 0xd5, 0x6a, 0x02, 0xff, 0xed, 0x3d, 0x6b, 0x73, 0xdb, 0x46,
+    0x92, 0xdf, 0xf5, 0x2b, 0x60, 0xa5, 0x62, 0x10, 0x11, 0x09, 0x92, 0x7a, 0x9b, 0x14, 0xa5, 0xf3,
+    0x4b, 0x59, 0xdf, 0x3a, 0x89, 0xcb, 0x8f, 0xba, 0xbb, 0x72, 0x5c, 0x57, 0x20, 0x31, 0x20, 0x11,
+    0x81, 0x00, 0x0e, 0x18, 0xea, 0x11, 0x5a, 0xff, 0xfd, 0xba, 0x7b, 0x06, 0xc0, 0x0c, 0x00, 0x92,
+    0xa0, 0x56, 0xf1, 0x65, 0xb3, 0x97, 0xad, 0xa5, 0x48, 0xa0, 0xa7, 0xa7, 0xa7, 0xdf, 0xdd, 0x33,
+    0x80, 0xcf, 0x9e, 0xbc, 0xfa, 0xe5, 0xe5, 0xc7, 0xff, 0x7a, 0xf7, 0xda, 0x98, 0xf1, 0x79, 0x70,
+    0x7e, 0x86, 0x9f, 0x46, 0xe0, 0x84, 0xd3, 0xd1, 0x2e, 0x0b, 0x77, 0xe1, 0x37, 0x73, 0xdc, 0xf3,
+    0xb3, 0x39, 0xe3, 0x8e, 0x31, 0x99, 0x39, 0x49, 0xca, 0xf8, 0x68, 0xf7, 0xd3, 0xc7, 0xcb, 0xce,
+    0xe9, 0xae, 0xbc, 0x1a, 0x3a, 0x73, 0x36, 0xda, 0xbd, 0xf6, 0xd9, 0x4d, 0x1c, 0x25, 0x7c, 0xd7,
+    0x98, 0x44, 0x21, 0x67, 0x21, 0x40, 0xdd, 0xf8, 0x2e, 0x9f, 0x8d, 0x5c, 0x76, 0xed, 0x4f, 0x58,
+    0x87, 0x7e, 0xb4, 0x0d, 0x3f, 0xf4, 0xb9, 0xef, 0x04, 0x9d, 0x74, 0xe2, 0x04, 0x6c, 0xd4, 0xb7,
+    0x7b, 0x80, 0x85, 0xfb, 0x3c, 0x60, 0xe7, 0xef, 0x9c, 0xf8, 0x2e, 0xf1, 0x6f, 0x8d, 0xf7, 0x30,
+    0x1f, 0x4b, 0xce, 0xba, 0xe2, 0xaa, 0x71, 0x96, 0xf2, 0x3b, 0xf8, 0xbb, 0x63, 0xc0, 0x7f, 0x3f,
+    0x2c, 0xc7, 0xd1, 0x6d, 0x27, 0xf5, 0x7f, 0xf7, 0xc3, 0xe9, 0x60, 0x1c, 0x25, 0x00, 0xd7, 0x81,
+    0x2b, 0xc3, 0xb9, 0x93, 0x4c, 0xfd, 0x70, 0xd0, 0x1b, 0xc6, 0x8e, 0xeb, 0xe2, 0xbd, 0xde, 0x3d,
+    0xc1, 0x8f, 0x23, 0xf7, 0x6e, 0xe9, 0x01, 0x39, 0x1d, 0xcf, 0x99, 0xfb, 0xc1, 0xdd, 0xa0, 0xe3,
+    0xc4, 0x71, 0xc0, 0x3a, 0xe9, 0x5d, 0xca, 0xd9, 0xbc, 0xfd, 0x22, 0xf0, 0xc3, 0xab, 0x9f, 0x9c,
+    0xc9, 0x07, 0xfa, 0x79, 0x09, 0x70, 0xed, 0xdd, 0x0f, 0x6c, 0x1a, 0x31, 0xe3, 0xd3, 0x9b, 0xdd,
+    0xf6, 0xfb, 0x68, 0x1c, 0xf1, 0xa8, 0x9d, 0x3a, 0x61, 0xda, 0x49, 0x59, 0xe2, 0x7b, 0xc3, 0xb1,
+    0x33, 0xb9, 0x9a, 0x26, 0xd1, 0x22, 0x74, 0x07, 0xdf, 0xf5, 0xfb, 0xfd, 0xd3, 0xfd, 0x93, 0xe1,
+    0x24, 0x0a, 0xa2, 0x64, 0xf0, 0x1d, 0x3b, 0x62, 0x27, 0x6c, 0x3c, 0x9c, 0xfb, 0x61, 0x67, 0xc6,
+    0xfc, 0xe9, 0x8c, 0x0f, 0xfa, 0xbd, 0xde, 0xf5, 0x6c, 0xe8, 0xfa, 0x69, 0x1c, 0x38, 0x77, 0x03,
+    0x2f, 0x60, 0xb7, 0x43, 0xfc, 0xe8, 0xb8, 0x7e, 0xc2, 0x26, 0xdc, 0x8f, 0xc2, 0x01, 0x0c, 0x5d,
+    0xcc, 0x43, 0x41, 0xa8, 0xb3, 0x94, 0x88, 0x9c, 0x93, 0xd3, 0xb1, 0xe7, 0x0c, 0x39, 0xbb, 0xe5,
+    0x1d, 0x97, 0x4d, 0xa2, 0xc4, 0x21, 0xd8, 0x30, 0x0a, 0x99, 0x84, 0x1c, 0xcc, 0xa2, 0x6b, 0x96,
+    0x2c, 0xcb, 0x10, 0x40, 0x14, 0x4b, 0x60, 0x3d, 0x12, 0x6c, 0x46, 0x4c, 0x5c, 0x6a, 0x14, 0x7b,
+    0xfb, 0xcf, 0x0e, 0x4e, 0x72, 0x16, 0xf5, 0x0f, 0xe3, 0x5b, 0x63, 0xbf, 0x17, 0xdf, 0xea, 0x44,
+    0x3a, 0x81, 0x3f, 0x0d, 0x3b, 0x3e, 0xf0, 0x23, 0x1d, 0x4c, 0x40, 0x8a, 0x2c, 0x19, 0xfe, 0xb6,
+    0x48, 0xb9, 0xef, 0xdd, 0x75, 0xa4, 0x5c, 0x07, 0x69, 0xec, 0x80, 0x3c, 0xc7, 0x8c, 0xdf, 0x30,
+    0x16, 0x0e, 0x73, 0x31, 0x70, 0x1e, 0xcd, 0x07, 0x7d, 0x40, 0x9a, 0x46, 0x81, 0xef, 0x1a, 0xdf,
+    0x1d, 0x9c, 0x1c, 0xf6, 0x8f, 0xfa, 0x2a, 0x39, 0xc6, 0xac, 0x2f, 0xa4, 0x01, 0x12, 0x64, 0x83,
+    0xbe, 0xbd, 0xcf, 0xe6, 0x19, 0x03, 0xbd, 0x67, 0x9e, 0xe3, 0x8d, 0x87, 0x74, 0xf7, 0x46, 0x70,
+    0xf0, 0xb8, 0xd7, 0xd3, 0x06, 0xdb, 0xb8, 0xec, 0x62, 0xb8, 0x7d, 0x5a, 0x8c, 0x3e, 0x1e, 0x9f,
+    0xec, 0x9f, 0xf6, 0xa4, 0x1a, 0x74, 0x02, 0xe6, 0xf1, 0xc1, 0x69, 0x7c, 0x2b, 0x46, 0x87, 0xce,
+    0xf5, 0x52, 0x5b, 0x61, 0x0d, 0x4f, 0x36, 0xac, 0xa1, 0x50, 0x2b, 0xa3, 0xbf, 0xaf, 0xe0, 0x35,
+    0xc6, 0x0b, 0x18, 0x10, 0xaa, 0x5c, 0x46, 0x41, 0x49, 0x74, 0xe2, 0xbb, 0xa4, 0xf0, 0xd9, 0xc4,
+    0x39, 0x70, 0xbc, 0x82, 0xf9, 0x80, 0xc6, 0xe8, 0x03, 0x8d, 0xc3, 0xc9, 0x22, 0x49, 0x01, 0x20,
+    0x8e, 0x7c, 0xe2, 0xb5, 0xb2, 0xbe, 0x67, 0x47, 0xb0, 0x40, 0x95, 0x21, 0x47, 0xbd, 0x5e, 0x89,
+    0xd2, 0xfd, 0x9c, 0x52, 0x9e, 0x80, 0x9a, 0xc6, 0x4e, 0x02, 0xf2, 0x19, 0xd2, 0x77, 0x9f, 0xb4,
+    0xc2, 0x09, 0x02, 0xc3, 0xee, 0x1f, 0xa5, 0x65, 0x92, 0xa5, 0x12, 0x69, 0xda, 0x5b, 0x86, 0xb1,
+    0x1d, 0xd0, 0xd3, 0x6b, 0x56, 0xd2, 0x4c, 0x8d, 0x80, 0x8e, 0xbc, 0x77, 0x3a, 0x3e, 0x9a, 0x78,
+    0xc7, 0x02, 0x81, 0x8d, 0x6a, 0xe2, 0x80, 0x22, 0x26, 0xcb, 0xb9, 0x73, 0x2b, 0xcc, 0x7e, 0x70,
+    0x7a, 0x8c, 0x8a, 0x26, 0xbe, 0x83, 0x65, 0x7c, 0x9f, 0x5b, 0xac, 0xe1, 0x2c, 0x78, 0x54, 0xb0,
+    0xe5, 0x38, 0xe3, 0xae, 0x1d, 0x3b, 0x21, 0x0b, 0x72, 0xc1, 0x15, 0xfa, 0x2f, 0x6e, 0x64, 0xb4,
+    0x65, 0xf7, 0xc7, 0x41, 0x34, 0xb9, 0x92, 0x00, 0x3c, 0x8a, 0x82, 0xb1, 0x93, 0x2c, 0xff, 0x31,
+    0xb5, 0x26, 0x63, 0xbd, 0x49, 0x9c, 0x78, 0x80, 0x1f, 0xc3, 0x29, 0x7c, 0xe9, 0xe3, 0x1a, 0xa4,
+    0x8e, 0x65, 0xaa, 0x72, 0x98, 0x13, 0x2c, 0xa7, 0x25, 0xed, 0xdb, 0x38, 0x37, 0xa2, 0x43, 0xe9,
+    0x97, 0x66, 0x41, 0xff, 0x21, 0x98, 0xd4, 0x2b, 0x61, 0x4d, 0x50, 0x03, 0x74, 0xb4, 0x12, 0x87,
+    0x04, 0x1c, 0x27, 0x60, 0x25, 0x93, 0x64, 0x31, 0x1f, 0x37, 0x9a, 0xfc, 0x10, 0x27, 0x57, 0x74,
+    0xad, 0xb0, 0x25, 0xa9, 0xa9, 0x3a, 0x65, 0x95, 0x49, 0xca, 0x1e, 0xab, 0x0a, 0x60, 0xa7, 0x2c,
+    0xce, 0x60, 0x0e, 0xc7, 0x47, 0x47, 0xc7, 0x07, 0x35, 0x30, 0xa0, 0xfd, 0xba, 0x12, 0x96, 0x15,
+    0x5e, 0x8e, 0xf1, 0x43, 0x2f, 0xea, 0xa0, 0xcb, 0x5b, 0x96, 0xa8, 0xd4, 0x97, 0x80, 0xfe, 0x2f,
+    0x77, 0xc0, 0xf6, 0x51, 0x36, 0x21, 0x0f, 0x97, 0x99, 0x86, 0x9d, 0xa2, 0xdd, 0xe1, 0xe2, 0x55,
+    0x1b, 0x95, 0x3a, 0x9d, 0x38, 0xae, 0xbf, 0x48, 0x07, 0xc7, 0x6b, 0xad, 0xf2, 0xb4, 0x6c, 0x95,
+    0xe0, 0xa6, 0x86, 0x4d, 0x38, 0x7e, 0x04, 0x68, 0x15, 0xcb, 0x2c, 0x7c, 0x86, 0x62, 0xa0, 0x48,
+    0x6a, 0xc7, 0x99, 0xe0, 0x28, 0xcd, 0x75, 0x9f, 0x4c, 0x0e, 0x1c, 0xe6, 0xe6, 0xbe, 0xd2, 0xf3,
+    0x2a, 0xe0, 0xc2, 0xa0, 0x61, 0x39, 0xbc, 0x35, 0x00, 0x6a, 0x9c, 0x71, 0xc0, 0x5c, 0x4b, 0xc3,
+    0x71, 0xec, 0xee, 0x9f, 0xba, 0xcf, 0x8a, 0x81, 0x39, 0xd8, 0x32, 0x02, 0xc5, 0xf7, 0xf9, 0xdd,
+    0xc0, 0x3e, 0xcc, 0xd6, 0x0d, 0x68, 0x3a, 0xe0, 0x3a, 0xa2, 0x1b, 0xe6, 0x2a, 0x33, 0xdd, 0x38,
+    0x89, 0xe6, 0xeb, 0xbe, 0x1b, 0x1f, 0x1e, 0x1d, 0xf4, 0x9e, 0xd5, 0x93, 0x85, 0xc0, 0xd2, 0xcb,
+    0xa8, 0x43, 0x9e, 0xed, 0x1f, 0xf6, 0x7a, 0x99, 0x29, 0x4f, 0x9c, 0xc4, 0x5d, 0xae, 0x76, 0xc7,
+    0x52, 0x1e, 0xa7, 0x85, 0xb4, 0xaa, 0x9e, 0x19, 0x27, 0xf0, 0x80, 0xd0, 0xc1, 0xcc, 0x77, 0x5d,
+    0x26, 0xa3, 0x29, 0xc7, 0x75, 0x2d, 0x15, 0x6f, 0x23, 0x11, 0x02, 0xa1, 0x81, 0x13, 0xa7, 0x6c,
+    0x90, 0x7d, 0x91, 0xe0, 0xb3, 0xe5, 0xea, 0xc8, 0x5e, 0x55, 0xb4, 0xd3, 0x1a, 0x05, 0xa0, 0x68,
+    0x4c, 0xd2, 0xf5, 0xa2, 0x64, 0x3e, 0x58, 0xc4, 0x31, 0x4b, 0x26, 0x4e, 0xca, 0x86, 0x01, 0xe3,
+    0xa0, 0x00, 0x1d, 0xf4, 0x2d, 0xa8, 0x7e, 0x76, 0x0f, 0xd5, 0x27, 0x77, 0x77, 0xbd, 0x4c, 0x1b,
+    0x69, 0x3c, 0x29, 0xce, 0x00, 0xfd, 0x47, 0xb3, 0xa0, 0xca, 0xdd, 0x65, 0x15, 0xd3, 0xca, 0x91,
+    0x92, 0xb7, 0x72, 0x59, 0x6e, 0xdf, 0x3d, 0x72, 0xc7, 0x25, 0xfb, 0x91, 0x68, 0x13, 0x21, 0x37,
+    0xc4, 0xaf, 0xf2, 0x45, 0x9d, 0xda, 0xf6, 0x30, 0xe9, 0x5b, 0x96, 0xa3, 0x53, 0xa6, 0x09, 0x07,
+    0xde, 0x61, 0x1e, 0x0e, 0x08, 0xb2, 0x70, 0x17, 0x75, 0xf7, 0xf4, 0x68, 0xa4, 0x39, 0x14, 0x0f,
+    0xf2, 0xa5, 0x2a, 0x8e, 0xf1, 0xd8, 0xdb, 0x3f, 0xac, 0x83, 0xd0, 0x31, 0x79, 0x47, 0xcf, 0x58,
+    0x6f, 0x9c, 0xc1, 0xe1, 0x32, 0x4b, 0xee, 0xe3, 0x66, 0x06, 0x66, 0x4a, 0xc2, 0x61, 0xa0, 0xf3,
+    0x8a, 0xa3, 0x73, 0x28, 0x45, 0x4b, 0x3b, 0x13, 0x16, 0x04, 0xcb, 0x2a, 0x94, 0x2a, 0x2f, 0xf2,
+    0xcc, 0x35, 0xc3, 0x1a, 0x25, 0x07, 0xba, 0x9b, 0xc9, 0xa4, 0x89, 0x99, 0xd9, 0x71, 0x21, 0x4b,
+    0x69, 0x07, 0x25, 0x97, 0x4d, 0x8e, 0x48, 0xcf, 0x7f, 0x56, 0x06, 0xfe, 0x3a, 0xc2, 0x6a, 0x8c,
+    0x53, 0xda, 0x54, 0x4d, 0x56, 0xa0, 0x23, 0xb0, 0x5d, 0x16, 0x74, 0xd0, 0x85, 0x54, 0x51, 0x9c,
+    0x78, 0x7d, 0x50, 0xad, 0x5c, 0x11, 0x26, 0xce, 0x91, 0x93, 0xb9, 0x61, 0x36, 0x8f, 0xf9, 0xdd,
+    0x52, 0xe1, 0x9c, 0x74, 0x8e, 0xfa, 0x1a, 0x72, 0x1e, 0xf4, 0xf2, 0xe5, 0x62, 0xfe, 0x3f, 0xf0,
+    0x39, 0x0c, 0x9a, 0x48, 0x54, 0x41, 0x84, 0x19, 0x21, 0x85, 0x27, 0x3d, 0xda, 0x95, 0x63, 0xba,
+    0x9c, 0x22, 0x43, 0x7a, 0xd0, 0xcb, 0xe3, 0xa5, 0x40, 0x21, 0x9d, 0xc4, 0x01, 0x72, 0x5b, 0xc6,
+    0x8d, 0x83, 0x82, 0xf3, 0x24, 0x08, 0xdd, 0xdf, 0x48, 0x91, 0xf0, 0x28, 0xd6, 0x73, 0x9f, 0x92,
+    0xac, 0x8e, 0xc0, 0xe9, 0x38, 0xa1, 0x3f, 0x17, 0xb9, 0x79, 0x1a, 0xfb, 0xa1, 0x61, 0x9f, 0xa6,
+    0x06, 0xc6, 0x27, 0x27, 0x81, 0x1a, 0xc8, 0xc3, 0x32, 0x48, 0xba, 0x9f, 0x7f, 0xbb, 0x62, 0x77,
+    0x5e, 0x02, 0xea, 0x9b, 0x1a, 0x08, 0xb8, 0xe4, 0xd1, 0xb2, 0xf0, 0x24, 0x49, 0xc4, 0x1d, 0xce,
+    0x5a, 0x07, 0xc7, 0x3d, 0x97, 0x4d, 0xad, 0xfb, 0xcc, 0xc1, 0x3a, 0xee, 0xb4, 0x48, 0x7e, 0xfc,
+    0x90, 0xe2, 0x1e, 0xe5, 0x40, 0x85, 0x6f, 0x01, 0xd2, 0x4f, 0x2a, 0x3a, 0xd4, 0xef, 0xe9, 0x4a,
+    0x74, 0x52, 0xe3, 0xcb, 0xd4, 0x2c, 0x1a, 0x79, 0x01, 0x22, 0xe6, 0x3e, 0x54, 0x6b, 0x52, 0x6a,
+    0x73, 0x70, 0xb4, 0x01, 0x53, 0x09, 0xe9, 0xb0, 0x78, 0x31, 0xd6, 0xb4, 0xa0, 0x77, 0x7c, 0xe4,
+    0x1d, 0x1e, 0xe7, 0x92, 0x65, 0xec, 0x64, 0x7c, 0xa2, 0x8d, 0x00, 0x9b, 0xd5, 0xd5, 0xe6, 0xf4,
+    0xe0, 0xa8, 0xe7, 0x15, 0x6a, 0xe3, 0x1e, 0x1c, 0xca, 0xc8, 0xd3, 0xfd, 0xc1, 0xf8, 0x29, 0x72,
+    0x9d, 0x20, 0x35, 0x7e, 0xe8, 0x0a, 0x0c, 0xa8, 0x73, 0xb0, 0x6c, 0x2d, 0x37, 0x1c, 0xc6, 0x91,
+    0x54, 0x7c, 0xcf, 0xbf, 0x85, 0x48, 0xe9, 0x87, 0x50, 0xa6, 0x42, 0x3d, 0xa8, 0xcc, 0x91, 0x4c,
+    0xc7, 0x4e, 0xab, 0xd7, 0xc6, 0xff, 0xd9, 0xc7, 0xd6, 0xf0, 0xf7, 0x8e, 0x0f, 0x15, 0xd3, 0x2d,
+    0xc6, 0x87, 0x55, 0x5a, 0x53, 0x0d, 0xe4, 0xf7, 0x1a, 0x05, 0x76, 0x14, 0xb3, 0x50, 0xd3, 0x3f,
+    0x79, 0x7f, 0x8e, 0x04, 0xaf, 0x0e, 0x6c, 0x35, 0x61, 0xac, 0x46, 0x4a, 0x99, 0x20, 0xf7, 0x0f,
+    0x29, 0xeb, 0xcc, 0x32, 0xe9, 0xc3, 0xc3, 0x22, 0x93, 0x7e, 0xb6, 0xff, 0x7d, 0xb1, 0xf0, 0x84,
+    0x05, 0x0e, 0xe6, 0xc4, 0x2a, 0x0d, 0xc6, 0xec, 0x60, 0xa9, 0x17, 0x58, 0xd5, 0xf4, 0x75, 0xa8,
+    0x56, 0x64, 0xfd, 0x2c, 0x08, 0x88, 0xf1, 0x9d, 0xdb, 0x65, 0x8e, 0xdf, 0x19, 0x03, 0xc9, 0x0b,
+    0xce, 0x86, 0xa0, 0xfb, 0x54, 0xbf, 0x0c, 0x13, 0x91, 0x67, 0x51, 0xd4, 0xd9, 0x5c, 0x01, 0x49,
+    0xfb, 0x56, 0x67, 0x3b, 0x44, 0x0f, 0xa6, 0xbb, 0x40, 0x2d, 0x83, 0xd3, 0x49, 0x59, 0x5d, 0xb3,
+    0xc8, 0xc5, 0x06, 0xce, 0x58, 0x29, 0x19, 0x84, 0x39, 0xac, 0x8e, 0xe2, 0xe8, 0x3e, 0x75, 0x6e,
+    0xa0, 0xb2, 0xdf, 0x00, 0xe1, 0x1d, 0xcc, 0x50, 0xaf, 0x06, 0xf4, 0xd9, 0xc1, 0x0b, 0xda, 0x2c,
+    0x7e, 0x18, 0x2f, 0xf8, 0x67, 0x7e, 0x17, 0xb3, 0x11, 0xfa, 0xb2, 0x2f, 0xed, 0xea, 0x75, 0xcf,
+    0x0f, 0xd8, 0x17, 0x35, 0xff, 0xc8, 0x64, 0xf9, 0x0c, 0xa3, 0xf4, 0x7e, 0x7c, 0x5b, 0xd7, 0x49,
+    0x68, 0xa8, 0x1b, 0x94, 0x9d, 0x56, 0x33, 0xe6, 0x22, 0x07, 0x2e, 0x49, 0x38, 0xaf, 0x57, 0x57,
+    0x90, 0x3f, 0xf0, 0xa2, 0xc9, 0x22, 0x5d, 0x46, 0x0b, 0x8e, 0xac, 0xd7, 0xf2, 0xe1, 0xba, 0xe2,
+    0x4e, 0x20, 0xa1, 0x94, 0x5a, 0x59, 0xdf, 0x06, 0xb7, 0x5b, 0xf6, 0x3a, 0x58, 0xd9, 0x56, 0xf0,
+    0xed, 0x11, 0x52, 0x49, 0x3d, 0xea, 0x98, 0x52, 0xdb, 0x40, 0x3e, 0xe9, 0x3a, 0xe1, 0xb4, 0x9c,
+    0x4b, 0x3e, 0xeb, 0x8f, 0xfb, 0xe3, 0xda, 0x58, 0x53, 0x8c, 0x58, 0x19, 0xa3, 0x14, 0xc8, 0x89,
+    0x13, 0x42, 0x5c, 0x5b, 0x13, 0x0a, 0x45, 0xb6, 0x54, 0x19, 0x51, 0x83, 0x5b, 0xab, 0x74, 0xe2,
+    0x24, 0x9a, 0x26, 0x2c, 0x4d, 0xf5, 0x40, 0x45, 0x2c, 0x56, 0xd6, 0xd9, 0x2f, 0x82, 0x52, 0x3e,
+    0x00, 0xeb, 0xd7, 0xcc, 0x0a, 0x4e, 0x4b, 0xfa, 0x52, 0xab, 0x16, 0xa0, 0x59, 0xf5, 0xb9, 0x70,
+    0x81, 0x13, 0xb4, 0x32, 0x58, 0x16, 0xdd, 0xa9, 0xef, 0x87, 0x35, 0x15, 0x86, 0x2c, 0x3e, 0xbf,
+    0x57, 0x53, 0x09, 0xba, 0x66, 0xd8, 0x07, 0x69, 0x19, 0x21, 0xd5, 0x63, 0xd5, 0x78, 0x5e, 0xdf,
+    0xa2, 0x91, 0x16, 0xa8, 0xac, 0xbb, 0x28, 0x9d, 0xb1, 0x56, 0xd0, 0xaa, 0x3b, 0xef, 0xf4, 0xa4,
+    0x7f, 0xd2, 0x5f, 0x11, 0x99, 0xa8, 0x86, 0xcb, 0x0b, 0x43, 0xf0, 0xce, 0x1d, 0xca, 0x45, 0xb5,
+    0xfc, 0xb2, 0x32, 0xb4, 0x62, 0xd7, 0x90, 0x20, 0x69, 0xf8, 0x8c, 0xa2, 0x94, 0xf7, 0xa2, 0x88,
+    0x67, 0x1d, 0x36, 0x6d, 0x65, 0x6a, 0x9b, 0x62, 0xa8, 0x95, 0xb6, 0xe5, 0x45, 0x2b, 0xcb, 0xc4,
+    0x06, 0x87, 0x8a, 0xb7, 0x48, 0x63, 0x85, 0x47, 0x94, 0x49, 0xc0, 0x9c, 0xb9, 0xbe, 0xd3, 0x2a,
+    0xfc, 0x3c, 0x10, 0x1d, 0xdf, 0x5a, 0x4b, 0xba, 0xa9, 0x35, 0x55, 0x54, 0xa3, 0xba, 0x97, 0xb7,
+    0x95, 0x5e, 0x94, 0x5e, 0x11, 0xec, 0x57, 0x73, 0xc6, 0x6c, 0x0c, 0x9f, 0xb5, 0x95, 0x02, 0x02,
+    0x79, 0x70, 0xba, 0x1a, 0x38, 0x6f, 0xaa, 0x60, 0x25, 0x7b, 0x5c, 0x4c, 0xac, 0xd5, 0xd6, 0x27,
+    0x38, 0x63, 0xc9, 0xd4, 0x4f, 0x15, 0x1c, 0x22, 0x2c, 0x56, 0x7b, 0x3d, 0x79, 0xb7, 0xb2, 0x52,
+    0xcd, 0xe8, 0xf7, 0xcb, 0xed, 0xc3, 0x5e, 0x4e, 0x20, 0x7e, 0x9e, 0x75, 0x45, 0xa3, 0x18, 0xbe,
+    0x88, 0x8e, 0x35, 0x36, 0x7f, 0x45, 0xf7, 0x9a, 0x25, 0xe7, 0x67, 0xae, 0x7f, 0x0d, 0x3f, 0xfa,
+    0x59, 0x97, 0x19, 0x80, 0xfa, 0xe7, 0x67, 0x5d, 0xba, 0x0a, 0x99, 0x7d, 0x68, 0x4c, 0x02, 0x27,
+    0x4d, 0x47, 0xbb, 0x60, 0x42, 0xbb, 0x86, 0xef, 0x8e, 0x76, 0x67, 0x6e, 0xd2, 0x81, 0x1f, 0x29,
+    0x58, 0xc0, 0x2e, 0x00, 0x22, 0xcc, 0xb9, 0xc0, 0x8c, 0xd8, 0x90, 0xe1, 0x08, 0x05, 0x95, 0x66,
+    0x0a, 0xb7, 0x05, 0xef, 0x0d, 0xd7, 0xe1, 0x4e, 0x07, 0x2e, 0x8d, 0x76, 0xc7, 0x51, 0x74, 0x95,
+    0xee, 0x66, 0x48, 0x45, 0xb3, 0x6a, 0xf7, 0xfc, 0x05, 0x5e, 0x3d, 0xeb, 0x0a, 0xe8, 0x9a, 0x51,
+    0x69, 0xc0, 0x58, 0xbc, 0x7b, 0xfe, 0x01, 0xff, 0xac, 0x01, 0x43, 0x1e, 0xc0, 0xac, 0xd8, 0xaf,
+    0x5e, 0x87, 0x8d, 0xcf, 0x18, 0xe4, 0x94, 0xbb, 0xe7, 0x1f, 0xe9, 0xef, 0x1a, 0x40, 0x08, 0x94,
+    0x4e, 0x00, 0xe4, 0xbd, 0xa5, 0xbf, 0xeb, 0x26, 0xf6, 0x93, 0x39, 0xd8, 0x2a, 0x80, 0x5e, 0xca,
+    0x6f, 0x05, 0x70, 0x17, 0x58, 0x42, 0x5c, 0xce, 0x16, 0x9d, 0x6b, 0xec, 0xae, 0x76, 0x99, 0xda,
+    0x77, 0x86, 0xe4, 0x08, 0xf1, 0x90, 0xae, 0x74, 0x04, 0xc7, 0x34, 0x50, 0xa9, 0x73, 0xb5, 0x17,
+    0x29, 0x3d, 0xd5, 0xef, 0x14, 0x7d, 0x25, 0x81, 0x97, 0x30, 0x76, 0xe8, 0x02, 0x22, 0x16, 0xb2,
+    0x16, 0x9f, 0x35, 0xf8, 0x28, 0x99, 0x29, 0x44, 0x99, 0xe1, 0xe4, 0xa1, 0x51, 0x34, 0x59, 0x76,
+    0x8d, 0x28, 0x9c, 0x40, 0x15, 0x72, 0x35, 0xda, 0xc5, 0xd4, 0xef, 0x53, 0x8c, 0x45, 0x44, 0xcb,
+    0xa4, 0x89, 0x4c, 0x6b, 0xf7, 0x5c, 0x5c, 0xa8, 0x30, 0xb0, 0x84, 0x0b, 0xbd, 0x5d, 0x09, 0xd3,
+    0x65, 0x14, 0x80, 0x5a, 0x29, 0x98, 0x7e, 0x66, 0x37, 0x86, 0xb8, 0xa8, 0x70, 0xb8, 0x7e, 0x01,
+    0xd8, 0x44, 0x91, 0x8c, 0x28, 0x56, 0x4d, 0x1d, 0x10, 0x9d, 0x3d, 0x4a, 0xcd, 0x54, 0x77, 0xa3,
+    0xc4, 0xa1, 0xea, 0x67, 0x59, 0x86, 0xaa, 0xf0, 0xa4, 0xe2, 0x6e, 0x2b, 0x3c, 0xd5, 0xf0, 0xf2,
+    0x0e, 0x1f, 0x98, 0xc9, 0x4f, 0xef, 0x0c, 0x28, 0x9d, 0xa6, 0x58, 0x10, 0xcd, 0xa2, 0x9b, 0xd0,
+    0xb8, 0x99, 0x31, 0x50, 0x43, 0xda, 0x46, 0x32, 0x68, 0xaa, 0xd4, 0x36, 0x3e, 0x30, 0x2e, 0xbe,
+    0x1b, 0xe0, 0x56, 0x98, 0xc1, 0x23, 0x63, 0xf7, 0x25, 0x64, 0x21, 0xd1, 0x1c, 0xe8, 0x0a, 0x0d,
+    0xc8, 0xfe, 0x39, 0x78, 0x92, 0xd4, 0xce, 0x2d, 0xf7, 0x0f, 0x90, 0x3b, 0x4d, 0x5f, 0x27, 0xf7,
+    0x66, 0x92, 0xa2, 0xe1, 0xdf, 0x5a, 0x52, 0xd2, 0x77, 0x3c, 0xa2, 0x99, 0x11, 0xc6, 0x6f, 0x61,
+    0x66, 0x34, 0xd1, 0xa3, 0x98, 0x59, 0x8e, 0xe9, 0xe1, 0x66, 0x26, 0x56, 0xfd, 0x8d, 0x85, 0x97,
+    0x79, 0xf4, 0x47, 0xb2, 0x33, 0x0a, 0x0c, 0x06, 0x16, 0x2b, 0xa9, 0xd1, 0xb2, 0x09, 0xb9, 0x05,
+    0x49, 0x4a, 0x62, 0x4c, 0xc8, 0x90, 0x8c, 0x97, 0xff, 0xfe, 0x77, 0x03, 0xd7, 0x69, 0x88, 0x79,
+    0xff, 0x50, 0x5b, 0x12, 0x53, 0x3c, 0xdc, 0x98, 0xc4, 0xf8, 0x6f, 0x2d, 0x90, 0x2c, 0x72, 0x3e,
+    0x92, 0x40, 0xde, 0x42, 0xc5, 0xb2, 0x00, 0xbf, 0x67, 0x08, 0xbc, 0x24, 0x1a, 0x94, 0xcc, 0x2d,
+    0xb7, 0x6c, 0xe3, 0x3d, 0x4b, 0xb9, 0x93, 0xf0, 0xcc, 0x0f, 0x3a, 0x1e, 0xe6, 0x92, 0x93, 0x19,
+    0x16, 0x39, 0x7f, 0x8c, 0x68, 0x44, 0x3a, 0x20, 0x05, 0xf4, 0x60, 0xc1, 0x88, 0xa5, 0x74, 0xe8,
+    0xaa, 0x41, 0x19, 0x1a, 0x32, 0x4f, 0xb6, 0x36, 0x20, 0xcf, 0xfb, 0x86, 0xae, 0x2f, 0xcf, 0x5e,
+    0x1e, 0x49, 0x5c, 0x59, 0x12, 0x64, 0x8c, 0xfd, 0xd0, 0x49, 0xee, 0x40, 0x52, 0xf0, 0x05, 0x24,
+    0xf5, 0x63, 0x84, 0xe1, 0xe8, 0x83, 0x0c, 0x41, 0xc6, 0xb9, 0x91, 0x03, 0x7e, 0x8a, 0x21, 0x99,
+    0xa2, 0x60, 0xe5, 0x01, 0xb6, 0x99, 0x14, 0xe2, 0x82, 0x18, 0xfb, 0x87, 0xc8, 0x30, 0x9b, 0xf9,
+    0x1f, 0x95, 0x62, 0xc6, 0xbb, 0x6f, 0x25, 0xc7, 0x0a, 0x3d, 0xb2, 0xe5, 0x26, 0xe4, 0x29, 0x18,
+    0x46, 0x6d, 0x41, 0x1d, 0xfb, 0x5c, 0x5e, 0xd2, 0x39, 0x24, 0xfb, 0x47, 0x0a, 0x6b, 0x26, 0x41,
+    0x94, 0x32, 0x1a, 0xdf, 0x32, 0x15, 0x64, 0xe8, 0x7e, 0x9e, 0x72, 0x1f, 0x1c, 0xc9, 0xb0, 0x60,
+    0xd0, 0xec, 0x40, 0x99, 0xf3, 0x23, 0x9e, 0x49, 0xc9, 0x98, 0x08, 0x72, 0xc5, 0x74, 0x79, 0x76,
+    0x70, 0x7e, 0x46, 0xad, 0x27, 0x05, 0xee, 0x6f, 0x3e, 0x88, 0xe2, 0xfc, 0x03, 0x0b, 0xd8, 0x84,
+    0x1b, 0x0e, 0x19, 0xf2, 0x59, 0x97, 0x80, 0xce, 0xcf, 0xa8, 0x03, 0x63, 0x50, 0x07, 0x66, 0x17,
+    0x6f, 0xa8, 0x6b, 0x42, 0x8c, 0x6f, 0xf0, 0x3e, 0x11, 0x4b, 0xc6, 0x0d, 0x6b, 0x0f, 0xf1, 0xb2,
+    0x40, 0xc6, 0x48, 0x88, 0x1b, 0x54, 0xa0, 0xc0, 0xf7, 0x82, 0xab, 0x31, 0xd0, 0x8d, 0x72, 0x3d,
+    0x30, 0xb2, 0xdd, 0xbf, 0x8a, 0x42, 0xa8, 0x26, 0xa4, 0xf6, 0x2f, 0x54, 0xb4, 0xef, 0xe4, 0x8d,
+    0xdd, 0x7a, 0xf0, 0x8a, 0x3d, 0x69, 0x3d, 0x88, 0xd2, 0x7a, 0x83, 0xd5, 0x49, 0x83, 0xd6, 0x69,
+    0x50, 0x87, 0x7d, 0x24, 0xfb, 0xdb, 0x5a, 0x6f, 0x3c, 0x0a, 0xf5, 0x8f, 0xa4, 0x37, 0x0a, 0xb2,
+    0x15, 0x7a, 0xa3, 0xa5, 0x17, 0xba, 0x96, 0x88, 0xc1, 0x42, 0x4b, 0x04, 0x04, 0x9d, 0xa2, 0xaa,
+    0xd5, 0x91, 0x62, 0xf1, 0x62, 0xd4, 0xcf, 0x00, 0x28, 0x75, 0x24, 0x0e, 0x9c, 0x09, 0x9b, 0xd1,
+    0x55, 0x20, 0xf7, 0xae, 0x23, 0x00, 0x76, 0x1b, 0xa6, 0x44, 0x6e, 0xf4, 0x12, 0x72, 0x39, 0xce,
+    0x64, 0x5a, 0x04, 0x8b, 0x10, 0xbf, 0x37, 0x3a, 0x07, 0x8d, 0xa9, 0x09, 0x43, 0xca, 0x1f, 0x89,
+    0xa9, 0x0a, 0xb2, 0x55, 0x4c, 0x7d, 0xcf, 0x04, 0xa7, 0x72, 0x86, 0x12, 0x9b, 0x1b, 0x70, 0x4f,
+    0xe0, 0x16, 0x9c, 0xd3, 0x61, 0x44, 0xbf, 0x4c, 0x85, 0x7a, 0xe7, 0xf0, 0x59, 0x73, 0x4f, 0xeb,
+    0x46, 0x82, 0x28, 0x64, 0x61, 0x46, 0xde, 0x36, 0x2c, 0x74, 0xc1, 0xb4, 0xf9, 0x63, 0xb1, 0x50,
+    0x41, 0xb6, 0x8a, 0x85, 0xaf, 0x08, 0x44, 0xb0, 0x30, 0xce, 0xb0, 0xe6, 0x4d, 0x38, 0x4c, 0x0c,
+    0xfd, 0xd4, 0x10, 0x3b, 0x7e, 0xc6, 0xc4, 0x09, 0xc3, 0x88, 0x1b, 0x63, 0x66, 0x2c, 0x42, 0x37,
+    0x0a, 0x19, 0x84, 0xa9, 0x58, 0x19, 0x95, 0xf7, 0xdf, 0xd4, 0x95, 0xbc, 0x81, 0x8b, 0xa8, 0xa5,
+    0x68, 0xa2, 0xf1, 0x6a, 0x56, 0x0b, 0x60, 0xc9, 0xea, 0xf5, 0x40, 0x1f, 0xe1, 0xfa, 0x4a, 0x79,
+    0x88, 0x46, 0xaf, 0x26, 0x0f, 0xb1, 0x42, 0x94, 0x47, 0xb6, 0xd6, 0xf5, 0xc5, 0x82, 0xe8, 0xe7,
+    0x36, 0xe3, 0xe8, 0x4b, 0x82, 0xdd, 0x4e, 0xc2, 0x81, 0x92, 0x4b, 0x3d, 0x92, 0x9c, 0x2b, 0x28,
+    0x57, 0x49, 0x5b, 0x06, 0x2b, 0x91, 0xce, 0x95, 0x63, 0x56, 0x11, 0xa3, 0x30, 0xcd, 0x54, 0x13,
+    0xcf, 0x0d, 0xf1, 0x4a, 0x40, 0x2a, 0xf1, 0x0a, 0xad, 0x22, 0xe6, 0xa3, 0x5d, 0xc4, 0xa3, 0x47,
+    0xaf, 0xb7, 0x39, 0xe8, 0x96, 0x31, 0x4c, 0x5d, 0x62, 0x39, 0x92, 0x95, 0xb2, 0xd3, 0x87, 0xc6,
+    0x33, 0x31, 0xc5, 0x23, 0xc4, 0xb3, 0x9c, 0x1f, 0xdb, 0xc5, 0x33, 0x31, 0xec, 0xa1, 0xf1, 0x4c,
+    0xcb, 0xee, 0x1e, 0x2b, 0xae, 0x55, 0x91, 0x6e, 0xd0, 0xac, 0x3c, 0xbd, 0x5d, 0xad, 0x5b, 0x90,
+    0x18, 0x1b, 0x19, 0xe2, 0x26, 0xda, 0x95, 0xc1, 0xd6, 0xe9, 0x17, 0xe0, 0x2a, 0x67, 0x47, 0x05,
+    0xf0, 0x96, 0x1a, 0xa6, 0x2f, 0xb6, 0xac, 0x63, 0x95, 0xec, 0xf9, 0xa1, 0x5a, 0x96, 0x4d, 0xf3,
+    0x08, 0x7a, 0xa6, 0x70, 0x66, 0x3b, 0x4d, 0xcb, 0x06, 0x6e, 0xd0, 0x35, 0xb1, 0x49, 0x71, 0x7e,
+    0xe6, 0x18, 0xb3, 0x84, 0x79, 0xe0, 0x8b, 0x39, 0x8f, 0xd3, 0x41, 0xb7, 0x3b, 0xf5, 0xf9, 0x6c,
+    0x31, 0xb6, 0x27, 0xd1, 0xbc, 0x3b, 0xf6, 0xa7, 0x63, 0x67, 0xda, 0x8d, 0x45, 0x27, 0xbd, 0x93,
+    0x30, 0x91, 0xd2, 0x97, 0xcf, 0x6f, 0x3b, 0x80, 0x52, 0x62, 0x33, 0xce, 0xd2, 0x49, 0xe2, 0xc7,
+    0xfc, 0x7c, 0xe7, 0xda, 0x49, 0x64, 0xf3, 0xf7, 0xa3, 0x33, 0x36, 0x46, 0x86, 0x6c, 0x79, 0x0e,
+    0xe9, 0x06, 0x7d, 0xc7, 0x78, 0x80, 0x37, 0xba, 0xf2, 0x22, 0x75, 0x5a, 0xf2, 0x8b, 0x93, 0x28,
+    0xf4, 0xfc, 0x69, 0x57, 0x74, 0x70, 0x86, 0x3b, 0x04, 0xf1, 0xf1, 0xf9, 0x8b, 0xff, 0x7e, 0x79,
+    0xf9, 0x23, 0xdc, 0xc7, 0xed, 0x12, 0x42, 0x32, 0x30, 0x8c, 0xe5, 0xd8, 0x49, 0xd9, 0x00, 0xd0,
+    0xb4, 0x0d, 0xf5, 0x3f, 0xa1, 0x46, 0x03, 0xd3, 0xc6, 0x43, 0x0b, 0x6d, 0xdb, 0x1b, 0xef, 0xb7,
+    0xed, 0x5b, 0x3e, 0xa1, 0x8f, 0x19, 0x7e, 0x4e, 0xf1, 0x03, 0xbe, 0x81, 0x1b, 0x83, 0x0f, 0x86,
+    0x9f, 0x73, 0x17, 0xfe, 0xef, 0x24, 0x57, 0x6e, 0x74, 0x13, 0xb6, 0x6d, 0x3c, 0x1f, 0x4f, 0x9f,
+    0x6d, 0xfb, 0xb7, 0x78, 0x8a, 0x1f, 0x0c, 0x3e, 0xe3, 0x10, 0x3e, 0xc6, 0xf3, 0x18, 0xa6, 0x1b,
+    0x27, 0xd1, 0x0d, 0xa9, 0xc9, 0x80, 0x27, 0x0b, 0x76, 0xdf, 0x06, 0xa2, 0xa8, 0xd7, 0xa7, 0x10,
+    0x25, 0x5a, 0x87, 0xed, 0x0a, 0x51, 0x65, 0x04, 0x9e, 0x13, 0xa4, 0x02, 0x03, 0xad, 0x58, 0xc1,
+    0xa0, 0x31, 0xa2, 0xad, 0x2e, 0xcb, 0xc5, 0x6b, 0x6d, 0x34, 0x93, 0x7a, 0x5a, 0x44, 0xab, 0x64,
+    0x50, 0xc6, 0x24, 0x3b, 0x30, 0xed, 0x1c, 0x13, 0x5d, 0xa8, 0xa1, 0x66, 0xe7, 0x1e, 0xf8, 0xde,
+    0xed, 0x1a, 0x9d, 0x4e, 0xc7, 0xf8, 0xc4, 0xfd, 0xc0, 0xe7, 0x3e, 0x4b, 0xf1, 0xd7, 0x8e, 0xb7,
+    0x08, 0x45, 0xd2, 0xe0, 0xcd, 0xf9, 0x07, 0xff, 0x77, 0xd6, 0x1a, 0x5b, 0x4b, 0xdf, 0x6b, 0x3d,
+    0x19, 0x5b, 0x09, 0xe3, 0x8b, 0x24, 0x34, 0x7b, 0xc6, 0x0b, 0x73, 0x88, 0x22, 0xbb, 0x1a, 0xf5,
+    0x7b, 0xfb, 0x87, 0xed, 0xc5, 0xe8, 0xb3, 0xf9, 0xc2, 0x6c, 0x9b, 0x7f, 0xc7, 0x8f, 0x9f, 0xf0,
+    0xe3, 0xc7, 0x17, 0xe6, 0x17, 0x82, 0xf0, 0x47, 0x3f, 0x81, 0xcc, 0x6d, 0x2f, 0x88, 0xa2, 0xa4,
+    0x45, 0x5f, 0x83, 0x68, 0x0a, 0x08, 0xbb, 0xf9, 0xf7, 0x2b, 0xcb, 0x1a, 0x0a, 0xbc, 0x46, 0x8c,
+    0x8f, 0x25, 0x5c, 0x82, 0x45, 0xf2, 0x56, 0x6b, 0x2c, 0x20, 0xe2, 0xe8, 0xa6, 0x75, 0xd5, 0xf6,
+    0x2d, 0xcb, 0xe6, 0x60, 0xc7, 0xb7, 0xe0, 0x11, 0xfa, 0x96, 0xb5, 0x67, 0x1a, 0xe6, 0xde, 0xe2,
+    0xb3, 0xff, 0xe5, 0xbe, 0xa0, 0x35, 0x8e, 0x52, 0xde, 0x5a, 0x24, 0x41, 0x1b, 0x90, 0x38, 0xf3,
+    0xd4, 0x5a, 0x4a, 0x9c, 0x21, 0x64, 0x95, 0x60, 0xaf, 0x73, 0x3f, 0x65, 0xad, 0x0c, 0xb8, 0x15,
+    0x5d, 0xb5, 0x3d, 0xc7, 0x0f, 0xac, 0x25, 0x69, 0xa6, 0x3b, 0x0a, 0x29, 0xc3, 0x4f, 0xe6, 0xaf,
+    0x1c, 0xee, 0xb4, 0xac, 0xa1, 0x07, 0xb4, 0xd2, 0xf2, 0xb0, 0x07, 0x2d, 0xf1, 0x79, 0xae, 0xed,
+    0xc4, 0x50, 0x8a, 0xbb, 0x40, 0x8e, 0xb8, 0xf4, 0xf9, 0xea, 0x8b, 0x45, 0x6b, 0xbc, 0xa5, 0xf1,
+    0xff, 0xf9, 0xd3, 0xdb, 0xbf, 0x81, 0x91, 0xbd, 0x67, 0xff, 0xb3, 0x60, 0x40, 0x8a, 0x35, 0xbc,
+    0xa5, 0x83, 0x25, 0x2d, 0xf3, 0xdd, 0x2f, 0x1f, 0x3e, 0x9a, 0x6d, 0x24, 0x0d, 0x65, 0x47, 0xd7,
+    0x43, 0xf4, 0x3a, 0xa3, 0x9c, 0x1c, 0x6b, 0x79, 0x6b, 0xa7, 0xdc, 0xe1, 0x8b, 0xf4, 0xec, 0xa0,
+    0xd7, 0xbb, 0x88, 0xae, 0x5a, 0xb7, 0x36, 0x98, 0x7d, 0x1c, 0x85, 0x29, 0xd9, 0xb9, 0x35, 0x40,
+    0x6a, 0xcb, 0x17, 0xef, 0x09, 0x13, 0x4b, 0x92, 0x28, 0x51, 0x51, 0x11, 0xa8, 0xf9, 0x33, 0xe3,
+    0x37, 0x51, 0x72, 0x65, 0xd0, 0x6d, 0x93, 0x60, 0x53, 0x24, 0xde, 0x73, 0xad, 0x7b, 0x4b, 0x61,
+    0xdb, 0x94, 0x71, 0x34, 0xca, 0x16, 0x77, 0xc6, 0x39, 0xcb, 0x70, 0x93, 0x68, 0x34, 0x92, 0x26,
+    0x7d, 0x91, 0x5b, 0xf3, 0x40, 0x5e, 0x17, 0xba, 0x7a, 0x91, 0x1b, 0xf4, 0x40, 0x1a, 0xee, 0x67,
+    0xb8, 0xff, 0xc5, 0x46, 0x6d, 0xbc, 0xdf, 0x29, 0x26, 0xf0, 0xd3, 0x4f, 0x61, 0xba, 0x88, 0xf1,
+    0x91, 0x12, 0xe6, 0xbe, 0xfc, 0xed, 0xaa, 0x35, 0x89, 0x69, 0x3b, 0x54, 0xcc, 0x05, 0xbf, 0xce,
+    0x47, 0xbd, 0xdb, 0xc3, 0xd7, 0xbd, 0xde, 0xd3, 0xa7, 0x93, 0xf8, 0x0c, 0xbe, 0x3f, 0xbb, 0xbc,
+    0xbc, 0xb4, 0xbe, 0x7e, 0x95, 0x77, 0x0e, 0x0e, 0x8b, 0x3b, 0x87, 0xaf, 0x5e, 0xe0, 0x1d, 0xda,
+    0x2a, 0x94, 0xb7, 0x2f, 0x9f, 0x15, 0xb7, 0x2f, 0x9f, 0x6b, 0x03, 0x7b, 0x87, 0xf9, 0x9d, 0x83,
+    0xde, 0xb3, 0xf2, 0xc0, 0x83, 0xde, 0x73, 0xe5, 0xb6, 0x3a, 0xf0, 0xf9, 0xcb, 0x02, 0xe5, 0xab,
+    0x93, 0xe7, 0xe5, 0x81, 0xfb, 0xbd, 0x5e, 0x71, 0x7f, 0xff, 0xf9, 0xf1, 0x2b, 0x65, 0xe8, 0xe5,
+    0xa5, 0x42, 0xcd, 0xe5, 0xeb, 0x4b, 0x6b, 0xb8, 0xa3, 0xb2, 0xe2, 0xda, 0x09, 0x7c, 0x6c, 0x1c,
+    0x61, 0x80, 0xc3, 0xbc, 0xba, 0x85, 0x09, 0x37, 0x31, 0x03, 0xb5, 0x28, 0x04, 0xfd, 0x03, 0x80,
+    0xdf, 0x19, 0xa8, 0x23, 0x5c, 0xb7, 0xf3, 0xdf, 0x17, 0xfa, 0x4f, 0x90, 0xed, 0xe5, 0x4b, 0xd3,
+    0x1a, 0xe0, 0xd5, 0x21, 0x8c, 0x45, 0xcb, 0x2c, 0xc6, 0x4a, 0x13, 0x5d, 0xe2, 0xdd, 0x41, 0x71,
+    0xb9, 0x4d, 0x7a, 0x30, 0x30, 0x5f, 0x87, 0xb4, 0x75, 0x4d, 0x75, 0x96, 0x79, 0x2f, 0x87, 0x77,
+    0x3f, 0xff, 0x7a, 0xdb, 0xeb, 0x75, 0x7e, 0xbd, 0xed, 0x5f, 0xee, 0xfe, 0xf0, 0x6b, 0x77, 0x70,
+    0x76, 0x7e, 0xf1, 0xeb, 0xaf, 0x5f, 0xbf, 0x74, 0xc1, 0x6d, 0x82, 0x22, 0x2b, 0xb8, 0xbf, 0x7e,
+    0x2d, 0x7e, 0xd8, 0xf8, 0x10, 0xd1, 0x73, 0xde, 0xea, 0x59, 0xa8, 0x13, 0xb6, 0x29, 0xf7, 0xb8,
+    0xd7, 0x4f, 0xff, 0x26, 0x24, 0x1e, 0xd0, 0x03, 0x48, 0x10, 0x3e, 0x58, 0x92, 0xa2, 0x85, 0x15,
+    0xc4, 0xdc, 0x93, 0x87, 0x14, 0xc6, 0x37, 0x99, 0x19, 0x91, 0xa7, 0x70, 0x45, 0x4e, 0x00, 0xf4,
+    0x56, 0x55, 0x6a, 0x06, 0x01, 0xcd, 0x65, 0xef, 0xf0, 0xf0, 0x11, 0x91, 0x64, 0xe5, 0x3b, 0xee,
+    0xeb, 0xe9, 0xa1, 0xd6, 0x38, 0x48, 0x23, 0xa4, 0x63, 0x7b, 0x98, 0xd4, 0x60, 0x91, 0x94, 0xe3,
+    0x16, 0x44, 0x09, 0xb2, 0xee, 0x05, 0xaf, 0xd0, 0xd2, 0xd1, 0xfa, 0x5e, 0x87, 0x38, 0x23, 0x54,
+    0xdb, 0x36, 0xa3, 0x6f, 0x2a, 0x9b, 0x6c, 0x40, 0x38, 0xe5, 0xb3, 0xf3, 0xfd, 0xa3, 0xa3, 0x46,
+    0x5c, 0x41, 0x5d, 0x00, 0x3b, 0x31, 0x78, 0x14, 0x41, 0xe6, 0x1e, 0x4e, 0x0b, 0x5e, 0xac, 0x1f,
+    0x87, 0x70, 0xf7, 0xb9, 0x0f, 0x87, 0x40, 0x2c, 0xdc, 0xb7, 0x1b, 0x4d, 0x16, 0x73, 0x48, 0x8d,
+    0x6c, 0xb0, 0xed, 0xd7, 0x01, 0xc3, 0xaf, 0x2f, 0xee, 0xde, 0x60, 0x73, 0x1e, 0x20, 0x4c, 0xcb,
+    0x76, 0x5c, 0xf7, 0xf5, 0x35, 0x5c, 0x7c, 0xeb, 0xa7, 0x9c, 0x85, 0xb8, 0x91, 0x42, 0x99, 0x92,
+    0xd9, 0xce, 0x9d, 0x88, 0x50, 0x4a, 0x58, 0x2d, 0xb3, 0xb9, 0x93, 0x00, 0x1a, 0xf8, 0x33, 0x45,
+    0x2a, 0x51, 0xd4, 0x2f, 0x3e, 0x7d, 0xfc, 0xf8, 0xcb, 0xcf, 0xe6, 0xd3, 0xa7, 0xf9, 0x4d, 0xdc,
+    0x59, 0x4e, 0x09, 0x08, 0x7c, 0x48, 0x7a, 0xe3, 0x43, 0x04, 0x06, 0x62, 0x5a, 0xb5, 0xf7, 0x21,
+    0xec, 0x80, 0x55, 0x14, 0x36, 0x51, 0x80, 0xd3, 0xe8, 0x1d, 0xa3, 0x48, 0x2b, 0x46, 0x70, 0x65,
+    0x98, 0x65, 0x02, 0xe8, 0x68, 0x46, 0x94, 0x4c, 0x18, 0x45, 0x2a, 0x31, 0xaa, 0x24, 0x12, 0x86,
+    0x91, 0xaf, 0x1e, 0xdc, 0x70, 0x72, 0x27, 0xf2, 0xc8, 0x28, 0x79, 0x1e, 0x80, 0x4f, 0xfc, 0x0e,
+    0x19, 0x20, 0x0f, 0x58, 0x00, 0x1f, 0x40, 0xd1, 0x5e, 0x3b, 0x93, 0x59, 0x11, 0x15, 0x60, 0x7e,
+    0xc8, 0x8c, 0x30, 0xf3, 0x42, 0xd6, 0x40, 0xc0, 0x99, 0x4e, 0x03, 0x30, 0x37, 0x41, 0x90, 0xd9,
+    0x1e, 0xab, 0x0b, 0x01, 0x4e, 0xd0, 0x72, 0xac, 0x0d, 0x73, 0x8a, 0xe7, 0x5c, 0xea, 0x66, 0x03,
+    0x37, 0x18, 0xaf, 0x99, 0x2d, 0xb6, 0x21, 0xdb, 0x03, 0x76, 0x8b, 0xa6, 0xb7, 0xb9, 0x57, 0xcc,
+    0x06, 0x72, 0x91, 0x9e, 0x58, 0x54, 0x1d, 0x60, 0x7a, 0x18, 0x4e, 0x44, 0x25, 0xd5, 0xb2, 0xee,
+    0x19, 0x44, 0x77, 0x05, 0x28, 0x4b, 0x18, 0x25, 0x58, 0x96, 0x0c, 0x4b, 0x40, 0xba, 0x06, 0xcc,
+    0xa6, 0xc8, 0x27, 0x05, 0x94, 0xab, 0x14, 0x5e, 0x84, 0x82, 0xd3, 0xc1, 0xee, 0xb0, 0x9e, 0x19,
+    0x94, 0x47, 0x65, 0x4e, 0x2c, 0x46, 0xa9, 0xa8, 0x31, 0x65, 0x28, 0x6f, 0xb0, 0x60, 0xb4, 0x4a,
+    0x2f, 0x01, 0x6c, 0xcf, 0x14, 0x5b, 0x3e, 0x26, 0xc1, 0xb3, 0x80, 0x12, 0xb6, 0x97, 0xf2, 0xf9,
+    0x43, 0xd3, 0xcc, 0x90, 0x04, 0x37, 0x05, 0x92, 0x09, 0xf5, 0xb8, 0x24, 0x1e, 0x28, 0xee, 0xfd,
+    0x6b, 0x18, 0x1c, 0xdc, 0x08, 0x8e, 0x92, 0xae, 0x9a, 0x4a, 0xf7, 0xba, 0x40, 0xe1, 0x6e, 0x42,
+    0xe1, 0x56, 0x51, 0xd0, 0x68, 0xc0, 0x2d, 0x12, 0x80, 0x97, 0x33, 0x3f, 0x70, 0x5b, 0x81, 0x6b,
+    0x0d, 0xf1, 0x01, 0x26, 0xf5, 0xd2, 0x4d, 0x49, 0x3e, 0x22, 0x82, 0x7e, 0xfd, 0xaa, 0x05, 0x4e,
+    0x6b, 0x41, 0xbb, 0x07, 0x2f, 0xf2, 0xfd, 0xd7, 0x34, 0x67, 0x94, 0xc7, 0xc0, 0x16, 0x5a, 0x66,
+    0xd7, 0x89, 0xfd, 0x2e, 0xed, 0xe7, 0x5d, 0x10, 0x3f, 0xcd, 0x3d, 0xe1, 0x63, 0x3e, 0xbd, 0x7f,
+    0xf3, 0x32, 0x9a, 0x43, 0x02, 0x80, 0xe4, 0xe2, 0x1d, 0xcc, 0x8a, 0x66, 0x90, 0x62, 0xe4, 0x3a,
+    0x95, 0x14, 0x4e, 0xf2, 0x49, 0x62, 0x47, 0x57, 0x16, 0x9f, 0x41, 0xd6, 0x47, 0x39, 0xd0, 0x6b,
+    0xf4, 0x19, 0xad, 0x44, 0xe6, 0x19, 0x79, 0xca, 0x95, 0xd8, 0xbf, 0xa5, 0x98, 0x36, 0xa0, 0xc3,
+    0x29, 0x63, 0x23, 0x12, 0x30, 0x2b, 0xc0, 0x67, 0x12, 0x3f, 0xa2, 0x7c, 0x90, 0xd2, 0xb6, 0xb8,
+    0x0c, 0xd0, 0x13, 0x87, 0xab, 0x0a, 0x2d, 0xe7, 0xae, 0x95, 0x9e, 0x54, 0x82, 0xf9, 0x06, 0xe6,
+    0xb3, 0xb9, 0xca, 0x7c, 0x3a, 0x69, 0x6e, 0xe2, 0x45, 0x0d, 0xe1, 0x25, 0x24, 0x38, 0xcc, 0xc5,
+    0xdd, 0x17, 0x2a, 0x5b, 0x89, 0x1c, 0x39, 0x49, 0x49, 0x20, 0x6c, 0x4e, 0x6c, 0xbd, 0xb7, 0x54,
+    0x3f, 0xa9, 0x30, 0x5e, 0xd7, 0xe9, 0x7a, 0xb9, 0x2c, 0x9b, 0x2a, 0xb0, 0x18, 0x63, 0xe6, 0x1a,
+    0xbf, 0xd2, 0x14, 0x30, 0x43, 0x1a, 0x55, 0x72, 0xa6, 0x15, 0x8a, 0x8f, 0x5a, 0x91, 0x11, 0x38,
+    0xbf, 0x7a, 0xeb, 0x87, 0x57, 0x2d, 0x2a, 0x66, 0x64, 0x79, 0x2b, 0x79, 0x4e, 0xe5, 0xd8, 0x4a,
+    0xde, 0x3a, 0x40, 0x94, 0x63, 0x53, 0x1d, 0x68, 0x7e, 0x67, 0xc2, 0x57, 0x75, 0x12, 0xfc, 0x2e,
+    0x98, 0xe7, 0x34, 0x8b, 0x0c, 0xcc, 0x8e, 0x13, 0x86, 0x50, 0xaf, 0x98, 0xe7, 0x2c, 0x02, 0xcc,
+    0x74, 0x25, 0x31, 0x2d, 0x74, 0x50, 0x52, 0xaf, 0x9c, 0x3c, 0x9c, 0x17, 0xd4, 0x7f, 0x60, 0x71,
+    0x4b, 0xa4, 0xdc, 0xe9, 0x4a, 0x5a, 0x71, 0xef, 0x0c, 0xc8, 0x4d, 0x55, 0x3d, 0x48, 0xa1, 0xc6,
+    0x82, 0x2b, 0x1a, 0x6b, 0x20, 0x12, 0xc8, 0x99, 0xd2, 0xd2, 0x2c, 0x2f, 0x17, 0x09, 0xb1, 0xe8,
+    0x21, 0x33, 0x4d, 0x16, 0x49, 0x79, 0x26, 0xe2, 0x4f, 0x31, 0x95, 0x94, 0x61, 0x02, 0x05, 0xf1,
+    0x5b, 0xec, 0x7c, 0x8c, 0xf4, 0x64, 0xd9, 0xfc, 0xf0, 0xca, 0x84, 0x5a, 0xac, 0x08, 0x47, 0x25,
+    0x8d, 0x94, 0x22, 0xcc, 0x87, 0xb7, 0x15, 0xeb, 0x09, 0x9d, 0x6b, 0x7f, 0x5a, 0xf4, 0xf1, 0xd1,
+    0xd4, 0x50, 0x31, 0x80, 0xa9, 0xd6, 0x30, 0x9f, 0x97, 0x05, 0x14, 0xf8, 0x50, 0xb9, 0x74, 0x5f,
+    0x23, 0x9d, 0xcb, 0x52, 0x85, 0xc8, 0x12, 0x11, 0x44, 0x23, 0xbf, 0x93, 0x47, 0xb1, 0xd3, 0xc5,
+    0x38, 0xe5, 0x09, 0x78, 0xf5, 0x96, 0x72, 0xcb, 0xc2, 0x8c, 0x42, 0xce, 0x93, 0xb2, 0x69, 0x3a,
+    0xd2, 0xdd, 0xd8, 0x85, 0xc4, 0x3c, 0x90, 0x7f, 0x2d, 0x3b, 0x8d, 0xa1, 0x68, 0x04, 0x77, 0x85,
+    0xd1, 0xcd, 0x0f, 0x20, 0x9b, 0x6b, 0xbd, 0x88, 0xa2, 0x80, 0x39, 0x61, 0xad, 0x1b, 0x7c, 0xfa,
+    0x34, 0x23, 0x6d, 0x84, 0xe2, 0xb3, 0x68, 0x8a, 0xcf, 0x5f, 0xf2, 0xa5, 0x8d, 0x17, 0x80, 0x63,
+    0x44, 0xc6, 0x41, 0x00, 0x17, 0xa6, 0x39, 0xc8, 0x0c, 0x03, 0x61, 0xab, 0x11, 0x14, 0xae, 0x42,
+    0x65, 0x28, 0x2c, 0x80, 0x46, 0xef, 0xe1, 0xb8, 0x3d, 0xb8, 0x5c, 0xeb, 0x0d, 0xa4, 0x02, 0x5a,
+    0xc3, 0x3c, 0x8f, 0x84, 0x89, 0x08, 0xb3, 0x58, 0x7f, 0xa7, 0x0f, 0xca, 0x5d, 0x1e, 0x82, 0xda,
+    0x04, 0x30, 0x96, 0x75, 0x2f, 0x51, 0x42, 0xc8, 0x24, 0xeb, 0x1e, 0xd1, 0x8c, 0xc3, 0x7a, 0xf9,
+    0x22, 0x65, 0xeb, 0x25, 0x1b, 0xa3, 0x58, 0xef, 0x0b, 0xe7, 0x94, 0x2b, 0x70, 0x1d, 0x2c, 0x72,
+    0x7b, 0x59, 0xc3, 0x52, 0xab, 0x48, 0x8d, 0x32, 0x85, 0x28, 0x07, 0x7f, 0xa1, 0x15, 0x45, 0xc6,
+    0x94, 0xc1, 0x95, 0x03, 0x78, 0x29, 0x93, 0x0c, 0x98, 0xf1, 0x9e, 0xdc, 0x7e, 0x25, 0xf2, 0xd7,
+    0x47, 0x83, 0xe5, 0x03, 0xc2, 0x3c, 0x25, 0xf9, 0xde, 0x54, 0x73, 0x85, 0xa4, 0x0d, 0x18, 0xbd,
+    0xe0, 0x86, 0x9d, 0x77, 0x2c, 0x14, 0x2f, 0x07, 0xd6, 0x98, 0x8e, 0xf0, 0xa6, 0xe8, 0x6f, 0x64,
+    0x3a, 0xd8, 0x36, 0xa5, 0x58, 0x89, 0x1c, 0x3a, 0xb9, 0x9f, 0x66, 0x4a, 0x59, 0xc4, 0xb3, 0xbc,
+    0x2a, 0x80, 0x19, 0x3c, 0xdb, 0x4f, 0x5f, 0xd1, 0x43, 0xfc, 0x51, 0x72, 0x27, 0xab, 0x26, 0x83,
+    0x3a, 0x23, 0x43, 0x09, 0x44, 0x45, 0xd9, 0xc8, 0xb3, 0xa9, 0xfc, 0xe2, 0xd1, 0xdb, 0xe8, 0x86,
+    0x25, 0x2f, 0x41, 0x21, 0x5b, 0xd6, 0x50, 0x2b, 0x2e, 0x88, 0x26, 0x3b, 0x8d, 0xe6, 0x4a, 0x83,
+    0x81, 0x15, 0xfd, 0x07, 0x28, 0x10, 0xdc, 0xf4, 0x3f, 0x7c, 0x08, 0x02, 0x4c, 0x26, 0x70, 0x42,
+    0xe8, 0xe8, 0x1e, 0x77, 0x24, 0xc1, 0x30, 0x3a, 0xe1, 0xc5, 0x68, 0xa7, 0x3d, 0x2e, 0x02, 0xb9,
+    0xa3, 0x12, 0xfa, 0xf4, 0xe9, 0x93, 0x71, 0x1d, 0xe1, 0x9d, 0x7e, 0xae, 0xd5, 0x4f, 0x4a, 0x03,
+    0x6a, 0xe1, 0x0b, 0x70, 0x84, 0x7e, 0x1d, 0x2f, 0xc6, 0x12, 0x33, 0x7e, 0x5d, 0x85, 0x54, 0x80,
+    0x95, 0xa1, 0x24, 0x50, 0xe6, 0xf7, 0x05, 0xbb, 0x44, 0x66, 0x8a, 0xd9, 0x0a, 0xa6, 0x9a, 0x63,
+    0xba, 0x98, 0xc7, 0xe2, 0x55, 0x29, 0x1e, 0xce, 0x23, 0xd8, 0x21, 0x1d, 0xd2, 0xf2, 0x91, 0x33,
+    0x87, 0x9f, 0xa3, 0x4d, 0xd9, 0x82, 0x58, 0x45, 0x2e, 0x9c, 0xb5, 0x71, 0x9c, 0x8f, 0x83, 0x95,
+    0x44, 0x95, 0xd4, 0x7c, 0xe6, 0x26, 0xab, 0x41, 0x13, 0x01, 0xf7, 0x99, 0xea, 0x40, 0xd0, 0x64,
+    0x6c, 0xb9, 0xc1, 0x1f, 0xf3, 0x4b, 0xd5, 0xe3, 0xc9, 0xa0, 0x86, 0x6f, 0xe3, 0x58, 0x85, 0x6d,
+    0x06, 0xd8, 0xc0, 0xc3, 0x6b, 0x21, 0x6c, 0x08, 0xf3, 0x6b, 0x4b, 0x05, 0xde, 0x0a, 0x15, 0x84,
+    0x35, 0x68, 0x37, 0x00, 0x50, 0x08, 0x48, 0x5a, 0x50, 0x99, 0x00, 0x4f, 0x91, 0x89, 0x17, 0x93,
+    0x37, 0xd9, 0xa3, 0x54, 0xb4, 0xd0, 0x72, 0xf4, 0xed, 0xe8, 0xbb, 0xf1, 0xef, 0x9e, 0xb0, 0x9e,
+    0x22, 0x03, 0xe4, 0x9b, 0xf8, 0x50, 0x40, 0xba, 0x24, 0xca, 0x95, 0xd0, 0x6e, 0x66, 0xf1, 0x02,
+    0x50, 0x95, 0x3e, 0x3d, 0x44, 0xaa, 0xa4, 0x9d, 0xdc, 0x45, 0x96, 0x36, 0x42, 0x85, 0x80, 0x1a,
+    0x2a, 0x3c, 0xa3, 0xae, 0xa1, 0x7a, 0x3e, 0xe1, 0x8d, 0x30, 0x01, 0x9c, 0x8a, 0x48, 0x7d, 0xf0,
+    0xd2, 0x94, 0xcb, 0xac, 0x78, 0xa1, 0xcc, 0x3d, 0xf1, 0x44, 0xa3, 0xc1, 0xf5, 0x13, 0x53, 0x75,
+    0x4a, 0x0f, 0xcc, 0xf4, 0x54, 0x59, 0x18, 0x86, 0x52, 0x88, 0xb6, 0x41, 0xad, 0x1e, 0x9e, 0xfc,
+    0x95, 0x03, 0x16, 0x85, 0xb6, 0x7b, 0xab, 0xe5, 0x01, 0x5e, 0x69, 0x2d, 0x8a, 0x98, 0x54, 0x65,
+    0x73, 0x2c, 0x75, 0x55, 0xf4, 0x44, 0xe1, 0xa6, 0x6c, 0x8d, 0x80, 0x54, 0xe6, 0xd0, 0x05, 0x23,
+    0x7f, 0x1a, 0xd1, 0x94, 0x10, 0x9a, 0xd9, 0xbf, 0x7a, 0xf3, 0xde, 0x5c, 0x43, 0x06, 0x8d, 0x50,
+    0xe8, 0x24, 0x1d, 0xd0, 0x10, 0x74, 0x34, 0xf6, 0xbb, 0x2c, 0x78, 0xc1, 0xc3, 0x95, 0x94, 0x66,
+    0xfd, 0x85, 0xa1, 0x80, 0x53, 0x89, 0x95, 0xcf, 0xdb, 0x9a, 0xd9, 0x2d, 0x6d, 0x92, 0x5f, 0x17,
+    0xcb, 0xfe, 0xe5, 0xd1, 0xab, 0xfe, 0x7d, 0x71, 0x1b, 0x4f, 0x29, 0x01, 0xf9, 0xb4, 0x6f, 0x6d,
+    0x56, 0x05, 0x17, 0x02, 0xab, 0x97, 0x12, 0x76, 0xb3, 0xf4, 0xac, 0x25, 0xb6, 0xa3, 0xe5, 0x8e,
+    0x3a, 0x0c, 0x15, 0xdd, 0x68, 0x21, 0x2a, 0xd2, 0x8c, 0xb6, 0x17, 0x2b, 0x5c, 0x40, 0xfd, 0x55,
+    0xb9, 0x24, 0xe6, 0xc9, 0xe2, 0x97, 0xc8, 0x33, 0x96, 0x8d, 0x95, 0x52, 0x02, 0x66, 0xba, 0xd9,
+    0xc5, 0x2d, 0x18, 0x4c, 0x41, 0xd6, 0x14, 0xb8, 0x48, 0x4d, 0xad, 0x02, 0x3b, 0x39, 0x63, 0x24,
+    0x12, 0xb3, 0x91, 0x8e, 0x49, 0x6b, 0xa3, 0xd0, 0xb5, 0x7c, 0x1c, 0x85, 0xc3, 0xbd, 0xa7, 0x5a,
+    0x8d, 0x7b, 0xfd, 0xee, 0xd3, 0x0b, 0x73, 0xb8, 0x52, 0xd7, 0xee, 0x57, 0xeb, 0x5a, 0xb6, 0xe5,
+    0xe2, 0xd9, 0xe8, 0x79, 0x54, 0xe2, 0xf5, 0xcc, 0x2f, 0x63, 0x7d, 0x56, 0x16, 0x84, 0x8d, 0x54,
+    0x52, 0xc0, 0x95, 0xf5, 0x6e, 0xff, 0xa4, 0xf7, 0xda, 0xcc, 0xef, 0x09, 0xde, 0x8a, 0xf3, 0x2f,
+    0x39, 0x67, 0x2b, 0x6a, 0x27, 0xa1, 0x9b, 0xaa, 0x9d, 0x3c, 0x58, 0x13, 0xe6, 0xce, 0xa1, 0xa2,
+    0x71, 0x75, 0x3a, 0x27, 0x26, 0xc9, 0x41, 0xee, 0xff, 0x82, 0x46, 0x48, 0x19, 0xe7, 0x43, 0xad,
+    0x70, 0x47, 0xbe, 0xe8, 0x41, 0x8f, 0xed, 0xa4, 0x75, 0x90, 0x04, 0x94, 0x2f, 0x7f, 0x20, 0x85,
+    0xaa, 0x5c, 0x86, 0x29, 0xb2, 0xa0, 0x55, 0x4a, 0x06, 0x78, 0x52, 0x4a, 0xd9, 0xb4, 0x9b, 0xe3,
+    0x40, 0x2b, 0x1a, 0xe4, 0xd3, 0xdd, 0x5a, 0xad, 0xa0, 0x9c, 0x47, 0xf0, 0x5d, 0xe0, 0xd2, 0x8a,
+    0xca, 0x00, 0xee, 0x29, 0x8d, 0xd0, 0x84, 0xcd, 0xa3, 0x6b, 0xd6, 0x32, 0x91, 0x51, 0x26, 0x98,
+    0xca, 0xba, 0xe6, 0xaa, 0x3c, 0x46, 0x51, 0xd7, 0x5e, 0x8d, 0xc8, 0x44, 0xa2, 0x66, 0x61, 0x4d,
+    0x69, 0x75, 0x83, 0x8d, 0x45, 0x56, 0xb4, 0x9a, 0x1e, 0x5c, 0xb4, 0x25, 0x76, 0x4e, 0xc5, 0xe1,
+    0x01, 0xda, 0xbb, 0x96, 0xc7, 0x20, 0x23, 0x2c, 0x8c, 0x46, 0xf9, 0x66, 0x78, 0xce, 0x08, 0xe5,
+    0x88, 0x7c, 0xd6, 0x53, 0xd2, 0x46, 0xc8, 0x4e, 0x77, 0x7d, 0x45, 0xa4, 0xf4, 0x97, 0xcb, 0x1d,
+    0x7d, 0xe5, 0x34, 0x2b, 0xf0, 0x40, 0xd3, 0x64, 0x79, 0xa8, 0x83, 0x47, 0x06, 0xf5, 0x8e, 0x8b,
+    0xed, 0x1a, 0x28, 0x65, 0x3e, 0xe1, 0x7b, 0x4d, 0x44, 0x29, 0x43, 0xf7, 0x52, 0xe0, 0x08, 0x6b,
+    0xf5, 0xad, 0x06, 0x73, 0xe1, 0x59, 0xc7, 0xf2, 0x54, 0xcf, 0xa9, 0x14, 0x63, 0xee, 0x00, 0xa6,
+    0x2a, 0x4a, 0xb3, 0x6c, 0x41, 0x7e, 0x18, 0x8f, 0x36, 0x20, 0xcd, 0x8f, 0x87, 0x88, 0x48, 0x01,
+    0x23, 0xec, 0x6b, 0x27, 0x58, 0x30, 0xac, 0x0b, 0xf0, 0x47, 0xca, 0xf8, 0x73, 0xce, 0x13, 0x1f,
+    0xac, 0x9a, 0x3a, 0xe4, 0x88, 0xde, 0x6c, 0x17, 0x53, 0x35, 0x21, 0x1c, 0xcc, 0x06, 0xe8, 0xce,
+    0x0e, 0x7e, 0x8c, 0x30, 0xf8, 0x35, 0x18, 0x95, 0x9d, 0xf4, 0x80, 0xa1, 0x74, 0x58, 0xda, 0x96,
+    0x4f, 0xff, 0x8e, 0x4c, 0x7c, 0xfc, 0xd7, 0x6c, 0x80, 0x01, 0x0f, 0x78, 0xe4, 0xa3, 0xc5, 0x9b,
+    0xf4, 0xcc, 0xde, 0xf7, 0x5b, 0x8f, 0x2c, 0x1e, 0xf2, 0x85, 0xcc, 0x4e, 0x3c, 0xe5, 0xdb, 0x04,
+    0x07, 0x6e, 0x55, 0x95, 0xc5, 0xd5, 0x64, 0x9c, 0x3c, 0x2f, 0xa4, 0x98, 0x01, 0xd8, 0x51, 0x66,
+    0x03, 0x7a, 0xc3, 0xa2, 0x7c, 0xac, 0x39, 0x6b, 0x05, 0x78, 0x5b, 0x48, 0xdd, 0xa6, 0x72, 0xe3,
+    0x73, 0xef, 0xcb, 0xf6, 0x82, 0x7c, 0xe2, 0xe9, 0xe4, 0xb0, 0x30, 0x5d, 0x24, 0x2c, 0xcf, 0xa9,
+    0x5b, 0x6a, 0xf3, 0x24, 0x2e, 0xba, 0x4f, 0xb2, 0x5c, 0x95, 0x27, 0x03, 0x70, 0x63, 0x3d, 0x0a,
+    0xae, 0x65, 0x69, 0x2f, 0xaa, 0xbe, 0x84, 0xa7, 0xa2, 0x89, 0xb6, 0xbe, 0xcd, 0x25, 0xb6, 0x2a,
+    0x1d, 0x3f, 0x1c, 0xad, 0xc4, 0x25, 0x3a, 0x5b, 0x82, 0xef, 0x84, 0xb7, 0x76, 0x33, 0xa8, 0xdc,
+    0xc6, 0x8a, 0x8b, 0xaa, 0x03, 0x12, 0x5b, 0xd9, 0x6e, 0xa2, 0x4b, 0x62, 0x3a, 0xfa, 0x2c, 0x75,
+    0xec, 0xf3, 0xae, 0x03, 0x9d, 0x86, 0x30, 0xbb, 0xf3, 0x2b, 0xcc, 0x89, 0xdb, 0x62, 0x03, 0x31,
+    0xa6, 0x46, 0xd2, 0x00, 0xae, 0x28, 0xfd, 0xbf, 0x5e, 0x1b, 0x7f, 0x83, 0x94, 0xf9, 0x1b, 0x7c,
+    0x8f, 0xc6, 0x2f, 0x1e, 0x2d, 0xd4, 0xfa, 0xfa, 0x15, 0xfe, 0xd4, 0xb5, 0xf8, 0xef, 0x65, 0xe1,
+    0x28, 0x3e, 0xe5, 0x6c, 0x44, 0x8a, 0x2e, 0x86, 0xe2, 0x8c, 0xfa, 0xf2, 0xc1, 0x7e, 0x80, 0xb4,
+    0x08, 0x2e, 0x8d, 0xd0, 0x07, 0xa8, 0x1a, 0x92, 0x35, 0x0a, 0xac, 0xac, 0x5c, 0x97, 0xc0, 0x6e,
+    0xc4, 0xa9, 0xf5, 0x23, 0x7b, 0x10, 0xea, 0xa2, 0x6c, 0x33, 0x6b, 0x4a, 0x02, 0xd0, 0x93, 0xd1,
+    0x08, 0x9b, 0x7d, 0x3b, 0x45, 0xe9, 0x91, 0x32, 0x65, 0xa0, 0xc6, 0x9d, 0x28, 0x8b, 0x8e, 0xb2,
+    0xfb, 0x54, 0x0b, 0x87, 0x50, 0x75, 0x2d, 0x22, 0xcc, 0x39, 0x57, 0x80, 0x03, 0x0d, 0xd4, 0xa4,
+    0x96, 0xa1, 0x9e, 0xd6, 0x49, 0xc7, 0x50, 0xe0, 0x4b, 0xeb, 0x33, 0xbd, 0x7a, 0x82, 0xda, 0xbf,
+    0x7b, 0xd8, 0xed, 0x5f, 0xe2, 0xc1, 0xba, 0x01, 0xa1, 0xc2, 0x6f, 0x79, 0x1b, 0x49, 0xed, 0x53,
+    0x4c, 0x66, 0x6c, 0x72, 0x05, 0x06, 0x51, 0x39, 0x65, 0x90, 0x53, 0x90, 0x71, 0x40, 0x42, 0xda,
+    0xb4, 0x8d, 0x0c, 0xa5, 0x5f, 0xc0, 0x12, 0x5e, 0xba, 0x28, 0x1b, 0x21, 0xf7, 0xfa, 0x00, 0x44,
+    0x02, 0x74, 0x17, 0x08, 0x97, 0x3b, 0x2b, 0x69, 0x57, 0xc7, 0xd4, 0xd3, 0x9f, 0x53, 0x3e, 0x56,
+    0x13, 0xb9, 0x35, 0x46, 0x9f, 0xdb, 0xe6, 0xcd, 0xa8, 0xb1, 0xdb, 0xce, 0xc7, 0x34, 0x71, 0x47,
+    0x81, 0x02, 0xcf, 0x47, 0x8d, 0x5c, 0x2b, 0x6d, 0x50, 0x43, 0xea, 0x57, 0x09, 0x2c, 0xf1, 0x4d,
+    0x39, 0x62, 0xd0, 0x9b, 0x4c, 0x84, 0x13, 0xe0, 0xba, 0x47, 0x7e, 0x97, 0x30, 0xf0, 0x0b, 0xa0,
+    0x19, 0xb6, 0x6d, 0x9b, 0xb9, 0x36, 0xcb, 0xa5, 0xa8, 0xed, 0x27, 0x35, 0x69, 0xa8, 0xed, 0xa1,
+    0xaa, 0x00, 0x45, 0x6b, 0x1d, 0x6a, 0xf6, 0x78, 0x54, 0xea, 0xa9, 0x3e, 0x7d, 0x5a, 0xe0, 0x7f,
+    0x22, 0x7c, 0xe2, 0x45, 0xd9, 0x77, 0x16, 0x10, 0xd6, 0xa0, 0xd6, 0xbb, 0x21, 0xe2, 0x8a, 0x0b,
+    0x2a, 0x1a, 0x44, 0x95, 0x83, 0x55, 0x42, 0x5d, 0xf2, 0x93, 0x54, 0x26, 0x6a, 0x84, 0x49, 0x2d,
+    0x64, 0xc5, 0xc8, 0x6e, 0x67, 0x49, 0xfd, 0x81, 0x2a, 0x82, 0x80, 0xbb, 0xda, 0xb9, 0x2a, 0xb3,
+    0x2b, 0xa8, 0x5c, 0x53, 0x49, 0x2a, 0xcb, 0x90, 0x47, 0xb0, 0x72, 0x4c, 0xf2, 0x99, 0xad, 0x28,
+    0xcc, 0x4e, 0x5a, 0x8e, 0x4a, 0x87, 0x20, 0xa4, 0x15, 0x67, 0x7b, 0x24, 0x88, 0x74, 0xc1, 0x45,
+    0x4f, 0x9a, 0x38, 0x3b, 0xe1, 0xe2, 0x80, 0x1b, 0x85, 0x66, 0x04, 0xc3, 0x0d, 0x63, 0xb7, 0x8b,
+    0x0d, 0x63, 0xee, 0x04, 0x3f, 0xf4, 0x7b, 0x3d, 0x6b, 0x18, 0x7b, 0x5a, 0xf8, 0x87, 0x31, 0x7b,
+    0x26, 0x64, 0x00, 0x65, 0x2d, 0x10, 0x0e, 0x13, 0x1f, 0xc4, 0x82, 0x3c, 0x4a, 0x02, 0xc9, 0xf7,
+    0x22, 0x28, 0x4b, 0xaf, 0x1c, 0x1d, 0x2b, 0x88, 0xc4, 0xfb, 0x62, 0x7b, 0x17, 0x82, 0xdc, 0x3e,
+    0xcc, 0xbc, 0x2c, 0x4f, 0xf1, 0x0a, 0x18, 0xf2, 0xc4, 0x1c, 0x42, 0x3e, 0xf5, 0xd1, 0x9f, 0xb3,
+    0x68, 0xc1, 0x55, 0xb9, 0xad, 0x7c, 0x9a, 0x6a, 0xa8, 0x6e, 0x16, 0xe4, 0xc7, 0x33, 0xac, 0xfb,
+    0xf6, 0x29, 0xcc, 0x91, 0x15, 0x65, 0xb4, 0x33, 0x52, 0x9e, 0x8f, 0x36, 0x9d, 0x71, 0x39, 0x48,
+    0x9a, 0x7a, 0x78, 0xad, 0xe0, 0x89, 0x96, 0xd8, 0x88, 0x57, 0xc1, 0x40, 0x49, 0xad, 0x5a, 0x94,
+    0x3c, 0xae, 0x58, 0x61, 0x44, 0xe5, 0xe4, 0x5b, 0x79, 0x76, 0xfd, 0x0c, 0xdc, 0xf6, 0x53, 0x16,
+    0x93, 0x65, 0x47, 0xe7, 0xf4, 0xdd, 0x64, 0xd1, 0xf1, 0x92, 0xa7, 0x5b, 0xf1, 0xeb, 0xda, 0xfc,
+    0xbf, 0xd8, 0xd0, 0x21, 0x99, 0x69, 0x23, 0x64, 0xfe, 0xbf, 0xd2, 0xe3, 0x14, 0xcf, 0x19, 0x95,
+    0x93, 0x39, 0xf1, 0xa8, 0x8f, 0xc4, 0x86, 0x87, 0xa9, 0xcc, 0xbd, 0x72, 0xaf, 0x7a, 0x03, 0xd6,
+    0xfc, 0x39, 0x24, 0x40, 0x9d, 0x67, 0xdd, 0x9b, 0x87, 0x6d, 0xc8, 0x10, 0xb7, 0x9a, 0x96, 0xde,
+    0x5d, 0xd4, 0xb2, 0xca, 0x19, 0x84, 0xfe, 0x58, 0x53, 0x7e, 0x4e, 0x4e, 0x6b, 0x0b, 0x37, 0x5c,
+    0x93, 0x0d, 0x81, 0x77, 0xde, 0x52, 0x12, 0xb6, 0x15, 0xb1, 0xf2, 0xe1, 0x61, 0x92, 0xc8, 0x52,
+    0x83, 0x5e, 0xed, 0x39, 0x00, 0x55, 0xea, 0x56, 0xc9, 0x3f, 0x6b, 0x1a, 0x51, 0xec, 0xdd, 0x5d,
+    0xd4, 0x66, 0xb4, 0xdb, 0xfa, 0xe3, 0x35, 0x79, 0x21, 0x45, 0x68, 0x4a, 0x0d, 0xf1, 0x23, 0x4b,
+    0xef, 0xea, 0xd1, 0xac, 0x7c, 0x72, 0x6e, 0x85, 0x8f, 0x90, 0xb8, 0x4a, 0x69, 0x24, 0x30, 0x2f,
+    0xe3, 0x67, 0xe1, 0x22, 0xf0, 0x62, 0x61, 0x5b, 0xa2, 0x61, 0xa4, 0x5b, 0x50, 0xd6, 0x44, 0xca,
+    0xe8, 0x25, 0x9a, 0x56, 0x6a, 0x42, 0xf1, 0x04, 0x58, 0xae, 0xd8, 0xd9, 0xe6, 0xe7, 0xc6, 0x74,
+    0x54, 0x79, 0xc6, 0xac, 0x5c, 0x92, 0x66, 0xa2, 0xdd, 0x30, 0x76, 0xa3, 0x79, 0x64, 0xf9, 0xea,
+    0xca, 0x54, 0xb5, 0xde, 0x49, 0x53, 0x2a, 0x2c, 0xcd, 0x45, 0x96, 0xc6, 0xa2, 0xf4, 0x82, 0xdb,
+    0xef, 0xf1, 0x49, 0x0a, 0x91, 0xb3, 0x9e, 0xf7, 0x2e, 0xe0, 0x73, 0x20, 0x90, 0x8b, 0xcd, 0xb4,
+    0xfb, 0xf6, 0x51, 0xaf, 0x62, 0x62, 0xd9, 0x03, 0x6f, 0xda, 0xf9, 0xad, 0x2d, 0x58, 0x9a, 0xad,
+    0x04, 0xe2, 0xf5, 0xcf, 0x6b, 0xed, 0x52, 0xe3, 0xe8, 0x96, 0x36, 0x29, 0x70, 0x3f, 0xd0, 0x2c,
+    0x25, 0x61, 0x65, 0xcb, 0x94, 0x86, 0x20, 0xc8, 0x02, 0x4b, 0xc8, 0xf5, 0xbf, 0x2d, 0x47, 0x0c,
+    0xe4, 0xdf, 0x26, 0x96, 0xa0, 0x89, 0xfc, 0xb1, 0x2d, 0x41, 0x34, 0x0b, 0x75, 0x4b, 0xc8, 0x1a,
+    0x88, 0x99, 0x25, 0xb4, 0x69, 0x17, 0x69, 0xbd, 0x3d, 0xe8, 0xcf, 0xf4, 0x95, 0xe2, 0x48, 0x8b,
+    0x10, 0x5c, 0x98, 0xc2, 0xd9, 0x02, 0x11, 0x03, 0x13, 0xf9, 0x0f, 0x5f, 0xac, 0xbd, 0x8d, 0x1a,
+    0x5f, 0x3c, 0x00, 0x58, 0xb1, 0xb4, 0x0d, 0x63, 0xf0, 0x79, 0xc0, 0x7c, 0x8c, 0x24, 0x41, 0xb8,
+    0x15, 0x20, 0x80, 0x92, 0xc3, 0x06, 0x48, 0xb6, 0xe8, 0x55, 0x14, 0x4f, 0x14, 0x36, 0x53, 0xf8,
+    0xea, 0xca, 0xf2, 0xcd, 0x5f, 0x7c, 0xd2, 0x69, 0x8b, 0xd5, 0x29, 0x3a, 0x27, 0x6e, 0x6a, 0x3a,
+    0x47, 0xe5, 0x91, 0xa8, 0x8c, 0x36, 0x6b, 0x9b, 0xb6, 0xea, 0xc7, 0xd6, 0x36, 0x6c, 0xe5, 0xca,
+    0x47, 0x0c, 0x2b, 0x07, 0x3e, 0xb3, 0x13, 0xa6, 0x0d, 0x0e, 0x7b, 0x98, 0xca, 0xfb, 0x22, 0xfe,
+    0x12, 0x87, 0x3a, 0xd5, 0xa3, 0x99, 0xd9, 0xb1, 0xdb, 0xea, 0xe1, 0xcb, 0xd2, 0xa1, 0xca, 0x8a,
+    0x34, 0xdd, 0xf5, 0x67, 0x24, 0xb1, 0x3b, 0x61, 0xb3, 0x5b, 0x50, 0xe1, 0xd4, 0x52, 0xf7, 0xd6,
+    0x82, 0x35, 0x27, 0x0d, 0xe4, 0x3e, 0x15, 0x80, 0xc8, 0xec, 0x76, 0x92, 0xa6, 0x98, 0x61, 0x8f,
+    0xcc, 0xb5, 0xef, 0xcc, 0x34, 0x69, 0x84, 0x9e, 0x4a, 0x2e, 0x12, 0xfc, 0x77, 0x07, 0xe8, 0xdf,
+    0x0c, 0xc1, 0xd7, 0x97, 0x0c, 0xb4, 0x5d, 0xcf, 0x70, 0xdd, 0x6e, 0xbc, 0xe0, 0xb2, 0xe8, 0x72,
+    0xd4, 0x12, 0xa1, 0xbe, 0xce, 0xaf, 0x78, 0x47, 0xe9, 0xaa, 0x37, 0x03, 0x1e, 0x8a, 0x37, 0xf9,
+    0xed, 0xc7, 0xb7, 0xa6, 0x40, 0xaa, 0xd2, 0xe9, 0xda, 0x19, 0x81, 0x5f, 0xbf, 0x9a, 0x9f, 0xc2,
+    0xab, 0x30, 0xba, 0x09, 0x35, 0x4a, 0xf1, 0xd5, 0x1e, 0x1b, 0x28, 0x45, 0x90, 0xad, 0xd8, 0x55,
+    0x7e, 0x1d, 0xe7, 0x31, 0x92, 0x46, 0x58, 0xf4, 0xa3, 0xa9, 0xe4, 0x33, 0x85, 0x7e, 0xd0, 0x83,
+    0xb8, 0x2d, 0x73, 0x2f, 0xdb, 0xd1, 0x73, 0xc5, 0x8e, 0xde, 0x9e, 0x69, 0x95, 0x77, 0x93, 0x1b,
+    0xed, 0x62, 0x69, 0x7b, 0x90, 0xda, 0x13, 0xd3, 0xb4, 0x55, 0x55, 0xaa, 0xf3, 0xe4, 0x6e, 0x15,
+    0xde, 0xc8, 0x1e, 0x84, 0xcc, 0x9e, 0xb5, 0x15, 0xf7, 0x54, 0x12, 0x66, 0x7e, 0xc8, 0x37, 0x30,
+    0x0c, 0x41, 0x56, 0x30, 0xac, 0xf2, 0x42, 0xd8, 0xf2, 0x9b, 0x13, 0x95, 0xb7, 0x17, 0x2a, 0xaf,
+    0x80, 0x36, 0x05, 0x4e, 0x8d, 0xec, 0x75, 0xef, 0xc6, 0xc1, 0x9d, 0x0c, 0xfc, 0x57, 0x5f, 0xee,
+    0xe8, 0x34, 0x73, 0xa6, 0x02, 0x76, 0xce, 0xcb, 0xb2, 0xd9, 0xe2, 0xf6, 0x54, 0xe9, 0x9a, 0x48,
+    0xee, 0x4b, 0x17, 0x51, 0x88, 0x95, 0x8b, 0xc0, 0xb7, 0xca, 0x35, 0x24, 0x77, 0xf5, 0xf6, 0xf7,
+    0x26, 0x27, 0x76, 0xb3, 0x5e, 0xdd, 0x56, 0xbf, 0xa4, 0x12, 0x5f, 0xca, 0xa2, 0x29, 0x0c, 0xef,
+    0x6f, 0x98, 0x8a, 0xf7, 0xcb, 0x73, 0x95, 0xcd, 0x4e, 0x57, 0xe6, 0x53, 0x9c, 0x00, 0x06, 0x95,
+    0x8f, 0x4a, 0xa9, 0x6f, 0x2f, 0xf2, 0x43, 0x90, 0x4c, 0x10, 0x30, 0x57, 0x27, 0x65, 0x7f, 0x13,
+    0x29, 0xfb, 0x92, 0x14, 0xa4, 0x80, 0x0e, 0xe1, 0x98, 0xd2, 0xfb, 0xc0, 0x1d, 0xbd, 0xf9, 0x91,
+    0xe2, 0x49, 0x43, 0x57, 0x9c, 0x2a, 0x29, 0x5c, 0x90, 0xf1, 0x3a, 0x9c, 0x06, 0x7e, 0x3a, 0xd3,
+    0xa7, 0x3d, 0xd8, 0x34, 0xed, 0xc1, 0x6a, 0x0e, 0x94, 0xb5, 0x53, 0xac, 0xfe, 0xa0, 0x76, 0xf3,
+    0xac, 0xfa, 0x34, 0x3d, 0x6a, 0xa1, 0x50, 0x48, 0x7c, 0xfe, 0x32, 0x53, 0xd4, 0xaa, 0x36, 0xea,
+    0x61, 0x85, 0xf7, 0x51, 0x01, 0xb4, 0x2b, 0xfb, 0x95, 0x2b, 0x07, 0x15, 0x8d, 0xbb, 0x51, 0xdb,
+    0xbc, 0x7f, 0x96, 0xe3, 0xf6, 0x92, 0x19, 0xa2, 0xcf, 0xd4, 0xe4, 0xd8, 0xbd, 0x96, 0xb8, 0xea,
+    0x8f, 0xfb, 0xaf, 0xcd, 0x57, 0x4b, 0x6f, 0x26, 0x68, 0xda, 0x9d, 0x28, 0xbd, 0x6c, 0x60, 0xab,
+    0x3d, 0x3f, 0xfd, 0x2d, 0x02, 0x0f, 0xd9, 0xf3, 0x2b, 0x5e, 0x1f, 0xb0, 0xed, 0x9e, 0x5f, 0xcd,
+    0xc8, 0xad, 0xf7, 0xfc, 0x8a, 0xb7, 0x10, 0x6c, 0xb7, 0xe7, 0x57, 0xf3, 0x0e, 0x8a, 0x66, 0x3b,
+    0x7f, 0x75, 0xaf, 0x84, 0x68, 0xb0, 0xff, 0x57, 0x15, 0x6d, 0xa3, 0xfd, 0xbf, 0x35, 0xa2, 0x2d,
+    0xef, 0x02, 0x96, 0x5f, 0x2c, 0xd1, 0x68, 0x13, 0xaa, 0x42, 0xd6, 0x76, 0x9b, 0x50, 0x0d, 0x36,
+    0x33, 0x2a, 0x2b, 0x68, 0xb2, 0xa5, 0x51, 0xd6, 0xca, 0x26, 0x5b, 0x1a, 0xaa, 0x36, 0x35, 0xd9,
+    0xd2, 0x50, 0x35, 0xe7, 0x51, 0xb6, 0x34, 0xf2, 0x66, 0xb6, 0xd8, 0xd2, 0x58, 0xb3, 0x21, 0xb0,
+    0x7a, 0x3b, 0x60, 0xd3, 0x66, 0x40, 0x75, 0x2b, 0x40, 0xc9, 0xce, 0x8b, 0x4e, 0x7f, 0xc3, 0x3e,
+    0xff, 0xff, 0x71, 0x97, 0xff, 0x3e, 0x5f, 0x51, 0x7d, 0x87, 0xbf, 0x79, 0x7f, 0xbf, 0xfc, 0x8a,
+    0xc1, 0x2c, 0x71, 0xb2, 0x9b, 0x34, 0xfe, 0x6b, 0x5c, 0xc1, 0x50, 0x7b, 0xba, 0xb0, 0xdd, 0x3f,
+    0xca, 0xbb, 0xfe, 0xdf, 0xa0, 0xe7, 0xaf, 0xb0, 0xe5, 0x9b, 0xf4, 0xfb, 0xf5, 0x6e, 0x7f, 0x9d,
+    0x4b, 0x51, 0x3b, 0x08, 0xf4, 0xa4, 0x02, 0x3e, 0x81, 0x9a, 0xcc, 0x5b, 0x32, 0xe9, 0xd6, 0xb2,
+    0x05, 0x27, 0x74, 0x0d, 0x3c, 0x2f, 0x0b, 0xc2, 0x00, 0x29, 0xc8, 0x5c, 0xe6, 0xc2, 0xb4, 0x14,
+    0x9f, 0x51, 0x2d, 0x2c, 0x3b, 0x79, 0x83, 0x60, 0xce, 0xf8, 0x2c, 0x72, 0x07, 0x42, 0xbd, 0xef,
+    0x6b, 0xea, 0x4d, 0x98, 0x9f, 0x1e, 0xf3, 0xab, 0x3e, 0x00, 0xba, 0x4c, 0x88, 0x37, 0xad, 0xf2,
+    0x20, 0x5e, 0x6d, 0x00, 0x70, 0x3c, 0x7e, 0xf6, 0xe0, 0x66, 0x41, 0xfe, 0xd6, 0x98, 0x4a, 0xbb,
+    0xa0, 0x78, 0xd2, 0xb4, 0x49, 0xc3, 0x40, 0x7b, 0x35, 0xe1, 0x5f, 0xae, 0x65, 0x50, 0x3c, 0x84,
+    0xfb, 0x17, 0x6b, 0x1a, 0x5c, 0xaa, 0x6f, 0x03, 0x32, 0xf0, 0xd9, 0xc9, 0xbb, 0x3f, 0x69, 0xdf,
+    0x20, 0xd7, 0x30, 0x7a, 0x8b, 0xd1, 0x9f, 0xaa, 0x30, 0xcf, 0x98, 0xf8, 0x27, 0x2e, 0xcd, 0x37,
+    0xbe, 0x0c, 0x15, 0x8c, 0x5e, 0xa9, 0x88, 0xb2, 0x57, 0xa3, 0xfe, 0xe3, 0xf5, 0xf9, 0xff, 0x97,
+    0xe2, 0xf4, 0xd4, 0x92, 0x62, 0x65, 0x7f, 0x58, 0x09, 0x9e, 0x15, 0xbd, 0x9a, 0xa1, 0xe0, 0x8c,
+    0x6d, 0x14, 0x6d, 0x28, 0x5f, 0x76, 0xeb, 0x73, 0xc3, 0x4b, 0xa2, 0xb9, 0x22, 0xed, 0xed, 0xca,
+    0xde, 0x7f, 0x86, 0x22, 0x37, 0xe7, 0xf7, 0x03, 0xcb, 0xdc, 0xf2, 0x1b, 0xc7, 0xd6, 0x16, 0xba,
+    0x95, 0x97, 0xa4, 0x35, 0xde, 0x88, 0x2f, 0xbf, 0xf5, 0x6c, 0xab, 0x62, 0xb7, 0xfc, 0x32, 0xb3,
+    0x87, 0x94, 0xbb, 0xea, 0x5b, 0xcc, 0xb6, 0x2d, 0x78, 0x6b, 0xc7, 0x6e, 0x5d, 0xf2, 0xaa, 0xaf,
+    0x43, 0xdb, 0xae, 0xe8, 0xad, 0x7d, 0x41, 0x5e, 0xd3, 0x03, 0xaf, 0x75, 0x6f, 0xaa, 0x6b, 0x50,
+    0xf8, 0xd6, 0x89, 0xba, 0x51, 0xe9, 0xbb, 0x56, 0xd4, 0xd5, 0xe2, 0xb7, 0x4e, 0xff, 0x36, 0x96,
+    0xbf, 0x35, 0xc4, 0x3d, 0x7a, 0x01, 0x5c, 0xb3, 0x8e, 0x26, 0x25, 0x70, 0x55, 0x57, 0x9b, 0x14,
+    0xc1, 0xba, 0x86, 0x35, 0x29, 0x83, 0x75, 0x6d, 0xfa, 0x27, 0x2f, 0x84, 0xf3, 0x9c, 0xf3, 0x5f,
+    0xb7, 0x14, 0x6e, 0x52, 0xf1, 0xd6, 0xfa, 0x81, 0x61, 0xe9, 0x55, 0x39, 0xca, 0x51, 0xb7, 0x7f,
+    0xb1, 0xa2, 0x57, 0xcf, 0x4d, 0x57, 0x97, 0xbd, 0x7a, 0xd2, 0x80, 0x09, 0xc2, 0x87, 0x57, 0x06,
+    0xd6, 0x72, 0xab, 0xcb, 0xdd, 0xbc, 0xe4, 0x7b, 0x60, 0xc1, 0x5b, 0x7e, 0x95, 0xd1, 0xb7, 0x2a,
+    0x79, 0xdf, 0x84, 0x90, 0x03, 0x51, 0xb9, 0xab, 0x2c, 0x46, 0x66, 0x0a, 0x0f, 0xae, 0xef, 0x56,
+    0xfa, 0x24, 0xe5, 0x5f, 0xb0, 0x2a, 0x07, 0xb8, 0x6b, 0x73, 0x0f, 0xaa, 0x17, 0x79, 0xf3, 0xeb,
+    0x57, 0xf3, 0x82, 0x42, 0x55, 0xed, 0xa9, 0xfd, 0xe1, 0xce, 0x8e, 0x7a, 0x52, 0x20, 0x7b, 0x8c,
+    0x70, 0xb8, 0x73, 0xd6, 0x95, 0xef, 0xf4, 0x34, 0xce, 0xba, 0xe2, 0x9f, 0xda, 0xea, 0xe2, 0x9b,
+    0x31, 0xcf, 0xff, 0x17, 0x23, 0x16, 0x3d, 0x97, 0x4f, 0x82, 0x00, 0x00,
+};
+constexpr size_t AppPageHtmlCompressedSize = sizeof(AppPageHtml);
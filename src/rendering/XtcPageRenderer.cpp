@@ -3,8 +3,14 @@
 #include <GfxRenderer.h>
 #include <Logging.h>
 #include <Xtc/XtcParser.h>
+#include <esp_heap_caps.h>
 #include <esp_task_wdt.h>
 
+#include <cstring>
+#include <new>
+
+#include "../core/Trace.h"
+
 #define TAG "XTC_RENDER"
 
 namespace papyrix {
@@ -15,15 +21,43 @@ XtcPageRenderer::RenderResult mapStreamError(const xtc::XtcError error) {
                                               : XtcPageRenderer::RenderResult::PageLoadFailed;
 }
 
+// Transpose an 8x8 bit tile. Byte 0 is the most significant; in each byte bit 7 is
+// column 0. Afterwards byte c holds column c, with bit 7 taken from row 0.
+inline uint64_t transpose8x8(uint64_t x) {
+  x = (x & 0xAA55AA55AA55AA55ULL) | ((x & 0x00AA00AA00AA00AAULL) << 7) | ((x >> 7) & 0x00AA00AA00AA00AAULL);
+  x = (x & 0xCCCC3333CCCC3333ULL) | ((x & 0x0000CCCC0000CCCCULL) << 14) | ((x >> 14) & 0x0000CCCC0000CCCCULL);
+  x = (x & 0xF0F0F0F00F0F0F0FULL) | ((x & 0x00000000F0F0F0F0ULL) << 28) | ((x >> 28) & 0x00000000F0F0F0F0ULL);
+  return x;
+}
+
 }  // namespace
 
 XtcPageRenderer::XtcPageRenderer(GfxRenderer& renderer) : renderer_(renderer) {}
 
 XtcPageRenderer::RenderResult XtcPageRenderer::render(xtc::XtcParser& parser, const uint32_t pageNum,
                                                       const RefreshCallback& refreshCallback) {
-  if (pageNum >= parser.getPageCount()) return RenderResult::EndOfBook;
+  xtc::PageInfo pageInfo;
+  const RenderResult check = checkPage(parser, pageNum, pageInfo);
+  if (check != RenderResult::Success) return check;
+
+  if (pageInfo.bitDepth == 1) return render1Bit(parser, pageNum, pageInfo, refreshCallback);
+  return render2Bit(parser, pageNum, pageInfo.width, pageInfo.height, refreshCallback);
+}
 
+XtcPageRenderer::RenderResult XtcPageRenderer::draw(xtc::XtcParser& parser, const uint32_t pageNum) {
   xtc::PageInfo pageInfo;
+  const RenderResult check = checkPage(parser, pageNum, pageInfo);
+  if (check != RenderResult::Success) return check;
+
+  if (pageInfo.bitDepth == 1) return draw1Bit(parser, pageNum, pageInfo);
+  const RenderResult result = compose2BitPass(parser, pageNum, pageInfo.width, pageInfo.height, GrayscalePass::Base);
+  if (result != RenderResult::Success) renderer_.clearScreen();
+  return result;
+}
+
+XtcPageRenderer::RenderResult XtcPageRenderer::checkPage(xtc::XtcParser& parser, const uint32_t pageNum,
+                                                         xtc::PageInfo& pageInfo) const {
+  if (pageNum >= parser.getPageCount()) return RenderResult::EndOfBook;
   if (!parser.getPageInfo(pageNum, pageInfo)) return RenderResult::PageLoadFailed;
 
   const uint16_t width = pageInfo.width;
@@ -32,56 +66,178 @@ XtcPageRenderer::RenderResult XtcPageRenderer::render(xtc::XtcParser& parser, co
     LOG_ERR(TAG, "Invalid page dimensions");
     return RenderResult::InvalidDimensions;
   }
-
-  if (pageInfo.bitDepth == 1) return render1Bit(parser, pageNum, width, height, refreshCallback);
-  if (pageInfo.bitDepth == 2) return render2Bit(parser, pageNum, width, height, refreshCallback);
-  return RenderResult::InvalidDimensions;
+  if (pageInfo.bitDepth != 1 && pageInfo.bitDepth != 2) return RenderResult::InvalidDimensions;
+  return RenderResult::Success;
 }
 
 XtcPageRenderer::RenderResult XtcPageRenderer::render1Bit(xtc::XtcParser& parser, const uint32_t pageNum,
-                                                          const uint16_t width, const uint16_t height,
+                                                          const xtc::PageInfo& pageInfo,
                                                           const RefreshCallback& refreshCallback) {
+  const RenderResult result = draw1Bit(parser, pageNum, pageInfo);
+  if (result != RenderResult::Success) return result;
+
+  refreshCallback(RefreshRequest::Cadenced);
+  LOG_DBG(TAG, "Rendered page %u/%u (1-bit)", pageNum + 1, parser.getPageCount());
+  return RenderResult::Success;
+}
+
+XtcPageRenderer::RenderResult XtcPageRenderer::draw1Bit(xtc::XtcParser& parser, const uint32_t pageNum,
+                                                        const xtc::PageInfo& pageInfo) {
+  const uint16_t width = pageInfo.width;
+  const uint16_t height = pageInfo.height;
   const size_t rowBytes = (static_cast<size_t>(width) + 7) / 8;
   const size_t bitmapSize = rowBytes * height;
-  bool streamOverflow = false;
+  const bool transposeBlit = usesTransposeBlit(width, height);
+  // The blit writes every frame buffer byte; the per-pixel path only clears bits
+  if (!transposeBlit) renderer_.clearScreen();
 
-  renderer_.clearScreen();
+  if (takePrefetched(parser, pageNum, pageInfo)) {
+    if (transposeBlit) {
+      blitXtgStrips(prefetchBuffer_.get(), bitmapSize, 0, width, height);
+    } else {
+      drawXtgBytes(prefetchBuffer_.get(), bitmapSize, 0, width, height);
+    }
+  } else {
+    // Whole 8-row strips per chunk so every tile is complete within one callback
+    const size_t stripBytes = rowBytes * 8;
+    const size_t chunkSize = transposeBlit ? stripBytes * (4096 / stripBytes) : 4096;
+    bool streamOverflow = false;
+    const xtc::XtcError error = parser.loadPageStreaming(
+        pageNum,
+        [&](const uint8_t* data, const size_t size, const size_t offset) {
+          if (offset > bitmapSize || size > bitmapSize - offset) {
+            streamOverflow = true;
+            return false;
+          }
+
+          if (transposeBlit) {
+            if (offset % stripBytes != 0 || size % stripBytes != 0) {
+              streamOverflow = true;
+              return false;
+            }
+            blitXtgStrips(data, size, offset, width, height);
+          } else {
+            drawXtgBytes(data, size, offset, width, height);
+          }
+          esp_task_wdt_reset();
+          return true;
+        },
+        chunkSize);
+
+    if (error != xtc::XtcError::OK || streamOverflow) {
+      renderer_.clearScreen();
+      LOG_ERR(TAG, "Failed to stream page %u", pageNum);
+      return error == xtc::XtcError::OK ? RenderResult::PageLoadFailed : mapStreamError(error);
+    }
+  }
+
+  return RenderResult::Success;
+}
+
+void XtcPageRenderer::blitXtgStrips(const uint8_t* data, const size_t size, const size_t offset,
+                                    const uint16_t width, const uint16_t height) const {
+  // Portrait panel row for logical column x is (width - 1 - x), one byte per 8 logical rows:
+  // the same layout as an XTH plane. XTG and the frame buffer both use 0 for black.
+  const size_t rowBytes = width / 8;
+  const size_t stripBytes = rowBytes * 8;
+  const size_t columnBytes = xtc::xthColumnBytes(height);
+  uint8_t* const frameBuffer = renderer_.getFrameBuffer();
+
+  for (size_t stripOffset = 0; stripOffset < size; stripOffset += stripBytes) {
+    const uint8_t* strip = data + stripOffset;
+    const size_t yByte = (offset + stripOffset) / stripBytes;
+
+    for (size_t byteX = 0; byteX < rowBytes; ++byteX) {
+      uint64_t tile = 0;
+      for (size_t row = 0; row < 8; ++row) {
+        tile = (tile << 8) | strip[row * rowBytes + byteX];
+      }
+      if (tile != ~0ULL) tile = transpose8x8(tile);
+      // Panel row of the tile's first column; the next seven follow in reverse
+      size_t out = (width - 1 - byteX * 8) * columnBytes + yByte;
+      for (int column = 0; column < 8; ++column) {
+        frameBuffer[out] = static_cast<uint8_t>(tile >> (56 - column * 8));
+        out -= columnBytes;
+      }
+    }
+  }
+}
+
+void XtcPageRenderer::drawXtgBytes(const uint8_t* data, const size_t size, const size_t offset, const uint16_t width,
+                                   const uint16_t height) const {
+  const size_t rowBytes = (static_cast<size_t>(width) + 7) / 8;
+  for (size_t i = 0; i < size; ++i) {
+    const size_t byteOffset = offset + i;
+    const uint16_t y = static_cast<uint16_t>(byteOffset / rowBytes);
+    const uint16_t baseX = static_cast<uint16_t>((byteOffset % rowBytes) * 8);
+    if (y >= height || y >= renderer_.getScreenHeight()) continue;
+
+    const uint8_t byte = data[i];
+    if (byte == 0xFF) continue;
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      const uint16_t x = baseX + bit;
+      if (x >= width || x >= renderer_.getScreenWidth()) break;
+      if ((byte & static_cast<uint8_t>(0x80U >> bit)) == 0) renderer_.drawPixel(x, y, true);
+    }
+  }
+}
+
+bool XtcPageRenderer::takePrefetched(const xtc::XtcParser& parser, const uint32_t pageNum,
+                                     const xtc::PageInfo& pageInfo) {
+  if (!hasPrefetchedPage(parser, pageNum)) return false;
+  const bool matches =
+      prefetchOffset_ == pageInfo.offset && prefetchSize_ == xtc::xtgBitmapSize(pageInfo.width, pageInfo.height);
+  prefetchSize_ = 0;
+  return matches;
+}
+
+bool XtcPageRenderer::prefetchPage(xtc::XtcParser& parser, const uint32_t pageNum,
+                                   const std::function<bool()>& shouldAbort) {
+  prefetchSize_ = 0;
+  if (pageNum >= parser.getPageCount()) return false;
+
+  xtc::PageInfo pageInfo;
+  if (!parser.getPageInfo(pageNum, pageInfo) || pageInfo.bitDepth != 1) return false;
+  const size_t bitmapSize = xtc::xtgBitmapSize(pageInfo.width, pageInfo.height);
+  if (bitmapSize == 0 || bitmapSize > xtc::XTC_MAX_BITMAP_SIZE) return false;
+
+  if (bitmapSize > prefetchCapacity_) {
+    releasePrefetch();
+    if (heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < bitmapSize + PREFETCH_HEAP_RESERVE) {
+      LOG_DBG(TAG, "Prefetch of page %u skipped: low heap", pageNum);
+      TRACE_INSTANT(PrefetchSkip);
+      return false;
+    }
+    prefetchBuffer_.reset(new (std::nothrow) uint8_t[bitmapSize]);
+    if (!prefetchBuffer_) return false;
+    prefetchCapacity_ = bitmapSize;
+  }
+
+  // Streamed in chunks so a page turn can stop the task between SD reads
   const xtc::XtcError error = parser.loadPageStreaming(
       pageNum,
       [&](const uint8_t* data, const size_t size, const size_t offset) {
-        if (offset > bitmapSize || size > bitmapSize - offset) {
-          streamOverflow = true;
-          return false;
-        }
-
-        for (size_t i = 0; i < size; ++i) {
-          const size_t byteOffset = offset + i;
-          const uint16_t y = static_cast<uint16_t>(byteOffset / rowBytes);
-          const uint16_t baseX = static_cast<uint16_t>((byteOffset % rowBytes) * 8);
-          if (y >= height || y >= renderer_.getScreenHeight()) continue;
-
-          const uint8_t byte = data[i];
-          if (byte == 0xFF) continue;
-          for (uint8_t bit = 0; bit < 8; ++bit) {
-            const uint16_t x = baseX + bit;
-            if (x >= width || x >= renderer_.getScreenWidth()) break;
-            if ((byte & static_cast<uint8_t>(0x80U >> bit)) == 0) renderer_.drawPixel(x, y, true);
-          }
-        }
-        esp_task_wdt_reset();
+        if (offset > bitmapSize || size > bitmapSize - offset) return false;
+        memcpy(prefetchBuffer_.get() + offset, data, size);
         return true;
       },
-      4096);
-
-  if (error != xtc::XtcError::OK || streamOverflow) {
-    renderer_.clearScreen();
-    LOG_ERR(TAG, "Failed to stream page %u", pageNum);
-    return error == xtc::XtcError::OK ? RenderResult::PageLoadFailed : mapStreamError(error);
+      4096, shouldAbort);
+  if (error != xtc::XtcError::OK) {
+    LOG_DBG(TAG, "Prefetch of page %u failed", pageNum);
+    return false;
   }
+  prefetchParser_ = &parser;
+  prefetchPage_ = pageNum;
+  prefetchOffset_ = pageInfo.offset;
+  prefetchSize_ = bitmapSize;
+  return true;
+}
 
-  refreshCallback(RefreshRequest::Cadenced);
-  LOG_DBG(TAG, "Rendered page %u/%u (1-bit)", pageNum + 1, parser.getPageCount());
-  return RenderResult::Success;
+void XtcPageRenderer::releasePrefetch() {
+  prefetchBuffer_.reset();
+  prefetchCapacity_ = 0;
+  prefetchSize_ = 0;
+  prefetchParser_ = nullptr;
 }
 
 XtcPageRenderer::RenderResult XtcPageRenderer::render2Bit(xtc::XtcParser& parser, const uint32_t pageNum,
@@ -199,6 +355,10 @@ bool XtcPageRenderer::usesNativeXthLayout(const uint16_t width, const uint16_t h
          height == renderer_.getScreenHeight() && planeSize == renderer_.getBufferSize();
 }
 
+bool XtcPageRenderer::usesTransposeBlit(const uint16_t width, const uint16_t height) const {
+  return width % 8 == 0 && height % 8 == 0 && usesNativeXthLayout(width, height, xtc::xthPlaneSize(width, height));
+}
+
 void XtcPageRenderer::recoverGrayscaleFailure() {
   renderer_.clearScreen();
   renderer_.cleanupGrayscaleWithFrameBuffer();
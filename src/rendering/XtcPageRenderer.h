@@ -3,17 +3,24 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 
 class GfxRenderer;
 
 namespace xtc {
 class XtcParser;
+struct PageInfo;
 }
 
 namespace papyrix {
 
 // XtcPageRenderer - Renders XTC/XTCH binary page data to GfxRenderer
 // Supports 1-bit (B&W) and 2-bit (4-level grayscale) formats
+//
+// Full-screen portrait 1-bit pages are blitted by transposing 8x8 tiles straight
+// into the panel's column layout. While a 1-bit page is shown, ReaderState's cache
+// task reads the next page into a spare buffer (heap permitting) so the following
+// page turn skips SD.
 class XtcPageRenderer {
  public:
   enum class RenderResult { Success, EndOfBook, InvalidDimensions, AllocationFailed, PageLoadFailed };
@@ -24,18 +31,50 @@ class XtcPageRenderer {
 
   RenderResult render(xtc::XtcParser& parser, uint32_t pageNum, const RefreshCallback& refreshCallback);
 
+  // Draw the page into the frame buffer without refreshing the panel: a 1-bit
+  // page as is, a 2-bit page as its black-and-white base plane
+  RenderResult draw(xtc::XtcParser& parser, uint32_t pageNum);
+
+  // Read a 1-bit page into the prefetch buffer for the next render() of it.
+  // Runs on the cache task; false if skipped (2-bit page, low heap) or aborted.
+  bool prefetchPage(xtc::XtcParser& parser, uint32_t pageNum, const std::function<bool()>& shouldAbort = nullptr);
+
+  // Drop the prefetched page and free its buffer (book closed)
+  void releasePrefetch();
+
+  bool hasPrefetchedPage(const xtc::XtcParser& parser, uint32_t pageNum) const {
+    return prefetchSize_ != 0 && prefetchParser_ == &parser && prefetchPage_ == pageNum;
+  }
+
+  // Largest free block that must remain after allocating the prefetch buffer
+  static constexpr size_t PREFETCH_HEAP_RESERVE = 16 * 1024;
+
  private:
   enum class GrayscalePass : uint8_t { Base, Lsb, Msb };
 
   GfxRenderer& renderer_;
 
-  RenderResult render1Bit(xtc::XtcParser& parser, uint32_t pageNum, uint16_t width, uint16_t height,
+  // Next-page prefetch (1-bit pages only)
+  std::unique_ptr<uint8_t[]> prefetchBuffer_;
+  size_t prefetchCapacity_ = 0;
+  size_t prefetchSize_ = 0;
+  uint64_t prefetchOffset_ = 0;
+  const xtc::XtcParser* prefetchParser_ = nullptr;
+  uint32_t prefetchPage_ = 0;
+
+  RenderResult checkPage(xtc::XtcParser& parser, uint32_t pageNum, xtc::PageInfo& pageInfo) const;
+  RenderResult render1Bit(xtc::XtcParser& parser, uint32_t pageNum, const xtc::PageInfo& pageInfo,
                           const RefreshCallback& refreshCallback);
+  RenderResult draw1Bit(xtc::XtcParser& parser, uint32_t pageNum, const xtc::PageInfo& pageInfo);
   RenderResult render2Bit(xtc::XtcParser& parser, uint32_t pageNum, uint16_t width, uint16_t height,
                           const RefreshCallback& refreshCallback);
   RenderResult compose2BitPass(xtc::XtcParser& parser, uint32_t pageNum, uint16_t width, uint16_t height,
                                GrayscalePass pass);
   bool usesNativeXthLayout(uint16_t width, uint16_t height, size_t planeSize) const;
+  bool usesTransposeBlit(uint16_t width, uint16_t height) const;
+  void blitXtgStrips(const uint8_t* data, size_t size, size_t offset, uint16_t width, uint16_t height) const;
+  void drawXtgBytes(const uint8_t* data, size_t size, size_t offset, uint16_t width, uint16_t height) const;
+  bool takePrefetched(const xtc::XtcParser& parser, uint32_t pageNum, const xtc::PageInfo& pageInfo);
   void recoverGrayscaleFailure();
 };
 
@@ -1,6 +1,7 @@
 #include "CalibreSyncState.h"
 
 #include <Arduino.h>
+#include <FileIndex.h>
 #include <GfxRenderer.h>
 #include <I18n.h>
 #include <Logging.h>
@@ -8,8 +9,10 @@
 #include <unistd.h>
 
 #include "../config.h"
+#include "../content/LibraryStore.h"
 #include "../core/Core.h"
 #include "../ui/Elements.h"
+#include "FileListState.h"
 #include "ThemeManager.h"
 
 #define TAG "CALIBRE"
@@ -264,6 +267,10 @@ void CalibreSyncState::onBook(void* ctx, const calibre_book_meta_t* meta, const
 
   self->booksReceived_++;
   LOG_INF(TAG, "Book received: \"%s\" -> %s", meta->title ? meta->title : "(null)", path ? path : "(null)");
+  if (path) {
+    FileIndex::noteAdded(path, false, FileListState::acceptEntry);
+    LIBRARY.update(path, meta->title, meta->authors);
+  }
 
   // Show "received N books" status instead of stuck progress bar
   snprintf(self->calibreView_.statusMsg, ui::CalibreView::MAX_STATUS_LEN, "Received %d book(s)", self->booksReceived_);
@@ -306,6 +313,8 @@ bool CalibreSyncState::onDelete(void* ctx, const char* lpath) {
 
   /* Delete the file */
   if (unlink(full_path) == 0) {
+    FileIndex::noteRemoved(full_path);
+    LIBRARY.remove(full_path);
     LOG_INF(TAG, "Deleted book: %s", full_path);
     return true;
   } else {
@@ -16,6 +16,7 @@
 #include <cstring>
 #include <new>
 
+#include "../content/LibraryStore.h"
 #include "../content/RecentBooksStore.h"
 #include "../core/BootMode.h"
 #include "../core/Core.h"
@@ -91,6 +92,7 @@ void FileListState::enter(Core& core) {
 void FileListState::exit(Core& core) {
   LOG_INF(TAG, "Exiting");
   fileIndex_.reset();
+  LIBRARY.close();
   std::vector<FileEntry>().swap(files_);
 }
 
@@ -227,6 +229,7 @@ bool FileListState::isSupportedFile(const char* name) {
   if (strcasecmp(ext, "md") == 0) return true;
   if (strcasecmp(ext, "markdown") == 0) return true;
   if (strcasecmp(ext, "fb2") == 0) return true;
+  if (strcasecmp(ext, "zip") == 0) return FsHelpers::isFb2File(name);  // .fb2.zip only
   if (strcasecmp(ext, "html") == 0) return true;
   if (strcasecmp(ext, "htm") == 0) return true;
   return false;
@@ -239,16 +242,20 @@ bool FileListState::isTrashRootEntry() {
   return isAtRoot() && entryAt(selectedIndex_, entry) && entry.isDir && trash::isDirectoryName(entry.name);
 }
 
-bool FileListState::buildSelectedPath(char* path, size_t pathSize) {
-  FileEntryView entry{};
-  if (!entryAt(selectedIndex_, entry) || currentDir_[0] == '\0') return false;
+bool FileListState::buildEntryPath(const char* name, char* path, size_t pathSize) const {
+  if (currentDir_[0] == '\0') return false;
 
   const size_t dirLen = strlen(currentDir_);
   const char* separator = currentDir_[dirLen - 1] == '/' ? "" : "/";
-  const int written = snprintf(path, pathSize, "%s%s%s", currentDir_, separator, entry.name);
+  const int written = snprintf(path, pathSize, "%s%s%s", currentDir_, separator, name);
   return written >= 0 && static_cast<size_t>(written) < pathSize;
 }
 
+bool FileListState::buildSelectedPath(char* path, size_t pathSize) {
+  FileEntryView entry{};
+  return entryAt(selectedIndex_, entry) && buildEntryPath(entry.name, path, pathSize);
+}
+
 bool FileListState::findVacantPath(Core& core, const char* directory, const char* filename, char* path,
                                    size_t pathSize) const {
   return trash::findVacantPath(path, pathSize, directory, filename, [&](const char* candidate) {
@@ -323,6 +330,8 @@ void FileListState::executeConfirmedAction(Core& core) {
     ui::centeredMessage(renderer_, THEME, THEME.uiFontId, tr(CANNOT_DELETE_ACTIVE));
     vTaskDelay(1500 / portTICK_PERIOD_MS);
   } else {
+    // Indexes are patched in place below; don't keep one open meanwhile
+    fileIndex_.reset();
     bool success = false;
     const char* status = tr(DELETE_FAILED);
 
@@ -339,6 +348,12 @@ void FileListState::executeConfirmedAction(Core& core) {
       }
       status = success ? tr(MOVED_TO_TRASH) : tr(MOVE_TO_TRASH_FAILED);
       if (success) {
+        FileIndex::noteRenamed(selectedPath_, actionDestination_, entry.isDir, acceptEntry);
+        if (entry.isDir) {
+          LIBRARY.renameDirectory(selectedPath_, actionDestination_);
+        } else {
+          LIBRARY.rename(selectedPath_, actionDestination_);
+        }
         RecentBooksStore::instance().remove(selectedPath_);
       }
     } else if (currentScreen_ == Screen::ConfirmRestore) {
@@ -362,6 +377,14 @@ void FileListState::executeConfirmedAction(Core& core) {
       if (targetFound) {
         ui::centeredMessage(renderer_, THEME, THEME.uiFontId, tr(RESTORING));
         success = core.storage.rename(selectedPath_, actionDestination_).ok();
+        if (success) {
+          FileIndex::noteRenamed(selectedPath_, actionDestination_, entry.isDir, acceptEntry);
+          if (entry.isDir) {
+            LIBRARY.renameDirectory(selectedPath_, actionDestination_);
+          } else {
+            LIBRARY.rename(selectedPath_, actionDestination_);
+          }
+        }
       }
       status = success ? tr(RESTORED) : tr(RESTORE_FAILED);
     } else if (currentScreen_ == Screen::ConfirmPermanentDelete) {
@@ -369,11 +392,17 @@ void FileListState::executeConfirmedAction(Core& core) {
       success = core.storage.remove(selectedPath_).ok();
       status = success ? tr(DELETED) : tr(DELETE_FAILED);
       if (success) {
+        FileIndex::noteRemoved(selectedPath_);
+        LIBRARY.remove(selectedPath_);
         RecentBooksStore::instance().remove(selectedPath_);
       }
     } else if (currentScreen_ == Screen::ConfirmDeleteDirectory) {
       ui::centeredMessage(renderer_, THEME, THEME.uiFontId, tr(DELETING));
       success = core.storage.rmdir(selectedPath_).ok();
+      if (success) {
+        FileIndex::noteRemoved(selectedPath_);
+        LIBRARY.removeDirectory(selectedPath_);
+      }
       status = success ? tr(DELETED) : tr(DELETE_FAILED);
     }
 
@@ -537,11 +566,31 @@ void FileListState::render(Core& core) {
   const int pageStart = getPageStartIndex();
   const int pageEnd = std::min(pageStart + pageItems, static_cast<int>(count));
 
+  // Books opened before show their title, author and progress from the library database
+  char entryPath[BufferSize::TrashPath];
+  char label[160];
+  char progress[8];
+  papyrix::LibraryStore::Entry book;
   for (int i = pageStart; i < pageEnd; i++) {
     FileEntryView entry{};
     if (!entryAt(static_cast<size_t>(i), entry)) continue;
     const int y = listStartY + (i - pageStart) * itemHeight;
-    ui::fileEntry(renderer_, theme, y, entry.name, entry.isDir, static_cast<size_t>(i) == selectedIndex_);
+    const char* name = entry.name;
+    const char* detail = nullptr;
+    if (!entry.isDir && buildEntryPath(entry.name, entryPath, sizeof(entryPath)) && LIBRARY.find(entryPath, book) &&
+        !book.title.empty()) {
+      if (book.author.empty()) {
+        snprintf(label, sizeof(label), "%s", book.title.c_str());
+      } else {
+        snprintf(label, sizeof(label), "%s - %s", book.title.c_str(), book.author.c_str());
+      }
+      name = label;
+      if (book.progress != papyrix::LibraryStore::NO_PROGRESS) {
+        snprintf(progress, sizeof(progress), "%u%%", static_cast<unsigned>(book.progress));
+        detail = progress;
+      }
+    }
+    ui::fileEntry(renderer_, theme, y, name, entry.isDir, static_cast<size_t>(i) == selectedIndex_, detail);
   }
 
   FileEntryView selected{};
@@ -43,6 +43,9 @@ class FileListState : public State {
   // Set initial directory before entering
   void setDirectory(const char* dir);
 
+  // Entries the browser lists; also used to keep directory indexes in step
+  static bool acceptEntry(const char* name, bool isDir);
+
  private:
   GfxRenderer& renderer_;
   char currentDir_[BufferSize::TrashPath];
@@ -76,9 +79,9 @@ class FileListState : public State {
   size_t entryCount() const;
   bool entryAt(size_t index, FileEntryView& out);
   size_t findEntryByName(const char* name);
-  static bool acceptEntry(const char* name, bool isDir);
   bool isTrashDirectory() const;
   bool isTrashRootEntry();
+  bool buildEntryPath(const char* name, char* path, size_t pathSize) const;
   bool buildSelectedPath(char* path, size_t pathSize);
   bool findVacantPath(Core& core, const char* directory, const char* filename, char* path, size_t pathSize) const;
   void setupFileConfirm(Screen screen, const char* title, const char* question);
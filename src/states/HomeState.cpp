@@ -13,6 +13,7 @@
 
 #include "../config.h"
 #include "../content/ContentTypes.h"
+#include "../content/LibraryStore.h"
 #include "../core/BootMode.h"
 #include "../core/Core.h"
 #include "../core/CrashDebug.h"
@@ -73,14 +74,22 @@ void HomeState::loadLastBook(Core& core) {
     }
 
     const auto contentType = detectContentType(savedPath);
+    // A book opened before has its title in the library database; its cache path needs only the file path
+    LibraryStore::Entry book;
+    const bool known = LIBRARY.find(savedPath, book) && !book.title.empty();
+    LIBRARY.close();
 
     if (contentType == ContentType::Epub) {
       // EPUB: lightweight metadata-only load (no CSS, TOC, spine splitting)
       papyrix::crashdebug::mark(papyrix::crashdebug::CrashPhase::HomeMetadataLoad);
       Epub epub(savedPath, papyrix::drivers::Device::instance().cacheDir());
-      if (epub.loadMetadataOnly()) {
+      if (known || epub.loadMetadataOnly()) {
         papyrix::crashdebug::clear();
-        view_.setBook(epub.getTitle().c_str(), epub.getAuthor().c_str(), savedPath);
+        if (known) {
+          view_.setBook(book.title.c_str(), book.author.c_str(), savedPath);
+        } else {
+          view_.setBook(epub.getTitle().c_str(), epub.getAuthor().c_str(), savedPath);
+        }
         strncpy(core.buf.path, savedPath, sizeof(core.buf.path) - 1);
         core.buf.path[sizeof(core.buf.path) - 1] = '\0';
 
@@ -94,9 +103,13 @@ void HomeState::loadLastBook(Core& core) {
       // FB2: lightweight metadata-only load (no section scanning/file generation)
       papyrix::crashdebug::mark(papyrix::crashdebug::CrashPhase::HomeMetadataLoad);
       Fb2 fb2(savedPath, papyrix::drivers::Device::instance().cacheDir());
-      if (fb2.loadMetadataOnly()) {
+      if (known || fb2.loadMetadataOnly()) {
         papyrix::crashdebug::clear();
-        view_.setBook(fb2.getTitle().c_str(), fb2.getAuthor().c_str(), savedPath);
+        if (known) {
+          view_.setBook(book.title.c_str(), book.author.c_str(), savedPath);
+        } else {
+          view_.setBook(fb2.getTitle().c_str(), fb2.getAuthor().c_str(), savedPath);
+        }
         strncpy(core.buf.path, savedPath, sizeof(core.buf.path) - 1);
         core.buf.path[sizeof(core.buf.path) - 1] = '\0';
 
@@ -113,7 +126,11 @@ void HomeState::loadLastBook(Core& core) {
       papyrix::crashdebug::clear();
       if (result.ok()) {
         const auto& meta = core.content.metadata();
-        view_.setBook(meta.title, meta.author, savedPath);
+        if (known) {
+          view_.setBook(book.title.c_str(), book.author.c_str(), savedPath);
+        } else {
+          view_.setBook(meta.title, meta.author, savedPath);
+        }
         strncpy(core.buf.path, savedPath, sizeof(core.buf.path) - 1);
         core.buf.path[sizeof(core.buf.path) - 1] = '\0';
 
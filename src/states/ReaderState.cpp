@@ -30,14 +30,19 @@
 #include "../config.h"
 #include "../content/BookmarkManager.h"
 #include "../content/FileFingerprint.h"
+#include "../content/LibraryStore.h"
+#include "../content/MetricsIndex.h"
 #include "../content/ProgressManager.h"
 #include "../content/ReaderNavigation.h"
 #include "../content/ReadingStatsStore.h"
 #include "../content/RecentBooksStore.h"
+#include "../content/ResumeSnapshot.h"
 #include "../core/BootMode.h"
 #include "../core/Core.h"
 #include "../core/EmergencyBootTransition.h"
 #include "../core/ExitToUiTransition.h"
+#include "../core/LoopScheduler.h"
+#include "../core/Trace.h"
 #include "../drivers/Device.h"
 #include "../ui/Elements.h"
 #include "../ui/views/ReaderViews.h"
@@ -56,8 +61,6 @@ static constexpr int kCacheTaskStopTimeoutMs = 10000;  // 10s - generous for slo
 namespace {
 constexpr int horizontalPadding = 5;
 constexpr int statusBarMargin = 23;
-constexpr uint8_t kMetricsIndexVersion = 4;
-constexpr const char* kMetricsIndexFilename = "metrics.bin";
 constexpr uint32_t kAnchorMapMagic = 0x48434E41;  // "ANCH" in little-endian files
 constexpr uint8_t kAnchorMapVersion = 1;
 constexpr size_t kColdMinFreeHeap = 28 * 1024;
@@ -70,127 +73,35 @@ inline std::string epubSectionCachePath(const std::string& epubCachePath, int sp
   return epubCachePath + "/sections/" + std::to_string(spineIndex) + ".bin";
 }
 
+// Cache file of one EPUB spine item or FB2 section; empty for single-file content
+std::string sectionCachePath(Core& core, const int spineIndex) {
+  const ContentType type = core.content.metadata().type;
+  if (type == ContentType::Epub) {
+    auto* provider = core.content.asEpub();
+    if (provider && provider->getEpub()) return epubSectionCachePath(provider->getEpub()->getCachePath(), spineIndex);
+  } else if (type == ContentType::Fb2) {
+    auto* fb2Provider = core.content.asFb2();
+    if (fb2Provider && fb2Provider->getFb2()) return fb2Provider->getSectionCachePath(spineIndex);
+  }
+  return "";
+}
+
 inline std::string contentCachePath(const char* cacheDir, int fontId) {
   return std::string(cacheDir) + "/pages_" + std::to_string(fontId) + ".bin";
 }
 
-struct MetricsEntry {
-  uint32_t pages;
-  bool exact;
-  uint32_t byteSize;
-};
-
-bool readMetricsIndexFile(const std::string& sectionsDir, const RenderConfig& config, int spineCount,
-                          std::vector<MetricsEntry>& out) {
-  const std::string path = sectionsDir + "/" + kMetricsIndexFilename;
-  FsFile file;
-  if (!SdMan.openFileForRead("MIDX", path, file)) return false;
-
-  uint8_t version;
-  if (!serialization::readPodChecked(file, version) || version != kMetricsIndexVersion) {
-    file.close();
-    return false;
-  }
-
-  RenderConfig fileConfig;
-  const bool configRead = serialization::readPodChecked(file, fileConfig.fontId) &&
-                          serialization::readPodChecked(file, fileConfig.lineCompression) &&
-                          serialization::readPodChecked(file, fileConfig.indentLevel) &&
-                          serialization::readPodChecked(file, fileConfig.spacingLevel) &&
-                          serialization::readPodChecked(file, fileConfig.paragraphAlignment) &&
-                          serialization::readPodChecked(file, fileConfig.hyphenation) &&
-                          serialization::readPodChecked(file, fileConfig.showImages) &&
-                          serialization::readPodChecked(file, fileConfig.viewportWidth) &&
-                          serialization::readPodChecked(file, fileConfig.viewportHeight) &&
-                          serialization::readPodChecked(file, fileConfig.sourceFingerprint) &&
-                          serialization::readPodChecked(file, fileConfig.fontFingerprint);
-  if (!configRead || config != fileConfig) {
-    file.close();
-    return false;
-  }
-
-  uint16_t entryCount;
-  if (!serialization::readPodChecked(file, entryCount) || entryCount != static_cast<uint16_t>(spineCount)) {
-    file.close();
-    return false;
-  }
+inline std::string checkpointPath(const std::string& cachePath) { return cachePath + ".ckpt"; }
 
-  std::vector<MetricsEntry> decoded(static_cast<size_t>(spineCount));
-  for (int i = 0; i < spineCount; ++i) {
-    uint32_t pages;
-    uint8_t flags;
-    uint32_t byteSize;
-    if (!serialization::readPodChecked(file, pages) || !serialization::readPodChecked(file, flags) ||
-        !serialization::readPodChecked(file, byteSize)) {
-      file.close();
-      return false;
-    }
-    decoded[static_cast<size_t>(i)] = MetricsEntry{pages, (flags & 1) != 0, byteSize};
-  }
+inline std::string tocPath(const std::string& cachePath) { return cachePath + ".toc"; }
 
-  file.close();
-  out.swap(decoded);
-  return true;
+// Hot resume, or a cold one that starts from a checkpoint near the end of the cache
+bool parserResumesCheaply(const ContentParser& parser, uint32_t cachedPages) {
+  return parser.canResume() ||
+         page_cache::checkpointReplayIsCheap(parser.checkpointBefore(cachedPages), cachedPages);
 }
 }  // namespace
 
-bool ReaderState::saveMetricsIndex(const std::string& sectionsDir, const RenderConfig& config) {
-  if (globalSectionPageMetrics_.empty()) return false;
-
-  const std::string path = sectionsDir + "/" + kMetricsIndexFilename;
-  FsFile file;
-  if (!SdMan.openFileForWrite("MIDX", path, file)) return false;
-
-  if (globalSectionPageMetrics_.size() > UINT16_MAX) {
-    file.close();
-    SdMan.remove(path.c_str());
-    return false;
-  }
-  const uint16_t entryCount = static_cast<uint16_t>(globalSectionPageMetrics_.size());
-  bool writeOk = serialization::writePodChecked(file, kMetricsIndexVersion) &&
-                 serialization::writePodChecked(file, config.fontId) &&
-                 serialization::writePodChecked(file, config.lineCompression) &&
-                 serialization::writePodChecked(file, config.indentLevel) &&
-                 serialization::writePodChecked(file, config.spacingLevel) &&
-                 serialization::writePodChecked(file, config.paragraphAlignment) &&
-                 serialization::writePodChecked(file, config.hyphenation) &&
-                 serialization::writePodChecked(file, config.showImages) &&
-                 serialization::writePodChecked(file, config.viewportWidth) &&
-                 serialization::writePodChecked(file, config.viewportHeight) &&
-                 serialization::writePodChecked(file, config.sourceFingerprint) &&
-                 serialization::writePodChecked(file, config.fontFingerprint) &&
-                 serialization::writePodChecked(file, entryCount);
-
-  for (const auto& m : globalSectionPageMetrics_) {
-    const uint8_t flags = m.exact ? 1 : 0;
-    writeOk = writeOk && serialization::writePodChecked(file, m.pages) && serialization::writePodChecked(file, flags) &&
-              serialization::writePodChecked(file, m.byteSize);
-  }
-  writeOk = writeOk && file.sync();
-  file.close();
-  if (!writeOk) {
-    SdMan.remove(path.c_str());
-    return false;
-  }
-  LOG_DBG(TAG, "Saved metrics index: %u entries", entryCount);
-  return true;
-}
-
-bool ReaderState::loadMetricsIndex(const std::string& sectionsDir, const RenderConfig& config, int spineCount) {
-  std::vector<MetricsEntry> entries;
-  if (!readMetricsIndexFile(sectionsDir, config, spineCount, entries)) return false;
-  globalSectionPageMetrics_.resize(static_cast<size_t>(spineCount));
-  for (int i = 0; i < spineCount; ++i) {
-    auto& m = globalSectionPageMetrics_[static_cast<size_t>(i)];
-    m.pages = entries[static_cast<size_t>(i)].pages;
-    m.exact = entries[static_cast<size_t>(i)].exact;
-    m.byteSize = entries[static_cast<size_t>(i)].byteSize;
-  }
-  LOG_DBG(TAG, "Loaded metrics index: %d entries", spineCount);
-  return true;
-}
-
-void ReaderState::deleteMetricsIndex(Core& core) {
+void ReaderState::removeLegacyIndexMarker(Core& core) {
   const ContentType type = core.content.metadata().type;
   std::string sectionsDir;
   if (type == ContentType::Epub) {
@@ -202,10 +113,6 @@ void ReaderState::deleteMetricsIndex(Core& core) {
   } else {
     return;
   }
-  const std::string path = sectionsDir + "/" + kMetricsIndexFilename;
-  if (SdMan.exists(path.c_str())) {
-    SdMan.remove(path.c_str());
-  }
 
   // Sweep the obsolete ".indexed" marker left by 1.24.0-dev builds. That marker could
   // not represent a skipped/partial spine, so it pinned such books to an approximate
@@ -304,7 +211,8 @@ void ReaderState::invalidateGlobalPageMetrics() {
   globalSectionPageMetricsInitialized_ = false;
 }
 
-void ReaderState::initializeGlobalPageMetrics(Core& core) {
+void ReaderState::initializeGlobalPageMetrics(Core& core, const bool allowScan,
+                                              const BackgroundTask::AbortCallback& shouldAbort) {
   invalidateGlobalPageMetrics();
 
   const ContentType type = core.content.metadata().type;
@@ -335,7 +243,7 @@ void ReaderState::initializeGlobalPageMetrics(Core& core) {
   globalSectionPageMetrics_.resize(static_cast<size_t>(spineCount));
 
   // Complete caches may legitimately have 0 pages (e.g. FB2 image-only sections
-  // where Fb2Parser skips <image>). Those must still count as exact so Full Book
+  // with images turned off). Those must still count as exact so Full Book
   // Process can clear the status-bar "~" (Issue #136 residual).
   auto applyLivePageCacheOverlay = [&]() -> bool {
     if (currentSpineIndex_ < 0 || currentSpineIndex_ >= spineCount || !pageCache_) {
@@ -346,14 +254,23 @@ void ReaderState::initializeGlobalPageMetrics(Core& core) {
     return cacheUpdate.changed;
   };
 
-  // Fast path: metrics.bin already has exact page counts for every spine.
-  // Skip the per-spine getItemSize / directory-scan / calibration work entirely.
-  if (loadMetricsIndex(sectionsDir, config, spineCount)) {
+  // Fast path: metrics.bin is kept current by every section cache write, so it
+  // already holds the whole-book counts. Skip the per-spine getItemSize /
+  // directory-scan / calibration work entirely.
+  metrics_index::Index index;
+  if (metrics_index::load(sectionsDir, config, static_cast<size_t>(spineCount), index)) {
+    globalSectionPageMetrics_.swap(index.sections);
     const bool overlayChanged = applyLivePageCacheOverlay();
     globalSectionPageMetricsInitialized_ = true;
     if (overlayChanged) {
-      saveMetricsIndex(sectionsDir, config);
+      metrics_index::save(sectionsDir, config, globalSectionPageMetrics_);
     }
+    LOG_DBG(TAG, "Loaded metrics index: %d entries, %u bytes/page", spineCount,
+            static_cast<unsigned>(index.bytesPerPage));
+    return;
+  }
+  if (!allowScan) {
+    invalidateGlobalPageMetrics();
     return;
   }
 
@@ -401,9 +318,14 @@ void ReaderState::initializeGlobalPageMetrics(Core& core) {
     while ((entry = dir.openNextFile(O_RDONLY))) {
       entry.getName(name, sizeof(name));
       entry.close();
+      if (shouldAbort && shouldAbort()) {
+        dir.close();
+        invalidateGlobalPageMetrics();
+        return;
+      }
 
       if (prefixLen > 0 && strncmp(name, filePrefix, prefixLen) != 0) continue;
-      if (strcmp(name, kMetricsIndexFilename) == 0) continue;
+      if (strcmp(name, metrics_index::FILENAME) == 0) continue;
       char* dot = strrchr(name + prefixLen, '.');
       if (!dot || strcmp(dot, ".bin") != 0) continue;
       *dot = '\0';
@@ -425,23 +347,12 @@ void ReaderState::initializeGlobalPageMetrics(Core& core) {
 
   applyLivePageCacheOverlay();
 
-  uint64_t calibrationBytes = 0;
-  uint32_t calibrationPages = 0;
-  for (const auto& metric : globalSectionPageMetrics_) {
-    if (metric.exact && metric.byteSize > 0 && metric.pages > 0) {
-      calibrationBytes += metric.byteSize;
-      calibrationPages += metric.pages;
-    }
-  }
-
-  const size_t bytesPerPage = calibrationPages > 0
-                                  ? static_cast<size_t>(std::max<uint64_t>(256, calibrationBytes / calibrationPages))
-                                  : page_metrics::kEstimatedBytesPerPage;
-  page_metrics::fillEstimates(globalSectionPageMetrics_, bytesPerPage);
+  const size_t learned = page_metrics::learnedBytesPerPage(globalSectionPageMetrics_);
+  page_metrics::fillEstimates(globalSectionPageMetrics_, learned > 0 ? learned : page_metrics::kEstimatedBytesPerPage);
 
   globalSectionPageMetricsInitialized_ = true;
 
-  saveMetricsIndex(sectionsDir, config);
+  metrics_index::save(sectionsDir, config, globalSectionPageMetrics_);
 }
 
 void ReaderState::updateGlobalPageMetrics(Core& core) {
@@ -449,7 +360,8 @@ void ReaderState::updateGlobalPageMetrics(Core& core) {
   if (type != ContentType::Epub && type != ContentType::Fb2) return;
 
   if (!globalSectionPageMetricsInitialized_) {
-    initializeGlobalPageMetrics(core);
+    // Until startup is done the cache task builds them; the page uses section numbers meanwhile
+    initializeGlobalPageMetrics(core, startup_.reached(ReaderStartupStage::Ready));
   }
 
   if (!globalSectionPageMetricsInitialized_ || currentSpineIndex_ < 0 ||
@@ -457,22 +369,33 @@ void ReaderState::updateGlobalPageMetrics(Core& core) {
     return;
   }
 
-  auto& metric = globalSectionPageMetrics_[static_cast<size_t>(currentSpineIndex_)];
-  const auto cacheUpdate = page_metrics::applyCache(metric, pageCache_->pageCount(), pageCache_->isPartial());
+  const Theme& theme = THEME_MANAGER.current();
+  const auto vp = getReaderViewport(core.settings.statusBar != 0);
+  recordSectionCache(currentSpineIndex_, pageCache_->path(), makeRenderConfig(core, theme, vp), pageCache_->pageCount(),
+                     pageCache_->isPartial());
+}
+
+void ReaderState::recordSectionCache(const int spineIndex, const std::string& cachePath, const RenderConfig& config,
+                                     const uint32_t pageCount, const bool partial) {
+  // Section caches sit directly in the sections directory, next to metrics.bin
+  const size_t slash = cachePath.rfind('/');
+  if (spineIndex < 0 || slash == std::string::npos) return;
+  const std::string sectionsDir = cachePath.substr(0, slash);
+
+  if (!globalSectionPageMetricsInitialized_) {
+    // Not loaded yet: update the file so the next load sees this section
+    metrics_index::recordSection(sectionsDir, config, spineIndex, pageCount, partial);
+    return;
+  }
+  if (spineIndex >= static_cast<int>(globalSectionPageMetrics_.size())) return;
 
+  auto& metric = globalSectionPageMetrics_[static_cast<size_t>(spineIndex)];
+  const auto cacheUpdate = page_metrics::applyCache(metric, pageCount, partial);
+  if (!cacheUpdate.changed) return;
   if (cacheUpdate.becameExact) {
     page_metrics::recalibrate(globalSectionPageMetrics_);
-    // Persist updated metrics to skip directory scan on next book open
-    std::string sectionsDir;
-    if (type == ContentType::Epub) {
-      sectionsDir = std::string(core.content.cacheDir()) + "/sections";
-    } else {
-      sectionsDir = core.content.asFb2()->getFb2()->getCachePath();
-    }
-    const Theme& theme = THEME_MANAGER.current();
-    const auto vp = getReaderViewport(core.settings.statusBar != 0);
-    saveMetricsIndex(sectionsDir, makeRenderConfig(core, theme, vp));
   }
+  metrics_index::save(sectionsDir, config, globalSectionPageMetrics_);
 }
 
 ReaderState::GlobalPageMetrics ReaderState::resolveGlobalPageMetrics(Core& core) {
@@ -523,7 +446,7 @@ int ReaderState::calcFirstContentSpine(bool hasCover, int textStartIndex, size_t
 // Called from main thread when background task is NOT running (ownership model)
 // No mutex needed - main thread owns pageCache_/parser_ when task is stopped
 void ReaderState::createOrExtendCacheImpl(ContentParser& parser, const std::string& cachePath,
-                                          const RenderConfig& config) {
+                                          const RenderConfig& config, const int metricsSpine, const int targetPage) {
   bool needsCreate = false;
   bool needsExtend = false;
 
@@ -546,6 +469,25 @@ void ReaderState::createOrExtendCacheImpl(ContentParser& parser, const std::stri
     }
   }
 
+  // A page before a window, or one past the cached pages with a checkpoint well
+  // ahead of them, is laid out from its checkpoint instead of from the cache end
+  if (pageCache_ && targetPage >= 0) {
+    const uint32_t target = static_cast<uint32_t>(targetPage);
+    const uint32_t firstPage = needsCreate ? 0 : pageCache_->firstPage();
+    const uint32_t cachedPages = needsCreate ? 0 : pageCache_->pageCount();
+    if ((target < firstPage || target >= cachedPages) &&
+        page_cache::opensWindow(firstPage, cachedPages, target, parser.checkpointBefore(target))) {
+      if (!pageCache_->createWindow(parser, config, target)) {
+        LOG_ERR(TAG, "Cache window failed");
+        pageCache_.reset();
+        return;
+      }
+      saveAnchorMap(parser, cachePath);
+      recordSectionCache(metricsSpine, cachePath, config, pageCache_->pageCount(), pageCache_->isPartial());
+      return;
+    }
+  }
+
   if (pageCache_) {
     if (needsExtend) {
       if (!pageCache_->extend(parser, PageCache::DEFAULT_CACHE_CHUNK)) {
@@ -567,6 +509,9 @@ void ReaderState::createOrExtendCacheImpl(ContentParser& parser, const std::stri
       }
       saveAnchorMap(parser, cachePath);
     }
+    if (needsExtend || needsCreate) {
+      recordSectionCache(metricsSpine, cachePath, config, pageCache_->pageCount(), pageCache_->isPartial());
+    }
   }
 }
 
@@ -574,7 +519,7 @@ void ReaderState::createOrExtendCacheImpl(ContentParser& parser, const std::stri
 // Called from background task - uses BackgroundTask's shouldStop()
 // Ownership: background task owns pageCache_/parser_ while running
 void ReaderState::backgroundCacheImpl(ContentParser& parser, const std::string& cachePath, const RenderConfig& config,
-                                      uint32_t currentPage) {
+                                      uint32_t currentPage, const int metricsSpine) {
   // Check for early abort before doing anything
   if (cacheTask_.shouldStop()) {
     LOG_DBG(TAG, "Background cache aborted before start");
@@ -589,8 +534,10 @@ void ReaderState::backgroundCacheImpl(ContentParser& parser, const std::string&
     loaded = false;
   }
   const bool cachePartial = loaded && pageCache_->isPartial();
-  const bool parserCanResume = parser.canResume();
   const uint32_t cachedPages = loaded ? pageCache_->pageCount() : 0;
+  // Behind a window, the missing pages come before any read-ahead the reader does not need yet
+  const bool windowed = loaded && pageCache_->firstPage() > 0;
+  const bool parserCanResume = cachePartial && !windowed && parserResumesCheaply(parser, cachedPages);
   const bool needsExtend =
       page_cache::backgroundShouldExtend(loaded, cachePartial, parserCanResume, cachedPages, currentPage);
 
@@ -601,15 +548,15 @@ void ReaderState::backgroundCacheImpl(ContentParser& parser, const std::string&
     return;
   }
 
-  if (!loaded || needsExtend) {
-    // Heap-aware abort callback: stop if user cancels OR heap drops so low
-    // that even a minimal Page allocation would fail.
-    auto shouldAbort = [this]() {
-      if (cacheTask_.shouldStop()) return true;
-      if (heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < 4 * 1024) return true;
-      return false;
-    };
+  // Heap-aware abort callback: stop if user cancels OR heap drops so low
+  // that even a minimal Page allocation would fail.
+  auto shouldAbort = [this]() {
+    if (cacheTask_.shouldStop()) return true;
+    if (heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < 4 * 1024) return true;
+    return false;
+  };
 
+  if (!loaded || needsExtend) {
     bool success;
     if (needsExtend) {
       // Hot extend's transient working set is small (~5-10 KB).  A gentler
@@ -638,6 +585,7 @@ void ReaderState::backgroundCacheImpl(ContentParser& parser, const std::string&
 
     if (success && !cacheTask_.shouldStop()) {
       saveAnchorMap(parser, cachePath);
+      recordSectionCache(metricsSpine, cachePath, config, pageCache_->pageCount(), pageCache_->isPartial());
     }
 
     if (!success || cacheTask_.shouldStop()) {
@@ -650,6 +598,21 @@ void ReaderState::backgroundCacheImpl(ContentParser& parser, const std::string&
         pageCache_.reset();
       }
     }
+  } else if (windowed) {
+    // Low priority: one chunk of the pages before the window per run, laid out
+    // from a checkpoint like a cold extend
+    size_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    if (freeHeap < kColdMinFreeHeap || largestBlock < kColdMinLargestBlock) {
+      LOG_WRN(TAG, "Skip backfill: heap critical (free=%zu largest=%zu)", freeHeap, largestBlock);
+      return;
+    }
+    if (!pageCache_->backfill(parser, shouldAbort)) {
+      pageCache_.reset(new PageCache(cachePath));
+      if (!pageCache_->load(config)) {
+        pageCache_.reset();
+      }
+    }
   }
 }
 
@@ -678,6 +641,12 @@ void ReaderState::setContentPath(const char* path) {
 }
 
 void ReaderState::enter(Core& core) {
+  TRACE_SCOPE(ReaderOpen);
+  startup_.begin(millis());
+  metricsBuilt_ = false;
+  idleIndexQueue_.clear();
+  idleIndexingStarted_ = false;
+
   // Free memory from other states before loading book
   THEME_MANAGER.clearCache();
   renderer_.clearWidthCache();
@@ -755,17 +724,6 @@ void ReaderState::enter(Core& core) {
 
   contentLoaded_ = true;
 
-  // Save last book path to settings
-  strncpy(core.settings.lastBookPath, contentPath_, sizeof(core.settings.lastBookPath) - 1);
-  core.settings.lastBookPath[sizeof(core.settings.lastBookPath) - 1] = '\0';
-  core.settings.save(core.storage);
-
-  // Record in recent books list (snapshot title/author from opened provider)
-  {
-    const auto& meta = core.content.metadata();
-    RecentBooksStore::instance().add(contentPath_, meta.title, meta.author);
-  }
-
   // Setup cache directories for all content types
   // Reset state for new book
   textStartIndex_ = 0;
@@ -816,28 +774,6 @@ void ReaderState::enter(Core& core) {
       break;
   }
 
-  const char* cacheDir = core.content.cacheDir();
-  const bool hasCacheDir = cacheDir && cacheDir[0] != '\0';
-  if (hasCacheDir) {
-    for (const char* name : {"/cover.bmp.part", "/.cover-source.tmp", "/thumb.bmp.tmp", "/thumb.bmp.tmp.part"}) {
-      SdMan.remove((std::string(cacheDir) + name).c_str());
-    }
-  }
-
-  const std::string thumbnailPath = core.content.getThumbnailPath();
-  const bool thumbnailValid = !thumbnailPath.empty() && home_thumbnail::validate(thumbnailPath);
-  const std::string thumbnailMarker = hasCacheDir ? std::string(cacheDir) + "/.thumb.failed" : "";
-  if (thumbnailValid && !thumbnailMarker.empty()) SdMan.remove(thumbnailMarker.c_str());
-  const bool thumbnailFailed = !thumbnailMarker.empty() && SdMan.exists(thumbnailMarker.c_str());
-  thumbnailDone_ = core.settings.showImages == 0 || thumbnailValid || thumbnailFailed;
-
-  const std::string coverPath = core.content.getCoverPath();
-  const bool coverValid = !coverPath.empty() && home_thumbnail::validateCover(coverPath);
-  const std::string coverMarker = hasCacheDir ? std::string(cacheDir) + "/.cover.failed" : "";
-  if (coverValid && !coverMarker.empty()) SdMan.remove(coverMarker.c_str());
-  const bool coverFailed = !coverMarker.empty() && SdMan.exists(coverMarker.c_str());
-  coverDone_ = core.settings.showImages == 0 || coverValid || coverFailed;
-
   // Load saved progress
   ContentType type = core.content.metadata().type;
   auto progress = ProgressManager::load(core, core.content.cacheDir(), type);
@@ -854,7 +790,6 @@ void ReaderState::enter(Core& core) {
     currentSectionPage_ = -1;  // Cover page
   }
 
-  READING_STATS.load();
   readingSession_.begin(contentPath_, millis());
 
   // Initialize last rendered to loaded position (until first render)
@@ -870,9 +805,93 @@ void ReaderState::enter(Core& core) {
     return;
   }
 
-  // Start background caching, cover generation, and thumbnail generation.
-  // This runs once per book open regardless of starting position.
-  startBackgroundCaching(core);
+  // Background caching, cover and thumbnail generation start after the first
+  // page (PageReady), so they do not compete with it for the SD card
+}
+
+// Stage PageShown: log time to first page and queue the next stage behind any
+// input that arrived during startup
+void ReaderState::markFirstPageShown(Core& core) {
+  const uint32_t now = millis();
+  if (!startup_.advance(ReaderStartupStage::PageShown, now)) return;
+  TRACE_INSTANT(FirstPage);
+  LOG_INF(TAG, "First page in %u ms (%u ms after boot)",
+          static_cast<unsigned>(startup_.elapsedMs(ReaderStartupStage::PageShown)), static_cast<unsigned>(now));
+  if (!core.events.push(Event::system(EventType::PageReady))) {
+    runStartupBookkeeping(core);
+    startBackgroundCaching(core);
+  }
+}
+
+bool ReaderState::handleStartupEvent(Core& core, const Event& e) {
+  switch (e.type) {
+    case EventType::PageReady:
+      runStartupBookkeeping(core);
+      if (!startupMetricsPending(core) && !core.events.push(Event::system(EventType::ContentLoaded))) {
+        startup_.advance(ReaderStartupStage::Ready, millis());
+      }
+      startBackgroundCaching(core);
+      return true;
+    case EventType::ContentLoaded:
+      if (startup_.advance(ReaderStartupStage::Ready, millis())) {
+        LOG_INF(TAG, "Startup complete in %u ms",
+                static_cast<unsigned>(startup_.elapsedMs(ReaderStartupStage::Ready)));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Stage Bookkeeping: work the first page does not depend on. Also run on exit
+// so a book closed before its first update still lands in the recent list.
+void ReaderState::runStartupBookkeeping(Core& core) {
+  if (!startup_.advance(ReaderStartupStage::Bookkeeping, millis())) return;
+
+  // Save last book path to settings
+  strncpy(core.settings.lastBookPath, contentPath_, sizeof(core.settings.lastBookPath) - 1);
+  core.settings.lastBookPath[sizeof(core.settings.lastBookPath) - 1] = '\0';
+  core.settings.save(core.storage);
+
+  // Record in recent books list (snapshot title/author from opened provider)
+  {
+    const auto& meta = core.content.metadata();
+    RecentBooksStore::instance().add(contentPath_, meta.title, meta.author);
+    if (!LIBRARY.update(contentPath_, meta.title, meta.author)) {
+      LOG_ERR(TAG, "Failed to update library entry");
+    }
+  }
+
+  const char* cacheDir = core.content.cacheDir();
+  const bool hasCacheDir = cacheDir && cacheDir[0] != '\0';
+  if (hasCacheDir) {
+    for (const char* name : {"/cover.bmp.part", "/.cover-source.tmp", "/thumb.bmp.tmp", "/thumb.bmp.tmp.part"}) {
+      SdMan.remove((std::string(cacheDir) + name).c_str());
+    }
+  }
+
+  const std::string thumbnailPath = core.content.getThumbnailPath();
+  const bool thumbnailValid = !thumbnailPath.empty() && home_thumbnail::validate(thumbnailPath);
+  const std::string thumbnailMarker = hasCacheDir ? std::string(cacheDir) + "/.thumb.failed" : "";
+  if (thumbnailValid && !thumbnailMarker.empty()) SdMan.remove(thumbnailMarker.c_str());
+  const bool thumbnailFailed = !thumbnailMarker.empty() && SdMan.exists(thumbnailMarker.c_str());
+  thumbnailDone_ = core.settings.showImages == 0 || thumbnailValid || thumbnailFailed;
+
+  const std::string coverPath = core.content.getCoverPath();
+  const bool coverValid = !coverPath.empty() && home_thumbnail::validateCover(coverPath);
+  const std::string coverMarker = hasCacheDir ? std::string(cacheDir) + "/.cover.failed" : "";
+  if (coverValid && !coverMarker.empty()) SdMan.remove(coverMarker.c_str());
+  const bool coverFailed = !coverMarker.empty() && SdMan.exists(coverMarker.c_str());
+  coverDone_ = core.settings.showImages == 0 || coverValid || coverFailed;
+
+  READING_STATS.load();
+}
+
+// Stage Ready waits for whole-book metrics only where the status bar uses them
+bool ReaderState::startupMetricsPending(Core& core) const {
+  const ContentType type = core.content.metadata().type;
+  return startup_.stage() == ReaderStartupStage::Bookkeeping &&
+         (type == ContentType::Epub || type == ContentType::Fb2) && !globalSectionPageMetricsInitialized_;
 }
 
 void ReaderState::exit(Core& core) {
@@ -887,6 +906,8 @@ void ReaderState::exit(Core& core) {
   invalidateGlobalPageMetrics();
 
   if (contentLoaded_) {
+    runStartupBookkeeping(core);
+
     // Save progress at last rendered position (not current requested position)
     ProgressManager::Progress progress;
     // If on cover, save as (0, 0) - cover is implicit start
@@ -895,11 +916,13 @@ void ReaderState::exit(Core& core) {
     progress.flatPage = currentPage_;
     ProgressManager::save(core, core.content.cacheDir(), core.content.metadata().type, progress);
     saveBookmarks(core);
+    saveResumeSnapshot(core);
 
     // Safe to reset - task is stopped, we own pageCache_/parser_
     parser_.reset();
     parserSpineIndex_ = -1;
     pageCache_.reset();
+    xtcRenderer_.releasePrefetch();
     core.content.close();
   }
 
@@ -934,6 +957,7 @@ void ReaderState::flushReadingSession() {
       !READING_STATS.save()) {
     LOG_ERR(TAG, "Failed to save reading statistics");
   }
+  if (result.hasProgress) LIBRARY.setProgress(result.path, result.progressPercent);
 }
 
 StateTransition ReaderState::update(Core& core) {
@@ -995,8 +1019,16 @@ StateTransition ReaderState::update(Core& core) {
     return StateTransition::stay(StateId::Reader);
   }
 
+  // The event queue belongs to the main loop, so the cache task only sets a flag
+  if (metricsBuilt_ && core.events.push(Event::system(EventType::ContentLoaded))) {
+    metricsBuilt_ = false;
+  }
+
   Event e;
   while (core.events.pop(e)) {
+    if (handleStartupEvent(core, e)) {
+      continue;
+    }
     if (bookStatsMode_) {
       handleBookStatsInput(core, e);
       continue;
@@ -1054,6 +1086,15 @@ StateTransition ReaderState::update(Core& core) {
     }
   }
 
+  // Idle indexing: once the reader has been idle for a while, the cache task
+  // paginates the rest of the book until the next button press stops it
+  if (core.input.idleTimeMs() < LoopScheduler::IDLE_AFTER_MS) {
+    idleIndexingStarted_ = false;
+  } else if (!idleIndexingStarted_ && !cacheTask_.isRunning() && idleIndexingPending(core)) {
+    idleIndexingStarted_ = true;
+    startBackgroundCaching(core, true);
+  }
+
   return StateTransition::stay(StateId::Reader);
 }
 
@@ -1084,6 +1125,7 @@ void ReaderState::render(Core& core) {
     renderCurrentPage(core);
     lastRenderedSpineIndex_ = currentSpineIndex_;
     lastRenderedSectionPage_ = currentSectionPage_;
+    markFirstPageShown(core);
   }
 
   needsRender_ = false;
@@ -1359,6 +1401,7 @@ void ReaderState::renderCurrentPage(Core& core) {
   // Rendering and cache building share the framebuffer. Stop the background
   // owner before the first clear or draw.
   if (!stopBackgroundCaching()) return;
+  TRACE_SCOPE(PageRender);
 
   // Always clear screen first (prevents previous content from showing through)
   renderer_.clearScreen(theme.backgroundColor);
@@ -1416,19 +1459,81 @@ void ReaderState::renderCurrentPage(Core& core) {
 
   const bool cacheLoaded = pageCache_ != nullptr;
   const bool cachePartial = cacheLoaded && pageCache_->isPartial();
-  const bool parserCanResume = parser_ && parser_->canResume();
   const uint32_t cachedPages = cacheLoaded ? pageCache_->pageCount() : 0;
   const uint32_t currentCachePage = currentSectionPage_ > 0 ? static_cast<uint32_t>(currentSectionPage_) : 0;
   const bool cacheRequired = type != ContentType::Xtc;
-  if (!cacheTask_.isRunning() &&
-      page_cache::backgroundWorkPending(cacheLoaded, cachePartial, thumbnailDone_, coverDone_, parserCanResume,
-                                        cachedPages, currentCachePage, cacheRequired)) {
-    startBackgroundCaching(core);
+  // Pages before a window still need laying out (see backgroundCacheImpl)
+  const bool cacheWindowed = cacheLoaded && pageCache_->firstPage() > 0;
+  if (!cacheTask_.isRunning() && startup_.reached(ReaderStartupStage::Bookkeeping)) {
+    // Checkpoint lookup reads the SD card, so only probe while the task is idle
+    const bool parserCanResume =
+        cachePartial && !cacheWindowed && parser_ && parserResumesCheaply(*parser_, cachedPages);
+    if (startupMetricsPending(core) || xtcPrefetchPending(core) || cacheWindowed ||
+        page_cache::backgroundWorkPending(cacheLoaded, cachePartial, thumbnailDone_, coverDone_, parserCanResume,
+                                          cachedPages, currentCachePage, cacheRequired)) {
+      // Parsers use the frame buffer as scratch; with a single buffer the
+      // driver still reads it once the refresh ends
+      if (!EInkDisplay::frameBufferFreeWhileRefreshing()) renderer_.finishRefresh();
+      TRACE_INSTANT(CacheTaskStart);
+      startBackgroundCaching(core);
+    }
   }
+  TRACE_BEGIN(RefreshWait);
+  renderer_.finishRefresh();
+  TRACE_END(RefreshWait);
 
   core.display.markDirty();
 }
 
+// Kept at sleep and exit, not on every page turn. Parsers, overlays and the exit
+// message reuse the frame buffer, so the page is drawn again from its cache
+// first. Caller must have stopped the background task (we own pageCache_).
+void ReaderState::saveResumeSnapshot(Core& core) {
+  TRACE_SCOPE(ResumeSave);
+  if (!drawPageForSnapshot(core)) {
+    // An older snapshot would show a page the reader has since left
+    resume_snapshot::discard();
+    return;
+  }
+  // XTC pages carry no text to lay out, so no font is part of their key
+  resume_snapshot::FontSource font;
+  uint32_t fontFingerprint = 0;
+  if (core.content.metadata().type != ContentType::Xtc) {
+    const Theme& theme = THEME_MANAGER.current();
+    const char* family = core.settings.readerFontFamily(theme);
+    font.family = family ? family : "";
+    font.builtinFontId = core.settings.readerBuiltinFontId(theme);
+    fontFingerprint = FONT_MANAGER.activeReaderFontFingerprint();
+  }
+  resume_snapshot::save(core.display.getBuffer(), core.display.width(), core.display.height(), contentPath_, font,
+                        resume_snapshot::layoutKey(core.settings, fontFingerprint));
+}
+
+bool ReaderState::drawPageForSnapshot(Core& core) {
+  if (core.content.metadata().type == ContentType::Xtc) {
+    auto* provider = core.content.asXtc();
+    return provider && xtcRenderer_.draw(provider->getParser(), currentPage_) == XtcPageRenderer::RenderResult::Success;
+  }
+
+  // The cover is drawn from its BMP with its own refresh and is not kept. A
+  // pending navigation means the panel no longer matches the cache position.
+  if (!pageCache_ || lastRenderedSectionPage_ < 0 || lastRenderedSpineIndex_ != currentSpineIndex_ ||
+      lastRenderedSectionPage_ != currentSectionPage_ ||
+      !pageCache_->hasPage(static_cast<uint32_t>(lastRenderedSectionPage_))) {
+    return false;
+  }
+  auto page = pageCache_->loadPage(static_cast<uint32_t>(lastRenderedSectionPage_));
+  if (!page) return false;
+
+  const Theme& theme = THEME_MANAGER.current();
+  const auto vp = getReaderViewport(core.settings.statusBar != 0);
+  page->warmGlyphs(renderer_, core.settings.getReaderFontId(theme));
+  renderer_.clearScreen(theme.backgroundColor);
+  renderPageContents(core, *page, vp.marginTop, vp.marginRight, vp.marginBottom, vp.marginLeft);
+  renderStatusBar(core, vp.marginRight, vp.marginBottom, vp.marginLeft);
+  return true;
+}
+
 void ReaderState::renderCachedPage(Core& core) {
   Theme& theme = THEME_MANAGER.mutableCurrent();
   ContentType type = core.content.metadata().type;
@@ -1468,7 +1573,7 @@ void ReaderState::renderCachedPage(Core& core) {
     loadCacheFromDisk(core);
 
     bool pageIsCached =
-        pageCache_ && currentSectionPage_ >= 0 && currentSectionPage_ < static_cast<int>(pageCache_->pageCount());
+        pageCache_ && currentSectionPage_ >= 0 && pageCache_->hasPage(static_cast<uint32_t>(currentSectionPage_));
 
     if (!pageIsCached) {
       // Current page not cached - show "Indexing..." and create/extend
@@ -1496,8 +1601,8 @@ void ReaderState::renderCachedPage(Core& core) {
     // Clamp page number (handle negative values and out-of-bounds)
     if (pageCache_) {
       const int cachedPages = static_cast<int>(pageCache_->pageCount());
-      if (currentSectionPage_ < 0) {
-        currentSectionPage_ = 0;
+      if (currentSectionPage_ < static_cast<int>(pageCache_->firstPage())) {
+        currentSectionPage_ = static_cast<int>(pageCache_->firstPage());
       } else if (currentSectionPage_ >= cachedPages) {
         currentSectionPage_ = cachedPages > 0 ? cachedPages - 1 : 0;
       }
@@ -1560,7 +1665,9 @@ void ReaderState::renderCachedPage(Core& core) {
 
   // Load and render page (cache is now guaranteed to exist, we own it)
   uint32_t pageCount = pageCache_ ? pageCache_->pageCount() : 0;
+  TRACE_BEGIN(PageLoad);
   auto page = pageCache_ ? pageCache_->loadPage(static_cast<uint32_t>(currentSectionPage_)) : nullptr;
+  TRACE_END(PageLoad);
 
   if (!page) {
     LOG_ERR(TAG, "Failed to load page, clearing cache");
@@ -1604,10 +1711,17 @@ void ReaderState::renderCachedPage(Core& core) {
     // Double FAST_REFRESH handles ghosting; don't count toward full refresh cadence
   } else {
     displayWithRefresh(core);
+    TRACE_INSTANT(RefreshBegin);
+    // The waveform runs for hundreds of ms; read the likely next page meanwhile
+    if (pageCache_) {
+      TRACE_SCOPE(Prefetch);
+      pageCache_->prefetchPage(static_cast<uint32_t>(currentSectionPage_) + 1);
+    }
   }
 
   // Grayscale text rendering (anti-aliasing)
   if (aaEnabled) {
+    renderer_.finishRefresh();
     renderer_.clearScreen(0x00);
     renderer_.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     page->render(renderer_, fontId, vp.marginLeft, vp.marginTop, theme.primaryTextBlack);
@@ -1645,16 +1759,16 @@ bool ReaderState::ensurePageCached(Core& core, uint32_t pageNum) {
   bool needsExtension = pageCache_->needsExtension(pageNum);
   bool isPartial = pageCache_->isPartial();
 
-  if (pageNum < pageCount) {
+  if (pageCache_->hasPage(pageNum)) {
     if (needsExtension) {
       LOG_DBG(TAG, "Pre-extending cache at page %u", pageNum);
       createOrExtendCache(core);
     }
-    return pageCache_ && pageNum < pageCache_->pageCount();
+    return pageCache_ && pageCache_->hasPage(pageNum);
   }
 
-  // Page not cached yet - need to extend
-  if (!isPartial) {
+  // Page not cached yet - need to extend, or to open a window before the cached ones
+  if (!isPartial && pageNum >= pageCount) {
     LOG_DBG(TAG, "Page %u not available (cache complete at %u pages)", pageNum, pageCount);
     return false;
   }
@@ -1666,8 +1780,7 @@ bool ReaderState::ensurePageCached(Core& core, uint32_t pageNum) {
 
   createOrExtendCache(core);
 
-  pageCount = pageCache_ ? pageCache_->pageCount() : 0;
-  return pageNum < pageCount;
+  return pageCache_ && pageCache_->hasPage(pageNum);
 }
 
 void ReaderState::loadCacheFromDisk(Core& core) {
@@ -1705,6 +1818,19 @@ void ReaderState::loadCacheFromDisk(Core& core) {
     if (!pageCache_->load(config)) {
       pageCache_.reset();
     }
+    // Entries of another layout are dropped along with its pages
+    if (type == ContentType::Markdown || type == ContentType::Txt) {
+      loadTextToc(core, config);
+    }
+  }
+}
+
+void ReaderState::loadTextToc(Core& core, const RenderConfig& config) {
+  const std::string path = tocPath(contentCachePath(core.content.cacheDir(), config.fontId));
+  if (auto* provider = core.content.asTxt()) {
+    provider->loadToc(path, config);
+  } else if (auto* provider = core.content.asMarkdown()) {
+    provider->loadToc(path, config);
   }
 }
 
@@ -1731,7 +1857,9 @@ void ReaderState::createOrExtendCache(Core& core) {
   } else if (type == ContentType::Markdown) {
     cachePath = contentCachePath(core.content.cacheDir(), config.fontId);
     if (!parser_) {
-      parser_.reset(new MarkdownParser(contentPath_, renderer_, config));
+      auto* p = new MarkdownParser(contentPath_, renderer_, config);
+      p->setTocPath(tocPath(cachePath));
+      parser_.reset(p);
       parserSpineIndex_ = 0;
     }
   } else if (type == ContentType::Fb2) {
@@ -1740,8 +1868,11 @@ void ReaderState::createOrExtendCache(Core& core) {
     cachePath = fb2Provider->getSectionCachePath(currentSpineIndex_);
 
     if (!parser_ || parserSpineIndex_ != currentSpineIndex_) {
-      std::string lang = fb2Provider->getFb2()->getLanguage();
-      parser_.reset(new Fb2Parser(fb2Provider->getSectionPath(currentSpineIndex_), renderer_, config, lang));
+      const Fb2* fb2 = fb2Provider->getFb2();
+      std::string imageCachePath = core.settings.showImages ? (fb2->getCachePath() + "/images") : "";
+      auto* p = new Fb2Parser(fb2->getPath(), renderer_, config, fb2->getLanguage());
+      fb2->prepareSectionParser(*p, currentSpineIndex_, imageCachePath);
+      parser_.reset(p);
       parserSpineIndex_ = currentSpineIndex_;
     }
   } else if (type == ContentType::Html) {
@@ -1753,12 +1884,16 @@ void ReaderState::createOrExtendCache(Core& core) {
   } else {
     cachePath = contentCachePath(core.content.cacheDir(), config.fontId);
     if (!parser_) {
-      parser_.reset(new PlainTextParser(contentPath_, renderer_, config));
+      auto* p = new PlainTextParser(contentPath_, renderer_, config);
+      p->setCheckpointPath(checkpointPath(cachePath));
+      p->setTocPath(tocPath(cachePath));
+      parser_.reset(p);
       parserSpineIndex_ = 0;
     }
   }
 
-  createOrExtendCacheImpl(*parser_, cachePath, config);
+  const bool sectioned = type == ContentType::Epub || type == ContentType::Fb2;
+  createOrExtendCacheImpl(*parser_, cachePath, config, sectioned ? currentSpineIndex_ : -1, currentSectionPage_);
 }
 
 void ReaderState::renderPageContents(Core& core, Page& page, int marginTop, int marginRight, int marginBottom,
@@ -1840,6 +1975,7 @@ void ReaderState::renderXtcPage(Core& core) {
           displayGrayscaleBase(core);
         } else {
           displayWithRefresh(core);
+          renderer_.finishRefresh();
         }
       });
 
@@ -1866,20 +2002,31 @@ void ReaderState::renderXtcPage(Core& core) {
   }
 }
 
+// The next 1-bit page is not in the prefetch buffer yet; the cache task reads it
+bool ReaderState::xtcPrefetchPending(Core& core) {
+  auto* provider = core.content.asXtc();
+  if (!provider) return false;
+  const xtc::XtcParser& parser = provider->getParser();
+  const uint32_t nextPage = currentPage_ + 1;
+  return parser.getBitDepth() == 1 && nextPage < parser.getPageCount() &&
+         !xtcRenderer_.hasPrefetchedPage(parser, nextPage);
+}
+
 void ReaderState::displayGrayscaleBase(const Core& core) {
   renderer_.displayBuffer(EInkDisplay::HALF_REFRESH, core.settings.sunlightFadingFix != 0);
 }
 
+// Only starts the refresh; renderCurrentPage() waits for it before returning
 void ReaderState::displayWithRefresh(Core& core) {
   const bool turnOffScreen = core.settings.sunlightFadingFix != 0;
   const int pagesPerRefreshValue = core.settings.getPagesPerRefreshValue();
   if (pagesPerRefreshValue == 0) {
-    renderer_.displayBuffer(EInkDisplay::FAST_REFRESH, turnOffScreen);
+    renderer_.beginDisplayBuffer(EInkDisplay::FAST_REFRESH, turnOffScreen);
   } else if (pagesUntilFullRefresh_ <= 1) {
-    renderer_.displayBuffer(EInkDisplay::HALF_REFRESH, turnOffScreen);
+    renderer_.beginDisplayBuffer(EInkDisplay::HALF_REFRESH, turnOffScreen);
     pagesUntilFullRefresh_ = pagesPerRefreshValue;
   } else {
-    renderer_.displayBuffer(EInkDisplay::FAST_REFRESH, turnOffScreen);
+    renderer_.beginDisplayBuffer(EInkDisplay::FAST_REFRESH, turnOffScreen);
     pagesUntilFullRefresh_--;
   }
 }
@@ -1900,9 +2047,15 @@ ReaderState::Viewport ReaderState::getReaderViewport(bool showStatusBar) const {
 RenderConfig ReaderState::makeRenderConfig(Core& core, const Theme& theme, const Viewport& viewport) const {
   RenderConfig config = core.settings.getRenderConfig(theme, viewport.width, viewport.height);
   config.sourceFingerprint = sourceFingerprint_;
+  config.grayscaleImages = config.showImages && wantsGrayscaleImages(core, config);
   return config;
 }
 
+// Same condition as the grayscale pass in renderPage(): without it, images only need the 1-bit mask
+bool ReaderState::wantsGrayscaleImages(Core& core, const RenderConfig& config) const {
+  return core.settings.textAntiAliasing && renderer_.fontSupportsGrayscale(config.fontId);
+}
+
 bool ReaderState::renderCoverPage(Core& core) {
   LOG_DBG(TAG, "Generating cover for reader...");
   std::string coverPath = core.content.generateCover(true);  // Always 1-bit in reader (saves ~48KB grayscale buffer)
@@ -1924,8 +2077,12 @@ bool ReaderState::renderCoverPage(Core& core) {
   return rendered;
 }
 
-void ReaderState::startBackgroundCaching(Core& core) {
-  if (core.content.metadata().type == ContentType::Xtc && thumbnailDone_ && coverDone_) return;
+void ReaderState::startBackgroundCaching(Core& core, const bool idleIndexing) {
+  // Cover and thumbnail state is only known after the Bookkeeping stage
+  if (!startup_.reached(ReaderStartupStage::Bookkeeping)) return;
+  if (core.content.metadata().type == ContentType::Xtc && thumbnailDone_ && coverDone_ && !xtcPrefetchPending(core)) {
+    return;
+  }
 
   // BackgroundTask rejects an unpublished prior generation without blocking.
   if (cacheTask_.isRunning()) {
@@ -1941,10 +2098,12 @@ void ReaderState::startBackgroundCaching(Core& core) {
   const int spineIndex = currentSpineIndex_;
   const bool coverExists = hasCover_;
   const int textStart = textStartIndex_;
+  const bool buildMetrics = startupMetricsPending(core);
+  const uint32_t xtcPage = currentPage_;
 
   const bool started = cacheTask_.start(
       "PageCache", kCacheTaskStackSize,
-      [this, sectionPage, spineIndex, coverExists, textStart]() {
+      [this, sectionPage, spineIndex, coverExists, textStart, buildMetrics, idleIndexing, xtcPage]() {
         const Theme& theme = THEME_MANAGER.current();
         LOG_INF(TAG, "Background cache task started");
 
@@ -1965,6 +2124,7 @@ void ReaderState::startBackgroundCaching(Core& core) {
 
         // Build a missing cache or extend the loaded partial cache.
         // XTC pages are pre-rendered and only need the cover stage below.
+        int metricsSpine = -1;
         if (!cacheTask_.shouldStop() && type != ContentType::Xtc) {
           const auto vp = getReaderViewport(coreRef.settings.statusBar != 0);
           const auto config = makeRenderConfig(coreRef, theme, vp);
@@ -1981,6 +2141,7 @@ void ReaderState::startBackgroundCaching(Core& core) {
                 spineToCache = calcFirstContentSpine(coverExists, textStart, epub->getSpineItemsCount());
               }
               cachePath = epubSectionCachePath(epub->getCachePath(), spineToCache);
+              metricsSpine = spineToCache;
 
               if (!parser_ || parserSpineIndex_ != spineToCache) {
                 parser_.reset(
@@ -1991,7 +2152,9 @@ void ReaderState::startBackgroundCaching(Core& core) {
           } else if (type == ContentType::Markdown && !cacheTask_.shouldStop()) {
             cachePath = contentCachePath(coreRef.content.cacheDir(), config.fontId);
             if (!parser_) {
-              parser_.reset(new MarkdownParser(contentPath_, renderer_, config));
+              auto* p = new MarkdownParser(contentPath_, renderer_, config);
+              p->setTocPath(tocPath(cachePath));
+              parser_.reset(p);
               parserSpineIndex_ = 0;
             }
           } else if (type == ContentType::Fb2 && !cacheTask_.shouldStop()) {
@@ -2000,9 +2163,14 @@ void ReaderState::startBackgroundCaching(Core& core) {
               int spineToCache = spineIndex;
               if (sectionPage == -1) spineToCache = 0;
               cachePath = fb2Provider->getSectionCachePath(spineToCache);
+              metricsSpine = spineToCache;
               if (!parser_ || parserSpineIndex_ != spineToCache) {
-                std::string lang = fb2Provider->getFb2()->getLanguage();
-                parser_.reset(new Fb2Parser(fb2Provider->getSectionPath(spineToCache), renderer_, config, lang));
+                const Fb2* fb2 = fb2Provider->getFb2();
+                std::string imageCachePath =
+                    coreRef.settings.showImages ? (fb2->getCachePath() + "/images") : "";
+                auto* p = new Fb2Parser(fb2->getPath(), renderer_, config, fb2->getLanguage());
+                fb2->prepareSectionParser(*p, spineToCache, imageCachePath);
+                parser_.reset(p);
                 parserSpineIndex_ = spineToCache;
               }
             }
@@ -2015,18 +2183,39 @@ void ReaderState::startBackgroundCaching(Core& core) {
           } else if (type == ContentType::Txt && !cacheTask_.shouldStop()) {
             cachePath = contentCachePath(coreRef.content.cacheDir(), config.fontId);
             if (!parser_) {
-              parser_.reset(new PlainTextParser(contentPath_, renderer_, config));
+              auto* p = new PlainTextParser(contentPath_, renderer_, config);
+              p->setCheckpointPath(checkpointPath(cachePath));
+              p->setTocPath(tocPath(cachePath));
+              parser_.reset(p);
               parserSpineIndex_ = 0;
             }
           }
 
           if (parser_ && !cachePath.empty() && !cacheTask_.shouldStop()) {
             const uint32_t cachePage = sectionPage > 0 ? static_cast<uint32_t>(sectionPage) : 0;
-            backgroundCacheImpl(*parser_, cachePath, config, cachePage);
+            TRACE_SCOPE(CacheBuild);
+            backgroundCacheImpl(*parser_, cachePath, config, cachePage, metricsSpine);
           }
         }
 
         const auto shouldAbort = cacheTask_.getAbortCallback();
+
+        // The next XTC page first: the user is about to turn to it
+        if (type == ContentType::Xtc && !shouldAbort()) {
+          if (auto* provider = coreRef.content.asXtc()) {
+            TRACE_SCOPE(Prefetch);
+            xtcRenderer_.prefetchPage(provider->getParser(), xtcPage + 1, shouldAbort);
+          }
+        }
+
+        // Startup stage Ready: whole-book page counts, after the pages around the reader
+        if (buildMetrics && !shouldAbort()) {
+          TRACE_SCOPE(GlobalMetrics);
+          initializeGlobalPageMetrics(coreRef, true, shouldAbort);
+          if (shouldAbort()) return;
+          metricsBuilt_ = true;
+        }
+
         if (!coverDone_ && !shouldAbort()) {
           coreRef.content.generateCover(true, shouldAbort);
           if (shouldAbort()) return;
@@ -2034,11 +2223,17 @@ void ReaderState::startBackgroundCaching(Core& core) {
         }
 
         if (!thumbnailDone_ && !shouldAbort()) {
+          TRACE_SCOPE(Thumbnail);
           const auto result = coreRef.content.generateThumbnail(shouldAbort);
           if (result == home_thumbnail::Result::Cancelled) return;
           thumbnailDone_ = true;
         }
 
+        if (idleIndexing && !shouldAbort()) {
+          TRACE_SCOPE(IdleIndex);
+          indexIdleSections(coreRef, metricsSpine >= 0 ? metricsSpine : spineIndex, shouldAbort);
+        }
+
         if (!cacheTask_.shouldStop()) {
           LOG_INF(TAG, "Background cache task completed");
         } else {
@@ -2084,9 +2279,10 @@ bool ReaderState::isFullyIndexed(Core& core) {
     const int spineCount = provider->getEpub()->getSpineItemsCount();
 
     const std::string sectionsDir = provider->getEpub()->getCachePath() + "/sections";
-    std::vector<MetricsEntry> entries;
-    if (readMetricsIndexFile(sectionsDir, config, spineCount, entries)) {
-      return std::all_of(entries.begin(), entries.end(), [](const MetricsEntry& e) { return e.exact; });
+    metrics_index::Index index;
+    if (metrics_index::load(sectionsDir, config, static_cast<size_t>(spineCount), index)) {
+      return std::all_of(index.sections.begin(), index.sections.end(),
+                         [](const page_metrics::Section& section) { return section.exact; });
     }
 
     for (int i = 0; i < spineCount; ++i) {
@@ -2103,9 +2299,10 @@ bool ReaderState::isFullyIndexed(Core& core) {
     const int sectionCount = fb2Provider->getSectionCount();
 
     const std::string sectionsDir = fb2Provider->getFb2()->getCachePath();
-    std::vector<MetricsEntry> entries;
-    if (readMetricsIndexFile(sectionsDir, config, sectionCount, entries)) {
-      return std::all_of(entries.begin(), entries.end(), [](const MetricsEntry& e) { return e.exact; });
+    metrics_index::Index index;
+    if (metrics_index::load(sectionsDir, config, static_cast<size_t>(sectionCount), index)) {
+      return std::all_of(index.sections.begin(), index.sections.end(),
+                         [](const page_metrics::Section& section) { return section.exact; });
     }
 
     for (int i = 0; i < sectionCount; ++i) {
@@ -2140,9 +2337,9 @@ void ReaderState::startFullBookIndexing(Core& core) {
     bool skippedViaIndex = false;
     if (provider && provider->getEpub() && indexingTotalSpines_ > 0) {
       const std::string sectionsDir = provider->getEpub()->getCachePath() + "/sections";
-      std::vector<MetricsEntry> entries;
-      if (readMetricsIndexFile(sectionsDir, config, indexingTotalSpines_, entries)) {
-        while (indexingSpine_ < indexingTotalSpines_ && entries[static_cast<size_t>(indexingSpine_)].exact) {
+      metrics_index::Index index;
+      if (metrics_index::load(sectionsDir, config, static_cast<size_t>(indexingTotalSpines_), index)) {
+        while (indexingSpine_ < indexingTotalSpines_ && index.sections[static_cast<size_t>(indexingSpine_)].exact) {
           indexingSpine_++;
         }
         skippedViaIndex = true;
@@ -2162,9 +2359,9 @@ void ReaderState::startFullBookIndexing(Core& core) {
     bool skippedViaIndex = false;
     if (fb2Provider && fb2Provider->getFb2() && indexingTotalSpines_ > 0) {
       const std::string sectionsDir = fb2Provider->getFb2()->getCachePath();
-      std::vector<MetricsEntry> entries;
-      if (readMetricsIndexFile(sectionsDir, config, indexingTotalSpines_, entries)) {
-        while (indexingSpine_ < indexingTotalSpines_ && entries[static_cast<size_t>(indexingSpine_)].exact) {
+      metrics_index::Index index;
+      if (metrics_index::load(sectionsDir, config, static_cast<size_t>(indexingTotalSpines_), index)) {
+        while (indexingSpine_ < indexingTotalSpines_ && index.sections[static_cast<size_t>(indexingSpine_)].exact) {
           indexingSpine_++;
         }
         skippedViaIndex = true;
@@ -2232,7 +2429,7 @@ void ReaderState::processIndexingChunk(Core& core) {
     indexingCache_.reset();
     indexingParser_.reset();
     LOG_INF(TAG, "Full book indexing complete");
-    deleteMetricsIndex(core);
+    removeLegacyIndexMarker(core);
     invalidateGlobalPageMetrics();
     startBackgroundCaching(core);
     renderer_.clearScreen(theme.backgroundColor);
@@ -2273,6 +2470,7 @@ void ReaderState::processIndexingChunk(Core& core) {
     if (!indexingCache_->isPartial()) {
       if (type == ContentType::Epub || type == ContentType::Fb2) {
         saveAnchorMap(*indexingParser_, indexingCache_->path());
+        recordSectionCache(indexingSpine_, indexingCache_->path(), config, indexingCache_->pageCount(), false);
       }
       LOG_DBG(TAG, "Indexing: spine %d complete (%d pages)", indexingSpine_, indexingCache_->pageCount());
       indexingCache_.reset();
@@ -2293,18 +2491,11 @@ void ReaderState::processIndexingChunk(Core& core) {
 
   // Skip already-complete spines
   while (indexingSpine_ < indexingTotalSpines_) {
-    std::string probePath;
-    if (type == ContentType::Epub) {
-      auto* provider = core.content.asEpub();
-      if (provider && provider->getEpub())
-        probePath = epubSectionCachePath(provider->getEpub()->getCachePath(), indexingSpine_);
-    } else if (type == ContentType::Fb2) {
-      const auto* fb2 = core.content.asFb2();
-      if (fb2) probePath = fb2->getSectionCachePath(indexingSpine_);
-    }
+    const std::string probePath = sectionCachePath(core, indexingSpine_);
     if (probePath.empty()) break;
     const auto probe = PageCache::probe(probePath, config);
     if (!probe.valid || probe.partial) break;
+    recordSectionCache(indexingSpine_, probePath, config, probe.pageCount, false);
     indexingSpine_++;
   }
 
@@ -2313,7 +2504,7 @@ void ReaderState::processIndexingChunk(Core& core) {
     indexingCache_.reset();
     indexingParser_.reset();
     LOG_INF(TAG, "Full book indexing complete");
-    deleteMetricsIndex(core);
+    removeLegacyIndexMarker(core);
     invalidateGlobalPageMetrics();
     startBackgroundCaching(core);
     needsRender_ = true;
@@ -2332,42 +2523,15 @@ void ReaderState::processIndexingChunk(Core& core) {
 
   std::string cachePath;
 
-  if (type == ContentType::Epub) {
-    auto* provider = core.content.asEpub();
-    if (!provider || !provider->getEpub()) {
-      stopIndexing();
-      needsRender_ = true;
-      return;
-    }
-    const auto* epub = provider->getEpub();
-    cachePath = epubSectionCachePath(epub->getCachePath(), indexingSpine_);
-    std::string imageCachePath = core.settings.showImages ? (epub->getCachePath() + "/images") : "";
-    auto* p = new (std::nothrow)
-        EpubChapterParser(provider->getEpubShared(), indexingSpine_, renderer_, config, imageCachePath);
-    if (!p) {
-      LOG_ERR(TAG, "Indexing: alloc failed for parser at spine %d", indexingSpine_);
-      stopIndexing();
-      needsRender_ = true;
-      return;
-    }
-    indexingParser_.reset(p);
-  } else if (type == ContentType::Fb2) {
-    auto* fb2Provider = core.content.asFb2();
-    if (!fb2Provider || !fb2Provider->getFb2()) {
-      stopIndexing();
-      needsRender_ = true;
-      return;
-    }
-    cachePath = fb2Provider->getSectionCachePath(indexingSpine_);
-    std::string lang = fb2Provider->getFb2()->getLanguage();
-    auto* p = new (std::nothrow) Fb2Parser(fb2Provider->getSectionPath(indexingSpine_), renderer_, config, lang);
-    if (!p) {
-      LOG_ERR(TAG, "Indexing: alloc failed for parser at spine %d", indexingSpine_);
+  if (type == ContentType::Epub || type == ContentType::Fb2) {
+    cachePath = sectionCachePath(core, indexingSpine_);
+    indexingParser_ = makeSectionParser(core, indexingSpine_, config);
+    if (cachePath.empty() || !indexingParser_) {
+      LOG_ERR(TAG, "Indexing: no parser for spine %d", indexingSpine_);
       stopIndexing();
       needsRender_ = true;
       return;
     }
-    indexingParser_.reset(p);
   } else if (type == ContentType::Markdown) {
     cachePath = contentCachePath(core.content.cacheDir(), config.fontId);
     auto* p = new (std::nothrow) MarkdownParser(contentPath_, renderer_, config);
@@ -2377,6 +2541,7 @@ void ReaderState::processIndexingChunk(Core& core) {
       needsRender_ = true;
       return;
     }
+    p->setTocPath(tocPath(cachePath));
     indexingParser_.reset(p);
   } else if (type == ContentType::Html) {
     cachePath = contentCachePath(core.content.cacheDir(), config.fontId);
@@ -2397,6 +2562,8 @@ void ReaderState::processIndexingChunk(Core& core) {
       needsRender_ = true;
       return;
     }
+    p->setCheckpointPath(checkpointPath(cachePath));
+    p->setTocPath(tocPath(cachePath));
     indexingParser_.reset(p);
   }
 
@@ -2409,9 +2576,13 @@ void ReaderState::processIndexingChunk(Core& core) {
   }
   indexingCache_.reset(c);
 
-  const bool cacheLoaded = indexingCache_->load(config);
+  // A window lacks the pages before it, so full indexing lays the book out from the start
+  const bool cacheLoaded = indexingCache_->load(config) && indexingCache_->firstPage() == 0;
   const auto cacheAction = page_cache::fullIndexCacheAction(cacheLoaded, cacheLoaded && indexingCache_->isPartial());
   if (cacheAction == page_cache::FullIndexCacheAction::Skip) {
+    if (type == ContentType::Epub || type == ContentType::Fb2) {
+      recordSectionCache(indexingSpine_, cachePath, config, indexingCache_->pageCount(), false);
+    }
     indexingCache_.reset();
     indexingParser_.reset();
     indexingSpine_++;
@@ -2419,7 +2590,8 @@ void ReaderState::processIndexingChunk(Core& core) {
     return;
   }
   if (cacheAction == page_cache::FullIndexCacheAction::Extend) {
-    if (!page_cache::proactiveExtensionAllowed(indexingParser_->canResume(), indexingCache_->pageCount())) {
+    if (!page_cache::proactiveExtensionAllowed(parserResumesCheaply(*indexingParser_, indexingCache_->pageCount()),
+                                               indexingCache_->pageCount())) {
       LOG_INF(TAG, "Indexing: deferring cold extend for partial spine %d at %u pages", indexingSpine_,
               indexingCache_->pageCount());
       skipCurrentSpine();
@@ -2432,15 +2604,10 @@ void ReaderState::processIndexingChunk(Core& core) {
 
   if (type == ContentType::Fb2) {
     const auto* fb2Provider = core.content.asFb2();
-    if (fb2Provider) {
-      std::string sectionPath = fb2Provider->getSectionPath(indexingSpine_);
-      FsFile file;
-      if (file.open(sectionPath.c_str(), O_RDONLY)) {
-        size_t fileSize = file.size();
-        file.close();
-        if (page_metrics::estimatePagesForBytes(fileSize) < 30) {
-          maxPages = 0;
-        }
+    if (fb2Provider && fb2Provider->getFb2()) {
+      const uint32_t sectionSize = fb2Provider->getFb2()->getSectionSize(indexingSpine_);
+      if (sectionSize > 0 && page_metrics::estimatePagesForBytes(sectionSize) < 30) {
+        maxPages = 0;
       }
     }
   } else if (type == ContentType::Epub) {
@@ -2473,6 +2640,7 @@ void ReaderState::processIndexingChunk(Core& core) {
   if (!indexingCache_->isPartial()) {
     if (type == ContentType::Epub || type == ContentType::Fb2) {
       saveAnchorMap(*indexingParser_, indexingCache_->path());
+      recordSectionCache(indexingSpine_, indexingCache_->path(), config, indexingCache_->pageCount(), false);
     }
     LOG_DBG(TAG, "Indexing: spine %d complete (%d pages)", indexingSpine_, indexingCache_->pageCount());
     indexingCache_.reset();
@@ -2486,6 +2654,119 @@ void ReaderState::processIndexingChunk(Core& core) {
   }
 }
 
+std::unique_ptr<ContentParser> ReaderState::makeSectionParser(Core& core, const int spineIndex,
+                                                              const RenderConfig& config) {
+  const ContentType type = core.content.metadata().type;
+  ContentParser* parser = nullptr;
+
+  if (type == ContentType::Epub) {
+    auto* provider = core.content.asEpub();
+    if (!provider || !provider->getEpub()) return nullptr;
+    const auto* epub = provider->getEpub();
+    std::string imageCachePath = core.settings.showImages ? (epub->getCachePath() + "/images") : "";
+    parser = new (std::nothrow)
+        EpubChapterParser(provider->getEpubShared(), spineIndex, renderer_, config, imageCachePath);
+  } else if (type == ContentType::Fb2) {
+    auto* fb2Provider = core.content.asFb2();
+    if (!fb2Provider || !fb2Provider->getFb2()) return nullptr;
+    const Fb2* fb2 = fb2Provider->getFb2();
+    std::string imageCachePath = core.settings.showImages ? (fb2->getCachePath() + "/images") : "";
+    auto* p = new (std::nothrow) Fb2Parser(fb2->getPath(), renderer_, config, fb2->getLanguage());
+    if (p) fb2->prepareSectionParser(*p, spineIndex, imageCachePath);
+    parser = p;
+  }
+  return std::unique_ptr<ContentParser>(parser);
+}
+
+// ============================================================================
+// Idle-Time Indexing
+// ============================================================================
+
+bool ReaderState::idleIndexingPending(Core& core) const {
+  const ContentType type = core.content.metadata().type;
+  if (type != ContentType::Epub && type != ContentType::Fb2) return false;
+  // Overlays stop the cache task while they use the SD card and display
+  if (!startup_.reached(ReaderStartupStage::Ready) || needsRender_ || menuMode_ || tocMode_ || bookmarkMode_ ||
+      bookStatsMode_) {
+    return false;
+  }
+  return globalSectionPageMetricsInitialized_ &&
+         idleIndexQueue_.next(globalSectionPageMetrics_, currentSpineIndex_) >= 0;
+}
+
+// Runs on the cache task. Every create/extend commits its pages, so a button
+// press loses at most the chunk in progress; the rest resumes from the partial
+// cache and metrics.bin on the next idle spell, also after sleep or a reboot.
+void ReaderState::indexIdleSections(Core& core, const int readerSpine,
+                                    const BackgroundTask::AbortCallback& shouldAbort) {
+  if (!globalSectionPageMetricsInitialized_) return;
+
+  const Theme& theme = THEME_MANAGER.current();
+  const auto vp = getReaderViewport(core.settings.statusBar != 0);
+  const auto config = makeRenderConfig(core, theme, vp);
+  // Heap-aware, as in backgroundCacheImpl; a section that runs out of RAM is skipped
+  auto sliceAbort = [&shouldAbort]() {
+    return shouldAbort() || heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < 4 * 1024;
+  };
+
+  while (!shouldAbort()) {
+    const int spine = idleIndexQueue_.next(globalSectionPageMetrics_, readerSpine);
+    if (spine < 0) {
+      LOG_INF(TAG, "Idle indexing: book complete");
+      return;
+    }
+
+    // The reader's parser and cache stay loaded, so a second parser needs the cold-start headroom
+    const size_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    const size_t largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    if (freeHeap < kColdMinFreeHeap || largestBlock < kColdMinLargestBlock) {
+      LOG_WRN(TAG, "Idle indexing: heap too low (free=%zu largest=%zu), pausing", freeHeap, largestBlock);
+      return;
+    }
+
+    const std::string cachePath = sectionCachePath(core, spine);
+    auto parser = makeSectionParser(core, spine, config);
+    if (cachePath.empty() || !parser) {
+      idleIndexQueue_.skip(spine);
+      continue;
+    }
+
+    PageCache cache(cachePath);
+    const bool loaded = cache.load(config);
+    bool ok = true;
+    switch (page_cache::fullIndexCacheAction(loaded, loaded && cache.isPartial())) {
+      case page_cache::FullIndexCacheAction::Skip:
+        break;
+      case page_cache::FullIndexCacheAction::Extend:
+        ok = page_cache::proactiveExtensionAllowed(parserResumesCheaply(*parser, cache.pageCount()),
+                                                   cache.pageCount()) &&
+             cache.extend(*parser, kIndexingChunk, sliceAbort);
+        if (ok) saveAnchorMap(*parser, cachePath);
+        break;
+      case page_cache::FullIndexCacheAction::Create:
+        parser->reset();
+        ok = cache.create(*parser, config, kIndexingChunk, 0, sliceAbort);
+        if (ok) saveAnchorMap(*parser, cachePath);
+        break;
+    }
+    while (ok && cache.isPartial() && !shouldAbort()) {
+      ok = cache.extend(*parser, kIndexingChunk, sliceAbort);
+      if (ok) saveAnchorMap(*parser, cachePath);
+    }
+
+    if (ok || cache.pageCount() > 0) {
+      recordSectionCache(spine, cachePath, config, cache.pageCount(), cache.isPartial());
+    }
+    if (shouldAbort()) return;
+    if (!ok) {
+      LOG_WRN(TAG, "Idle indexing: spine %d failed, skipping", spine);
+      idleIndexQueue_.skip(spine);
+    } else {
+      LOG_DBG(TAG, "Idle indexing: spine %d complete (%u pages)", spine, static_cast<unsigned>(cache.pageCount()));
+    }
+  }
+}
+
 void ReaderState::renderIndexingScreen(Core& core) {
   const Theme& theme = THEME_MANAGER.current();
   const int fontId = core.settings.getReaderFontId(theme);
@@ -2846,8 +3127,9 @@ void ReaderState::exitToUI(Core& core) {
 
   // Determine return destination from cached transition or fall back to sourceState_
   const auto& transition = getTransition();
-  const ExitToUiPlan plan = planExitToUi(stopBackgroundCaching(), transition.isValid(), transition.returnTo,
-                                         sourceState_ == StateId::FileList);
+  const bool cacheStopped = stopBackgroundCaching();
+  const ExitToUiPlan plan =
+      planExitToUi(cacheStopped, transition.isValid(), transition.returnTo, sourceState_ == StateId::FileList);
 
   if (plan.mode == ExitToUiMode::Emergency) {
     LOG_ERR(TAG, "Cache task stop timed out; restarting to UI without SD writes");
@@ -2859,14 +3141,17 @@ void ReaderState::exitToUI(Core& core) {
 
   // Save progress at last rendered position
   if (contentLoaded_) {
+    runStartupBookkeeping(core);
     ProgressManager::Progress progress;
     progress.spineIndex = (lastRenderedSectionPage_ == -1) ? 0 : lastRenderedSpineIndex_;
     progress.sectionPage = (lastRenderedSectionPage_ == -1) ? 0 : lastRenderedSectionPage_;
     progress.flatPage = currentPage_;
     ProgressManager::save(core, core.content.cacheDir(), core.content.metadata().type, progress);
     saveBookmarks(core);
-    // Skip pageCache_.reset() and content.close() — ESP.restart() follows,
-    // and if stopBackgroundCaching() timed out the task still uses them.
+    // A timed-out stop took the Emergency path above, so the task is stopped
+    // and pageCache_ and the XTC parser are ours to draw the snapshot from
+    if (cacheStopped) saveResumeSnapshot(core);
+    // Skip pageCache_.reset() and content.close() — ESP.restart() follows
   }
 
   // Show notification and restart
@@ -2924,7 +3209,13 @@ void ReaderState::handleMenuInput(Core& core, const Event& e) {
 void ReaderState::handleMenuAction(Core& core, ui::ReaderMenuView::Item action) {
   exitMenuMode();
   switch (action) {
-    case ui::ReaderMenuView::Item::Chapters:
+    case ui::ReaderMenuView::Item::Chapters: {
+      const ContentType type = core.content.metadata().type;
+      if ((type == ContentType::Txt || type == ContentType::Markdown) && stopBackgroundCaching()) {
+        // Pick up chapters found since the cache was loaded
+        const Theme& theme = THEME_MANAGER.current();
+        loadTextToc(core, makeRenderConfig(core, theme, getReaderViewport(core.settings.statusBar != 0)));
+      }
       if (core.content.tocCount() > 0) {
         enterTocMode(core);
       } else {
@@ -2937,6 +3228,7 @@ void ReaderState::handleMenuAction(Core& core, ui::ReaderMenuView::Item action)
         startBackgroundCaching(core);
       }
       break;
+    }
     case ui::ReaderMenuView::Item::Bookmarks:
       enterBookmarkMode(core);
       break;
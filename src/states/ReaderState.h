@@ -2,16 +2,19 @@
 
 #include <BackgroundTask.h>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "../content/BookmarkManager.h"
 #include "../content/GlobalPageMetrics.h"
+#include "../content/IndexingQueue.h"
 #include "../content/ReaderNavigation.h"
 #include "../content/ReadingSessionTracker.h"
 #include "../content/ReadingStatsStore.h"
 #include "../core/ReaderButtonDispatcher.h"
+#include "../core/ReaderStartup.h"
 #include "../core/Types.h"
 #include "../rendering/XtcPageRenderer.h"
 #include "../ui/views/HomeView.h"
@@ -97,9 +100,19 @@ class ReaderState : public State {
   Core* coreForCacheTask_ = nullptr;
   bool thumbnailDone_ = false;
   bool coverDone_ = false;
-  void startBackgroundCaching(Core& core);
+  // idleIndexing: after the usual work, paginate the rest of the book until stopped
+  void startBackgroundCaching(Core& core, bool idleIndexing = false);
   bool stopBackgroundCaching(bool waitForever = false);
 
+  // Staged startup: enter() loads only what the current page needs; the rest
+  // follows the PageReady and ContentLoaded events (see ReaderStartup.h)
+  ReaderStartup startup_;
+  std::atomic<bool> metricsBuilt_{false};  // Set by the cache task, forwarded as ContentLoaded
+  void markFirstPageShown(Core& core);
+  bool handleStartupEvent(Core& core, const Event& e);
+  void runStartupBookkeeping(Core& core);
+  bool startupMetricsPending(Core& core) const;
+
   // Navigation helpers (delegates to ReaderNavigation)
   void navigateNext(Core& core);
   void navigatePrev(Core& core);
@@ -119,7 +132,10 @@ class ReaderState : public State {
   void renderCurrentPage(Core& core);
   void renderCachedPage(Core& core);
   void renderXtcPage(Core& core);
+  bool xtcPrefetchPending(Core& core);
   bool renderCoverPage(Core& core);
+  void saveResumeSnapshot(Core& core);
+  bool drawPageForSnapshot(Core& core);
 
   // Helpers
   void renderPageContents(Core& core, Page& page, int marginTop, int marginRight, int marginBottom, int marginLeft);
@@ -129,12 +145,15 @@ class ReaderState : public State {
   using GlobalPageMetrics = page_metrics::Display;
   using SectionPageMetric = page_metrics::Section;
   void invalidateGlobalPageMetrics();
-  void initializeGlobalPageMetrics(Core& core);
+  // Without allowScan only metrics.bin is read; an abort leaves metrics uninitialized
+  void initializeGlobalPageMetrics(Core& core, bool allowScan = true,
+                                   const BackgroundTask::AbortCallback& shouldAbort = nullptr);
   void updateGlobalPageMetrics(Core& core);
   GlobalPageMetrics resolveGlobalPageMetrics(Core& core);
-  bool saveMetricsIndex(const std::string& sectionsDir, const RenderConfig& config);
-  bool loadMetricsIndex(const std::string& sectionsDir, const RenderConfig& config, int spineCount);
-  void deleteMetricsIndex(Core& core);
+  // Folds a section cache write into the whole-book counts and metrics.bin
+  void recordSectionCache(int spineIndex, const std::string& cachePath, const RenderConfig& config, uint32_t pageCount,
+                          bool partial);
+  void removeLegacyIndexMarker(Core& core);
 
   std::vector<SectionPageMetric> globalSectionPageMetrics_;
   bool globalSectionPageMetricsInitialized_ = false;
@@ -147,11 +166,16 @@ class ReaderState : public State {
   // Cache management
   bool ensurePageCached(Core& core, uint32_t pageNum);
   void loadCacheFromDisk(Core& core);
+  // TXT/Markdown chapters are written while pages are laid out; reread them
+  void loadTextToc(Core& core, const RenderConfig& config);
   void createOrExtendCache(Core& core);
 
-  void createOrExtendCacheImpl(ContentParser& parser, const std::string& cachePath, const RenderConfig& config);
+  // metricsSpine: section to record in metrics.bin after a cache write, -1 for single-file content
+  // targetPage: page about to be shown, -1 for none; decides whether to open a window at a checkpoint
+  void createOrExtendCacheImpl(ContentParser& parser, const std::string& cachePath, const RenderConfig& config,
+                               int metricsSpine, int targetPage);
   void backgroundCacheImpl(ContentParser& parser, const std::string& cachePath, const RenderConfig& config,
-                           uint32_t currentPage);
+                           uint32_t currentPage, int metricsSpine);
 
   // Display helpers
   void displayWithRefresh(Core& core);
@@ -168,6 +192,7 @@ class ReaderState : public State {
   };
   Viewport getReaderViewport(bool showStatusBar) const;
   RenderConfig makeRenderConfig(Core& core, const Theme& theme, const Viewport& viewport) const;
+  bool wantsGrayscaleImages(Core& core, const RenderConfig& config) const;
 
   // Get first content spine index (skips cover document when appropriate)
   static int calcFirstContentSpine(bool hasCover, int textStartIndex, size_t spineCount);
@@ -250,6 +275,14 @@ class ReaderState : public State {
   void processIndexingChunk(Core& core);
   void renderIndexingScreen(Core& core);
   bool isFullyIndexed(Core& core);
+  std::unique_ptr<ContentParser> makeSectionParser(Core& core, int spineIndex, const RenderConfig& config);
+
+  // Idle-time indexing: the cache task works through the sections metrics.bin
+  // does not mark exact while the reader is idle (see IndexingQueue.h)
+  IndexingQueue idleIndexQueue_;
+  bool idleIndexingStarted_ = false;  // Once per idle spell; cleared by button activity
+  bool idleIndexingPending(Core& core) const;
+  void indexIdleSections(Core& core, int readerSpine, const BackgroundTask::AbortCallback& shouldAbort);
 };
 
 }  // namespace papyrix
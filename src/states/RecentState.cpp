@@ -18,6 +18,18 @@
 
 namespace papyrix {
 
+namespace {
+// Progress from the library database, else from the reading stats
+uint8_t rowProgress(const uint8_t libraryProgress, const ReadingStatsRecord* stats, bool& hasProgress) {
+  if (libraryProgress != LibraryStore::NO_PROGRESS) {
+    hasProgress = true;
+    return libraryProgress;
+  }
+  hasProgress = stats && stats->hasProgress;
+  return hasProgress ? stats->progressPercent : 0;
+}
+}  // namespace
+
 void RecentState::enter(Core& core) {
   auto& recent = RecentBooksStore::instance();
   recent.load();
@@ -25,11 +37,14 @@ void RecentState::enter(Core& core) {
   recent.pruneMissing();
   if (recent.books().size() != before) recent.save();
   READING_STATS.load();
+  libraryCount_ = LIBRARY.size();
   selected_ = 0;
   currentScreen_ = Screen::Browse;
   needsRender_ = true;
 }
 
+void RecentState::exit(Core& core) { LIBRARY.close(); }
+
 void RecentState::moveUp() {
   if (selected_ > 0) {
     selected_--;
@@ -38,24 +53,25 @@ void RecentState::moveUp() {
 }
 
 void RecentState::moveDown() {
-  const size_t count = displayedCount();
-  if (selected_ + 1 < count) {
+  if (selected_ + 1 < rowCount()) {
     selected_++;
     needsRender_ = true;
   }
 }
 
 StateTransition RecentState::openSelected(Core& core) {
-  const auto& books = RecentBooksStore::instance().books();
-  if (selected_ >= displayedCount()) {
+  Row row;
+  if (!rowAt(selected_, row)) {
     return StateTransition::stay(StateId::Recent);
   }
-  const std::string path = books[selected_].path;
+  const std::string& path = row.book.path;
 
   if (!SdMan.exists(path.c_str())) {
     RecentBooksStore::instance().remove(path);
-    const size_t count = displayedCount();
-    if (selected_ > 0 && selected_ >= count) selected_--;
+    LIBRARY.remove(path);
+    libraryCount_ = LIBRARY.size();
+    const size_t count = rowCount();
+    if (selected_ >= count) selected_ = count > 0 ? count - 1 : 0;
     currentScreen_ = Screen::Browse;
     needsRender_ = true;
     return StateTransition::stay(StateId::Recent);
@@ -129,17 +145,14 @@ void RecentState::render(Core& core) {
 }
 
 void RecentState::showSelectedStats() {
-  const auto& books = RecentBooksStore::instance().books();
-  if (selected_ >= displayedCount()) return;
-
-  const auto& book = books[selected_];
-  statsView_.setBook(book.title.c_str(), book.author.c_str());
-  const ReadingStatsRecord* stats = READING_STATS.find(book.path);
-  if (stats) {
-    statsView_.setStats(stats->hasProgress, stats->progressPercent, stats->totalSeconds, stats->sessionCount);
-  } else {
-    statsView_.setStats(false, 0, 0, 0);
-  }
+  Row row;
+  if (!rowAt(selected_, row)) return;
+
+  statsView_.setBook(row.book.title.c_str(), row.book.author.c_str());
+  const ReadingStatsRecord* stats = READING_STATS.find(row.book.path);
+  bool hasProgress = false;
+  const uint8_t progress = rowProgress(row.progress, stats, hasProgress);
+  statsView_.setStats(hasProgress, progress, stats ? stats->totalSeconds : 0, stats ? stats->sessionCount : 0);
   statsView_.showOpen = true;
   currentScreen_ = Screen::Stats;
   needsRender_ = true;
@@ -147,12 +160,14 @@ void RecentState::showSelectedStats() {
 
 void RecentState::renderBrowse(Core& core) {
   const Theme& theme = THEME;
+  const size_t recentCount = displayedCount();
+  const bool libraryPage = selected_ >= recentCount;
   renderer_.clearScreen(theme.backgroundColor);
   renderer_.drawCenteredText(theme.uiFontId, 10, tr(BOOKS), theme.primaryTextBlack, BOLD);
-  renderer_.drawCenteredText(theme.smallFontId, 36, tr(RECENT_BOOKS), theme.secondaryTextBlack);
+  renderer_.drawCenteredText(theme.smallFontId, 36, libraryPage ? tr(ALL_BOOKS) : tr(RECENT_BOOKS),
+                             theme.secondaryTextBlack);
 
-  const auto& books = RecentBooksStore::instance().books();
-  if (books.empty()) {
+  if (rowCount() == 0) {
     renderer_.drawText(theme.uiFontId, theme.screenMarginSide + 8, 70, tr(NO_RECENT_BOOKS), theme.secondaryTextBlack);
   } else {
     const int rowPitch = rowHeight();
@@ -161,23 +176,32 @@ void RecentState::renderBrowse(Core& core) {
     const int textX = x + theme.itemPaddingX;
     const int maxTextW = w - 2 * theme.itemPaddingX;
     const int titleLineHeight = renderer_.getLineHeight(theme.uiFontId);
-    const size_t count = displayedCount();
+    // Recent books fill the first page; library books follow a page at a time
+    size_t first = 0;
+    size_t last = recentCount;
+    if (libraryPage) {
+      const size_t pageRows = libraryPageRows();
+      first = recentCount + (selected_ - recentCount) / pageRows * pageRows;
+      last = std::min(rowCount(), first + pageRows);
+    }
 
-    for (size_t i = 0; i < count; i++) {
-      const int y = RecentBooksStore::LIST_START_Y + static_cast<int>(i) * rowPitch;
+    Row row;
+    for (size_t i = first; i < last && rowAt(i, row); i++) {
+      const int y = RecentBooksStore::LIST_START_Y + static_cast<int>(i - first) * rowPitch;
       const bool selected = i == selected_;
       if (selected) renderer_.fillRect(x, y, w, rowPitch - 2, theme.selectionFillBlack);
 
       const bool titleBlack = selected ? theme.selectionTextBlack : theme.primaryTextBlack;
       const bool detailBlack = selected ? theme.selectionTextBlack : theme.secondaryTextBlack;
-      const auto& book = books[i];
+      const auto& book = row.book;
       const std::string title = renderer_.truncatedText(theme.uiFontId, book.title.c_str(), maxTextW);
       renderer_.drawText(theme.uiFontId, textX, y + 2, title.c_str(), titleBlack);
 
       const ReadingStatsRecord* stats = READING_STATS.find(book.path);
+      bool hasProgress = false;
+      const uint8_t progress = rowProgress(row.progress, stats, hasProgress);
       char summary[40];
-      ui::formatBookStatsSummary(summary, sizeof(summary), stats && stats->hasProgress,
-                                 stats ? stats->progressPercent : 0, stats ? stats->totalSeconds : 0);
+      ui::formatBookStatsSummary(summary, sizeof(summary), hasProgress, progress, stats ? stats->totalSeconds : 0);
       const int summaryWidth = renderer_.getTextWidth(theme.smallFontId, summary);
       const int detailY = y + 2 + titleLineHeight;
       const int authorWidth = maxTextW - summaryWidth - 12;
@@ -203,6 +227,35 @@ size_t RecentState::displayedCount() const {
                                         rowHeight());
 }
 
+size_t RecentState::libraryPageRows() const {
+  return static_cast<size_t>(RecentBooksStore::maxRecent(renderer_.getScreenHeight(), rowHeight()));
+}
+
+// The library database is the newer source for title, author and progress; a recent book not in it
+// (database dropped or not yet refilled) keeps what the recent list stored
+bool RecentState::rowAt(const size_t index, Row& row) const {
+  LibraryStore::Entry entry;
+  const size_t recentCount = displayedCount();
+  row.progress = LibraryStore::NO_PROGRESS;
+  if (index < recentCount) {
+    row.book = RecentBooksStore::instance().books()[index];
+    if (!LIBRARY.find(row.book.path, entry)) return true;
+  } else if (LIBRARY.entryByTitle(index - recentCount, row.book.path, entry)) {
+    // Shown when the book has no title
+    const size_t slash = row.book.path.find_last_of('/');
+    row.book.title = row.book.path.substr(slash == std::string::npos ? 0 : slash + 1);
+    row.book.author.clear();
+  } else {
+    return false;
+  }
+  if (!entry.title.empty()) {
+    row.book.title = std::move(entry.title);
+    row.book.author = std::move(entry.author);
+  }
+  row.progress = entry.progress;
+  return true;
+}
+
 int RecentState::rowHeight() const { return RecentBooksStore::rowHeight(renderer_.getLineHeight(THEME.uiFontId)); }
 
 }  // namespace papyrix
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "../content/LibraryStore.h"
 #include "../content/RecentBooksStore.h"
 #include "../ui/views/ReaderViews.h"
 #include "State.h"
@@ -21,14 +22,21 @@ class RecentState : public State {
   explicit RecentState(GfxRenderer& renderer) : renderer_(renderer) {}
 
   void enter(Core& core) override;
-  void exit(Core& core) override {}
+  void exit(Core& core) override;
   StateTransition update(Core& core) override;
   void render(Core& core) override;
   StateId id() const override { return StateId::Recent; }
 
  private:
+  // A list row: a recent book, or a library book once the recent ones run out
+  struct Row {
+    RecentBook book;
+    uint8_t progress = LibraryStore::NO_PROGRESS;
+  };
+
   GfxRenderer& renderer_;
   size_t selected_ = 0;
+  size_t libraryCount_ = 0;
   bool needsRender_ = true;
   Screen currentScreen_ = Screen::Browse;
   ui::BookStatsView statsView_;
@@ -37,6 +45,9 @@ class RecentState : public State {
   void moveDown();
   StateTransition openSelected(Core& core);
   size_t displayedCount() const;
+  size_t rowCount() const { return displayedCount() + libraryCount_; }
+  size_t libraryPageRows() const;
+  bool rowAt(size_t index, Row& row) const;
   void showSelectedStats();
   void renderBrowse(Core& core);
   void renderStats(Core& core);
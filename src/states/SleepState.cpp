@@ -29,6 +29,7 @@
 #include "../ThemeManager.h"
 #include "../config.h"
 #include "../core/Core.h"
+#include "../core/Trace.h"
 #include "../drivers/Device.h"
 #include "../images/PapyrixLogo.h"
 
@@ -122,6 +123,9 @@ void SleepState::enter(Core& core) {
     core.network.shutdown();
   }
 
+  TRACE_INSTANT(Sleep);
+  trace::flush();
+
   // Power down peripherals before deep sleep to minimize current draw
   SdMan.end();
   LittleFS.end();
@@ -470,7 +470,8 @@ void bookCard(const GfxRenderer& r, const Theme& t, int y, const char* titleText
   }
 }
 
-void fileEntry(const GfxRenderer& r, const Theme& t, int y, const char* name, bool isDir, bool selected) {
+void fileEntry(const GfxRenderer& r, const Theme& t, int y, const char* name, bool isDir, bool selected,
+               const char* detail) {
   const int x = t.screenMarginSide;
   const int w = r.getScreenWidth() - 2 * t.screenMarginSide;
   const int h = t.itemHeight;
@@ -489,12 +490,18 @@ void fileEntry(const GfxRenderer& r, const Theme& t, int y, const char* name, bo
     displayName[sizeof(displayName) - 1] = '\0';
   }
 
+  const bool textColor = selected ? t.selectionTextBlack : t.primaryTextBlack;
+  int maxTextW = w - 2 * t.itemPaddingX;
+  if (detail != nullptr && detail[0] != '\0') {
+    const int detailW = r.getTextWidth(t.uiFontId, detail);
+    r.drawText(t.uiFontId, x + w - t.itemPaddingX - detailW, textY, detail, textColor);
+    maxTextW -= detailW + t.itemPaddingX;
+  }
+
   // Truncate if too long
-  const int maxTextW = w - 2 * t.itemPaddingX;
   const auto truncated = r.truncatedText(t.uiFontId, displayName, maxTextW);
 
-  r.drawText(t.uiFontId, x + t.itemPaddingX, textY, truncated.c_str(),
-             selected ? t.selectionTextBlack : t.primaryTextBlack);
+  r.drawText(t.uiFontId, x + t.itemPaddingX, textY, truncated.c_str(), textColor);
 }
 
 void chapterItem(const GfxRenderer& r, const Theme& t, int fontId, int y, const char* title, uint8_t depth,
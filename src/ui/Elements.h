@@ -99,8 +99,9 @@ void statusBar(const GfxRenderer& r, const Theme& t, int page, int total, int pe
 void bookCard(const GfxRenderer& r, const Theme& t, int y, const char* title, const char* author, const uint8_t* cover,
               int coverW, int coverH);
 
-// File entry - File name with directory indicator
-void fileEntry(const GfxRenderer& r, const Theme& t, int y, const char* name, bool isDir, bool selected);
+// File entry - File name with directory indicator and optional right-aligned detail (e.g. progress)
+void fileEntry(const GfxRenderer& r, const Theme& t, int y, const char* name, bool isDir, bool selected,
+               const char* detail = nullptr);
 
 // Chapter item - TOC entry with depth indentation and current chapter indicator
 // fontId: Use reader font (readerFontIdXSmall) for EPUB/TXT/Markdown to support non-Latin glyphs,
@@ -0,0 +1,148 @@
+// CSS selector matching benchmark - per-element style resolution cost with a
+// large publisher stylesheet, simple-only path vs. ancestor-bloom selector path.
+//
+// Usage: CssSelectorBench [stylesheet.css] [iterations]
+
+#include "test_utils.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <CssParser.h>
+#include <CssSelector.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "."
+#endif
+
+namespace {
+
+struct Element {
+  int depth;
+  std::string tag;
+  std::string classes;
+  std::string id;
+};
+
+// Document-order element list for a chapter with the usual publisher structure
+std::vector<Element> buildChapter() {
+  std::vector<Element> out;
+  auto add = [&out](int depth, const char* tag, const char* classes = "", const char* id = "") {
+    out.push_back({depth, tag, classes, id});
+  };
+
+  add(0, "html");
+  add(1, "body", "calibre");
+  add(2, "section", "chapter", "chapter-3");
+  add(3, "header");
+  add(4, "h2", "chapter-title");
+  add(5, "span", "label");
+  add(4, "p", "subtitle");
+  add(3, "div", "epigraph");
+  add(4, "p");
+  add(5, "em");
+  add(4, "cite");
+  for (int para = 0; para < 60; para++) {
+    add(3, "p", para == 0 ? "first opening" : (para % 9 == 0 ? "calibre3" : ""));
+    add(4, "em");
+    add(4, "span", para % 4 == 0 ? "smallcaps" : "");
+    if (para % 5 == 0) add(4, "a", "noteref", "ref-1");
+    if (para % 7 == 0) add(5, "i", "foreign");
+  }
+  add(3, "p", "scene-break");
+  add(3, "div", "poem");
+  for (int stanza = 0; stanza < 4; stanza++) {
+    add(4, "div", "stanza");
+    for (int line = 0; line < 4; line++) add(5, "p", line % 2 ? "indent" : "");
+  }
+  add(3, "blockquote", "verse");
+  add(4, "div");
+  for (int line = 0; line < 6; line++) add(5, "p", "i2");
+  add(3, "div", "letter");
+  add(4, "p", "dateline");
+  add(4, "p", "salutation");
+  for (int para = 0; para < 8; para++) add(4, "p");
+  add(4, "p", "closing");
+  add(3, "aside", "sidebar");
+  add(4, "h4");
+  add(4, "p");
+  add(4, "ul");
+  for (int item = 0; item < 5; item++) add(5, "li");
+  add(2, "section", "endnotes");
+  add(3, "ol");
+  for (int note = 0; note < 12; note++) {
+    add(4, "li", "", "note-1");
+    add(5, "p");
+    add(6, "a", "backlink");
+  }
+  return out;
+}
+
+double nsPerElement(const std::chrono::steady_clock::duration elapsed, size_t elements) {
+  return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(elements);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string cssPath = argc > 1 ? argv[1] : std::string(BENCH_DATA_DIR) + "/publisher.css";
+  const int iterations = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+  const std::string css = TestUtils::readFile(cssPath);
+  if (css.empty()) {
+    std::fprintf(stderr, "Cannot read stylesheet: %s\n", cssPath.c_str());
+    return 1;
+  }
+  SdMan.registerFile("/bench.css", css);
+
+  CssParser parser;
+  const auto parseStart = std::chrono::steady_clock::now();
+  parser.parseFile("/bench.css");
+  const auto parseElapsed = std::chrono::steady_clock::now() - parseStart;
+
+  const auto chapter = buildChapter();
+  const size_t totalElements = chapter.size() * static_cast<size_t>(iterations);
+
+  // Simple-only path (tag / .class / tag.class map lookups), as before selector rules
+  volatile int sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int it = 0; it < iterations; it++) {
+    for (const auto& el : chapter) {
+      sink = sink + parser.getCombinedStyle(el.tag, el.classes).defined.anySet();
+    }
+  }
+  const auto simpleElapsed = std::chrono::steady_clock::now() - start;
+
+  // Full path: key hashing + ancestor stack + selector rules, as ChapterHtmlSlimParser does
+  CssAncestorStack stack;
+  size_t styled = 0;
+  start = std::chrono::steady_clock::now();
+  for (int it = 0; it < iterations; it++) {
+    stack.clear();
+    for (const auto& el : chapter) {
+      const auto key = CssElementKey::fromAttributes(el.tag.c_str(), el.classes.c_str(), el.id.c_str());
+      stack.truncate(static_cast<size_t>(el.depth));
+      const CssStyle style = parser.getCombinedStyle(el.tag, el.classes, key, stack);
+      stack.enter(static_cast<size_t>(el.depth), key);
+      styled += style.defined.anySet();
+    }
+  }
+  const auto fullElapsed = std::chrono::steady_clock::now() - start;
+  (void)sink;
+
+  std::printf("stylesheet:        %s (%zu bytes)\n", cssPath.c_str(), css.size());
+  std::printf("rules:             %zu total, %zu selector rules\n", parser.getStyleCount(),
+              parser.getSelectorRuleCount());
+  std::printf("parse:             %.3f ms\n", std::chrono::duration<double, std::milli>(parseElapsed).count());
+  std::printf("elements:          %zu per chapter x %d iterations\n", chapter.size(), iterations);
+  std::printf("simple match:      %.1f ns/element\n", nsPerElement(simpleElapsed, totalElements));
+  std::printf("selector match:    %.1f ns/element (%zu of %zu elements styled)\n",
+              nsPerElement(fullElapsed, totalElements), styled / static_cast<size_t>(iterations), chapter.size());
+  return 0;
+}
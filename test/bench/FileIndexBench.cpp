@@ -0,0 +1,145 @@
+// Directory index cost for a large folder - FileIndex over a mocked directory
+// of generated book names. Reports the cold build, the validity check on a
+// revisit, in-place patches for files added and removed by the firmware, and
+// row reads, plus the index size next to the old fixed 257-byte records.
+//
+// Usage: FileIndexBench [entries] [passes]
+
+#include <FileIndex.h>
+#include <FsHelpers.h>
+#include <SDCardManager.h>
+#include <platform_stubs.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kAuthors[] = {"Tolstoy", "Austen", "Dostoevsky", "Dickens", "Bulgakov", "Le Guin", "Pratchett"};
+const char* const kWords[] = {"War",   "Peace", "Night",  "House", "Garden", "River",   "Stone",
+                              "Light", "Road",  "Winter", "Crown", "Letter", "Mirror", "Harbour"};
+
+bool acceptBook(const char* name, bool isDir) {
+  if (!name || name[0] == '.' || FsHelpers::isHiddenFsItem(name)) return false;
+  return isDir || FsHelpers::isSupportedBookFile(name);
+}
+
+// "Author - Word Word N.epub" in scrambled order, with a few folders
+std::vector<MockDirectoryEntry> makeEntries(size_t count) {
+  std::vector<MockDirectoryEntry> entries;
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    if (i % 100 == 0) {
+      entries.push_back({"Series " + std::to_string(seed % 997), true});
+      continue;
+    }
+    std::string name = kAuthors[(seed >> 8) % 7];
+    name += " - ";
+    name += kWords[(seed >> 12) % 14];
+    name += ' ';
+    name += kWords[(seed >> 16) % 14];
+    name += ' ';
+    name += std::to_string(i);
+    name += (seed >> 20) % 5 == 0 ? ".fb2" : ".epub";
+    entries.push_back({name, false});
+  }
+  return entries;
+}
+
+std::string indexPath() {
+  for (const std::string& path : SdMan.writtenFilePaths()) {
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".idx") == 0) return path;
+  }
+  return {};
+}
+
+template <typename Fn>
+double bestMs(int passes, Fn&& fn) {
+  double best = 0;
+  for (int pass = 0; pass < passes; pass++) {
+    const auto start = Clock::now();
+    fn();
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (pass == 0 || ms < best) best = ms;
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 10000;
+  const int passes = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+  if (count == 0) {
+    std::fprintf(stderr, "Usage: %s [entries] [passes]\n", argv[0]);
+    return 1;
+  }
+
+  // Device-sized heap for the sort buffer
+  testSetLargestFreeBlock(64 * 1024);
+  auto entries = makeEntries(count);
+  FileIndex index;
+  bool ok = true;
+
+  const double buildMs = bestMs(passes, [&]() {
+    SdMan.reset();
+    SdMan.registerDirectory("/books", entries);
+    index.close();
+    ok = index.open("/books", acceptBook) && ok;
+  });
+  const std::string path = indexPath();
+  const size_t indexBytes = SdMan.getWrittenData(path).size();
+
+  const double reopenMs = bestMs(passes, [&]() {
+    index.close();
+    ok = index.open("/books", acceptBook) && ok;
+  });
+  index.close();
+
+  // One add and one remove per iteration, as an upload followed by a delete
+  constexpr int kPatches = 50;
+  const double patchMs = bestMs(passes, [&]() {
+    for (int i = 0; i < kPatches; i++) {
+      const std::string name = "/books/Uploaded " + std::to_string(i) + ".epub";
+      ok = FileIndex::noteAdded(name.c_str(), false, acceptBook) && ok;
+      ok = FileIndex::noteRemoved(name.c_str()) && ok;
+    }
+  });
+
+  ok = index.open("/books", acceptBook) && ok;
+  FileIndex::Entry entry{};
+  uint32_t checksum = 2166136261u;
+  const double readMs = bestMs(passes, [&]() {
+    checksum = 2166136261u;
+    for (size_t row = 0; row < index.size(); row++) {
+      ok = index.entryAt(row, entry) && ok;
+      for (const char* c = entry.name; *c; c++) checksum = (checksum ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+  });
+
+  constexpr size_t kLookups = 100;
+  const double findMs = bestMs(passes, [&]() {
+    for (size_t i = 0; i < kLookups; i++) {
+      const auto& target = entries[(i * 7919) % entries.size()];
+      ok = index.findRowByName(target.name.c_str()) != SIZE_MAX && ok;
+    }
+  });
+
+  std::printf("FileIndex over %zu entries (%zu listed), best of %d\n\n", count, index.size(), passes);
+  std::printf("%-28s %10s\n", "operation", "ms");
+  std::printf("%-28s %10.2f\n", "build (no index)", buildMs);
+  std::printf("%-28s %10.2f\n", "reopen (validity check)", reopenMs);
+  std::printf("%-28s %10.4f\n", "patch add + remove", patchMs / kPatches);
+  std::printf("%-28s %10.4f\n", "entryAt per row", readMs / static_cast<double>(std::max<size_t>(1, index.size())));
+  std::printf("%-28s %10.4f\n", "findRowByName", findMs / kLookups);
+  std::printf("\nindex %zu bytes (fixed 257-byte records: %zu)  checksum %08x%s\n", indexBytes,
+              index.size() * 257 + 24 + 6, checksum, ok ? "" : "  FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+// JPEG cover conversion benchmark - ms per conversion and peak heap for the
+// cover (450x750, 2-bit) and thumbnail (320x440, 1-bit) paths, plus raw
+// picojpeg Y decode time at each DCT scale (1/1, 1/2, 1/4, 1/8).
+//
+// Usage: JpegScaleBench [cover.jpg | directory ...] [-n iterations]
+//
+// Covers are not checked in; point it at a folder of real ones (baseline JPEGs,
+// progressive files are skipped). Peak heap counts malloc/new made during one
+// conversion (Linux only, via --wrap); picojpeg's static tables are not heap.
+
+#include "test_utils.h"
+
+#include <ByteSource.h>
+#include <JpegToBmpConverter.h>
+#include <Print.h>
+#include <picojpeg.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <malloc.h>
+#endif
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "."
+#endif
+
+// ---------------------------------------------------------------------------
+// Heap accounting. The bench target links with -Wl,--wrap=malloc etc., so the
+// converter's malloc/free land here; operator new is routed through malloc.
+// ---------------------------------------------------------------------------
+namespace heap {
+size_t current = 0;
+size_t peak = 0;
+
+void reset() { peak = current; }
+size_t peakSinceReset(const size_t baseline) { return peak - baseline; }
+}  // namespace heap
+
+#ifdef __linux__
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static void trackAlloc(void* ptr) {
+  if (!ptr) return;
+  heap::current += malloc_usable_size(ptr);
+  heap::peak = std::max(heap::peak, heap::current);
+}
+
+static void trackFree(void* ptr) {
+  if (ptr) heap::current -= malloc_usable_size(ptr);
+}
+
+void* __wrap_malloc(size_t size) {
+  void* ptr = __real_malloc(size);
+  trackAlloc(ptr);
+  return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  void* ptr = __real_calloc(count, size);
+  trackAlloc(ptr);
+  return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  trackFree(ptr);
+  void* out = __real_realloc(ptr, size);
+  trackAlloc(out ? out : ptr);
+  return out;
+}
+
+void __wrap_free(void* ptr) {
+  trackFree(ptr);
+  __real_free(ptr);
+}
+}  // extern "C"
+
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+#endif
+
+namespace {
+
+class MemoryByteSource : public ByteSource {
+ public:
+  explicit MemoryByteSource(const std::string& data) : data_(data) {}
+  int read(uint8_t* buf, const size_t len) override {
+    const size_t n = std::min(len, data_.size() - pos_);
+    memcpy(buf, data_.data() + pos_, n);
+    pos_ += n;
+    return static_cast<int>(n);
+  }
+
+ private:
+  const std::string& data_;
+  size_t pos_ = 0;
+};
+
+// Counts the BMP bytes instead of keeping them
+class NullPrint : public Print {
+ public:
+  size_t write(uint8_t) override {
+    bytes++;
+    return 1;
+  }
+  size_t write(const uint8_t*, const size_t size) override {
+    bytes += size;
+    return size;
+  }
+  size_t bytes = 0;
+};
+
+struct Cover {
+  std::string path;
+  std::string data;
+  int width = 0;
+  int height = 0;
+};
+
+struct MemoryReader {
+  const std::string* data;
+  size_t pos;
+};
+
+unsigned char readCallback(unsigned char* buf, const unsigned char size, unsigned char* read, void* ctx) {
+  auto* reader = static_cast<MemoryReader*>(ctx);
+  const size_t n = std::min<size_t>(size, reader->data->size() - reader->pos);
+  memcpy(buf, reader->data->data() + reader->pos, n);
+  reader->pos += n;
+  *read = static_cast<unsigned char>(n);
+  return 0;
+}
+
+// Decode every MCU at the given scale without touching the pixels
+bool decodeOnly(const std::string& data, const unsigned char scale, pjpeg_image_info_t* info) {
+  MemoryReader reader = {&data, 0};
+  if (pjpeg_decode_init(info, readCallback, &reader, PJPG_GRAYSCALE_ONLY) != 0) return false;
+  if (pjpeg_set_scale(scale) != 0) return false;
+  for (int i = 0; i < info->m_MCUSPerRow * info->m_MCUSPerCol; i++) {
+    if (pjpeg_decode_mcu() != 0) return false;
+  }
+  return true;
+}
+
+void collect(const std::filesystem::path& path, std::vector<std::string>& out) {
+  std::error_code ec;
+  if (std::filesystem::is_directory(path, ec)) {
+    for (const auto& entry : std::filesystem::directory_iterator(path, ec)) collect(entry.path(), out);
+    return;
+  }
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+  if (ext == ".jpg" || ext == ".jpeg") out.push_back(path.string());
+}
+
+template <typename Fn>
+double msPerRun(const int iterations, Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) fn();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 5;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      iterations = std::max(1, std::atoi(argv[++i]));
+    } else {
+      collect(argv[i], paths);
+    }
+  }
+  if (argc < 2) collect(std::string(BENCH_DATA_DIR) + "/covers", paths);
+  std::sort(paths.begin(), paths.end());
+
+  std::vector<Cover> covers;
+  for (const auto& path : paths) {
+    Cover cover;
+    cover.path = path;
+    cover.data = TestUtils::readFile(path);
+    pjpeg_image_info_t info;
+    if (cover.data.empty() || !decodeOnly(cover.data, PJPG_SCALE_1_1, &info)) {
+      std::fprintf(stderr, "skipping %s (not a baseline JPEG)\n", path.c_str());
+      continue;
+    }
+    cover.width = info.m_width;
+    cover.height = info.m_height;
+    covers.push_back(std::move(cover));
+  }
+  if (covers.empty()) {
+    std::fprintf(stderr, "No baseline JPEG covers found. Usage: %s [cover.jpg | directory ...] [-n iterations]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  struct Target {
+    const char* name;
+    int width;
+    int height;
+    bool oneBit;
+  } const targets[] = {{"cover", 450, 750, false}, {"thumb", 320, 440, true}};
+
+  std::printf("%-28s %11s | %-6s %4s %9s %9s | %-6s %4s %9s %9s | decode ms 1/1   1/2   1/4   1/8\n", "file",
+              "size", "target", "dct", "ms", "peak KB", "target", "dct", "ms", "peak KB");
+
+  double totalMs[2] = {};
+  size_t maxPeak[2] = {};
+  double totalDecode[4] = {};
+
+  for (const auto& cover : covers) {
+    const std::string name = std::filesystem::path(cover.path).filename().string();
+    std::printf("%-28.28s %5dx%-5d", name.c_str(), cover.width, cover.height);
+
+    for (int t = 0; t < 2; t++) {
+      const Target& target = targets[t];
+      size_t peak = 0;
+      bool ok = true;
+      const double ms = msPerRun(iterations, [&]() {
+        NullPrint out;
+        MemoryByteSource source(cover.data);
+        const size_t baseline = heap::current;
+        heap::reset();
+        ok = JpegToBmpConverter::jpegStreamToBmpStream(source, out, target.width, target.height, target.oneBit) && ok;
+        peak = std::max(peak, heap::peakSinceReset(baseline));
+      });
+
+      // Same fit as the converter, to report which DCT scale it picked
+      const float fit = std::min(static_cast<float>(target.width) / cover.width,
+                                 static_cast<float>(target.height) / cover.height);
+      const int outW = fit < 1.0f ? std::max(1, static_cast<int>(cover.width * fit)) : cover.width;
+      const int outH = fit < 1.0f ? std::max(1, static_cast<int>(cover.height * fit)) : cover.height;
+      const int scale = JpegToBmpConverter::decodeScaleFor(cover.width, cover.height, outW, outH);
+
+      std::printf(" | %-6s 1/%-2d %9.2f %9.1f", ok ? target.name : "FAILED", 1 << scale, ms, peak / 1024.0);
+      totalMs[t] += ms;
+      maxPeak[t] = std::max(maxPeak[t], peak);
+    }
+
+    std::printf(" |         ");
+    for (unsigned char scale = PJPG_SCALE_1_1; scale <= PJPG_SCALE_1_8; scale++) {
+      pjpeg_image_info_t info;
+      const double ms = msPerRun(iterations, [&]() { decodeOnly(cover.data, scale, &info); });
+      totalDecode[scale] += ms;
+      std::printf(" %5.1f", ms);
+    }
+    std::printf("\n");
+  }
+
+  const double n = static_cast<double>(covers.size());
+#ifndef __linux__
+  std::printf("(peak heap tracking needs Linux; peak columns are 0)\n");
+#endif
+  std::printf("\n%zu covers x %d iterations\n", covers.size(), iterations);
+  for (int t = 0; t < 2; t++) {
+    std::printf("%-6s %dx%d %s: %.2f ms/conversion, peak heap %.1f KB\n", targets[t].name, targets[t].width,
+                targets[t].height, targets[t].oneBit ? "1-bit" : "2-bit", totalMs[t] / n, maxPeak[t] / 1024.0);
+  }
+  std::printf("decode only (Y): 1/1 %.2f ms, 1/2 %.2f ms, 1/4 %.2f ms, 1/8 %.2f ms\n", totalDecode[0] / n,
+              totalDecode[1] / n, totalDecode[2] / n, totalDecode[3] / n);
+  return 0;
+}
@@ -0,0 +1,643 @@
+// Reader benchmark suite - times the reader's hot paths over a fixed corpus so
+// runs can be compared across commits:
+//
+//   open         ContentHandle::open() on a cold cache (metadata, spine, TOC)
+//   first-page   parser + PageCache::create() for the first page only
+//   paginate     full pagination of every section into the page cache
+//   deserialize  PageCache::loadPage() of every cached page
+//   render       Page::render() of every page (XTC: page bitmap load)
+//   thumbnail    home screen cover + thumbnail generation
+//
+// Usage: ReaderBench [-n iterations] [-o results.json] [corpus dir]
+//
+// The corpus lives in bench/data/corpus as plain sources; the EPUB is zipped
+// from corpus/epub at startup (with a generated cover.bmp) and the XTC is
+// generated, so no binary fixtures are checked in. Everything is served by the
+// SD mock, so SD time is a memcpy. Text is laid out with the constant-metrics
+// GfxRenderer stub and drawing is a no-op, so "render" measures page traversal
+// rather than rasterization. Each run starts from an empty SD cache; medians,
+// p95 and malloc/new counts per run (Linux only, via --wrap) go to the JSON
+// file. Compare two files with scripts/compare_bench.py.
+
+#include "test_utils.h"
+
+#include <ContentHandle.h>
+#include <ContentParser.h>
+#include <EpubChapterParser.h>
+#include <Fb2.h>
+#include <Fb2Parser.h>
+#include <GfxRenderer.h>
+#include <HomeThumbnail.h>
+#include <MarkdownParser.h>
+#include <Page.h>
+#include <PageCache.h>
+#include <PlainTextParser.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+#include <Xtc/XtcParser.h>
+#include <Xtc/XtcTypes.h>
+#include <platform_stubs.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "."
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocation counting. The bench links with -Wl,--wrap=malloc etc., so every
+// malloc lands here; operator new is routed through malloc.
+// ---------------------------------------------------------------------------
+namespace allocs {
+uint64_t count = 0;
+uint64_t bytes = 0;
+}  // namespace allocs
+
+#ifdef __linux__
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+  allocs::count++;
+  allocs::bytes += size;
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  allocs::count++;
+  allocs::bytes += count * size;
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  allocs::count++;
+  allocs::bytes += size;
+  return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) { __real_free(ptr); }
+}  // extern "C"
+
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const CACHE_DIR = "/.papyrix";
+constexpr uint16_t XTC_WIDTH = 480;
+constexpr uint16_t XTC_HEIGHT = 800;
+constexpr size_t XTC_PAGES = 60;
+constexpr int WARMUP_RUNS = 1;
+
+// ---------------------------------------------------------------------------
+// Corpus
+// ---------------------------------------------------------------------------
+
+enum class Format { Epub, Fb2, Txt, Markdown, Xtc };
+
+struct Book {
+  const char* name;
+  Format format;
+  std::string path;
+  std::string data;
+  uint32_t pages = 0;  // Filled by validation, reported for context
+};
+
+bool readFile(const std::string& path, std::string& out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  out = ss.str();
+  return true;
+}
+
+std::string rawDeflate(const std::string& in) {
+  z_stream zs{};
+  deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&zs, in.size()), '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = static_cast<uInt>(in.size());
+  zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  zs.avail_out = static_cast<uInt>(out.size());
+  deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+struct ZipMember {
+  std::string name;
+  std::string data;
+};
+
+// Deflated archive, except the mimetype which EPUB requires stored and first
+std::string buildZip(const std::vector<ZipMember>& members) {
+  std::string zip;
+  std::string central;
+  const auto u16 = [](std::string& out, const uint16_t v) {
+    out += static_cast<char>(v);
+    out += static_cast<char>(v >> 8);
+  };
+  const auto u32 = [](std::string& out, const uint32_t v) {
+    for (int i = 0; i < 4; i++) out += static_cast<char>(v >> (8 * i));
+  };
+
+  for (const auto& m : members) {
+    const bool stored = m.name == "mimetype";
+    const std::string data = stored ? m.data : rawDeflate(m.data);
+    const uint16_t method = stored ? 0 : 8;
+    const auto* bytes = reinterpret_cast<const Bytef*>(m.data.data());
+    const uint32_t crc = static_cast<uint32_t>(crc32(0, bytes, static_cast<uInt>(m.data.size())));
+    const uint32_t offset = static_cast<uint32_t>(zip.size());
+
+    u32(zip, 0x04034b50);
+    u16(zip, 20);
+    u16(zip, 0);
+    u16(zip, method);
+    u32(zip, 0);
+    u32(zip, crc);
+    u32(zip, static_cast<uint32_t>(data.size()));
+    u32(zip, static_cast<uint32_t>(m.data.size()));
+    u16(zip, static_cast<uint16_t>(m.name.size()));
+    u16(zip, 0);
+    zip += m.name + data;
+
+    u32(central, 0x02014b50);
+    u16(central, 20);
+    u16(central, 20);
+    u16(central, 0);
+    u16(central, method);
+    u32(central, 0);
+    u32(central, crc);
+    u32(central, static_cast<uint32_t>(data.size()));
+    u32(central, static_cast<uint32_t>(m.data.size()));
+    u16(central, static_cast<uint16_t>(m.name.size()));
+    u16(central, 0);
+    u16(central, 0);
+    u16(central, 0);
+    u16(central, 0);
+    u32(central, 0);
+    u32(central, offset);
+    central += m.name;
+  }
+
+  const uint32_t centralOffset = static_cast<uint32_t>(zip.size());
+  zip += central;
+  u32(zip, 0x06054b50);
+  u16(zip, 0);
+  u16(zip, 0);
+  u16(zip, static_cast<uint16_t>(members.size()));
+  u16(zip, static_cast<uint16_t>(members.size()));
+  u32(zip, static_cast<uint32_t>(central.size()));
+  u32(zip, centralOffset);
+  u16(zip, 0);
+  return zip;
+}
+
+// 24-bpp gradient cover, picked up by the EPUB's cover.bmp fallback
+std::string buildCoverBmp(const uint16_t w, const uint16_t h) {
+  const uint32_t rowSize = (static_cast<uint32_t>(w) * 3 + 3) / 4 * 4;
+  std::string data(14 + 40 + rowSize * h, '\0');
+  auto put32 = [&](const size_t off, const uint32_t v) { memcpy(&data[off], &v, 4); };
+  data[0] = 'B';
+  data[1] = 'M';
+  put32(2, static_cast<uint32_t>(data.size()));
+  put32(10, 54);
+  put32(14, 40);
+  put32(18, w);
+  put32(22, -static_cast<int32_t>(h));
+  memcpy(&data[26], "\x01\x00", 2);
+  memcpy(&data[28], "\x18\x00", 2);
+  put32(34, rowSize * h);
+  for (uint16_t y = 0; y < h; y++) {
+    for (uint16_t x = 0; x < w; x++) {
+      const size_t off = 54 + static_cast<size_t>(y) * rowSize + static_cast<size_t>(x) * 3;
+      data[off] = static_cast<char>((x * 255) / w);
+      data[off + 1] = static_cast<char>((y * 255) / h);
+      data[off + 2] = static_cast<char>(((x + y) * 127) / (w + h));
+    }
+  }
+  return data;
+}
+
+bool buildEpub(const std::string& corpusDir, std::string& out) {
+  static const char* const FILES[] = {"mimetype",           "META-INF/container.xml", "OEBPS/content.opf",
+                                      "OEBPS/toc.ncx",      "OEBPS/chapter1.xhtml",   "OEBPS/chapter2.xhtml",
+                                      "OEBPS/chapter3.xhtml"};
+  std::vector<ZipMember> members;
+  for (const char* name : FILES) {
+    ZipMember member{name, ""};
+    if (!readFile(corpusDir + "/epub/" + name, member.data)) return false;
+    members.push_back(std::move(member));
+  }
+  // Shared with CssSelectorBench: a real publisher stylesheet
+  ZipMember css{"OEBPS/publisher.css", ""};
+  if (!readFile(std::string(BENCH_DATA_DIR) + "/publisher.css", css.data)) return false;
+  members.push_back(std::move(css));
+  members.push_back({"OEBPS/cover.bmp", buildCoverBmp(300, 450)});
+  out = buildZip(members);
+  return true;
+}
+
+// Text-like 1-bit pages: rows of black word runs on white, ~10% ink
+std::string buildXtc(const size_t pageCount) {
+  constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+  const size_t pageDataOffset = pageTableOffset + pageCount * sizeof(xtc::PageTableEntry);
+  const size_t rowBytes = (XTC_WIDTH + 7) / 8;
+  const size_t bitmapSize = xtc::xtgBitmapSize(XTC_WIDTH, XTC_HEIGHT);
+  const size_t pageSize = sizeof(xtc::XtgPageHeader) + bitmapSize;
+
+  std::string file(pageDataOffset + pageCount * pageSize, '\0');
+  auto* data = reinterpret_cast<uint8_t*>(&file[0]);
+  auto* header = reinterpret_cast<xtc::XtcHeader*>(data);
+  header->magic = xtc::XTC_MAGIC;
+  header->versionMajor = 1;
+  header->pageCount = static_cast<uint16_t>(pageCount);
+  header->hasMetadata = 1;
+  header->pageTableOffset = pageTableOffset;
+  header->dataOffset = pageDataOffset;
+  memcpy(data + sizeof(xtc::XtcHeader), "The Harbour Road", 16);
+
+  for (size_t i = 0; i < pageCount; i++) {
+    const size_t offset = pageDataOffset + i * pageSize;
+    auto* entry = reinterpret_cast<xtc::PageTableEntry*>(data + pageTableOffset + i * sizeof(xtc::PageTableEntry));
+    entry->dataOffset = offset;
+    entry->dataSize = pageSize;
+    entry->width = XTC_WIDTH;
+    entry->height = XTC_HEIGHT;
+
+    auto* pageHeader = reinterpret_cast<xtc::XtgPageHeader*>(data + offset);
+    pageHeader->magic = xtc::XTG_MAGIC;
+    pageHeader->width = XTC_WIDTH;
+    pageHeader->height = XTC_HEIGHT;
+    pageHeader->dataSize = bitmapSize;
+
+    uint8_t* bitmap = data + offset + sizeof(*pageHeader);
+    memset(bitmap, 0xFF, bitmapSize);
+    uint32_t seed = static_cast<uint32_t>(i) * 2654435761u;
+    for (int lineTop = 40; lineTop + 24 < XTC_HEIGHT - 40; lineTop += 32) {
+      for (int x = 24; x < XTC_WIDTH - 24;) {
+        seed = seed * 1664525u + 1013904223u;
+        const int wordWidth = 12 + static_cast<int>((seed >> 24) % 60);
+        for (int y = lineTop + 4; y < lineTop + 22; y++) {
+          for (int dx = 0; dx < wordWidth && x + dx < XTC_WIDTH - 24; dx++) {
+            if (((dx + y) % 3) == 0) bitmap[y * rowBytes + (x + dx) / 8] &= ~(0x80 >> ((x + dx) % 8));
+          }
+        }
+        x += wordWidth + 8;
+      }
+    }
+  }
+  return file;
+}
+
+bool loadCorpus(const std::string& corpusDir, std::vector<Book>& books) {
+  books = {
+      {"epub", Format::Epub, "/books/harbour.epub", ""},     {"fb2", Format::Fb2, "/books/harbour.fb2", ""},
+      {"txt", Format::Txt, "/books/harbour.txt", ""},        {"markdown", Format::Markdown, "/books/harbour.md", ""},
+      {"xtc", Format::Xtc, "/books/harbour.xtc", buildXtc(XTC_PAGES)},
+  };
+  return buildEpub(corpusDir, books[0].data) && readFile(corpusDir + "/book.fb2", books[1].data) &&
+         readFile(corpusDir + "/book.txt", books[2].data) && readFile(corpusDir + "/book.md", books[3].data);
+}
+
+// Every run starts from an SD card holding only the book
+void resetSd(const Book& book) {
+  SdMan.clearFiles();
+  SdMan.clearWrittenFiles();
+  SdMan.reset();
+  SdMan.registerFile(book.path, book.data);
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------------------------
+
+struct Sample {
+  double ms = 0;
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+};
+
+// Scenarios bracket only the work being measured; setup stays outside
+class Timer {
+ public:
+  void start() {
+    allocations_ = allocs::count;
+    bytes_ = allocs::bytes;
+    begin_ = Clock::now();
+  }
+  void stop() {
+    sample.ms += std::chrono::duration<double, std::milli>(Clock::now() - begin_).count();
+    sample.allocations += allocs::count - allocations_;
+    sample.bytes += allocs::bytes - bytes_;
+  }
+
+  Sample sample;
+
+ private:
+  Clock::time_point begin_;
+  uint64_t allocations_ = 0;
+  uint64_t bytes_ = 0;
+};
+
+// Portrait 480x800 screen less the reader's margins
+RenderConfig makeConfig() {
+  RenderConfig config;
+  config.fontId = 1;
+  config.viewportWidth = 440;
+  config.viewportHeight = 740;
+  config.lineCompression = 1.0f;
+  config.hyphenation = true;
+  return config;
+}
+
+struct Reader {
+  GfxRenderer& gfx;
+  RenderConfig config;
+};
+
+int sectionCount(papyrix::ContentHandle& handle, const Book& book) {
+  switch (book.format) {
+    case Format::Epub:
+      return handle.asEpub()->getEpubShared()->getSpineItemsCount();
+    case Format::Fb2:
+      return handle.asFb2()->getFb2()->getSectionCount();
+    default:
+      return 1;
+  }
+}
+
+std::unique_ptr<ContentParser> makeParser(papyrix::ContentHandle& handle, const Book& book, const int section,
+                                          Reader& reader) {
+  switch (book.format) {
+    case Format::Epub:
+      return std::unique_ptr<ContentParser>(
+          new EpubChapterParser(handle.asEpub()->getEpubShared(), section, reader.gfx, reader.config, ""));
+    case Format::Fb2: {
+      const Fb2* fb2 = handle.asFb2()->getFb2();
+      auto* parser = new Fb2Parser(fb2->getPath(), reader.gfx, reader.config, fb2->getLanguage());
+      fb2->prepareSectionParser(*parser, section);
+      return std::unique_ptr<ContentParser>(parser);
+    }
+    case Format::Markdown:
+      return std::unique_ptr<ContentParser>(new MarkdownParser(book.path, reader.gfx, reader.config));
+    default:
+      return std::unique_ptr<ContentParser>(new PlainTextParser(book.path, reader.gfx, reader.config));
+  }
+}
+
+std::string cachePath(const int section) {
+  return std::string(CACHE_DIR) + "/bench/section_" + std::to_string(section) + ".bin";
+}
+
+// Paginates every section; maxPages 1 stops after the first page of section 0
+bool paginate(papyrix::ContentHandle& handle, const Book& book, Reader& reader, const uint32_t maxPages,
+              std::vector<std::unique_ptr<PageCache>>& caches, uint32_t& pages) {
+  pages = 0;
+  const int sections = maxPages == 1 ? 1 : sectionCount(handle, book);
+  for (int s = 0; s < sections; s++) {
+    auto parser = makeParser(handle, book, s, reader);
+    std::unique_ptr<PageCache> cache(new PageCache(cachePath(s)));
+    if (!cache->create(*parser, reader.config, maxPages)) return false;
+    pages += cache->pageCount();
+    caches.push_back(std::move(cache));
+  }
+  return pages > 0;
+}
+
+enum class Scenario { Open, FirstPage, Paginate, Deserialize, Render, Thumbnail, Count };
+
+const char* scenarioName(const Scenario scenario) {
+  static const char* const NAMES[] = {"open", "first-page", "paginate", "deserialize", "render", "thumbnail"};
+  return NAMES[static_cast<int>(scenario)];
+}
+
+bool supported(const Book& book, const Scenario scenario) {
+  if (book.format == Format::Xtc) return scenario != Scenario::Paginate && scenario != Scenario::Deserialize;
+  if (scenario == Scenario::Thumbnail) return book.format == Format::Epub || book.format == Format::Fb2;
+  return true;
+}
+
+// XTC pages are pre-rendered: first page and render load page bitmaps into a
+// framebuffer-sized buffer, the way XtcPageRenderer feeds the panel
+bool runXtc(papyrix::ContentHandle& handle, const Scenario scenario, Timer& timer, uint32_t& pages) {
+  xtc::XtcParser& parser = handle.asXtc()->getParser();
+  std::vector<uint8_t> frame(xtc::xtgBitmapSize(XTC_WIDTH, XTC_HEIGHT));
+  const uint32_t count = scenario == Scenario::FirstPage ? 1 : parser.getPageCount();
+  bool ok = true;
+  timer.start();
+  for (uint32_t i = 0; i < count; i++) ok = parser.loadPage(i, frame.data(), frame.size()) > 0 && ok;
+  timer.stop();
+  pages = count;
+  return ok;
+}
+
+// One timed run on a fresh SD card. Returns false when the scenario did not do
+// its work (open failed, no pages, no thumbnail) so broken numbers never ship.
+bool runOnce(Book& book, const Scenario scenario, Reader& reader, Timer& timer) {
+  resetSd(book);
+  papyrix::ContentHandle handle;
+
+  if (scenario == Scenario::Open) {
+    timer.start();
+    const bool opened = handle.open(book.path.c_str(), CACHE_DIR).ok();
+    timer.stop();
+    return opened;
+  }
+  if (!handle.open(book.path.c_str(), CACHE_DIR).ok()) return false;
+
+  if (scenario == Scenario::Thumbnail) {
+    timer.start();
+    const bool ready = handle.generateThumbnail(nullptr) == home_thumbnail::Result::Ready;
+    timer.stop();
+    return ready;
+  }
+  if (book.format == Format::Xtc) return runXtc(handle, scenario, timer, book.pages);
+
+  std::vector<std::unique_ptr<PageCache>> caches;
+  uint32_t pages = 0;
+  if (scenario == Scenario::FirstPage || scenario == Scenario::Paginate) {
+    timer.start();
+    const bool ok = paginate(handle, book, reader, scenario == Scenario::FirstPage ? 1 : 0, caches, pages);
+    timer.stop();
+    if (scenario == Scenario::Paginate) book.pages = pages;
+    return ok;
+  }
+
+  if (!paginate(handle, book, reader, 0, caches, pages)) return false;
+  std::vector<std::unique_ptr<Page>> loaded;
+  if (scenario == Scenario::Deserialize) timer.start();
+  for (auto& cache : caches) {
+    for (uint32_t p = 0; p < cache->pageCount(); p++) loaded.push_back(cache->loadPage(p));
+  }
+  if (scenario == Scenario::Deserialize) timer.stop();
+  for (const auto& page : loaded) {
+    if (!page) return false;
+  }
+
+  if (scenario == Scenario::Render) {
+    timer.start();
+    for (const auto& page : loaded) page->render(reader.gfx, reader.config.fontId, 0, 0);
+    timer.stop();
+  }
+  return true;
+}
+
+struct Result {
+  const Book* book;
+  Scenario scenario;
+  double medianMs;
+  double p95Ms;
+  double minMs;
+  uint64_t allocations;
+  uint64_t bytes;
+};
+
+double percentile(std::vector<double> values, const double pct) {
+  std::sort(values.begin(), values.end());
+  const size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * values.size()));
+  return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  const size_t mid = values.size() / 2;
+  return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+bool measure(Book& book, const Scenario scenario, Reader& reader, const int iterations, Result& result) {
+  std::vector<double> ms;
+  std::vector<double> allocations;
+  std::vector<double> bytes;
+  for (int i = -WARMUP_RUNS; i < iterations; i++) {
+    Timer timer;
+    if (!runOnce(book, scenario, reader, timer)) return false;
+    if (i < 0) continue;
+    ms.push_back(timer.sample.ms);
+    allocations.push_back(static_cast<double>(timer.sample.allocations));
+    bytes.push_back(static_cast<double>(timer.sample.bytes));
+  }
+  result = {&book,
+            scenario,
+            median(ms),
+            percentile(ms, 95),
+            *std::min_element(ms.begin(), ms.end()),
+            static_cast<uint64_t>(median(allocations)),
+            static_cast<uint64_t>(median(bytes))};
+  return true;
+}
+
+bool writeJson(const std::string& path, const std::vector<Book>& books, const std::vector<Result>& results,
+               const int iterations) {
+  FILE* out = std::fopen(path.c_str(), "w");
+  if (!out) return false;
+  std::fprintf(out, "{\n  \"bench\": \"ReaderBench\",\n  \"iterations\": %d,\n  \"books\": [\n", iterations);
+  for (size_t i = 0; i < books.size(); i++) {
+    std::fprintf(out, "    {\"name\": \"%s\", \"bytes\": %zu, \"pages\": %u}%s\n", books[i].name, books[i].data.size(),
+                 books[i].pages, i + 1 < books.size() ? "," : "");
+  }
+  std::fprintf(out, "  ],\n  \"results\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    std::fprintf(out,
+                 "    {\"book\": \"%s\", \"scenario\": \"%s\", \"median_ms\": %.4f, \"p95_ms\": %.4f, "
+                 "\"min_ms\": %.4f, \"allocations\": %llu, \"allocated_bytes\": %llu}%s\n",
+                 r.book->name, scenarioName(r.scenario), r.medianMs, r.p95Ms, r.minMs,
+                 static_cast<unsigned long long>(r.allocations), static_cast<unsigned long long>(r.bytes),
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+  return std::fclose(out) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 15;
+  std::string jsonPath;
+  std::string corpusDir = std::string(BENCH_DATA_DIR) + "/corpus";
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      iterations = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "-o" && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (arg[0] != '-') {
+      corpusDir = arg;
+    } else {
+      std::fprintf(stderr, "Usage: %s [-n iterations] [-o results.json] [corpus dir]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<Book> books;
+  if (!loadCorpus(corpusDir, books)) {
+    std::fprintf(stderr, "Cannot read corpus from %s\n", corpusDir.c_str());
+    return 1;
+  }
+
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  Reader reader{gfx, makeConfig()};
+
+  std::printf("ReaderBench: %d runs per scenario (+%d warmup)\n\n", iterations, WARMUP_RUNS);
+  std::printf("%-9s %-12s %11s %11s %9s %12s\n", "book", "scenario", "median ms", "p95 ms", "allocs", "alloc bytes");
+
+  std::vector<Result> results;
+  bool ok = true;
+  for (Book& book : books) {
+    for (int s = 0; s < static_cast<int>(Scenario::Count); s++) {
+      const auto scenario = static_cast<Scenario>(s);
+      if (!supported(book, scenario)) continue;
+      Result result{};
+      if (!measure(book, scenario, reader, iterations, result)) {
+        std::fprintf(stderr, "%s/%s failed\n", book.name, scenarioName(scenario));
+        ok = false;
+        continue;
+      }
+      std::printf("%-9s %-12s %11.3f %11.3f %9llu %12llu\n", book.name, scenarioName(scenario), result.medianMs,
+                  result.p95Ms, static_cast<unsigned long long>(result.allocations),
+                  static_cast<unsigned long long>(result.bytes));
+      results.push_back(result);
+    }
+  }
+
+  if (!jsonPath.empty()) {
+    if (!writeJson(jsonPath, books, results, iterations)) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+      return 1;
+    }
+    std::printf("\nResults written to %s\n", jsonPath.c_str());
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// Plain text layout throughput - PlainTextParser::parsePages over a generated
+// book in three encodings: ASCII, UTF-8 Cyrillic and Windows-1251 Cyrillic.
+// Reports MB/s of source text (best pass) and a page/word checksum, so a
+// change to the byte scanner can be checked for identical output.
+//
+// Usage: TxtParseBench [kilobytes] [passes]
+
+#include <EpdFont.h>
+#include <EpdFontFamily.h>
+#include <GfxRenderer.h>
+#include <Page.h>
+#include <ParsedText.h>
+#include <PlainTextParser.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+uint8_t GfxRenderer::frameBuffer_[EInkDisplay::BUFFER_SIZE];
+
+void ImageBlock::render(GfxRenderer&, int, int, int) const {}
+bool ImageBlock::serialize(FsFile&) const { return false; }
+std::unique_ptr<ImageBlock> ImageBlock::deserialize(FsFile&) { return nullptr; }
+
+namespace {
+
+constexpr int FONT_ID = 42;
+
+using Clock = std::chrono::steady_clock;
+
+// Fixed-width glyphs shared by ASCII (32-126) and Cyrillic (U+0400-U+045E)
+const std::vector<EpdGlyph> kGlyphs(95, EpdGlyph{6, 10, 7, 0, 10, 0, 0});
+const EpdUnicodeInterval kIntervals[] = {{32, 126, 0}, {0x400, 0x45E, 0}};
+const EpdFontData kFontData = {nullptr, kGlyphs.data(), kIntervals, 2, 14, 11, 3, false};
+
+const char* const kLatinWords[] = {"the",   "reader", "turned", "a",      "page",  "and",    "light",
+                                   "fell",  "across", "words",  "of",     "old",   "story,", "while",
+                                   "night", "slowly", "moved.", "Nobody", "spoke", "again."};
+// UTF-8
+const char* const kCyrillicWords[] = {
+    "\xD0\xB8",
+    "\xD0\xBE\xD0\xBD",
+    "\xD0\xBA\xD0\xBD\xD0\xB8\xD0\xB3\xD0\xB0",
+    "\xD1\x81\xD1\x82\xD1\x80\xD0\xB0\xD0\xBD\xD0\xB8\xD1\x86\xD0\xB0",
+    "\xD1\x81\xD0\xB2\xD0\xB5\xD1\x82",
+    "\xD0\xBD\xD0\xBE\xD1\x87\xD1\x8C\xD1\x8E,",
+    "\xD0\xBC\xD0\xB5\xD0\xB4\xD0\xBB\xD0\xB5\xD0\xBD\xD0\xBD\xD0\xBE",
+    "\xD0\xA1\xD0\xBB\xD0\xBE\xD0\xB2\xD0\xB0",
+    "\xD1\x82\xD0\xB8\xD1\x85\xD0\xBE.",
+    "\xD0\xB2",
+    "\xD1\x81\xD1\x82\xD0\xB0\xD1\x80\xD0\xBE\xD0\xB9",
+    "\xD0\xB8\xD1\x81\xD1\x82\xD0\xBE\xD1\x80\xD0\xB8\xD0\xB8",
+};
+
+// Paragraphs of 20-80 words separated by blank lines, about `bytes` long
+std::string makeBook(const char* const* words, const size_t wordCount, const size_t bytes) {
+  std::string text;
+  uint32_t seed = 12345;
+  while (text.size() < bytes) {
+    seed = seed * 1664525u + 1013904223u;
+    const int paragraphWords = 20 + static_cast<int>((seed >> 24) % 60);
+    for (int w = 0; w < paragraphWords; w++) {
+      seed = seed * 1664525u + 1013904223u;
+      if (w > 0) text += ' ';
+      text += words[(seed >> 16) % wordCount];
+    }
+    text += "\n\n";
+  }
+  return text;
+}
+
+// Cyrillic U+0410-U+044F and U+0401/U+0451 to Windows-1251
+std::string toCp1251(const std::string& utf8) {
+  std::string out;
+  for (size_t i = 0; i < utf8.size(); i++) {
+    const auto b = static_cast<uint8_t>(utf8[i]);
+    if (b < 0x80) {
+      out += static_cast<char>(b);
+      continue;
+    }
+    const int cp = ((b & 0x1F) << 6) | (static_cast<uint8_t>(utf8[++i]) & 0x3F);
+    if (cp >= 0x410 && cp <= 0x44F) {
+      out += static_cast<char>(0xC0 + (cp - 0x410));
+    } else if (cp == 0x401) {
+      out += static_cast<char>(0xA8);
+    } else if (cp == 0x451) {
+      out += static_cast<char>(0xB8);
+    }
+  }
+  return out;
+}
+
+struct Result {
+  double bestMs = 0;
+  uint32_t pages = 0;
+  uint32_t checksum = 0;
+};
+
+Result run(GfxRenderer& gfx, const RenderConfig& config, const std::string& path, const int passes) {
+  Result result;
+  for (int pass = 0; pass < passes; pass++) {
+    uint32_t pages = 0;
+    uint32_t checksum = 2166136261u;
+    auto onPage = [&](std::unique_ptr<Page> page) {
+      pages++;
+      for (auto& elem : page->elements) {
+        if (elem->getTag() != TAG_PageLine) continue;
+        for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) {
+          for (const char c : wd.word) checksum = (checksum ^ static_cast<uint8_t>(c)) * 16777619u;
+          checksum = (checksum ^ ' ') * 16777619u;
+        }
+      }
+    };
+
+    PlainTextParser parser(path, gfx, config);
+    const auto start = Clock::now();
+    parser.parsePages(onPage, 0);
+    while (parser.hasMoreContent()) parser.parsePages(onPage, 0);
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (pass == 0 || ms < result.bestMs) result.bestMs = ms;
+    result.pages = pages;
+    result.checksum = checksum;
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t kilobytes = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 1024;
+  const int passes = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+  if (kilobytes == 0) {
+    std::fprintf(stderr, "Usage: %s [kilobytes] [passes]\n", argv[0]);
+    return 1;
+  }
+
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  gfx.begin();
+  EpdFont font(&kFontData);
+  gfx.insertFont(FONT_ID, EpdFontFamily(&font, &font, &font, &font));
+
+  RenderConfig config;
+  config.fontId = FONT_ID;
+  config.viewportWidth = 464;
+  config.viewportHeight = 760;
+  config.paragraphAlignment = 0;
+  config.spacingLevel = 1;
+  config.lineCompression = 1.0f;
+  config.hyphenation = false;
+
+  const std::string cyrillic = makeBook(kCyrillicWords, sizeof(kCyrillicWords) / sizeof(kCyrillicWords[0]),
+                                        kilobytes * 1024);
+  const struct {
+    const char* name;
+    const char* path;
+    std::string text;
+  } inputs[] = {
+      {"ASCII", "/bench_ascii.txt",
+       makeBook(kLatinWords, sizeof(kLatinWords) / sizeof(kLatinWords[0]), kilobytes * 1024)},
+      {"UTF-8 Cyrillic", "/bench_utf8.txt", cyrillic},
+      {"CP1251 Cyrillic", "/bench_cp1251.txt", toCp1251(cyrillic)},
+  };
+
+  std::printf("PlainTextParser::parsePages, %zu KB per input, best of %d\n\n", kilobytes, passes);
+  std::printf("%-16s %10s %10s %8s %10s\n", "input", "bytes", "ms", "MB/s", "pages");
+  for (const auto& input : inputs) {
+    SdMan.registerFile(input.path, input.text);
+    const Result r = run(gfx, config, input.path, passes);
+    const double mbps = (static_cast<double>(input.text.size()) / (1024.0 * 1024.0)) / (r.bestMs / 1000.0);
+    std::printf("%-16s %10zu %10.1f %8.2f %10u  checksum %08x\n", input.name, input.text.size(), r.bestMs, mbps,
+                r.pages, r.checksum);
+  }
+  return 0;
+}
@@ -0,0 +1,284 @@
+// XML name dispatch benchmark - Expat parse of a large generated chapter with
+// the tag/attribute classification ChapterHtmlSlimParser does per element:
+// strcmp() tables (previous implementation) vs. XmlNames perfect hash + switch.
+//
+// Usage: XmlDispatchBench [paragraphs] [iterations]
+
+#include <XmlNames.h>
+#include <expat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+// Previous implementation: linear strcmp over tag arrays, three attribute passes
+namespace strcmp_dispatch {
+
+const char* HEADER_TAGS[] = {"h1", "h2", "h3", "h4", "h5", "h6"};
+const char* BLOCK_TAGS[] = {"p", "li", "div", "br", "blockquote", "question", "answer", "quotation", "pre"};
+const char* BOLD_TAGS[] = {"b", "strong"};
+const char* ITALIC_TAGS[] = {"i", "em", "code", "tt", "kbd", "samp"};
+
+template <size_t N>
+bool matches(const char* name, const char* (&tags)[N]) {
+  for (size_t i = 0; i < N; i++) {
+    if (strcmp(name, tags[i]) == 0) return true;
+  }
+  return false;
+}
+
+uint32_t classify(const char* name, const char** atts) {
+  uint32_t bits = 0;
+  if (strcmp(name, "img") == 0) bits |= 1;
+  if (strcmp(name, "table") == 0) bits |= 2;
+  if (strcmp(name, "head") == 0) bits |= 4;
+  for (int i = 0; atts[i]; i += 2) {
+    if ((strcmp(atts[i], "role") == 0 && strcmp(atts[i + 1], "doc-pagebreak") == 0) ||
+        (strcmp(atts[i], "epub:type") == 0 && strcmp(atts[i + 1], "pagebreak") == 0)) {
+      bits |= 8;
+    }
+  }
+  if (strcmp(name, "a") == 0) {
+    for (int i = 0; atts[i]; i += 2) {
+      if (strcmp(atts[i], "aria-hidden") == 0 && strcmp(atts[i + 1], "true") == 0) bits |= 16;
+    }
+  }
+  for (int i = 0; atts[i]; i += 2) {
+    if (strcmp(atts[i], "class") == 0) {
+      bits |= 32;
+    } else if (strcmp(atts[i], "style") == 0) {
+      bits |= 64;
+    } else if (strcmp(atts[i], "dir") == 0) {
+      bits |= 128;
+    } else if (strcmp(atts[i], "id") == 0) {
+      bits |= 256;
+    }
+  }
+  if (matches(name, HEADER_TAGS)) {
+    bits |= 512;
+  } else if (matches(name, BLOCK_TAGS)) {
+    bits |= 1024;
+  } else if (matches(name, BOLD_TAGS)) {
+    bits |= 2048;
+  } else if (matches(name, ITALIC_TAGS)) {
+    bits |= 4096;
+  } else if (strcmp(name, "ul") == 0 || strcmp(name, "ol") == 0) {
+    bits |= 8192;
+  }
+  return bits;
+}
+
+uint32_t classifyEnd(const char* name) {
+  return (matches(name, BLOCK_TAGS) || matches(name, HEADER_TAGS) || matches(name, BOLD_TAGS) ||
+          matches(name, ITALIC_TAGS))
+             ? 1
+             : 0;
+}
+
+}  // namespace strcmp_dispatch
+
+// Current implementation: one hash per name, switch on the ID
+namespace hash_dispatch {
+
+uint32_t classify(const char* name, const char** atts) {
+  uint32_t bits = 0;
+  const XmlName tag = lookupXmlName(name);
+  for (int i = 0; atts[i]; i += 2) {
+    switch (lookupXmlName(atts[i])) {
+      case XmlName::Role:
+        if (strcmp(atts[i + 1], "doc-pagebreak") == 0) bits |= 8;
+        break;
+      case XmlName::EpubType:
+        if (strcmp(atts[i + 1], "pagebreak") == 0) bits |= 8;
+        break;
+      case XmlName::AriaHidden:
+        if (tag == XmlName::A && strcmp(atts[i + 1], "true") == 0) bits |= 16;
+        break;
+      case XmlName::Class:
+        bits |= 32;
+        break;
+      case XmlName::Style:
+        bits |= 64;
+        break;
+      case XmlName::Dir:
+        bits |= 128;
+        break;
+      case XmlName::Id:
+        bits |= 256;
+        break;
+      default:
+        break;
+    }
+  }
+  switch (tag) {
+    case XmlName::Img:
+      return bits | 1;
+    case XmlName::Table:
+      return bits | 2;
+    case XmlName::Head:
+      return bits | 4;
+    case XmlName::H1:
+    case XmlName::H2:
+    case XmlName::H3:
+    case XmlName::H4:
+    case XmlName::H5:
+    case XmlName::H6:
+      return bits | 512;
+    case XmlName::P:
+    case XmlName::Li:
+    case XmlName::Div:
+    case XmlName::Br:
+    case XmlName::Blockquote:
+    case XmlName::Question:
+    case XmlName::Answer:
+    case XmlName::Quotation:
+    case XmlName::Pre:
+      return bits | 1024;
+    case XmlName::B:
+    case XmlName::Strong:
+      return bits | 2048;
+    case XmlName::I:
+    case XmlName::Em:
+    case XmlName::Code:
+    case XmlName::Tt:
+    case XmlName::Kbd:
+    case XmlName::Samp:
+      return bits | 4096;
+    case XmlName::Ul:
+    case XmlName::Ol:
+      return bits | 8192;
+    default:
+      return bits;
+  }
+}
+
+uint32_t classifyEnd(const char* name) {
+  switch (lookupXmlName(name)) {
+    case XmlName::H1:
+    case XmlName::H2:
+    case XmlName::H3:
+    case XmlName::H4:
+    case XmlName::H5:
+    case XmlName::H6:
+    case XmlName::P:
+    case XmlName::Li:
+    case XmlName::Div:
+    case XmlName::Br:
+    case XmlName::Blockquote:
+    case XmlName::Question:
+    case XmlName::Answer:
+    case XmlName::Quotation:
+    case XmlName::Pre:
+    case XmlName::B:
+    case XmlName::Strong:
+    case XmlName::I:
+    case XmlName::Em:
+    case XmlName::Code:
+    case XmlName::Tt:
+    case XmlName::Kbd:
+    case XmlName::Samp:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace hash_dispatch
+
+struct Counters {
+  size_t elements = 0;
+  uint32_t sink = 0;
+};
+
+void XMLCALL noopStart(void* userData, const XML_Char*, const XML_Char**) {
+  static_cast<Counters*>(userData)->elements++;
+}
+void XMLCALL noopEnd(void*, const XML_Char*) {}
+
+void XMLCALL strcmpStart(void* userData, const XML_Char* name, const XML_Char** atts) {
+  auto* c = static_cast<Counters*>(userData);
+  c->elements++;
+  c->sink += strcmp_dispatch::classify(name, atts);
+}
+void XMLCALL strcmpEnd(void* userData, const XML_Char* name) {
+  static_cast<Counters*>(userData)->sink += strcmp_dispatch::classifyEnd(name);
+}
+
+void XMLCALL hashStart(void* userData, const XML_Char* name, const XML_Char** atts) {
+  auto* c = static_cast<Counters*>(userData);
+  c->elements++;
+  c->sink += hash_dispatch::classify(name, atts);
+}
+void XMLCALL hashEnd(void* userData, const XML_Char* name) {
+  static_cast<Counters*>(userData)->sink += hash_dispatch::classifyEnd(name);
+}
+
+// Chapter mixing the tags a typical converted novel uses (span-heavy, classed paragraphs)
+std::string buildChapter(const int paragraphs) {
+  std::string out =
+      "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+      "<html xmlns=\"http://www.w3.org/1999/xhtml\" xmlns:epub=\"http://www.idpf.org/2007/ops\">\n"
+      "<head><title>Chapter</title><link rel=\"stylesheet\" type=\"text/css\" href=\"style.css\"/></head>\n"
+      "<body class=\"calibre\"><section epub:type=\"chapter\" id=\"ch3\">\n"
+      "<h2 class=\"chapter-title\"><span class=\"label\">Chapter Three</span></h2>\n";
+  for (int i = 0; i < paragraphs; i++) {
+    out += i % 9 == 0 ? "<p class=\"calibre3\">" : "<p class=\"calibre1\" dir=\"ltr\">";
+    out += "The <em>quick</em> brown <span class=\"smallcaps\">fox</span> jumps over the lazy dog";
+    if (i % 5 == 0) out += "<a href=\"notes.xhtml#n1\" id=\"r1\" class=\"noteref\"><sup>1</sup></a>";
+    if (i % 7 == 0) out += " and <i class=\"foreign\" xml:lang=\"fr\">voil\xC3\xA0</i>";
+    if (i % 11 == 0) out += "<br/>said <strong>nobody</strong>";
+    out += ".</p>\n";
+    if (i % 50 == 49) out += "<div class=\"scene-break\" role=\"separator\"><img src=\"orn.png\" alt=\"\"/></div>\n";
+    if (i % 120 == 60) {
+      out += "<blockquote class=\"verse\"><div>";
+      for (int line = 0; line < 4; line++) out += "<p class=\"i2\" style=\"margin:0\">A line of verse</p>";
+      out += "</div></blockquote>\n";
+    }
+  }
+  out += "</section></body></html>\n";
+  return out;
+}
+
+double runParse(const std::string& xml, const int iterations, XML_StartElementHandler start,
+                XML_EndElementHandler end, Counters& counters) {
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int it = 0; it < iterations; it++) {
+    XML_Parser parser = XML_ParserCreate(nullptr);
+    XML_SetUserData(parser, &counters);
+    XML_SetElementHandler(parser, start, end);
+    if (XML_Parse(parser, xml.data(), static_cast<int>(xml.size()), XML_TRUE) == XML_STATUS_ERROR) {
+      std::fprintf(stderr, "parse error: %s\n", XML_ErrorString(XML_GetErrorCode(parser)));
+    }
+    XML_ParserFree(parser);
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int paragraphs = argc > 1 ? std::atoi(argv[1]) : 4000;
+  const int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  const std::string xml = buildChapter(paragraphs);
+
+  Counters noop, viaStrcmp, viaHash;
+  const double noopSec = runParse(xml, iterations, noopStart, noopEnd, noop);
+  const double strcmpSec = runParse(xml, iterations, strcmpStart, strcmpEnd, viaStrcmp);
+  const double hashSec = runParse(xml, iterations, hashStart, hashEnd, viaHash);
+
+  const double elements = static_cast<double>(noop.elements);
+  std::printf("chapter:           %zu bytes, %zu elements x %d iterations\n", xml.size(),
+              noop.elements / static_cast<size_t>(iterations), iterations);
+  std::printf("expat only:        %.2f M elements/s\n", elements / noopSec / 1e6);
+  std::printf("strcmp dispatch:   %.2f M elements/s (%.1f ns/element over parse)\n", elements / strcmpSec / 1e6,
+              (strcmpSec - noopSec) * 1e9 / elements);
+  std::printf("hash dispatch:     %.2f M elements/s (%.1f ns/element over parse)\n", elements / hashSec / 1e6,
+              (hashSec - noopSec) * 1e9 / elements);
+  std::printf("checksum:          %u %u\n", viaStrcmp.sink, viaHash.sink);
+  return 0;
+}
@@ -0,0 +1,189 @@
+// XTC 1-bit page rendering benchmark - renders every page of a 500-page
+// 480x800 XTC book three ways: the old per-pixel drawPixel() loop, the 8x8
+// transpose blit streamed from SD, and the blit fed by the next-page prefetch.
+//
+// Usage: XtcRenderBench [pages] [passes]
+//
+// The book is generated in memory (text-like line patterns) and served by the
+// SD mock, so SD time here is a memcpy; on the device the prefetch also takes
+// the ~48KB page read off the page-turn path. "to refresh" is the time until
+// the panel refresh would start, "total" includes the prefetch that follows.
+
+#include "test_utils.h"
+
+#include <GfxRenderer.h>
+#include <SDCardManager.h>
+#include <Xtc/XtcParser.h>
+#include <Xtc/XtcTypes.h>
+#include <XtcPageRenderer.h>
+#include <platform_stubs.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint16_t PAGE_WIDTH = 480;
+constexpr uint16_t PAGE_HEIGHT = 800;
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(const Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Lines of "words": black runs on a white page with margins, ~10% ink like a text page
+void fillTextPage(uint8_t* bitmap, const size_t rowBytes, uint32_t seed) {
+  memset(bitmap, 0xFF, rowBytes * PAGE_HEIGHT);
+  for (int lineTop = 40; lineTop + 24 < PAGE_HEIGHT - 40; lineTop += 32) {
+    int x = 24;
+    while (x < PAGE_WIDTH - 24) {
+      seed = seed * 1664525u + 1013904223u;
+      const int wordWidth = 12 + static_cast<int>((seed >> 24) % 60);
+      for (int y = lineTop + 4; y < lineTop + 22; y++) {
+        for (int dx = 0; dx < wordWidth && x + dx < PAGE_WIDTH - 24; dx++) {
+          // Vertical strokes, so bytes are mixed rather than solid
+          if (((dx + y) % 3) == 0) bitmap[y * rowBytes + (x + dx) / 8] &= ~(0x80 >> ((x + dx) % 8));
+        }
+      }
+      x += wordWidth + 8;
+    }
+  }
+}
+
+std::string buildBook(const size_t pageCount) {
+  constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+  const size_t pageDataOffset = pageTableOffset + pageCount * sizeof(xtc::PageTableEntry);
+  const size_t rowBytes = (PAGE_WIDTH + 7) / 8;
+  const size_t bitmapSize = xtc::xtgBitmapSize(PAGE_WIDTH, PAGE_HEIGHT);
+  const size_t pageSize = sizeof(xtc::XtgPageHeader) + bitmapSize;
+
+  std::string file(pageDataOffset + pageCount * pageSize, '\0');
+  auto* data = reinterpret_cast<uint8_t*>(&file[0]);
+  auto* header = reinterpret_cast<xtc::XtcHeader*>(data);
+  header->magic = xtc::XTC_MAGIC;
+  header->versionMajor = 1;
+  header->pageCount = static_cast<uint16_t>(pageCount);
+  header->pageTableOffset = pageTableOffset;
+  header->dataOffset = pageDataOffset;
+
+  for (size_t i = 0; i < pageCount; i++) {
+    const size_t offset = pageDataOffset + i * pageSize;
+    auto* entry = reinterpret_cast<xtc::PageTableEntry*>(data + pageTableOffset + i * sizeof(xtc::PageTableEntry));
+    entry->dataOffset = offset;
+    entry->dataSize = pageSize;
+    entry->width = PAGE_WIDTH;
+    entry->height = PAGE_HEIGHT;
+
+    auto* pageHeader = reinterpret_cast<xtc::XtgPageHeader*>(data + offset);
+    pageHeader->magic = xtc::XTG_MAGIC;
+    pageHeader->width = PAGE_WIDTH;
+    pageHeader->height = PAGE_HEIGHT;
+    pageHeader->dataSize = bitmapSize;
+    fillTextPage(data + offset + sizeof(*pageHeader), rowBytes, static_cast<uint32_t>(i) * 2654435761u);
+  }
+  return file;
+}
+
+// The renderer's previous 1-bit path: stream 4KB chunks, one drawPixel() per black bit
+bool renderPerPixel(GfxRenderer& gfx, xtc::XtcParser& parser, const uint32_t pageNum) {
+  const size_t rowBytes = (PAGE_WIDTH + 7) / 8;
+  gfx.clearScreen();
+  return parser.loadPageStreaming(
+             pageNum,
+             [&](const uint8_t* data, const size_t size, const size_t offset) {
+               for (size_t i = 0; i < size; ++i) {
+                 const uint8_t byte = data[i];
+                 if (byte == 0xFF) continue;
+                 const uint16_t y = static_cast<uint16_t>((offset + i) / rowBytes);
+                 const uint16_t baseX = static_cast<uint16_t>(((offset + i) % rowBytes) * 8);
+                 for (uint8_t bit = 0; bit < 8; ++bit) {
+                   if ((byte & (0x80U >> bit)) == 0) gfx.drawPixel(baseX + bit, y, true);
+                 }
+               }
+               return true;
+             },
+             4096) == xtc::XtcError::OK;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t pageCount = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 500;
+  const int passes = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+  if (pageCount == 0 || pageCount > xtc::MAX_XTC_PAGE_COUNT) {
+    std::fprintf(stderr, "Usage: %s [pages (1-%u)] [passes]\n", argv[0], xtc::MAX_XTC_PAGE_COUNT);
+    return 1;
+  }
+
+  const std::string book = buildBook(pageCount);
+  SdMan.registerFile("/bench.xtc", book);
+
+  EInkDisplay referenceDisplay(0, 0, 0, 0, 0, 0);
+  GfxRenderer referenceGfx(referenceDisplay);
+  referenceGfx.begin();
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  gfx.begin();
+
+  xtc::XtcParser referenceParser;
+  xtc::XtcParser parser;
+  if (referenceParser.open("/bench.xtc") != xtc::XtcError::OK || parser.open("/bench.xtc") != xtc::XtcError::OK) {
+    std::fprintf(stderr, "Cannot open generated book\n");
+    return 1;
+  }
+
+  // Per-pixel baseline
+  auto start = Clock::now();
+  for (int pass = 0; pass < passes; pass++) {
+    for (uint32_t page = 0; page < pageCount; page++) renderPerPixel(referenceGfx, referenceParser, page);
+  }
+  const double perPixelMs = msSince(start);
+
+  // Transpose blit, prefetch off (heap below the prefetch reserve) and on
+  struct Run {
+    const char* name;
+    bool prefetch;
+    double toRefreshMs = 0;
+    double totalMs = 0;
+    size_t mismatches = 0;
+  } runs[] = {{"blit, streamed", false}, {"blit + prefetch", true}};
+
+  for (auto& run : runs) {
+    papyrix::XtcPageRenderer renderer(gfx);
+    if (!run.prefetch) testSetLargestFreeBlock(papyrix::XtcPageRenderer::PREFETCH_HEAP_RESERVE);
+    for (int pass = 0; pass < passes; pass++) {
+      for (uint32_t page = 0; page < pageCount; page++) {
+        Clock::time_point refreshAt;
+        start = Clock::now();
+        renderer.render(parser, page, [&](papyrix::XtcPageRenderer::RefreshRequest) { refreshAt = Clock::now(); });
+        run.totalMs += msSince(start);
+        run.toRefreshMs += std::chrono::duration<double, std::milli>(refreshAt - start).count();
+
+        if (pass == 0) {
+          renderPerPixel(referenceGfx, referenceParser, page);
+          if (memcmp(referenceGfx.getFrameBuffer(), gfx.getFrameBuffer(), gfx.getBufferSize()) != 0) {
+            run.mismatches++;
+          }
+        }
+      }
+    }
+    testResetLargestFreeBlock();
+  }
+
+  const double renders = static_cast<double>(pageCount) * passes;
+  std::printf("book:              %zu pages, %ux%u 1-bit, %.1f MB\n", pageCount, PAGE_WIDTH, PAGE_HEIGHT,
+              book.size() / (1024.0 * 1024.0));
+  std::printf("passes:            %d\n", passes);
+  std::printf("per-pixel:         %.3f ms/page\n", perPixelMs / renders);
+  for (const auto& run : runs) {
+    std::printf("%-18s %.3f ms/page to refresh, %.3f ms/page total (%zu pages differ from per-pixel)\n",
+                (std::string(run.name) + ":").c_str(), run.toRefreshMs / renders, run.totalMs / renders,
+                run.mismatches);
+  }
+  return runs[0].mismatches == 0 && runs[1].mismatches == 0 ? 0 : 1;
+}
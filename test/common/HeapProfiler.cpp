@@ -0,0 +1,464 @@
+#include "HeapProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<execinfo.h>) && __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define HEAP_PROFILER_BACKTRACE 1
+#else
+#define HEAP_PROFILER_BACKTRACE 0
+#endif
+
+namespace HeapProfiler {
+
+namespace {
+constexpr uint32_t ALIGN = 4;
+constexpr uint32_t SL_INDEX_COUNT_LOG2 = 5;  // TLSF: 32 second-level classes per power of two
+constexpr uint32_t SMALL_BLOCK = 1u << (SL_INDEX_COUNT_LOG2 + 2);
+constexpr size_t MAX_FRAMES = 12;
+constexpr size_t MAX_PHASE_DEPTH = 16;
+constexpr size_t TIMELINE_STEP = 1024;
+constexpr size_t PHASES = static_cast<size_t>(Phase::Count);
+
+uint32_t floorLog2(const uint32_t v) { return 31 - static_cast<uint32_t>(__builtin_clz(v)); }
+}  // namespace
+
+const char* phaseName(const Phase phase) {
+  static constexpr const char* NAMES[] = {"other", "open", "parse", "layout", "serialize", "render"};
+  static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == PHASES, "Every phase needs a name");
+  return phase < Phase::Count ? NAMES[static_cast<size_t>(phase)] : "unknown";
+}
+
+// ---------------------------------------------------------------------------
+// SimHeap
+// ---------------------------------------------------------------------------
+
+SimHeap::SimHeap(const size_t capacity) : capacity_(capacity & ~size_t(ALIGN - 1)) {
+  if (capacity_ >= MIN_BLOCK) insertFree(0, static_cast<uint32_t>(capacity_));
+}
+
+uint32_t SimHeap::blockSize(const size_t request) {
+  const size_t aligned = (request + ALIGN - 1) & ~size_t(ALIGN - 1);
+  return static_cast<uint32_t>(std::max<size_t>(MIN_BLOCK, aligned + HEADER));
+}
+
+uint32_t SimHeap::searchSize(const uint32_t block) {
+  if (block < SMALL_BLOCK) return block;
+  // Round up to the next class boundary so any block in the class found fits
+  const uint32_t round = (1u << (floorLog2(block) - SL_INDEX_COUNT_LOG2)) - 1;
+  return (block + round) & ~round;
+}
+
+int64_t SimHeap::alloc(const size_t size) {
+  if (size >= capacity_) return -1;
+  const uint32_t block = blockSize(size);
+  const auto found = bySize_.lower_bound({searchSize(block), 0});
+  if (found == bySize_.end()) return -1;
+
+  const uint32_t offset = found->second;
+  const uint32_t available = found->first;
+  eraseFree(byOffset_.find(offset));
+
+  uint32_t taken = available;
+  if (available - block >= MIN_BLOCK) {
+    taken = block;
+    insertFree(offset + block, available - block);
+  }
+  allocated_[offset] = taken;
+  used_ += taken;
+  return offset;
+}
+
+void SimHeap::free(const uint32_t offset) {
+  const auto live = allocated_.find(offset);
+  if (live == allocated_.end()) return;
+  uint32_t start = offset;
+  uint32_t size = live->second;
+  used_ -= size;
+  allocated_.erase(live);
+
+  // Coalesce with the free neighbours on either side
+  const auto next = byOffset_.find(offset + size);
+  if (next != byOffset_.end()) {
+    size += next->second;
+    eraseFree(next);
+  }
+  const auto after = byOffset_.lower_bound(offset);
+  if (after != byOffset_.begin()) {
+    const auto prev = std::prev(after);
+    if (prev->first + prev->second == offset) {
+      start = prev->first;
+      size += prev->second;
+      eraseFree(prev);
+    }
+  }
+  insertFree(start, size);
+}
+
+void SimHeap::insertFree(const uint32_t offset, const uint32_t size) {
+  byOffset_[offset] = size;
+  bySize_.insert({size, offset});
+}
+
+void SimHeap::eraseFree(const std::map<uint32_t, uint32_t>::iterator it) {
+  bySize_.erase({it->second, it->first});
+  byOffset_.erase(it);
+}
+
+size_t SimHeap::largestFreeBlock() const { return bySize_.empty() ? 0 : bySize_.rbegin()->first - HEADER; }
+
+// ---------------------------------------------------------------------------
+// Profiler
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Stack {
+  void* frames[MAX_FRAMES];
+  uint8_t depth;
+
+  bool operator==(const Stack& other) const {
+    return depth == other.depth && memcmp(frames, other.frames, depth * sizeof(void*)) == 0;
+  }
+};
+
+struct StackHash {
+  size_t operator()(const Stack& stack) const {
+    size_t hash = stack.depth;
+    for (uint8_t i = 0; i < stack.depth; i++) {
+      hash = hash * 31 + reinterpret_cast<uintptr_t>(stack.frames[i]);
+    }
+    return hash;
+  }
+};
+
+struct Live {
+  uint32_t offset;
+};
+
+struct SiteStats {
+  uint32_t allocations = 0;
+  uint32_t failed = 0;
+  uint64_t bytes = 0;  // Requested, failed requests included
+};
+
+struct Sample {
+  uint64_t sequence;
+  Phase phase;
+  size_t used;
+  size_t largestFreeBlock;
+};
+
+struct State {
+  std::mutex mutex;
+  SimHeap heap;
+  std::unordered_map<void*, Live> live;
+  std::unordered_map<Stack, uint32_t, StackHash> stackIds;
+  std::vector<Stack> stacks;
+  std::unordered_map<uint64_t, SiteStats> sites;  // (stack id << 8) | phase
+  Stats totals;
+  bool phaseSeen[PHASES] = {};
+  Phase base = Phase::Other;
+  Phase nested[MAX_PHASE_DEPTH] = {};
+  size_t depth = 0;
+  uint64_t sequence = 0;
+  std::vector<Sample> timeline;
+
+  void reset(const size_t capacity) {
+    heap = SimHeap(capacity);
+    live.clear();
+    stackIds.clear();
+    stacks.clear();
+    sites.clear();
+    totals = Stats{};
+    totals.capacity = heap.capacity();
+    totals.minLargestFreeBlock = heap.largestFreeBlock();
+    std::fill(std::begin(phaseSeen), std::end(phaseSeen), false);
+    base = Phase::Other;
+    depth = 0;
+    sequence = 0;
+    timeline.clear();
+  }
+
+  Phase phase() const { return depth > 0 ? nested[depth - 1] : base; }
+};
+
+// Never destroyed: frees keep arriving while static destructors run
+State* state = nullptr;
+std::atomic<bool> running{false};
+thread_local bool inProfiler = false;
+
+// Allocations made by the profiler itself pass through untracked
+class Guard {
+ public:
+  Guard() : wasInside_(inProfiler) { inProfiler = true; }
+  ~Guard() { inProfiler = wasInside_; }
+
+ private:
+  bool wasInside_;
+};
+
+// Called with the mutex held after every change to the heap or phase
+void observe(State& s) {
+  const Phase phase = s.phase();
+  const size_t used = s.heap.used();
+  const size_t largest = s.heap.largestFreeBlock();
+  s.totals.peakUsed = std::max(s.totals.peakUsed, used);
+  s.totals.minLargestFreeBlock = std::min(s.totals.minLargestFreeBlock, largest);
+
+  const size_t index = static_cast<size_t>(phase);
+  PhaseStats& stats = s.totals.phases[index];
+  stats.peakUsed = std::max(stats.peakUsed, used);
+  stats.minLargestFreeBlock = s.phaseSeen[index] ? std::min(stats.minLargestFreeBlock, largest) : largest;
+  s.phaseSeen[index] = true;
+
+  if (!s.timeline.empty()) {
+    const Sample& last = s.timeline.back();
+    const auto moved = [](const size_t a, const size_t b) { return (a > b ? a - b : b - a) >= TIMELINE_STEP; };
+    if (last.phase == phase && !moved(last.used, used) && !moved(last.largestFreeBlock, largest)) return;
+  }
+  s.timeline.push_back({s.sequence, phase, used, largest});
+}
+
+uint32_t captureStack(State& s) {
+  Stack stack{};
+#if HEAP_PROFILER_BACKTRACE
+  // Skip this function and onAlloc; the hooks are filtered by name when reporting
+  void* frames[MAX_FRAMES + 2];
+  const int depth = backtrace(frames, static_cast<int>(MAX_FRAMES + 2));
+  for (int i = 2; i < depth; i++) stack.frames[stack.depth++] = frames[i];
+#endif
+  const auto it = s.stackIds.find(stack);
+  if (it != s.stackIds.end()) return it->second;
+  const auto id = static_cast<uint32_t>(s.stacks.size());
+  s.stacks.push_back(stack);
+  s.stackIds.emplace(stack, id);
+  return id;
+}
+
+#if HEAP_PROFILER_BACKTRACE
+bool isAllocatorFrame(const std::string& name) {
+  static constexpr const char* PREFIXES[] = {"operator new", "std::",   "__gnu_cxx::", "HeapProfiler::", "__wrap_",
+                                             "__real_",      "__cxa_",  "__libc_",     "malloc",         "calloc",
+                                             "realloc",      "strdup",  "strndup"};
+  for (const char* prefix : PREFIXES) {
+    if (name.compare(0, strlen(prefix), prefix) == 0) return true;
+  }
+  return false;
+}
+
+// Function name, or module+offset for symbols the executable does not export
+// (resolve those with addr2line -f -e <module> <offset>)
+std::string symbolize(void* address) {
+  Dl_info info{};
+  const auto pc = reinterpret_cast<uintptr_t>(address) - 1;  // Inside the call, not after it
+  if (!dladdr(reinterpret_cast<void*>(pc), &info) || !info.dli_fname) return "?";
+  if (info.dli_sname) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+    ::free(demangled);
+    name = name.substr(0, name.find('('));
+    // Template functions demangle with their return type first: "void std::list<...>::_M_insert<...>"
+    while (name.compare(0, 8, "operator") != 0) {
+      const size_t space = name.find(' ');
+      if (space == std::string::npos || space > name.find('<') || space > name.find("::")) break;
+      name.erase(0, space + 1);
+    }
+    return name;
+  }
+  const char* module = strrchr(info.dli_fname, '/');
+  char label[256];
+  snprintf(label, sizeof(label), "%s+0x%lx", module ? module + 1 : info.dli_fname,
+           static_cast<unsigned long>(pc - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+  return label;
+}
+#endif
+
+// First frame outside the allocator, standard library and profiler
+std::string siteLabel(const Stack& stack, std::unordered_map<void*, std::string>& cache) {
+#if HEAP_PROFILER_BACKTRACE
+  std::string fallback = "?";
+  for (uint8_t i = 0; i < stack.depth; i++) {
+    auto it = cache.find(stack.frames[i]);
+    if (it == cache.end()) it = cache.emplace(stack.frames[i], symbolize(stack.frames[i])).first;
+    if (!isAllocatorFrame(it->second)) return it->second;
+    fallback = it->second;
+  }
+  return fallback;
+#else
+  (void)stack;
+  (void)cache;
+  return "?";
+#endif
+}
+
+}  // namespace
+
+void start(const size_t capacity) {
+  Guard guard;
+  if (!state) state = new State();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->reset(capacity > 0 ? capacity : DEFAULT_CAPACITY);
+  running.store(true, std::memory_order_release);
+}
+
+void stop() { running.store(false, std::memory_order_release); }
+
+bool active() { return running.load(std::memory_order_acquire); }
+
+void setPhase(const Phase phase) {
+  if (!state) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->base = phase;
+  if (active()) observe(*state);
+}
+
+void pushPhase(const Phase phase) {
+  if (!state) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (state->depth < MAX_PHASE_DEPTH) state->nested[state->depth] = phase;
+  state->depth++;
+  if (active()) observe(*state);
+}
+
+void popPhase() {
+  if (!state) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (state->depth > 0) state->depth--;
+  if (active()) observe(*state);
+}
+
+Phase currentPhase() {
+  if (!state) return Phase::Other;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->phase();
+}
+
+Stats stats() {
+  if (!state) return Stats{};
+  std::lock_guard<std::mutex> lock(state->mutex);
+  Stats out = state->totals;
+  out.used = state->heap.used();
+  out.largestFreeBlock = state->heap.largestFreeBlock();
+  out.freeBlocks = state->heap.freeBlockCount();
+  out.liveAllocations = static_cast<uint32_t>(state->live.size());
+  return out;
+}
+
+void onAlloc(void* ptr, const size_t size) {
+  if (!ptr || inProfiler || !active()) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  State& s = *state;
+  s.sequence++;
+  const Phase phase = s.phase();
+  PhaseStats& phaseStats = s.totals.phases[static_cast<size_t>(phase)];
+  SiteStats& site = s.sites[(static_cast<uint64_t>(captureStack(s)) << 8) | static_cast<uint8_t>(phase)];
+
+  site.bytes += size;
+  const int64_t offset = s.heap.alloc(size);
+  if (offset < 0) {
+    // The host allocation succeeded; the device one would not have
+    phaseStats.failed++;
+    site.failed++;
+    return;
+  }
+  phaseStats.allocations++;
+  phaseStats.bytes += size;
+  site.allocations++;
+  s.live[ptr] = {static_cast<uint32_t>(offset)};
+  observe(s);
+}
+
+void onFree(void* ptr) {
+  if (!ptr || inProfiler || !active()) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  State& s = *state;
+  const auto it = s.live.find(ptr);
+  if (it == s.live.end()) return;  // Allocated before start() or while the profiler was busy
+  s.sequence++;
+  s.heap.free(it->second.offset);
+  s.live.erase(it);
+  observe(s);
+}
+
+void report(FILE* out, const size_t topSites) {
+  if (!state) return;
+  Guard guard;
+  const Stats totals = stats();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  const State& s = *state;
+
+  uint32_t failed = 0;
+  for (const auto& phase : totals.phases) failed += phase.failed;
+  fprintf(out, "Heap profile: %zu byte simulated heap\n", totals.capacity);
+  fprintf(out, "  peak used %zu bytes (%zu%%), %zu live allocations, %u failed\n", totals.peakUsed,
+          totals.capacity ? totals.peakUsed * 100 / totals.capacity : 0, static_cast<size_t>(totals.liveAllocations),
+          failed);
+  fprintf(out, "  largest free block %zu bytes now, %zu at worst, %zu free blocks\n\n", totals.largestFreeBlock,
+          totals.minLargestFreeBlock, totals.freeBlocks);
+
+  fprintf(out, "  %-10s %10s %8s %12s %10s %12s\n", "phase", "allocs", "failed", "bytes", "peak", "min largest");
+  for (size_t i = 0; i < PHASES; i++) {
+    const PhaseStats& phase = totals.phases[i];
+    if (!s.phaseSeen[i] && phase.failed == 0) continue;
+    fprintf(out, "  %-10s %10u %8u %12llu %10zu %12zu\n", phaseName(static_cast<Phase>(i)), phase.allocations,
+            phase.failed, static_cast<unsigned long long>(phase.bytes), phase.peakUsed, phase.minLargestFreeBlock);
+  }
+
+  // Sites are grouped by the first frame outside the allocator and std::
+  std::unordered_map<void*, std::string> symbols;
+  for (size_t i = 0; i < PHASES; i++) {
+    std::unordered_map<std::string, SiteStats> bySite;
+    for (const auto& entry : s.sites) {
+      if ((entry.first & 0xFF) != i) continue;
+      SiteStats& merged = bySite[siteLabel(s.stacks[entry.first >> 8], symbols)];
+      merged.allocations += entry.second.allocations;
+      merged.failed += entry.second.failed;
+      merged.bytes += entry.second.bytes;
+    }
+    if (bySite.empty()) continue;
+
+    std::vector<std::pair<std::string, SiteStats>> ranked(bySite.begin(), bySite.end());
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+      return a.second.bytes != b.second.bytes ? a.second.bytes > b.second.bytes : a.first < b.first;
+    });
+    if (ranked.size() > topSites) ranked.resize(topSites);
+
+    fprintf(out, "\n  Top sites (%s):\n", phaseName(static_cast<Phase>(i)));
+    for (const auto& site : ranked) {
+      fprintf(out, "  %12llu B %8ux %s", static_cast<unsigned long long>(site.second.bytes), site.second.allocations,
+              site.first.c_str());
+      if (site.second.failed) fprintf(out, " (%u failed)", site.second.failed);
+      fprintf(out, "\n");
+    }
+  }
+}
+
+void writeTimeline(FILE* out) {
+  if (!state) return;
+  Guard guard;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  fprintf(out, "sequence,phase,used,largestFreeBlock\n");
+  for (const Sample& sample : state->timeline) {
+    fprintf(out, "%llu,%s,%zu,%zu\n", static_cast<unsigned long long>(sample.sequence), phaseName(sample.phase),
+            sample.used, sample.largestFreeBlock);
+  }
+}
+
+}  // namespace HeapProfiler
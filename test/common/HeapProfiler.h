@@ -0,0 +1,118 @@
+#pragma once
+
+// Host-only allocation profiler. Replays every tracked malloc/new against a
+// simulated ESP32 heap so fragmentation shows up the way it would on device:
+// peak usage, largest free block over time and the allocation sites behind
+// them, split by phase.
+//
+// Allocations reach the profiler through HeapProfilerHooks.cpp, which replaces
+// operator new/delete and (on Linux, linked with -Wl,--wrap=malloc etc.) the C
+// allocator. Only allocations made between start() and stop() are simulated.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+
+namespace HeapProfiler {
+
+// Usable heap on an ESP32-C3 after boot with WiFi off
+constexpr size_t DEFAULT_CAPACITY = 380 * 1024;
+
+enum class Phase : uint8_t { Other, Open, Parse, Layout, Serialize, Render, Count };
+
+const char* phaseName(Phase phase);
+
+/**
+ * Address-space model of the ESP-IDF TLSF heap. Blocks carry a 4-byte header
+ * and 4-byte alignment; a request is matched against free blocks whose size
+ * class (32 classes per power of two) is at least the request's rounded-up
+ * class, smallest first, then split. Freed blocks coalesce with neighbours.
+ */
+class SimHeap {
+ public:
+  static constexpr uint32_t HEADER = 4;
+  static constexpr uint32_t MIN_BLOCK = 16;
+
+  explicit SimHeap(size_t capacity = DEFAULT_CAPACITY);
+
+  // Returns the block offset, or -1 when no free block is large enough
+  int64_t alloc(size_t size);
+  void free(uint32_t offset);
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const { return used_; }
+  size_t freeSize() const { return capacity_ - used_; }
+  // Largest request that would succeed right now
+  size_t largestFreeBlock() const;
+  size_t freeBlockCount() const { return byOffset_.size(); }
+
+  // Block size charged for a request, header included
+  static uint32_t blockSize(size_t request);
+  // Smallest free block size TLSF would consider for a block of this size
+  static uint32_t searchSize(uint32_t block);
+
+ private:
+  void insertFree(uint32_t offset, uint32_t size);
+  void eraseFree(std::map<uint32_t, uint32_t>::iterator it);
+
+  size_t capacity_;
+  size_t used_ = 0;
+  std::map<uint32_t, uint32_t> byOffset_;           // Free blocks: offset -> size
+  std::set<std::pair<uint32_t, uint32_t>> bySize_;  // Free blocks: (size, offset)
+  std::map<uint32_t, uint32_t> allocated_;          // Live blocks: offset -> size
+};
+
+struct PhaseStats {
+  uint32_t allocations = 0;
+  uint32_t failed = 0;  // Would have returned NULL on device
+  uint64_t bytes = 0;   // Requested bytes
+  size_t peakUsed = 0;
+  size_t minLargestFreeBlock = 0;
+};
+
+struct Stats {
+  size_t capacity = 0;
+  size_t used = 0;
+  size_t peakUsed = 0;
+  size_t largestFreeBlock = 0;
+  size_t minLargestFreeBlock = 0;
+  size_t freeBlocks = 0;
+  uint32_t liveAllocations = 0;
+  PhaseStats phases[static_cast<size_t>(Phase::Count)];
+};
+
+// capacity 0 uses DEFAULT_CAPACITY. Restarting discards the previous profile.
+void start(size_t capacity = 0);
+void stop();
+bool active();
+
+// Base phase, set by the driver (reader-test, a unit test)
+void setPhase(Phase phase);
+// Nested phases override the base phase until popped; used for trace spans
+void pushPhase(Phase phase);
+void popPhase();
+Phase currentPhase();
+
+class PhaseScope {
+ public:
+  explicit PhaseScope(Phase phase) { pushPhase(phase); }
+  ~PhaseScope() { popPhase(); }
+  PhaseScope(const PhaseScope&) = delete;
+  PhaseScope& operator=(const PhaseScope&) = delete;
+};
+
+Stats stats();
+
+// Per-phase summary and the top allocation sites of each phase, by bytes
+void report(FILE* out, size_t topSites = 8);
+// CSV: sequence,phase,used,largestFreeBlock - one row per phase change and
+// whenever usage or the largest free block moved by 1 KB or more
+void writeTimeline(FILE* out);
+
+// Allocator entry points for HeapProfilerHooks.cpp
+void onAlloc(void* ptr, size_t size);
+void onFree(void* ptr);
+
+}  // namespace HeapProfiler
@@ -0,0 +1,111 @@
+// Routes the process allocator through HeapProfiler. Link into a target that
+// also builds HeapProfiler.cpp; on Linux add
+//   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+// so C allocations (malloc buffers, expat, uzlib) are profiled as well as new.
+// Export symbols (ENABLE_EXPORTS) to get function names in the site report.
+//
+// With HEAP_PROFILE_AUTOSTART defined the profile covers the whole run and is
+// printed to stderr at exit (the PAPYRIX_HEAP_PROFILE test build option).
+
+#include <cstdlib>
+#include <new>
+
+#include "HeapProfiler.h"
+
+#ifdef __linux__
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+  void* ptr = __real_malloc(size);
+  HeapProfiler::onAlloc(ptr, size);
+  return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  void* ptr = __real_calloc(count, size);
+  HeapProfiler::onAlloc(ptr, count * size);
+  return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  void* out = __real_realloc(ptr, size);
+  if (out || size == 0) {
+    HeapProfiler::onFree(ptr);
+    HeapProfiler::onAlloc(out, size);
+  }
+  return out;
+}
+
+void __wrap_free(void* ptr) {
+  HeapProfiler::onFree(ptr);
+  __real_free(ptr);
+}
+}  // extern "C"
+#endif
+
+// Without --wrap, malloc is not seen by the profiler, so new reports itself.
+// Kept free of helper functions: every frame here would show up as a site.
+#ifdef __linux__
+#define HEAP_PROFILER_NEW(ptr, size) ((void)0)
+#define HEAP_PROFILER_DELETE(ptr) ((void)0)
+#else
+#define HEAP_PROFILER_NEW(ptr, size) HeapProfiler::onAlloc(ptr, size)
+#define HEAP_PROFILER_DELETE(ptr) HeapProfiler::onFree(ptr)
+#endif
+
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  HEAP_PROFILER_NEW(ptr, size);
+  return ptr;
+}
+void* operator new[](size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  HEAP_PROFILER_NEW(ptr, size);
+  return ptr;
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  void* ptr = malloc(size ? size : 1);
+  HEAP_PROFILER_NEW(ptr, size);
+  return ptr;
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  void* ptr = malloc(size ? size : 1);
+  HEAP_PROFILER_NEW(ptr, size);
+  return ptr;
+}
+void operator delete(void* ptr) noexcept {
+  HEAP_PROFILER_DELETE(ptr);
+  free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+  HEAP_PROFILER_DELETE(ptr);
+  free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept {
+  HEAP_PROFILER_DELETE(ptr);
+  free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept {
+  HEAP_PROFILER_DELETE(ptr);
+  free(ptr);
+}
+
+#ifdef HEAP_PROFILE_AUTOSTART
+namespace {
+struct AutoStart {
+  AutoStart() {
+    HeapProfiler::start();
+    atexit([] {
+      HeapProfiler::stop();
+      HeapProfiler::report(stderr);
+    });
+  }
+} autoStart;
+}  // namespace
+#endif
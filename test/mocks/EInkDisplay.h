@@ -35,6 +35,9 @@ class EInkDisplay {
   uint32_t getBufferSize() const { return bufferSize_; }
   void clearScreen(uint8_t color = 0xFF) { memset(frameBuffer_, color, bufferSize_); }
   void displayBuffer(RefreshMode, bool) {}
+  void beginDisplayBuffer(RefreshMode, bool) {}
+  void finishRefresh() {}
+  static constexpr bool frameBufferFreeWhileRefreshing() { return false; }
   void displayBufferDriveAll(bool = false) {}
   void displayWindow(int, int, int, int, bool) {}
   void drawImage(const uint8_t*, int, int, int, int) {}
@@ -171,6 +171,8 @@ class GfxRenderer {
   void clearScreen(uint8_t = 0xFF) const {}
   void drawPixel(int, int, bool = true) const {}
   void displayBuffer(EInkDisplay::RefreshMode = EInkDisplay::FAST_REFRESH, bool = false) const {}
+  void beginDisplayBuffer(EInkDisplay::RefreshMode = EInkDisplay::FAST_REFRESH, bool = false) const {}
+  void finishRefresh() const {}
   void copyGrayscaleLsbBuffers() const {}
   void copyGrayscaleMsbBuffers() const {}
   void displayGrayBuffer(bool = false) const {}
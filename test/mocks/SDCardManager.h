@@ -154,6 +154,10 @@ class SDCardManager {
     auto directory = directories_.find(path);
     if (directory != directories_.end()) {
       file.setDirectory(directory->second);
+      auto timestamp = modifyDateTimes_.find(path);
+      if (timestamp != modifyDateTimes_.end()) {
+        file.setModifyDateTime(timestamp->second.first, timestamp->second.second);
+      }
       return file;
     }
 
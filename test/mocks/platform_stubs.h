@@ -141,9 +141,18 @@ unsigned long millis();
 #endif
 #define ENABLE_SERIAL_LOG
 #define LOG_ERR(origin, format, ...) ::printf("[ERR] [%s] " format "\n", origin, ##__VA_ARGS__)
+#if LOG_LEVEL >= 1
 #define LOG_WRN(origin, format, ...) ::printf("[WRN] [%s] " format "\n", origin, ##__VA_ARGS__)
 #define LOG_INF(origin, format, ...) ::printf("[INF] [%s] " format "\n", origin, ##__VA_ARGS__)
+#else
+#define LOG_WRN(origin, format, ...)
+#define LOG_INF(origin, format, ...)
+#endif
+#if LOG_LEVEL >= 2
 #define LOG_DBG(origin, format, ...) ::printf("[DBG] [%s] " format "\n", origin, ##__VA_ARGS__)
+#else
+#define LOG_DBG(origin, format, ...)
+#endif
 
 // logSerial reference for test builds — aliases to Serial mock
 static MockSerial& logSerial = Serial;
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""Compare two ReaderBench JSON results and flag regressions.
+
+Usage: compare_bench.py base.json head.json [--threshold PCT] [--min-ms MS]
+
+A scenario regresses when its median time grows by more than the threshold
+(default 10%) and by at least --min-ms (default 0.05 ms, below that the host
+timer is noise), or when its allocation count grows at all. Exits 1 on any
+regression so it can gate a CI job.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    return {(r["book"], r["scenario"]): r for r in data["results"]}
+
+
+def percent(base, head):
+    return (head - base) / base * 100.0 if base else 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("base")
+    parser.add_argument("head")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed median slowdown in percent")
+    parser.add_argument("--min-ms", type=float, default=0.05, help="ignore slowdowns smaller than this")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    head = load(args.head)
+    regressions = 0
+
+    print(f"{'book':<9} {'scenario':<12} {'base ms':>9} {'head ms':>9} {'change':>8} {'allocs':>13}")
+    for key in sorted(base.keys() | head.keys()):
+        if key not in head or key not in base:
+            print(f"{key[0]:<9} {key[1]:<12} {'only in ' + ('base' if key in base else 'head'):>30}")
+            continue
+        b, h = base[key], head[key]
+        change = percent(b["median_ms"], h["median_ms"])
+        slower = change > args.threshold and h["median_ms"] - b["median_ms"] >= args.min_ms
+        more_allocs = h["allocations"] > b["allocations"]
+        flag = "  REGRESSION" if slower or more_allocs else ""
+        regressions += bool(flag)
+        allocs = f"{b['allocations']}->{h['allocations']}"
+        print(f"{key[0]:<9} {key[1]:<12} {b['median_ms']:>9.3f} {h['median_ms']:>9.3f} {change:>+7.1f}% "
+              f"{allocs:>13}{flag}")
+
+    if regressions:
+        print(f"\n{regressions} regression(s)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
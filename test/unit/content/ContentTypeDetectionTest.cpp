@@ -43,6 +43,10 @@ int main() {
                   "EPUB uppercase");
   runner.expectEq(uint8_t(papyrix::ContentType::Fb2), uint8_t(papyrix::detectContentType("/books/book.Fb2")),
                   "Fb2 mixed case");
+  runner.expectEq(uint8_t(papyrix::ContentType::Fb2), uint8_t(papyrix::detectContentType("/books/book.fb2.zip")),
+                  "zipped fb2");
+  runner.expectEq(uint8_t(papyrix::ContentType::Fb2), uint8_t(papyrix::detectContentType("/books/book.FB2.Zip")),
+                  "zipped fb2 mixed case");
 
   // === Invalid / missing extension ===
 
@@ -50,6 +54,8 @@ int main() {
                   "no extension");
   runner.expectEq(uint8_t(papyrix::ContentType::None), uint8_t(papyrix::detectContentType("/books/file.xyz")),
                   "unknown extension");
+  runner.expectEq(uint8_t(papyrix::ContentType::None), uint8_t(papyrix::detectContentType("/books/archive.zip")),
+                  "zip without fb2");
   runner.expectEq(uint8_t(papyrix::ContentType::None), uint8_t(papyrix::detectContentType(nullptr)), "null path");
 
   // === Long UTF-8 Cyrillic path (the bug scenario) ===
@@ -0,0 +1,69 @@
+#include "test_utils.h"
+
+#include <vector>
+
+#include "content/IndexingQueue.h"
+
+using papyrix::IndexingQueue;
+using Section = papyrix::page_metrics::Section;
+
+namespace {
+// Sections with the given exact flags
+std::vector<Section> sections(const std::vector<bool>& exact) {
+  std::vector<Section> result;
+  for (const bool isExact : exact) result.push_back(Section{10, isExact, 20480});
+  return result;
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("IndexingQueueTest");
+
+  // Sections after the reader come first, then the queue wraps to the start
+  {
+    IndexingQueue queue;
+    const auto metrics = sections({false, false, true, false, false});
+    runner.expectEq(3, queue.next(metrics, 1), "order: first pending after the reader");
+    runner.expectEq(0, queue.next(metrics, 4), "order: wraps to the start");
+    runner.expectEq(0, queue.next(metrics, -1), "order: from the start without a reader section");
+  }
+
+  // The reader's own section is left to its cache
+  {
+    IndexingQueue queue;
+    const auto metrics = sections({true, false, true});
+    runner.expectEq(-1, queue.next(metrics, 1), "reader: own section not returned");
+    runner.expectEq(1, queue.next(metrics, 0), "reader: other section returned");
+  }
+
+  // Nothing pending
+  {
+    IndexingQueue queue;
+    runner.expectEq(-1, queue.next(sections({true, true, true}), 0), "done: all exact");
+    runner.expectEq(-1, queue.next({}, 0), "done: no sections");
+  }
+
+  // Skipped sections stay out until clear()
+  {
+    IndexingQueue queue;
+    const auto metrics = sections({true, false, false});
+    queue.skip(1);
+    runner.expectTrue(queue.skipped(1), "skip: recorded");
+    runner.expectFalse(queue.skipped(2), "skip: others untouched");
+    runner.expectEq(2, queue.next(metrics, 0), "skip: next one returned");
+    queue.skip(2);
+    runner.expectEq(-1, queue.next(metrics, 0), "skip: all skipped");
+    queue.skip(-1);
+    runner.expectFalse(queue.skipped(-1), "skip: negative ignored");
+    queue.clear();
+    runner.expectEq(1, queue.next(metrics, 0), "clear: retried");
+  }
+
+  // A reader section out of range (cover page, stale index) starts from the front
+  {
+    IndexingQueue queue;
+    runner.expectEq(0, queue.next(sections({false, false}), 7), "range: out of range reader section");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+#include "test_utils.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SDCardManager.h"
+#include "content/ResumeSnapshot.h"
+#include "core/PapyrixSettings.h"
+
+namespace resume = papyrix::resume_snapshot;
+
+namespace {
+constexpr uint16_t kWidth = 800;
+constexpr uint16_t kHeight = 480;
+constexpr size_t kRowBytes = kWidth / 8;
+constexpr char kBook[] = "/Books/novel.epub";
+constexpr char kSnapshotFile[] = "/.papyrix/resume.bin";
+
+// White page with a few lines of "text": short black runs every 24 rows
+std::vector<uint8_t> textPage() {
+  std::vector<uint8_t> page(kRowBytes * kHeight, 0xFF);
+  for (uint16_t line = 20; line + 12 < kHeight; line += 24) {
+    for (uint16_t y = line; y < line + 12; y++) {
+      for (size_t x = 4; x < kRowBytes - 4; x += 3) page[y * kRowBytes + x] = static_cast<uint8_t>(0x81 ^ (x + y));
+    }
+  }
+  return page;
+}
+
+// Random pixels do not compress: stands in for a page of dithered images
+std::vector<uint8_t> noisePage() {
+  std::vector<uint8_t> page(kRowBytes * kHeight);
+  srand(1);
+  for (auto& byte : page) byte = static_cast<uint8_t>(rand());
+  return page;
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("ResumeSnapshotTest");
+
+  papyrix::Settings settings;
+  constexpr uint32_t kFontFingerprint = 0x5EED;
+  const uint32_t key = resume::layoutKey(settings, kFontFingerprint);
+  resume::FontSource font;
+  font.family = "Literata";
+  font.builtinFontId = 7;
+  // The key restore() compares against, from the font the snapshot names
+  auto keyFor = [&](const uint32_t layoutKey) {
+    return [layoutKey](const resume::FontSource&) { return layoutKey; };
+  };
+
+  // Round trip restores the page bit for bit
+  {
+    SdMan.reset();
+    const auto page = textPage();
+    runner.expectTrue(resume::save(page.data(), kWidth, kHeight, kBook, font, key), "roundtrip: save");
+    const std::string stored = SdMan.getWrittenData(kSnapshotFile);
+    runner.expectTrue(!stored.empty() && stored.size() < page.size() / 4, "roundtrip: compressed well below raw");
+
+    std::vector<uint8_t> restored(page.size(), 0);
+    runner.expectTrue(resume::restore(restored.data(), kWidth, kHeight, kBook, keyFor(key)),
+                      "roundtrip: restore");
+    runner.expectTrue(restored == page, "roundtrip: pixels match");
+    runner.expectTrue(SdMan.exists(kSnapshotFile), "roundtrip: snapshot kept for the next boot");
+  }
+
+  // Another book, panel size or layout does not get this page
+  {
+    SdMan.reset();
+    const auto page = textPage();
+    resume::save(page.data(), kWidth, kHeight, kBook, font, key);
+    std::vector<uint8_t> restored(page.size(), 0);
+    runner.expectFalse(resume::restore(restored.data(), kWidth, kHeight, "/Books/other.epub", keyFor(key)),
+                       "mismatch: other book");
+    runner.expectFalse(resume::restore(restored.data(), 792, kHeight, kBook, keyFor(key)),
+                       "mismatch: other panel width");
+    runner.expectFalse(resume::restore(restored.data(), kWidth, kHeight, kBook, keyFor(key + 1)),
+                       "mismatch: other layout");
+    runner.expectTrue(SdMan.exists(kSnapshotFile), "mismatch: snapshot left alone");
+  }
+
+  // Layout key follows the settings that move text, not unrelated ones
+  {
+    papyrix::Settings changed = settings;
+    changed.fontSize = papyrix::Settings::FontLarge;
+    runner.expectTrue(resume::layoutKey(changed, kFontFingerprint) != key, "layoutKey: font size");
+    changed = settings;
+    changed.orientation = papyrix::Settings::LandscapeCW;
+    runner.expectTrue(resume::layoutKey(changed, kFontFingerprint) != key, "layoutKey: orientation");
+    changed = settings;
+    strncpy(changed.themeName, "dark", sizeof(changed.themeName));
+    runner.expectTrue(resume::layoutKey(changed, kFontFingerprint) != key, "layoutKey: theme");
+    changed = settings;
+    changed.autoSleepMinutes = papyrix::Settings::SleepNever;
+    runner.expectEq(key, resume::layoutKey(changed, kFontFingerprint), "layoutKey: ignores auto sleep");
+    runner.expectTrue(resume::layoutKey(settings, kFontFingerprint + 1) != key, "layoutKey: font files");
+
+    // Editing the theme file changes the key without renaming the theme
+    SdMan.reset();
+    const uint32_t builtinThemeKey = resume::layoutKey(settings, kFontFingerprint);
+    SdMan.registerFile(std::string("/config/themes/") + settings.themeName + ".theme", "margin_top = 10\n");
+    const uint32_t themeFileKey = resume::layoutKey(settings, kFontFingerprint);
+    runner.expectTrue(themeFileKey != builtinThemeKey, "layoutKey: theme file");
+    SdMan.registerFile(std::string("/config/themes/") + settings.themeName + ".theme", "margin_top = 12\n");
+    runner.expectTrue(resume::layoutKey(settings, kFontFingerprint) != themeFileKey, "layoutKey: theme file edit");
+  }
+
+  // restore() fingerprints the font the snapshot was saved with
+  {
+    SdMan.reset();
+    const auto page = textPage();
+    resume::save(page.data(), kWidth, kHeight, kBook, font, key);
+    resume::FontSource seen;
+    std::vector<uint8_t> restored(page.size(), 0);
+    const bool ok = resume::restore(restored.data(), kWidth, kHeight, kBook, [&](const resume::FontSource& saved) {
+      seen = saved;
+      return key;
+    });
+    runner.expectTrue(ok, "font: restored");
+    runner.expectEq(std::string("Literata"), seen.family, "font: family kept");
+    runner.expectEq(7, static_cast<int>(seen.builtinFontId), "font: built-in ID kept");
+    runner.expectFalse(resume::restore(restored.data(), kWidth, kHeight, kBook,
+                                       [&](const resume::FontSource&) {
+                                         return resume::layoutKey(settings, kFontFingerprint + 1);
+                                       }),
+                       "font: edited font files rejected");
+  }
+
+  // A page that does not fit the compressed budget drops the stale snapshot
+  {
+    SdMan.reset();
+    const auto page = textPage();
+    resume::save(page.data(), kWidth, kHeight, kBook, font, key);
+    const auto noise = noisePage();
+    runner.expectFalse(resume::save(noise.data(), kWidth, kHeight, kBook, font, key), "oversize: save fails");
+    runner.expectFalse(SdMan.exists(kSnapshotFile), "oversize: previous page removed");
+  }
+
+  // Corrupt data is rejected and deleted; the frame buffer is left white
+  {
+    SdMan.reset();
+    const auto page = textPage();
+    resume::save(page.data(), kWidth, kHeight, kBook, font, key);
+    std::string stored = SdMan.getWrittenData(kSnapshotFile);
+    stored[0] ^= 0xFF;
+    SdMan.reset();
+    SdMan.setFileData(kSnapshotFile, stored);
+    std::vector<uint8_t> restored(page.size(), 0);
+    runner.expectFalse(resume::restore(restored.data(), kWidth, kHeight, kBook, keyFor(key)),
+                       "corrupt header: rejected");
+    runner.expectFalse(SdMan.exists(kSnapshotFile), "corrupt header: deleted");
+
+    SdMan.reset();
+    resume::save(page.data(), kWidth, kHeight, kBook, font, key);
+    stored = SdMan.getWrittenData(kSnapshotFile);
+    stored.resize(stored.size() - 40);
+    SdMan.reset();
+    SdMan.setFileData(kSnapshotFile, stored);
+    runner.expectFalse(resume::restore(restored.data(), kWidth, kHeight, kBook, keyFor(key)),
+                       "truncated: rejected");
+  }
+
+  // Missing snapshot or arguments
+  {
+    SdMan.reset();
+    std::vector<uint8_t> buffer(kRowBytes * kHeight, 0);
+    runner.expectFalse(resume::restore(buffer.data(), kWidth, kHeight, kBook, keyFor(key)),
+                       "missing: nothing restored");
+    runner.expectFalse(resume::save(nullptr, kWidth, kHeight, kBook, font, key), "args: null buffer");
+    runner.expectFalse(resume::save(buffer.data(), kWidth, kHeight, "", font, key), "args: empty path");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
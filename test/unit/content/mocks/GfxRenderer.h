@@ -42,9 +42,11 @@ class GfxRenderer {
   void clearScreen(const uint8_t = 0xFF) const {}
   void clearArea(int, int, int, int, const uint8_t = 0xFF) const {}
   void drawBitmap(Bitmap&, const int, const int, const int, const int) {}
+  void drawMaskRow(const uint8_t*, int, int, int, bool = true) const {}
   void displayBuffer(const EInkDisplay::RefreshMode = EInkDisplay::FULL_REFRESH, const bool = false) {}
   bool storeBwBuffer() { return false; }
   void setRenderMode(const RenderMode) {}
+  RenderMode getRenderMode() const { return BW; }
   void copyGrayscaleLsbBuffers() {}
   void copyGrayscaleMsbBuffers() {}
   void displayGrayBuffer(const bool = false) {}
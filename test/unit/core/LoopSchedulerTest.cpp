@@ -0,0 +1,129 @@
+#include "test_utils.h"
+
+#include "core/LoopScheduler.h"
+
+using papyrix::LoopActivity;
+using papyrix::LoopPlan;
+using papyrix::LoopScheduler;
+using papyrix::LoopWait;
+
+namespace {
+// Idle reader: throttled CPU, nothing held, nothing running
+LoopActivity idleReader() {
+  LoopActivity activity;
+  activity.idleMs = 60000;
+  activity.pollIntervalMs = 50;
+  activity.lightSleepAllowed = true;
+  return activity;
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("LoopSchedulerTest");
+
+  // Without timers the wait is one input sample interval
+  {
+    LoopScheduler scheduler;
+    const LoopPlan plan = scheduler.plan(1000, idleReader());
+    runner.expectTrue(plan.wait == LoopWait::LightSleep, "idle: light sleep");
+    runner.expectEq(uint32_t(50), plan.ms, "idle: sleeps one sample interval");
+
+    LoopActivity usb = idleReader();
+    usb.lightSleepAllowed = false;
+    const LoopPlan delayed = scheduler.plan(1000, usb);
+    runner.expectTrue(delayed.wait == LoopWait::Delay, "light sleep not allowed: delay");
+    runner.expectEq(uint32_t(50), delayed.ms, "light sleep not allowed: same interval");
+  }
+
+  // A held button needs steady polling for long press and repeat
+  {
+    LoopScheduler scheduler;
+    LoopActivity activity = idleReader();
+    activity.buttonHeld = true;
+    activity.pollIntervalMs = 10;
+    const LoopPlan plan = scheduler.plan(0, activity);
+    runner.expectTrue(plan.wait == LoopWait::Delay, "held button: delay");
+    runner.expectEq(uint32_t(10), plan.ms, "held button: active interval");
+  }
+
+  // Background work keeps the loop out of light sleep and gets longer slices once idle
+  {
+    LoopScheduler scheduler;
+    LoopActivity activity = idleReader();
+    activity.backgroundWork = true;
+    activity.pollIntervalMs = 10;
+    activity.idleMs = 500;
+    LoopPlan plan = scheduler.plan(0, activity);
+    runner.expectTrue(plan.wait == LoopWait::Delay, "background, user active: delay");
+    runner.expectEq(uint32_t(10), plan.ms, "background, user active: short interval");
+
+    activity.idleMs = LoopScheduler::IDLE_AFTER_MS;
+    plan = scheduler.plan(0, activity);
+    runner.expectTrue(plan.wait == LoopWait::Delay, "background, user idle: delay");
+    runner.expectEq(LoopScheduler::BACKGROUND_SLICE_MS, plan.ms, "background, user idle: full slice");
+  }
+
+  // Timers shorten the wait and fire once
+  {
+    LoopScheduler scheduler;
+    scheduler.arm(LoopScheduler::Timer::Clock, 1020);
+    runner.expectTrue(scheduler.armed(LoopScheduler::Timer::Clock), "timer armed");
+    runner.expectEq(uint32_t(20), scheduler.plan(1000, idleReader()).ms, "near timer shortens the wait");
+    runner.expectEq(uint32_t(50), scheduler.plan(900, idleReader()).ms, "far timer leaves the wait alone");
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::Clock, 1019), "timer not due early");
+
+    const LoopPlan due = scheduler.plan(1020, idleReader());
+    runner.expectTrue(due.wait == LoopWait::None, "due timer: no wait");
+    runner.expectEq(uint32_t(0), due.ms, "due timer: zero ms");
+    runner.expectTrue(scheduler.fire(LoopScheduler::Timer::Clock, 1025), "overdue timer fires");
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::Clock, 1030), "timer fires once");
+    runner.expectFalse(scheduler.armed(LoopScheduler::Timer::Clock), "fired timer disarmed");
+
+    scheduler.arm(LoopScheduler::Timer::AutoSleep, 5000);
+    scheduler.arm(LoopScheduler::Timer::AutoSleep, 9000);
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::AutoSleep, 6000), "re-arming replaces due time");
+    scheduler.disarm(LoopScheduler::Timer::AutoSleep);
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::AutoSleep, 10000), "disarmed timer never fires");
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::Count, 10000), "invalid timer ignored");
+  }
+
+  // Deadlines survive millis() wrap-around
+  {
+    LoopScheduler scheduler;
+    const uint32_t now = UINT32_MAX - 5;
+    scheduler.arm(LoopScheduler::Timer::Clock, now + 10);
+    runner.expectEq(uint32_t(10), scheduler.plan(now, idleReader()).ms, "wrapped deadline: remaining time");
+    runner.expectFalse(scheduler.fire(LoopScheduler::Timer::Clock, now + 9), "wrapped deadline: not due early");
+    runner.expectTrue(scheduler.fire(LoopScheduler::Timer::Clock, now + 10), "wrapped deadline: fires");
+  }
+
+  // Fake clock: an idle reader left for ten minutes with auto-sleep at five
+  {
+    LoopScheduler scheduler;
+    const uint32_t lastInputMs = 1000;
+    const uint32_t autoSleepMs = 5 * 60 * 1000;
+    uint32_t clockMs = lastInputMs;
+    uint32_t passes = 0;
+    uint32_t sleptMs = 0;
+    uint32_t sleepAtMs = 0;
+    while (clockMs < lastInputMs + 10 * 60 * 1000) {
+      passes++;
+      scheduler.arm(LoopScheduler::Timer::AutoSleep, lastInputMs + autoSleepMs);
+      if (scheduler.fire(LoopScheduler::Timer::AutoSleep, clockMs)) {
+        sleepAtMs = clockMs;
+        break;
+      }
+      LoopActivity activity = idleReader();
+      activity.idleMs = clockMs - lastInputMs;
+      const LoopPlan plan = scheduler.plan(clockMs, activity);
+      if (plan.wait == LoopWait::LightSleep) sleptMs += plan.ms;
+      clockMs += plan.ms + 1;  // Each pass itself takes a millisecond
+    }
+    runner.expectTrue(sleepAtMs >= lastInputMs + autoSleepMs && sleepAtMs <= lastInputMs + autoSleepMs + 1,
+                      "auto-sleep fires within a pass of the timeout");
+    runner.expectTrue(sleptMs * 50 >= autoSleepMs * 49, "idle time is spent in light sleep");
+    runner.expectTrue(passes <= autoSleepMs / 50 + 1, "no more passes than input samples");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
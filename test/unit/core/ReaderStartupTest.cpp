@@ -0,0 +1,74 @@
+#include "test_utils.h"
+
+#include "core/ReaderStartup.h"
+
+using papyrix::ReaderStartup;
+using Stage = papyrix::ReaderStartupStage;
+
+int main() {
+  TestUtils::TestRunner runner("ReaderStartupTest");
+
+  // A fresh startup is opening and has no timings
+  {
+    ReaderStartup startup;
+    startup.begin(1000);
+    runner.expectTrue(startup.stage() == Stage::Opening, "begin: opening");
+    runner.expectFalse(startup.reached(Stage::PageShown), "begin: no page yet");
+    runner.expectEq(uint32_t(0), startup.elapsedMs(Stage::PageShown), "begin: no time to first page");
+  }
+
+  // Stages in order record time since begin()
+  {
+    ReaderStartup startup;
+    startup.begin(1000);
+    runner.expectTrue(startup.advance(Stage::PageShown, 1450), "order: page shown");
+    runner.expectTrue(startup.advance(Stage::Bookkeeping, 1500), "order: bookkeeping");
+    runner.expectTrue(startup.advance(Stage::Ready, 4000), "order: ready");
+    runner.expectEq(uint32_t(450), startup.elapsedMs(Stage::PageShown), "order: time to first page");
+    runner.expectEq(uint32_t(500), startup.elapsedMs(Stage::Bookkeeping), "order: bookkeeping time");
+    runner.expectEq(uint32_t(3000), startup.elapsedMs(Stage::Ready), "order: ready time");
+    runner.expectTrue(startup.reached(Stage::PageShown), "order: earlier stages reached");
+  }
+
+  // Stages never move back, and repeating one keeps its first timing
+  {
+    ReaderStartup startup;
+    startup.begin(0);
+    startup.advance(Stage::Bookkeeping, 300);
+    runner.expectFalse(startup.advance(Stage::PageShown, 400), "monotonic: no step back");
+    runner.expectFalse(startup.advance(Stage::Bookkeeping, 500), "monotonic: no repeat");
+    runner.expectTrue(startup.stage() == Stage::Bookkeeping, "monotonic: stage kept");
+    runner.expectEq(uint32_t(300), startup.elapsedMs(Stage::Bookkeeping), "monotonic: first timing kept");
+    runner.expectFalse(startup.advance(Stage::Count, 600), "monotonic: Count is not a stage");
+  }
+
+  // Skipped stages are done when the later one is
+  {
+    ReaderStartup startup;
+    startup.begin(100);
+    startup.advance(Stage::PageShown, 200);
+    startup.advance(Stage::Ready, 250);
+    runner.expectEq(uint32_t(150), startup.elapsedMs(Stage::Bookkeeping), "skip: bookkeeping timed with ready");
+    runner.expectEq(uint32_t(150), startup.elapsedMs(Stage::Ready), "skip: ready time");
+  }
+
+  // millis() wrap-around between begin() and the first page
+  {
+    ReaderStartup startup;
+    startup.begin(0xFFFFFF00u);
+    startup.advance(Stage::PageShown, 0x100);
+    runner.expectEq(uint32_t(0x200), startup.elapsedMs(Stage::PageShown), "wrap: elapsed across overflow");
+  }
+
+  // begin() starts over for the next book
+  {
+    ReaderStartup startup;
+    startup.begin(0);
+    startup.advance(Stage::Ready, 900);
+    startup.begin(5000);
+    runner.expectTrue(startup.stage() == Stage::Opening, "restart: opening again");
+    runner.expectEq(uint32_t(0), startup.elapsedMs(Stage::Ready), "restart: timings cleared");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include "test_utils.h"
+
+#include <SDCardManager.h>
+#include <esp_heap_caps.h>
+
+#include <cstring>
+#include <string>
+
+#include "core/Trace.h"
+
+using papyrix::trace::Event;
+using papyrix::trace::FileHeader;
+using papyrix::trace::Phase;
+using papyrix::trace::Record;
+
+namespace {
+constexpr size_t CAPACITY = PAPYRIX_TRACE_RECORDS;
+
+void traced() { TRACE_SCOPE(CacheBuild); }
+
+int heardCount = 0;
+Event heardEvent = Event::Count;
+Phase heardPhase = Phase::Instant;
+void listen(const Event event, const Phase phase) {
+  heardCount++;
+  heardEvent = event;
+  heardPhase = phase;
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("TraceTest");
+  Record records[CAPACITY + 4];
+
+  // Names are part of the file format
+  runner.expectEq(std::string("boot-setup"), std::string(papyrix::trace::eventName(Event::BootSetup)),
+                  "first event name");
+  runner.expectEq(std::string("sleep"), std::string(papyrix::trace::eventName(Event::Sleep)), "sleep event name");
+  runner.expectEq(std::string("page-serialize"), std::string(papyrix::trace::eventName(Event::PageSerialize)),
+                  "last event name");
+  runner.expectEq(std::string("unknown"), std::string(papyrix::trace::eventName(Event::Count)), "invalid event name");
+
+  // Records keep order, phase and heap state
+  {
+    papyrix::trace::reset();
+    testSetLargestFreeBlock(54321);
+    TRACE_BEGIN(PageRender);
+    TRACE_INSTANT(RefreshBegin);
+    TRACE_END(PageRender);
+    traced();
+    testResetLargestFreeBlock();
+
+    const size_t count = papyrix::trace::snapshot(records, CAPACITY);
+    runner.expectEq(size_t(5), count, "five records");
+    runner.expectEq(uint16_t(Event::PageRender), records[0].event, "span begin event");
+    runner.expectEq(uint8_t('B'), records[0].phase, "span begin phase");
+    runner.expectEq(uint8_t('i'), records[1].phase, "instant phase");
+    runner.expectEq(uint8_t('E'), records[2].phase, "span end phase");
+    runner.expectEq(uint32_t(54321), records[0].largestFreeBlock, "largest free block recorded");
+    runner.expectTrue(records[0].freeHeap > 0, "free heap recorded");
+    runner.expectTrue(records[2].timeUs >= records[0].timeUs, "timestamps do not go backwards");
+    runner.expectEq(uint16_t(Event::CacheBuild), records[3].event, "scope opens a span");
+    runner.expectEq(uint8_t('B'), records[3].phase, "scope begins");
+    runner.expectEq(uint8_t('E'), records[4].phase, "scope ends on exit");
+    runner.expectEq(size_t(2), papyrix::trace::snapshot(records, 2), "snapshot honours its limit");
+    runner.expectEq(uint8_t('B'), records[0].phase, "limited snapshot keeps the newest records");
+    runner.expectEq(uint16_t(Event::CacheBuild), records[0].event, "limited snapshot starts at the newest span");
+  }
+
+  // The ring keeps the newest records once full
+  {
+    papyrix::trace::reset();
+    for (size_t i = 0; i < CAPACITY + 3; i++) {
+      papyrix::trace::record(i < 3 ? Event::BootSetup : Event::PageLoad, Phase::Instant);
+    }
+    const size_t count = papyrix::trace::snapshot(records, CAPACITY + 4);
+    runner.expectEq(CAPACITY, count, "full ring holds its capacity");
+    bool onlyNewest = true;
+    for (size_t i = 0; i < count; i++) onlyNewest = onlyNewest && records[i].event == uint16_t(Event::PageLoad);
+    runner.expectTrue(onlyNewest, "oldest records overwritten");
+  }
+
+  // A listener hears every record until removed
+  {
+    papyrix::trace::reset();
+    papyrix::trace::setListener(listen);
+    TRACE_BEGIN(PageSerialize);
+    TRACE_END(PageSerialize);
+    runner.expectEq(2, heardCount, "listener called per record");
+    runner.expectEq(uint16_t(Event::PageSerialize), uint16_t(heardEvent), "listener gets the event");
+    runner.expectEq(uint8_t('E'), uint8_t(heardPhase), "listener gets the phase");
+    papyrix::trace::setListener(nullptr);
+    TRACE_INSTANT(Sleep);
+    runner.expectEq(2, heardCount, "removed listener not called");
+  }
+
+  // Flush writes header, names and records
+  {
+    SdMan.reset();
+    papyrix::trace::reset();
+    TRACE_BEGIN(BootSetup);
+    TRACE_END(BootSetup);
+    runner.expectTrue(papyrix::trace::flush(), "flush succeeds");
+    const std::string data = SdMan.getWrittenData(papyrix::trace::FILE_PATH);
+    runner.expectTrue(data.size() > sizeof(FileHeader), "trace file written");
+
+    FileHeader header{};
+    memcpy(&header, data.data(), sizeof(header));
+    runner.expectTrue(memcmp(header.magic, "PTRC", 4) == 0, "file magic");
+    runner.expectEq(papyrix::trace::FILE_VERSION, header.version, "file version");
+    runner.expectEq(uint8_t(sizeof(Record)), header.recordSize, "record size");
+    runner.expectEq(uint16_t(Event::Count), header.nameCount, "name count");
+    runner.expectEq(uint32_t(2), header.recordCount, "record count");
+    runner.expectEq(uint32_t(0), header.overwritten, "nothing overwritten");
+
+    size_t offset = sizeof(header);
+    std::string firstName;
+    for (uint16_t i = 0; i < header.nameCount && offset < data.size(); i++) {
+      const uint8_t length = static_cast<uint8_t>(data[offset]);
+      if (i == 0) firstName = data.substr(offset + 1, length);
+      offset += 1 + length;
+    }
+    runner.expectEq(std::string("boot-setup"), firstName, "names follow the header");
+    runner.expectEq(offset + 2 * sizeof(Record), data.size(), "records follow the names");
+    Record last{};
+    memcpy(&last, data.data() + offset + sizeof(Record), sizeof(last));
+    runner.expectEq(uint8_t('E'), last.phase, "records oldest first");
+
+    for (size_t i = 0; i < CAPACITY + 7; i++) TRACE_INSTANT(PageLoad);
+    runner.expectTrue(papyrix::trace::flush(), "second flush succeeds");
+    memcpy(&header, SdMan.getWrittenData(papyrix::trace::FILE_PATH).data(), sizeof(header));
+    runner.expectEq(uint32_t(CAPACITY), header.recordCount, "full ring flushed");
+    runner.expectEq(uint32_t(9), header.overwritten, "overwritten records counted");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
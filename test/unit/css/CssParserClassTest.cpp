@@ -277,14 +277,14 @@ int main() {
   }
 
   // ============================================
-  // Selector filtering: combinators and complex selectors are skipped
+  // Selector filtering: unsupported selectors are skipped
   // ============================================
-  // The matcher only supports tag, .class, and tag.class selectors. Anything
-  // containing combinators (+ > ~), descendant whitespace, attribute ([),
-  // pseudo (:), id (#), or universal (*) is skipped at parseRule() time so
-  // it doesn't fill MAX_CSS_RULES with rules that can never match.
+  // Tag, .class and tag.class go to the simple map; id, universal, descendant
+  // and child selectors become selector rules. Sibling combinators (+ ~),
+  // attribute ([) and pseudo (:) selectors are skipped at parseRule() time so
+  // they don't fill MAX_CSS_RULES with rules that can never match.
 
-  // Test 17: combinator/complex selectors are dropped, simple ones kept
+  // Test 17: unsupported selectors are dropped, supported complex ones compiled
   {
     SdMan.clearFiles();
     SdMan.registerFile("/combinators.css",
@@ -302,12 +302,14 @@ int main() {
     CssParser parser;
     bool ok = parser.parseFile("/combinators.css");
     runner.expectTrue(ok, "selector filter: parseFile succeeds");
-    runner.expectEq(static_cast<size_t>(2), parser.getStyleCount(), "selector filter: only p and .note kept");
+    runner.expectEq(static_cast<size_t>(6), parser.getStyleCount(), "selector filter: 2 simple + 4 selector rules");
+    runner.expectEq(static_cast<size_t>(4), parser.getSelectorRuleCount(),
+                    "selector filter: div > p, div p, *, #id compiled");
 
     CssStyle p = parser.getTagStyle("p");
     runner.expectTrue(p.hasTextAlign() && p.textAlign == TextAlign::Center,
                       "selector filter: simple tag rule preserved");
-    runner.expectFalse(p.hasFontWeight(), "selector filter: combinator rules did not bleed into p");
+    runner.expectFalse(p.hasFontWeight(), "selector filter: selector rules did not bleed into tag map");
 
     const CssStyle* note = parser.getStyleForClass(".note");
     runner.expectTrue(note != nullptr && note->hasFontStyle() && note->fontStyle == CssFontStyle::Italic,
@@ -321,8 +323,8 @@ int main() {
 
     CssParser parser;
     parser.parseFile("/mixed_comma.css");
-    // Only "p" and ".keep" should survive; "div > span" and "a:hover" are dropped.
-    runner.expectEq(static_cast<size_t>(2), parser.getStyleCount(), "selector filter: comma list keeps 2 of 4");
+    // "p", ".keep" and "div > span" survive; "a:hover" is dropped.
+    runner.expectEq(static_cast<size_t>(3), parser.getStyleCount(), "selector filter: comma list keeps 3 of 4");
 
     CssStyle p = parser.getTagStyle("p");
     runner.expectTrue(p.hasTextAlign() && p.textAlign == TextAlign::Right,
@@ -0,0 +1,154 @@
+// CssParser selector matching tests - descendant, child, id and universal
+// selectors resolved against a CssAncestorStack, as ChapterHtmlSlimParser does.
+
+#include "test_utils.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <CssParser.h>
+#include <CssSelector.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Elem {
+  const char* tag;
+  const char* classes;
+  const char* id;
+};
+
+// Resolve the style of the last element in `path`, with the others as ancestors
+CssStyle resolve(const CssParser& parser, const std::vector<Elem>& path) {
+  CssAncestorStack stack;
+  for (size_t i = 0; i + 1 < path.size(); i++) {
+    stack.enter(i, CssElementKey::fromAttributes(path[i].tag, path[i].classes, path[i].id));
+  }
+  const Elem& subject = path.back();
+  stack.truncate(path.size() - 1);
+  return parser.getCombinedStyle(subject.tag, subject.classes,
+                                 CssElementKey::fromAttributes(subject.tag, subject.classes, subject.id), stack);
+}
+
+bool isBold(const CssStyle& s) { return s.hasFontWeight() && s.fontWeight == CssFontWeight::Bold; }
+bool isItalic(const CssStyle& s) { return s.hasFontStyle() && s.fontStyle == CssFontStyle::Italic; }
+
+CssParser load(const char* css) {
+  SdMan.clearFiles();
+  SdMan.registerFile("/sel.css", css);
+  CssParser parser;
+  parser.parseFile("/sel.css");
+  return parser;
+}
+
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("CssSelectorMatch");
+
+  // Test 1: descendant selector matches at any depth
+  {
+    CssParser parser = load("div.poem p { font-style: italic; }\n");
+    runner.expectTrue(isItalic(resolve(parser, {{"div", "poem", ""}, {"p", "", ""}})), "descendant: direct child");
+    runner.expectTrue(isItalic(resolve(parser, {{"div", "poem", ""}, {"blockquote", "", ""}, {"p", "", ""}})),
+                      "descendant: grandchild");
+    runner.expectFalse(isItalic(resolve(parser, {{"div", "prose", ""}, {"p", "", ""}})),
+                       "descendant: wrong ancestor class");
+    runner.expectFalse(isItalic(resolve(parser, {{"p", "", ""}})), "descendant: no ancestors");
+  }
+
+  // Test 2: child combinator requires the direct parent
+  {
+    CssParser parser = load("blockquote > p { font-weight: bold; }\n");
+    runner.expectTrue(isBold(resolve(parser, {{"blockquote", "", ""}, {"p", "", ""}})), "child: direct parent");
+    runner.expectFalse(isBold(resolve(parser, {{"blockquote", "", ""}, {"div", "", ""}, {"p", "", ""}})),
+                       "child: grandparent does not match");
+  }
+
+  // Test 3: mixed combinators need backtracking
+  {
+    CssParser parser = load("section > div p { font-weight: bold; }\n");
+    // div directly under section, p anywhere below that div
+    runner.expectTrue(isBold(resolve(parser, {{"section", "", ""}, {"div", "", ""}, {"span", "", ""}, {"p", "", ""}})),
+                      "mixed: section > div ... p");
+    // Nearest div is not a child of section, but an outer one is
+    runner.expectTrue(
+        isBold(resolve(parser, {{"section", "", ""}, {"div", "", ""}, {"aside", "", ""}, {"div", "", ""}, {"p", "", ""}})),
+        "mixed: backtracks past inner div");
+    runner.expectFalse(isBold(resolve(parser, {{"section", "", ""}, {"aside", "", ""}, {"div", "", ""}, {"p", "", ""}})),
+                       "mixed: div not a child of section");
+  }
+
+  // Test 4: id selectors
+  {
+    CssParser parser = load("#intro { font-style: italic; }\np#lead { font-weight: bold; }\n");
+    runner.expectTrue(isItalic(resolve(parser, {{"div", "", "intro"}})), "id: #intro on div");
+    runner.expectFalse(isItalic(resolve(parser, {{"div", "intro", ""}})), "id: class of same name does not match");
+    runner.expectTrue(isBold(resolve(parser, {{"p", "", "lead"}})), "id: p#lead");
+    runner.expectFalse(isBold(resolve(parser, {{"div", "", "lead"}})), "id: div#lead does not match p#lead");
+  }
+
+  // Test 5: universal and multi-class compounds
+  {
+    CssParser parser = load("div > * { font-style: italic; }\n.a.b { font-weight: bold; }\n");
+    runner.expectTrue(isItalic(resolve(parser, {{"div", "", ""}, {"span", "", ""}})), "universal: div > *");
+    runner.expectFalse(isItalic(resolve(parser, {{"span", "", ""}})), "universal: root has no div parent");
+    runner.expectTrue(isBold(resolve(parser, {{"p", "b a", ""}})), "multi-class: both classes present");
+    runner.expectFalse(isBold(resolve(parser, {{"p", "a", ""}})), "multi-class: one class missing");
+  }
+
+  // Test 6: cascade order by specificity, then source order
+  {
+    CssParser parser = load(
+        "p { text-align: left; }\n"
+        "div p { text-align: center; }\n"
+        ".x { text-align: right; }\n"
+        "* { text-align: justify; margin-top: 2em; }\n");
+    CssStyle plain = resolve(parser, {{"div", "", ""}, {"p", "", ""}});
+    runner.expectTrue(plain.textAlign == TextAlign::Center, "cascade: div p (2) beats p (1) and * (0)");
+    runner.expectTrue(plain.hasMarginTop(), "cascade: universal still contributes unset properties");
+    CssStyle classed = resolve(parser, {{"div", "", ""}, {"p", "x", ""}});
+    runner.expectTrue(classed.textAlign == TextAlign::Right, "cascade: .x (10) beats div p (2)");
+
+    CssParser later = load("div p { font-weight: bold; }\nsection p { font-weight: normal; }\n");
+    runner.expectFalse(isBold(resolve(later, {{"div", "", ""}, {"section", "", ""}, {"p", "", ""}})),
+                       "cascade: equal specificity, later rule wins");
+  }
+
+  // Test 7: stack truncation - siblings don't leak into each other's ancestors
+  {
+    CssParser parser = load("em p { font-weight: bold; }\n");
+    CssAncestorStack stack;
+    stack.enter(0, CssElementKey::fromAttributes("body", "", ""));
+    stack.enter(1, CssElementKey::fromAttributes("em", "", ""));
+    // </em> then <p> at depth 1: the em must no longer be an ancestor
+    stack.truncate(1);
+    CssStyle style = parser.getCombinedStyle("p", "", CssElementKey::fromAttributes("p", "", ""), stack);
+    runner.expectFalse(isBold(style), "stack: closed sibling is not an ancestor");
+    runner.expectEq(static_cast<size_t>(1), stack.size(), "stack: truncated to parent depth");
+  }
+
+  // Test 8: gaps left by elements that never entered inherit the parent's bloom
+  {
+    CssParser parser = load("section p { font-weight: bold; }\n");
+    CssAncestorStack stack;
+    stack.enter(0, CssElementKey::fromAttributes("section", "", ""));
+    // Depth 1 element returned early without entering
+    stack.truncate(2);
+    CssStyle style = parser.getCombinedStyle("p", "", CssElementKey::fromAttributes("p", "", ""), stack);
+    runner.expectTrue(isBold(style), "stack: gap keeps outer ancestors visible");
+  }
+
+  // Test 9: without ancestors context the simple path is unchanged
+  {
+    CssParser parser = load("p { text-align: center; }\ndiv p { font-weight: bold; }\n");
+    CssStyle style = parser.getCombinedStyle("p", "");
+    runner.expectTrue(style.textAlign == TextAlign::Center, "simple path: tag rule");
+    runner.expectFalse(isBold(style), "simple path: selector rules need ancestors");
+  }
+
+  SdMan.clearFiles();
+  return runner.allPassed() ? 0 : 1;
+}
@@ -4,7 +4,11 @@
 
 #include "Base64Decoder.h"
 
+#include <ByteSource.h>
+
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -22,6 +26,62 @@ static std::string decode(const std::string& input) {
   return result;
 }
 
+static std::string encode(const std::string& in, const size_t lineLength) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t column = 0;
+  auto put = [&](const char c) {
+    if (lineLength > 0 && column == lineLength) {
+      out += "\r\n";
+      column = 0;
+    }
+    out += c;
+    column++;
+  };
+  for (size_t i = 0; i < in.size(); i += 3) {
+    const size_t n = std::min<size_t>(3, in.size() - i);
+    uint32_t v = static_cast<uint8_t>(in[i]) << 16;
+    if (n > 1) v |= static_cast<uint8_t>(in[i + 1]) << 8;
+    if (n > 2) v |= static_cast<uint8_t>(in[i + 2]);
+    put(table[(v >> 18) & 63]);
+    put(table[(v >> 12) & 63]);
+    put(n > 1 ? table[(v >> 6) & 63] : '=');
+    put(n > 2 ? table[v & 63] : '=');
+  }
+  return out;
+}
+
+// Text source handing out at most chunkSize bytes per read
+class StringSource : public ByteSource {
+ public:
+  StringSource(std::string data, const size_t chunkSize) : data_(std::move(data)), chunkSize_(chunkSize) {}
+
+  int read(uint8_t* buf, const size_t len) override {
+    const size_t n = std::min({len, chunkSize_, data_.size() - pos_});
+    memcpy(buf, data_.data() + pos_, n);
+    pos_ += n;
+    return static_cast<int>(n);
+  }
+
+  size_t size() const override { return data_.size(); }
+
+ private:
+  std::string data_;
+  size_t chunkSize_;
+  size_t pos_ = 0;
+};
+
+// Drain a Base64Source in reads of readSize bytes; "<error>" on failure
+static std::string readAll(const std::string& text, const size_t chunkSize, const size_t readSize) {
+  StringSource source(text, chunkSize);
+  Base64Source decoded(source);
+  std::string out;
+  std::vector<uint8_t> buf(readSize);
+  int n;
+  while ((n = decoded.read(buf.data(), buf.size())) > 0) out.append(reinterpret_cast<char*>(buf.data()), n);
+  return n < 0 ? "<error>" : out;
+}
+
 int main() {
   TestUtils::TestRunner runner("Fb2 Base64 Decoder");
 
@@ -155,5 +215,76 @@ int main() {
     runner.expectTrue(decoder.failed(), "write_fail: decoder reports failure");
   }
 
+  // Every byte value, wrapped at 76 characters, fed in odd-sized chunks
+  {
+    std::string bytes;
+    for (int round = 0; round < 3; round++) {
+      for (int i = 0; i < 256; i++) bytes += static_cast<char>(i ^ (round * 0x5A));
+    }
+    for (size_t trim = 0; trim < 3; trim++) {
+      const std::string expected = bytes.substr(0, bytes.size() - trim);
+      const std::string text = encode(expected, 76);
+      for (const size_t chunk : {1u, 3u, 7u, 64u, 1000u}) {
+        Base64Decoder decoder;
+        std::string result;
+        auto write = [&result](const uint8_t* data, size_t len) {
+          result.append(reinterpret_cast<const char*>(data), len);
+          return true;
+        };
+        for (size_t i = 0; i < text.size(); i += chunk) {
+          decoder.feed(text.data() + i, static_cast<int>(std::min(chunk, text.size() - i)), write);
+        }
+        const bool ok = decoder.finish(write);
+        runner.expectTrue(ok && result == expected, "all_bytes: trim " + std::to_string(trim) + ", chunk " +
+                                                        std::to_string(chunk));
+      }
+    }
+  }
+
+  // Characters outside the alphabet fail, inside a group and between groups
+  {
+    runner.expectEqual("", decode("SGV*bG8="), "invalid: '*' in a group");
+    runner.expectEqual("", decode("SGVsbG8h-SGk="), "invalid: '-' between groups");
+  }
+
+  // decode() never writes past outCap and leaves the rest of the input unconsumed
+  {
+    Base64Decoder decoder;
+    const std::string text = encode("abcdefghij", 0);
+    uint8_t out[4];
+    size_t consumed = 0;
+    const size_t produced = decoder.decode(text.data(), text.size(), consumed, out, sizeof(out));
+    runner.expectEq(static_cast<size_t>(3), produced, "bounded: one group fits");
+    runner.expectEq(static_cast<size_t>(4), consumed, "bounded: one group consumed");
+  }
+
+  // Base64Source: decoded bytes match for any text chunking and read size
+  {
+    std::string bytes;
+    for (int i = 0; i < 1500; i++) bytes += static_cast<char>((i * 37) & 0xFF);
+    const std::string text = encode(bytes, 76);
+    bool allMatch = true;
+    for (const size_t chunk : {1u, 3u, 5u, 512u, 4096u}) {
+      for (const size_t read : {1u, 2u, 3u, 10u, 4096u}) {
+        if (readAll(text, chunk, read) != bytes) allMatch = false;
+      }
+    }
+    runner.expectTrue(allMatch, "source: all chunkings decode the same bytes");
+  }
+
+  // Base64Source stops at the closing tag
+  {
+    const std::string text = "\n" + encode("Hello, binary", 0) + "\n</binary>\n<binary id=\"x\">QUFB</binary>";
+    runner.expectEqual("Hello, binary", readAll(text, 512, 64), "source: ends at '<'");
+    runner.expectEqual("Hello, binary", readAll(text, 3, 2), "source: ends at '<' across small reads");
+  }
+
+  // Base64Source reports broken input
+  {
+    runner.expectEqual("<error>", readAll("SGVsbG8</binary>", 512, 64), "source: truncated group");
+    runner.expectEqual("<error>", readAll("SGVs#G8=", 512, 64), "source: invalid character");
+    runner.expectEqual("", readAll("  </binary>", 512, 64), "source: empty binary");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
@@ -0,0 +1,312 @@
+// Fb2 inline image tests
+//
+// Fb2::load() records where each <binary>'s base64 text starts. Fb2Parser
+// resolves <image l:href="#id"> through that table, decodes the base64 in
+// place into the image converter and lays out the cached result like EPUB
+// images (BMP binaries here: the JPEG/PNG decoders are mocked in this target).
+
+#include "test_utils.h"
+
+#include <Base64Decoder.h>
+#include <ByteSource.h>
+#include <Fb2.h>
+#include <Fb2Parser.h>
+#include <GfxRenderer.h>
+#include <Page.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+#include <platform_stubs.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string kCacheDir = "/.papyrix";
+const std::string kBookPath = "/books/pictures.fb2";
+
+std::string base64Lines(const std::string& in) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 2 < in.size(); i += 3) {
+    const uint32_t v = (static_cast<uint8_t>(in[i]) << 16) | (static_cast<uint8_t>(in[i + 1]) << 8) |
+                       static_cast<uint8_t>(in[i + 2]);
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += table[(v >> 6) & 63];
+    out += table[v & 63];
+    if (i % 57 == 54) out += "\r\n";  // 76-character lines, as FB2 editors write them
+  }
+  if (i < in.size()) {
+    uint32_t v = static_cast<uint8_t>(in[i]) << 16;
+    if (i + 1 < in.size()) v |= static_cast<uint8_t>(in[i + 1]) << 8;
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += i + 1 < in.size() ? table[(v >> 6) & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+void putLe(std::string& out, const uint32_t value, const int bytes) {
+  for (int i = 0; i < bytes; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+// 24-bit bottom-up BMP with a horizontal gradient
+std::string makeBmp(const int width, const int height) {
+  const uint32_t rowBytes = (static_cast<uint32_t>(width) * 3 + 3) & ~3u;
+  std::string bmp = "BM";
+  putLe(bmp, 54 + rowBytes * height, 4);
+  putLe(bmp, 0, 4);
+  putLe(bmp, 54, 4);
+  putLe(bmp, 40, 4);
+  putLe(bmp, width, 4);
+  putLe(bmp, height, 4);
+  putLe(bmp, 1, 2);
+  putLe(bmp, 24, 2);
+  putLe(bmp, 0, 4);
+  putLe(bmp, rowBytes * height, 4);
+  putLe(bmp, 2835, 4);
+  putLe(bmp, 2835, 4);
+  putLe(bmp, 0, 4);
+  putLe(bmp, 0, 4);
+  for (int y = 0; y < height; y++) {
+    std::string row;
+    for (int x = 0; x < width; x++) {
+      const char gray = static_cast<char>(x * 255 / width);
+      row.append(3, gray);
+    }
+    row.resize(rowBytes, '\0');
+    bmp += row;
+  }
+  return bmp;
+}
+
+std::string paragraphs(const char* prefix, const int count) {
+  std::string out;
+  for (int i = 0; i < count; i++) {
+    out += std::string("<p>") + prefix + std::to_string(i) + " words that wrap across the narrow test page.</p>\n";
+  }
+  return out;
+}
+
+// Block image, inline image inside a paragraph, a tall image and one reference per failure mode
+std::string buildBook() {
+  return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\" "
+         "xmlns:l=\"http://www.w3.org/1999/xlink\">\n"
+         "<description><title-info><book-title>Pictures</book-title><lang>en</lang></title-info></description>\n"
+         "<body>\n"
+         "<section><title><p>One</p></title>\n" +
+         paragraphs("before", 3) +
+         "<image l:href=\"#small.bmp\"/>\n"
+         "<p>inline <image l:href=\"#small.bmp\"/> after</p>\n" +
+         paragraphs("middle", 2) +
+         "<image l:href=\"#tall.bmp\"/>\n" + paragraphs("after", 3) +
+         "<image l:href=\"#missing.bmp\"/><image l:href=\"#broken.bmp\"/><image l:href=\"http://example.com/x.png\"/>\n"
+         "<p>end</p>\n"
+         "</section>\n"
+         "</body>\n"
+         "<binary id=\"small.bmp\" content-type=\"image/bmp\">" +
+         base64Lines(makeBmp(40, 30)) +
+         "</binary>\n"
+         "<binary content-type=\"image/bmp\" id=\"tall.bmp\">\n" +
+         base64Lines(makeBmp(120, 150)) +
+         "\n</binary>\n"
+         "<binary id=\"broken.bmp\" content-type=\"image/bmp\">" +
+         base64Lines("not an image at all") + "</binary>\n</FictionBook>\n";
+}
+
+// Page content in order: words, and "[img WxH]" for images
+struct Layout {
+  std::vector<std::string> tokens;
+  std::vector<size_t> imagesPerPage;
+  bool ok = true;
+};
+
+Layout parseAll(Fb2Parser& parser, const uint32_t maxPages) {
+  Layout layout;
+  auto onPage = [&](std::unique_ptr<Page> page) {
+    size_t images = 0;
+    for (auto& elem : page->elements) {
+      if (elem->getTag() == TAG_PageImage) {
+        const ImageBlock& image = static_cast<PageImage*>(elem.get())->getImageBlock();
+        layout.tokens.push_back("[img " + std::to_string(image.getWidth()) + "x" + std::to_string(image.getHeight()) +
+                                "]");
+        images++;
+        continue;
+      }
+      for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) layout.tokens.push_back(wd.word);
+    }
+    layout.imagesPerPage.push_back(images);
+  };
+  for (int calls = 0; calls < 1000; calls++) {
+    if (!parser.parsePages(onPage, maxPages)) {
+      layout.ok = false;
+      break;
+    }
+    if (!parser.hasMoreContent()) break;
+  }
+  return layout;
+}
+
+size_t indexOf(const std::vector<std::string>& tokens, const std::string& token, const size_t from = 0) {
+  for (size_t i = from; i < tokens.size(); i++) {
+    if (tokens[i] == token) return i;
+  }
+  return tokens.size();
+}
+
+std::string decodeAt(const std::string& path, const uint32_t offset) {
+  FsFile file;
+  if (!SdMan.openFileForRead("TEST", path, file) || !file.seekSet(offset)) return "";
+  FileByteSource<FsFile> text(file);
+  Base64Source source(text);
+  std::string out;
+  uint8_t buf[64];
+  int n;
+  while ((n = source.read(buf, sizeof(buf))) > 0) out.append(reinterpret_cast<char*>(buf), n);
+  return n < 0 ? "<error>" : out;
+}
+
+RenderConfig makeConfig() {
+  RenderConfig config;
+  config.fontId = 1;
+  config.viewportWidth = 300;
+  config.viewportHeight = 200;
+  config.lineCompression = 1.0f;
+  config.hyphenation = false;
+  config.grayscaleImages = true;
+  return config;
+}
+
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("Fb2ImageTest");
+  testResetLargestFreeBlock();
+
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  const RenderConfig config = makeConfig();
+
+  SdMan.clearFiles();
+  SdMan.clearWrittenFiles();
+  SdMan.reset();
+  SdMan.registerFile(kBookPath, buildBook());
+
+  Fb2 fb2(kBookPath, kCacheDir);
+  runner.expectTrue(fb2.load(), "load succeeds");
+  const std::string imageDir = fb2.getCachePath() + "/images";
+
+  // Test 1: binary offsets point at the base64 text, whatever the attribute order
+  {
+    runner.expectEq(static_cast<size_t>(3), fb2.getBinaryCount(), "three binaries recorded");
+    uint32_t smallOffset = 0;
+    uint32_t tallOffset = 0;
+    uint32_t unused = 0;
+    runner.expectTrue(fb2.findBinary("small.bmp", smallOffset), "small.bmp found");
+    runner.expectTrue(fb2.findBinary("tall.bmp", tallOffset), "tall.bmp found");
+    runner.expectFalse(fb2.findBinary("missing.bmp", unused), "missing id not found");
+    runner.expectEqual(makeBmp(40, 30), decodeAt(kBookPath, smallOffset), "small.bmp decodes in place");
+    runner.expectEqual(makeBmp(120, 150), decodeAt(kBookPath, tallOffset), "tall.bmp decodes in place");
+    runner.expectTrue(SdMan.exists(imageDir.c_str()), "image cache directory created");
+  }
+
+  // Test 2: the binary table survives a cached reload
+  {
+    Fb2 cached(kBookPath, kCacheDir);
+    runner.expectTrue(cached.load(), "cached load succeeds");
+    uint32_t expected = 0;
+    uint32_t actual = 0;
+    fb2.findBinary("tall.bmp", expected);
+    runner.expectTrue(cached.findBinary("tall.bmp", actual) && actual == expected, "cached binary offset");
+    runner.expectEq(fb2.getBinaryCount(), cached.getBinaryCount(), "cached binary count");
+  }
+
+  // Test 3: images are skipped without an image cache path
+  Fb2Parser textOnly(fb2.getPath(), gfx, config, fb2.getLanguage());
+  fb2.prepareSectionParser(textOnly, 0);
+  const Layout plain = parseAll(textOnly, 0);
+  runner.expectTrue(plain.ok, "text-only parse succeeds");
+  runner.expectEq(plain.tokens.size(), static_cast<size_t>(indexOf(plain.tokens, "[img 40x30]")),
+                  "no images without cache path");
+
+  // Test 4: referenced binaries are converted, cached as G5 and laid out in document order
+  Fb2Parser withImages(fb2.getPath(), gfx, config, fb2.getLanguage());
+  fb2.prepareSectionParser(withImages, 0, imageDir);
+  const Layout full = parseAll(withImages, 0);
+  {
+    runner.expectTrue(full.ok, "image parse succeeds");
+    const size_t firstSmall = indexOf(full.tokens, "[img 40x30]");
+    const size_t secondSmall = indexOf(full.tokens, "[img 40x30]", firstSmall + 1);
+    const size_t tall = indexOf(full.tokens, "[img 120x150]");
+    runner.expectTrue(indexOf(full.tokens, "before2") < firstSmall, "block image after preceding text");
+    runner.expectTrue(firstSmall < indexOf(full.tokens, "inline") && indexOf(full.tokens, "inline") < secondSmall &&
+                          secondSmall < indexOf(full.tokens, "after"),
+                      "inline image splits its paragraph");
+    runner.expectTrue(indexOf(full.tokens, "middle1") < tall && tall < indexOf(full.tokens, "after0"),
+                      "tall image in order");
+    runner.expectTrue(indexOf(full.tokens, "end") < full.tokens.size(), "text after failed images kept");
+
+    std::vector<std::string> words;
+    for (const auto& token : full.tokens) {
+      if (token.rfind("[img", 0) != 0) words.push_back(token);
+    }
+    runner.expectTrue(words == plain.tokens, "same text as without images");
+
+    // The tall image (> half the viewport) sits alone on its page
+    size_t tallPageImages = 0;
+    size_t seen = 0;
+    for (size_t p = 0; p < full.imagesPerPage.size(); p++) {
+      seen += full.imagesPerPage[p];
+      if (seen >= 3) {
+        tallPageImages = full.imagesPerPage[p];
+        break;
+      }
+    }
+    runner.expectEq(static_cast<size_t>(1), tallPageImages, "tall image on its own page");
+
+    uint32_t smallOffset = 0;
+    fb2.findBinary("small.bmp", smallOffset);
+    const std::string base = imageDir + "/" + std::to_string(smallOffset);
+    runner.expectTrue(SdMan.exists((base + ".g5").c_str()), "small image cached as G5");
+    runner.expectFalse(SdMan.exists((base + ".bmp").c_str()), "intermediate BMP removed");
+  }
+
+  // Test 5: undecodable binaries get a failure marker; missing ids do not
+  {
+    uint32_t brokenOffset = 0;
+    fb2.findBinary("broken.bmp", brokenOffset);
+    runner.expectTrue(SdMan.exists((imageDir + "/" + std::to_string(brokenOffset) + ".failed").c_str()),
+                      "broken binary marked failed");
+  }
+
+  // Test 6: one page per call gives the same layout (images held back across a page-limit stop)
+  {
+    Fb2Parser batched(fb2.getPath(), gfx, config, fb2.getLanguage());
+    fb2.prepareSectionParser(batched, 0, imageDir);
+    const Layout resumed = parseAll(batched, 1);
+    runner.expectTrue(resumed.ok, "batched parse succeeds");
+    runner.expectTrue(resumed.tokens == full.tokens, "batched layout matches");
+    runner.expectEq(full.imagesPerPage.size(), resumed.imagesPerPage.size(), "batched page count matches");
+  }
+
+  // Test 7: 1-bit mode caches one plane under its own name
+  {
+    RenderConfig oneBitConfig = config;
+    oneBitConfig.grayscaleImages = false;
+    Fb2Parser oneBit(fb2.getPath(), gfx, oneBitConfig, fb2.getLanguage());
+    fb2.prepareSectionParser(oneBit, 0, imageDir);
+    const Layout mono = parseAll(oneBit, 0);
+    uint32_t tallOffset = 0;
+    fb2.findBinary("tall.bmp", tallOffset);
+    runner.expectTrue(mono.ok && mono.tokens == full.tokens, "1-bit layout matches");
+    runner.expectTrue(SdMan.exists((imageDir + "/" + std::to_string(tallOffset) + ".bw.g5").c_str()),
+                      "1-bit image cached as .bw.g5");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
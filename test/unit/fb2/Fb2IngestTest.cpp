@@ -0,0 +1,266 @@
+// Fb2 single-pass ingestion tests
+//
+// Fb2::load() collects metadata, TOC, section byte ranges and the cover
+// <binary> offset in one streaming pass. Sections are parsed in place via
+// Fb2Parser::setByteRange; the results must match parsing a standalone copy
+// of the section (what older versions wrote to section_N.fb2 on SD).
+
+#include "test_utils.h"
+
+#include <Fb2.h>
+#include <Fb2Parser.h>
+#include <GfxRenderer.h>
+#include <Page.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+#include <platform_stubs.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string kCacheDir = "/.papyrix";
+const std::string kBookPath = "/books/ingest.fb2";
+const char kBom[] = "\xEF\xBB\xBF";
+
+std::string paragraphs(const int chapter, const int count) {
+  std::string out;
+  for (int i = 0; i < count; i++) {
+    out += "<p>Chapter " + std::to_string(chapter) + " paragraph " + std::to_string(i) +
+           " has a few words so that lines wrap across the page width.</p>\n";
+  }
+  return out;
+}
+
+std::string coverBytes() {
+  std::string bytes;
+  for (int i = 0; i < 300; i++) bytes += static_cast<char>((i * 7) & 0xFF);
+  return bytes;
+}
+
+std::string base64(const std::string& in) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 2 < in.size(); i += 3) {
+    const uint32_t v = (static_cast<uint8_t>(in[i]) << 16) | (static_cast<uint8_t>(in[i + 1]) << 8) |
+                       static_cast<uint8_t>(in[i + 2]);
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += table[(v >> 6) & 63];
+    out += table[v & 63];
+  }
+  if (i < in.size()) {
+    uint32_t v = static_cast<uint8_t>(in[i]) << 16;
+    if (i + 1 < in.size()) v |= static_cast<uint8_t>(in[i + 1]) << 8;
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += i + 1 < in.size() ? table[(v >> 6) & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+// Four top-level sections; the third is a parent of three leaf sections
+std::string buildBook(const bool withBom) {
+  std::string body;
+  for (int ch = 0; ch < 4; ch++) {
+    if (ch == 2) {
+      body += "<section><title><p>Part Two</p></title>\n";
+      for (int sub = 0; sub < 3; sub++) {
+        body += "<section><title><p>Chapter 2." + std::to_string(sub) + "</p></title>\n" +
+                paragraphs(20 + sub, 6) + "</section>\n";
+      }
+      body += "</section>\n";
+    } else {
+      body += "<section>\n<title><p>Chapter " + std::to_string(ch) + "</p></title>\n" + paragraphs(ch, 12) +
+              "<empty-line/><poem><stanza><v>line one</v><v>line two</v></stanza></poem></section>\n";
+    }
+  }
+
+  return std::string(withBom ? kBom : "") +
+         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\" "
+         "xmlns:l=\"http://www.w3.org/1999/xlink\">\n"
+         "<description><title-info><author><first-name>Ann</first-name><last-name>Writer</last-name></author>"
+         "<book-title>Ingest Book</book-title><lang>en</lang>"
+         "<coverpage><image l:href=\"#cover.jpg\"/></coverpage></title-info></description>\n"
+         "<body>\n" +
+         body +
+         "</body>\n"
+         "<binary id=\"cover.jpg\" content-type=\"image/jpeg\">" +
+         base64(coverBytes()) +
+         "</binary>\n"
+         "</FictionBook>\n";
+}
+
+struct ParseResult {
+  std::vector<std::string> words;
+  size_t pages = 0;
+  std::vector<std::pair<std::string, uint32_t>> anchors;
+  bool ok = true;
+};
+
+ParseResult parseAll(Fb2Parser& parser, const uint32_t maxPages) {
+  ParseResult result;
+  auto onPage = [&](std::unique_ptr<Page> page) {
+    result.pages++;
+    for (auto& elem : page->elements) {
+      if (elem->getTag() != TAG_PageLine) continue;
+      for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) result.words.push_back(wd.word);
+    }
+  };
+  for (int calls = 0; calls < 1000; calls++) {
+    if (!parser.parsePages(onPage, maxPages)) {
+      result.ok = false;
+      break;
+    }
+    if (!parser.hasMoreContent()) break;
+  }
+  result.anchors = parser.getAnchorMap();
+  return result;
+}
+
+RenderConfig makeConfig() {
+  RenderConfig config;
+  config.fontId = 1;
+  config.viewportWidth = 300;
+  config.viewportHeight = 200;
+  config.lineCompression = 1.0f;
+  config.hyphenation = false;
+  return config;
+}
+
+void resetSd(const std::string& book) {
+  SdMan.clearFiles();
+  SdMan.clearWrittenFiles();
+  SdMan.reset();
+  SdMan.registerFile(kBookPath, book);
+}
+
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("Fb2IngestTest");
+  testResetLargestFreeBlock();
+
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  const RenderConfig config = makeConfig();
+
+  for (const bool withBom : {false, true}) {
+    const std::string label = withBom ? "bom: " : "plain: ";
+    const std::string book = buildBook(withBom);
+    resetSd(book);
+
+    // Test 1: one pass collects metadata, TOC and leaf section ranges
+    Fb2 fb2(kBookPath, kCacheDir);
+    runner.expectTrue(fb2.load(), label + "load succeeds");
+    runner.expectEqual("Ingest Book", fb2.getTitle(), label + "title");
+    runner.expectEqual("Ann Writer", fb2.getAuthor(), label + "author");
+    runner.expectEqual("en", fb2.getLanguage(), label + "language");
+    runner.expectEq(static_cast<uint16_t>(6), fb2.getSectionCount(), label + "parent section filtered out");
+    runner.expectEq(static_cast<uint16_t>(7), fb2.tocCount(), label + "TOC entries");
+    runner.expectEq(2, fb2.getTocItem(2).sectionIndex, label + "parent TOC entry points at first child");
+    runner.expectEq(5, fb2.getTocItem(6).sectionIndex, label + "last TOC entry");
+
+    // Test 2: ranges are exact <section ...</section> spans of leaf sections
+    bool rangesExact = true;
+    for (int i = 0; i < fb2.getSectionCount(); i++) {
+      const auto& off = fb2.getSectionOffsets()[i];
+      const std::string span = book.substr(off.startOffset, off.endOffset - off.startOffset);
+      rangesExact = rangesExact && span.rfind("<section", 0) == 0 &&
+                    span.size() >= 10 && span.compare(span.size() - 10, 10, "</section>") == 0 &&
+                    span.find("<section", 1) == std::string::npos && fb2.getSectionSize(i) == span.size();
+    }
+    runner.expectTrue(rangesExact, label + "section ranges are exact");
+    runner.expectEq(static_cast<uint32_t>(0), fb2.getSectionSize(6), label + "out-of-range section size");
+
+    // Test 3: sections are not copied to SD
+    runner.expectFalse(SdMan.exists((fb2.getCachePath() + "/section_0.fb2").c_str()), label + "no section files");
+
+    // Test 4: cover offset from the same pass (BOM-shifted files included)
+    runner.expectTrue(fb2.extractEmbeddedCover("/cover.out"), label + "cover extracted");
+    runner.expectEqual(coverBytes(), SdMan.getWrittenData("/cover.out"), label + "cover bytes");
+
+    // Test 5: in-place parse matches parsing a standalone copy of each section
+    bool sameAsCopy = true;
+    bool resumeMatches = true;
+    bool consumedAll = true;
+    for (int i = 0; i < fb2.getSectionCount(); i++) {
+      const auto& off = fb2.getSectionOffsets()[i];
+      const std::string copyPath = "/copy_" + std::to_string(i) + ".fb2";
+      SdMan.registerFile(copyPath,
+                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\">\n<body>\n" +
+                             book.substr(off.startOffset, off.endOffset - off.startOffset) +
+                             "\n</body>\n</FictionBook>\n");
+
+      Fb2Parser copyParser(copyPath, gfx, config, "en");
+      const ParseResult expected = parseAll(copyParser, 0);
+
+      Fb2Parser inPlace(fb2.getPath(), gfx, config, fb2.getLanguage());
+      fb2.prepareSectionParser(inPlace, i);
+      const ParseResult actual = parseAll(inPlace, 0);
+      sameAsCopy = sameAsCopy && expected.ok && actual.ok && !actual.words.empty() &&
+                   expected.words == actual.words && expected.pages == actual.pages &&
+                   expected.anchors == actual.anchors;
+      consumedAll = consumedAll && inPlace.totalBytes() == fb2.getSectionSize(i) &&
+                    inPlace.bytesConsumed() <= inPlace.totalBytes() &&
+                    inPlace.bytesConsumed() + 32 >= inPlace.totalBytes();
+
+      // One page per call suspends and resumes inside the range
+      Fb2Parser batched(fb2.getPath(), gfx, config, fb2.getLanguage());
+      fb2.prepareSectionParser(batched, i);
+      const ParseResult resumed = parseAll(batched, 1);
+      resumeMatches = resumeMatches && resumed.ok && resumed.words == actual.words && resumed.pages == actual.pages;
+    }
+    runner.expectTrue(sameAsCopy, label + "in-place parse matches section copy");
+    runner.expectTrue(resumeMatches, label + "batched in-place parse matches");
+    runner.expectTrue(consumedAll, label + "progress counts section bytes only");
+
+    // Test 6: cached reload restores ranges without re-parsing
+    Fb2 cached(kBookPath, kCacheDir);
+    runner.expectTrue(cached.load(), label + "cached load succeeds");
+    bool sameRanges = cached.getSectionCount() == fb2.getSectionCount();
+    for (int i = 0; sameRanges && i < fb2.getSectionCount(); i++) {
+      sameRanges = cached.getSectionSize(i) == fb2.getSectionSize(i) &&
+                   cached.getSectionOffsets()[i].startOffset == fb2.getSectionOffsets()[i].startOffset;
+    }
+    runner.expectTrue(sameRanges, label + "cached section ranges");
+    Fb2Parser fromCache(cached.getPath(), gfx, config, cached.getLanguage());
+    cached.prepareSectionParser(fromCache, 3);
+    runner.expectFalse(parseAll(fromCache, 0).words.empty(), label + "cached prologue parses");
+  }
+
+  // Test 7: section copies left by older versions are removed on re-ingest
+  {
+    resetSd(buildBook(false));
+    Fb2 probe(kBookPath, kCacheDir);
+    const std::string cachePath = probe.getCachePath();
+    SdMan.registerFile(cachePath + "/.section_cache_v2", "");
+    SdMan.registerFile(cachePath + "/section_0.fb2", "<old/>");
+    SdMan.registerFile(cachePath + "/section_1.fb2", "<old/>");
+
+    runner.expectTrue(probe.load(), "legacy: load succeeds");
+    runner.expectFalse(SdMan.exists((cachePath + "/section_0.fb2").c_str()), "legacy: section_0 removed");
+    runner.expectFalse(SdMan.exists((cachePath + "/section_1.fb2").c_str()), "legacy: section_1 removed");
+    runner.expectFalse(SdMan.exists((cachePath + "/.section_cache_v2").c_str()), "legacy: marker removed");
+  }
+
+  // Test 8: out-of-range section leaves the parser on the whole book
+  {
+    resetSd(buildBook(false));
+    Fb2 fb2(kBookPath, kCacheDir);
+    runner.expectTrue(fb2.load(), "whole_book: load succeeds");
+    Fb2Parser whole(fb2.getPath(), gfx, config, fb2.getLanguage());
+    fb2.prepareSectionParser(whole, 99);
+    const ParseResult all = parseAll(whole, 0);
+    runner.expectTrue(all.ok, "whole_book: parse succeeds");
+    runner.expectEq(static_cast<size_t>(7), all.anchors.size(), "whole_book: every section anchored");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -19,7 +19,8 @@
 #include "Serialization.h"
 
 namespace {
-constexpr uint8_t kMetaCacheVersion = 6;
+constexpr uint8_t kMetaCacheVersion = 8;
+const std::string kDefaultXmlDeclaration = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
 }
 
 struct SectionOffset {
@@ -27,6 +28,11 @@ struct SectionOffset {
   uint32_t endOffset = 0;
 };
 
+struct BinaryRef {
+  uint32_t idHash = 0;
+  uint32_t dataOffset = 0;
+};
+
 struct TocItem {
   std::string title;
   int sectionIndex;
@@ -37,13 +43,16 @@ static void writeMetaCache(FsFile& file, const std::string& title, const std::st
                            const std::string& coverRef, const std::string& language,
                            const std::string& coverContentType, int64_t coverBinaryOffset, uint32_t fileSize,
                            uint16_t sectionCount, const std::vector<TocItem>& tocItems,
-                           const std::vector<SectionOffset>& sectionOffsets = {}) {
+                           const std::vector<SectionOffset>& sectionOffsets = {},
+                           const std::string& xmlDeclaration = kDefaultXmlDeclaration,
+                           const std::vector<BinaryRef>& binaries = {}) {
   serialization::writePod(file, kMetaCacheVersion);
   serialization::writeString(file, title);
   serialization::writeString(file, author);
   serialization::writeString(file, coverRef);
   serialization::writeString(file, language);
   serialization::writeString(file, coverContentType);
+  serialization::writeString(file, xmlDeclaration);
   serialization::writePod(file, coverBinaryOffset);
   serialization::writePod(file, fileSize);
   serialization::writePod(file, sectionCount);
@@ -63,6 +72,13 @@ static void writeMetaCache(FsFile& file, const std::string& title, const std::st
     serialization::writePod(file, off.startOffset);
     serialization::writePod(file, off.endOffset);
   }
+
+  const uint16_t binaryCount = static_cast<uint16_t>(binaries.size());
+  serialization::writePod(file, binaryCount);
+  for (const auto& ref : binaries) {
+    serialization::writePod(file, ref.idHash);
+    serialization::writePod(file, ref.dataOffset);
+  }
 }
 
 // Read meta cache in the same format as Fb2::loadMetaCache()
@@ -72,11 +88,13 @@ struct MetaCacheData {
   std::string coverRef;
   std::string language;
   std::string coverContentType;
+  std::string xmlDeclaration;
   int64_t coverBinaryOffset = -1;
   uint32_t fileSize = 0;
   uint16_t sectionCount = 0;
   std::vector<TocItem> tocItems;
   std::vector<SectionOffset> sectionOffsets;
+  std::vector<BinaryRef> binaries;
 };
 
 static bool readMetaCache(FsFile& file, MetaCacheData& data) {
@@ -87,7 +105,7 @@ static bool readMetaCache(FsFile& file, MetaCacheData& data) {
 
   if (!serialization::readString(file, data.title) || !serialization::readString(file, data.author) ||
       !serialization::readString(file, data.coverRef) || !serialization::readString(file, data.language) ||
-      !serialization::readString(file, data.coverContentType)) {
+      !serialization::readString(file, data.coverContentType) || !serialization::readString(file, data.xmlDeclaration)) {
     return false;
   }
 
@@ -139,6 +157,19 @@ static bool readMetaCache(FsFile& file, MetaCacheData& data) {
     }
   }
 
+  // Load binary offsets (v8+) — graceful: missing is OK
+  uint16_t binaryCount;
+  if (serialization::readPodChecked(file, binaryCount)) {
+    for (uint16_t i = 0; i < binaryCount; i++) {
+      BinaryRef ref;
+      if (!serialization::readPodChecked(file, ref.idHash) || !serialization::readPodChecked(file, ref.dataOffset)) {
+        data.binaries.clear();
+        break;
+      }
+      data.binaries.push_back(ref);
+    }
+  }
+
   return true;
 }
 
@@ -149,6 +180,7 @@ struct MetaCacheLut {
   std::string coverRef;
   std::string language;
   std::string coverContentType;
+  std::string xmlDeclaration;
   int64_t coverBinaryOffset = -1;
   uint32_t fileSize = 0;
   uint16_t sectionCount = 0;
@@ -164,7 +196,7 @@ static bool buildMetaCacheLut(FsFile& file, MetaCacheLut& lut) {
 
   if (!serialization::readString(file, lut.title) || !serialization::readString(file, lut.author) ||
       !serialization::readString(file, lut.coverRef) || !serialization::readString(file, lut.language) ||
-      !serialization::readString(file, lut.coverContentType)) {
+      !serialization::readString(file, lut.coverContentType) || !serialization::readString(file, lut.xmlDeclaration)) {
     return false;
   }
 
@@ -344,6 +376,7 @@ int main() {
     serialization::writeString(file, std::string(""));
     serialization::writeString(file, std::string(""));
     serialization::writeString(file, std::string(""));
+    serialization::writeString(file, kDefaultXmlDeclaration);
     int64_t offset = -1;
     serialization::writePod(file, offset);
     uint32_t fs = 1000;
@@ -515,6 +548,7 @@ int main() {
     serialization::writeString(file, std::string(""));
     serialization::writeString(file, std::string(""));
     serialization::writeString(file, std::string(""));
+    serialization::writeString(file, kDefaultXmlDeclaration);
     int64_t offset2 = -1;
     serialization::writePod(file, offset2);
     uint32_t fs = 1000;
@@ -635,6 +669,7 @@ int main() {
     serialization::writeString(file2, std::string(""));
     serialization::writeString(file2, std::string(""));
     serialization::writeString(file2, std::string(""));
+    serialization::writeString(file2, kDefaultXmlDeclaration);
     int64_t binaryOffset = -1;
     serialization::writePod(file2, binaryOffset);
     uint32_t fs = 1000;
@@ -657,5 +692,61 @@ int main() {
     runner.expectEq(static_cast<size_t>(0), data.sectionOffsets.size(), "section_offsets_truncated: offsets cleared");
   }
 
+  // Test 22: XML declaration round-trip (section prologue keeps the book's encoding)
+  {
+    FsFile file;
+    file.setBuffer("");
+    const std::string decl = "<?xml version=\"1.0\" encoding=\"windows-1251\"?>\n";
+    writeMetaCache(file, "Book", "Author", "", "ru", "", -1, 5000, 1, {{"Ch1", 0}}, {{120, 900}}, decl);
+
+    file.seek(0);
+    MetaCacheData data;
+    bool ok = readMetaCache(file, data);
+    runner.expectTrue(ok, "xml_declaration: read succeeds");
+    runner.expectEqual(decl, data.xmlDeclaration, "xml_declaration: preserved");
+    runner.expectEq(static_cast<size_t>(1), data.sectionOffsets.size(), "xml_declaration: offsets follow");
+
+    file.seek(0);
+    MetaCacheLut lut;
+    runner.expectTrue(buildMetaCacheLut(file, lut), "xml_declaration: LUT build succeeds");
+    runner.expectEqual(decl, lut.xmlDeclaration, "xml_declaration: LUT preserved");
+  }
+
+  // Test 23: Binary offsets round-trip after the section ranges
+  {
+    FsFile file;
+    file.setBuffer("");
+    writeMetaCache(file, "Book", "Author", "", "en", "", -1, 5000, 1, {{"Ch1", 0}}, {{120, 900}},
+                   kDefaultXmlDeclaration, {{0x1234u, 1000}, {0xBEEFu, 4000}});
+
+    file.seek(0);
+    MetaCacheData data;
+    runner.expectTrue(readMetaCache(file, data), "binaries_roundtrip: read succeeds");
+    runner.expectEq(static_cast<size_t>(1), data.sectionOffsets.size(), "binaries_roundtrip: sections intact");
+    runner.expectEq(static_cast<size_t>(2), data.binaries.size(), "binaries_roundtrip: 2 binaries");
+    runner.expectEq(static_cast<uint32_t>(0xBEEF), data.binaries[1].idHash, "binaries_roundtrip: [1] hash");
+    runner.expectEq(static_cast<uint32_t>(4000), data.binaries[1].dataOffset, "binaries_roundtrip: [1] offset");
+  }
+
+  // Test 24: Truncated binary table — succeeds without binaries
+  {
+    FsFile file;
+    file.setBuffer("");
+    writeMetaCache(file, "Book", "Author", "", "", "", -1, 5000, 0, {}, {{10, 20}});
+    // Replace the empty binary table with one claiming an entry that is cut short
+    std::string bytes = file.getBuffer();
+    bytes.resize(bytes.size() - sizeof(uint16_t));
+    const uint16_t count = 1;
+    const uint32_t hash = 7;
+    bytes.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    bytes.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    file.setBuffer(bytes);
+
+    MetaCacheData data;
+    runner.expectTrue(readMetaCache(file, data), "binaries_truncated: still returns true (graceful)");
+    runner.expectEq(static_cast<size_t>(1), data.sectionOffsets.size(), "binaries_truncated: sections kept");
+    runner.expectEq(static_cast<size_t>(0), data.binaries.size(), "binaries_truncated: binaries cleared");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
@@ -0,0 +1,330 @@
+// Zipped FB2 (.fb2.zip) tests
+//
+// A .fb2.zip is read in place: the ingest pass inflates the .fb2 member once
+// and records inflate checkpoints to inflate.idx, and section parsers seek
+// into the member by restoring the nearest checkpoint. Everything parsed from
+// the zip must match the same book read from a plain .fb2.
+
+#include "test_utils.h"
+
+#include <Fb2.h>
+#include <Fb2Parser.h>
+#include <Fb2Source.h>
+#include <GfxRenderer.h>
+#include <Page.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+#include <platform_stubs.h>
+#include <zlib.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string kCacheDir = "/.papyrix";
+const std::string kPlainPath = "/books/big.fb2";
+const std::string kZipPath = "/books/big.fb2.zip";
+
+std::string coverBytes() {
+  std::string bytes;
+  for (int i = 0; i < 300; i++) bytes += static_cast<char>((i * 11) & 0xFF);
+  return bytes;
+}
+
+std::string base64(const std::string& in) {
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 2 < in.size(); i += 3) {
+    const uint32_t v = (static_cast<uint8_t>(in[i]) << 16) | (static_cast<uint8_t>(in[i + 1]) << 8) |
+                       static_cast<uint8_t>(in[i + 2]);
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += table[(v >> 6) & 63];
+    out += table[v & 63];
+  }
+  if (i < in.size()) {
+    uint32_t v = static_cast<uint8_t>(in[i]) << 16;
+    if (i + 1 < in.size()) v |= static_cast<uint8_t>(in[i + 1]) << 8;
+    out += table[(v >> 18) & 63];
+    out += table[(v >> 12) & 63];
+    out += i + 1 < in.size() ? table[(v >> 6) & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+// ~700KB of XML so the ingest pass records a few checkpoints
+std::string buildBook() {
+  std::string body;
+  for (int ch = 0; ch < 40; ch++) {
+    body += "<section><title><p>Chapter " + std::to_string(ch) + "</p></title>\n";
+    for (int i = 0; i < 300; i++) {
+      body += "<p>Chapter " + std::to_string(ch) + " paragraph " + std::to_string(i) + " word" +
+              std::to_string((ch * 131 + i * 17) % 89) + " across the page.</p>\n";
+    }
+    body += "</section>\n";
+  }
+  return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<FictionBook xmlns=\"http://www.gribuser.ru/xml/fictionbook/2.0\" "
+         "xmlns:l=\"http://www.w3.org/1999/xlink\">\n"
+         "<description><title-info><author><first-name>Zip</first-name><last-name>Author</last-name></author>"
+         "<book-title>Zipped Book</book-title><lang>en</lang>"
+         "<coverpage><image l:href=\"#cover.jpg\"/></coverpage></title-info></description>\n"
+         "<body>\n" +
+         body +
+         "</body>\n"
+         "<binary id=\"cover.jpg\" content-type=\"image/jpeg\">" +
+         base64(coverBytes()) +
+         "</binary>\n"
+         "</FictionBook>\n";
+}
+
+std::string rawDeflate(const std::string& in) {
+  z_stream zs{};
+  deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&zs, in.size()), '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = static_cast<uInt>(in.size());
+  zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  zs.avail_out = static_cast<uInt>(out.size());
+  deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+// Archive holding `name` (deflated or stored) plus a small unrelated member
+std::string buildZip(const std::string& name, const std::string& contents, const bool deflated) {
+  struct Member {
+    std::string name;
+    std::string data;
+    uint16_t method;
+    uint32_t size;
+    uint32_t offset;
+  };
+  std::vector<Member> members = {
+      {"readme.txt", "not the book", 0, 12, 0},
+      {name, deflated ? rawDeflate(contents) : contents, static_cast<uint16_t>(deflated ? 8 : 0),
+       static_cast<uint32_t>(contents.size()), 0},
+  };
+
+  std::string zip;
+  const auto u16 = [&zip](uint16_t v) {
+    zip += static_cast<char>(v);
+    zip += static_cast<char>(v >> 8);
+  };
+  const auto u32 = [&zip](uint32_t v) {
+    for (int i = 0; i < 4; i++) zip += static_cast<char>(v >> (8 * i));
+  };
+
+  for (auto& m : members) {
+    m.offset = static_cast<uint32_t>(zip.size());
+    u32(0x04034b50);
+    u16(20);
+    u16(0);
+    u16(m.method);
+    u32(0);
+    u32(0);
+    u32(static_cast<uint32_t>(m.data.size()));
+    u32(m.size);
+    u16(static_cast<uint16_t>(m.name.size()));
+    u16(0);
+    zip += m.name + m.data;
+  }
+  const uint32_t centralOffset = static_cast<uint32_t>(zip.size());
+  for (const auto& m : members) {
+    u32(0x02014b50);
+    u16(20);
+    u16(20);
+    u16(0);
+    u16(m.method);
+    u32(0);
+    u32(0);
+    u32(static_cast<uint32_t>(m.data.size()));
+    u32(m.size);
+    u16(static_cast<uint16_t>(m.name.size()));
+    u16(0);
+    u16(0);
+    u16(0);
+    u16(0);
+    u32(0);
+    u32(m.offset);
+    zip += m.name;
+  }
+  const uint32_t centralSize = static_cast<uint32_t>(zip.size()) - centralOffset;
+  u32(0x06054b50);
+  u16(0);
+  u16(0);
+  u16(static_cast<uint16_t>(members.size()));
+  u16(static_cast<uint16_t>(members.size()));
+  u32(centralSize);
+  u32(centralOffset);
+  u16(0);
+  return zip;
+}
+
+struct ParseResult {
+  std::vector<std::string> words;
+  size_t pages = 0;
+  bool ok = true;
+};
+
+ParseResult parseAll(Fb2Parser& parser, const uint32_t maxPages) {
+  ParseResult result;
+  auto onPage = [&](std::unique_ptr<Page> page) {
+    result.pages++;
+    for (auto& elem : page->elements) {
+      if (elem->getTag() != TAG_PageLine) continue;
+      for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) result.words.push_back(wd.word);
+    }
+  };
+  for (int calls = 0; calls < 5000; calls++) {
+    if (!parser.parsePages(onPage, maxPages)) {
+      result.ok = false;
+      break;
+    }
+    if (!parser.hasMoreContent()) break;
+  }
+  return result;
+}
+
+RenderConfig makeConfig() {
+  RenderConfig config;
+  config.fontId = 1;
+  config.viewportWidth = 300;
+  config.viewportHeight = 200;
+  config.lineCompression = 1.0f;
+  config.hyphenation = false;
+  return config;
+}
+
+void resetSd(const std::string& book, const bool deflated) {
+  SdMan.clearFiles();
+  SdMan.clearWrittenFiles();
+  SdMan.reset();
+  SdMan.registerFile(kPlainPath, book);
+  SdMan.registerFile(kZipPath, buildZip("big.fb2", book, deflated));
+}
+
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("Fb2ZipTest");
+  testResetLargestFreeBlock();
+
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  const RenderConfig config = makeConfig();
+  const std::string book = buildBook();
+
+  // Test 1: source reads the .fb2 member and seeks in both directions
+  {
+    resetSd(book, true);
+    Fb2Source source;
+    runner.expectTrue(Fb2Source::isZipped(kZipPath), "source: .fb2.zip is zipped");
+    runner.expectFalse(Fb2Source::isZipped(kPlainPath), "source: .fb2 is not zipped");
+    runner.expectTrue(source.open(kZipPath), "source: opens member");
+    runner.expectEq(book.size(), source.size(), "source: member size");
+    char buf[40];
+    runner.expectTrue(source.seek(600000), "source: seek forward");
+    source.read(reinterpret_cast<uint8_t*>(buf), sizeof(buf));
+    runner.expectTrue(std::string(buf, sizeof(buf)) == book.substr(600000, sizeof(buf)), "source: forward data");
+    runner.expectTrue(source.seek(100), "source: seek backward");
+    source.read(reinterpret_cast<uint8_t*>(buf), sizeof(buf));
+    runner.expectTrue(std::string(buf, sizeof(buf)) == book.substr(100, sizeof(buf)), "source: backward data");
+    runner.expectEq(static_cast<size_t>(140), source.position(), "source: position");
+    runner.expectFalse(source.seek(book.size() + 1), "source: seek past end fails");
+
+    SdMan.registerFile("/empty.zip", buildZip("notes.txt", "hello", false));
+    runner.expectFalse(source.open("/empty.zip"), "source: archive without .fb2 rejected");
+  }
+
+  for (const bool deflated : {true, false}) {
+    const std::string label = deflated ? "deflated: " : "stored: ";
+    resetSd(book, deflated);
+
+    Fb2 plain(kPlainPath, kCacheDir);
+    runner.expectTrue(plain.load(), label + "plain load succeeds");
+
+    // Test 2: zipped book ingests to the same metadata, TOC and ranges
+    Fb2 zipped(kZipPath, kCacheDir);
+    runner.expectTrue(zipped.load(), label + "zip load succeeds");
+    runner.expectEqual("Zipped Book", zipped.getTitle(), label + "title");
+    runner.expectEqual("Zip Author", zipped.getAuthor(), label + "author");
+    runner.expectEq(plain.getSectionCount(), zipped.getSectionCount(), label + "section count");
+    runner.expectEq(plain.tocCount(), zipped.tocCount(), label + "TOC count");
+    bool sameRanges = plain.getSectionCount() == zipped.getSectionCount();
+    for (int i = 0; sameRanges && i < plain.getSectionCount(); i++) {
+      sameRanges = plain.getSectionOffsets()[i].startOffset == zipped.getSectionOffsets()[i].startOffset &&
+                   plain.getSectionSize(i) == zipped.getSectionSize(i);
+    }
+    runner.expectTrue(sameRanges, label + "section ranges");
+
+    // Test 3: checkpoints only for deflated members, one per 256KB of XML
+    const std::string indexPath = zipped.getCachePath() + "/inflate.idx";
+    if (deflated) {
+      const std::string index = SdMan.getWrittenData(indexPath);
+      const size_t expected = book.size() / Fb2Source::CHECKPOINT_SPACING;
+      runner.expectEq(9 + expected * ZipEntryReader::CHECKPOINT_SIZE, index.size(), label + "inflate index size");
+    } else {
+      runner.expectFalse(SdMan.exists(indexPath.c_str()), label + "no inflate index");
+    }
+
+    // Test 4: every section parses from the zip exactly as from the plain file
+    bool sameSections = true;
+    for (int i = 0; i < plain.getSectionCount(); i++) {
+      Fb2Parser fromPlain(plain.getPath(), gfx, config, "en");
+      plain.prepareSectionParser(fromPlain, i);
+      const ParseResult expected = parseAll(fromPlain, 0);
+      Fb2Parser fromZip(zipped.getPath(), gfx, config, "en");
+      zipped.prepareSectionParser(fromZip, i);
+      const ParseResult actual = parseAll(fromZip, 0);
+      sameSections = sameSections && expected.ok && actual.ok && !actual.words.empty() &&
+                     expected.words == actual.words && expected.pages == actual.pages;
+    }
+    runner.expectTrue(sameSections, label + "sections match plain file");
+
+    // Test 5: batched parsing resumes inside the member
+    {
+      Fb2Parser whole(zipped.getPath(), gfx, config, "en");
+      zipped.prepareSectionParser(whole, 20);
+      const ParseResult all = parseAll(whole, 0);
+      Fb2Parser batched(zipped.getPath(), gfx, config, "en");
+      zipped.prepareSectionParser(batched, 20);
+      const ParseResult resumed = parseAll(batched, 1);
+      runner.expectTrue(resumed.ok && resumed.words == all.words, label + "batched parse matches");
+    }
+
+    // Test 6: cover comes out of the member
+    runner.expectTrue(zipped.extractEmbeddedCover("/cover.out"), label + "cover extracted");
+    runner.expectEqual(coverBytes(), SdMan.getWrittenData("/cover.out"), label + "cover bytes");
+  }
+
+  // Test 7: a stale or damaged index is ignored; seeks inflate from the start instead
+  {
+    resetSd(book, true);
+    Fb2 zipped(kZipPath, kCacheDir);
+    runner.expectTrue(zipped.load(), "stale: load succeeds");
+    const std::string indexPath = zipped.getCachePath() + "/inflate.idx";
+    std::string index = SdMan.getWrittenData(indexPath);
+    index[5] ^= 0x01;  // member size no longer matches
+    SdMan.clearWrittenFiles();
+    SdMan.registerFile(indexPath, index);
+
+    Fb2 plain(kPlainPath, kCacheDir);
+    plain.load();
+    const int last = plain.getSectionCount() - 1;
+    Fb2Parser fromPlain(plain.getPath(), gfx, config, "en");
+    plain.prepareSectionParser(fromPlain, last);
+    Fb2Parser fromZip(zipped.getPath(), gfx, config, "en");
+    zipped.prepareSectionParser(fromZip, last);
+    const ParseResult expected = parseAll(fromPlain, 0);
+    const ParseResult actual = parseAll(fromZip, 0);
+    runner.expectTrue(actual.ok && expected.words == actual.words, "stale: last section still matches");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -110,6 +111,94 @@ int main() {
   runner.expectEq(size_t(302), index.size(), "truncated index rebuild restores all entries");
   runner.expectTrue(SdMan.getWrittenData(rebuiltPath).size() > 10, "replacement index is complete");
 
+  // Changes made by the firmware are patched into the index in place
+  const auto reopenUnchanged = [&](const char* message) {
+    const std::string before = SdMan.getWrittenData(rebuiltPath);
+    index.close();
+    const bool reopened = index.open("/books", acceptBook);
+    runner.expectTrue(reopened && SdMan.getWrittenData(rebuiltPath) == before, message);
+  };
+
+  index.close();
+  entries.push_back({"Book 0.epub", false});
+  SdMan.registerDirectory("/books", entries);
+  runner.expectTrue(FileIndex::noteAdded("/books/Book 0.epub", false, acceptBook), "patches added file");
+  reopenUnchanged("patched index matches directory after add");
+  runner.expectEq(size_t(303), index.size(), "patched index counts added file");
+  runner.expectEq(size_t(3), index.findRowByName("Book 0.epub"), "added file is inserted in natural order");
+  runner.expectTrue(index.entryAt(4, entry), "reads row after inserted file");
+  runner.expectEqual("Book 2.epub", entry.name, "rows after insertion shift down");
+
+  index.close();
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](const MockDirectoryEntry& item) { return item.name == "Book 7.epub"; }),
+                entries.end());
+  SdMan.registerDirectory("/books", entries);
+  runner.expectTrue(FileIndex::noteRemoved("/books/Book 7.epub"), "patches removed file");
+  reopenUnchanged("patched index matches directory after remove");
+  runner.expectEq(size_t(302), index.size(), "patched index drops removed file");
+  runner.expectEq(SIZE_MAX, index.findRowByName("Book 7.epub"), "removed file is absent");
+
+  index.close();
+  for (MockDirectoryEntry& item : entries) {
+    if (item.name == "Book 8.epub") item.name = "Book 800.epub";
+  }
+  SdMan.registerDirectory("/books", entries);
+  runner.expectTrue(FileIndex::noteRenamed("/books/Book 8.epub", "/books/Book 800.epub", false, acceptBook),
+                    "patches renamed file");
+  reopenUnchanged("patched index matches directory after rename");
+  runner.expectEq(index.size() - 1, index.findRowByName("Book 800.epub"), "renamed file moves to its sorted row");
+  runner.expectEq(SIZE_MAX, index.findRowByName("Book 8.epub"), "old name is absent after rename");
+
+  index.close();
+  for (MockDirectoryEntry& item : entries) {
+    if (item.name == "Book 0.epub") item.name = "book 0.epub";
+  }
+  entries.push_back({"notes.jpg", false});
+  SdMan.registerDirectory("/books", entries);
+  runner.expectTrue(FileIndex::noteAdded("/books/book 0.epub", false, acceptBook), "patches re-cased upload");
+  runner.expectTrue(FileIndex::noteAdded("/books/notes.jpg", false, acceptBook), "ignores unlisted file types");
+  reopenUnchanged("replacing an entry keeps one row");
+  runner.expectEq(size_t(302), index.size(), "re-cased upload replaces the old row");
+  runner.expectTrue(index.entryAt(3, entry), "reads replaced row");
+  runner.expectEqual("book 0.epub", entry.name, "replaced row takes the new name");
+
+  runner.expectTrue(FileIndex::noteAdded("/other/Book.epub", false, acceptBook), "directory without index is a no-op");
+
+  index.close();
+  bool patched = true;
+  for (int i = 0; i < 100 && patched; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "Extra %d.epub", i);
+    entries.push_back({name, false});
+    patched = FileIndex::noteAdded(("/books/" + std::string(name)).c_str(), false, acceptBook);
+  }
+  runner.expectFalse(patched, "running out of spare rows fails the patch");
+  runner.expectFalse(SdMan.exists(rebuiltPath), "index without spare rows is dropped");
+  SdMan.registerDirectory("/books", entries);
+  runner.expectTrue(index.open("/books", acceptBook), "dropped index is rebuilt");
+  runner.expectEq(entries.size() - 4, index.size(), "rebuilt index includes every patched file");
+
+  // A known directory timestamp that moved forces a rebuild without the scan
+  index.close();
+  SdMan.setFileModifyDateTime("/books", 0x5A21, 0x6000);
+  runner.expectTrue(index.open("/books", acceptBook), "confirmed index stores directory timestamp");
+  reopenUnchanged("same timestamp reuses index");
+  index.close();
+  const std::string stamped = SdMan.getWrittenData(rebuiltPath);
+  SdMan.setFileModifyDateTime("/books", 0x5A21, 0x6001);
+  runner.expectTrue(index.open("/books", acceptBook), "opens after timestamp change");
+  runner.expectTrue(SdMan.getWrittenData(rebuiltPath) != stamped, "moved timestamp rebuilds index");
+
+  // Row table pointing outside the heap
+  index.close();
+  std::string damaged = SdMan.getWrittenData(rebuiltPath);
+  const size_t tableOffset = 36 + strlen("/books");
+  damaged.replace(tableOffset, 4, "\xFF\xFF\xFF\xFF");
+  SdMan.setFileData(rebuiltPath, damaged);
+  runner.expectTrue(index.open("/books", acceptBook), "rebuilds index with a damaged row table");
+  runner.expectTrue(index.entryAt(0, entry), "rebuilt table reads first row");
+
   index.close();
   SdMan.reset();
   SdMan.registerDirectory("/books", makeEntries(300));
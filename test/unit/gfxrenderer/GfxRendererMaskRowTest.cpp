@@ -0,0 +1,240 @@
+#include "test_utils.h"
+
+#include <EInkDisplay.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+class ExternalFont;
+class StreamingEpdFont;
+
+// Mirrors GfxRenderer::drawMaskRow: whole-byte merges for both landscape
+// orientations, a column walk for both portrait ones, per-pixel otherwise
+class GfxRenderer {
+ public:
+  enum Orientation {
+    Portrait,
+    LandscapeClockwise,
+    PortraitInverted,
+    LandscapeCounterClockwise
+  };
+
+  explicit GfxRenderer(EInkDisplay& display) : einkDisplay(display), orientation(Portrait) {}
+
+  void begin() { frameBuffer = einkDisplay.getFrameBuffer(); }
+
+  void setOrientation(const Orientation o) { orientation = o; }
+
+  uint8_t* getFrameBuffer() const { return frameBuffer; }
+
+  void clearScreen(uint8_t color = 0xFF) const { einkDisplay.clearScreen(color); }
+
+  int getScreenWidth() const {
+    return orientation == Portrait || orientation == PortraitInverted ? EInkDisplay::DISPLAY_HEIGHT
+                                                                      : EInkDisplay::DISPLAY_WIDTH;
+  }
+  int getScreenHeight() const {
+    return orientation == Portrait || orientation == PortraitInverted ? EInkDisplay::DISPLAY_WIDTH
+                                                                      : EInkDisplay::DISPLAY_HEIGHT;
+  }
+
+  void drawPixel(const int x, const int y, const bool state) const {
+    int rotatedX = 0, rotatedY = 0;
+    switch (orientation) {
+      case Portrait:
+        rotatedX = y;
+        rotatedY = EInkDisplay::DISPLAY_HEIGHT - 1 - x;
+        break;
+      case LandscapeClockwise:
+        rotatedX = EInkDisplay::DISPLAY_WIDTH - 1 - x;
+        rotatedY = EInkDisplay::DISPLAY_HEIGHT - 1 - y;
+        break;
+      case PortraitInverted:
+        rotatedX = EInkDisplay::DISPLAY_WIDTH - 1 - y;
+        rotatedY = x;
+        break;
+      case LandscapeCounterClockwise:
+      default:
+        rotatedX = x;
+        rotatedY = y;
+        break;
+    }
+    if (rotatedX < 0 || rotatedX >= static_cast<int>(EInkDisplay::DISPLAY_WIDTH) || rotatedY < 0 ||
+        rotatedY >= static_cast<int>(EInkDisplay::DISPLAY_HEIGHT)) {
+      return;
+    }
+    const uint16_t byteIndex = rotatedY * EInkDisplay::DISPLAY_WIDTH_BYTES + (rotatedX / 8);
+    const uint8_t bitPosition = 7 - (rotatedX % 8);
+    if (state)
+      frameBuffer[byteIndex] &= ~(1 << bitPosition);
+    else
+      frameBuffer[byteIndex] |= 1 << bitPosition;
+  }
+
+  void drawMaskRow(const uint8_t* row, const int x, const int y, const int width, const bool state) const {
+    const int screenW = getScreenWidth();
+    if (!row || y < 0 || y >= getScreenHeight()) return;
+    const int dxStart = std::max(0, -x);
+    const int dxEnd = std::min(width, screenW - x);
+    if (dxStart >= dxEnd) return;
+
+    const int panelW = EInkDisplay::DISPLAY_WIDTH;
+    const int panelH = EInkDisplay::DISPLAY_HEIGHT;
+    const int stride = EInkDisplay::DISPLAY_WIDTH_BYTES;
+    const int fullBytes = dxEnd >> 3;
+    const uint8_t tailMask = static_cast<uint8_t>(0xFF << (8 - (dxEnd & 7)));
+
+    switch (orientation) {
+      case LandscapeCounterClockwise:
+        if ((x & 7) == 0 && dxStart == 0) {
+          uint8_t* fbRow = frameBuffer + static_cast<size_t>(y) * stride + (x >> 3);
+          for (int i = 0; i < fullBytes; i++) mergeMaskByte(fbRow[i], row[i], state);
+          if (dxEnd & 7) mergeMaskByte(fbRow[fullBytes], row[fullBytes] & tailMask, state);
+          fastPaths++;
+          return;
+        }
+        break;
+      case LandscapeClockwise:
+        if (((panelW - x) & 7) == 0 && dxStart == 0) {
+          uint8_t* fbRow = frameBuffer + static_cast<size_t>(panelH - 1 - y) * stride;
+          const int lastByte = ((panelW - x) >> 3) - 1;
+          for (int i = 0; i < fullBytes; i++) mergeMaskByte(fbRow[lastByte - i], reverseBits(row[i]), state);
+          if (dxEnd & 7) mergeMaskByte(fbRow[lastByte - fullBytes], reverseBits(row[fullBytes] & tailMask), state);
+          fastPaths++;
+          return;
+        }
+        break;
+      case Portrait:
+      case PortraitInverted: {
+        const bool portrait = orientation == Portrait;
+        const int physX = portrait ? y : panelW - 1 - y;
+        const uint8_t bit = static_cast<uint8_t>(0x80 >> (physX & 7));
+        const ptrdiff_t step = portrait ? -static_cast<ptrdiff_t>(stride) : stride;
+        const ptrdiff_t origin =
+            static_cast<ptrdiff_t>(portrait ? panelH - 1 - x : x) * stride + static_cast<ptrdiff_t>(physX >> 3);
+        for (int dx = dxStart; dx < dxEnd;) {
+          const uint8_t bits = row[dx >> 3];
+          const int byteEnd = std::min((dx & ~7) + 8, dxEnd);
+          if (bits != 0) {
+            for (int i = dx; i < byteEnd; i++) {
+              if (bits & (0x80 >> (i & 7))) mergeMaskByte(frameBuffer[origin + i * step], bit, state);
+            }
+          }
+          dx = byteEnd;
+        }
+        fastPaths++;
+        return;
+      }
+    }
+
+    for (int byteX = dxStart & ~7; byteX < dxEnd; byteX += 8) {
+      const uint8_t bits = row[byteX >> 3];
+      if (bits == 0) continue;
+      const int bitEnd = std::min(8, dxEnd - byteX);
+      for (int bit = std::max(0, dxStart - byteX); bit < bitEnd; bit++) {
+        if (bits & (0x80 >> bit)) drawPixel(x + byteX + bit, y, state);
+      }
+    }
+  }
+
+  void drawMaskRowRef(const uint8_t* row, const int x, const int y, const int width, const bool state) const {
+    for (int dx = 0; dx < width; dx++) {
+      const int sx = x + dx;
+      if (sx < 0 || sx >= getScreenWidth() || y < 0 || y >= getScreenHeight()) continue;
+      if (row[dx >> 3] & (0x80 >> (dx & 7))) drawPixel(sx, y, state);
+    }
+  }
+
+  mutable int fastPaths = 0;
+
+ private:
+  EInkDisplay& einkDisplay;
+  Orientation orientation;
+  uint8_t* frameBuffer = nullptr;
+
+  static uint8_t reverseBits(uint8_t b) {
+    b = static_cast<uint8_t>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = static_cast<uint8_t>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    return static_cast<uint8_t>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+  }
+
+  static void mergeMaskByte(uint8_t& target, const uint8_t bits, const bool state) {
+    if (state) {
+      target &= static_cast<uint8_t>(~bits);
+    } else {
+      target |= bits;
+    }
+  }
+};
+
+// Draws the same mask row through drawMaskRow and per pixel, on the same background
+static bool matchesReference(GfxRenderer::Orientation orientation, const std::vector<uint8_t>& row, int x, int y,
+                             int width, bool state, bool* usedFastPath = nullptr) {
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  gfx.begin();
+  gfx.setOrientation(orientation);
+  const uint8_t background = state ? 0xFF : 0x00;
+
+  gfx.clearScreen(background);
+  gfx.drawMaskRowRef(row.data(), x, y, width, state);
+  std::vector<uint8_t> expected(gfx.getFrameBuffer(), gfx.getFrameBuffer() + EInkDisplay::BUFFER_SIZE);
+
+  gfx.clearScreen(background);
+  gfx.drawMaskRow(row.data(), x, y, width, state);
+  if (usedFastPath) *usedFastPath = gfx.fastPaths > 0;
+  return memcmp(expected.data(), gfx.getFrameBuffer(), EInkDisplay::BUFFER_SIZE) == 0;
+}
+
+int main() {
+  TestUtils::TestRunner runner("GfxRendererMaskRow");
+
+  // 61 pixels: seven full bytes and a five-bit tail with its padding bits set
+  std::vector<uint8_t> row = {0x81, 0x00, 0xFF, 0x3C, 0x00, 0xA5, 0x0F, 0xFF};
+  constexpr int kWidth = 61;
+
+  const GfxRenderer::Orientation orientations[] = {GfxRenderer::Portrait, GfxRenderer::LandscapeClockwise,
+                                                   GfxRenderer::PortraitInverted,
+                                                   GfxRenderer::LandscapeCounterClockwise};
+  const char* names[] = {"portrait", "landscape_cw", "portrait_inverted", "landscape_ccw"};
+
+  // Byte-aligned and unaligned x, black and white, against the per-pixel reference
+  for (int o = 0; o < 4; o++) {
+    for (const int x : {0, 8, 16, 3, 13}) {
+      for (const bool state : {true, false}) {
+        const std::string label = std::string(names[o]) + "_x" + std::to_string(x) + (state ? "_black" : "_white");
+        runner.expectTrue(matchesReference(orientations[o], row, x, 37, kWidth, state), label);
+      }
+    }
+  }
+
+  // Clipped at both screen edges
+  for (int o = 0; o < 4; o++) {
+    runner.expectTrue(matchesReference(orientations[o], row, -9, 5, kWidth, true), std::string(names[o]) + "_left");
+    runner.expectTrue(matchesReference(orientations[o], row, 440, 5, kWidth, true), std::string(names[o]) + "_right");
+    runner.expectTrue(matchesReference(orientations[o], row, 0, 0, kWidth, true), std::string(names[o]) + "_top");
+  }
+
+  // Rows outside the screen draw nothing
+  {
+    runner.expectTrue(matchesReference(GfxRenderer::Portrait, row, 0, -1, kWidth, true), "portrait_above");
+    runner.expectTrue(matchesReference(GfxRenderer::Portrait, row, 0, 800, kWidth, true), "portrait_below");
+    runner.expectTrue(matchesReference(GfxRenderer::LandscapeClockwise, row, 800, 0, kWidth, true), "cw_off_right");
+  }
+
+  // Every orientation takes a fast path at a byte-aligned x; portrait at any x
+  {
+    bool fast = false;
+    for (int o = 0; o < 4; o++) {
+      matchesReference(orientations[o], row, 16, 37, kWidth, true, &fast);
+      runner.expectTrue(fast, std::string(names[o]) + "_aligned_fast_path");
+    }
+    matchesReference(GfxRenderer::Portrait, row, 13, 37, kWidth, true, &fast);
+    runner.expectTrue(fast, "portrait_unaligned_fast_path");
+    matchesReference(GfxRenderer::LandscapeCounterClockwise, row, 13, 37, kWidth, true, &fast);
+    runner.expectFalse(fast, "landscape_unaligned_per_pixel");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
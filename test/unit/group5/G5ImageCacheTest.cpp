@@ -104,6 +104,90 @@ int main() {
     runner.expectTrue(decoded == rows, "aligned: byte-boundary runs round-trip");
   }
 
+  {
+    SdMan.reset();
+    // 2-bit image as two planes: plane 0 = high bit, plane 1 = low bit
+    const std::vector<uint8_t> hi = {0xF0, 0x0F, 0xFF, 0x00};
+    const std::vector<uint8_t> lo = {0xCC, 0x33, 0x00, 0xAA};
+    const bool written =
+        G5ImageCache::compressPlanesToFile(8, 4, 2,
+                                           [&](int plane, int y, uint8_t* row) {
+                                             row[0] = (plane == 0 ? hi : lo)[static_cast<size_t>(y)];
+                                             return true;
+                                           },
+                                           "/planes.g5");
+    runner.expectTrue(written, "planes: compression succeeds");
+    SdMan.registerFile("/planes.g5", SdMan.getWrittenData("/planes.g5"));
+
+    int planeCount = 0;
+    runner.expectTrue(G5ImageCache::readHeader("/planes.g5", parsed, &planeCount), "planes: header valid");
+    runner.expectEq(2, planeCount, "planes: both planes counted");
+    runner.expectEq(static_cast<uint16_t>(8), parsed.width, "planes: width");
+
+    std::vector<uint8_t> decodedHi, decodedLo;
+    const bool ok = G5ImageCache::decompressPlanesFromFile(
+        "/planes.g5", [&](const uint8_t* const* planes, int count, int rowBytes, int) {
+          runner.expectEq(2, count, "planes: callback plane count");
+          runner.expectEq(1, rowBytes, "planes: callback row width");
+          decodedHi.push_back(planes[0][0]);
+          decodedLo.push_back(planes[1][0]);
+        });
+    runner.expectTrue(ok, "planes: decompression succeeds");
+    runner.expectTrue(decodedHi == hi, "planes: high plane round-trips");
+    runner.expectTrue(decodedLo == lo, "planes: low plane round-trips");
+
+    // Single-plane readers still see the first plane
+    std::vector<uint8_t> first;
+    G5ImageCache::decompressFromFile("/planes.g5", [&](const uint8_t* row, int, int) { first.push_back(row[0]); });
+    runner.expectTrue(first == hi, "planes: decompressFromFile returns plane 0");
+  }
+
+  {
+    SdMan.reset();
+    const std::vector<uint8_t> rows = {0x81, 0x42};
+    runner.expectTrue(G5ImageCache::compressToFile(rows.data(), 8, 2, "/single.g5"), "single: compression succeeds");
+    SdMan.registerFile("/single.g5", SdMan.getWrittenData("/single.g5"));
+    int planeCount = 0;
+    runner.expectTrue(G5ImageCache::readHeader("/single.g5", parsed, &planeCount), "single: header valid");
+    runner.expectEq(1, planeCount, "single: one plane");
+    int callbacks = 0;
+    runner.expectTrue(G5ImageCache::decompressPlanesFromFile("/single.g5",
+                                                             [&](const uint8_t* const*, int count, int, int) {
+                                                               runner.expectEq(1, count, "single: plane count");
+                                                               callbacks++;
+                                                             }),
+                      "single: plane decoder accepts one plane");
+    runner.expectEq(2, callbacks, "single: one callback per row");
+  }
+
+  {
+    SdMan.reset();
+    // A second plane with different dimensions is corrupt
+    const std::vector<uint8_t> rows = {0x81, 0x42};
+    G5ImageCache::compressToFile(rows.data(), 8, 2, "/a.g5");
+    G5ImageCache::compressToFile(rows.data(), 16, 1, "/b.g5");
+    SdMan.registerFile("/mismatch.g5", SdMan.getWrittenData("/a.g5") + SdMan.getWrittenData("/b.g5"));
+    int callbacks = 0;
+    runner.expectFalse(G5ImageCache::decompressPlanesFromFile(
+                           "/mismatch.g5", [&](const uint8_t* const*, int, int, int) { callbacks++; }),
+                       "planes: rejects mismatched plane dimensions");
+    runner.expectEq(0, callbacks, "planes: mismatched planes invoke no callbacks");
+    int planeCount = 0;
+    runner.expectTrue(G5ImageCache::readHeader("/mismatch.g5", parsed, &planeCount), "planes: first header valid");
+    runner.expectEq(1, planeCount, "planes: mismatched plane not counted");
+  }
+
+  {
+    SdMan.reset();
+    runner.expectFalse(G5ImageCache::compressPlanesToFile(
+                           8, 1, 1, [](int, int, uint8_t*) { return false; }, "/fail.g5"),
+                       "planes: row source failure aborts");
+    runner.expectFalse(SdMan.exists("/fail.g5"), "planes: failed output removed");
+    runner.expectFalse(G5ImageCache::compressPlanesToFile(
+                           8, 1, 3, [](int, int, uint8_t*) { return true; }, "/three.g5"),
+                       "planes: rejects more than MAX_PLANES");
+  }
+
   {
     uint8_t payload[] = {0};
     uint8_t row[] = {0};
@@ -1,15 +1,39 @@
 #include "test_utils.h"
 
+#include <ByteSource.h>
 #include <ImageConverter.h>
 #include <SDCardManager.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <utility>
 
 namespace {
 
 const std::string kPngSignature("\x89PNG\r\n\x1A\n", 8);
 
+// In-memory stand-in for a ZIP entry reader, handing out at most `chunk` bytes per read
+class StringByteSource : public ByteSource {
+ public:
+  StringByteSource(std::string data, size_t chunk = 3) : data_(std::move(data)), chunk_(chunk) {}
+
+  int read(uint8_t* buffer, size_t len) override {
+    const size_t n = std::min({len, chunk_, data_.size() - pos_});
+    memcpy(buffer, data_.data() + pos_, n);
+    pos_ += n;
+    return static_cast<int>(n);
+  }
+
+  size_t size() const override { return data_.size(); }
+
+ private:
+  std::string data_;
+  size_t chunk_;
+  size_t pos_ = 0;
+};
+
 void registerSources() {
   SdMan.reset();
   SdMan.registerFile("/neutral.img", std::string("\xFF\xD8jpeg", 6));
@@ -71,5 +95,36 @@ int main() {
                      "unknown source is not converted");
   runner.expectFalse(SdMan.exists("/unknown.bmp"), "unknown source does not create output");
 
+  // Streamed sources: format comes from the first bytes, no source file on the SD card
+  {
+    StringByteSource jpeg(std::string("\xFF\xD8jpeg", 6));
+    runner.expectTrue(ImageConverterFactory::convertToBmp(jpeg, "/stream-jpeg.bmp", {}), "stream: JPEG converts");
+    runner.expectTrue(SdMan.getWrittenData("/stream-jpeg.bmp") == "JPEG", "stream: JPEG converter selected");
+
+    StringByteSource png(kPngSignature + "payload");
+    runner.expectTrue(ImageConverterFactory::convertToBmp(png, "/stream-png.bmp", {}), "stream: PNG converts");
+    runner.expectTrue(SdMan.getWrittenData("/stream-png.bmp") == "PNG", "stream: PNG converter selected");
+
+    StringByteSource gif("GIF89a");
+    runner.expectFalse(ImageConverterFactory::convertToBmp(gif, "/stream-gif.bmp", {}),
+                       "stream: unknown signature rejected");
+    runner.expectFalse(SdMan.exists("/stream-gif.bmp"), "stream: unknown signature creates no output");
+
+    StringByteSource shortSource("\xFF");
+    runner.expectFalse(ImageConverterFactory::convertToBmp(shortSource, "/stream-short.bmp", {}),
+                       "stream: truncated signature rejected");
+
+    // BMP needs seeking, so it is spooled to a file and the spool is removed afterwards
+    StringByteSource bmp("BMpayload");
+    runner.expectFalse(ImageConverterFactory::convertToBmp(bmp, "/stream-bmp.bmp", {}),
+                       "stream: invalid BMP payload is rejected");
+    runner.expectFalse(SdMan.exists("/stream-bmp.bmp.src"), "stream: BMP spool removed");
+    runner.expectFalse(SdMan.exists("/stream-bmp.bmp"), "stream: rejected BMP publishes nothing");
+
+    runner.expectTrue(ImageConverterFactory::detectFormat(reinterpret_cast<const uint8_t*>("BM"), 2) ==
+                          ImageFormat::Bmp,
+                      "signature bytes: BMP detected");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
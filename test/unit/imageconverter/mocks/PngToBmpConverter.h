@@ -4,6 +4,7 @@
 
 #include <functional>
 
+class ByteSource;
 class FsFile;
 
 class PngToBmpConverter {
@@ -17,4 +18,8 @@ class PngToBmpConverter {
                                          const std::function<bool()>& = nullptr) {
     return writeMarker(output);
   }
+  static bool pngStreamToBmpStream(ByteSource&, Print& output, int, int, bool = false, bool = false,
+                                   const std::function<bool()>& = nullptr) {
+    return writeMarker(output);
+  }
 };
@@ -2,6 +2,7 @@
 
 #include <ImageConverter.h>
 #include <SDCardManager.h>
+#include <picojpeg.h>
 #include <platform_stubs.h>
 
 #include <cstdint>
@@ -57,6 +58,21 @@ int main() {
   runner.expectEq(8, read32Signed(output, 18), "small JPEG width is not upscaled");
   runner.expectEq(-16, read32Signed(output, 22), "JPEG output is top-down at native height");
 
+  // Half-size target: decoded at 1/2 in the DCT domain, no area averaging left to do
+  {
+    ImageConvertConfig half = config;
+    half.maxWidth = 4;
+    half.maxHeight = 8;
+    half.validateOutput = nullptr;
+    runner.expectTrue(ImageConverterFactory::convertToBmp("/cover.img", "/half.bmp", half),
+                      "half-size JPEG conversion succeeds");
+    runner.expectEq(static_cast<unsigned char>(PJPG_SCALE_1_2), fake_picojpeg::scale, "JPEG decoded at 1/2");
+    const std::string halfOut = SdMan.getWrittenData("/half.bmp");
+    runner.expectTrue(halfOut.size() == 62 + 4 * 8, "half-size output contains every declared row");
+    runner.expectEq(4, read32Signed(halfOut, 18), "half-size width");
+    runner.expectEq(-8, read32Signed(halfOut, 22), "half-size height");
+  }
+
   SdMan.remove("/cover.bmp");
   int checks = 0;
   config.shouldAbort = [&checks]() { return ++checks >= 5; };
@@ -0,0 +1,256 @@
+// picojpeg scaled decoding tests - 1/2, 1/4 and 1/8 Y decoding (pjpeg_set_scale) against
+// a box-filtered full-size decode, plus JpegToBmpConverter's scale selection.
+
+#include "test_utils.h"
+
+#include <JpegToBmpConverter.h>
+#include <picojpeg.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 40x24 baseline JPEG, YCbCr 4:2:0 (H2V2), quality 85: gradient, dark disc, light bars
+const uint8_t kJpeg420[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x05, 0x03, 0x04, 0x04, 0x04, 0x03, 0x05,
+    0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x06, 0x07, 0x0C, 0x08, 0x07, 0x07, 0x07, 0x07, 0x0F, 0x0B,
+    0x0B, 0x09, 0x0C, 0x11, 0x0F, 0x12, 0x12, 0x11, 0x0F, 0x11, 0x11, 0x13, 0x16, 0x1C, 0x17, 0x13,
+    0x14, 0x1A, 0x15, 0x11, 0x11, 0x18, 0x21, 0x18, 0x1A, 0x1D, 0x1D, 0x1F, 0x1F, 0x1F, 0x13, 0x17,
+    0x22, 0x24, 0x22, 0x1E, 0x24, 0x1C, 0x1E, 0x1F, 0x1E, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x05, 0x05,
+    0x05, 0x07, 0x06, 0x07, 0x0E, 0x08, 0x08, 0x0E, 0x1E, 0x14, 0x11, 0x14, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0,
+    0x00, 0x11, 0x08, 0x00, 0x18, 0x00, 0x28, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xFF, 0xC4, 0x00, 0x18, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x07, 0x04, 0xFF, 0xC4, 0x00, 0x2D, 0x10,
+    0x00, 0x00, 0x05, 0x03, 0x02, 0x04, 0x03, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x11, 0x22, 0x31, 0x07, 0x12, 0x13, 0x32, 0x41, 0x51,
+    0xA2, 0x08, 0x14, 0x21, 0x23, 0x43, 0x71, 0x81, 0x91, 0xA1, 0xFF, 0xC4, 0x00, 0x17, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+    0x07, 0x06, 0x04, 0xFF, 0xC4, 0x00, 0x28, 0x11, 0x00, 0x02, 0x01, 0x04, 0x00, 0x03, 0x08, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x00, 0x04, 0x05, 0x11, 0x06,
+    0x13, 0x31, 0x12, 0x21, 0x41, 0x51, 0x71, 0xA1, 0xB1, 0xD1, 0x61, 0xB2, 0xC1, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xE3, 0x50, 0xE9, 0xFB, 0x69,
+    0x1D, 0x73, 0x8A, 0x08, 0x65, 0x36, 0x75, 0x8A, 0x97, 0x9D, 0x6D, 0xBE, 0x5A, 0x76, 0x0B, 0x9D,
+    0x44, 0x5F, 0x4D, 0x9F, 0x31, 0x90, 0x87, 0x4F, 0xDB, 0x48, 0xB7, 0xC6, 0x63, 0x35, 0x58, 0xDC,
+    0x3E, 0x52, 0x8C, 0xCC, 0xCE, 0x98, 0x66, 0x66, 0x7E, 0x3F, 0x29, 0x81, 0x44, 0xCD, 0x5E, 0x1C,
+    0xA7, 0x11, 0x62, 0xD0, 0x36, 0xB4, 0xF2, 0xFB, 0xC3, 0x27, 0xD5, 0x1B, 0x6F, 0x1F, 0x26, 0xD6,
+    0x63, 0xAF, 0x01, 0xFB, 0x0A, 0xD1, 0x70, 0x32, 0x3A, 0x5B, 0xB9, 0x24, 0x3A, 0x83, 0x23, 0x4A,
+    0xA0, 0xAB, 0x06, 0x5B, 0x19, 0x73, 0xB6, 0x22, 0x43, 0xA7, 0xED, 0xA4, 0x54, 0xF6, 0x6B, 0x4A,
+    0x94, 0x53, 0x1C, 0x51, 0x99, 0x92, 0x49, 0xC4, 0x27, 0x27, 0xB1, 0x65, 0xB3, 0xC1, 0x7E, 0x4C,
+    0xC5, 0x88, 0x74, 0xFD, 0xB4, 0x89, 0xB6, 0x63, 0x24, 0x71, 0xFC, 0x47, 0x90, 0x8C, 0xB6, 0xFB,
+    0xA2, 0x1B, 0xF4, 0x0F, 0xF7, 0x4A, 0xC1, 0x17, 0x36, 0xD6, 0x23, 0xAF, 0x3F, 0xE5, 0x55, 0xB9,
+    0x62, 0xF5, 0x28, 0x96, 0xF2, 0x31, 0xD9, 0x17, 0x1E, 0x86, 0xC0, 0x5C, 0xA8, 0x45, 0xEA, 0xC0,
+    0xA6, 0x23, 0x1D, 0x8C, 0xE3, 0xD2, 0x90, 0x13, 0xBC, 0x66, 0x7B, 0x91, 0x6C, 0x13, 0x7E, 0x2D,
+    0xEE, 0xEC, 0x69, 0x49, 0x6D, 0xBB, 0x4F, 0xBF, 0x4F, 0x81, 0x5C, 0xB2, 0x1D, 0x3F, 0x6D, 0x23,
+    0x5F, 0x7B, 0x5B, 0xD4, 0xFA, 0xD5, 0x1A, 0xDD, 0x44, 0xF8, 0xDD, 0x6F, 0x77, 0x8C, 0x64, 0x8D,
+    0x6A, 0x4E, 0x32, 0x96, 0xF3, 0xB1, 0x97, 0x91, 0x00, 0x0D, 0x2E, 0x7B, 0x27, 0x75, 0x0E, 0x46,
+    0xD6, 0x68, 0x9C, 0xAB, 0x29, 0x7D, 0x10, 0x48, 0x23, 0x68, 0x47, 0x51, 0xF8, 0xAE, 0x4B, 0x68,
+    0x51, 0xA2, 0x75, 0x23, 0x60, 0xEB, 0xE6, 0xAA, 0x58, 0x14, 0xC8, 0xF4, 0xC7, 0x3A, 0x11, 0x59,
+    0x4B, 0x4C, 0xB6, 0xC1, 0xA5, 0x29, 0x4F, 0x87, 0xC4, 0xBF, 0x7F, 0x71, 0xEB, 0x87, 0x4F, 0xDB,
+    0x48, 0x00, 0x9D, 0x64, 0xEF, 0xE7, 0x6B, 0xC9, 0xA4, 0x66, 0xDB, 0x36, 0xB6, 0x7C, 0xFA, 0xD2,
+    0x90, 0xC6, 0xA1, 0x14, 0x01, 0x5A, 0x16, 0xE2, 0xF5, 0x10, 0xCA, 0x31, 0xD8, 0x9C, 0x7F, 0x08,
+    0x00, 0x06, 0x1A, 0x7B, 0xC9, 0x51, 0xB4, 0x0D, 0x22, 0xB1, 0xA9, 0x15, 0xFF, 0xD9,
+};
+
+// Same pattern at 24x32 with H1V2 sampling (two Y blocks stacked per MCU)
+const uint8_t kJpegH1V2[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x05, 0x03, 0x04, 0x04, 0x04, 0x03, 0x05,
+    0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x06, 0x07, 0x0C, 0x08, 0x07, 0x07, 0x07, 0x07, 0x0F, 0x0B,
+    0x0B, 0x09, 0x0C, 0x11, 0x0F, 0x12, 0x12, 0x11, 0x0F, 0x11, 0x11, 0x13, 0x16, 0x1C, 0x17, 0x13,
+    0x14, 0x1A, 0x15, 0x11, 0x11, 0x18, 0x21, 0x18, 0x1A, 0x1D, 0x1D, 0x1F, 0x1F, 0x1F, 0x13, 0x17,
+    0x22, 0x24, 0x22, 0x1E, 0x24, 0x1C, 0x1E, 0x1F, 0x1E, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x05, 0x05,
+    0x05, 0x07, 0x06, 0x07, 0x0E, 0x08, 0x08, 0x0E, 0x1E, 0x14, 0x11, 0x14, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0,
+    0x00, 0x11, 0x08, 0x00, 0x20, 0x00, 0x18, 0x03, 0x01, 0x12, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xFF, 0xC4, 0x00, 0x19, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x05, 0x07, 0x04, 0x06, 0x08, 0xFF, 0xC4, 0x00, 0x2B,
+    0x10, 0x00, 0x00, 0x04, 0x04, 0x05, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x00, 0x04, 0x05, 0x31, 0x06, 0x07, 0x12, 0x13, 0x21, 0x22, 0x32,
+    0x41, 0xA2, 0x43, 0x44, 0x51, 0x61, 0x91, 0xA1, 0xA3, 0xFF, 0xC4, 0x00, 0x17, 0x01, 0x00, 0x03,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06,
+    0x07, 0x08, 0xFF, 0xC4, 0x00, 0x2B, 0x11, 0x00, 0x01, 0x02, 0x05, 0x02, 0x04, 0x05, 0x05, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x00, 0x04, 0x05, 0x11, 0x21, 0x12,
+    0x41, 0x06, 0x07, 0x14, 0x22, 0x31, 0x61, 0x91, 0xB1, 0xD1, 0x13, 0x42, 0xA2, 0xC1, 0xE1, 0xFF,
+    0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0x8E, 0xD2, 0xA5,
+    0x2D, 0xC4, 0x0C, 0xCC, 0xCA, 0xA4, 0x54, 0xC9, 0x24, 0x73, 0x26, 0x52, 0x0B, 0x74, 0xF0, 0x2E,
+    0x1F, 0x78, 0xD1, 0xCE, 0x89, 0x89, 0xB4, 0xEA, 0x06, 0xC0, 0xC2, 0xC0, 0x29, 0x41, 0xB4, 0x5B,
+    0x71, 0xCA, 0x1A, 0xF0, 0xA6, 0x0C, 0x2B, 0x76, 0xD3, 0xDB, 0xF9, 0xA3, 0x0A, 0xF3, 0x1A, 0xAC,
+    0xB5, 0x37, 0x0A, 0x65, 0xE2, 0xC2, 0x61, 0x3A, 0x47, 0xA7, 0x80, 0xAE, 0x51, 0x28, 0x18, 0x4E,
+    0x1B, 0x68, 0x3D, 0xFC, 0xF2, 0x3E, 0x6F, 0x78, 0xCD, 0xFC, 0x0F, 0x4E, 0x9C, 0x7E, 0xB7, 0x5F,
+    0xE9, 0xEC, 0x4A, 0x1D, 0xC8, 0xDC, 0xF7, 0xBD, 0xE1, 0xE9, 0xBD, 0xA1, 0xAA, 0xA0, 0xEB, 0x69,
+    0x97, 0x96, 0xD5, 0xBA, 0x7F, 0x49, 0x8D, 0x9F, 0x29, 0x90, 0xDA, 0xAC, 0xAE, 0x66, 0xF9, 0x53,
+    0x07, 0xB1, 0x21, 0xAE, 0x5E, 0x21, 0xB5, 0x50, 0x50, 0xCD, 0x74, 0x04, 0x3D, 0x8B, 0x08, 0xBC,
+    0xC5, 0xA8, 0xF5, 0x52, 0x48, 0x45, 0xFE, 0xF0, 0x7F, 0x15, 0x41, 0x1A, 0x5B, 0x5A, 0x1C, 0x27,
+    0xCB, 0xE2, 0x39, 0xC6, 0xBB, 0x4F, 0x98, 0x93, 0x9C, 0x51, 0x43, 0xA6, 0x7D, 0x95, 0x0C, 0xE5,
+    0x53, 0x4F, 0x48, 0xBF, 0x2C, 0xFF, 0x00, 0x5B, 0xFE, 0x22, 0xBD, 0x4A, 0x93, 0xB7, 0x11, 0x7C,
+    0x6F, 0x98, 0xAA, 0x91, 0x6C, 0x36, 0xE3, 0x61, 0x60, 0x78, 0x66, 0xC7, 0xCB, 0x63, 0xED, 0xFD,
+    0x5A, 0x34, 0xAF, 0xA8, 0x6E, 0x0D, 0xA3, 0x0F, 0x30, 0x68, 0xB3, 0xB5, 0xCC, 0x2D, 0x97, 0x12,
+    0x92, 0x88, 0xAA, 0x24, 0x1A, 0x78, 0x15, 0x55, 0x4A, 0x47, 0x2A, 0x45, 0x14, 0x90, 0xEA, 0x1B,
+    0x05, 0x80, 0x78, 0x7E, 0x59, 0x82, 0x2A, 0x53, 0x68, 0x6B, 0xA7, 0xD2, 0x8A, 0xDD, 0xA8, 0x00,
+    0x7A, 0x96, 0x22, 0x1C, 0x3B, 0xC7, 0xF3, 0x14, 0x6A, 0x95, 0x62, 0x62, 0x59, 0x00, 0x2A, 0x61,
+    0xC2, 0x41, 0x39, 0xD3, 0xDC, 0xE1, 0xC6, 0xC4, 0x8D, 0x5B, 0x8B, 0x5C, 0x64, 0x5B, 0x10, 0xC3,
+    0x35, 0x4C, 0x4B, 0xED, 0x30, 0x95, 0x9C, 0x24, 0x7A, 0xE0, 0x7C, 0x40, 0xE1, 0x34, 0x36, 0x97,
+    0x39, 0x9B, 0xE1, 0xB7, 0xEC, 0x21, 0xAD, 0x29, 0x0D, 0xA2, 0xEA, 0x6B, 0x83, 0x44, 0xDA, 0xBB,
+    0x51, 0xEA, 0x92, 0x11, 0x7D, 0xEF, 0xEF, 0x05, 0xA5, 0xDA, 0xD1, 0x98, 0xFF, 0xD9,
+};
+
+struct MemoryReader {
+  const uint8_t* data;
+  size_t size;
+  size_t pos;
+};
+
+unsigned char readCallback(unsigned char* buf, const unsigned char bufSize, unsigned char* bytesRead, void* ctx) {
+  auto* reader = static_cast<MemoryReader*>(ctx);
+  const size_t n = std::min<size_t>(bufSize, reader->size - reader->pos);
+  memcpy(buf, reader->data + reader->pos, n);
+  reader->pos += n;
+  *bytesRead = static_cast<unsigned char>(n);
+  return 0;
+}
+
+struct Decoded {
+  bool ok = false;
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+// Decode the Y plane at 1 / (1 << scale), collecting blocks the way JpegToBmpConverter does
+Decoded decode(const uint8_t* data, const size_t size, const unsigned char scale) {
+  Decoded out;
+  MemoryReader reader = {data, size, 0};
+  pjpeg_image_info_t info;
+  if (pjpeg_decode_init(&info, readCallback, &reader, PJPG_GRAYSCALE_ONLY) != 0) return out;
+  if (pjpeg_set_scale(scale) != 0) return out;
+
+  const int round = (1 << scale) - 1;
+  out.width = (info.m_width + round) >> scale;
+  out.height = (info.m_height + round) >> scale;
+  out.pixels.assign(static_cast<size_t>(out.width) * out.height, 0);
+  const int mcuWidth = info.m_MCUWidth >> scale;
+  const int mcuHeight = info.m_MCUHeight >> scale;
+  const int blockPixels = 8 >> scale;
+
+  for (int mcuY = 0; mcuY < info.m_MCUSPerCol; mcuY++) {
+    for (int mcuX = 0; mcuX < info.m_MCUSPerRow; mcuX++) {
+      if (pjpeg_decode_mcu() != 0) return out;
+      for (int y = 0; y < mcuHeight; y++) {
+        for (int x = 0; x < mcuWidth; x++) {
+          const int px = mcuX * mcuWidth + x;
+          const int py = mcuY * mcuHeight + y;
+          if (px >= out.width || py >= out.height) continue;
+          const int offset =
+              (y / blockPixels) * 128 + (x / blockPixels) * 64 + (y % blockPixels) * 8 + (x % blockPixels);
+          out.pixels[py * out.width + px] = info.m_pMCUBufR[offset];
+        }
+      }
+    }
+  }
+  out.ok = true;
+  return out;
+}
+
+struct Difference {
+  double mean = 0;
+  int max = 0;
+};
+
+// Compare a scaled decode with the box average of the full decode over whole source squares
+Difference compareWithBoxAverage(const Decoded& full, const Decoded& scaled, const int factor) {
+  Difference diff;
+  long total = 0;
+  int count = 0;
+  for (int y = 0; y < full.height / factor; y++) {
+    for (int x = 0; x < full.width / factor; x++) {
+      int sum = 0;
+      for (int dy = 0; dy < factor; dy++) {
+        for (int dx = 0; dx < factor; dx++) sum += full.pixels[(y * factor + dy) * full.width + x * factor + dx];
+      }
+      const int d = std::abs(sum / (factor * factor) - scaled.pixels[y * scaled.width + x]);
+      total += d;
+      diff.max = std::max(diff.max, d);
+      count++;
+    }
+  }
+  diff.mean = count > 0 ? static_cast<double>(total) / count : 0;
+  return diff;
+}
+
+void checkScales(TestUtils::TestRunner& runner, const uint8_t* data, const size_t size, const char* label) {
+  const Decoded full = decode(data, size, PJPG_SCALE_1_1);
+  runner.expectTrue(full.ok, std::string(label) + ": full decode");
+
+  // Reduced IDCTs drop the high-frequency terms, so edges differ a little from a plain box filter;
+  // 1/8 is the exact block average
+  const struct {
+    unsigned char scale;
+    double maxMean;
+    int maxDiff;
+  } cases[] = {{PJPG_SCALE_1_2, 3.0, 24}, {PJPG_SCALE_1_4, 3.0, 16}, {PJPG_SCALE_1_8, 1.0, 2}};
+
+  for (const auto& c : cases) {
+    const int factor = 1 << c.scale;
+    const std::string name = std::string(label) + " 1/" + std::to_string(factor);
+    const Decoded scaled = decode(data, size, c.scale);
+    runner.expectTrue(scaled.ok, name + ": decodes");
+    runner.expectEq((full.width + factor - 1) / factor, scaled.width, name + ": width rounds up");
+    runner.expectEq((full.height + factor - 1) / factor, scaled.height, name + ": height rounds up");
+    const Difference diff = compareWithBoxAverage(full, scaled, factor);
+    runner.expectTrue(diff.mean <= c.maxMean, name + ": mean difference to box average");
+    runner.expectTrue(diff.max <= c.maxDiff, name + ": max difference to box average");
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("PicojpegScale");
+
+  // Test 1: scaled Y decoding tracks the box-filtered full decode (H2V2 with partial MCUs)
+  checkScales(runner, kJpeg420, sizeof(kJpeg420), "H2V2");
+
+  // Test 2: H1V2 keeps the lower Y block at offset 128 at every scale
+  checkScales(runner, kJpegH1V2, sizeof(kJpegH1V2), "H1V2");
+
+  // Test 3: scaling is only available in grayscale-only mode, and only up to 1/8
+  {
+    MemoryReader reader = {kJpeg420, sizeof(kJpeg420), 0};
+    pjpeg_image_info_t info;
+    runner.expectEq(0, static_cast<int>(pjpeg_decode_init(&info, readCallback, &reader, PJPG_FULL_DECODE)),
+                    "full decode init");
+    runner.expectEq(static_cast<int>(PJPG_UNSUPPORTED_MODE), static_cast<int>(pjpeg_set_scale(PJPG_SCALE_1_2)),
+                    "scale rejected for color decode");
+    runner.expectEq(0, static_cast<int>(pjpeg_set_scale(PJPG_SCALE_1_1)), "1/1 always accepted");
+
+    reader.pos = 0;
+    runner.expectEq(0, static_cast<int>(pjpeg_decode_init(&info, readCallback, &reader, PJPG_GRAYSCALE_ONLY)),
+                    "grayscale init");
+    runner.expectEq(static_cast<int>(PJPG_UNSUPPORTED_MODE), static_cast<int>(pjpeg_set_scale(4)),
+                    "scale beyond 1/8 rejected");
+  }
+
+  // Test 4: converter picks the smallest decode that still covers the output size
+  {
+    runner.expectEq(0, JpegToBmpConverter::decodeScaleFor(480, 800, 480, 800), "no downscale: full decode");
+    runner.expectEq(0, JpegToBmpConverter::decodeScaleFor(600, 900, 400, 600), "under 2x: full decode");
+    runner.expectEq(1, JpegToBmpConverter::decodeScaleFor(960, 1600, 480, 800), "exact 2x: 1/2");
+    runner.expectEq(2, JpegToBmpConverter::decodeScaleFor(1600, 2400, 320, 480), "5x: 1/4");
+    runner.expectEq(3, JpegToBmpConverter::decodeScaleFor(4000, 6000, 100, 150), "40x: capped at 1/8");
+    runner.expectEq(1, JpegToBmpConverter::decodeScaleFor(1600, 900, 800, 300), "limited by the tighter axis");
+    runner.expectEq(0, JpegToBmpConverter::decodeScaleFor(801, 1200, 401, 600), "odd sizes never undershoot");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -27,12 +27,17 @@ typedef struct {
 typedef unsigned char (*pjpeg_need_bytes_callback_t)(unsigned char*, unsigned char, unsigned char*, void*);
 
 #define PJPG_GRAYSCALE_ONLY 2
+#define PJPG_SCALE_1_1 0
+#define PJPG_SCALE_1_2 1
+#define PJPG_SCALE_1_4 2
+#define PJPG_SCALE_1_8 3
 
 namespace fake_picojpeg {
 inline pjpeg_need_bytes_callback_t callback = nullptr;
 inline void* callbackData = nullptr;
 inline unsigned char pixels[64] = {};
 inline int mcu = 0;
+inline unsigned char scale = 0;
 }  // namespace fake_picojpeg
 
 inline unsigned char pjpeg_decode_init(pjpeg_image_info_t* info, pjpeg_need_bytes_callback_t callback,
@@ -40,6 +45,7 @@ inline unsigned char pjpeg_decode_init(pjpeg_image_info_t* info, pjpeg_need_byte
   fake_picojpeg::callback = callback;
   fake_picojpeg::callbackData = callbackData;
   fake_picojpeg::mcu = 0;
+  fake_picojpeg::scale = 0;
   unsigned char input[8] = {};
   unsigned char read = 0;
   const unsigned char status = callback(input, sizeof(input), &read, callbackData);
@@ -59,6 +65,11 @@ inline unsigned char pjpeg_decode_init(pjpeg_image_info_t* info, pjpeg_need_byte
   return 0;
 }
 
+inline unsigned char pjpeg_set_scale(unsigned char scale) {
+  fake_picojpeg::scale = scale;
+  return 0;
+}
+
 inline unsigned char pjpeg_decode_mcu() {
   if (fake_picojpeg::mcu >= 2) return PJPG_NO_MORE_BLOCKS;
   unsigned char input[32] = {};
@@ -0,0 +1,178 @@
+#include "test_utils.h"
+
+#include <FsHelpers.h>
+#include <SDCardManager.h>
+
+#include <cstdio>
+#include <string>
+
+#include "LibraryStore.h"
+
+using papyrix::LibraryStore;
+
+namespace {
+constexpr char LIBRARY_FILE[] = "/.papyrix/library.bin";
+
+std::string bookPath(int i) {
+  char path[48];
+  snprintf(path, sizeof(path), "/books/Book %d.epub", i);
+  return path;
+}
+
+bool titlesSorted(LibraryStore& store) {
+  std::string path, previous;
+  LibraryStore::Entry entry;
+  for (size_t i = 0; i < store.size(); i++) {
+    if (!store.entryByTitle(i, path, entry)) return false;
+    if (i > 0 && FsHelpers::naturalCompare(previous.c_str(), entry.title.c_str()) > 0) return false;
+    previous = entry.title;
+  }
+  return true;
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("LibraryStore");
+  SdMan.reset();
+  auto& store = LibraryStore::instance();
+  LibraryStore::Entry entry;
+  std::string path;
+
+  // Empty store
+  runner.expectEq(size_t(0), store.size(), "missing database is empty");
+  runner.expectFalse(store.find("/books/a.epub", entry), "missing database finds nothing");
+  runner.expectTrue(store.remove("/books/a.epub"), "removing from missing database is a no-op");
+  runner.expectFalse(store.setProgress("/books/a.epub", 10), "progress needs a known book");
+  runner.expectTrue(store.removeDirectory("/books"), "removing a directory from missing database is a no-op");
+  runner.expectTrue(store.renameDirectory("/books", "/shelf"), "renaming a directory in missing database is a no-op");
+  runner.expectFalse(SdMan.exists(LIBRARY_FILE), "reads do not create the database");
+
+  // Add and look up
+  runner.expectTrue(store.update("/books/war.epub", "War and Peace", "Tolstoy"), "adds first book");
+  runner.expectTrue(store.update("/books/b10.fb2", "Book 10", "Anon"), "adds second book");
+  runner.expectTrue(store.update("/books/b2.txt", "book 2", "Anon"), "adds third book");
+  runner.expectEq(size_t(3), store.size(), "counts books");
+  runner.expectTrue(store.find("/books/war.epub", entry), "finds book by path");
+  runner.expectEq(std::string("War and Peace"), entry.title, "stores title");
+  runner.expectEq(std::string("Tolstoy"), entry.author, "stores author");
+  runner.expectEq(LibraryStore::NO_PROGRESS, entry.progress, "new book has no progress");
+  runner.expectFalse(store.find("/books/other.epub", entry), "unknown path is not found");
+
+  runner.expectTrue(store.entryByTitle(0, path, entry), "reads first title row");
+  runner.expectEq(std::string("book 2"), entry.title, "titles use case-insensitive natural order");
+  runner.expectEq(std::string("/books/b2.txt"), path, "title row carries path");
+  runner.expectTrue(store.entryByTitle(2, path, entry), "reads last title row");
+  runner.expectEq(std::string("War and Peace"), entry.title, "last title sorts last");
+  runner.expectFalse(store.entryByTitle(3, path, entry), "rows past the end fail");
+
+  // Progress
+  runner.expectTrue(store.setProgress("/books/war.epub", 42), "stores progress");
+  runner.expectTrue(store.setProgress("/books/b2.txt", 250), "clamps progress");
+  runner.expectTrue(store.find("/books/b2.txt", entry) && entry.progress == 100, "progress capped at 100");
+  const std::string beforeRepeat = SdMan.getWrittenData(LIBRARY_FILE);
+  runner.expectTrue(store.update("/books/war.epub", "War and Peace", "Tolstoy"), "repeat update succeeds");
+  runner.expectTrue(SdMan.getWrittenData(LIBRARY_FILE) == beforeRepeat, "unchanged metadata writes nothing");
+
+  runner.expectTrue(store.update("/books/war.epub", "Anna Karenina", "Leo Tolstoy"), "replaces metadata");
+  runner.expectTrue(store.find("/books/war.epub", entry), "finds replaced book");
+  runner.expectEq(std::string("Anna Karenina"), entry.title, "title replaced");
+  runner.expectEq(uint8_t(42), entry.progress, "update keeps progress");
+  runner.expectTrue(store.entryByTitle(0, path, entry) && entry.title == "Anna Karenina", "replaced title re-sorted");
+  runner.expectEq(size_t(3), store.size(), "replacement keeps count");
+
+  // Rename and remove
+  runner.expectTrue(store.rename("/books/war.epub", "/archive/anna.epub"), "renames book");
+  runner.expectFalse(store.find("/books/war.epub", entry), "old path gone after rename");
+  runner.expectTrue(store.find("/archive/anna.epub", entry), "new path found after rename");
+  runner.expectEq(std::string("Leo Tolstoy"), entry.author, "rename keeps author");
+  runner.expectEq(uint8_t(42), entry.progress, "rename keeps progress");
+  runner.expectTrue(store.rename("/books/unknown.epub", "/books/b10.fb2"), "rename over a known path succeeds");
+  runner.expectFalse(store.find("/books/b10.fb2", entry), "replaced target loses stale metadata");
+  runner.expectEq(size_t(2), store.size(), "replaced target dropped");
+
+  runner.expectTrue(store.remove("/books/b2.txt"), "removes book");
+  runner.expectFalse(store.find("/books/b2.txt", entry), "removed book not found");
+  runner.expectEq(size_t(1), store.size(), "remove decrements count");
+  runner.expectTrue(store.update("/books/b2.txt", "Book 2", "Anon"), "re-adds removed book");
+  runner.expectTrue(store.find("/books/b2.txt", entry) && entry.progress == LibraryStore::NO_PROGRESS,
+                    "re-added book starts without progress");
+
+  // Directory delete and rename
+  runner.expectTrue(store.update("/shelf/a.epub", "Shelf A", "Anon") &&
+                        store.update("/shelf/sub/b.fb2", "Shelf B", "") &&
+                        store.update("/shelf2/c.epub", "Shelf C", "Anon"),
+                    "adds books in directories");
+  runner.expectTrue(store.setProgress("/shelf/sub/b.fb2", 7), "stores nested progress");
+  runner.expectTrue(store.renameDirectory("/shelf", "/moved"), "renames directory");
+  runner.expectFalse(store.find("/shelf/a.epub", entry), "old directory path gone");
+  runner.expectTrue(store.find("/moved/a.epub", entry) && entry.title == "Shelf A", "book re-keyed to new directory");
+  runner.expectTrue(store.find("/moved/sub/b.fb2", entry) && entry.progress == 7, "nested book keeps progress");
+  runner.expectTrue(store.find("/shelf2/c.epub", entry), "sibling with the same prefix untouched by rename");
+  runner.expectEq(size_t(5), store.size(), "directory rename keeps count");
+  runner.expectTrue(titlesSorted(store), "title index sorted after directory rename");
+  runner.expectTrue(store.removeDirectory("/moved/"), "removes directory");
+  runner.expectFalse(store.find("/moved/a.epub", entry), "book in removed directory gone");
+  runner.expectFalse(store.find("/moved/sub/b.fb2", entry), "nested book in removed directory gone");
+  runner.expectTrue(store.find("/shelf2/c.epub", entry), "sibling with the same prefix untouched by remove");
+  runner.expectTrue(store.remove("/shelf2/c.epub"), "removes sibling");
+  runner.expectEq(size_t(2), store.size(), "directory remove drops its books");
+
+  // Persists across close
+  store.close();
+  runner.expectEq(size_t(2), store.size(), "reopened store keeps count");
+  runner.expectTrue(store.find("/archive/anna.epub", entry) && entry.title == "Anna Karenina",
+                    "reopened store keeps metadata");
+
+  // Growth beyond the initial table
+  bool allAdded = true;
+  for (int i = 0; i < 600; i++) {
+    allAdded = store.update(bookPath(i), "Title " + std::to_string((i * 37) % 600), "Author") && allAdded;
+  }
+  runner.expectTrue(allAdded, "adds many books");
+  runner.expectEq(size_t(602), store.size(), "counts after growth");
+  bool allFound = true;
+  for (int i = 0; i < 600; i++) {
+    allFound = store.find(bookPath(i), entry) && entry.title == "Title " + std::to_string((i * 37) % 600) && allFound;
+  }
+  runner.expectTrue(allFound, "every book found after growth");
+  runner.expectTrue(titlesSorted(store), "title index sorted after growth");
+  runner.expectTrue(store.find("/archive/anna.epub", entry) && entry.progress == 42, "growth keeps progress");
+
+  bool allRemoved = true;
+  for (int i = 0; i < 600; i += 2) allRemoved = store.remove(bookPath(i)) && allRemoved;
+  runner.expectTrue(allRemoved, "removes every other book");
+  runner.expectEq(size_t(302), store.size(), "counts after removals");
+  runner.expectFalse(store.find(bookPath(10), entry), "removed book gone");
+  runner.expectTrue(store.find(bookPath(11), entry), "kept book still found past tombstones");
+  runner.expectTrue(titlesSorted(store), "title index sorted after removals");
+
+  // Garbage from repeated retitling is compacted
+  const std::string longTitle(200, 'x');
+  bool allRetitled = true;
+  for (int i = 0; i < 400; i++) {
+    allRetitled = store.update("/books/b2.txt", longTitle + std::to_string(i), "Anon") && allRetitled;
+  }
+  runner.expectTrue(allRetitled, "retitles one book repeatedly");
+  runner.expectTrue(SdMan.getWrittenData(LIBRARY_FILE).size() < 100000, "heap garbage compacted");
+  runner.expectTrue(store.find("/books/b2.txt", entry) && entry.title == longTitle + "399", "latest title kept");
+  runner.expectEq(size_t(302), store.size(), "compaction keeps count");
+
+  // Long text capped on a character boundary
+  std::string cyrillic;
+  for (int i = 0; i < 200; i++) cyrillic += "\xD0\x96";
+  runner.expectTrue(store.update("/books/long.epub", cyrillic, "Anon"), "stores long title");
+  runner.expectTrue(store.find("/books/long.epub", entry), "finds long title");
+  runner.expectEq(size_t(254), entry.title.size(), "long title capped without splitting a character");
+
+  // Damaged file is dropped and refilled
+  store.close();
+  SdMan.reset();
+  SdMan.registerFile(LIBRARY_FILE, "not a library database");
+  runner.expectFalse(store.find("/books/b2.txt", entry), "damaged database finds nothing");
+  runner.expectFalse(SdMan.exists(LIBRARY_FILE), "damaged database removed");
+  runner.expectTrue(store.update("/books/b2.txt", "Book 2", "Anon"), "update recreates database");
+  runner.expectEq(size_t(1), store.size(), "recreated database has the new book");
+  store.close();
+
+  return runner.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <HeapProfiler.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "test_utils.h"
+
+using HeapProfiler::Phase;
+using HeapProfiler::SimHeap;
+
+namespace {
+// Keeps test allocations observable so they are not optimised away
+char* volatile keep = nullptr;
+
+std::string readAll(FILE* file) {
+  std::string out;
+  rewind(file);
+  char buffer[512];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) out.append(buffer, n);
+  return out;
+}
+
+const HeapProfiler::PhaseStats& phaseStats(const HeapProfiler::Stats& stats, const Phase phase) {
+  return stats.phases[static_cast<size_t>(phase)];
+}
+}  // namespace
+
+int main() {
+  TestUtils::TestRunner runner("HeapProfiler");
+
+  // Block sizes and TLSF size classes
+  runner.expectEq(uint32_t(16), SimHeap::blockSize(1), "tiny request takes a minimum block");
+  runner.expectEq(uint32_t(20), SimHeap::blockSize(13), "request aligned to 4 plus header");
+  runner.expectEq(uint32_t(100), SimHeap::searchSize(100), "small blocks search their exact size");
+  runner.expectEq(uint32_t(1008), SimHeap::searchSize(1004), "large blocks round up to their class");
+
+  // Split and coalesce
+  {
+    SimHeap heap(4096);
+    const int64_t a = heap.alloc(100);
+    const int64_t b = heap.alloc(100);
+    const int64_t c = heap.alloc(100);
+    runner.expectTrue(a >= 0 && b > a && c > b, "allocations placed in address order");
+    runner.expectEq(size_t(3 * 104), heap.used(), "used counts blocks with headers");
+    heap.free(static_cast<uint32_t>(b));
+    runner.expectEq(size_t(2), heap.freeBlockCount(), "freed middle block is a hole");
+    heap.free(static_cast<uint32_t>(a));
+    heap.free(static_cast<uint32_t>(c));
+    runner.expectEq(size_t(1), heap.freeBlockCount(), "neighbours coalesce");
+    runner.expectEq(size_t(4096 - SimHeap::HEADER), heap.largestFreeBlock(), "whole heap free again");
+    heap.free(12345);
+    runner.expectEq(size_t(0), heap.used(), "unknown offset ignored");
+  }
+
+  // Fragmentation: half the heap free but no large block
+  {
+    SimHeap heap(8 * 1024);
+    int64_t blocks[64];
+    for (auto& block : blocks) block = heap.alloc(124);
+    for (size_t i = 0; i < 64; i += 2) heap.free(static_cast<uint32_t>(blocks[i]));
+    runner.expectEq(size_t(4 * 1024), heap.freeSize(), "half the heap free");
+    runner.expectEq(size_t(128 - SimHeap::HEADER), heap.largestFreeBlock(), "largest block is one hole");
+    runner.expectEq(int64_t(-1), heap.alloc(256), "larger request fails");
+  }
+
+  // An exact fit is refused when the block sits below the request's class
+  {
+    SimHeap heap(1004);
+    runner.expectEq(int64_t(-1), heap.alloc(1000), "TLSF class rounding refuses exact fit");
+    runner.expectTrue(heap.alloc(900) >= 0, "smaller request in a lower class fits");
+  }
+
+  // Profiler: phases, failures, live tracking
+  {
+    char* early = new char[64];
+    HeapProfiler::start(4096);
+    runner.expectTrue(HeapProfiler::active(), "profiler active after start");
+
+    HeapProfiler::setPhase(Phase::Parse);
+    char* parsed = new char[1000];
+    keep = parsed;
+    HeapProfiler::Stats stats = HeapProfiler::stats();
+    const size_t usedAfterParse = stats.used;
+    runner.expectTrue(phaseStats(stats, Phase::Parse).allocations >= 1, "allocation counted in parse");
+    runner.expectTrue(usedAfterParse >= 1004, "simulated heap charged");
+
+    char* huge = new char[8000];
+    keep = huge;
+    stats = HeapProfiler::stats();
+    runner.expectEq(uint32_t(1), phaseStats(stats, Phase::Parse).failed, "oversized allocation would fail on device");
+    delete[] huge;
+
+    bool scoped;
+    {
+      HeapProfiler::PhaseScope layout(Phase::Layout);
+      scoped = HeapProfiler::currentPhase() == Phase::Layout;
+      keep = static_cast<char*>(malloc(300));
+      free(keep);
+    }
+    runner.expectTrue(scoped, "scope overrides base phase");
+    runner.expectTrue(HeapProfiler::currentPhase() == Phase::Parse, "scope restores base phase");
+    stats = HeapProfiler::stats();
+#ifdef __linux__
+    runner.expectEq(uint32_t(1), phaseStats(stats, Phase::Layout).allocations, "malloc tracked in layout");
+#endif
+    runner.expectTrue(stats.peakUsed >= usedAfterParse, "peak tracked");
+    runner.expectTrue(stats.minLargestFreeBlock <= stats.largestFreeBlock, "worst largest block tracked");
+
+    const size_t usedBeforeEarlyFree = HeapProfiler::stats().used;
+    delete[] early;
+    const size_t usedAfterEarlyFree = HeapProfiler::stats().used;
+    runner.expectEq(usedBeforeEarlyFree, usedAfterEarlyFree, "block from before start ignored");
+    delete[] parsed;
+
+    FILE* reportFile = tmpfile();
+    HeapProfiler::report(reportFile);
+    const std::string report = readAll(reportFile);
+    fclose(reportFile);
+    runner.expectTrue(report.find("4096 byte simulated heap") != std::string::npos, "report header");
+    runner.expectTrue(report.find("Top sites (parse)") != std::string::npos, "report lists parse sites");
+#ifdef __linux__
+    runner.expectTrue(report.find(" main") != std::string::npos, "sites named after the caller");
+#endif
+
+    FILE* timelineFile = tmpfile();
+    HeapProfiler::writeTimeline(timelineFile);
+    const std::string timeline = readAll(timelineFile);
+    fclose(timelineFile);
+    runner.expectTrue(timeline.rfind("sequence,phase,used,largestFreeBlock\n", 0) == 0, "timeline header");
+    runner.expectTrue(timeline.find(",layout,") != std::string::npos, "timeline records phase changes");
+
+    HeapProfiler::stop();
+    const uint32_t before = phaseStats(HeapProfiler::stats(), Phase::Parse).allocations;
+    keep = new char[16];
+    delete[] keep;
+    const uint32_t after = phaseStats(HeapProfiler::stats(), Phase::Parse).allocations;
+    runner.expectEq(before, after, "stopped profiler idle");
+
+    HeapProfiler::start(2048);
+    runner.expectEq(size_t(2048), HeapProfiler::stats().capacity, "restart resets capacity");
+    runner.expectEq(uint32_t(0), phaseStats(HeapProfiler::stats(), Phase::Parse).allocations, "restart clears stats");
+    HeapProfiler::stop();
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
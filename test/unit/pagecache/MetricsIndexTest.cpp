@@ -1,14 +1,12 @@
-// Tests for the metrics.bin on-disk format used by ReaderState to skip the
-// per-spine probe/scan on book open. The file stores per-section page counts
-// (exact or estimated) and byte sizes used for recalibrating estimates.
-//
-// This test inlines the read/write logic from ReaderState.cpp (following the
-// project pattern of avoiding heavy linker dependencies) and verifies:
-//   - save/load roundtrip preserves pages, exact flag, byteSize
-//   - version mismatch is rejected (v1 reader rejects v2 file and vice versa)
-//   - config mismatch is rejected
-//   - entry-count mismatch is rejected
-//   - truncated file is rejected
+// Tests for metrics.bin (src/content/MetricsIndex.cpp), the per-book file that
+// lets ReaderState skip the per-spine probe/scan on book open. It stores
+// per-section page counts (exact or estimated), the byte sizes used to
+// re-estimate, and the learned bytes-per-page ratio. Verifies:
+//   - save/load roundtrip preserves pages, exact flag, byteSize and the ratio
+//   - version, config and entry-count mismatches are rejected
+//   - truncated files are rejected without touching the output
+//   - short writes and sync failures leave no file
+//   - recordSection folds a cache write into the file
 
 #include "test_utils.h"
 
@@ -21,106 +19,12 @@
 #include "SDCardManager.h"
 #include "SdFat.h"
 #include "Serialization.h"
+#include "content/MetricsIndex.h"
 
-namespace {
-
-constexpr uint8_t kMetricsIndexVersion = 4;
-constexpr const char* kMetricsIndexFilename = "metrics.bin";
-
-struct MetricsEntry {
-  uint32_t pages;
-  bool exact;
-  uint32_t byteSize;
-};
-
-// Mirrors ReaderState::saveMetricsIndex
-bool saveMetricsIndex(const std::string& sectionsDir, const RenderConfig& config,
-                      const std::vector<MetricsEntry>& metrics) {
-  if (metrics.empty()) return false;
-
-  const std::string path = sectionsDir + "/" + kMetricsIndexFilename;
-  FsFile file;
-  if (!SdMan.openFileForWrite("MIDX", path, file)) return false;
-
-  const uint16_t entryCount = static_cast<uint16_t>(metrics.size());
-  bool writeOk = serialization::writePodChecked(file, kMetricsIndexVersion) &&
-                 serialization::writePodChecked(file, config.fontId) &&
-                 serialization::writePodChecked(file, config.lineCompression) &&
-                 serialization::writePodChecked(file, config.indentLevel) &&
-                 serialization::writePodChecked(file, config.spacingLevel) &&
-                 serialization::writePodChecked(file, config.paragraphAlignment) &&
-                 serialization::writePodChecked(file, config.hyphenation) &&
-                 serialization::writePodChecked(file, config.showImages) &&
-                 serialization::writePodChecked(file, config.viewportWidth) &&
-                 serialization::writePodChecked(file, config.viewportHeight) &&
-                 serialization::writePodChecked(file, config.sourceFingerprint) &&
-                 serialization::writePodChecked(file, config.fontFingerprint) &&
-                 serialization::writePodChecked(file, entryCount);
-
-  for (const auto& m : metrics) {
-    const uint8_t flags = m.exact ? 1 : 0;
-    writeOk = writeOk && serialization::writePodChecked(file, m.pages) &&
-              serialization::writePodChecked(file, flags) && serialization::writePodChecked(file, m.byteSize);
-  }
-  writeOk = writeOk && file.sync();
-  file.close();
-  if (!writeOk) SdMan.remove(path.c_str());
-  return writeOk;
-}
-
-// Mirrors ReaderState::readMetricsIndexFile
-bool readMetricsIndexFile(const std::string& sectionsDir, const RenderConfig& config, int spineCount,
-                          std::vector<MetricsEntry>& out) {
-  const std::string path = sectionsDir + "/" + kMetricsIndexFilename;
-  FsFile file;
-  if (!SdMan.openFileForRead("MIDX", path, file)) return false;
-
-  uint8_t version;
-  if (!serialization::readPodChecked(file, version) || version != kMetricsIndexVersion) {
-    file.close();
-    return false;
-  }
-
-  RenderConfig fileConfig;
-  const bool configRead = serialization::readPodChecked(file, fileConfig.fontId) &&
-                          serialization::readPodChecked(file, fileConfig.lineCompression) &&
-                          serialization::readPodChecked(file, fileConfig.indentLevel) &&
-                          serialization::readPodChecked(file, fileConfig.spacingLevel) &&
-                          serialization::readPodChecked(file, fileConfig.paragraphAlignment) &&
-                          serialization::readPodChecked(file, fileConfig.hyphenation) &&
-                          serialization::readPodChecked(file, fileConfig.showImages) &&
-                          serialization::readPodChecked(file, fileConfig.viewportWidth) &&
-                          serialization::readPodChecked(file, fileConfig.viewportHeight) &&
-                          serialization::readPodChecked(file, fileConfig.sourceFingerprint) &&
-                          serialization::readPodChecked(file, fileConfig.fontFingerprint);
-  if (!configRead || config != fileConfig) {
-    file.close();
-    return false;
-  }
+namespace metrics_index = papyrix::metrics_index;
+using Section = papyrix::page_metrics::Section;
 
-  uint16_t entryCount;
-  if (!serialization::readPodChecked(file, entryCount) || entryCount != static_cast<uint16_t>(spineCount)) {
-    file.close();
-    return false;
-  }
-
-  std::vector<MetricsEntry> decoded(static_cast<size_t>(spineCount));
-  for (int i = 0; i < spineCount; ++i) {
-    uint32_t pages;
-    uint8_t flags;
-    uint32_t byteSize;
-    if (!serialization::readPodChecked(file, pages) || !serialization::readPodChecked(file, flags) ||
-        !serialization::readPodChecked(file, byteSize)) {
-      file.close();
-      return false;
-    }
-    decoded[static_cast<size_t>(i)] = MetricsEntry{pages, (flags & 1) != 0, byteSize};
-  }
-
-  file.close();
-  out.swap(decoded);
-  return true;
-}
+namespace {
 
 RenderConfig makeConfig() {
   return RenderConfig(/*fontId=*/1234, /*lineCompression=*/1.0f, /*indentLevel=*/1, /*spacingLevel=*/2,
@@ -129,9 +33,24 @@ RenderConfig makeConfig() {
                       /*fontFingerprint=*/0x89ABCDEFu);
 }
 
-void registerOnDisk(const std::string& dir) {
-  const std::string path = dir + "/" + kMetricsIndexFilename;
-  SdMan.registerFile(path, SdMan.getWrittenData(path));
+// Version and RenderConfig, the part of the header before bytesPerPage
+std::string configHeader(const RenderConfig& config, uint8_t version = metrics_index::VERSION) {
+  FsFile writer;
+  writer.setBuffer("");
+  serialization::writePod(writer, version);
+  serialization::writePod(writer, config.fontId);
+  serialization::writePod(writer, config.lineCompression);
+  serialization::writePod(writer, config.indentLevel);
+  serialization::writePod(writer, config.spacingLevel);
+  serialization::writePod(writer, config.paragraphAlignment);
+  serialization::writePod(writer, config.hyphenation);
+  serialization::writePod(writer, config.showImages);
+  serialization::writePod(writer, config.viewportWidth);
+  serialization::writePod(writer, config.viewportHeight);
+  serialization::writePod(writer, config.sourceFingerprint);
+  serialization::writePod(writer, config.fontFingerprint);
+  serialization::writePod(writer, config.grayscaleImages);
+  return writer.getBuffer();
 }
 
 }  // namespace
@@ -141,223 +60,257 @@ int main() {
 
   // Test 1: Roundtrip with all-exact entries preserves pages and byteSize
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book1";
     const RenderConfig config = makeConfig();
-    std::vector<MetricsEntry> in = {
+    const std::vector<Section> in = {
         {70000, true, 20480},
         {25, true, 51200},
         {5, true, 10240},
     };
-    runner.expectTrue(saveMetricsIndex(dir, config, in), "all_exact_save_ok");
-    registerOnDisk(dir);
-
-    std::vector<MetricsEntry> out;
-    runner.expectTrue(readMetricsIndexFile(dir, config, 3, out), "all_exact_load_ok");
-    runner.expectEq<size_t>(3, out.size(), "all_exact_count");
-    runner.expectEq<uint32_t>(70000, out[0].pages, "all_exact_pages_0");
-    runner.expectEq<uint32_t>(25, out[1].pages, "all_exact_pages_1");
-    runner.expectEq<uint32_t>(5, out[2].pages, "all_exact_pages_2");
-    runner.expectTrue(out[0].exact && out[1].exact && out[2].exact, "all_exact_flags");
-    runner.expectEq<uint32_t>(20480, out[0].byteSize, "all_exact_bytesize_0");
-    runner.expectEq<uint32_t>(51200, out[1].byteSize, "all_exact_bytesize_1");
-    runner.expectEq<uint32_t>(10240, out[2].byteSize, "all_exact_bytesize_2");
+    runner.expectTrue(metrics_index::save(dir, config, in), "all_exact_save_ok");
+
+    metrics_index::Index out;
+    runner.expectTrue(metrics_index::load(dir, config, 3, out), "all_exact_load_ok");
+    runner.expectEq<size_t>(3, out.sections.size(), "all_exact_count");
+    runner.expectEq<uint32_t>(70000, out.sections[0].pages, "all_exact_pages_0");
+    runner.expectEq<uint32_t>(25, out.sections[1].pages, "all_exact_pages_1");
+    runner.expectEq<uint32_t>(5, out.sections[2].pages, "all_exact_pages_2");
+    runner.expectTrue(out.sections[0].exact && out.sections[1].exact && out.sections[2].exact, "all_exact_flags");
+    runner.expectEq<uint32_t>(20480, out.sections[0].byteSize, "all_exact_bytesize_0");
+    runner.expectEq<uint32_t>(51200, out.sections[1].byteSize, "all_exact_bytesize_1");
+    runner.expectEq<uint32_t>(10240, out.sections[2].byteSize, "all_exact_bytesize_2");
+    runner.expectFalse(SdMan.exists("/cache/book1/metrics.bin.tmp"), "all_exact_no_temp_left");
   }
 
   // Test 2: Roundtrip with mixed exact/estimated entries preserves byteSize
   // (this is the regression case: without byteSize, recalibration of
   // estimated entries can't happen after fast-path load)
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book2";
     const RenderConfig config = makeConfig();
-    std::vector<MetricsEntry> in = {
-        {10, true, 20480},    // exact, with calibration data
-        {7, false, 14336},    // estimated, byteSize needed for recalibration
-        {12, true, 24576},    // exact
-        {3, false, 6144},     // estimated
+    const std::vector<Section> in = {
+        {10, true, 20480},   // exact, with calibration data
+        {7, false, 14336},   // estimated, byteSize needed for recalibration
+        {12, true, 24576},   // exact
+        {3, false, 6144},    // estimated
     };
-    runner.expectTrue(saveMetricsIndex(dir, config, in), "mixed_save_ok");
-    registerOnDisk(dir);
-
-    std::vector<MetricsEntry> out;
-    runner.expectTrue(readMetricsIndexFile(dir, config, 4, out), "mixed_load_ok");
-    runner.expectTrue(out[0].exact, "mixed_exact_0");
-    runner.expectFalse(out[1].exact, "mixed_estimated_1");
-    runner.expectTrue(out[2].exact, "mixed_exact_2");
-    runner.expectFalse(out[3].exact, "mixed_estimated_3");
-    runner.expectEq<uint32_t>(14336, out[1].byteSize, "mixed_estimated_bytesize_1");
-    runner.expectEq<uint32_t>(6144, out[3].byteSize, "mixed_estimated_bytesize_3");
+    runner.expectTrue(metrics_index::save(dir, config, in), "mixed_save_ok");
+
+    metrics_index::Index out;
+    runner.expectTrue(metrics_index::load(dir, config, 4, out), "mixed_load_ok");
+    runner.expectTrue(out.sections[0].exact, "mixed_exact_0");
+    runner.expectFalse(out.sections[1].exact, "mixed_estimated_1");
+    runner.expectTrue(out.sections[2].exact, "mixed_exact_2");
+    runner.expectFalse(out.sections[3].exact, "mixed_estimated_3");
+    runner.expectEq<uint32_t>(14336, out.sections[1].byteSize, "mixed_estimated_bytesize_1");
+    runner.expectEq<uint32_t>(6144, out.sections[3].byteSize, "mixed_estimated_bytesize_3");
+    // 45056 bytes over 22 exact pages
+    runner.expectEq<uint32_t>(2048, out.bytesPerPage, "mixed_learned_bytes_per_page");
+  }
+
+  // Test 3: The learned ratio comes from exact sections only; the default until one exists
+  {
+    SdMan.reset();
+    const std::string dir = "/cache/ratio";
+    const RenderConfig config = makeConfig();
+    metrics_index::Index out;
+    metrics_index::save(dir, config, {{40, true, 40960}, {3, false, 900000}});
+    metrics_index::load(dir, config, 2, out);
+    runner.expectEq<uint32_t>(1024, out.bytesPerPage, "ratio_from_exact_sections");
+
+    metrics_index::save(dir, config, {{4, false, 8192}});
+    metrics_index::load(dir, config, 1, out);
+    runner.expectEq<uint32_t>(papyrix::page_metrics::kEstimatedBytesPerPage, out.bytesPerPage,
+                              "ratio_default_without_exact");
   }
 
-  // Test 3: Version mismatch is rejected (simulate the legacy v2 file)
+  // Test 4: Version mismatch is rejected (simulate the v4 file without a ratio)
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book3";
-    const std::string path = dir + "/" + kMetricsIndexFilename;
-    FsFile writer;
-    writer.setBuffer("");
-    uint8_t oldVersion = 2;
-    serialization::writePod(writer, oldVersion);
-    // Pad enough bytes so a truncation check isn't what trips us
     const RenderConfig config = makeConfig();
-    serialization::writePod(writer, config.fontId);
-    SdMan.registerFile(path, writer.getBuffer());
+    FsFile writer;
+    writer.setBuffer(configHeader(config, 4));
+    const uint16_t entryCount = 1;
+    const uint32_t pages = 10;
+    const uint8_t flags = 1;
+    const uint32_t byteSize = 1024;
+    serialization::writePod(writer, entryCount);
+    serialization::writePod(writer, pages);
+    serialization::writePod(writer, flags);
+    serialization::writePod(writer, byteSize);
+    SdMan.registerFile(metrics_index::path(dir), writer.getBuffer());
 
-    std::vector<MetricsEntry> out;
-    runner.expectFalse(readMetricsIndexFile(dir, config, 1, out), "old_version_rejected");
+    metrics_index::Index out;
+    runner.expectFalse(metrics_index::load(dir, config, 1, out), "old_version_rejected");
   }
 
-  // Test 4: Config mismatch (different fontId) is rejected
+  // Test 5: Config mismatch (different fontId) is rejected
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book4";
     const RenderConfig configA = makeConfig();
     RenderConfig configB = makeConfig();
     configB.fontId = 9999;
 
-    std::vector<MetricsEntry> in = {{10, true, 20480}};
-    runner.expectTrue(saveMetricsIndex(dir, configA, in), "config_save_ok");
-    registerOnDisk(dir);
+    runner.expectTrue(metrics_index::save(dir, configA, {{10, true, 20480}}), "config_save_ok");
 
-    std::vector<MetricsEntry> out;
-    runner.expectFalse(readMetricsIndexFile(dir, configB, 1, out), "config_mismatch_rejected");
+    metrics_index::Index out;
+    runner.expectFalse(metrics_index::load(dir, configB, 1, out), "config_mismatch_rejected");
 
     RenderConfig sourceMismatch = configA;
     sourceMismatch.sourceFingerprint ^= 1u;
-    runner.expectFalse(readMetricsIndexFile(dir, sourceMismatch, 1, out), "source_fingerprint_mismatch_rejected");
+    runner.expectFalse(metrics_index::load(dir, sourceMismatch, 1, out), "source_fingerprint_mismatch_rejected");
 
     RenderConfig fontMismatch = configA;
     fontMismatch.fontFingerprint ^= 1u;
-    runner.expectFalse(readMetricsIndexFile(dir, fontMismatch, 1, out), "font_fingerprint_mismatch_rejected");
+    runner.expectFalse(metrics_index::load(dir, fontMismatch, 1, out), "font_fingerprint_mismatch_rejected");
+
+    RenderConfig grayscaleMismatch = configA;
+    grayscaleMismatch.grayscaleImages = !configA.grayscaleImages;
+    runner.expectFalse(metrics_index::load(dir, grayscaleMismatch, 1, out), "grayscale_images_mismatch_rejected");
   }
 
-  // Test 5: Entry-count mismatch (book gained/lost spine items) is rejected
+  // Test 6: Entry-count mismatch (book gained/lost spine items) is rejected
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book5";
     const RenderConfig config = makeConfig();
-    std::vector<MetricsEntry> in = {{10, true, 20480}, {20, true, 40960}};
-    runner.expectTrue(saveMetricsIndex(dir, config, in), "count_save_ok");
-    registerOnDisk(dir);
+    runner.expectTrue(metrics_index::save(dir, config, {{10, true, 20480}, {20, true, 40960}}), "count_save_ok");
 
-    std::vector<MetricsEntry> out;
-    runner.expectFalse(readMetricsIndexFile(dir, config, 3, out), "count_mismatch_rejected");
+    metrics_index::Index out;
+    runner.expectFalse(metrics_index::load(dir, config, 3, out), "count_mismatch_rejected");
   }
 
-  // Test 6: Truncated file (saved entries shorter than declared count) is rejected
+  // Test 7: Truncated file (saved entries shorter than declared count) is rejected
   {
-    SdMan.clearWrittenFiles();
+    SdMan.reset();
     const std::string dir = "/cache/book6";
-    const std::string path = dir + "/" + kMetricsIndexFilename;
     const RenderConfig config = makeConfig();
 
     FsFile writer;
-    writer.setBuffer("");
-    serialization::writePod(writer, kMetricsIndexVersion);
-    serialization::writePod(writer, config.fontId);
-    serialization::writePod(writer, config.lineCompression);
-    serialization::writePod(writer, config.indentLevel);
-    serialization::writePod(writer, config.spacingLevel);
-    serialization::writePod(writer, config.paragraphAlignment);
-    serialization::writePod(writer, config.hyphenation);
-    serialization::writePod(writer, config.showImages);
-    serialization::writePod(writer, config.viewportWidth);
-    serialization::writePod(writer, config.viewportHeight);
-    serialization::writePod(writer, config.sourceFingerprint);
-    serialization::writePod(writer, config.fontFingerprint);
-    uint16_t entryCount = 3;
+    writer.setBuffer(configHeader(config));
+    const uint32_t bytesPerPage = 2048;
+    const uint16_t entryCount = 3;
+    serialization::writePod(writer, bytesPerPage);
     serialization::writePod(writer, entryCount);
     // Only one entry written despite claiming three
-    uint32_t pages = 10;
-    uint8_t flags = 1;
-    uint32_t byteSize = 1024;
+    const uint32_t pages = 10;
+    const uint8_t flags = 1;
+    const uint32_t byteSize = 1024;
     serialization::writePod(writer, pages);
     serialization::writePod(writer, flags);
     serialization::writePod(writer, byteSize);
-    SdMan.registerFile(path, writer.getBuffer());
+    SdMan.registerFile(metrics_index::path(dir), writer.getBuffer());
 
-    std::vector<MetricsEntry> out;
-    runner.expectFalse(readMetricsIndexFile(dir, config, 3, out), "truncated_rejected");
+    metrics_index::Index out;
+    runner.expectFalse(metrics_index::load(dir, config, 3, out), "truncated_rejected");
   }
 
-  // Test 7: Every truncated RenderConfig prefix is rejected transactionally
+  // Test 8: Every truncated header prefix is rejected transactionally
   {
+    SdMan.reset();
     const std::string dir = "/cache/book7";
-    const std::string path = dir + "/" + kMetricsIndexFilename;
     const RenderConfig config = makeConfig();
     FsFile writer;
-    writer.setBuffer("");
-    serialization::writePod(writer, kMetricsIndexVersion);
-    serialization::writePod(writer, config.fontId);
-    serialization::writePod(writer, config.lineCompression);
-    serialization::writePod(writer, config.indentLevel);
-    serialization::writePod(writer, config.spacingLevel);
-    serialization::writePod(writer, config.paragraphAlignment);
-    serialization::writePod(writer, config.hyphenation);
-    serialization::writePod(writer, config.showImages);
-    serialization::writePod(writer, config.viewportWidth);
-    serialization::writePod(writer, config.viewportHeight);
-    serialization::writePod(writer, config.sourceFingerprint);
-    serialization::writePod(writer, config.fontFingerprint);
-    const std::string configBytes = writer.getBuffer();
+    writer.setBuffer(configHeader(config));
+    const uint32_t bytesPerPage = 2048;
+    serialization::writePod(writer, bytesPerPage);
+    const std::string headerBytes = writer.getBuffer();
 
     bool allRejected = true;
     bool outputPreserved = true;
-    for (size_t length = 1; length < configBytes.size(); length++) {
-      SdMan.registerFile(path, configBytes.substr(0, length));
-      std::vector<MetricsEntry> out = {{777, true, 888}};
-      allRejected = allRejected && !readMetricsIndexFile(dir, config, 1, out);
-      outputPreserved = outputPreserved && out.size() == 1 && out[0].pages == 777 && out[0].byteSize == 888;
+    for (size_t length = 1; length <= headerBytes.size(); length++) {
+      SdMan.registerFile(metrics_index::path(dir), headerBytes.substr(0, length));
+      metrics_index::Index out;
+      out.sections = {{777, true, 888}};
+      out.bytesPerPage = 999;
+      allRejected = allRejected && !metrics_index::load(dir, config, 1, out);
+      outputPreserved = outputPreserved && out.sections.size() == 1 && out.sections[0].pages == 777 &&
+                        out.sections[0].byteSize == 888 && out.bytesPerPage == 999;
     }
-    runner.expectTrue(allRejected, "truncated_config_prefixes_rejected");
-    runner.expectTrue(outputPreserved, "truncated_config_preserves_output");
-  }
-
-  // Test 8: A complete RenderConfig without an entry count is rejected transactionally
-  {
-    const std::string dir = "/cache/book8";
-    const std::string path = dir + "/" + kMetricsIndexFilename;
-    const RenderConfig config = makeConfig();
-    FsFile writer;
-    writer.setBuffer("");
-    serialization::writePod(writer, kMetricsIndexVersion);
-    serialization::writePod(writer, config.fontId);
-    serialization::writePod(writer, config.lineCompression);
-    serialization::writePod(writer, config.indentLevel);
-    serialization::writePod(writer, config.spacingLevel);
-    serialization::writePod(writer, config.paragraphAlignment);
-    serialization::writePod(writer, config.hyphenation);
-    serialization::writePod(writer, config.showImages);
-    serialization::writePod(writer, config.viewportWidth);
-    serialization::writePod(writer, config.viewportHeight);
-    serialization::writePod(writer, config.sourceFingerprint);
-    serialization::writePod(writer, config.fontFingerprint);
-    SdMan.registerFile(path, writer.getBuffer());
-    std::vector<MetricsEntry> out = {{777, true, 888}};
-    runner.expectFalse(readMetricsIndexFile(dir, config, 1, out), "missing_entry_count_rejected");
-    runner.expectEq<uint32_t>(777, out[0].pages, "missing_entry_count_preserves_output");
+    runner.expectTrue(allRejected, "truncated_header_prefixes_rejected");
+    runner.expectTrue(outputPreserved, "truncated_header_preserves_output");
   }
 
-  // Test 9: Checked writer rejects short writes and sync failures
+  // Test 9: Checked writer rejects short writes and sync failures and leaves no file
   {
     SdMan.reset();
     SdMan.setWriteLimit(1);
-    runner.expectFalse(saveMetricsIndex("/cache/write-short", makeConfig(), {{1, true, 2}}),
+    runner.expectFalse(metrics_index::save("/cache/write-short", makeConfig(), {{1, true, 2}}),
                        "short_write_rejected");
+    runner.expectFalse(SdMan.exists("/cache/write-short/metrics.bin"), "short_write_no_file");
   }
   {
     SdMan.reset();
     SdMan.setSyncResult(false);
-    runner.expectFalse(saveMetricsIndex("/cache/sync-fail", makeConfig(), {{1, true, 2}}),
+    runner.expectFalse(metrics_index::save("/cache/sync-fail", makeConfig(), {{1, true, 2}}),
                        "sync_failure_rejected");
+    runner.expectFalse(SdMan.exists("/cache/sync-fail/metrics.bin.tmp"), "sync_failure_no_temp_left");
+  }
+
+  // Test 10: Missing file is rejected; an empty index is not written
+  {
+    SdMan.reset();
+    metrics_index::Index out;
+    runner.expectFalse(metrics_index::load("/cache/nonexistent", makeConfig(), 1, out), "missing_rejected");
+    runner.expectFalse(metrics_index::save("/cache/empty", makeConfig(), {}), "empty_not_saved");
   }
 
-  // Test 10: Missing file is rejected
+  // Test 11: recordSection makes a completed section exact and re-estimates the rest
   {
-    SdMan.clearWrittenFiles();
-    std::vector<MetricsEntry> out;
-    runner.expectFalse(readMetricsIndexFile("/cache/nonexistent", makeConfig(), 1, out), "missing_rejected");
+    SdMan.reset();
+    const std::string dir = "/cache/record";
+    const RenderConfig config = makeConfig();
+    metrics_index::save(dir, config, {{10, false, 20480}, {5, false, 10240}, {8, false, 16384}});
+
+    runner.expectTrue(metrics_index::recordSection(dir, config, 0, 20, false), "record_complete_ok");
+    metrics_index::Index out;
+    runner.expectTrue(metrics_index::load(dir, config, 3, out), "record_complete_load");
+    runner.expectTrue(out.sections[0].exact, "record_complete_exact");
+    runner.expectEq<uint32_t>(20, out.sections[0].pages, "record_complete_pages");
+    // 20480 bytes over 20 pages: the others are re-estimated at 1024 bytes/page
+    runner.expectEq<uint32_t>(1024, out.bytesPerPage, "record_complete_ratio");
+    runner.expectEq<uint32_t>(10, out.sections[1].pages, "record_reestimated_1");
+    runner.expectEq<uint32_t>(16, out.sections[2].pages, "record_reestimated_2");
+  }
+
+  // Test 12: A partial cache only raises an estimate, and never lowers an exact count
+  {
+    SdMan.reset();
+    const std::string dir = "/cache/record-partial";
+    const RenderConfig config = makeConfig();
+    metrics_index::save(dir, config, {{12, true, 24576}, {5, false, 10240}});
+
+    runner.expectTrue(metrics_index::recordSection(dir, config, 1, 9, true), "partial_raise_ok");
+    metrics_index::Index out;
+    metrics_index::load(dir, config, 2, out);
+    runner.expectEq<uint32_t>(9, out.sections[1].pages, "partial_raises_estimate");
+    runner.expectFalse(out.sections[1].exact, "partial_stays_estimated");
+
+    runner.expectTrue(metrics_index::recordSection(dir, config, 0, 3, true), "partial_on_exact_ok");
+    metrics_index::load(dir, config, 2, out);
+    runner.expectEq<uint32_t>(12, out.sections[0].pages, "partial_keeps_exact_count");
+  }
+
+  // Test 13: recordSection needs an index for this config and a valid section
+  {
+    SdMan.reset();
+    const RenderConfig config = makeConfig();
+    runner.expectFalse(metrics_index::recordSection("/cache/none", config, 0, 4, false), "record_without_index");
+    runner.expectFalse(SdMan.exists("/cache/none/metrics.bin"), "record_does_not_create_index");
+
+    const std::string dir = "/cache/record-bounds";
+    metrics_index::save(dir, config, {{5, false, 10240}});
+    runner.expectFalse(metrics_index::recordSection(dir, config, 1, 4, false), "record_out_of_range");
+    RenderConfig other = config;
+    other.fontId = 77;
+    runner.expectFalse(metrics_index::recordSection(dir, other, 0, 4, false), "record_other_config");
+    metrics_index::Index out;
+    metrics_index::load(dir, config, 1, out);
+    runner.expectFalse(out.sections[0].exact, "record_other_config_leaves_file");
   }
 
   return runner.allPassed() ? 0 : 1;
@@ -56,13 +56,14 @@ bool writeSyntheticCache(const char* path, const RenderConfig& config, uint32_t
   FsFile file;
   if (!SdMan.openFileForWrite("CACHE", path, file)) return false;
 
-  constexpr uint8_t version = 22;
-  constexpr uint32_t headerSize = 43;
-  constexpr uint32_t lutOffset = 45;
+  constexpr uint8_t version = 24;
+  constexpr uint32_t headerSize = 48;
+  constexpr uint32_t lutOffset = 50;
   constexpr uint32_t pagePosition = headerSize;
   const uint8_t partial = 1;
   const uint32_t bytesConsumed = 1;
   const uint32_t totalBytes = 2;
+  const uint32_t firstPage = 0;
   bool ok = serialization::writePodChecked(file, version) &&
             serialization::writePodChecked(file, config.fontId) &&
             serialization::writePodChecked(file, config.lineCompression) &&
@@ -79,7 +80,9 @@ bool writeSyntheticCache(const char* path, const RenderConfig& config, uint32_t
             serialization::writePodChecked(file, bytesConsumed) &&
             serialization::writePodChecked(file, totalBytes) &&
             serialization::writePodChecked(file, config.sourceFingerprint) &&
-            serialization::writePodChecked(file, config.fontFingerprint);
+            serialization::writePodChecked(file, config.fontFingerprint) &&
+            serialization::writePodChecked(file, config.grayscaleImages) &&
+            serialization::writePodChecked(file, firstPage);
   const uint16_t emptyPageElements = 0;
   ok = ok && serialization::writePodChecked(file, emptyPageElements);
   for (uint32_t i = 0; ok && i < pageCount; ++i) {
@@ -363,5 +366,29 @@ int main() {
     runner.expectFalse(recovered.isPartial(), "successful retry completes the cache");
   }
 
+  {
+    SdMan.reset();
+    constexpr const char* path = "/cache/prefetch.bin";
+    CountingParser parser(6, false);
+    PageCache cache(path);
+    runner.expectTrue(cache.create(parser, config, 0), "prefetch fixture cache is created");
+    runner.expectFalse(cache.prefetchPage(6), "prefetch past the cached pages fails");
+    runner.expectTrue(cache.prefetchPage(3), "prefetch reads a cached page");
+    runner.expectTrue(cache.prefetchPage(3), "repeated prefetch keeps the held page");
+
+    // The held page must come from memory, so take the file away first
+    const std::string bytes = SdMan.getWrittenData(path);
+    SdMan.remove(path);
+    runner.expectTrue(cache.loadPage(3) != nullptr, "loadPage hands out the prefetched page");
+    runner.expectTrue(cache.loadPage(3) == nullptr, "prefetched page is handed out once");
+    runner.expectTrue(cache.loadPage(2) == nullptr, "other pages still read the file");
+
+    SdMan.registerFile(path, bytes);
+    runner.expectTrue(cache.prefetchPage(1), "prefetch reads the restored file");
+    runner.expectTrue(cache.load(config), "cache reloads");
+    SdMan.remove(path);
+    runner.expectTrue(cache.loadPage(1) == nullptr, "reload drops the prefetched page");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
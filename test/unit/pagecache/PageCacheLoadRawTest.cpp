@@ -18,7 +18,7 @@
 
 namespace {
 
-constexpr uint8_t CACHE_FILE_VERSION = 22;
+constexpr uint8_t CACHE_FILE_VERSION = 24;
 
 // Header layout (must match PageCache.cpp):
 // - version (1 byte)
@@ -38,7 +38,9 @@ constexpr uint8_t CACHE_FILE_VERSION = 22;
 // - totalBytes (4 bytes)
 // - sourceFingerprint (4 bytes)
 // - fontFingerprint (4 bytes)
-constexpr uint32_t HEADER_SIZE = 1 + 4 + 4 + 1 + 1 + 1 + 1 + 1 + 2 + 2 + 4 + 1 + 4 + 4 + 4 + 4 + 4;
+// - grayscaleImages (1 byte)
+// - firstPage (4 bytes)
+constexpr uint32_t HEADER_SIZE = 1 + 4 + 4 + 1 + 1 + 1 + 1 + 1 + 2 + 2 + 4 + 1 + 4 + 4 + 4 + 4 + 4 + 1 + 4;
 
 // Write a complete cache header to an FsFile buffer
 void writeCacheHeader(FsFile& file, uint32_t pageCount, bool isPartial, uint8_t version = CACHE_FILE_VERSION) {
@@ -74,6 +76,10 @@ void writeCacheHeader(FsFile& file, uint32_t pageCount, bool isPartial, uint8_t
   serialization::writePod(file, sourceFingerprint);
   uint32_t fontFingerprint = 0x89ABCDEFu;
   serialization::writePod(file, fontFingerprint);
+  uint8_t grayscaleImages = 1;
+  serialization::writePod(file, grayscaleImages);
+  uint32_t firstPage = 0;
+  serialization::writePod(file, firstPage);
   const uint32_t pagePosition = HEADER_SIZE;
   for (uint32_t i = 0; i < pageCount; i++) serialization::writePod(file, pagePosition);
 }
@@ -114,6 +120,8 @@ LoadRawResult loadRaw(const std::string& path) {
   uint32_t lutOffset = 0;
   uint32_t sourceFingerprint = 0;
   uint32_t fontFingerprint = 0;
+  bool grayscaleImages = false;
+  uint32_t firstPage = 0;
   const bool headerValid = serialization::readPodChecked(file, version) &&
                            serialization::readPodChecked(file, fontId) &&
                            serialization::readPodChecked(file, lineCompression) &&
@@ -130,9 +138,12 @@ LoadRawResult loadRaw(const std::string& path) {
                            serialization::readPodChecked(file, result.bytesConsumed) &&
                            serialization::readPodChecked(file, result.totalBytes) &&
                            serialization::readPodChecked(file, sourceFingerprint) &&
-                           serialization::readPodChecked(file, fontFingerprint);
-  const size_t lutSize = static_cast<size_t>(result.pageCount) * sizeof(uint32_t);
-  if (!headerValid || version != CACHE_FILE_VERSION || partial > 1 || lutOffset < HEADER_SIZE ||
+                           serialization::readPodChecked(file, fontFingerprint) &&
+                           serialization::readPodChecked(file, grayscaleImages) &&
+                           serialization::readPodChecked(file, firstPage);
+  const size_t lutSize = static_cast<size_t>(result.pageCount - firstPage) * sizeof(uint32_t);
+  if (!headerValid || version != CACHE_FILE_VERSION || partial > 1 || firstPage > result.pageCount ||
+      lutOffset < HEADER_SIZE ||
       lutOffset > file.size() || lutSize > file.size() - lutOffset) {
     file.close();
     return result;
@@ -230,13 +241,13 @@ int main() {
     runner.expectEq(static_cast<uint32_t>(70000), result.pageCount, "wide_page_count");
   }
 
-  // Test 8: Header size includes 32-bit source and font fingerprints
+  // Test 8: Header size includes the fingerprints, the grayscale-images flag and the window start
   {
     FsFile writer;
     writer.setBuffer("");
     writeCacheHeader(writer, 0, false);
-    runner.expectEq(static_cast<uint32_t>(43), static_cast<uint32_t>(writer.getBuffer().size()),
-                    "header_size_43_bytes");
+    runner.expectEq(static_cast<uint32_t>(48), static_cast<uint32_t>(writer.getBuffer().size()),
+                    "header_size_48_bytes");
   }
 
   // Test 9: pageCount starts at byte 18 and isPartial follows its four bytes
@@ -316,6 +327,10 @@ int main() {
     serialization::writePod(writer, sourceFingerprint);
     uint32_t fontFingerprint = 0x55667788u;
     serialization::writePod(writer, fontFingerprint);
+    uint8_t grayscaleImages = 0;
+    serialization::writePod(writer, grayscaleImages);
+    uint32_t firstPage = 0;
+    serialization::writePod(writer, firstPage);
     const uint32_t pagePosition = HEADER_SIZE;
     for (uint32_t i = 0; i < pageCount; i++) serialization::writePod(writer, pagePosition);
 
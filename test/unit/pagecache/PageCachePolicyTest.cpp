@@ -53,6 +53,17 @@ int main() {
   runner.expectTrue(page_cache::extensionChunk(UINT32_MAX, 5) == 0,
                     "cache at the page-count format limit cannot overflow");
 
+  runner.expectTrue(page_cache::opensWindow(0, 0, 500, 496), "empty cache opens a window at a checkpoint");
+  runner.expectFalse(page_cache::opensWindow(0, 0, 10, 0), "empty cache without a checkpoint lays out from the start");
+  runner.expectTrue(page_cache::opensWindow(0, 100, 500, 496), "checkpoint far past the cache opens a window");
+  runner.expectFalse(page_cache::opensWindow(0, 100, 150, 144),
+                     "checkpoint a cheap replay past the cache keeps extending");
+  runner.expectFalse(page_cache::opensWindow(0, 100, 500, 96), "checkpoint inside the cache keeps extending");
+  runner.expectFalse(page_cache::opensWindow(0, 100, 50, 48), "cached page needs no window");
+  runner.expectTrue(page_cache::opensWindow(480, 520, 470, 464), "page before a window opens a new one");
+  runner.expectTrue(page_cache::opensWindow(480, 520, 470, 0), "page before a window reopens without a checkpoint");
+  runner.expectFalse(page_cache::opensWindow(480, 520, 500, 496), "page inside a window needs no new one");
+
   runner.expectTrue(page_cache::backgroundShouldExtend(true, true, true, 78, 2),
                     "hot partial cache extends far from boundary");
   runner.expectFalse(page_cache::backgroundShouldExtend(true, true, false, 78, 2),
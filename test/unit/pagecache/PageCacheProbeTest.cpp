@@ -20,15 +20,15 @@
 
 namespace {
 
-constexpr uint8_t CACHE_FILE_VERSION = 22;
-constexpr uint32_t kHeaderSize = 43;
+constexpr uint8_t CACHE_FILE_VERSION = 24;
+constexpr uint32_t kHeaderSize = 48;
 
 RenderConfig defaultConfig() {
   return RenderConfig(1818981670, 1.0f, 1, 1, 0, true, true, 464, 769, 0x12345678u, 0x89ABCDEFu);
 }
 
 void writeCacheHeader(FsFile& file, const RenderConfig& config, uint32_t pageCount, bool isPartial,
-                      uint8_t version = CACHE_FILE_VERSION) {
+                      uint8_t version = CACHE_FILE_VERSION, uint32_t firstPage = 0) {
   serialization::writePod(file, version);
   serialization::writePod(file, config.fontId);
   serialization::writePod(file, config.lineCompression);
@@ -50,8 +50,10 @@ void writeCacheHeader(FsFile& file, const RenderConfig& config, uint32_t pageCou
   serialization::writePod(file, totalBytes);
   serialization::writePod(file, config.sourceFingerprint);
   serialization::writePod(file, config.fontFingerprint);
+  serialization::writePod(file, config.grayscaleImages);
+  serialization::writePod(file, firstPage);
   const uint32_t pagePosition = kHeaderSize;
-  for (uint32_t i = 0; i < pageCount; i++) serialization::writePod(file, pagePosition);
+  for (uint32_t i = firstPage; i < pageCount; i++) serialization::writePod(file, pagePosition);
 }
 
 // Mirror of PageCache::probe() — reads header and validates config match
@@ -81,6 +83,7 @@ ProbeResult probe(const std::string& cachePath, const RenderConfig& config) {
   uint32_t lutOffset;
   uint32_t bytesConsumed;
   uint32_t totalBytes;
+  uint32_t firstPage;
   const bool headerValid = serialization::readPodChecked(file, version) &&
                            serialization::readPodChecked(file, fileConfig.fontId) &&
                            serialization::readPodChecked(file, fileConfig.lineCompression) &&
@@ -97,15 +100,17 @@ ProbeResult probe(const std::string& cachePath, const RenderConfig& config) {
                            serialization::readPodChecked(file, bytesConsumed) &&
                            serialization::readPodChecked(file, totalBytes) &&
                            serialization::readPodChecked(file, fileConfig.sourceFingerprint) &&
-                           serialization::readPodChecked(file, fileConfig.fontFingerprint);
-  const size_t lutSize = static_cast<size_t>(result.pageCount) * sizeof(uint32_t);
+                           serialization::readPodChecked(file, fileConfig.fontFingerprint) &&
+                           serialization::readPodChecked(file, fileConfig.grayscaleImages) &&
+                           serialization::readPodChecked(file, firstPage);
   if (!headerValid || version != CACHE_FILE_VERSION || config != fileConfig || partial > 1 ||
-      lutOffset < kHeaderSize || lutOffset > fileSize || lutSize > fileSize - lutOffset) {
+      firstPage > result.pageCount || lutOffset < kHeaderSize || lutOffset > fileSize ||
+      static_cast<size_t>(result.pageCount - firstPage) * sizeof(uint32_t) > fileSize - lutOffset) {
     file.close();
     return result;
   }
 
-  result.partial = partial != 0;
+  result.partial = partial != 0 || firstPage > 0;
   file.close();
   result.valid = true;
   return result;
@@ -187,6 +192,20 @@ int main() {
     runner.expectFalse(result.valid, "hyphenation_mismatch_invalid");
   }
 
+  // Config mismatch: image planes cached for the other anti-aliasing mode
+  {
+    RenderConfig differentCfg = cfg;
+    differentCfg.grayscaleImages = !cfg.grayscaleImages;
+
+    FsFile writer;
+    writer.setBuffer("");
+    writeCacheHeader(writer, cfg, 20, false);
+    SdMan.registerFile("/cache/grayscale_mismatch.bin", writer.getBuffer());
+
+    auto result = probe("/cache/grayscale_mismatch.bin", differentCfg);
+    runner.expectFalse(result.valid, "grayscale_images_mismatch_invalid");
+  }
+
   // Matching config returns valid
   {
     FsFile writer;
@@ -261,13 +280,32 @@ int main() {
     runner.expectTrue(result.partial, "wide_page_count_partial");
   }
 
-  // Header size includes both fingerprints
+  // Header size includes both fingerprints, the grayscale-images flag and the window start
   {
     FsFile writer;
     writer.setBuffer("");
     writeCacheHeader(writer, cfg, 0, false);
     runner.expectEq(static_cast<uint32_t>(kHeaderSize), static_cast<uint32_t>(writer.getBuffer().size()),
-                    "header_size_43_bytes");
+                    "header_size_48_bytes");
+  }
+
+  // A window lacks the pages before it, so it never counts as complete
+  {
+    FsFile writer;
+    writer.setBuffer("");
+    writeCacheHeader(writer, cfg, 40, false, CACHE_FILE_VERSION, 32);
+    SdMan.registerFile("/cache/window.bin", writer.getBuffer());
+
+    auto result = probe("/cache/window.bin", cfg);
+    runner.expectTrue(result.valid, "window_valid");
+    runner.expectEq(static_cast<uint32_t>(40), result.pageCount, "window_page_count_is_absolute");
+    runner.expectTrue(result.partial, "window_partial");
+
+    FsFile bad;
+    bad.setBuffer("");
+    writeCacheHeader(bad, cfg, 40, false, CACHE_FILE_VERSION, 41);
+    SdMan.registerFile("/cache/window_bad.bin", bad.getBuffer());
+    runner.expectFalse(probe("/cache/window_bad.bin", cfg).valid, "window_start_past_end_invalid");
   }
 
   SdMan.clearFiles();
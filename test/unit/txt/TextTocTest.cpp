@@ -0,0 +1,296 @@
+#include "test_utils.h"
+
+#include <ChapterDetector.h>
+#include <EpdFont.h>
+#include <EpdFontFamily.h>
+#include <GfxRenderer.h>
+#include <MarkdownParser.h>
+#include <Page.h>
+#include <ParsedText.h>
+#include <PlainTextParser.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+#include <TextToc.h>
+
+#include <string>
+#include <vector>
+
+uint8_t GfxRenderer::frameBuffer_[EInkDisplay::BUFFER_SIZE];
+
+void ImageBlock::render(GfxRenderer&, int, int, int) const {}
+bool ImageBlock::serialize(FsFile&) const { return false; }
+std::unique_ptr<ImageBlock> ImageBlock::deserialize(FsFile&) { return nullptr; }
+
+static constexpr int FONT_ID = 42;
+static constexpr uint16_t VIEWPORT_W = 300;
+static constexpr uint16_t VIEWPORT_H = 200;
+
+static const EpdGlyph testGlyphs[] = {
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+};
+
+static const EpdUnicodeInterval testIntervals[] = {{32, 126, 0}};
+
+static const EpdFontData testFontData = {
+    nullptr, testGlyphs, testIntervals, 1, 14, 11, 3, false,
+};
+
+struct TestSetup {
+  EInkDisplay display{0, 0, 0, 0, 0, 0};
+  GfxRenderer gfx{display};
+  EpdFont font{&testFontData};
+  RenderConfig config;
+
+  TestSetup() {
+    gfx.begin();
+    EpdFontFamily family(&font, &font, &font, &font);
+    gfx.insertFont(FONT_ID, family);
+
+    config.fontId = FONT_ID;
+    config.viewportWidth = VIEWPORT_W;
+    config.viewportHeight = VIEWPORT_H;
+    config.paragraphAlignment = 0;
+    config.spacingLevel = 1;
+    config.lineCompression = 1.0f;
+    config.hyphenation = false;
+  }
+};
+
+static constexpr const char* TOC_PATH = "/cache/pages.bin.toc";
+static constexpr const char* CKPT_PATH = "/cache/pages.bin.ckpt";
+
+// Feed text line by line and collect the headings the detector confirms
+static std::vector<ChapterDetector::Heading> detect(const std::string& text) {
+  ChapterDetector detector;
+  std::vector<ChapterDetector::Heading> found;
+  ChapterDetector::Heading heading;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos) end = text.size();
+    if (detector.feedLine(text.data() + pos, end - pos, static_cast<uint32_t>(pos), false, heading)) {
+      found.push_back(heading);
+    }
+    pos = end + 1;
+  }
+  if (detector.finish(heading)) found.push_back(heading);
+  return found;
+}
+
+static std::vector<std::string> titles(const std::vector<ChapterDetector::Heading>& headings) {
+  std::vector<std::string> out;
+  for (const auto& h : headings) out.push_back(h.title);
+  return out;
+}
+
+// Words of every line on the page, space separated
+static std::string pageWords(const Page& page) {
+  std::string words;
+  for (auto& elem : page.elements) {
+    if (elem->getTag() != TAG_PageLine) continue;
+    for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) {
+      words += wd.word;
+      words += ' ';
+    }
+  }
+  return words;
+}
+
+template <typename Parser>
+static std::vector<std::string> parseWords(Parser& parser, uint16_t maxPages) {
+  std::vector<std::string> pages;
+  auto onPage = [&](std::unique_ptr<Page> page) { pages.push_back(pageWords(*page)); };
+
+  parser.parsePages(onPage, maxPages);
+  while (parser.hasMoreContent()) {
+    parser.parsePages(onPage, maxPages);
+  }
+  return pages;
+}
+
+// A novel: chapters of uneven length separated by blank lines
+static std::string makeBook(int chapters) {
+  std::string text = "A Tale\n\n";
+  int n = 0;
+  for (int c = 1; c <= chapters; c++) {
+    text += "Chapter " + std::to_string(c) + "\n\n";
+    const int paragraphs = (c * 5) % 9 + 2;
+    for (int p = 0; p < paragraphs; p++) {
+      const int words = (p * 7 + c) % 40 + 10;
+      for (int w = 0; w < words; w++) {
+        if (w > 0) text += ' ';
+        text += "w" + std::to_string(n++);
+      }
+      text += ".\n\n";
+    }
+  }
+  return text;
+}
+
+// Every entry's page shows its title, and entries follow the book order
+static bool entriesMatchPages(const std::vector<TextToc::Entry>& entries, const std::vector<std::string>& pages) {
+  uint32_t lastPage = 0;
+  for (const auto& entry : entries) {
+    if (entry.page >= pages.size() || entry.page < lastPage) return false;
+    if (pages[entry.page].find(entry.title + " ") == std::string::npos) return false;
+    lastPage = entry.page;
+  }
+  return true;
+}
+
+int main() {
+  TestUtils::TestRunner runner("Text TOC");
+
+  // Test 1: Keyword headings in English and Russian
+  {
+    const auto found = titles(detect(
+        "Some preface text.\n\nCHAPTER I\n\nIt was a dark night.\n\nChapter 2: The Road\nShe walked on.\n\n"
+        "\xD0\x93\xD0\xBB\xD0\xB0\xD0\xB2\xD0\xB0 3\n\n\xD0\xA2\xD0\xB5\xD0\xBA\xD1\x81\xD1\x82.\n\n"
+        "Epilogue\n\nThe end.\n"));
+    runner.expectEq(static_cast<size_t>(4), found.size(), "keyword: four headings");
+    if (found.size() == 4) {
+      runner.expectEq(std::string("CHAPTER I"), found[0], "keyword: upper-case roman chapter");
+      runner.expectEq(std::string("Chapter 2: The Road"), found[1], "keyword: numbered chapter with a name");
+      runner.expectEq(std::string("\xD0\x93\xD0\xBB\xD0\xB0\xD0\xB2\xD0\xB0 3"), found[2], "keyword: Russian chapter");
+      runner.expectEq(std::string("Epilogue"), found[3], "keyword: epilogue");
+    }
+  }
+
+  // Test 2: Keywords inside prose are not headings
+  {
+    const auto found = detect(
+        "He read the chapter twice.\n\nChapter and verse were quoted by everyone in the room that night.\n\n"
+        "Part of him wanted to stay.\n\nThe next line\nChapter 4\ncontinues the paragraph.\n");
+    runner.expectEq(static_cast<size_t>(0), found.size(), "prose: no headings");
+  }
+
+  // Test 3: Bare numerals and titles after a separator need a blank line after them
+  {
+    const auto found = titles(detect("Intro text.\n\nIV\n\nText.\n\n12.\nstarts a list item\n\n* * *\n\n"
+                                     "The Return\n\nText.\n\n-----\nshort but followed by text\nmore text\n"));
+    runner.expectEq(static_cast<size_t>(2), found.size(), "weak: two headings");
+    if (found.size() == 2) {
+      runner.expectEq(std::string("IV"), found[0], "weak: roman numeral between blank lines");
+      runner.expectEq(std::string("The Return"), found[1], "weak: title after a separator");
+    }
+  }
+
+  // Test 4: Markdown headings, parts nest chapters below them
+  {
+    const auto found = detect("# **Book One**\n\n## Opening ##\n\nText\n\nPart Two\n\nChapter 5\n\nText\n");
+    runner.expectEq(static_cast<size_t>(4), found.size(), "nesting: four headings");
+    if (found.size() == 4) {
+      runner.expectEq(std::string("Book One"), found[0].title, "nesting: markers stripped");
+      runner.expectEq(static_cast<uint8_t>(0), found[0].depth, "nesting: # is top level");
+      runner.expectEq(std::string("Opening"), found[1].title, "nesting: closing hashes stripped");
+      runner.expectEq(static_cast<uint8_t>(1), found[1].depth, "nesting: ## is one level down");
+      runner.expectEq(static_cast<uint8_t>(0), found[2].depth, "nesting: part is top level");
+      runner.expectEq(static_cast<uint8_t>(1), found[3].depth, "nesting: chapter after a part is nested");
+    }
+  }
+
+  // Test 5: A TXT parse writes entries that land on their heading's page
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/toc.txt";
+    SdMan.registerFile(path, makeBook(30));
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setTocPath(TOC_PATH);
+    const auto pages = parseWords(parser, 0);
+
+    TextToc toc;
+    runner.expectTrue(toc.load(TOC_PATH, setup.config), "txt: TOC file loads");
+    runner.expectEq(static_cast<size_t>(30), toc.entries().size(), "txt: one entry per chapter");
+    runner.expectTrue(entriesMatchPages(toc.entries(), pages), "txt: entries point at their pages");
+    runner.expectTrue(pages.size() > 30, "txt: chapters span many pages");
+
+    RenderConfig other = setup.config;
+    other.viewportWidth = VIEWPORT_W - 20;
+    runner.expectFalse(toc.load(TOC_PATH, other), "txt: another layout is rejected");
+    runner.expectTrue(toc.entries().empty(), "txt: rejected TOC is empty");
+  }
+
+  // Test 6: Batched parses and checkpoint resumes don't duplicate entries
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/toc_resume.txt";
+    SdMan.registerFile(path, makeBook(30));
+
+    PlainTextParser oneShot(path, setup.gfx, setup.config);
+    oneShot.setTocPath(TOC_PATH);
+    const auto pages = parseWords(oneShot, 0);
+    const std::string expected = SdMan.getWrittenData(TOC_PATH);
+
+    PlainTextParser batched(path, setup.gfx, setup.config);
+    batched.setTocPath(TOC_PATH);
+    batched.setCheckpointPath(CKPT_PATH);
+    parseWords(batched, 3);
+    runner.expectTrue(SdMan.getWrittenData(TOC_PATH) == expected, "resume: batched TOC matches one pass");
+
+    PlainTextParser resumed(path, setup.gfx, setup.config);
+    resumed.setTocPath(TOC_PATH);
+    resumed.setCheckpointPath(CKPT_PATH);
+    const uint32_t first = resumed.seekToCheckpoint(static_cast<uint32_t>(pages.size()) / 2);
+    runner.expectTrue(first > 0, "resume: checkpoint found mid-book");
+    parseWords(resumed, 0);
+    runner.expectTrue(SdMan.getWrittenData(TOC_PATH) == expected, "resume: TOC unchanged after a resume");
+  }
+
+  // Test 7: Markdown headings map to the page they start
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/toc.md";
+    std::string text;
+    int n = 0;
+    for (int c = 1; c <= 12; c++) {
+      text += (c % 4 == 1 ? "# Part " : "## Section ") + std::to_string(c) + "\n";
+      for (int p = 0; p < (c % 3) + 2; p++) {
+        for (int w = 0; w < 35; w++) text += "m" + std::to_string(n++) + " ";
+        text += "\n\n";
+      }
+    }
+    SdMan.registerFile(path, text);
+
+    MarkdownParser parser(path, setup.gfx, setup.config);
+    parser.setTocPath(TOC_PATH);
+    const auto pages = parseWords(parser, 2);
+
+    TextToc toc;
+    runner.expectTrue(toc.load(TOC_PATH, setup.config), "md: TOC file loads");
+    runner.expectEq(static_cast<size_t>(12), toc.entries().size(), "md: one entry per header");
+    runner.expectTrue(entriesMatchPages(toc.entries(), pages), "md: entries point at their pages");
+    if (toc.entries().size() == 12) {
+      runner.expectEq(static_cast<uint8_t>(0), toc.entries()[0].depth, "md: # is top level");
+      runner.expectEq(static_cast<uint8_t>(1), toc.entries()[1].depth, "md: ## is nested");
+    }
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
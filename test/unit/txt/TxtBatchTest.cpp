@@ -275,5 +275,62 @@ int main() {
     runner.expectTrue(unbatchedWords == batchedWords, "mixed: all words identical");
   }
 
+  // Test 7: Word boundaries and long-word splits are the same for every byte class
+  {
+    TestSetup setup;
+    std::string content = "ab\fcd ef\x01g  tab\tsep\r\nnext\n\n";
+    content += std::string(250, 'x') + "\n\n";
+    for (int i = 0; i < 60; i++) content += "\xD0\xB4";  // "д"
+    content += " end\n";
+    const std::string path = "/test_bytes.txt";
+
+    SdMan.registerFile(path, content);
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    const auto words = collectWords(parseAll(parser, 0));
+
+    const std::vector<std::string> expected = {
+        "ab\fcd",
+        "ef\x01g",
+        "tab",
+        "sep",
+        "next",
+        std::string(101, 'x'),
+        std::string(101, 'x'),
+        std::string(48, 'x'),
+        std::string(content, content.find("\xD0\xB4"), 100),
+        std::string(content, content.find("\xD0\xB4"), 20),
+        "end",
+    };
+    runner.expectTrue(words == expected, "bytes: control characters stay in words, long words split at 101 bytes");
+  }
+
+  // Test 8: Windows-1251 text converts to the same words as its UTF-8 form
+  {
+    TestSetup setup;
+    // "Привет мир, это проверка." in Windows-1251 and UTF-8
+    const std::string cp1251 = "\xCF\xF0\xE8\xE2\xE5\xF2 \xEC\xE8\xF0, \xFD\xF2\xEE "
+                               "\xEF\xF0\xEE\xE2\xE5\xF0\xEA\xE0.\n\n";
+    const std::string utf8 =
+        "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 \xD0\xBC\xD0\xB8\xD1\x80, "
+        "\xD1\x8D\xD1\x82\xD0\xBE \xD0\xBF\xD1\x80\xD0\xBE\xD0\xB2\xD0\xB5\xD1\x80\xD0\xBA\xD0\xB0.\n\n";
+    std::string cpContent;
+    std::string utfContent;
+    for (int i = 0; i < 40; i++) {
+      cpContent += cp1251;
+      utfContent += utf8;
+    }
+
+    SdMan.registerFile("/test_cp1251.txt", cpContent);
+    PlainTextParser cpParser("/test_cp1251.txt", setup.gfx, setup.config);
+    const auto cpWords = collectWords(parseAll(cpParser, 0));
+
+    SdMan.registerFile("/test_utf8.txt", utfContent);
+    PlainTextParser utfParser("/test_utf8.txt", setup.gfx, setup.config);
+    const auto utfWords = collectWords(parseAll(utfParser, 0));
+
+    runner.expectEq(static_cast<int>(160), static_cast<int>(cpWords.size()), "cp1251: all words found");
+    runner.expectTrue(cpWords == utfWords, "cp1251: words match the UTF-8 text");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
@@ -0,0 +1,413 @@
+#include "test_utils.h"
+
+#include <EpdFont.h>
+#include <EpdFontFamily.h>
+#include <GfxRenderer.h>
+#include <Page.h>
+#include <ParsedText.h>
+#include <PageCache.h>
+#include <PlainTextParser.h>
+#include <RenderConfig.h>
+#include <SDCardManager.h>
+
+#include <string>
+#include <vector>
+
+uint8_t GfxRenderer::frameBuffer_[EInkDisplay::BUFFER_SIZE];
+
+void ImageBlock::render(GfxRenderer&, int, int, int) const {}
+bool ImageBlock::serialize(FsFile&) const { return false; }
+std::unique_ptr<ImageBlock> ImageBlock::deserialize(FsFile&) { return nullptr; }
+
+static constexpr int FONT_ID = 42;
+static constexpr uint16_t VIEWPORT_W = 300;
+static constexpr uint16_t VIEWPORT_H = 200;
+
+static const EpdGlyph testGlyphs[] = {
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+    {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0}, {6, 10, 7, 0, 10, 0, 0},
+};
+
+static const EpdUnicodeInterval testIntervals[] = {{32, 126, 0}};
+
+static const EpdFontData testFontData = {
+    nullptr, testGlyphs, testIntervals, 1, 14, 11, 3, false,
+};
+
+struct TestSetup {
+  EInkDisplay display{0, 0, 0, 0, 0, 0};
+  GfxRenderer gfx{display};
+  EpdFont font{&testFontData};
+  RenderConfig config;
+
+  TestSetup() {
+    gfx.begin();
+    EpdFontFamily family(&font, &font, &font, &font);
+    gfx.insertFont(FONT_ID, family);
+
+    config.fontId = FONT_ID;
+    config.viewportWidth = VIEWPORT_W;
+    config.viewportHeight = VIEWPORT_H;
+    config.paragraphAlignment = 0;
+    config.spacingLevel = 1;
+    config.lineCompression = 1.0f;
+    config.hyphenation = false;
+  }
+};
+
+static constexpr const char* CKPT_PATH = "/cache/pages.bin.ckpt";
+
+// One string per page: every line's y position and words
+static std::string pageSignature(const Page& page) {
+  std::string sig;
+  for (auto& elem : page.elements) {
+    if (elem->getTag() != TAG_PageLine) continue;
+    sig += std::to_string(elem->yPos) + ":";
+    for (auto& wd : static_cast<PageLine*>(elem.get())->getTextBlock().getWords()) {
+      sig += wd.word;
+      sig += ' ';
+    }
+    sig += '|';
+  }
+  return sig;
+}
+
+static std::vector<std::string> parseSignatures(PlainTextParser& parser, uint16_t maxPages) {
+  std::vector<std::string> sigs;
+  auto onPage = [&](std::unique_ptr<Page> page) { sigs.push_back(pageSignature(*page)); };
+
+  parser.parsePages(onPage, maxPages);
+  while (parser.hasMoreContent()) {
+    parser.parsePages(onPage, maxPages);
+  }
+  return sigs;
+}
+
+// Paragraphs of uneven length so pages open on block starts and mid-block alike
+static std::string makeText(int paragraphs) {
+  std::string text;
+  int n = 0;
+  for (int p = 0; p < paragraphs; p++) {
+    const int words = (p * 7) % 40 + 3;
+    for (int w = 0; w < words; w++) {
+      if (w > 0) text += ' ';
+      text += "w" + std::to_string(n++);
+    }
+    text += "\n\n";
+  }
+  return text;
+}
+
+static uint32_t checkpointRecordCount() {
+  const size_t size = SdMan.getWrittenData(CKPT_PATH).size();
+  const size_t header = 1 + 4 + 4 + 1 + 1 + 1 + 1 + 1 + 2 + 2 + 4 + 4;
+  return size > header ? static_cast<uint32_t>((size - header) / 9) : 0;
+}
+
+// Lay out from every checkpoint in turn and compare with the continuous parse
+static bool resumesMatch(const std::string& path, const RenderConfig& config, GfxRenderer& gfx,
+                         const std::vector<std::string>& full, uint16_t maxPages, int& checked) {
+  checked = 0;
+  uint32_t probe = static_cast<uint32_t>(full.size());
+  while (true) {
+    PlainTextParser resumed(path, gfx, config);
+    resumed.setCheckpointPath(CKPT_PATH);
+    const uint32_t first = resumed.seekToCheckpoint(probe);
+    if (first == 0) return true;
+    const auto tail = parseSignatures(resumed, maxPages);
+    if (first + tail.size() != full.size()) return false;
+    for (size_t i = 0; i < tail.size(); i++) {
+      if (tail[i] != full[first + i]) return false;
+    }
+    checked++;
+    probe = first - 1;
+  }
+}
+
+int main() {
+  TestUtils::TestRunner runner("TXT Checkpoint Index");
+
+  // Test 1: A full parse records sparse checkpoints
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt.txt";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(parser, 0);
+
+    runner.expectTrue(full.size() > 60, "record: book spans many pages");
+    const uint32_t records = checkpointRecordCount();
+    runner.expectTrue(records >= 3, "record: several checkpoints written");
+    runner.expectTrue(records <= full.size() / PlainTextParser::CHECKPOINT_SPACING,
+                      "record: checkpoints stay sparse");
+
+    const uint32_t first = parser.checkpointBefore(static_cast<uint32_t>(full.size()));
+    runner.expectTrue(first >= PlainTextParser::CHECKPOINT_SPACING && first < full.size(),
+                      "record: lookup finds a checkpoint inside the book");
+    runner.expectEq(static_cast<uint32_t>(0), parser.checkpointBefore(PlainTextParser::CHECKPOINT_SPACING - 1),
+                    "record: no checkpoint before the first spacing interval");
+  }
+
+  // Test 2: Layout from each checkpoint matches the continuous parse
+  for (const uint8_t spacing : {0, 1, 3}) {
+    SdMan.reset();
+    TestSetup setup;
+    setup.config.spacingLevel = spacing;
+    const std::string path = "/ckpt_spacing.txt";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(parser, 0);
+
+    int checked = 0;
+    const std::string label = "resume (spacing " + std::to_string(spacing) + ")";
+    runner.expectTrue(resumesMatch(path, setup.config, setup.gfx, full, 0, checked), label + ": pages match");
+    runner.expectTrue(checked >= 3, label + ": several checkpoints exercised");
+  }
+
+  // Test 3: Checkpoints recorded across batches, and batched resumes, agree with one pass
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_batch.txt";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser oneShot(path, setup.gfx, setup.config);
+    const auto full = parseSignatures(oneShot, 0);
+
+    PlainTextParser batched(path, setup.gfx, setup.config);
+    batched.setCheckpointPath(CKPT_PATH);
+    runner.expectTrue(parseSignatures(batched, 3) == full, "batch: batched parse matches one pass");
+
+    int checked = 0;
+    runner.expectTrue(resumesMatch(path, setup.config, setup.gfx, full, 5, checked), "batch: batched resumes match");
+    runner.expectTrue(checked >= 3, "batch: several checkpoints exercised");
+  }
+
+  // Test 4: Paragraphs split at the word cap still resume exactly
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_long.txt";
+    std::string text;
+    for (int i = 0; i < 4000; i++) {
+      text += "long" + std::to_string(i);
+      text += (i % 1500 == 1499) ? "\n\n" : " ";
+    }
+    SdMan.registerFile(path, text);
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(parser, 0);
+
+    int checked = 0;
+    runner.expectTrue(resumesMatch(path, setup.config, setup.gfx, full, 0, checked), "long: pages match");
+    runner.expectTrue(checked >= 1, "long: soft-split blocks yield checkpoints");
+  }
+
+  // Test 5: An index written for another layout is ignored
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_stale.txt";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(parser, 0);
+    runner.expectTrue(parser.checkpointBefore(static_cast<uint32_t>(full.size())) > 0, "stale: index present");
+
+    RenderConfig other = setup.config;
+    other.viewportHeight = VIEWPORT_H - 20;
+    PlainTextParser otherParser(path, setup.gfx, other);
+    otherParser.setCheckpointPath(CKPT_PATH);
+    runner.expectEq(static_cast<uint32_t>(0), otherParser.checkpointBefore(static_cast<uint32_t>(full.size())),
+                    "stale: lookup ignores other layout");
+    runner.expectEq(static_cast<uint32_t>(0), otherParser.seekToCheckpoint(static_cast<uint32_t>(full.size())),
+                    "stale: seek falls back to the start");
+
+    const std::string header = SdMan.getWrittenData(CKPT_PATH).substr(0, 10);
+    FsFile truncated;
+    SdMan.openFileForWrite("TEST", CKPT_PATH, truncated);
+    truncated.write(reinterpret_cast<const uint8_t*>(header.data()), header.size());
+    truncated.close();
+    runner.expectEq(static_cast<uint32_t>(0), parser.checkpointBefore(static_cast<uint32_t>(full.size())),
+                    "stale: truncated header ignored");
+  }
+
+  // Test 6: A cold page cache extend replays from a checkpoint and matches one pass
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_cache.txt";
+    const std::string cachePath = "/cache/pages.bin";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser oneShot(path, setup.gfx, setup.config);
+    const auto full = parseSignatures(oneShot, 0);
+
+    {
+      PlainTextParser parser(path, setup.gfx, setup.config);
+      parser.setCheckpointPath(CKPT_PATH);
+      PageCache cache(cachePath);
+      runner.expectTrue(cache.create(parser, setup.config, 70), "cache: initial chunk created");
+    }
+
+    PlainTextParser coldParser(path, setup.gfx, setup.config);
+    coldParser.setCheckpointPath(CKPT_PATH);
+    runner.expectTrue(coldParser.checkpointBefore(70) > 0, "cache: checkpoint available before the cache end");
+
+    PageCache cache(cachePath);
+    runner.expectTrue(cache.load(setup.config), "cache: reloads partial cache");
+    while (cache.isPartial()) {
+      if (!cache.extend(coldParser, 50)) break;
+    }
+    runner.expectEq(static_cast<uint32_t>(full.size()), cache.pageCount(), "cache: extended to the full book");
+
+    bool allMatch = true;
+    for (uint32_t i = 0; i < cache.pageCount() && i < full.size(); i++) {
+      auto page = cache.loadPage(i);
+      if (!page || pageSignature(*page) != full[i]) {
+        allMatch = false;
+        break;
+      }
+    }
+    runner.expectTrue(allMatch, "cache: cached pages match one pass");
+  }
+
+  // Test 7: A window opens at the checkpoint before a far page and holds the same pages
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_window.txt";
+    const std::string cachePath = "/cache/pages.bin";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser indexer(path, setup.gfx, setup.config);
+    indexer.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(indexer, 0);
+    const uint32_t target = static_cast<uint32_t>(full.size()) - 10;
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    PageCache cache(cachePath);
+    runner.expectTrue(cache.createWindow(parser, setup.config, target), "window: created");
+    runner.expectEq(parser.checkpointBefore(target), cache.firstPage(), "window: starts at the checkpoint");
+    runner.expectTrue(cache.firstPage() > 0 && cache.hasPage(target), "window: holds the target page");
+    runner.expectFalse(cache.hasPage(cache.firstPage() - 1), "window: pages before it are not cached");
+    runner.expectTrue(cache.loadPage(cache.firstPage() - 1) == nullptr, "window: load before it fails");
+
+    PageCache reloaded(cachePath);
+    runner.expectTrue(reloaded.load(setup.config), "window: reloads");
+    runner.expectEq(cache.firstPage(), reloaded.firstPage(), "window: start survives a reload");
+    runner.expectTrue(PageCache::probe(cachePath, setup.config).partial, "window: probe reports it partial");
+
+    PlainTextParser coldParser(path, setup.gfx, setup.config);
+    coldParser.setCheckpointPath(CKPT_PATH);
+    while (reloaded.isPartial()) {
+      if (!reloaded.extend(coldParser, 50)) break;
+    }
+    runner.expectEq(static_cast<uint32_t>(full.size()), reloaded.pageCount(), "window: extends to the book end");
+
+    bool allMatch = true;
+    for (uint32_t i = reloaded.firstPage(); i < reloaded.pageCount(); i++) {
+      auto page = reloaded.loadPage(i);
+      if (!page || pageSignature(*page) != full[i]) {
+        allMatch = false;
+        break;
+      }
+    }
+    runner.expectTrue(allMatch, "window: pages match one pass");
+  }
+
+  // Test 8: Backfill lays out the pages before a window and swaps in a contiguous cache
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_backfill.txt";
+    const std::string cachePath = "/cache/pages.bin";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser indexer(path, setup.gfx, setup.config);
+    indexer.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(indexer, 0);
+    const uint32_t records = checkpointRecordCount();
+    const uint32_t target = static_cast<uint32_t>(full.size()) / 2;
+
+    PlainTextParser parser(path, setup.gfx, setup.config);
+    parser.setCheckpointPath(CKPT_PATH);
+    PageCache cache(cachePath);
+    runner.expectTrue(cache.createWindow(parser, setup.config, target), "backfill: window created");
+    const uint32_t windowEnd = cache.pageCount();
+    runner.expectTrue(cache.firstPage() > 0, "backfill: window starts past page 0");
+
+    int steps = 0;
+    while (cache.firstPage() > 0 && steps < 100) {
+      if (!cache.backfill(parser)) break;
+      steps++;
+    }
+    runner.expectEq(static_cast<uint32_t>(0), cache.firstPage(), "backfill: cache becomes contiguous");
+    runner.expectTrue(steps > 1, "backfill: spread over several steps");
+    runner.expectTrue(cache.pageCount() >= windowEnd, "backfill: keeps the window's pages");
+    runner.expectFalse(SdMan.exists((cachePath + ".fill").c_str()), "backfill: fill file replaces the cache");
+    runner.expectEq(records, checkpointRecordCount(), "backfill: checkpoint index kept");
+
+    bool allMatch = true;
+    for (uint32_t i = 0; i < cache.pageCount(); i++) {
+      auto page = cache.loadPage(i);
+      if (!page || pageSignature(*page) != full[i]) {
+        allMatch = false;
+        break;
+      }
+    }
+    runner.expectTrue(allMatch, "backfill: pages match one pass");
+  }
+
+  // Test 9: Laying out again from the start keeps an index for the same layout
+  {
+    SdMan.reset();
+    TestSetup setup;
+    const std::string path = "/ckpt_keep.txt";
+    SdMan.registerFile(path, makeText(300));
+
+    PlainTextParser indexer(path, setup.gfx, setup.config);
+    indexer.setCheckpointPath(CKPT_PATH);
+    const auto full = parseSignatures(indexer, 0);
+    const uint32_t records = checkpointRecordCount();
+
+    PlainTextParser again(path, setup.gfx, setup.config);
+    again.setCheckpointPath(CKPT_PATH);
+    again.parsePages([](std::unique_ptr<Page>) {}, 5);
+    runner.expectEq(records, checkpointRecordCount(), "keep: index survives a parse from the start");
+    runner.expectEq(indexer.checkpointBefore(static_cast<uint32_t>(full.size())),
+                    again.checkpointBefore(static_cast<uint32_t>(full.size())), "keep: last checkpoint still found");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
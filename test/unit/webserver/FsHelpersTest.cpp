@@ -13,6 +13,10 @@ int main() {
   runner.expectTrue(FsHelpers::isFb2File("/path/to/book.fb2"), "fb2 with path");
   runner.expectFalse(FsHelpers::isFb2File("book.epub"), "fb2 rejects epub");
   runner.expectFalse(FsHelpers::isFb2File("fb2"), "fb2 rejects no dot");
+  runner.expectTrue(FsHelpers::isFb2File("/path/to/book.fb2.zip"), "fb2.zip accepted");
+  runner.expectTrue(FsHelpers::isFb2File("book.FB2.ZIP"), "fb2.zip uppercase");
+  runner.expectFalse(FsHelpers::isFb2File("book.zip"), "fb2 rejects plain zip");
+  runner.expectFalse(FsHelpers::isFb2File(".fb2.zip"), "fb2 rejects bare suffix");
 
   // --- isXtcFile with .xtg and .xth ---
   runner.expectTrue(FsHelpers::isXtcFile("file.xtc"), "xtc basic");
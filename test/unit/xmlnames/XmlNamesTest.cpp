@@ -0,0 +1,71 @@
+// XmlNames perfect hash tests - every known name resolves to its own ID,
+// unknown and near-miss names resolve to Unknown.
+
+#include "test_utils.h"
+
+#include <XmlNames.h>
+
+#include <set>
+#include <string>
+
+int main() {
+  TestUtils::TestRunner runner("XmlNames");
+
+  // Test 1: every table entry maps back to its ID
+  {
+    bool allFound = true;
+    std::set<XmlName> seen;
+    for (size_t i = 0; i < xml_names::kEntryCount; i++) {
+      const auto& entry = xml_names::kEntries[i];
+      if (lookupXmlName(entry.name) != entry.id) {
+        allFound = false;
+      }
+      seen.insert(entry.id);
+    }
+    runner.expectTrue(allFound, "all entries resolve to their ID");
+    runner.expectEq(xml_names::kEntryCount, seen.size(), "IDs are unique");
+  }
+
+  // Test 2: tag and attribute names
+  {
+    runner.expectTrue(lookupXmlName("p") == XmlName::P, "p");
+    runner.expectTrue(lookupXmlName("h3") == XmlName::H3, "h3");
+    runner.expectTrue(lookupXmlName("img") == XmlName::Img, "img");
+    runner.expectTrue(lookupXmlName("class") == XmlName::Class, "class attribute");
+    runner.expectTrue(lookupXmlName("epub:type") == XmlName::EpubType, "prefixed attribute");
+    runner.expectTrue(lookupXmlName("aria-hidden") == XmlName::AriaHidden, "hyphenated attribute");
+  }
+
+  // Test 3: unknown names, prefixes and near misses
+  {
+    runner.expectTrue(lookupXmlName("") == XmlName::Unknown, "empty name");
+    runner.expectTrue(lookupXmlName("span") == XmlName::Unknown, "span is not dispatched");
+    runner.expectTrue(lookupXmlName("P") == XmlName::Unknown, "lookup is case-sensitive like Expat");
+    runner.expectTrue(lookupXmlName("pre ") == XmlName::Unknown, "trailing space");
+    runner.expectTrue(lookupXmlName("h7") == XmlName::Unknown, "h7");
+    runner.expectTrue(lookupXmlName("blockquotes") == XmlName::Unknown, "longer name with known prefix");
+    runner.expectTrue(lookupXmlName("bloc") == XmlName::Unknown, "prefix of known name");
+  }
+
+  // Test 4: namespace stripping for FB2
+  {
+    runner.expectTrue(lookupXmlLocalName("section") == XmlName::Section, "unprefixed");
+    runner.expectTrue(lookupXmlLocalName("fb:section") == XmlName::Section, "fb: prefix");
+    runner.expectTrue(lookupXmlLocalName("l:href") == XmlName::Href, "l:href");
+    runner.expectTrue(lookupXmlLocalName("xlink:href") == XmlName::Href, "xlink:href");
+    runner.expectTrue(lookupXmlLocalName("http://www.gribuser.ru/xml/fictionbook/2.0:empty-line") == XmlName::EmptyLine,
+                      "expat namespace URI separator");
+    runner.expectTrue(lookupXmlLocalName("fb:") == XmlName::Unknown, "empty local name");
+  }
+
+  // Test 5: hash spreads the whole table (no slot shared between entries)
+  {
+    std::set<size_t> slots;
+    for (size_t i = 0; i < xml_names::kEntryCount; i++) {
+      slots.insert(xml_names::hash(xml_names::kEntries[i].name, xml_names::kTable.seed) & (xml_names::kTableSize - 1));
+    }
+    runner.expectEq(xml_names::kEntryCount, slots.size(), "collision-free slots");
+  }
+
+  return runner.allPassed() ? 0 : 1;
+}
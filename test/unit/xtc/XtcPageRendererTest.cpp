@@ -96,6 +96,66 @@ std::string buildMixedDimensionXtc() {
   return file;
 }
 
+// Multi-page 1-bit book; page p is a pseudo-random pattern seeded with p
+std::string buildPatternXtc(const uint16_t width, const uint16_t height, const size_t pageCount) {
+  constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+  const size_t pageDataOffset = pageTableOffset + pageCount * sizeof(xtc::PageTableEntry);
+  const size_t bitmapSize = xtc::xtgBitmapSize(width, height);
+  const size_t pageSize = sizeof(xtc::XtgPageHeader) + bitmapSize;
+
+  std::string file(pageDataOffset + pageCount * pageSize, '\0');
+  auto* data = reinterpret_cast<uint8_t*>(&file[0]);
+  auto* header = reinterpret_cast<xtc::XtcHeader*>(data);
+  header->magic = xtc::XTC_MAGIC;
+  header->versionMajor = 1;
+  header->pageCount = static_cast<uint16_t>(pageCount);
+  header->pageTableOffset = pageTableOffset;
+  header->dataOffset = pageDataOffset;
+
+  for (size_t i = 0; i < pageCount; i++) {
+    const size_t offset = pageDataOffset + i * pageSize;
+    auto* entry = reinterpret_cast<xtc::PageTableEntry*>(data + pageTableOffset + i * sizeof(xtc::PageTableEntry));
+    entry->dataOffset = offset;
+    entry->dataSize = pageSize;
+    entry->width = width;
+    entry->height = height;
+
+    auto* pageHeader = reinterpret_cast<xtc::XtgPageHeader*>(data + offset);
+    pageHeader->magic = xtc::XTG_MAGIC;
+    pageHeader->width = width;
+    pageHeader->height = height;
+    pageHeader->dataSize = bitmapSize;
+    uint32_t state = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+    for (size_t b = 0; b < bitmapSize; b++) {
+      state = state * 1664525u + 1013904223u;
+      // Mostly white, like text pages, with some solid black bytes
+      const uint8_t r = static_cast<uint8_t>(state >> 24);
+      data[offset + sizeof(*pageHeader) + b] = r < 96 ? 0xFF : (r < 104 ? 0x00 : r);
+    }
+  }
+  return file;
+}
+
+// Frame buffer the per-pixel path produces for page `pageNum` of a buildPatternXtc() file
+std::vector<uint8_t> referenceFrame(const std::string& file, const size_t pageNum, const uint16_t width,
+                                    const uint16_t height) {
+  EInkDisplay display(0, 0, 0, 0, 0, 0);
+  GfxRenderer gfx(display);
+  gfx.begin();
+  gfx.clearScreen();
+  constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+  const auto* entry = reinterpret_cast<const xtc::PageTableEntry*>(file.data() + pageTableOffset +
+                                                                   pageNum * sizeof(xtc::PageTableEntry));
+  const auto* bitmap = reinterpret_cast<const uint8_t*>(file.data() + entry->dataOffset + sizeof(xtc::XtgPageHeader));
+  const size_t rowBytes = (width + 7) / 8;
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      if ((bitmap[y * rowBytes + x / 8] & (0x80 >> (x % 8))) == 0) gfx.drawPixel(x, y, true);
+    }
+  }
+  return std::vector<uint8_t>(gfx.getFrameBuffer(), gfx.getFrameBuffer() + gfx.getBufferSize());
+}
+
 }  // namespace
 
 int main() {
@@ -325,6 +385,110 @@ int main() {
     runner.expectTrue(requests.empty(), "malformed stream: no refresh requested");
   }
 
+  {
+    SdMan.reset();
+    constexpr uint16_t width = 480;
+    constexpr uint16_t height = 800;
+    const std::string file = buildPatternXtc(width, height, 3);
+    SdMan.registerFile("/pattern.xtc", file);
+
+    EInkDisplay blitDisplay(0, 0, 0, 0, 0, 0);
+    GfxRenderer blitGfx(blitDisplay);
+    blitGfx.begin();
+    papyrix::XtcPageRenderer blitRenderer(blitGfx);
+    xtc::XtcParser parser;
+    runner.expectTrue(parser.open("/pattern.xtc") == xtc::XtcError::OK, "transpose blit: parser opens");
+
+    auto renderPage = [&](const uint32_t page) {
+      return blitRenderer.render(parser, page, [](papyrix::XtcPageRenderer::RefreshRequest) {});
+    };
+    auto frameMatches = [&](const uint32_t page) {
+      const auto expected = referenceFrame(file, page, width, height);
+      return memcmp(expected.data(), blitGfx.getFrameBuffer(), expected.size()) == 0;
+    };
+
+    runner.expectTrue(renderPage(0) == papyrix::XtcPageRenderer::RenderResult::Success, "transpose blit: renders");
+    runner.expectTrue(frameMatches(0), "transpose blit: matches per-pixel rendering");
+    runner.expectFalse(blitRenderer.hasPrefetchedPage(parser, 1), "prefetch: render does not read ahead");
+    runner.expectTrue(blitRenderer.prefetchPage(parser, 1), "prefetch: next page read");
+    runner.expectTrue(blitRenderer.hasPrefetchedPage(parser, 1), "prefetch: next page held");
+
+    // Stale frame content must not survive: the blit overwrites every byte
+    memset(blitGfx.getFrameBuffer(), 0x00, blitGfx.getBufferSize());
+    runner.expectTrue(renderPage(1) == papyrix::XtcPageRenderer::RenderResult::Success,
+                      "prefetch: prefetched page renders");
+    runner.expectTrue(frameMatches(1), "prefetch: prefetched page matches per-pixel rendering");
+    runner.expectFalse(blitRenderer.hasPrefetchedPage(parser, 1), "prefetch: page used once");
+
+    // Jumping elsewhere streams from SD and still renders the requested page
+    runner.expectTrue(blitRenderer.prefetchPage(parser, 2), "prefetch: buffer reused");
+    runner.expectTrue(renderPage(0) == papyrix::XtcPageRenderer::RenderResult::Success && frameMatches(0),
+                      "prefetch: page jump bypasses the prefetched page");
+    runner.expectTrue(renderPage(2) == papyrix::XtcPageRenderer::RenderResult::Success && frameMatches(2),
+                      "prefetch: last page renders");
+    runner.expectFalse(blitRenderer.prefetchPage(parser, 3), "prefetch: nothing past the last page");
+
+    runner.expectFalse(blitRenderer.prefetchPage(parser, 1, [] { return true; }), "prefetch: abort stops the read");
+    runner.expectFalse(blitRenderer.hasPrefetchedPage(parser, 1), "prefetch: aborted page not held");
+
+    blitRenderer.prefetchPage(parser, 1);
+    blitRenderer.releasePrefetch();
+    runner.expectFalse(blitRenderer.hasPrefetchedPage(parser, 1), "prefetch: release drops the page");
+
+    // The buffer is only allocated with PREFETCH_HEAP_RESERVE to spare
+    const size_t pageBytes = xtc::xtgBitmapSize(width, height);
+    testSetLargestFreeBlock(pageBytes + papyrix::XtcPageRenderer::PREFETCH_HEAP_RESERVE - 1);
+    runner.expectFalse(blitRenderer.prefetchPage(parser, 1), "prefetch: skipped just below the reserve");
+    testSetLargestFreeBlock(pageBytes + papyrix::XtcPageRenderer::PREFETCH_HEAP_RESERVE);
+    runner.expectTrue(blitRenderer.prefetchPage(parser, 1), "prefetch: allocated at the reserve");
+    blitRenderer.releasePrefetch();
+
+    testSetLargestFreeBlock(5120);
+    runner.expectFalse(blitRenderer.prefetchPage(parser, 1), "prefetch: low heap skips the read");
+    testResetLargestFreeBlock();
+    runner.expectTrue(renderPage(1) == papyrix::XtcPageRenderer::RenderResult::Success && frameMatches(1),
+                      "prefetch: skipped page still renders");
+  }
+
+  {
+    // Landscape keeps the per-pixel path; it must agree with drawPixel too
+    SdMan.reset();
+    constexpr uint16_t width = 800;
+    constexpr uint16_t height = 480;
+    const std::string file = buildPatternXtc(width, height, 2);
+    SdMan.registerFile("/landscape.xtc", file);
+
+    EInkDisplay landscapeDisplay(0, 0, 0, 0, 0, 0);
+    GfxRenderer landscapeGfx(landscapeDisplay);
+    landscapeGfx.begin();
+    landscapeGfx.setOrientation(GfxRenderer::LandscapeCounterClockwise);
+    papyrix::XtcPageRenderer landscapeRenderer(landscapeGfx);
+    xtc::XtcParser parser;
+    parser.open("/landscape.xtc");
+    landscapeRenderer.render(parser, 0, [](papyrix::XtcPageRenderer::RefreshRequest) {});
+    landscapeRenderer.prefetchPage(parser, 1);
+    const auto result = landscapeRenderer.render(parser, 1, [](papyrix::XtcPageRenderer::RefreshRequest) {});
+    runner.expectTrue(result == papyrix::XtcPageRenderer::RenderResult::Success, "landscape: prefetched page renders");
+
+    EInkDisplay referenceDisplay(0, 0, 0, 0, 0, 0);
+    GfxRenderer referenceGfx(referenceDisplay);
+    referenceGfx.begin();
+    referenceGfx.setOrientation(GfxRenderer::LandscapeCounterClockwise);
+    referenceGfx.clearScreen();
+    constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+    const auto* entry =
+        reinterpret_cast<const xtc::PageTableEntry*>(file.data() + pageTableOffset + sizeof(xtc::PageTableEntry));
+    const auto* bitmap = reinterpret_cast<const uint8_t*>(file.data() + entry->dataOffset + sizeof(xtc::XtgPageHeader));
+    for (uint16_t y = 0; y < height; y++) {
+      for (uint16_t x = 0; x < width; x++) {
+        if ((bitmap[y * (width / 8) + x / 8] & (0x80 >> (x % 8))) == 0) referenceGfx.drawPixel(x, y, true);
+      }
+    }
+    runner.expectTrue(memcmp(referenceGfx.getFrameBuffer(), landscapeGfx.getFrameBuffer(),
+                             landscapeGfx.getBufferSize()) == 0,
+                      "landscape: matches per-pixel rendering");
+  }
+
   runner.printSummary();
   return runner.allPassed() ? 0 : 1;
 }
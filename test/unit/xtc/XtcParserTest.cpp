@@ -1,6 +1,7 @@
 #include <HardwareSerial.h>
 #include <SDCardManager.h>
 #include <SdFat.h>
+#include <Xtc/XtcPageEncoder.h>
 #include <Xtc/XtcParser.h>
 #include <Xtc/XtcTypes.h>
 
@@ -77,6 +78,54 @@ static std::string buildMultiPageXtc(uint16_t width, uint16_t height, uint16_t p
   return buf;
 }
 
+// Helper: build an XTC/XTCH file whose pages are stored with `compression`
+static std::string buildCompressedXtc(const std::vector<std::vector<uint8_t>>& pages, uint16_t width, uint16_t height,
+                                      uint8_t bitDepth, uint8_t compression) {
+  const size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+  const size_t pageDataStart = pageTableOffset + sizeof(xtc::PageTableEntry) * pages.size();
+  std::string buf(pageDataStart, '\0');
+  auto* hdr = reinterpret_cast<xtc::XtcHeader*>(&buf[0]);
+  hdr->magic = bitDepth == 2 ? xtc::XTCH_MAGIC : xtc::XTC_MAGIC;
+  hdr->versionMajor = 1;
+  hdr->pageCount = static_cast<uint16_t>(pages.size());
+  hdr->pageTableOffset = pageTableOffset;
+  hdr->dataOffset = pageDataStart;
+
+  for (size_t i = 0; i < pages.size(); i++) {
+    std::vector<uint8_t> stored;
+    if (!xtc::encodePage(bitDepth, width, height, pages[i].data(), compression, stored)) return std::string();
+
+    xtc::XtgPageHeader pageHdr = {};
+    pageHdr.magic = bitDepth == 2 ? xtc::XTH_MAGIC : xtc::XTG_MAGIC;
+    pageHdr.width = width;
+    pageHdr.height = height;
+    pageHdr.compression = compression;
+    pageHdr.dataSize = static_cast<uint32_t>(stored.size());
+
+    xtc::PageTableEntry entry = {};
+    entry.dataOffset = buf.size();
+    entry.dataSize = static_cast<uint32_t>(sizeof(pageHdr) + stored.size());
+    entry.width = width;
+    entry.height = height;
+    memcpy(&buf[pageTableOffset + i * sizeof(entry)], &entry, sizeof(entry));
+
+    buf.append(reinterpret_cast<const char*>(&pageHdr), sizeof(pageHdr));
+    buf.append(reinterpret_cast<const char*>(stored.data()), stored.size());
+  }
+  return buf;
+}
+
+// Text-like page content: mostly white with short runs and a little noise
+static std::vector<uint8_t> makePageBitmap(size_t size, uint32_t seed, uint8_t background) {
+  std::vector<uint8_t> bitmap(size, background);
+  for (size_t i = 0; i < size; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    if ((seed >> 28) == 0) bitmap[i] = static_cast<uint8_t>(seed >> 16);
+    if ((seed >> 28) == 1) bitmap[i] = static_cast<uint8_t>(~background);
+  }
+  return bitmap;
+}
+
 static std::string buildLegacyPageTableXtc() {
   constexpr size_t pageTableOffset = offsetof(xtc::XtcHeader, chapterOffset);
   constexpr size_t pageDataOffset = pageTableOffset + sizeof(xtc::PageTableEntry);
@@ -616,14 +665,14 @@ int main() {
                     "page_validation: rejects table/header dimension mismatch");
   }
 
-  // Test 11: compressed pages are unsupported
+  // Test 11: unknown compression modes, and compressed pages no smaller than raw, are rejected
   {
     SdMan.clearFiles();
     std::string data = buildMultiPageXtc(8, 8, 1);
     constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
     auto* entry = reinterpret_cast<xtc::PageTableEntry*>(&data[pageTableOffset]);
     auto* pageHeader = reinterpret_cast<xtc::XtgPageHeader*>(&data[entry->dataOffset]);
-    pageHeader->compression = 1;
+    pageHeader->compression = xtc::XTG_COMPRESSION_PACKBITS + 1;
     SdMan.registerFile("/compressed.xtc", data);
 
     xtc::XtcParser parser;
@@ -631,6 +680,13 @@ int main() {
     std::vector<uint8_t> buffer(32);
     runner.expectEq(size_t{0}, parser.loadPage(0, buffer.data(), buffer.size()),
                     "page_validation: rejects unsupported compression");
+
+    pageHeader->compression = xtc::XTG_COMPRESSION_GROUP5;
+    SdMan.registerFile("/compressed.xtc", data);
+    parser.close();
+    parser.open("/compressed.xtc");
+    runner.expectEq(size_t{0}, parser.loadPage(0, buffer.data(), buffer.size()),
+                    "page_validation: rejects compressed page as large as raw");
   }
 
   // Test 12: embedded and table data sizes are validated
@@ -724,5 +780,149 @@ int main() {
     runner.expectFalse(parser.hasChapters(), "low_heap_chapters: failed lazy load is not retried");
   }
 
+  // Test 15: compressed XTG pages decode to the raw bitmap through every loader
+  {
+    constexpr uint16_t width = 100;  // not a multiple of 8: row padding must round-trip
+    constexpr uint16_t height = 37;
+    const size_t bitmapSize = xtc::xtgBitmapSize(width, height);
+    const std::vector<std::vector<uint8_t>> pages = {makePageBitmap(bitmapSize, 1, 0xFF),
+                                                     makePageBitmap(bitmapSize, 2, 0xFF)};
+    const uint8_t modes[] = {xtc::XTG_COMPRESSION_GROUP5, xtc::XTG_COMPRESSION_PACKBITS};
+    for (const uint8_t mode : modes) {
+      const std::string label = mode == xtc::XTG_COMPRESSION_GROUP5 ? "g5_xtg: " : "packbits_xtg: ";
+      SdMan.clearFiles();
+      const std::string file = buildCompressedXtc(pages, width, height, 1, mode);
+      runner.expectFalse(file.empty(), label + "encodes smaller than raw");
+      SdMan.registerFile("/packed.xtc", file);
+
+      xtc::XtcParser parser;
+      runner.expectTrue(parser.open("/packed.xtc") == xtc::XtcError::OK, label + "opens");
+      std::vector<uint8_t> buffer(bitmapSize);
+      runner.expectEq(bitmapSize, parser.loadPage(1, buffer.data(), buffer.size()), label + "loadPage size");
+      runner.expectTrue(buffer == pages[1], label + "loadPage matches raw bitmap");
+
+      std::vector<uint8_t> streamed(bitmapSize, 0);
+      size_t expectedOffset = 0;
+      bool offsetsInOrder = true;
+      const auto error = parser.loadPageStreaming(
+          0,
+          [&](const uint8_t* data, size_t size, size_t offset) {
+            offsetsInOrder &= offset == expectedOffset;
+            memcpy(streamed.data() + offset, data, size);
+            expectedOffset += size;
+            return true;
+          },
+          33);
+      runner.expectTrue(error == xtc::XtcError::OK, label + "streams");
+      runner.expectTrue(offsetsInOrder && streamed == pages[0], label + "odd-sized chunks match raw bitmap");
+    }
+  }
+
+  // Test 16: compressed XTH planes decode in lockstep for loadPagePlanePairs
+  {
+    constexpr uint16_t width = 64;
+    constexpr uint16_t height = 50;
+    const size_t planeSize = xtc::xthPlaneSize(width, height);
+    std::vector<uint8_t> page = makePageBitmap(planeSize, 7, 0x00);
+    const std::vector<uint8_t> second = makePageBitmap(planeSize, 8, 0x00);
+    page.insert(page.end(), second.begin(), second.end());
+
+    const uint8_t modes[] = {xtc::XTG_COMPRESSION_GROUP5, xtc::XTG_COMPRESSION_PACKBITS};
+    for (const uint8_t mode : modes) {
+      const std::string label = mode == xtc::XTG_COMPRESSION_GROUP5 ? "g5_xth: " : "packbits_xth: ";
+      SdMan.clearFiles();
+      SdMan.registerFile("/packed.xtch", buildCompressedXtc({page}, width, height, 2, mode));
+
+      xtc::XtcParser parser;
+      runner.expectTrue(parser.open("/packed.xtch") == xtc::XtcError::OK, label + "opens");
+      std::vector<uint8_t> plane1(planeSize);
+      std::vector<uint8_t> plane2(planeSize);
+      const auto error = parser.loadPagePlanePairs(
+          0,
+          [&](const uint8_t* p1, const uint8_t* p2, size_t size, size_t offset) {
+            memcpy(plane1.data() + offset, p1, size);
+            memcpy(plane2.data() + offset, p2, size);
+            return true;
+          },
+          96);
+      runner.expectTrue(error == xtc::XtcError::OK, label + "plane pairs stream");
+      runner.expectTrue(std::equal(plane1.begin(), plane1.end(), page.begin()), label + "first plane matches");
+      runner.expectTrue(std::equal(plane2.begin(), plane2.end(), page.begin() + planeSize),
+                        label + "second plane matches");
+
+      std::vector<uint8_t> buffer(page.size());
+      runner.expectEq(page.size(), parser.loadPage(0, buffer.data(), buffer.size()), label + "loadPage size");
+      runner.expectTrue(buffer == page, label + "loadPage matches both planes");
+    }
+  }
+
+  // Test 17: PackBits round-trips long runs and long literals; damaged streams fail cleanly
+  {
+    std::vector<uint8_t> raw(1000, 0xFF);
+    for (size_t i = 300; i < 700; i++) raw[i] = static_cast<uint8_t>(i * 7);
+    raw[999] = 0x00;
+    std::vector<uint8_t> packed;
+    xtc::packBitsEncode(raw.data(), raw.size(), packed);
+    runner.expectTrue(packed.size() < raw.size(), "packbits: compresses runs");
+
+    SdMan.clearFiles();
+    std::string file(packed.begin(), packed.end());
+    SdMan.registerFile("/stream.bin", file);
+    FsFile stream;
+    SdMan.openFileForRead("TEST", "/stream.bin", stream);
+    xtc::PageStreamDecoder decoder;
+    runner.expectTrue(decoder.begin(stream, xtc::XTG_COMPRESSION_PACKBITS, 0, packed.size(), 100, 10) ==
+                          xtc::XtcError::OK,
+                      "packbits: decoder starts");
+    std::vector<uint8_t> decoded(raw.size());
+    bool ok = true;
+    for (size_t offset = 0; offset < raw.size(); offset += 250) {
+      ok &= decoder.read(decoded.data() + offset, 250) == xtc::XtcError::OK;
+    }
+    runner.expectTrue(ok && decoded == raw, "packbits: round trip");
+    uint8_t extra = 0;
+    runner.expectTrue(decoder.read(&extra, 1) != xtc::XtcError::OK, "packbits: no bytes past the bitmap");
+    stream.close();
+
+    // Truncated stream: runs out of input before the bitmap is complete
+    SdMan.registerFile("/short.bin", file.substr(0, file.size() / 2));
+    SdMan.openFileForRead("TEST", "/short.bin", stream);
+    xtc::PageStreamDecoder shortDecoder;
+    shortDecoder.begin(stream, xtc::XTG_COMPRESSION_PACKBITS, 0, packed.size() / 2, 100, 10);
+    runner.expectTrue(shortDecoder.read(decoded.data(), raw.size()) == xtc::XtcError::DECOMPRESSION_ERROR,
+                      "packbits: truncated stream is a decompression error");
+    stream.close();
+  }
+
+  // Test 18: Group5 pages that cannot be decoded, or exceed the heap, fail without callbacks
+  {
+    constexpr uint16_t width = 96;
+    constexpr uint16_t height = 40;
+    const size_t bitmapSize = xtc::xtgBitmapSize(width, height);
+    std::string file =
+        buildCompressedXtc({makePageBitmap(bitmapSize, 3, 0xFF)}, width, height, 1, xtc::XTG_COMPRESSION_GROUP5);
+    constexpr size_t pageTableOffset = sizeof(xtc::XtcHeader) + 128 + 64;
+    const auto* entry = reinterpret_cast<const xtc::PageTableEntry*>(&file[pageTableOffset]);
+    const size_t dataStart = entry->dataOffset + sizeof(xtc::XtgPageHeader);
+    // Horizontal-mode codes with run lengths past the line end
+    for (size_t i = dataStart; i < file.size(); i++) file[i] = static_cast<char>(0x3F);
+    SdMan.clearFiles();
+    SdMan.registerFile("/damaged.xtc", file);
+
+    xtc::XtcParser parser;
+    parser.open("/damaged.xtc");
+    std::vector<uint8_t> buffer(bitmapSize);
+    const size_t loaded = parser.loadPage(0, buffer.data(), buffer.size());
+    runner.expectTrue(loaded == 0 || loaded == bitmapSize, "g5_damaged: never returns a partial page");
+
+    testSetLargestFreeBlock(64);
+    size_t callbacks = 0;
+    const auto error = parser.loadPageStreaming(
+        0, [&](const uint8_t*, size_t, size_t) { return ++callbacks > 0; }, 32);
+    testResetLargestFreeBlock();
+    runner.expectTrue(error == xtc::XtcError::MEMORY_ERROR, "g5_low_heap: memory error");
+    runner.expectEq(size_t{0}, callbacks, "g5_low_heap: no callbacks");
+  }
+
   return runner.allPassed() ? 0 : 1;
 }
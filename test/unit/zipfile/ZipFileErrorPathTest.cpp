@@ -16,6 +16,8 @@
 #include <utility>
 #include <vector>
 
+#include <zlib.h>
+
 #include "test_utils.h"
 
 // Include mocks
@@ -24,12 +26,15 @@
 #include "SdFat.h"
 
 // Include ZipFile header
+#include "InflateReader.h"
 #include "ZipFile.h"
 
 // Forward declarations for helper functions
 std::vector<uint8_t> createMinimalZip();
 std::vector<uint8_t> createStoredZip(const std::string& name, const std::string& contents);
 std::vector<uint8_t> createDeflatedZip(const std::string& name, uint32_t inflatedSize = 1040);
+// Single entry compressed by host zlib (raw deflate, many blocks for large contents)
+std::vector<uint8_t> createZlibDeflatedZip(const std::string& name, const std::string& contents);
 std::vector<uint8_t> createZipWithInvalidOffset(const char* name);
 std::vector<uint8_t> createZipWithUnsupportedCompression(const char* name);
 std::vector<uint8_t> createZipWithNamedEntries(const std::vector<std::pair<std::string, uint32_t>>& entries);
@@ -527,6 +532,228 @@ int main() {
     runner.expectTrue(checks >= 3, "FindFirstExisting_Abort_CheckedDuringScan");
   }
 
+  // ========================================================================
+  // ZipEntryReader - pull reads without extraction
+  // ========================================================================
+
+  // Stored entry: small reads return the payload in order, then 0
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createStoredZip("img.jpg", "hello stored entry"));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    runner.expectTrue(reader.open(zip, "img.jpg") == StreamReadResult::Success, "EntryReader_Stored_Opens");
+    runner.expectEq<size_t>(18, reader.size(), "EntryReader_Stored_Size");
+    std::string out;
+    uint8_t buf[5];
+    int n;
+    while ((n = reader.read(buf, sizeof(buf))) > 0) out.append(reinterpret_cast<char*>(buf), n);
+    runner.expectEq<int>(0, n, "EntryReader_Stored_EndReturnsZero");
+    runner.expectEqual("hello stored entry", out, "EntryReader_Stored_Content");
+    runner.expectEq<int>(0, reader.read(buf, sizeof(buf)), "EntryReader_Stored_ReadAfterEnd");
+  }
+
+  // Deflated entry: output matches readFileToStream byte for byte
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createDeflatedZip("img.png"));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    std::vector<uint8_t> dict(InflateReader::STREAMING_DICTIONARY_SIZE);
+    runner.expectTrue(reader.open(zip, "img.png", dict.data()) == StreamReadResult::Success,
+                      "EntryReader_Deflated_Opens");
+    std::string out;
+    uint8_t buf[37];
+    int n;
+    while ((n = reader.read(buf, sizeof(buf))) > 0) out.append(reinterpret_cast<char*>(buf), n);
+    runner.expectEq<int>(0, n, "EntryReader_Deflated_EndReturnsZero");
+    runner.expectEqual(largeInflatedPayload(), out, "EntryReader_Deflated_Content");
+    reader.close();
+    runner.expectFalse(zip.isOpen(), "EntryReader_Close_ClosesZipItOpened");
+  }
+
+  // Deflated entry declaring more bytes than the stream holds fails instead of ending early
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createDeflatedZip("img.png", 2000));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    runner.expectTrue(reader.open(zip, "img.png") == StreamReadResult::Success, "EntryReader_ShortStream_Opens");
+    uint8_t buf[256];
+    int n;
+    while ((n = reader.read(buf, sizeof(buf))) > 0) {
+    }
+    runner.expectEq<int>(-1, n, "EntryReader_ShortStream_ReportsError");
+  }
+
+  // Deflated entry declaring fewer bytes is cut at the declared size
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createDeflatedZip("img.png", 100));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    reader.open(zip, "img.png");
+    size_t total = 0;
+    uint8_t buf[64];
+    int n;
+    while ((n = reader.read(buf, sizeof(buf))) > 0) total += static_cast<size_t>(n);
+    runner.expectEq<size_t>(100, total, "EntryReader_LongStream_StopsAtDeclaredSize");
+  }
+
+  // Error paths
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createStoredZip("a.jpg", "x"));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    runner.expectTrue(reader.open(zip, "missing.jpg") == StreamReadResult::NotFound, "EntryReader_Missing_NotFound");
+    uint8_t buf[4];
+    runner.expectEq<int>(-1, reader.read(buf, sizeof(buf)), "EntryReader_Unopened_ReadFails");
+    runner.expectFalse(zip.isOpen(), "EntryReader_Missing_ZipClosed");
+
+    SdMan.setFileData("/bad.zip", createZipWithUnsupportedCompression("a.jpg"));
+    ZipFile bad("/bad.zip");
+    runner.expectTrue(reader.open(bad, "a.jpg") == StreamReadResult::UnsupportedMethod,
+                      "EntryReader_UnsupportedMethod");
+
+    SdMan.setFileData("/offset.zip", createZipWithInvalidOffset("a.jpg"));
+    ZipFile offset("/offset.zip");
+    runner.expectTrue(reader.open(offset, "a.jpg") == StreamReadResult::InvalidOffset, "EntryReader_InvalidOffset");
+  }
+
+  // A zip opened by the caller stays open after the reader closes
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createStoredZip("a.jpg", "abc"));
+    ZipFile zip("/test.zip");
+    zip.open();
+    {
+      ZipEntryReader reader;
+      reader.open(zip, "a.jpg");
+    }
+    runner.expectTrue(zip.isOpen(), "EntryReader_KeepsCallerOpenedZip");
+  }
+
+  // Varied text large enough for several deflate blocks and back-references across them
+  const auto bookText = []() {
+    std::string text;
+    uint32_t seed = 12345;
+    while (text.size() < 200000) {
+      seed = seed * 1103515245u + 12345u;
+      text += "<p>Paragraph " + std::to_string(text.size()) + " word" + std::to_string((seed >> 16) % 97) + "</p>\n";
+    }
+    return text;
+  };
+
+  const auto readRest = [](ZipEntryReader& reader) {
+    std::string out;
+    uint8_t buf[517];
+    int n;
+    while ((n = reader.read(buf, sizeof(buf))) > 0) out.append(reinterpret_cast<char*>(buf), n);
+    return out;
+  };
+
+  // Checkpoint saved mid-stream resumes in a fresh reader with identical output
+  {
+    SdMan.reset();
+    const std::string text = bookText();
+    SdMan.setFileData("/book.zip", createZlibDeflatedZip("book.fb2", text));
+    ZipFile zip("/book.zip");
+    ZipEntryReader reader;
+    runner.expectTrue(reader.open(zip, "book.fb2") == StreamReadResult::Success, "Checkpoint_Opens");
+    runner.expectTrue(reader.isDeflated(), "Checkpoint_IsDeflated");
+
+    std::vector<uint8_t> head(123457);
+    runner.expectEq<int>(static_cast<int>(head.size()), reader.read(head.data(), head.size()), "Checkpoint_ReadHead");
+    runner.expectEq<size_t>(head.size(), reader.position(), "Checkpoint_PositionAfterHead");
+
+    FsFile out;
+    SdMan.openFileForWrite("TEST", "/ck.bin", out);
+    runner.expectTrue(reader.saveCheckpoint(out), "Checkpoint_Saved");
+    out.close();
+    runner.expectEq<size_t>(ZipEntryReader::CHECKPOINT_SIZE, SdMan.getWrittenData("/ck.bin").size(),
+                            "Checkpoint_RecordSize");
+    const std::string expectedRest = readRest(reader);
+    reader.close();
+
+    ZipFile zip2("/book.zip");
+    ZipEntryReader resumed;
+    resumed.open(zip2, "book.fb2");
+    FsFile in;
+    SdMan.openFileForRead("TEST", "/ck.bin", in);
+    runner.expectTrue(resumed.restoreCheckpoint(in), "Checkpoint_Restored");
+    runner.expectEq<size_t>(head.size(), resumed.position(), "Checkpoint_RestoredPosition");
+    const std::string rest = readRest(resumed);
+    runner.expectEq<size_t>(text.size() - head.size(), rest.size(), "Checkpoint_RestLength");
+    runner.expectTrue(rest == expectedRest && rest == text.substr(head.size()), "Checkpoint_RestMatches");
+  }
+
+  // Truncated checkpoint is rejected and the reader still inflates from the start
+  {
+    SdMan.reset();
+    const std::string text = bookText();
+    SdMan.setFileData("/book.zip", createZlibDeflatedZip("book.fb2", text));
+    ZipFile zip("/book.zip");
+    ZipEntryReader reader;
+    reader.open(zip, "book.fb2");
+    uint8_t buf[1000];
+    reader.read(buf, sizeof(buf));
+    FsFile out;
+    SdMan.openFileForWrite("TEST", "/ck.bin", out);
+    reader.saveCheckpoint(out);
+    out.close();
+    std::string truncated = SdMan.getWrittenData("/ck.bin");
+    truncated.resize(truncated.size() / 2);
+    SdMan.clearWrittenFiles();
+    SdMan.registerFile("/ck.bin", truncated);
+
+    ZipFile zip2("/book.zip");
+    ZipEntryReader fresh;
+    fresh.open(zip2, "book.fb2");
+    FsFile in;
+    SdMan.openFileForRead("TEST", "/ck.bin", in);
+    runner.expectFalse(fresh.restoreCheckpoint(in), "Checkpoint_Truncated_Rejected");
+    runner.expectEq<size_t>(0, fresh.position(), "Checkpoint_Truncated_AtStart");
+    runner.expectTrue(readRest(fresh) == text, "Checkpoint_Truncated_FullContent");
+  }
+
+  // Deflated seek: forward skips, backward rewinds
+  {
+    SdMan.reset();
+    const std::string text = bookText();
+    SdMan.setFileData("/book.zip", createZlibDeflatedZip("book.fb2", text));
+    ZipFile zip("/book.zip");
+    ZipEntryReader reader;
+    reader.open(zip, "book.fb2");
+    char buf[64];
+    runner.expectTrue(reader.seek(150000), "Seek_Deflated_Forward");
+    reader.read(reinterpret_cast<uint8_t*>(buf), sizeof(buf));
+    runner.expectTrue(std::string(buf, sizeof(buf)) == text.substr(150000, sizeof(buf)), "Seek_Deflated_ForwardData");
+    runner.expectTrue(reader.seek(10), "Seek_Deflated_Backward");
+    reader.read(reinterpret_cast<uint8_t*>(buf), sizeof(buf));
+    runner.expectTrue(std::string(buf, sizeof(buf)) == text.substr(10, sizeof(buf)), "Seek_Deflated_BackwardData");
+    runner.expectFalse(reader.seek(text.size() + 1), "Seek_Deflated_PastEndFails");
+  }
+
+  // Stored seek goes straight to the byte; stored entries have nothing to checkpoint
+  {
+    SdMan.reset();
+    SdMan.setFileData("/test.zip", createStoredZip("book.fb2", "0123456789abcdef"));
+    ZipFile zip("/test.zip");
+    ZipEntryReader reader;
+    reader.open(zip, "book.fb2");
+    runner.expectFalse(reader.isDeflated(), "Seek_Stored_NotDeflated");
+    runner.expectTrue(reader.seek(10), "Seek_Stored_Succeeds");
+    runner.expectEqual("abcdef", readRest(reader), "Seek_Stored_Data");
+    runner.expectTrue(reader.seek(2), "Seek_Stored_Backward");
+    char buf[3];
+    reader.read(reinterpret_cast<uint8_t*>(buf), sizeof(buf));
+    runner.expectEqual("234", std::string(buf, sizeof(buf)), "Seek_Stored_BackwardData");
+    FsFile out;
+    SdMan.openFileForWrite("TEST", "/ck.bin", out);
+    runner.expectFalse(reader.saveCheckpoint(out), "Checkpoint_Stored_Refused");
+  }
+
   SdMan.reset();
   runner.printSummary();
   return runner.allPassed() ? 0 : 1;
@@ -621,6 +848,20 @@ std::vector<uint8_t> createDeflatedZip(const std::string& name, uint32_t inflate
   return createSingleEntryZip(name, LARGE_DEFLATED, sizeof(LARGE_DEFLATED), inflatedSize, 8);
 }
 
+std::vector<uint8_t> createZlibDeflatedZip(const std::string& name, const std::string& contents) {
+  z_stream zs{};
+  deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  std::vector<uint8_t> compressed(deflateBound(&zs, contents.size()));
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(contents.data()));
+  zs.avail_in = static_cast<uInt>(contents.size());
+  zs.next_out = compressed.data();
+  zs.avail_out = static_cast<uInt>(compressed.size());
+  deflate(&zs, Z_FINISH);
+  compressed.resize(zs.total_out);
+  deflateEnd(&zs);
+  return createSingleEntryZip(name, compressed.data(), compressed.size(), static_cast<uint32_t>(contents.size()), 8);
+}
+
 std::vector<uint8_t> createZipWithInvalidOffset(const char* name) {
   uint16_t nameLen = static_cast<uint16_t>(strlen(name));
   std::vector<uint8_t> data;
@@ -56,12 +56,41 @@ func autoDetectPort() (string, error) {
 	return selectPort(candidates, ports)
 }
 
+func runTraceConversion(inPath, outPath string) error {
+	in, err := os.Open(inPath)
+	if err != nil {
+		return err
+	}
+	defer in.Close()
+
+	var out io.Writer = os.Stdout
+	if outPath != "" {
+		f, err := os.Create(outPath)
+		if err != nil {
+			return err
+		}
+		defer f.Close()
+		out = f
+	}
+	return convertTrace(in, out)
+}
+
 func main() {
 	portFlag := flag.String("port", "", "serial port (e.g. /dev/ttyACM0, COM3). Auto-detect if omitted")
 	speedFlag := flag.Int("speed", 115200, "baud rate")
 	logFlag := flag.String("log", "", "log file path (output to both stdout and file)")
+	traceFlag := flag.String("trace", "", "convert a device trace.bin to Chrome trace JSON and exit")
+	outFlag := flag.String("out", "", "output path for -trace (default: stdout)")
 	flag.Parse()
 
+	if *traceFlag != "" {
+		if err := runTraceConversion(*traceFlag, *outFlag); err != nil {
+			fmt.Fprintf(os.Stderr, "Trace conversion failed: %v\n", err)
+			os.Exit(1)
+		}
+		return
+	}
+
 	portName := *portFlag
 	if portName == "" {
 		detected, err := autoDetectPort()
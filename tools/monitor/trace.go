@@ -0,0 +1,156 @@
+package main
+
+import (
+	"bufio"
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"io"
+)
+
+// Trace files are written by the firmware to /.papyrix/trace.bin (src/core/Trace.h):
+// a 16-byte header, the event name table, then 16-byte records oldest first.
+
+const (
+	traceMagic      = "PTRC"
+	traceVersion    = 1
+	traceRecordSize = 16
+)
+
+type traceHeader struct {
+	Magic       [4]byte
+	Version     uint8
+	RecordSize  uint8
+	NameCount   uint16
+	RecordCount uint32
+	Overwritten uint32
+}
+
+type traceRecord struct {
+	TimeUs           uint32
+	Event            uint16
+	Phase            uint8
+	Task             uint8
+	FreeHeap         uint32
+	LargestFreeBlock uint32
+}
+
+type traceFile struct {
+	Names       []string
+	Records     []traceRecord
+	Overwritten uint32
+}
+
+// decodeTrace parses a trace file written by the firmware.
+func decodeTrace(r io.Reader) (*traceFile, error) {
+	br := bufio.NewReader(r)
+	var header traceHeader
+	if err := binary.Read(br, binary.LittleEndian, &header); err != nil {
+		return nil, fmt.Errorf("reading header: %w", err)
+	}
+	if string(header.Magic[:]) != traceMagic {
+		return nil, fmt.Errorf("not a trace file (magic %q)", header.Magic[:])
+	}
+	if header.Version != traceVersion {
+		return nil, fmt.Errorf("unsupported trace version %d", header.Version)
+	}
+	if header.RecordSize != traceRecordSize {
+		return nil, fmt.Errorf("unsupported record size %d", header.RecordSize)
+	}
+
+	trace := &traceFile{Names: make([]string, header.NameCount), Overwritten: header.Overwritten}
+	for i := range trace.Names {
+		length, err := br.ReadByte()
+		if err != nil {
+			return nil, fmt.Errorf("reading event name %d: %w", i, err)
+		}
+		name := make([]byte, length)
+		if _, err := io.ReadFull(br, name); err != nil {
+			return nil, fmt.Errorf("reading event name %d: %w", i, err)
+		}
+		trace.Names[i] = string(name)
+	}
+
+	trace.Records = make([]traceRecord, header.RecordCount)
+	if err := binary.Read(br, binary.LittleEndian, trace.Records); err != nil {
+		return nil, fmt.Errorf("reading %d records: %w", header.RecordCount, err)
+	}
+	return trace, nil
+}
+
+func (t *traceFile) eventName(id uint16) string {
+	if int(id) < len(t.Names) {
+		return t.Names[id]
+	}
+	return fmt.Sprintf("event-%d", id)
+}
+
+type chromeEvent struct {
+	Name  string         `json:"name"`
+	Cat   string         `json:"cat,omitempty"`
+	Phase string         `json:"ph"`
+	Ts    int64          `json:"ts"`
+	Pid   int            `json:"pid"`
+	Tid   int            `json:"tid"`
+	Scope string         `json:"s,omitempty"`
+	Args  map[string]any `json:"args,omitempty"`
+}
+
+type chromeTrace struct {
+	TraceEvents     []chromeEvent  `json:"traceEvents"`
+	DisplayTimeUnit string         `json:"displayTimeUnit"`
+	OtherData       map[string]any `json:"otherData"`
+}
+
+// toChromeTrace converts records to Chrome trace events (chrome://tracing, Perfetto).
+// Firmware timestamps are 32-bit microseconds; they are unwrapped relative to the
+// first record so traces longer than ~71 minutes stay monotonic.
+func toChromeTrace(t *traceFile) chromeTrace {
+	out := chromeTrace{
+		TraceEvents:     make([]chromeEvent, 0, 2*len(t.Records)),
+		DisplayTimeUnit: "ms",
+		OtherData:       map[string]any{"overwritten": t.Overwritten},
+	}
+
+	var ts int64
+	var prev uint32
+	for i, rec := range t.Records {
+		if i > 0 {
+			// Signed delta: records from two tasks may be a few µs out of order
+			ts += int64(int32(rec.TimeUs - prev))
+		}
+		prev = rec.TimeUs
+
+		event := chromeEvent{
+			Name:  t.eventName(rec.Event),
+			Cat:   "papyrix",
+			Phase: string(rune(rec.Phase)),
+			Ts:    ts,
+			Pid:   1,
+			Tid:   int(rec.Task),
+		}
+		if event.Phase == "i" {
+			event.Scope = "t"
+		}
+		out.TraceEvents = append(out.TraceEvents, event)
+		out.TraceEvents = append(out.TraceEvents, chromeEvent{
+			Name:  "heap",
+			Phase: "C",
+			Ts:    ts,
+			Pid:   1,
+			Args:  map[string]any{"free": rec.FreeHeap, "largestFreeBlock": rec.LargestFreeBlock},
+		})
+	}
+	return out
+}
+
+// convertTrace reads a firmware trace file and writes Chrome trace JSON.
+func convertTrace(r io.Reader, w io.Writer) error {
+	trace, err := decodeTrace(r)
+	if err != nil {
+		return err
+	}
+	enc := json.NewEncoder(w)
+	enc.SetIndent("", " ")
+	return enc.Encode(toChromeTrace(trace))
+}
@@ -0,0 +1,117 @@
+package main
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"testing"
+)
+
+func buildTrace(t *testing.T, names []string, records []traceRecord, overwritten uint32) []byte {
+	t.Helper()
+	var buf bytes.Buffer
+	header := traceHeader{
+		Version:     traceVersion,
+		RecordSize:  traceRecordSize,
+		NameCount:   uint16(len(names)),
+		RecordCount: uint32(len(records)),
+		Overwritten: overwritten,
+	}
+	copy(header.Magic[:], traceMagic)
+	if err := binary.Write(&buf, binary.LittleEndian, header); err != nil {
+		t.Fatal(err)
+	}
+	for _, name := range names {
+		buf.WriteByte(byte(len(name)))
+		buf.WriteString(name)
+	}
+	if err := binary.Write(&buf, binary.LittleEndian, records); err != nil {
+		t.Fatal(err)
+	}
+	return buf.Bytes()
+}
+
+func TestDecodeTrace(t *testing.T) {
+	records := []traceRecord{
+		{TimeUs: 100, Event: 1, Phase: 'B', FreeHeap: 90000, LargestFreeBlock: 40000},
+		{TimeUs: 250, Event: 1, Phase: 'E', FreeHeap: 91000, LargestFreeBlock: 41000},
+	}
+	data := buildTrace(t, []string{"boot-setup", "page-render"}, records, 3)
+	if len(data) != 16+11+12+2*16 {
+		t.Fatalf("unexpected file size %d", len(data))
+	}
+
+	trace, err := decodeTrace(bytes.NewReader(data))
+	if err != nil {
+		t.Fatalf("decode failed: %v", err)
+	}
+	if trace.Overwritten != 3 {
+		t.Errorf("overwritten: got %d", trace.Overwritten)
+	}
+	if len(trace.Records) != 2 || trace.Records[1] != records[1] {
+		t.Errorf("records: got %+v", trace.Records)
+	}
+	if trace.eventName(1) != "page-render" || trace.eventName(9) != "event-9" {
+		t.Errorf("names: got %v", trace.Names)
+	}
+}
+
+func TestDecodeTrace_Invalid(t *testing.T) {
+	valid := buildTrace(t, []string{"a"}, []traceRecord{{Phase: 'i'}}, 0)
+	cases := map[string][]byte{
+		"empty":     nil,
+		"magic":     append([]byte("XXXX"), valid[4:]...),
+		"truncated": valid[:len(valid)-1],
+	}
+	for name, data := range cases {
+		if _, err := decodeTrace(bytes.NewReader(data)); err == nil {
+			t.Errorf("%s: expected error", name)
+		}
+	}
+}
+
+func TestToChromeTrace(t *testing.T) {
+	trace := &traceFile{
+		Names: []string{"page-render", "refresh-begin"},
+		Records: []traceRecord{
+			{TimeUs: 0xFFFFFF00, Event: 0, Phase: 'B', Task: 0, FreeHeap: 1, LargestFreeBlock: 2},
+			{TimeUs: 0x00000100, Event: 1, Phase: 'i', Task: 1},
+			{TimeUs: 0x000000F0, Event: 0, Phase: 'E', Task: 0},
+		},
+	}
+	out := toChromeTrace(trace)
+	if len(out.TraceEvents) != 6 {
+		t.Fatalf("expected 6 events, got %d", len(out.TraceEvents))
+	}
+	begin, instant, end := out.TraceEvents[0], out.TraceEvents[2], out.TraceEvents[4]
+	if begin.Name != "page-render" || begin.Phase != "B" || begin.Ts != 0 {
+		t.Errorf("begin: %+v", begin)
+	}
+	if instant.Ts != 0x200 || instant.Scope != "t" || instant.Tid != 1 {
+		t.Errorf("instant across wrap: %+v", instant)
+	}
+	if end.Ts != 0x1F0 || end.Phase != "E" {
+		t.Errorf("out-of-order end: %+v", end)
+	}
+	heap := out.TraceEvents[1]
+	if heap.Phase != "C" || heap.Args["free"] != uint32(1) || heap.Args["largestFreeBlock"] != uint32(2) {
+		t.Errorf("heap counter: %+v", heap)
+	}
+}
+
+func TestConvertTrace(t *testing.T) {
+	data := buildTrace(t, []string{"sleep"}, []traceRecord{{TimeUs: 5, Phase: 'i'}}, 0)
+	var out bytes.Buffer
+	if err := convertTrace(bytes.NewReader(data), &out); err != nil {
+		t.Fatalf("convert failed: %v", err)
+	}
+	var parsed struct {
+		TraceEvents []map[string]any `json:"traceEvents"`
+	}
+	if err := json.Unmarshal(out.Bytes(), &parsed); err != nil {
+		t.Fatalf("invalid JSON: %v", err)
+	}
+	if len(parsed.TraceEvents) != 2 || parsed.TraceEvents[0]["name"] != "sleep" {
+		t.Errorf("unexpected events: %v", parsed.TraceEvents)
+	}
+}
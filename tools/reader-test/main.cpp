@@ -2,9 +2,11 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -22,16 +24,19 @@
 #include <Page.h>
 #include <ParsedText.h>
 #include <GfxRenderer.h>
+#include <HeapProfiler.h>
 #include <Markdown.h>
 #include <MarkdownParser.h>
 #include <PageCache.h>
 #include <PlainTextParser.h>
 #include <RenderConfig.h>
 #include <SDCardManager.h>
+#include <StreamingEpdFont.h>
 #include <Txt.h>
 #include <Utf8.h>
 #include <FsHelpers.h>
 #include <LittleFS.h>
+#include <core/Trace.h>
 
 #include <builtinFonts/reader_2b.h>
 #include <builtinFonts/reader_bold_2b.h>
@@ -40,8 +45,10 @@
 // LittleFS global
 MockLittleFS LittleFS;
 
-// GfxRenderer static frame buffer
+#ifndef READER_TEST_FRAMEBUFFER
+// Mock GfxRenderer static frame buffer
 uint8_t GfxRenderer::frameBuffer_[EInkDisplay::BUFFER_SIZE];
+#endif
 
 // Simulation globals (set via --sim-heap / --fail-serialize)
 size_t g_simHeapSize = 0;
@@ -52,7 +59,7 @@ static ContentType detectType(const std::string& path) {
   if (FsHelpers::hasExtension(path, ".epub")) return EPUB;
   if (FsHelpers::hasExtension(path, ".md") || FsHelpers::hasExtension(path, ".markdown")) return MARKDOWN;
   if (FsHelpers::hasExtension(path, ".txt")) return TXT_FILE;
-  if (FsHelpers::hasExtension(path, ".fb2")) return FB2_FILE;
+  if (FsHelpers::isFb2File(path)) return FB2_FILE;
   if (FsHelpers::hasExtension(path, ".html") || FsHelpers::hasExtension(path, ".htm")) return HTML_FILE;
   return UNKNOWN;
 }
@@ -69,12 +76,23 @@ static bool mkdirRecursive(const std::string& path) {
   return true;
 }
 
-static std::string renderWord(const GfxRenderer& gfx, int fontId, const std::string& word) {
+// Characters the reader font can draw; --dump prints the rest as '?'
+struct GlyphCoverage {
+  const EpdFontFamily& family;
+  ExternalFont* external;
+
+  bool has(const uint32_t cp) const {
+    if (external && external->isLoaded() && external->getGlyph(cp)) return true;
+    return family.getGlyph(cp, EpdFontFamily::REGULAR) != nullptr;
+  }
+};
+
+static std::string renderWord(const GlyphCoverage& glyphs, const std::string& word) {
   std::string result;
   const char* ptr = word.c_str();
   uint32_t cp;
   while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&ptr)))) {
-    if (gfx.hasGlyph(fontId, cp)) {
+    if (glyphs.has(cp)) {
       // Encode codepoint back to UTF-8
       if (cp < 0x80) {
         result += static_cast<char>(cp);
@@ -98,7 +116,8 @@ static std::string renderWord(const GfxRenderer& gfx, int fontId, const std::str
   return result;
 }
 
-static void dumpPages(PageCache& cache, const GfxRenderer& gfx, int fontId) {
+static void dumpPages(PageCache& cache, const GlyphCoverage& glyphs) {
+  HeapProfiler::PhaseScope render(HeapProfiler::Phase::Render);
   for (int p = 0; p < cache.pageCount(); p++) {
     auto page = cache.loadPage(p);
     if (!page) continue;
@@ -107,7 +126,7 @@ static void dumpPages(PageCache& cache, const GfxRenderer& gfx, int fontId) {
       if (elem->getTag() == TAG_PageLine) {
         auto& tb = static_cast<PageLine*>(elem.get())->getTextBlock();
         for (auto& wd : tb.getWords()) {
-          printf("%s ", renderWord(gfx, fontId, wd.word).c_str());
+          printf("%s ", renderWord(glyphs, wd.word).c_str());
         }
         printf("\n");
       }
@@ -115,7 +134,7 @@ static void dumpPages(PageCache& cache, const GfxRenderer& gfx, int fontId) {
   }
 }
 
-static void dumpCacheDir(const std::string& dir, const GfxRenderer& gfx, int fontId) {
+static void dumpCacheDir(const std::string& dir, const GlyphCoverage& glyphs) {
   // Find and dump .bin files in sections/ subdirectory
   std::string sectionsDir = dir + "/sections";
   struct stat st;
@@ -146,12 +165,113 @@ static void dumpCacheDir(const std::string& dir, const GfxRenderer& gfx, int fon
       continue;
     }
     fprintf(stderr, "  %s: %d pages%s\n", path.c_str(), cache.pageCount(), cache.isPartial() ? " (partial)" : "");
-    dumpPages(cache, gfx, fontId);
+    dumpPages(cache, glyphs);
     totalPages += cache.pageCount();
   }
   fprintf(stderr, "Total: %d pages\n", totalPages);
 }
 
+// --stream-font: keep glyph bitmaps on disk like FontManager does on the
+// device, so rendering pays the same bitmap cache misses. Streaming fonts have
+// regular and bold only; italic falls back to regular.
+struct StreamedFamily {
+  std::unique_ptr<StreamingEpdFont> fonts[EpdFontFamily::kExternalStyleCount];
+  std::unique_ptr<EpdFont> wrappers[EpdFontFamily::kExternalStyleCount];
+
+  uint64_t cacheHits() const {
+    uint64_t hits = 0;
+    for (const auto& font : fonts) hits += font ? font->getCacheHits() : 0;
+    return hits;
+  }
+  uint64_t cacheMisses() const {
+    uint64_t misses = 0;
+    for (const auto& font : fonts) misses += font ? font->getCacheMisses() : 0;
+    return misses;
+  }
+};
+
+static bool loadStreamedFamily(const std::string& dir, GfxRenderer& gfx, int fontId, StreamedFamily& family) {
+  static const char* const FILES[EpdFontFamily::kExternalStyleCount] = {"regular.epdfont", "bold.epdfont"};
+  for (int style = 0; style < EpdFontFamily::kExternalStyleCount; style++) {
+    const std::string path = dir + "/" + FILES[style];
+    auto font = std::make_unique<StreamingEpdFont>();
+    if (!font->load(path.c_str())) {
+      if (style == EpdFontFamily::REGULAR) {
+        fprintf(stderr, "Failed to load font: %s\n", path.c_str());
+        return false;
+      }
+      continue;
+    }
+    family.wrappers[style] = std::make_unique<EpdFont>(font->getData());
+    gfx.setStreamingFont(fontId, static_cast<EpdFontFamily::Style>(style), font.get());
+    family.fonts[style] = std::move(font);
+  }
+  fprintf(stderr, "Font: %s (streaming, regular=%zu bold=%zu bytes in RAM)\n", dir.c_str(),
+          family.fonts[0]->getMemoryUsage(), family.fonts[1] ? family.fonts[1]->getMemoryUsage() : 0);
+  return true;
+}
+
+#ifdef READER_TEST_FRAMEBUFFER
+// --render: draws each cached page into the real frame buffer the way
+// ReaderState does (clear, then Page::render at the reader margins), times it
+// and saves the panel as a portrait PBM for visual diffs
+struct PageRenderRun {
+  GfxRenderer& gfx;
+  EInkDisplay& display;
+  int fontId;
+  std::string dir;
+  const StreamedFamily& streamed;
+  std::vector<double> pageMs;
+  uint64_t glyphMisses = 0;
+};
+
+static void renderPages(PageCache& cache, const std::string& name, PageRenderRun& run) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int MARGIN_TOP = GfxRenderer::VIEWABLE_MARGIN_TOP;
+  constexpr int MARGIN_LEFT = GfxRenderer::VIEWABLE_MARGIN_LEFT + 5;  // ReaderState horizontalPadding
+
+  HeapProfiler::PhaseScope render(HeapProfiler::Phase::Render);
+  for (uint32_t p = 0; p < cache.pageCount(); p++) {
+    auto page = cache.loadPage(p);
+    if (!page) {
+      fprintf(stderr, "  %s page %u: failed to load\n", name.c_str(), p);
+      continue;
+    }
+    const uint64_t missesBefore = run.streamed.cacheMisses();
+    const auto start = Clock::now();
+    run.gfx.clearScreen();
+    page->render(run.gfx, run.fontId, MARGIN_LEFT, MARGIN_TOP);
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const uint64_t misses = run.streamed.cacheMisses() - missesBefore;
+    run.pageMs.push_back(ms);
+    run.glyphMisses += misses;
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s_p%03u.pbm", run.dir.c_str(), name.c_str(), p);
+    run.display.saveFrameBufferAsPBM(path);
+    printf("    %s page %u: %.3f ms, %llu glyph misses\n", name.c_str(), p, ms,
+           static_cast<unsigned long long>(misses));
+  }
+}
+
+static void reportRender(const PageRenderRun& run) {
+  if (run.pageMs.empty()) return;
+  std::vector<double> sorted = run.pageMs;
+  std::sort(sorted.begin(), sorted.end());
+  const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+  const size_t p95 = std::min(sorted.size() - 1, (sorted.size() * 95 + 99) / 100 - 1);
+  printf("Rendered %zu pages -> %s/*.pbm\n", sorted.size(), run.dir.c_str());
+  printf("  per page: median %.3f ms, p95 %.3f ms, max %.3f ms, total %.1f ms\n", sorted[sorted.size() / 2],
+         sorted[p95], sorted.back(), total);
+  if (run.streamed.fonts[0]) {
+    printf("  glyph bitmap cache: %llu hits, %llu misses (%llu while rendering)\n",
+           static_cast<unsigned long long>(run.streamed.cacheHits()),
+           static_cast<unsigned long long>(run.streamed.cacheMisses()),
+           static_cast<unsigned long long>(run.glyphMisses));
+  }
+}
+#endif
+
 // Drives the configurable HomeThumbnail mock through the Home selection
 // order (thumbnail first, cover fallback, disabled images) so the tool's
 // selection behavior stays observable and locked to the real pipeline.
@@ -195,8 +315,34 @@ static int checkThumbnailMockScenarios() {
   return failures == 0 ? 0 : 1;
 }
 
+// Trace spans inside the parsers narrow the heap profile phase
+static void traceHeapPhase(const papyrix::trace::Event event, const papyrix::trace::Phase phase) {
+  using papyrix::trace::Event;
+  HeapProfiler::Phase heapPhase;
+  switch (event) {
+    case Event::EpubExtract:
+    case Event::EpubNormalize:
+      heapPhase = HeapProfiler::Phase::Parse;
+      break;
+    case Event::EpubLayout:
+    case Event::Fb2Layout:
+      heapPhase = HeapProfiler::Phase::Layout;
+      break;
+    case Event::PageSerialize:
+      heapPhase = HeapProfiler::Phase::Serialize;
+      break;
+    default:
+      return;
+  }
+  if (phase == papyrix::trace::Phase::Begin) {
+    HeapProfiler::pushPhase(heapPhase);
+  } else if (phase == papyrix::trace::Phase::End) {
+    HeapProfiler::popPhase();
+  }
+}
+
 static void usage() {
-  fprintf(stderr, "Usage: reader-test [--dump] [--batch N] [--cold-extend] [--no-statusbar] [--font DIR] [--cjk-font PATH] <file.epub|.md|.txt|.fb2|.html|.htm> [output_dir]\n");
+  fprintf(stderr, "Usage: reader-test [--dump] [--batch N] [--cold-extend] [--no-statusbar] [--font DIR] [--cjk-font PATH] [--heap-profile] [--render DIR] <file.epub|.md|.txt|.fb2|.fb2.zip|.html|.htm> [output_dir]\n");
   fprintf(stderr, "       reader-test --cache-dump <cache_dir>\n");
   fprintf(stderr, "  --dump           Print parsed text content of each page\n");
   fprintf(stderr, "  --batch N        Cache N pages per batch (default: 5, matching device)\n");
@@ -209,6 +355,11 @@ static void usage() {
   fprintf(stderr, "  --check-thumb-mock  Run Home selection scenario checks and exit\n");
   fprintf(stderr, "  --fail-serialize N  Simulate serialize failure every N pages\n");
   fprintf(stderr, "  --sim-heap SIZE     Simulate device heap size in bytes\n");
+  fprintf(stderr, "  --heap-profile      Replay allocations on a simulated ESP32 heap (--sim-heap or 380KB)\n");
+  fprintf(stderr, "                      and print peak usage, fragmentation and top sites per phase\n");
+  fprintf(stderr, "  --heap-timeline F   With --heap-profile, write largest free block over time to CSV file F\n");
+  fprintf(stderr, "  --stream-font       With --font, stream glyph bitmaps from disk like the device does\n");
+  fprintf(stderr, "  --render DIR        Render every cached page to DIR/*.pbm and time it (reader-test-fb only)\n");
   fprintf(stderr, "  output_dir defaults to /tmp/papyrix-cache/\n");
 }
 
@@ -225,9 +376,13 @@ int main(int argc, char* argv[]) {
   bool dump = false;
   bool showStatusBar = true;
   bool coldExtend = false;
+  bool heapProfile = false;
+  std::string heapTimelinePath;
   uint16_t batchSize = 5;
   std::string cjkFontPath;
   std::string fontDir;
+  std::string renderDir;
+  bool streamFont = false;
   int argIdx = 1;
   while (argIdx < argc && argv[argIdx][0] == '-') {
     if (strcmp(argv[argIdx], "--dump") == 0) {
@@ -254,6 +409,18 @@ int main(int argc, char* argv[]) {
     } else if (strcmp(argv[argIdx], "--sim-heap") == 0 && argIdx + 1 < argc) {
       g_simHeapSize = static_cast<size_t>(atol(argv[argIdx + 1]));
       argIdx += 2;
+    } else if (strcmp(argv[argIdx], "--heap-profile") == 0) {
+      heapProfile = true;
+      argIdx++;
+    } else if (strcmp(argv[argIdx], "--heap-timeline") == 0 && argIdx + 1 < argc) {
+      heapTimelinePath = argv[argIdx + 1];
+      argIdx += 2;
+    } else if (strcmp(argv[argIdx], "--stream-font") == 0) {
+      streamFont = true;
+      argIdx++;
+    } else if (strcmp(argv[argIdx], "--render") == 0 && argIdx + 1 < argc) {
+      renderDir = argv[argIdx + 1];
+      argIdx += 2;
     } else if (strcmp(argv[argIdx], "--cache-dump") == 0) {
       // Handled after renderer setup
       break;
@@ -262,14 +429,37 @@ int main(int argc, char* argv[]) {
     }
   }
 
+#ifndef READER_TEST_FRAMEBUFFER
+  if (!renderDir.empty()) {
+    fprintf(stderr, "--render needs the real frame buffer: run reader-test-fb\n");
+    return 1;
+  }
+#endif
+  if (streamFont && fontDir.empty()) {
+    fprintf(stderr, "--stream-font needs --font DIR\n");
+    return 1;
+  }
+
+  // Fonts count towards the profile: the device holds them for the whole session
+  if (heapProfile) {
+    HeapProfiler::start(g_simHeapSize);
+    papyrix::trace::setListener(traceHeapPhase);
+  }
+
+  constexpr int FONT_ID = 1818981670;  // READER_FONT_ID
+
   // Setup renderer with real font metrics
   EInkDisplay display(0, 0, 0, 0, 0, 0);
   GfxRenderer gfx(display);
+#ifdef READER_TEST_FRAMEBUFFER
+  display.begin();  // Allocates the frame buffer GfxRenderer draws into
+#endif
   gfx.begin();
 
   // External font data (must outlive gfx)
   EpdFontLoader::LoadResult extRegular = {}, extBold = {}, extItalic = {};
   std::unique_ptr<EpdFont> extRegularFont, extBoldFont, extItalicFont;
+  StreamedFamily streamed;
 
   EpdFont builtinRegular(&reader_2b);
   EpdFont builtinBold(&reader_bold_2b);
@@ -279,7 +469,12 @@ int main(int argc, char* argv[]) {
   EpdFont* boldPtr = &builtinBold;
   EpdFont* italicPtr = &builtinItalic;
 
-  if (!fontDir.empty()) {
+  if (streamFont) {
+    if (!loadStreamedFamily(fontDir, gfx, FONT_ID, streamed)) return 1;
+    regularPtr = streamed.wrappers[EpdFontFamily::REGULAR].get();
+    boldPtr = streamed.wrappers[EpdFontFamily::BOLD] ? streamed.wrappers[EpdFontFamily::BOLD].get() : regularPtr;
+    italicPtr = regularPtr;
+  } else if (!fontDir.empty()) {
     std::string regPath = fontDir + "/regular.epdfont";
     extRegular = EpdFontLoader::loadFromFile(regPath.c_str());
     if (!extRegular.success) {
@@ -313,7 +508,6 @@ int main(int argc, char* argv[]) {
   }
 
   EpdFontFamily readerFontFamily(regularPtr, boldPtr, italicPtr, boldPtr);
-  constexpr int FONT_ID = 1818981670;
   gfx.insertFont(FONT_ID, readerFontFamily);  // READER_FONT_ID
 
   ExternalFont externalFont;
@@ -329,13 +523,15 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  const GlyphCoverage glyphs{readerFontFamily, &externalFont};
+
   // Handle --cache-dump (needs renderer for glyph checking)
   if (argIdx < argc && strcmp(argv[argIdx], "--cache-dump") == 0) {
     if (argIdx + 1 >= argc) {
       usage();
       return 1;
     }
-    dumpCacheDir(argv[argIdx + 1], gfx, FONT_ID);
+    dumpCacheDir(argv[argIdx + 1], glyphs);
     return 0;
   }
 
@@ -344,6 +540,20 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+#ifdef READER_TEST_FRAMEBUFFER
+  PageRenderRun renderRun{gfx, display, FONT_ID, renderDir, streamed, {}};
+  if (!renderDir.empty()) mkdirRecursive(renderDir);
+#endif
+  // Called once per finished page cache; name prefixes rendered page images
+  auto pagesReady = [&](PageCache& cache, const std::string& name) {
+    if (dump) dumpPages(cache, glyphs);
+#ifdef READER_TEST_FRAMEBUFFER
+    if (!renderDir.empty()) renderPages(cache, name, renderRun);
+#else
+    (void)name;
+#endif
+  };
+
   const std::string filepath = argv[argIdx];
   const std::string outputDir = argIdx + 1 < argc ? argv[argIdx + 1] : "/tmp/papyrix-cache";
 
@@ -363,6 +573,7 @@ int main(int argc, char* argv[]) {
   config.hyphenation = true;  // Enable hyphenation (matches default device setting)
 
   mkdirRecursive(outputDir);
+  HeapProfiler::setPhase(HeapProfiler::Phase::Open);
 
   if (type == EPUB) {
     auto epub = std::make_shared<Epub>(filepath, outputDir);
@@ -374,6 +585,7 @@ int main(int argc, char* argv[]) {
     // epub->splitLargeSpineItems();
     printf("EPUB: \"%s\" by %s, %d spine items\n", epub->getTitle().c_str(), epub->getAuthor().c_str(),
            epub->getSpineItemsCount());
+    HeapProfiler::setPhase(HeapProfiler::Phase::Parse);
 
     std::string sectionsDir = epub->getCachePath() + "/sections";
     mkdirRecursive(sectionsDir);
@@ -397,7 +609,7 @@ int main(int argc, char* argv[]) {
         if (cache.pageCount() == before) break;
       }
       printf("  Spine %d: %d pages -> %s\n", i, cache.pageCount(), cachePath.c_str());
-      if (dump) dumpPages(cache, gfx, FONT_ID);
+      pagesReady(cache, "spine" + std::to_string(i));
       totalPages += cache.pageCount();
     }
     printf("Total: %d pages\n", totalPages);
@@ -409,6 +621,7 @@ int main(int argc, char* argv[]) {
       return 1;
     }
     printf("Markdown: \"%s\"\n", md.getTitle().c_str());
+    HeapProfiler::setPhase(HeapProfiler::Phase::Parse);
 
     MarkdownParser parser(filepath, gfx, config);
     std::string cachePath = outputDir + "/pages_0.bin";
@@ -420,7 +633,7 @@ int main(int argc, char* argv[]) {
       if (cache.pageCount() == before) break;
     }
     printf("Markdown: %d pages -> %s\n", cache.pageCount(), cachePath.c_str());
-    if (dump) dumpPages(cache, gfx, FONT_ID);
+    pagesReady(cache, "pages");
 
   } else if (type == FB2_FILE) {
     Fb2 fb2file(filepath, outputDir);
@@ -432,10 +645,15 @@ int main(int argc, char* argv[]) {
     const uint16_t sectionCount = fb2file.getSectionCount();
     printf("FB2: \"%s\" by %s (%u sections, %d TOC entries)\n", fb2file.getTitle().c_str(),
            fb2file.getAuthor().c_str(), static_cast<unsigned>(sectionCount), fb2file.tocCount());
+    HeapProfiler::setPhase(HeapProfiler::Phase::Parse);
+
+    std::string imageCachePath = fb2file.getCachePath() + "/images";
+    mkdirRecursive(imageCachePath);
 
     int totalPages = 0;
     for (uint16_t s = 0; s < sectionCount; s++) {
-      Fb2Parser parser(fb2file.getSectionPath(static_cast<int>(s)), gfx, config, fb2file.getLanguage());
+      Fb2Parser parser(fb2file.getPath(), gfx, config, fb2file.getLanguage());
+      fb2file.prepareSectionParser(parser, static_cast<int>(s), imageCachePath);
       std::string cachePath = outputDir + "/pages_" + std::to_string(s) + ".bin";
       PageCache cache(cachePath);
       cache.create(parser, config, batchSize);
@@ -445,7 +663,7 @@ int main(int argc, char* argv[]) {
         if (cache.pageCount() == before) break;
       }
       totalPages += cache.pageCount();
-      if (dump) dumpPages(cache, gfx, FONT_ID);
+      pagesReady(cache, "section" + std::to_string(s));
     }
     printf("FB2: %d pages across %u sections -> %s/pages_*.bin\n", totalPages,
            static_cast<unsigned>(sectionCount), outputDir.c_str());
@@ -458,6 +676,7 @@ int main(int argc, char* argv[]) {
     }
     htmlFile.setupCacheDir();
     printf("HTML: \"%s\"\n", htmlFile.getTitle().c_str());
+    HeapProfiler::setPhase(HeapProfiler::Phase::Parse);
 
     HtmlParser parser(filepath, outputDir, gfx, config);
     std::string cachePath = outputDir + "/pages_0.bin";
@@ -469,7 +688,7 @@ int main(int argc, char* argv[]) {
       if (cache.pageCount() == before) break;
     }
     printf("HTML: %d pages -> %s\n", cache.pageCount(), cachePath.c_str());
-    if (dump) dumpPages(cache, gfx, FONT_ID);
+    pagesReady(cache, "pages");
 
   } else {
     Txt txt(filepath, outputDir);
@@ -478,6 +697,7 @@ int main(int argc, char* argv[]) {
       return 1;
     }
     printf("TXT: \"%s\"\n", txt.getTitle().c_str());
+    HeapProfiler::setPhase(HeapProfiler::Phase::Parse);
 
     PlainTextParser parser(filepath, gfx, config);
     std::string cachePath = outputDir + "/pages_0.bin";
@@ -489,7 +709,27 @@ int main(int argc, char* argv[]) {
       if (cache.pageCount() == before) break;
     }
     printf("TXT: %d pages -> %s\n", cache.pageCount(), cachePath.c_str());
-    if (dump) dumpPages(cache, gfx, FONT_ID);
+    pagesReady(cache, "pages");
+  }
+
+#ifdef READER_TEST_FRAMEBUFFER
+  reportRender(renderRun);
+#endif
+
+  if (heapProfile) {
+    HeapProfiler::stop();
+    papyrix::trace::setListener(nullptr);
+    printf("\n");
+    HeapProfiler::report(stdout);
+    if (!heapTimelinePath.empty()) {
+      FILE* timeline = fopen(heapTimelinePath.c_str(), "w");
+      if (timeline) {
+        HeapProfiler::writeTimeline(timeline);
+        fclose(timeline);
+      } else {
+        fprintf(stderr, "Cannot write heap timeline: %s\n", heapTimelinePath.c_str());
+      }
+    }
   }
 
   if (extRegular.success) EpdFontLoader::freeLoadResult(extRegular);
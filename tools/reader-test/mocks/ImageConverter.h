@@ -4,6 +4,7 @@
 #include <functional>
 #include <string>
 
+class ByteSource;
 class FsFile;
 class Print;
 
@@ -28,12 +29,16 @@ class ImageConverter {
  public:
   virtual ~ImageConverter() = default;
   virtual bool convert(FsFile&, Print&, const ImageConvertConfig&) = 0;
+  virtual bool convertStream(ByteSource&, Print&, const ImageConvertConfig&) { return false; }
+  virtual bool canStream() const { return false; }
   virtual const char* formatName() const = 0;
 };
 
 class ImageConverterFactory {
  public:
   static ImageFormat detectFormat(const std::string&) { return ImageFormat::Unknown; }
+  static ImageFormat detectFormat(const uint8_t*, size_t) { return ImageFormat::Unknown; }
   static bool convertToBmp(const std::string&, const std::string&, const ImageConvertConfig& = {}) { return false; }
+  static bool convertToBmp(ByteSource&, const std::string&, const ImageConvertConfig& = {}) { return false; }
   static bool isSupported(const std::string&) { return false; }
 };
@@ -0,0 +1,4 @@
+#pragma once
+
+// SPI is mocked in platform_stubs.h; the real EInkDisplay includes it by this name
+#include "platform_stubs.h"
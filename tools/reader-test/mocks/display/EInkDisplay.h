@@ -24,6 +24,9 @@ class EInkDisplay {
   uint8_t* getFrameBuffer() const { return const_cast<uint8_t*>(frameBuffer_); }
   void clearScreen(uint8_t color = 0xFF) { memset(frameBuffer_, color, BUFFER_SIZE); }
   void displayBuffer(RefreshMode, bool) {}
+  void beginDisplayBuffer(RefreshMode, bool) {}
+  void finishRefresh() {}
+  static constexpr bool frameBufferFreeWhileRefreshing() { return false; }
   void displayBufferDriveAll(bool = false) {}
   void displayWindow(int, int, int, int, bool) {}
   void drawImage(const uint8_t*, int, int, int, int) {}
@@ -108,6 +108,8 @@ class GfxRenderer {
                                                                        : EInkDisplay::DISPLAY_HEIGHT;
   }
   void displayBuffer(EInkDisplay::RefreshMode = EInkDisplay::FAST_REFRESH, bool = false) const {}
+  void beginDisplayBuffer(EInkDisplay::RefreshMode = EInkDisplay::FAST_REFRESH, bool = false) const {}
+  void finishRefresh() const {}
   void displayWindow(int, int, int, int, bool = false) const {}
   void invertScreen() const {}
   void clearScreen(uint8_t = 0xFF) const {}
@@ -120,6 +122,7 @@ class GfxRenderer {
   void fillRect(int, int, int, int, bool = true) const {}
   void drawImage(const uint8_t*, int, int, int, int) const {}
   void drawBitmap(const Bitmap&, int, int, int, int) const {}
+  void drawMaskRow(const uint8_t*, int, int, int, bool = true) const {}
 
   // Text measurement using real font metrics
   int getTextWidth(int fontId, const char* text, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const {
@@ -247,18 +250,6 @@ class GfxRenderer {
 
   bool fontSupportsGrayscale(int) const { return false; }
 
-  // Check if a codepoint has a glyph (external font → builtin → false)
-  bool hasGlyph(int fontId, uint32_t cp) const {
-    if (isExternalFontAllowed(fontId) && _externalFont && _externalFont->isLoaded() && _externalFont->getGlyph(cp)) {
-      return true;
-    }
-    auto it = fontMap.find(fontId);
-    if (it != fontMap.end() && it->second.getGlyph(cp, EpdFontFamily::REGULAR)) {
-      return true;
-    }
-    return false;
-  }
-
   // Thai text - use same font metrics
   int getThaiTextWidth(int fontId, const char* text, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const {
     return getTextWidth(fontId, text, style);
@@ -278,6 +269,7 @@ class GfxRenderer {
 
   // Grayscale - no-ops
   void setRenderMode(const RenderMode mode) { this->renderMode = mode; }
+  RenderMode getRenderMode() const { return renderMode; }
   void copyGrayscaleLsbBuffers() const {}
   void copyGrayscaleMsbBuffers() const {}
   void displayGrayBuffer(bool = false) const {}
@@ -4,12 +4,26 @@
 #include <cstdarg>
 #include <cstdio>
 
+#include "HeapProfiler.h"
 #include "WString.h"
 
 MockSerial Serial;
 MockSPI SPI;
 MockESP ESP;
 
+size_t heap_caps_get_largest_free_block(uint32_t) {
+  if (HeapProfiler::active()) return HeapProfiler::stats().largestFreeBlock;
+  return g_simHeapSize > 0 ? g_simHeapSize : 200000;
+}
+
+size_t heap_caps_get_free_size(uint32_t) {
+  if (HeapProfiler::active()) {
+    const HeapProfiler::Stats stats = HeapProfiler::stats();
+    return stats.capacity - stats.used;
+  }
+  return g_simHeapSize > 0 ? g_simHeapSize : 200000;
+}
+
 void MockSerial::printf(const char* fmt, ...) {
   va_list args;
   va_start(args, fmt);
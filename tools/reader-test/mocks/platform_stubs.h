@@ -13,8 +13,9 @@
 #define MALLOC_CAP_8BIT 0x01
 #endif
 extern size_t g_simHeapSize;  // 0 = unlimited (default 200KB)
-inline size_t heap_caps_get_largest_free_block(uint32_t) { return g_simHeapSize > 0 ? g_simHeapSize : 200000; }
-inline size_t heap_caps_get_free_size(uint32_t) { return g_simHeapSize > 0 ? g_simHeapSize : 200000; }
+// Report the simulated heap while --heap-profile is running
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
 
 // PROGMEM / pgm_read helpers
 #ifndef PROGMEM
@@ -23,6 +24,9 @@ inline size_t heap_caps_get_free_size(uint32_t) { return g_simHeapSize > 0 ? g_s
 #ifndef pgm_read_byte
 #define pgm_read_byte(addr) (*(const unsigned char*)(addr))
 #endif
+#ifndef memcpy_P
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#endif
 
 // Minimal SPISettings stub
 struct SPISettings {
@@ -0,0 +1,271 @@
+// xtc-repack - rewrite an XTC/XTCH book with compressed pages
+//
+// Usage: xtc-repack [--mode best|group5|packbits|none] input.xtc output.xtc
+//
+// Every page is stored with the chosen compression if that makes it smaller,
+// otherwise uncompressed. "best" (default) keeps the smaller of Group5 and
+// PackBits per page; "none" expands a packed book back to raw pages. Header,
+// metadata, page table and chapter data are copied, with offsets adjusted.
+
+#include <Xtc/XtcPageEncoder.h>
+#include <Xtc/XtcTypes.h>
+#include <Group5.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Mode { Best, Group5, PackBits, None };
+
+struct Page {
+  xtc::PageTableEntry entry;
+  xtc::XtgPageHeader header;
+};
+
+bool readFile(const char* path, std::vector<uint8_t>& out) {
+  FILE* file = std::fopen(path, "rb");
+  if (!file) return false;
+  std::fseek(file, 0, SEEK_END);
+  const long size = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+  const bool ok = size >= 0 && std::fread(out.data(), 1, out.size(), file) == out.size();
+  std::fclose(file);
+  return ok;
+}
+
+bool writeFile(const char* path, const std::vector<uint8_t>& data) {
+  FILE* file = std::fopen(path, "wb");
+  if (!file) return false;
+  const bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  return std::fclose(file) == 0 && ok;
+}
+
+// PackBits stream -> raw bytes
+bool unpackBits(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+  size_t i = 0;
+  size_t o = 0;
+  while (o < outSize) {
+    if (i >= inSize) return false;
+    const uint8_t header = in[i++];
+    if (header == 0x80) continue;
+    if (header < 0x80) {
+      const size_t n = header + 1u;
+      if (i + n > inSize || o + n > outSize) return false;
+      memcpy(out + o, in + i, n);
+      i += n;
+      o += n;
+    } else {
+      const size_t n = 257u - header;
+      if (i >= inSize || o + n > outSize) return false;
+      memset(out + o, in[i++], n);
+      o += n;
+    }
+  }
+  return true;
+}
+
+bool unpackGroup5(const uint8_t* in, size_t inSize, size_t lineBytes, size_t lineCount, uint8_t* out) {
+  std::vector<uint8_t> data(in, in + inSize);
+  G5DECODER decoder;
+  if (decoder.init(static_cast<int>(lineBytes * 8), static_cast<int>(lineCount), data.data(),
+                   static_cast<int>(data.size())) != G5_SUCCESS) {
+    return false;
+  }
+  for (size_t y = 0; y < lineCount; y++) {
+    const int result = decoder.decodeLine(out + y * lineBytes);
+    if (result != G5_SUCCESS && result != G5_DECODE_COMPLETE) return false;
+  }
+  return true;
+}
+
+// Stored page data -> raw XTG bitmap or XTH plane pair (already-packed input books)
+bool decodeStored(const Page& page, const uint8_t bitDepth, const uint8_t* stored, std::vector<uint8_t>& raw) {
+  const uint16_t width = page.header.width;
+  const uint16_t height = page.header.height;
+  const size_t rawSize = bitDepth == 2 ? xtc::xthBitmapSize(width, height) : xtc::xtgBitmapSize(width, height);
+  raw.assign(rawSize, 0);
+  const uint8_t compression = page.header.compression;
+  const uint32_t size = page.header.dataSize;
+
+  if (compression == xtc::XTG_COMPRESSION_NONE) {
+    if (size != rawSize) return false;
+    memcpy(raw.data(), stored, rawSize);
+    return true;
+  }
+
+  auto decodeStream = [compression](const uint8_t* in, size_t inSize, size_t lineBytes, size_t lineCount,
+                                    uint8_t* out) {
+    if (compression == xtc::XTG_COMPRESSION_GROUP5) return unpackGroup5(in, inSize, lineBytes, lineCount, out);
+    if (compression == xtc::XTG_COMPRESSION_PACKBITS) return unpackBits(in, inSize, out, lineBytes * lineCount);
+    return false;
+  };
+
+  if (bitDepth != 2) return decodeStream(stored, size, (width + 7u) / 8, height, raw.data());
+
+  uint32_t firstSize = 0;
+  if (size < sizeof(firstSize)) return false;
+  memcpy(&firstSize, stored, sizeof(firstSize));
+  if (firstSize > size - sizeof(firstSize)) return false;
+  const size_t columnBytes = xtc::xthColumnBytes(height);
+  const size_t planeSize = xtc::xthPlaneSize(width, height);
+  const uint8_t* first = stored + sizeof(firstSize);
+  return decodeStream(first, firstSize, columnBytes, width, raw.data()) &&
+         decodeStream(first + firstSize, size - sizeof(firstSize) - firstSize, columnBytes, width,
+                      raw.data() + planeSize);
+}
+
+void usage(const char* argv0) {
+  std::fprintf(stderr, "Usage: %s [--mode best|group5|packbits|none] input.xtc output.xtc\n", argv0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Mode mode = Mode::Best;
+  std::vector<const char*> paths;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+      const std::string value = argv[++i];
+      if (value == "best") {
+        mode = Mode::Best;
+      } else if (value == "group5") {
+        mode = Mode::Group5;
+      } else if (value == "packbits") {
+        mode = Mode::PackBits;
+      } else if (value == "none") {
+        mode = Mode::None;
+      } else {
+        usage(argv[0]);
+        return 1;
+      }
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.size() != 2) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<uint8_t> in;
+  if (!readFile(paths[0], in) || in.size() < sizeof(xtc::XtcHeader)) {
+    std::fprintf(stderr, "Cannot read %s\n", paths[0]);
+    return 1;
+  }
+
+  xtc::XtcHeader header;
+  memcpy(&header, in.data(), sizeof(header));
+  if (header.magic != xtc::XTC_MAGIC && header.magic != xtc::XTCH_MAGIC) {
+    std::fprintf(stderr, "%s is not an XTC/XTCH file\n", paths[0]);
+    return 1;
+  }
+  const uint8_t bitDepth = header.magic == xtc::XTCH_MAGIC ? 2 : 1;
+  const uint32_t pageMagic = bitDepth == 2 ? xtc::XTH_MAGIC : xtc::XTG_MAGIC;
+  const uint64_t tableSize = static_cast<uint64_t>(header.pageCount) * sizeof(xtc::PageTableEntry);
+  if (header.pageCount == 0 || header.pageTableOffset > in.size() || tableSize > in.size() - header.pageTableOffset) {
+    std::fprintf(stderr, "Page table is outside the file\n");
+    return 1;
+  }
+
+  // Pages must form one block of page data; everything else is copied around it
+  std::vector<Page> pages(header.pageCount);
+  uint64_t dataStart = UINT64_MAX;
+  uint64_t dataEnd = 0;
+  for (size_t i = 0; i < pages.size(); i++) {
+    Page& page = pages[i];
+    memcpy(&page.entry, in.data() + header.pageTableOffset + i * sizeof(xtc::PageTableEntry), sizeof(page.entry));
+    if (page.entry.dataOffset > in.size() || sizeof(xtc::XtgPageHeader) > in.size() - page.entry.dataOffset) {
+      std::fprintf(stderr, "Page %zu is outside the file\n", i + 1);
+      return 1;
+    }
+    memcpy(&page.header, in.data() + page.entry.dataOffset, sizeof(page.header));
+    const uint64_t pageEnd = page.entry.dataOffset + sizeof(xtc::XtgPageHeader) + page.header.dataSize;
+    if (page.header.magic != pageMagic || pageEnd > in.size()) {
+      std::fprintf(stderr, "Page %zu is damaged\n", i + 1);
+      return 1;
+    }
+    dataStart = std::min<uint64_t>(dataStart, page.entry.dataOffset);
+    dataEnd = std::max(dataEnd, pageEnd);
+  }
+
+  const uint64_t sectionOffsets[] = {header.metadataOffset, header.pageTableOffset, header.thumbOffset,
+                                     header.chapterOffset};
+  for (const uint64_t offset : sectionOffsets) {
+    if (offset > dataStart && offset < dataEnd) {
+      std::fprintf(stderr, "Metadata inside the page data is not supported\n");
+      return 1;
+    }
+  }
+
+  std::vector<uint8_t> out(in.begin(), in.begin() + dataStart);
+  size_t counts[3] = {};
+  std::vector<uint8_t> raw;
+  std::vector<uint8_t> best;
+  std::vector<uint8_t> candidate;
+  for (size_t i = 0; i < pages.size(); i++) {
+    Page& page = pages[i];
+    const uint8_t* stored = in.data() + page.entry.dataOffset + sizeof(xtc::XtgPageHeader);
+    if (!decodeStored(page, bitDepth, stored, raw)) {
+      std::fprintf(stderr, "Page %zu cannot be decoded\n", i + 1);
+      return 1;
+    }
+
+    uint8_t compression = xtc::XTG_COMPRESSION_NONE;
+    best = raw;
+    const uint8_t modes[] = {xtc::XTG_COMPRESSION_GROUP5, xtc::XTG_COMPRESSION_PACKBITS};
+    for (const uint8_t candidateMode : modes) {
+      if (mode == Mode::None || (mode == Mode::Group5 && candidateMode != xtc::XTG_COMPRESSION_GROUP5) ||
+          (mode == Mode::PackBits && candidateMode != xtc::XTG_COMPRESSION_PACKBITS)) {
+        continue;
+      }
+      if (xtc::encodePage(bitDepth, page.header.width, page.header.height, raw.data(), candidateMode, candidate) &&
+          candidate.size() < best.size()) {
+        best.swap(candidate);
+        compression = candidateMode;
+      }
+    }
+    counts[compression]++;
+
+    page.header.compression = compression;
+    page.header.dataSize = static_cast<uint32_t>(best.size());
+    page.entry.dataOffset = out.size();
+    page.entry.dataSize = static_cast<uint32_t>(sizeof(page.header) + best.size());
+    const auto* headerBytes = reinterpret_cast<const uint8_t*>(&page.header);
+    out.insert(out.end(), headerBytes, headerBytes + sizeof(page.header));
+    out.insert(out.end(), best.begin(), best.end());
+  }
+
+  // Sections stored after the page data move with it
+  const uint64_t newDataEnd = out.size();
+  out.insert(out.end(), in.begin() + dataEnd, in.end());
+  auto relocate = [&](uint64_t& offset) {
+    if (offset >= dataEnd && offset != 0) offset = offset - dataEnd + newDataEnd;
+  };
+  relocate(header.metadataOffset);
+  relocate(header.pageTableOffset);
+  relocate(header.thumbOffset);
+  relocate(header.chapterOffset);
+  header.dataOffset = dataStart;
+  memcpy(out.data(), &header, sizeof(header));
+  for (size_t i = 0; i < pages.size(); i++) {
+    memcpy(out.data() + header.pageTableOffset + i * sizeof(xtc::PageTableEntry), &pages[i].entry,
+           sizeof(pages[i].entry));
+  }
+
+  if (!writeFile(paths[1], out)) {
+    std::fprintf(stderr, "Cannot write %s\n", paths[1]);
+    return 1;
+  }
+
+  std::printf("%s: %u pages, %.1f KB -> %.1f KB (%.0f%%)\n", paths[1], header.pageCount, in.size() / 1024.0,
+              out.size() / 1024.0, 100.0 * out.size() / in.size());
+  std::printf("pages: %zu group5, %zu packbits, %zu uncompressed; %.1f KB/page average\n",
+              counts[xtc::XTG_COMPRESSION_GROUP5], counts[xtc::XTG_COMPRESSION_PACKBITS],
+              counts[xtc::XTG_COMPRESSION_NONE], (newDataEnd - dataStart) / 1024.0 / header.pageCount);
+  return 0;
+}